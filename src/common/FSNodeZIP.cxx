@@ -186,12 +186,22 @@ uInt32 FilesystemNodeZIP::read(BytePtr& image) const
   }
 
   ZipHandler& zip = open(_zipFile);
+  return zip.seek(_virtualPath) ? zip.decompress(image) : 0;
+}
 
-  bool found = false;
-  while(zip.hasNext() && !found)
-    found = zip.next() == _virtualPath;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 FilesystemNodeZIP::read(ImagePtr& image) const
+{
+  switch(_error)
+  {
+    case ZIPERR_NONE:         break;
+    case ZIPERR_NOT_A_FILE:   throw runtime_error("ZIP file contains errors/not found");
+    case ZIPERR_NOT_READABLE: throw runtime_error("ZIP file not readable");
+    case ZIPERR_NO_ROMS:      throw runtime_error("ZIP file doesn't contain any ROMs");
+  }
 
-  return found ? zip.decompress(image) : 0;
+  ZipHandler& zip = open(_zipFile);
+  return zip.seek(_virtualPath) ? zip.decompress(image) : 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -64,6 +64,9 @@ class FilesystemNodeZIP : public AbstractFSNode
     AbstractFSNode* getParent() const;
 
     uInt32 read(BytePtr& image) const;
+    uInt32 read(ImagePtr& image) const;
+    bool getStats(uInt64& size, uInt64& modified) const
+      { return _realNode && _realNode->getStats(size, modified); }
 
   private:
     FilesystemNodeZIP(const string& zipfile, const string& virtualpath,
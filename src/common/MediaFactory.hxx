@@ -44,6 +44,7 @@
 
 #include "FrameBufferSDL2.hxx"
 #include "EventHandlerSDL2.hxx"
+#include "SoundWAV.hxx"
 #ifdef SOUND_SUPPORT
   #include "SoundSDL2.hxx"
 #else
@@ -110,9 +111,15 @@ class MediaFactory
 
     static unique_ptr<Sound> createAudio(OSystem& osystem)
     {
+      // Dumping audio to a file doesn't need (or use) a sound device
+      const string& wavfile = osystem.settings().getString("wavfile");
+      if(wavfile != "")
+        return make_unique<SoundWAV>(osystem, wavfile);
+
     #ifdef SOUND_SUPPORT
       return make_unique<SoundSDL2>(osystem);
     #else
+      osystem.logMessage("Sound disabled.\n", 1);
       return make_unique<SoundNull>(osystem);
     #endif
     }
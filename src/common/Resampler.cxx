@@ -0,0 +1,105 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2018 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include <cmath>
+
+#include "Resampler.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Resampler::Resampler()
+  : myIndex(0),
+    myPosition(0.0)
+{
+  setRates(1.0, 1.0);
+  reset();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Resampler::setRates(double inputRate, double outputRate)
+{
+  static constexpr double PI = 3.14159265358979323846;
+
+  // Leave a little room for the transition band
+  const double cutoff = 0.9 * std::min(1.0, outputRate / inputRate);
+
+  for(int phase = 0; phase < PHASES; ++phase)
+  {
+    const double frac = double(phase) / PHASES;
+    double sum = 0.0;
+
+    for(int tap = 0; tap < TAPS; ++tap)
+    {
+      // Distance (in input frames) from this tap to the output position,
+      // which lies 'frac' of the way between taps TAPS/2-1 and TAPS/2
+      const double x = tap - (TAPS / 2 - 1) - frac;
+
+      const double sinc = x == 0.0 ? 1.0 : sin(PI * cutoff * x) / (PI * cutoff * x);
+
+      // Blackman window over the span of the filter
+      const double w = (x + TAPS / 2) / TAPS;
+      const double window = w <= 0.0 || w >= 1.0 ? 0.0 :
+          0.42 - 0.5 * cos(2 * PI * w) + 0.08 * cos(4 * PI * w);
+
+      myCoefficients[phase][tap] = float(sinc * window);
+      sum += sinc * window;
+    }
+
+    // Normalize for unity gain at DC
+    for(int tap = 0; tap < TAPS; ++tap)
+      myCoefficients[phase][tap] = float(myCoefficients[phase][tap] / sum);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Resampler::reset()
+{
+  std::fill_n(myLeft, TAPS * 2, 0);
+  std::fill_n(myRight, TAPS * 2, 0);
+  myIndex = 0;
+  myPosition = 0.0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Resampler::pushInput(Int16 left, Int16 right)
+{
+  myLeft[myIndex] = myLeft[myIndex + TAPS] = left;
+  myRight[myIndex] = myRight[myIndex + TAPS] = right;
+  myIndex = (myIndex + 1) % TAPS;
+
+  myPosition -= 1.0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Resampler::output(Int16& left, Int16& right) const
+{
+  const float* coeff = myCoefficients[
+      BSPF::clamp(int(myPosition * PHASES), 0, PHASES - 1)];
+
+  // The oldest frame in the history is at 'myIndex'
+  const Int16* l = myLeft + myIndex;
+  const Int16* r = myRight + myIndex;
+
+  float sumL = 0.0f, sumR = 0.0f;
+  for(int tap = 0; tap < TAPS; ++tap)
+  {
+    sumL += coeff[tap] * l[tap];
+    sumR += coeff[tap] * r[tap];
+  }
+
+  left  = Int16(BSPF::clamp(sumL, -32768.0f, 32767.0f));
+  right = Int16(BSPF::clamp(sumR, -32768.0f, 32767.0f));
+}
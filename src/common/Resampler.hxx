@@ -0,0 +1,100 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2018 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef RESAMPLER_HXX
+#define RESAMPLER_HXX
+
+#include "bspf.hxx"
+
+/**
+  A band-limited (windowed-sinc, polyphase) resampler for 16-bit stereo
+  sample frames.  Input frames are fed one at a time, and output frames
+  are produced at an arbitrary (and continuously variable) fractional
+  step through the input, which allows the step to be nudged for dynamic
+  rate control.
+
+  Usage per output frame is:
+
+    while(resampler.needsInput())  resampler.pushInput(left, right);
+    resampler.output(left, right);
+    resampler.advance(step);
+
+  where 'step' is the input rate divided by the output rate.
+*/
+class Resampler
+{
+  public:
+    Resampler();
+
+    /**
+      Build the filter for the given input and output rates.  The cutoff
+      is placed just below the Nyquist frequency of the lower of the two.
+    */
+    void setRates(double inputRate, double outputRate);
+
+    /**
+      Clear the sample history.
+    */
+    void reset();
+
+    /**
+      Answers whether another input frame is required before the next
+      output frame can be calculated.
+    */
+    bool needsInput() const { return myPosition >= 1.0; }
+
+    /**
+      Add the next input frame to the history.
+    */
+    void pushInput(Int16 left, Int16 right);
+
+    /**
+      Calculate the output frame at the current position.
+    */
+    void output(Int16& left, Int16& right) const;
+
+    /**
+      Move the current position forward by 'step' input frames.
+    */
+    void advance(double step) { myPosition += step; }
+
+  private:
+    enum {
+      TAPS   = 16,   // Filter length, in input frames
+      PHASES = 128   // Number of fractional positions between input frames
+    };
+
+    // Filter coefficients, one row of TAPS for each phase
+    float myCoefficients[PHASES][TAPS];
+
+    // History of input frames; each frame is stored twice (at 'i' and
+    // 'i + TAPS'), so the most recent TAPS frames are always contiguous
+    Int16 myLeft[TAPS * 2], myRight[TAPS * 2];
+    uInt32 myIndex;
+
+    // Fractional position between the two centre frames of the history
+    double myPosition;
+
+  private:
+    // Following constructors and assignment operators not supported
+    Resampler(const Resampler&) = delete;
+    Resampler(Resampler&&) = delete;
+    Resampler& operator=(const Resampler&) = delete;
+    Resampler& operator=(Resampler&&) = delete;
+};
+
+#endif
@@ -0,0 +1,176 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2018 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef SPSC_QUEUE_HXX
+#define SPSC_QUEUE_HXX
+
+#include <array>
+#include <atomic>
+
+#include "bspf.hxx"
+
+/**
+  A fixed-capacity, lock-free ring buffer for exactly one producer thread
+  and one consumer thread (typically the emulation core and the audio
+  callback).
+
+  The producer only ever moves the tail, and the consumer only ever moves
+  the head; each index is published with release semantics and read with
+  acquire semantics, so no locking is required on either side.
+
+  CAPACITY must be a power of two.  One slot is always kept free to
+  distinguish a full queue from an empty one.
+
+  NOTE: 'clear()' modifies both indices, and must only be called when
+        neither side is active (ie, with the audio device paused).
+*/
+namespace Common {
+
+template <class T, uInt32 CAPACITY = 1024>
+class SPSCQueue
+{
+  static_assert((CAPACITY & (CAPACITY - 1)) == 0,
+                "SPSCQueue capacity must be a power of two");
+
+  public:
+    SPSCQueue<T, CAPACITY>() : myHead(0), myTail(0) { }
+
+    /**
+      Producer: add an item to the end of the queue.
+
+      @return  False if the queue was full (the item is discarded)
+    */
+    bool push(const T& item) {
+      const uInt32 tail = myTail.load(std::memory_order_relaxed);
+      const uInt32 next = (tail + 1) & MASK;
+      if(next == myHead.load(std::memory_order_acquire))
+        return false;
+
+      myBuffer[tail] = item;
+      myTail.store(next, std::memory_order_release);
+      return true;
+    }
+
+    /**
+      Producer: add up to 'count' items from the given array.
+
+      @return  The number of items actually added
+    */
+    uInt32 push(const T* items, uInt32 count) {
+      const uInt32 tail = myTail.load(std::memory_order_relaxed);
+      const uInt32 head = myHead.load(std::memory_order_acquire);
+      const uInt32 avail = (head - tail - 1) & MASK;
+      if(count > avail)  count = avail;
+
+      const uInt32 first = std::min(count, CAPACITY - tail);
+      std::copy_n(items, first, myBuffer.begin() + tail);
+      std::copy_n(items + first, count - first, myBuffer.begin());
+
+      myTail.store((tail + count) & MASK, std::memory_order_release);
+      return count;
+    }
+
+    /**
+      Consumer: return a pointer to the item at the front of the queue,
+      or nullptr if it is empty.  The item remains owned by the consumer
+      (and may be modified) until 'pop()' is called.
+    */
+    T* front() {
+      const uInt32 head = myHead.load(std::memory_order_relaxed);
+      if(head == myTail.load(std::memory_order_acquire))
+        return nullptr;
+
+      return &myBuffer[head];
+    }
+
+    /**
+      Consumer: return the item 'i' positions from the front of the queue.
+      The caller must make sure that 'i < size()'.
+    */
+    const T& peek(uInt32 i) const {
+      return myBuffer[(myHead.load(std::memory_order_relaxed) + i) & MASK];
+    }
+
+    /**
+      Consumer: remove the item at the front of the queue (if any).
+    */
+    void pop() {
+      const uInt32 head = myHead.load(std::memory_order_relaxed);
+      if(head != myTail.load(std::memory_order_acquire))
+        myHead.store((head + 1) & MASK, std::memory_order_release);
+    }
+
+    /**
+      Consumer: remove up to 'count' items into the given array.
+
+      @return  The number of items actually removed
+    */
+    uInt32 pop(T* items, uInt32 count) {
+      const uInt32 head = myHead.load(std::memory_order_relaxed);
+      const uInt32 tail = myTail.load(std::memory_order_acquire);
+      const uInt32 used = (tail - head) & MASK;
+      if(count > used)  count = used;
+
+      const uInt32 first = std::min(count, CAPACITY - head);
+      std::copy_n(myBuffer.begin() + head, first, items);
+      std::copy_n(myBuffer.begin(), count - first, items + first);
+
+      myHead.store((head + count) & MASK, std::memory_order_release);
+      return count;
+    }
+
+    /**
+      Answers the number of items currently in the queue.  When called
+      from either side, the result is exact from that side's point of
+      view, and conservative from the other.
+    */
+    uInt32 size() const {
+      return (myTail.load(std::memory_order_acquire) -
+              myHead.load(std::memory_order_acquire)) & MASK;
+    }
+
+    bool empty() const { return size() == 0; }
+    static constexpr uInt32 capacity() { return CAPACITY - 1; }
+
+    void clear() {
+      myHead.store(0, std::memory_order_relaxed);
+      myTail.store(0, std::memory_order_release);
+    }
+
+  private:
+    static constexpr uInt32 MASK = CAPACITY - 1;
+
+    array<T, CAPACITY> myBuffer;
+
+    // Keep the indices on separate cache lines, since they're written by
+    // different threads (padding is used rather than 'alignas', since
+    // over-aligned heap allocation isn't guaranteed before C++17)
+    std::atomic<uInt32> myHead;
+    uInt8 myPadding[64 - sizeof(std::atomic<uInt32>)];
+    std::atomic<uInt32> myTail;
+
+  private:
+    // Following constructors and assignment operators not supported
+    SPSCQueue(const SPSCQueue&) = delete;
+    SPSCQueue(SPSCQueue&&) = delete;
+    SPSCQueue& operator=(const SPSCQueue&) = delete;
+    SPSCQueue& operator=(SPSCQueue&&) = delete;
+};
+
+}  // Namespace Common
+
+#endif
@@ -35,10 +35,7 @@ class SoundNull : public Sound
       Create a new sound object.  The init method must be invoked before
       using the object.
     */
-    SoundNull(OSystem& osystem) : Sound(osystem)
-    {
-      myOSystem.logMessage("Sound disabled.\n", 1);
-    }
+    SoundNull(OSystem& osystem) : Sound(osystem) { }
 
     /**
       Destructor
@@ -101,6 +98,13 @@ class SoundNull : public Sound
     */
     void set(uInt16 addr, uInt8 value, uInt64 cycle) override { }
 
+    /**
+      Informs the sound device that a frame has been completed.
+
+      @param cycle The system cycle at which the frame was completed
+    */
+    void frameComplete(uInt64 cycle) override { }
+
     /**
       Sets the volume of the sound device to the specified level.  The
       volume is given as a percentage from 0 to 100.  Values outside
@@ -118,6 +122,11 @@ class SoundNull : public Sound
     */
     void adjustVolume(Int8 direction) override { }
 
+    /**
+      Answers the current audio buffering measurements (all zero).
+    */
+    Stats stats() const override { return Stats(); }
+
   public:
     /**
       Saves the current state of this device to the given Serializer.
@@ -18,7 +18,6 @@
 #ifdef SOUND_SUPPORT
 
 #include <sstream>
-#include <cassert>
 #include <cmath>
 
 #include "SDL_lib.hxx"
@@ -36,13 +35,26 @@ SoundSDL2::SoundSDL2(OSystem& osystem)
   : Sound(osystem),
     myIsEnabled(false),
     myIsInitializedFlag(false),
-    myLastRegisterSetCycle(0),
+    myLastSampleCycle(0),
     myNumChannels(0),
-    myFragmentSizeLogBase2(0),
-    myFragmentSizeLogDiv1(0),
-    myFragmentSizeLogDiv2(0),
+    myFrameRate(60.0),
+    myFrameSamples(0),
     myIsMuted(true),
-    myVolume(100)
+    myVolume(100),
+    myInputRate(TIASound::NATIVE_FREQUENCY),
+    myTargetFill(0),
+    myFragmentFill(0),
+    myAdaptive(false),
+    myCallbackCount(0),
+    myUnderrunCount(0),
+    myQueueDepth(0),
+    myCallbackInterval(0),
+    myCallbackJitter(0),
+    myInputPos(0),
+    myInputCount(0),
+    myLastCallbackTime(0),
+    myWindowMinFill(0),
+    myWindowCallbacks(0)
 {
   myOSystem.logMessage("SoundSDL2::SoundSDL2 started ...", 2);
 
@@ -80,11 +92,6 @@ SoundSDL2::SoundSDL2(OSystem& osystem)
     return;
   }
 
-  // Pre-compute fragment-related variables as much as possible
-  myFragmentSizeLogBase2 = log(myHardwareSpec.samples) / log(2.0);
-  myFragmentSizeLogDiv1 = myFragmentSizeLogBase2 / 60.0;
-  myFragmentSizeLogDiv2 = (myFragmentSizeLogBase2 - 1) / 60.0;
-
   myIsInitializedFlag = true;
   SDL_PauseAudio(1);
 
@@ -124,9 +131,35 @@ void SoundSDL2::open()
   }
 
   // Now initialize the TIASound object which will actually generate sound
-  myTIASound.outputFrequency(myHardwareSpec.freq);
-  const string& chanResult =
-      myTIASound.channels(myHardwareSpec.channels, myNumChannels == 2);
+  // It always runs at its native rate, and always produces two channels
+  // (with a single hardware channel, both carry the mono mix)
+  myTIASound.outputFrequency(TIASound::NATIVE_FREQUENCY);
+  const string& chanResult = myTIASound.channels(2,
+      myHardwareSpec.channels == 2 && myNumChannels == 2);
+
+  // The callback is paused, so its state can be safely set up from here
+  mySampleQueue.clear();
+  myResampler.setRates(TIASound::NATIVE_FREQUENCY, myHardwareSpec.freq);
+  myResampler.reset();
+  myInputPos = myInputCount = 0;
+  myLastFrame = Frame();
+  myInputRate = TIASound::NATIVE_FREQUENCY;
+  myFrameSamples = 0;
+
+  // Aim to keep one hardware fragment plus one video frame of samples
+  // queued; anything less risks an underrun when the two clocks drift
+  // In adaptive mode this is only the starting point
+  myFragmentFill = uInt32(myHardwareSpec.samples * double(TIASound::NATIVE_FREQUENCY) /
+                          myHardwareSpec.freq);
+  myTargetFill = std::min(myFragmentFill + uInt32(TIASound::NATIVE_FREQUENCY / myFrameRate),
+                          SampleQueue::capacity() / 2);
+  myAdaptive = myOSystem.settings().getString("audiobuffer") == "adaptive";
+
+  myCallbackCount = myUnderrunCount = myQueueDepth = 0;
+  myCallbackInterval = myCallbackJitter = 0;
+  myLastCallbackTime = 0;
+  myWindowMinFill = SampleQueue::capacity();
+  myWindowCallbacks = 0;
 
   // Adjust volume to that defined in settings
   myVolume = myOSystem.settings().getInt("volume");
@@ -137,6 +170,8 @@ void SoundSDL2::open()
   buf << "Sound enabled:"  << endl
       << "  Volume:      " << myVolume << endl
       << "  Frag size:   " << uInt32(myHardwareSpec.samples) << endl
+      << "  Latency:     " << uInt32(myTargetFill * 1000 / TIASound::NATIVE_FREQUENCY)
+                           << " ms (" << (myAdaptive ? "adaptive" : "fixed") << ")" << endl
       << "  Frequency:   " << uInt32(myHardwareSpec.freq) << endl
       << "  Channels:    " << uInt32(myHardwareSpec.channels)
                            << " (" << chanResult << ")" << endl
@@ -157,9 +192,9 @@ void SoundSDL2::close()
   {
     myIsEnabled = false;
     SDL_PauseAudio(1);
-    myLastRegisterSetCycle = 0;
+    myLastSampleCycle = 0;
     myTIASound.reset();
-    myRegWriteQueue.clear();
+    mySampleQueue.clear();
     myOSystem.logMessage("SoundSDL2::close", 2);
   }
 }
@@ -169,6 +204,11 @@ void SoundSDL2::mute(bool state)
 {
   if(myIsInitializedFlag)
   {
+    // Anything still queued from before the mute is stale; the callback
+    // is paused at this point, so it's safe to discard it
+    if(myIsMuted && !state)
+      mySampleQueue.clear();
+
     myIsMuted = state;
     SDL_PauseAudio(myIsMuted ? 1 : 0);
   }
@@ -180,9 +220,9 @@ void SoundSDL2::reset()
   if(myIsInitializedFlag)
   {
     SDL_PauseAudio(1);
-    myLastRegisterSetCycle = 0;
+    myLastSampleCycle = 0;
     myTIASound.reset();
-    myRegWriteQueue.clear();
+    mySampleQueue.clear();
     mute(myIsMuted);
   }
 }
@@ -193,10 +233,8 @@ void SoundSDL2::setVolume(Int32 percent)
   if(myIsInitializedFlag && (percent >= 0) && (percent <= 100))
   {
     myOSystem.settings().setValue("volume", percent);
-    SDL_LockAudio();
     myVolume = percent;
     myTIASound.volume(percent);
-    SDL_UnlockAudio();
   }
 }
 
@@ -236,112 +274,199 @@ void SoundSDL2::setChannels(uInt32 channels)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void SoundSDL2::setFrameRate(float framerate)
 {
-  // Recalculate since frame rate has changed
-  // FIXME - should we clear out the queue or adjust the values in it?
-  myFragmentSizeLogDiv1 = myFragmentSizeLogBase2 / framerate;
-  myFragmentSizeLogDiv2 = (myFragmentSizeLogBase2 - 1) / framerate;
+  // This is called every frame when auto-frame calculation is enabled, so
+  // it only records the rate; the measured input rate follows it smoothly
+  if(framerate > 0)
+    myFrameRate = framerate;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void SoundSDL2::set(uInt16 addr, uInt8 value, uInt64 cycle)
 {
-  SDL_LockAudio();
+  // Everything up to this cycle is played with the old register values
+  update(cycle);
+  myTIASound.set(addr, value);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundSDL2::frameComplete(uInt64 cycle)
+{
+  update(cycle);
+
+  // Measure how fast frames are really being produced; this follows both
+  // the framerate and the number of scanlines per frame, and is used as
+  // the nominal input rate of the resampler
+  if(myIsEnabled && myFrameSamples > 0)
+  {
+    double rate = myInputRate.load(std::memory_order_relaxed);
+    rate += (myFrameSamples * myFrameRate - rate) / 32;
+    myInputRate.store(BSPF::clamp(rate, TIASound::NATIVE_FREQUENCY * 0.5,
+        TIASound::NATIVE_FREQUENCY * 2.0), std::memory_order_relaxed);
+  }
+  myFrameSamples = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundSDL2::update(uInt64 cycle)
+{
+  // The cycle count can go backwards when a state is loaded
+  if(cycle < myLastSampleCycle)
+  {
+    myLastSampleCycle = cycle;
+    return;
+  }
+
+  uInt64 samples = (cycle - myLastSampleCycle) / TIASound::CYCLES_PER_SAMPLE;
+  myLastSampleCycle += samples * TIASound::CYCLES_PER_SAMPLE;
+
+  if(!myIsEnabled || myIsMuted)
+    return;
 
-  // First, calculate how many seconds would have past since the last
-  // register write on a real 2600
-  double delta = double(cycle - myLastRegisterSetCycle) / 1193191.66666667;
+  myFrameSamples += uInt32(samples);
 
-  // Now, adjust the time based on the frame rate the user has selected. For
-  // the sound to "scale" correctly, we have to know the games real frame
-  // rate (e.g., 50 or 60) and the currently emulated frame rate. We use these
-  // values to "scale" the time before the register change occurs.
-  myRegWriteQueue.enqueue(addr, value, delta);
+  // Never let the queue grow past twice its target fill, to bound latency
+  // (ie, after a pause in the debugger, or when emulation runs too fast)
+  const uInt32 queued = mySampleQueue.size();
+  const uInt32 limit = myTargetFill.load(std::memory_order_relaxed) * 2;
+  samples = std::min(samples, uInt64(queued < limit ? limit - queued : 0));
 
-  // Update last cycle counter to the current cycle
-  myLastRegisterSetCycle = cycle;
+  while(samples > 0)
+  {
+    uInt32 count = uInt32(std::min(samples, uInt64(GENERATE_SIZE)));
+    myTIASound.process(myGenerateBuffer, count);
+    for(uInt32 i = 0; i < count; ++i)
+      myGenerateFrames[i] = Frame(myGenerateBuffer[i*2], myGenerateBuffer[i*2+1]);
 
-  SDL_UnlockAudio();
+    mySampleQueue.push(myGenerateFrames, count);
+    samples -= count;
+  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void SoundSDL2::processFragment(Int16* stream, uInt32 length)
 {
-  uInt32 channels = myHardwareSpec.channels;
+  const uInt32 channels = myHardwareSpec.channels;
   length = length / channels;
 
-  // If there are excessive items on the queue then we'll remove some
-  if(myRegWriteQueue.duration() > myFragmentSizeLogDiv1)
+  // Dynamic rate control; consume slightly faster when the queue is above
+  // its target, and slightly slower when below
+  const uInt32 fill = mySampleQueue.size() + (myInputCount - myInputPos);
+  const double target = myTargetFill.load(std::memory_order_relaxed);
+  const double error = BSPF::clamp((fill - target) / target, -1.0, 1.0);
+  const double step = myInputRate.load(std::memory_order_relaxed) /
+      myHardwareSpec.freq * (1.0 + error * MAX_RATE_DELTA);
+
+  bool underrun = false;
+  Int16 left, right;
+  while(length--)
   {
-    double removed = 0.0;
-    while(removed < myFragmentSizeLogDiv2)
+    while(myResampler.needsInput())
     {
-      RegWrite& info = myRegWriteQueue.front();
-      removed += info.delta;
-      myTIASound.set(info.addr, info.value);
-      myRegWriteQueue.dequeue();
+      if(myInputPos == myInputCount)
+      {
+        myInputPos = 0;
+        myInputCount = mySampleQueue.pop(myInputBuffer, INPUT_CHUNK);
+
+        // On underrun, hold the last value to avoid a click
+        if(myInputCount == 0)
+        {
+          myInputBuffer[0] = myLastFrame;
+          myInputCount = 1;
+          underrun = true;
+        }
+      }
+      myLastFrame = myInputBuffer[myInputPos++];
+      myResampler.pushInput(myLastFrame.left, myLastFrame.right);
     }
+
+    myResampler.output(left, right);
+    myResampler.advance(step);
+
+    *stream++ = left;
+    if(channels == 2)
+      *stream++ = right;
   }
 
-  double position = 0.0;
-  double remaining = length;
+  updateBuffering(fill, underrun);
+}
 
-  while(remaining > 0.0)
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundSDL2::updateBuffering(uInt32 fill, bool underrun)
+{
+  // Timing of the requests, as running averages
+  const uInt64 now = myOSystem.getTicks();
+  if(myLastCallbackTime > 0)
   {
-    if(myRegWriteQueue.size() == 0)
-    {
-      // There are no more pending TIA sound register updates so we'll
-      // use the current settings to finish filling the sound fragment
-      myTIASound.process(stream + (uInt32(position) * channels),
-          length - uInt32(position));
-
-      // Since we had to fill the fragment we'll reset the cycle counter
-      // to zero.  NOTE: This isn't 100% correct, however, it'll do for
-      // now.  We should really remember the overrun and remove it from
-      // the delta of the next write.
-      myLastRegisterSetCycle = 0;
-      break;
-    }
-    else
-    {
-      // There are pending TIA sound register updates so we need to
-      // update the sound buffer to the point of the next register update
-      RegWrite& info = myRegWriteQueue.front();
+    const float interval = (now - myLastCallbackTime) / 1000.0f;
+    float mean = myCallbackInterval.load(std::memory_order_relaxed);
+    float jitter = myCallbackJitter.load(std::memory_order_relaxed);
+    if(mean == 0.0f)
+      mean = interval;
+    jitter += (std::fabs(interval - mean) - jitter) / 16;
+    mean += (interval - mean) / 16;
+    myCallbackInterval.store(mean, std::memory_order_relaxed);
+    myCallbackJitter.store(jitter, std::memory_order_relaxed);
+  }
+  myLastCallbackTime = now;
 
-      // How long will the remaining samples in the fragment take to play
-      double duration = remaining / myHardwareSpec.freq;
+  myCallbackCount.fetch_add(1, std::memory_order_relaxed);
+  if(underrun)
+    myUnderrunCount.fetch_add(1, std::memory_order_relaxed);
+  myQueueDepth.store(fill, std::memory_order_relaxed);
 
-      // Does the register update occur before the end of the fragment?
-      if(info.delta <= duration)
-      {
-        // If the register update time hasn't already passed then
-        // process samples upto the point where it should occur
-        if(info.delta > 0.0)
-        {
-          // Process the fragment upto the next TIA register write.  We
-          // round the count passed to process up if needed.
-          double samples = (myHardwareSpec.freq * info.delta);
-          myTIASound.process(stream + (uInt32(position) * channels),
-              uInt32(samples) + uInt32(position + samples) -
-              (uInt32(position) + uInt32(samples)));
-
-          position += samples;
-          remaining -= samples;
-        }
-        myTIASound.set(info.addr, info.value);
-        myRegWriteQueue.dequeue();
-      }
-      else
-      {
-        // The next register update occurs in the next fragment so finish
-        // this fragment with the current TIA settings and reduce the register
-        // update delay by the corresponding amount of time
-        myTIASound.process(stream + (uInt32(position) * channels),
-            length - uInt32(position));
-        info.delta -= duration;
-        break;
-      }
+  if(!myAdaptive)
+    return;
+
+  // The queue must always cover one fragment, plus enough to ride out
+  // the measured variation in when fragments are requested
+  const uInt32 jitterFill = uInt32(4 * myCallbackJitter.load(std::memory_order_relaxed) *
+                                   TIASound::NATIVE_FREQUENCY / 1000);
+  const uInt32 minimum = myFragmentFill + jitterFill;
+  uInt32 target = myTargetFill.load(std::memory_order_relaxed);
+
+  if(underrun)
+  {
+    // Back off quickly
+    target += std::max(target / 4, myFragmentFill / 2);
+    myWindowMinFill = SampleQueue::capacity();
+    myWindowCallbacks = 0;
+  }
+  else
+  {
+    // If the queue never got close to empty for a while, then it holds
+    // more than it needs to; give back half of the unused slack
+    myWindowMinFill = std::min(myWindowMinFill, fill);
+    if(++myWindowCallbacks * float(myHardwareSpec.samples) * 1000 /
+       myHardwareSpec.freq >= ADAPT_WINDOW)
+    {
+      if(myWindowMinFill > myFragmentFill)
+        target -= std::min(target, (myWindowMinFill - myFragmentFill) / 2);
+      myWindowMinFill = SampleQueue::capacity();
+      myWindowCallbacks = 0;
     }
   }
+
+  myTargetFill.store(BSPF::clamp(target, minimum, SampleQueue::capacity() / 2),
+                     std::memory_order_relaxed);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Sound::Stats SoundSDL2::stats() const
+{
+  Stats stats;
+  if(!myIsInitializedFlag)
+    return stats;
+
+  const float msPerFrame = 1000.0f / TIASound::NATIVE_FREQUENCY;
+  stats.callbacks = myCallbackCount.load(std::memory_order_relaxed);
+  stats.underruns = myUnderrunCount.load(std::memory_order_relaxed);
+  stats.queueDepth = myQueueDepth.load(std::memory_order_relaxed) * msPerFrame;
+  stats.targetDepth = myTargetFill.load(std::memory_order_relaxed) * msPerFrame;
+  stats.callbackInterval = myCallbackInterval.load(std::memory_order_relaxed);
+  stats.jitter = myCallbackJitter.load(std::memory_order_relaxed);
+  stats.adaptive = myAdaptive;
+
+  return stats;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -380,7 +505,7 @@ bool SoundSDL2::save(Serializer& out) const
       for(int i = 0; i < 6; ++i)
         out.putByte(0);
 
-    out.putLong(myLastRegisterSetCycle);
+    out.putLong(myLastSampleCycle);
   }
   catch(...)
   {
@@ -404,7 +529,7 @@ bool SoundSDL2::load(Serializer& in)
     if(myIsInitializedFlag)
     {
       SDL_PauseAudio(1);
-      myRegWriteQueue.clear();
+      mySampleQueue.clear();
       myTIASound.set(TIARegister::AUDC0, in.getByte());
       myTIASound.set(TIARegister::AUDC1, in.getByte());
       myTIASound.set(TIARegister::AUDF0, in.getByte());
@@ -417,7 +542,7 @@ bool SoundSDL2::load(Serializer& in)
       for(int i = 0; i < 6; ++i)
         in.getByte();
 
-    myLastRegisterSetCycle = in.getLong();
+    myLastSampleCycle = in.getLong();
   }
   catch(...)
   {
@@ -428,84 +553,4 @@ bool SoundSDL2::load(Serializer& in)
   return true;
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-SoundSDL2::RegWriteQueue::RegWriteQueue(uInt32 capacity)
-  : myBuffer(make_unique<RegWrite[]>(capacity)),
-    myCapacity(capacity),
-    mySize(0),
-    myHead(0),
-    myTail(0)
-{
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void SoundSDL2::RegWriteQueue::clear()
-{
-  myHead = myTail = mySize = 0;
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void SoundSDL2::RegWriteQueue::dequeue()
-{
-  if(mySize > 0)
-  {
-    myHead = (myHead + 1) % myCapacity;
-    --mySize;
-  }
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-double SoundSDL2::RegWriteQueue::duration() const
-{
-  double duration = 0.0;
-  for(uInt32 i = 0; i < mySize; ++i)
-  {
-    duration += myBuffer[(myHead + i) % myCapacity].delta;
-  }
-  return duration;
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void SoundSDL2::RegWriteQueue::enqueue(uInt16 addr, uInt8 value, double delta)
-{
-  // If an attempt is made to enqueue more than the queue can hold then
-  // we'll enlarge the queue's capacity.
-  if(mySize == myCapacity)
-    grow();
-
-  RegWrite& reg = myBuffer[myTail];
-  reg.addr  = addr;
-  reg.value = value;
-  reg.delta = delta;
-  myTail = (myTail + 1) % myCapacity;
-  ++mySize;
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-SoundSDL2::RegWrite& SoundSDL2::RegWriteQueue::front() const
-{
-  assert(mySize != 0);
-  return myBuffer[myHead];
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt32 SoundSDL2::RegWriteQueue::size() const
-{
-  return mySize;
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void SoundSDL2::RegWriteQueue::grow()
-{
-  unique_ptr<RegWrite[]> buffer = make_unique<RegWrite[]>(myCapacity*2);
-  for(uInt32 i = 0; i < mySize; ++i)
-    buffer[i] = myBuffer[(myHead + i) % myCapacity];
-
-  myHead = 0;
-  myTail = mySize;
-  myCapacity *= 2;
-
-  myBuffer = std::move(buffer);
-}
-
 #endif  // SOUND_SUPPORT
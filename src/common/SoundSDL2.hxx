@@ -27,10 +27,20 @@ class OSystem;
 #include "bspf.hxx"
 #include "TIASnd.hxx"
 #include "Sound.hxx"
+#include "SPSCQueue.hxx"
+#include "Resampler.hxx"
 
 /**
   This class implements the sound API for SDL.
 
+  TIA audio is synthesized on the emulation thread at its native rate
+  (one sample every 38 CPU cycles), in lock-step with the system cycle
+  count.  The samples are pushed into a lock-free ring, from which the
+  SDL audio callback pulls them through a band-limited resampler.  The
+  resampling ratio is continuously adjusted to keep the ring near its
+  target fill level (dynamic rate control), so the emulation and audio
+  clocks never need to be exactly matched.
+
   @author Stephen Anthony and Bradford W. Mott
 */
 class SoundSDL2 : public Sound
@@ -107,6 +117,14 @@ class SoundSDL2 : public Sound
     */
     void set(uInt16 addr, uInt8 value, uInt64 cycle) override;
 
+    /**
+      Generate samples up to the given system cycle; called at the end
+      of each frame.
+
+      @param cycle  The system cycle at which the frame was completed
+    */
+    void frameComplete(uInt64 cycle) override;
+
     /**
       Sets the volume of the sound device to the specified level.  The
       volume is given as a percentage from 0 to 100.  Values outside
@@ -124,6 +142,11 @@ class SoundSDL2 : public Sound
     */
     void adjustVolume(Int8 direction) override;
 
+    /**
+      Answers the current audio buffering measurements.
+    */
+    Stats stats() const override;
+
   public:
     /**
       Saves the current state of this device to the given Serializer.
@@ -159,88 +182,49 @@ class SoundSDL2 : public Sound
     */
     void processFragment(Int16* stream, uInt32 length);
 
+    /**
+      Synthesize TIA samples from the last update up to the given system
+      cycle, and push them into the sample queue.
+    */
+    void update(uInt64 cycle);
+
+    /**
+      Record the timing of a fragment request, and in adaptive mode adjust
+      the target fill level (called only from the audio callback).
+
+      @param fill      The number of frames queued when the request started
+      @param underrun  Whether the queue ran out while filling the request
+    */
+    void updateBuffering(uInt32 fill, bool underrun);
+
   protected:
-    // Struct to hold information regarding a TIA sound register write
-    struct RegWrite
+    // A single stereo sample frame, at the native TIA rate
+    struct Frame
     {
-      uInt16 addr;
-      uInt8 value;
-      double delta;
+      Int16 left, right;
 
-      RegWrite(uInt16 a = 0, uInt8 v = 0, double d = 0.0)
-        : addr(a), value(v), delta(d) { }
+      Frame(Int16 l = 0, Int16 r = 0) : left(l), right(r) { }
     };
 
-    /**
-      A queue class used to hold TIA sound register writes before being
-      processed while creating a sound fragment.
-    */
-    class RegWriteQueue
-    {
-      public:
-        /**
-          Create a new queue instance with the specified initial
-          capacity.  If the queue ever reaches its capacity then it will
-          automatically increase its size.
-        */
-        RegWriteQueue(uInt32 capacity = 512);
-
-      public:
-        /**
-          Clear any items stored in the queue.
-        */
-        void clear();
-
-        /**
-          Dequeue the first object in the queue.
-        */
-        void dequeue();
-
-        /**
-          Return the duration of all the items in the queue.
-        */
-        double duration() const;
-
-        /**
-          Enqueue the specified object.
-        */
-        void enqueue(uInt16 addr, uInt8 value, double delta);
-
-        /**
-          Return the item at the front on the queue.
-
-          @return  The item at the front of the queue.
-        */
-        RegWrite& front() const;
-
-        /**
-          Answers the number of items currently in the queue.
-
-          @return  The number of items in the queue.
-        */
-        uInt32 size() const;
-
-      private:
-        // Increase the size of the queue
-        void grow();
-
-      private:
-        unique_ptr<RegWrite[]> myBuffer;
-        uInt32 myCapacity;
-        uInt32 mySize;
-        uInt32 myHead;
-        uInt32 myTail;
-
-      private:
-        // Following constructors and assignment operators not supported
-        RegWriteQueue(const RegWriteQueue&) = delete;
-        RegWriteQueue(RegWriteQueue&&) = delete;
-        RegWriteQueue& operator=(const RegWriteQueue&) = delete;
-        RegWriteQueue& operator=(RegWriteQueue&&) = delete;
+    // Lock-free queue of synthesized frames; the emulation core is the only
+    // producer, and the SDL audio callback the only consumer
+    using SampleQueue = Common::SPSCQueue<Frame, 16384>;
+
+    enum {
+      GENERATE_SIZE = 512,  // Frames synthesized per TIASound::process call
+      INPUT_CHUNK   = 256   // Frames pulled from the queue at a time
     };
 
+    // Maximum relative adjustment of the resampling ratio used for dynamic
+    // rate control; small enough for the pitch change to be inaudible
+    static constexpr double MAX_RATE_DELTA = 0.005;
+
+    // Length of the window over which adaptive buffering looks for unused
+    // slack in the queue before shrinking its target, in milliseconds
+    static constexpr uInt32 ADAPT_WINDOW = 2000;
+
   private:
-    // TIASound emulation object
+    // TIASound emulation object (only accessed by the emulation thread)
     TIASound myTIASound;
 
     // Indicates if the sound subsystem is to be initialized
@@ -249,20 +233,17 @@ class SoundSDL2 : public Sound
     // Indicates if the sound device was successfully initialized
     bool myIsInitializedFlag;
 
-    // Indicates the cycle when a sound register was last set
-    uInt64 myLastRegisterSetCycle;
+    // The system cycle up to which samples have been synthesized
+    uInt64 myLastSampleCycle;
 
     // Indicates the number of channels (mono or stereo)
     uInt32 myNumChannels;
 
-    // Log base 2 of the selected fragment size
-    double myFragmentSizeLogBase2;
+    // The current emulation framerate
+    float myFrameRate;
 
-    // The myFragmentSizeLogBase2 variable is used in only two places,
-    // both of which involve an expensive division in the sound
-    // processing callback
-    // These are pre-computed to speed up the callback as much as possible
-    double myFragmentSizeLogDiv1, myFragmentSizeLogDiv2;
+    // Number of frames synthesized since the end of the last video frame
+    uInt32 myFrameSamples;
 
     // Indicates if the sound is currently muted
     bool myIsMuted;
@@ -273,8 +254,41 @@ class SoundSDL2 : public Sound
     // Audio specification structure
     SDL_AudioSpec myHardwareSpec;
 
-    // Queue of TIA register writes
-    RegWriteQueue myRegWriteQueue;
+    // Synthesized frames waiting to be played
+    SampleQueue mySampleQueue;
+
+    // Scratch buffer used when synthesizing samples
+    Int16 myGenerateBuffer[GENERATE_SIZE * 2];
+    Frame myGenerateFrames[GENERATE_SIZE];
+
+    // The rate at which the emulation is actually producing frames, as
+    // measured over the last few video frames (written by the emulation
+    // thread, read by the callback)
+    std::atomic<double> myInputRate;
+
+    // Number of frames the queue should ideally hold; this is the latency
+    // added on top of the hardware fragment (changed by the callback in
+    // adaptive mode)
+    std::atomic<uInt32> myTargetFill;
+
+    // The hardware fragment size, in frames at the native rate
+    uInt32 myFragmentFill;
+
+    // Whether the target fill is adjusted to the measured timing
+    bool myAdaptive;
+
+    // Buffering measurements (written by the callback, read by the
+    // emulation thread)
+    std::atomic<uInt32> myCallbackCount, myUnderrunCount, myQueueDepth;
+    std::atomic<float> myCallbackInterval, myCallbackJitter;
+
+    // The following are only ever accessed by the audio callback
+    Resampler myResampler;
+    Frame myInputBuffer[INPUT_CHUNK];
+    uInt32 myInputPos, myInputCount;
+    Frame myLastFrame;
+    uInt64 myLastCallbackTime;
+    uInt32 myWindowMinFill, myWindowCallbacks;
 
   private:
     // Callback function invoked by the SDL Audio library when it needs data
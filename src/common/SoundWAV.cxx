@@ -0,0 +1,261 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2018 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "TIASnd.hxx"
+#include "TIAConstants.hxx"
+#include "OSystem.hxx"
+#include "Serializer.hxx"
+#include "SoundWAV.hxx"
+
+namespace {
+  // Store values in the little-endian order required by the WAV format,
+  // independent of the host byte order
+  inline uInt8* putLE16(uInt8* p, uInt16 v)
+  {
+    p[0] = uInt8(v);  p[1] = uInt8(v >> 8);
+    return p + 2;
+  }
+
+  inline uInt8* putLE32(uInt8* p, uInt32 v)
+  {
+    p[0] = uInt8(v);        p[1] = uInt8(v >> 8);
+    p[2] = uInt8(v >> 16);  p[3] = uInt8(v >> 24);
+    return p + 4;
+  }
+
+  // Store a four-character chunk ID
+  inline uInt8* putID(uInt8* p, const char* id)
+  {
+    std::copy_n(id, 4, p);
+    return p + 4;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+SoundWAV::SoundWAV(OSystem& osystem, const string& filename)
+  : Sound(osystem),
+    myDataSize(0),
+    myIsEnabled(false),
+    myNumChannels(2),
+    myLastSampleCycle(0)
+{
+  myOSystem.logMessage("SoundWAV::SoundWAV started ...", 2);
+
+  myFile.open(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+  if(!myFile.is_open())
+  {
+    myOSystem.logMessage("WARNING: Couldn't open WAV file '" + filename +
+                         "' for writing!", 0);
+    return;
+  }
+  writeHeader();
+
+  myOSystem.logMessage("SoundWAV::SoundWAV initialized", 2);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+SoundWAV::~SoundWAV()
+{
+  if(myFile.is_open())
+  {
+    writeHeader();
+    myFile.close();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundWAV::setChannels(uInt32 channels)
+{
+  if(channels == 1 || channels == 2)
+    myNumChannels = channels;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundWAV::open()
+{
+  myIsEnabled = false;
+  if(!myFile.is_open())
+    return;
+
+  // Samples are always generated at the native TIA rate, in two channels,
+  // and at full volume
+  myTIASound.outputFrequency(TIASound::NATIVE_FREQUENCY);
+  myTIASound.channels(2, myNumChannels == 2);
+  myTIASound.volume(100);
+  myTIASound.reset();
+  myLastSampleCycle = 0;
+
+  myIsEnabled = true;
+  myOSystem.logMessage("Sound written to WAV file (31400 Hz, 16-bit, stereo)\n", 1);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundWAV::close()
+{
+  if(!myIsEnabled)
+    return;
+
+  myIsEnabled = false;
+  myTIASound.reset();
+
+  // Make sure the file is valid up to this point, in case we never
+  // get a chance to finish it properly
+  writeHeader();
+  myFile.flush();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundWAV::reset()
+{
+  if(myIsEnabled)
+  {
+    myLastSampleCycle = 0;
+    myTIASound.reset();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundWAV::set(uInt16 addr, uInt8 value, uInt64 cycle)
+{
+  // Everything up to this cycle is written with the old register values
+  update(cycle);
+  myTIASound.set(addr, value);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundWAV::frameComplete(uInt64 cycle)
+{
+  update(cycle);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundWAV::update(uInt64 cycle)
+{
+  // The cycle count can go backwards when a state is loaded
+  if(cycle < myLastSampleCycle)
+  {
+    myLastSampleCycle = cycle;
+    return;
+  }
+
+  uInt64 samples = (cycle - myLastSampleCycle) / TIASound::CYCLES_PER_SAMPLE;
+  myLastSampleCycle += samples * TIASound::CYCLES_PER_SAMPLE;
+
+  if(!myIsEnabled)
+    return;
+
+  while(samples > 0)
+  {
+    uInt32 count = uInt32(std::min(samples, uInt64(GENERATE_SIZE)));
+    myTIASound.process(myGenerateBuffer, count);
+
+    uInt8* p = myWriteBuffer;
+    for(uInt32 i = 0; i < count * 2; ++i)
+      p = putLE16(p, uInt16(myGenerateBuffer[i]));
+
+    myFile.write(reinterpret_cast<const char*>(myWriteBuffer), count * 4);
+    myDataSize += count * 4;
+    samples -= count;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundWAV::writeHeader()
+{
+  static constexpr uInt32 RATE = TIASound::NATIVE_FREQUENCY;
+  static constexpr uInt16 CHANNELS = 2, BITS = 16;
+  static constexpr uInt16 BLOCK_ALIGN = CHANNELS * BITS / 8;
+
+  uInt8 header[44];
+  uInt8* p = header;
+
+  // RIFF chunk, which contains everything else
+  p = putID(p, "RIFF");
+  p = putLE32(p, 36 + myDataSize);
+  p = putID(p, "WAVE");
+
+  // Format chunk (uncompressed PCM)
+  p = putID(p, "fmt ");
+  p = putLE32(p, 16);
+  p = putLE16(p, 1);
+  p = putLE16(p, CHANNELS);
+  p = putLE32(p, RATE);
+  p = putLE32(p, RATE * BLOCK_ALIGN);
+  p = putLE16(p, BLOCK_ALIGN);
+  p = putLE16(p, BITS);
+
+  // Data chunk; the samples follow directly
+  p = putID(p, "data");
+  p = putLE32(p, myDataSize);
+
+  const std::streampos pos = myFile.tellp();
+  myFile.seekp(0);
+  myFile.write(reinterpret_cast<const char*>(header), sizeof(header));
+  if(pos > 0)
+    myFile.seekp(pos);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool SoundWAV::save(Serializer& out) const
+{
+  try
+  {
+    out.putString(name());
+
+    out.putByte(myTIASound.get(TIARegister::AUDC0));
+    out.putByte(myTIASound.get(TIARegister::AUDC1));
+    out.putByte(myTIASound.get(TIARegister::AUDF0));
+    out.putByte(myTIASound.get(TIARegister::AUDF1));
+    out.putByte(myTIASound.get(TIARegister::AUDV0));
+    out.putByte(myTIASound.get(TIARegister::AUDV1));
+
+    out.putLong(myLastSampleCycle);
+  }
+  catch(...)
+  {
+    myOSystem.logMessage("ERROR: SoundWAV::save", 0);
+    return false;
+  }
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool SoundWAV::load(Serializer& in)
+{
+  try
+  {
+    if(in.getString() != name())
+      return false;
+
+    myTIASound.set(TIARegister::AUDC0, in.getByte());
+    myTIASound.set(TIARegister::AUDC1, in.getByte());
+    myTIASound.set(TIARegister::AUDF0, in.getByte());
+    myTIASound.set(TIARegister::AUDF1, in.getByte());
+    myTIASound.set(TIARegister::AUDV0, in.getByte());
+    myTIASound.set(TIARegister::AUDV1, in.getByte());
+
+    myLastSampleCycle = in.getLong();
+  }
+  catch(...)
+  {
+    myOSystem.logMessage("ERROR: SoundWAV::load", 0);
+    return false;
+  }
+
+  return true;
+}
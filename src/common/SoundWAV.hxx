@@ -0,0 +1,204 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2018 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef SOUND_WAV_HXX
+#define SOUND_WAV_HXX
+
+class OSystem;
+
+#include "bspf.hxx"
+#include "TIASnd.hxx"
+#include "Sound.hxx"
+
+/**
+  This class implements a sound object that doesn't use an audio device
+  at all; instead, TIA audio is synthesized from the sound register writes
+  at the native TIA rate, with cycle-exact timing, and streamed as 16-bit
+  stereo PCM to a WAV file.
+
+  Since the output depends only on the emulated cycle count, it is the
+  same no matter how fast the emulation runs, and is identical between
+  runs of the same ROM and input.  For the same reason, the volume and
+  mute settings are ignored.
+
+  @author Stephen Anthony
+*/
+class SoundWAV : public Sound
+{
+  public:
+    /**
+      Create a new sound object, writing to the given file.
+    */
+    SoundWAV(OSystem& osystem, const string& filename);
+
+    /**
+      Destructor; finalizes the WAV file
+    */
+    virtual ~SoundWAV();
+
+  public:
+    /**
+      Enables/disables the sound subsystem (ignored).
+
+      @param state  True or false, to enable or disable the sound system
+    */
+    void setEnabled(bool state) override { }
+
+    /**
+      Sets the number of channels (mono or stereo sound).  The file always
+      has two channels; in mono mode both carry the same mix.
+
+      @param channels  The number of channels
+    */
+    void setChannels(uInt32 channels) override;
+
+    /**
+      Sets the display framerate (not needed, since timing comes only from
+      the system cycle count).
+
+      @param framerate The base framerate depending on NTSC or PAL ROM
+    */
+    void setFrameRate(float framerate) override { }
+
+    /**
+      Starts writing samples.
+    */
+    void open() override;
+
+    /**
+      Stops writing samples, and updates the WAV header so the file is
+      valid at this point.
+    */
+    void close() override;
+
+    /**
+      Set the mute state of the sound object (ignored).
+
+      @param state  Mutes sound if true, unmute if false
+    */
+    void mute(bool state) override { }
+
+    /**
+      Reset the sound device.
+    */
+    void reset() override;
+
+    /**
+      Sets the sound register to a given value.
+
+      @param addr   The register address
+      @param value  The value to save into the register
+      @param cycle  The system cycle at which the register is being updated
+    */
+    void set(uInt16 addr, uInt8 value, uInt64 cycle) override;
+
+    /**
+      Generate samples up to the given system cycle.
+
+      @param cycle  The system cycle at which the frame was completed
+    */
+    void frameComplete(uInt64 cycle) override;
+
+    /**
+      Sets the volume of the sound device (ignored).
+
+      @param percent  The new volume percentage level for the sound device
+    */
+    void setVolume(Int32 percent) override { }
+
+    /**
+      Adjusts the volume of the sound device (ignored).
+
+      @param direction  Increase or decrease the current volume
+    */
+    void adjustVolume(Int8 direction) override { }
+
+    /**
+      Answers the current audio buffering measurements (all zero, since
+      there's no buffering).
+    */
+    Stats stats() const override { return Stats(); }
+
+  public:
+    /**
+      Saves the current state of this device to the given Serializer.
+
+      @param out  The serializer device to save to.
+      @return  The result of the save.  True on success, false on failure.
+    */
+    bool save(Serializer& out) const override;
+
+    /**
+      Loads the current state of this device from the given Serializer.
+
+      @param in  The Serializer device to load from.
+      @return  The result of the load.  True on success, false on failure.
+    */
+    bool load(Serializer& in) override;
+
+    /**
+      Get a descriptor for this console class (used in error checking).
+
+      @return  The name of the object
+    */
+    string name() const override { return "TIASound"; }
+
+  private:
+    /**
+      Synthesize samples from the last update up to the given system
+      cycle, and append them to the file.
+    */
+    void update(uInt64 cycle);
+
+    /**
+      Write the RIFF/WAVE header, using the current data size.
+    */
+    void writeHeader();
+
+  private:
+    enum { GENERATE_SIZE = 1024 };
+
+    // TIASound emulation object
+    TIASound myTIASound;
+
+    // The file being written, and the number of sample bytes in it
+    ofstream myFile;
+    uInt32 myDataSize;
+
+    // Whether samples are currently being written
+    bool myIsEnabled;
+
+    // Number of channels to mix into (1 = mono, 2 = stereo)
+    uInt32 myNumChannels;
+
+    // The system cycle up to which samples have been synthesized
+    uInt64 myLastSampleCycle;
+
+    // Scratch buffers used when synthesizing samples
+    Int16 myGenerateBuffer[GENERATE_SIZE * 2];
+    uInt8 myWriteBuffer[GENERATE_SIZE * 4];
+
+  private:
+    // Following constructors and assignment operators not supported
+    SoundWAV() = delete;
+    SoundWAV(const SoundWAV&) = delete;
+    SoundWAV(SoundWAV&&) = delete;
+    SoundWAV& operator=(const SoundWAV&) = delete;
+    SoundWAV& operator=(SoundWAV&&) = delete;
+};
+
+#endif
@@ -17,8 +17,16 @@
 
 #include <cctype>
 #include <cstdlib>
+#include <new>
 #include <zlib.h>
 
+#if defined(BSPF_UNIX) || defined(BSPF_MAC_OSX)
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
 #include "ZipHandler.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -39,6 +47,13 @@ ZipHandler::~ZipHandler()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void ZipHandler::open(const string& filename)
 {
+  // Nothing to do if the file is already open
+  if(myZip && filename == myZip->filename)
+  {
+    reset();
+    return;
+  }
+
   // Close already open file
   if(myZip)
     zip_file_close(myZip);
@@ -53,35 +68,34 @@ void ZipHandler::reset()
 {
   // Reset the position and go from there
   if(myZip)
-    myZip->cd_pos = 0;
+    myZip->next_entry = 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool ZipHandler::hasNext()
 {
-  return myZip && (myZip->cd_pos < myZip->ecd.cd_size);
+  return myZip && (myZip->next_entry < myZip->entries.size());
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-string ZipHandler::next()
+const string& ZipHandler::next()
 {
-  if(myZip)
-  {
-    bool valid = false;
-    const zip_file_header* header = nullptr;
-    do {
-      header = zip_file_next_file(myZip);
+  return hasNext() ? myZip->entries[myZip->next_entry++].name : EmptyString;
+}
 
-      // Ignore zero-length files and '__MACOSX' virtual directories
-      valid = header && (header->uncompressed_length > 0) &&
-              !BSPF::startsWithIgnoreCase(header->filename, "__MACOSX");
-    }
-    while(!valid && myZip->cd_pos < myZip->ecd.cd_size);
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ZipHandler::seek(const string& filename)
+{
+  if(!myZip)
+    return false;
 
-    return valid ? header->filename : EmptyString;
-  }
-  else
-    return EmptyString;
+  const auto it = myZip->lookup.find(filename);
+  if(it == myZip->lookup.end())
+    return false;
+
+  // Parse the header of that file only
+  myZip->cd_pos = myZip->entries[it->second].cd_offset;
+  return zip_file_next_file(myZip) != nullptr;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -114,6 +128,28 @@ uInt32 ZipHandler::decompress(BytePtr& image)
     throw runtime_error("Invalid ZIP archive");
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 ZipHandler::decompress(shared_ptr<const uInt8>& image)
+{
+  // Stored files can be used in place; the image shares ownership of the
+  // mapping, so the archive may drop out of the cache meanwhile
+  uInt64 offset;
+  if(myZip && myZip->map && myZip->header.compression == 0 &&
+     myZip->header.compressed_length == myZip->header.uncompressed_length &&
+     get_compressed_data_offset(myZip, offset) == ZIPERR_NONE &&
+     offset + myZip->header.compressed_length <= myZip->length)
+  {
+    image = shared_ptr<const uInt8>(myZip->map, myZip->map.get() + offset);
+    return myZip->header.uncompressed_length;
+  }
+
+  BytePtr buffer;
+  uInt32 length = decompress(buffer);
+  image = shared_ptr<const uInt8>(buffer.release(),
+                                  [](const uInt8* p) { delete[] p; });
+  return length;
+}
+
 /*-------------------------------------------------
     replaces functionality of various osd_xxx
     file access functions
@@ -170,6 +206,33 @@ bool ZipHandler::stream_read(fstream* stream, void* buffer, uInt64 offset,
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ZipHandler::map_open(const char* filename, shared_ptr<const uInt8>& map,
+                          uInt64& length)
+{
+#if defined(BSPF_UNIX) || defined(BSPF_MAC_OSX)
+  int fd = ::open(filename, O_RDONLY);
+  if(fd < 0)
+    return false;
+
+  struct stat st;
+  void* data = MAP_FAILED;
+  if(fstat(fd, &st) == 0 && st.st_size > 0)
+    data = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping remains valid after the descriptor is closed
+  ::close(fd);
+  if(data == MAP_FAILED)
+    return false;
+
+  const size_t size = size_t(st.st_size);
+  map = shared_ptr<const uInt8>(static_cast<const uInt8*>(data),
+      [size](const uInt8* p) { munmap(const_cast<uInt8*>(p), size); });
+  length = uInt64(size);
+  return true;
+#else
+  return false;
+#endif
+}
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
@@ -205,13 +268,13 @@ ZipHandler::zip_error ZipHandler::zip_file_open(const char* filename, zip_file**
   }
 
   // Allocate memory for the zip_file structure
-  newzip = (zip_file*)malloc(sizeof(*newzip));
+  newzip = new (std::nothrow) zip_file();
   if (newzip == nullptr)
     return ZIPERR_OUT_OF_MEMORY;
-  memset(newzip, 0, sizeof(*newzip));
 
-  // Open the file
-  if(!stream_open(filename, &newzip->file, newzip->length))
+  // Map the file if possible, otherwise open it as a stream
+  if(!map_open(filename, newzip->map, newzip->length) &&
+     !stream_open(filename, &newzip->file, newzip->length))
   {
     ziperr = ZIPERR_FILE_ERROR;
     goto error;
@@ -239,8 +302,8 @@ ZipHandler::zip_error ZipHandler::zip_file_open(const char* filename, zip_file**
   }
 
   // Read the central directory
-  success = stream_read(newzip->file, newzip->cd, newzip->ecd.cd_start_disk_offset,
-                        newzip->ecd.cd_size, read_length);
+  success = read_data(newzip, newzip->cd, newzip->ecd.cd_start_disk_offset,
+                      newzip->ecd.cd_size, read_length);
   if(!success || read_length != newzip->ecd.cd_size)
   {
     ziperr = success ? ZIPERR_FILE_TRUNCATED : ZIPERR_FILE_ERROR;
@@ -259,14 +322,29 @@ ZipHandler::zip_error ZipHandler::zip_file_open(const char* filename, zip_file**
   newzip->filename = string;
   *zip = newzip;
 
-  // Count ROM files (we do it at this level so it will be cached)
-  while(hasNext())
+  // Index the files and count the ROMs among them (we do it at this level
+  // so it will be cached)
   {
-    const std::string& file = next();
-    if(BSPF::endsWithIgnoreCase(file, ".a26") ||
-       BSPF::endsWithIgnoreCase(file, ".bin") ||
-       BSPF::endsWithIgnoreCase(file, ".rom"))
-      (*zip)->romfiles++;
+    uInt32 offset = newzip->cd_pos;
+    const zip_file_header* header;
+    while((header = zip_file_next_file(newzip)) != nullptr)
+    {
+      // Ignore zero-length files and '__MACOSX' virtual directories
+      if(header->uncompressed_length > 0 &&
+         !BSPF::startsWithIgnoreCase(header->filename, "__MACOSX"))
+      {
+        const std::string file = header->filename;
+        newzip->lookup.emplace(file, uInt32(newzip->entries.size()));
+        newzip->entries.push_back(zip_entry{file, offset,
+            header->uncompressed_length, header->crc});
+
+        if(BSPF::endsWithIgnoreCase(file, ".a26") ||
+           BSPF::endsWithIgnoreCase(file, ".bin") ||
+           BSPF::endsWithIgnoreCase(file, ".rom"))
+          newzip->romfiles++;
+      }
+      offset = newzip->cd_pos;
+    }
   }
 
   return ZIPERR_NONE;
@@ -285,9 +363,8 @@ void ZipHandler::zip_file_close(zip_file* zip)
 {
   int cachenum;
 
-  // Close the open files
-  if(zip->file)
-    stream_close(&zip->file);
+  // The file itself is left open, since it is likely to be used again;
+  // it is closed once it drops out of the cache
 
   // Find the first NULL entry in the cache
   for(cachenum = 0; cachenum < ZIP_CACHE_SIZE; ++cachenum)
@@ -444,7 +521,7 @@ void ZipHandler::free_zip_file(zip_file* zip)
       free(zip->ecd.raw);
     if(zip->cd != nullptr)
       free(zip->cd);
-    free(zip);
+    delete zip;
   }
 }
 
@@ -452,6 +529,22 @@ void ZipHandler::free_zip_file(zip_file* zip)
     ZIP FILE PARSING
 ***************************************************************************/
 
+/*-------------------------------------------------
+    read_data - read from the mapped file if
+    possible, otherwise from the stream
+-------------------------------------------------*/
+bool ZipHandler::read_data(zip_file* zip, void* buffer, uInt64 offset,
+                           uInt32 length, uInt32& actual)
+{
+  if(!zip->map)
+    return stream_read(zip->file, buffer, offset, length, actual);
+
+  actual = offset < zip->length ?
+      uInt32(std::min(uInt64(length), zip->length - offset)) : 0;
+  memcpy(buffer, zip->map.get() + offset, actual);
+  return true;
+}
+
 /*-------------------------------------------------
     read_ecd - read the ECD data
 -------------------------------------------------*/
@@ -477,8 +570,8 @@ ZipHandler::zip_error ZipHandler::read_ecd(zip_file* zip)
       return ZIPERR_OUT_OF_MEMORY;
 
     // Read in one buffers' worth of data
-    bool success = stream_read(zip->file, buffer, zip->length - buflen,
-                               buflen, read_length);
+    bool success = read_data(zip, buffer, zip->length - buflen,
+                             buflen, read_length);
     if(!success || read_length != buflen)
     {
       free(buffer);
@@ -535,12 +628,13 @@ ZipHandler::zip_error
   uInt32 read_length;
 
   // Make sure the file handle is open
-  if(zip->file == nullptr && !stream_open(zip->filename, &zip->file, zip->length))
+  if(zip->file == nullptr && !zip->map &&
+     !stream_open(zip->filename, &zip->file, zip->length))
     return ZIPERR_FILE_ERROR;
 
   // Now go read the fixed-sized part of the local file header
-  bool success = stream_read(zip->file, zip->buffer, zip->header.local_header_offset,
-                             ZIPNAME, read_length);
+  bool success = read_data(zip, zip->buffer, zip->header.local_header_offset,
+                           ZIPNAME, read_length);
   if(!success || read_length != ZIPNAME)
     return success ? ZIPERR_FILE_TRUNCATED : ZIPERR_FILE_ERROR;
 
@@ -567,8 +661,8 @@ ZipHandler::zip_error
   uInt32 read_length;
 
   // The data is uncompressed; just read it
-  bool success = stream_read(zip->file, buffer, offset,
-                             zip->header.compressed_length, read_length);
+  bool success = read_data(zip, buffer, offset,
+                           zip->header.compressed_length, read_length);
   if(!success)
     return ZIPERR_FILE_ERROR;
   else if(read_length != zip->header.compressed_length)
@@ -608,46 +702,68 @@ ZipHandler::zip_error
   if(zerr != Z_OK)
     return ZIPERR_DECOMPRESS_ERROR;
 
-  // Loop until we're done
-  for(;;)
+  // A mapped file is inflated in one go, without copying the input
+  if(zip->map)
   {
-    // Read in the next chunk of data
-    bool success = stream_read(zip->file, zip->buffer, offset,
-                      std::min(input_remaining, (uInt32)sizeof(zip->buffer)),
-                      read_length);
-    if(!success)
-    {
-      inflateEnd(&stream);
-      return ZIPERR_FILE_ERROR;
-    }
-    offset += read_length;
-
-    // If we read nothing, but still have data left, the file is truncated
-    if(read_length == 0 && input_remaining > 0)
+    if(offset + input_remaining > zip->length)
     {
       inflateEnd(&stream);
       return ZIPERR_FILE_TRUNCATED;
     }
+    stream.next_in = const_cast<Bytef*>(zip->map.get() + offset);
+    stream.avail_in = input_remaining;
+    input_remaining = 0;
 
-    // Fill out the input data
-    stream.next_in = zip->buffer;
-    stream.avail_in = read_length;
-    input_remaining -= read_length;
-
-    // Add a dummy byte at end of compressed data
-    if(input_remaining == 0)
-      stream.avail_in++;
-
-    // Now inflate
-    zerr = inflate(&stream, Z_NO_FLUSH);
-    if(zerr == Z_STREAM_END)
-      break;
-    if(zerr != Z_OK)
+    zerr = inflate(&stream, Z_FINISH);
+    if(zerr != Z_STREAM_END)
     {
       inflateEnd(&stream);
       return ZIPERR_DECOMPRESS_ERROR;
     }
   }
+  else
+  {
+    // Loop until we're done
+    for(;;)
+    {
+      // Read in the next chunk of data
+      bool success = read_data(zip, zip->buffer, offset,
+                        std::min(input_remaining, (uInt32)sizeof(zip->buffer)),
+                        read_length);
+      if(!success)
+      {
+        inflateEnd(&stream);
+        return ZIPERR_FILE_ERROR;
+      }
+      offset += read_length;
+
+      // If we read nothing, but still have data left, the file is truncated
+      if(read_length == 0 && input_remaining > 0)
+      {
+        inflateEnd(&stream);
+        return ZIPERR_FILE_TRUNCATED;
+      }
+
+      // Fill out the input data
+      stream.next_in = zip->buffer;
+      stream.avail_in = read_length;
+      input_remaining -= read_length;
+
+      // Add a dummy byte at end of compressed data
+      if(input_remaining == 0)
+        stream.avail_in++;
+
+      // Now inflate
+      zerr = inflate(&stream, Z_NO_FLUSH);
+      if(zerr == Z_STREAM_END)
+        break;
+      if(zerr != Z_OK)
+      {
+        inflateEnd(&stream);
+        return ZIPERR_DECOMPRESS_ERROR;
+      }
+    }
+  }
 
   // Finish decompression
   zerr = inflateEnd(&stream);
@@ -18,6 +18,8 @@
 #ifndef ZIP_HANDLER_HXX
 #define ZIP_HANDLER_HXX
 
+#include <unordered_map>
+
 #include "bspf.hxx"
 
 /***************************************************************************
@@ -72,14 +74,23 @@ class ZipHandler
     void open(const string& filename);
 
     // The following form an iterator for processing the filenames in the ZIP file
-    void reset();     // Reset iterator to first file
-    bool hasNext();   // Answer whether there are more files present
-    string next();    // Get next file
+    void reset();          // Reset iterator to first file
+    bool hasNext();        // Answer whether there are more files present
+    const string& next();  // Get next file
+
+    // Select the given file for decompression, answering whether it exists
+    // This uses the index of the ZIP file, so it doesn't need to search
+    bool seek(const string& filename);
 
-    // Decompress the currently selected file and return its length
+    // Decompress the file selected by seek() and return its length
     // An exception will be thrown on any errors
     uInt32 decompress(BytePtr& image);
 
+    // As above, but a file which is stored uncompressed in a memory-mapped
+    // archive isn't copied; the image then points into the archive itself,
+    // which stays mapped for as long as the image exists
+    uInt32 decompress(shared_ptr<const uInt8>& image);
+
     // Answer the number of ROM files found in the archive
     // Currently, this means files with extension a26/bin/rom
     uInt16 romFiles() const { return myZip ? myZip->romfiles : 0; }
@@ -90,6 +101,8 @@ class ZipHandler
     static void stream_close(fstream** stream);
     static bool stream_read(fstream* stream, void* buffer, uInt64 offset,
                             uInt32 length, uInt32& actual);
+    static bool map_open(const char* filename, shared_ptr<const uInt8>& map,
+                         uInt64& length);
 
     /* Error types */
     enum zip_error
@@ -149,14 +162,28 @@ class ZipHandler
       uInt32      rawlength;        /* length of the raw data */
     };
 
+    /* describes a file in the central directory */
+    struct zip_entry
+    {
+      string          name;       /* filename */
+      uInt32          cd_offset;  /* offset of its header in the central directory */
+      uInt32          length;     /* uncompressed size */
+      uInt32          crc;        /* crc-32 */
+    };
+
     /* describes an open ZIP file */
     struct zip_file
     {
       const char*     filename;   /* copy of ZIP filename (for caching) */
       fstream*        file;       /* C++ fstream file handle */
+      shared_ptr<const uInt8> map; /* contents of the file, if memory-mapped */
       uInt64          length;     /* length of zip file */
       uInt16          romfiles;   /* number of ROM files in central directory */
 
+      vector<zip_entry> entries;  /* all (non-empty) files, in directory order */
+      std::unordered_map<string, uInt32> lookup; /* index into entries by name */
+      uInt32          next_entry; /* position of the filename iterator */
+
       zip_ecd         ecd;        /* end of central directory */
 
       uInt8*          cd;         /* central directory raw data */
@@ -254,6 +281,8 @@ class ZipHandler
     static void free_zip_file(zip_file* zip);
 
     /* ZIP file parsing */
+    static bool read_data(zip_file* zip, void* buffer, uInt64 offset,
+                          uInt32 length, uInt32& actual);
     static zip_error read_ecd(zip_file* zip);
     static zip_error get_compressed_data_offset(zip_file* zip, uInt64& offset);
 
@@ -0,0 +1,256 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2018 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "ZipHandler.hxx"
+#include "ZipLoader.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ZipLoader::ZipLoader(uInt32 ahead)
+  : myAhead(std::max(ahead, 1u)),
+    myQuit(false)
+{
+  // Decompressing is CPU bound, but mapping archives still waits on
+  // the disk, so always use at least two workers
+  const uInt32 systemThreads = std::thread::hardware_concurrency();
+  const uInt32 numThreads = std::min(4u, std::max(2u, systemThreads));
+
+  for(uInt32 i = 0; i < numThreads; ++i)
+    myThreads.emplace_back([this] { work(); });
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ZipLoader::~ZipLoader()
+{
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+    myQueue.clear();
+    myQuit = true;
+  }
+  myQueued.notify_all();
+
+  for(auto& t: myThreads)
+    t.join();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ZipLoader::queue(const StringList& paths)
+{
+  std::lock_guard<std::mutex> lock(myMutex);
+
+  // Files which are waited for stay at the front
+  std::unordered_set<string> queued;
+  std::deque<string> queue;
+  for(const auto& path: myQueue)
+    if(myWanted.count(path) > 0 && queued.insert(path).second)
+      queue.push_back(path);
+
+  // Files which are already queued, loaded (or being loaded) aren't
+  // queued again
+  std::unordered_set<string> files;
+  string archive, file;
+  for(const auto& path: paths)
+  {
+    if(!splitPath(path, archive, file) || !files.insert(path).second)
+      continue;
+
+    if(myResults.count(path) == 0 && myLoading.count(path) == 0 &&
+       queued.insert(path).second)
+      queue.push_back(path);
+  }
+  myQueue = std::move(queue);
+
+  // Everything else from the previous list is dropped
+  for(auto it = myResults.begin(); it != myResults.end(); )
+  {
+    if(files.count(it->first) == 0 && myWanted.count(it->first) == 0)
+      it = myResults.erase(it);
+    else
+      ++it;
+  }
+  for(auto& loading: myLoading)
+    loading.second = files.count(loading.first) > 0 ||
+                     myWanted.count(loading.first) > 0;
+
+  myQueued.notify_all();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ZipLoader::prioritize(const string& path)
+{
+  std::lock_guard<std::mutex> lock(myMutex);
+
+  auto it = std::find(myQueue.begin(), myQueue.end(), path);
+  if(it != myQueue.end() && it != myQueue.begin())
+  {
+    myQueue.erase(it);
+    myQueue.push_front(path);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 ZipLoader::load(const string& path, Image& image)
+{
+  string archive, file;
+  if(!splitPath(path, archive, file))
+  {
+    image.reset();
+    return 0;
+  }
+
+  std::unique_lock<std::mutex> lock(myMutex);
+
+  // Several threads may wait for the same file, so the result is only
+  // dropped once the last of them has taken it
+  ++myWanted[path];
+
+  auto it = myResults.find(path);
+  if(it == myResults.end())
+  {
+    auto loading = myLoading.find(path);
+    if(loading != myLoading.end())
+      loading->second = true;
+    else
+    {
+      auto queued = std::find(myQueue.begin(), myQueue.end(), path);
+      if(queued != myQueue.end())
+        myQueue.erase(queued);
+      myQueue.push_front(path);
+      myQueued.notify_all();
+    }
+
+    myFinished.wait(lock, [this, &path] { return myResults.count(path) > 0; });
+    it = myResults.find(path);
+  }
+
+  image = it->second.image;
+  const uInt32 size = it->second.size;
+
+  auto wanted = myWanted.find(path);
+  if(--wanted->second > 0)
+    return size;
+
+  myWanted.erase(wanted);
+  myResults.erase(it);
+
+  // There's room for another file to be loaded in advance
+  myQueued.notify_all();
+
+  return size;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ZipLoader::skip(const string& path)
+{
+  std::lock_guard<std::mutex> lock(myMutex);
+
+  if(myWanted.count(path) > 0)
+    return;
+
+  auto queued = std::find(myQueue.begin(), myQueue.end(), path);
+  if(queued != myQueue.end())
+    myQueue.erase(queued);
+
+  auto loading = myLoading.find(path);
+  if(loading != myLoading.end())
+    loading->second = false;
+
+  if(myResults.erase(path) > 0)
+    myQueued.notify_all();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ZipLoader::cancel()
+{
+  queue(StringList());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ZipLoader::splitPath(const string& path, string& archive, string& file)
+{
+  size_t pos = BSPF::findIgnoreCase(path, ".zip");
+  if(pos == string::npos || pos + 5 >= path.length())
+    return false;
+
+  archive = path.substr(0, pos + 4);
+  file = path.substr(pos + 5);
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+std::deque<string>::iterator ZipLoader::nextFile()
+{
+  if(myResults.size() + myLoading.size() < myAhead)
+    return myQueue.begin();
+
+  return std::find_if(myQueue.begin(), myQueue.end(),
+      [this](const string& path) { return myWanted.count(path) > 0; });
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ZipLoader::work()
+{
+  // Every worker has its own handler, which keeps its recently used
+  // archives open (and mapped)
+  ZipHandler zip;
+  string archive, file;
+
+  std::unique_lock<std::mutex> lock(myMutex);
+  for(;;)
+  {
+    myQueued.wait(lock, [this] { return myQuit || nextFile() != myQueue.end(); });
+    if(myQuit)
+      return;
+
+    auto next = nextFile();
+    const string path = std::move(*next);
+    myQueue.erase(next);
+
+    // A file is never loaded by two workers at once; whoever waits for
+    // it gets the result of the worker already loading it
+    if(!myLoading.emplace(path, true).second)
+      continue;
+
+    // The file is decompressed without holding the lock, so that the other
+    // workers (and whoever is waiting for results) can carry on meanwhile
+    lock.unlock();
+    Result result{nullptr, 0};
+    try
+    {
+      splitPath(path, archive, file);
+      zip.open(archive);
+      if(zip.seek(file))
+        result.size = zip.decompress(result.image);
+    }
+    catch(...)
+    {
+      result.image.reset();
+      result.size = 0;
+    }
+    lock.lock();
+
+    auto loading = myLoading.find(path);
+    if(loading != myLoading.end())
+    {
+      if(loading->second || myWanted.count(path) > 0)
+        myResults[path] = std::move(result);
+      myLoading.erase(loading);
+    }
+
+    myFinished.notify_all();
+    myQueued.notify_all();
+  }
+}
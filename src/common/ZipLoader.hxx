@@ -0,0 +1,139 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2018 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef ZIP_LOADER_HXX
+#define ZIP_LOADER_HXX
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "bspf.hxx"
+
+/**
+  Loads files from ZIP archives for batch jobs which go through a known
+  list of them, using a small pool of worker threads.  The workers decompress
+  the files ahead of the one currently asked for (up to a fixed number), so
+  that these are usually ready by the time they're needed.
+
+  Each worker has its own ZipHandler, so this is independent of the one
+  shared by all FilesystemNodeZIP's.  Archives are memory-mapped where
+  possible; files stored without compression are then not copied at all.
+
+  All methods may be called from any thread.  Every file queued must either
+  be loaded or skipped, since otherwise it takes up room in the prefetch
+  window until cancel() is called.
+*/
+class ZipLoader
+{
+  public:
+    // The contents of a file; this may point into a mapped archive, which
+    // stays mapped as long as it is referenced
+    using Image = shared_ptr<const uInt8>;
+
+    /**
+      Create a loader which decompresses up to 'ahead' files in advance.
+    */
+    ZipLoader(uInt32 ahead = 16);
+    ~ZipLoader();
+
+  public:
+    /**
+      Queue the given files for loading, in the order they will be asked for,
+      replacing any which were still waiting from a previous call.  Paths
+      which aren't inside a ZIP archive are ignored.
+
+      @param paths  The full paths of the files, as used by FilesystemNode
+    */
+    void queue(const StringList& paths);
+
+    /**
+      Move the given file to the front of the queue, if it hasn't been
+      loaded yet.
+    */
+    void prioritize(const string& path);
+
+    /**
+      Get the contents of the given file, waiting until a worker has loaded
+      it.  A file which wasn't queued is loaded before any other.  Several
+      threads may wait for the same file, and all of them get it.
+
+      @return  The size of the file, or 0 if it couldn't be loaded
+    */
+    uInt32 load(const string& path, Image& image);
+
+    /**
+      Forget about the given file, since it won't be loaded after all.
+    */
+    void skip(const string& path);
+
+    /**
+      Drop all files which haven't been loaded yet.
+    */
+    void cancel();
+
+    /**
+      Split the given path into the archive and the file within it.
+
+      @return  False if the path isn't inside a ZIP archive
+    */
+    static bool splitPath(const string& path, string& archive, string& file);
+
+  private:
+    // A file which has been loaded (successfully or not)
+    struct Result {
+      Image image;
+      uInt32 size;
+    };
+
+    // The worker thread loop
+    void work();
+
+    // The next file a worker should load, or the end of the queue if the
+    // prefetch window is full (files which are waited for are always loaded)
+    std::deque<string>::iterator nextFile();
+
+  private:
+    uInt32 myAhead;
+
+    vector<std::thread> myThreads;
+
+    // All following state is shared with the workers, and protected by myMutex
+    std::mutex myMutex;
+    std::condition_variable myQueued;    // Signalled when files can be loaded
+    std::condition_variable myFinished;  // Signalled when files are loaded
+
+    std::deque<string> myQueue;
+    // Files somebody is waiting for, and the number of waiting threads
+    std::unordered_map<string, uInt32> myWanted;
+    std::unordered_map<string, Result> myResults;
+    // Files a worker is busy with, and whether the result is still needed
+    std::unordered_map<string, bool> myLoading;
+    bool myQuit;
+
+  private:
+    // Following constructors and assignment operators not supported
+    ZipLoader(const ZipLoader&) = delete;
+    ZipLoader(ZipLoader&&) = delete;
+    ZipLoader& operator=(const ZipLoader&) = delete;
+    ZipLoader& operator=(ZipLoader&&) = delete;
+};
+
+#endif
@@ -82,6 +82,8 @@ using ByteArray = std::vector<uInt8>;
 using ShortArray = std::vector<uInt16>;
 using StringList = std::vector<std::string>;
 using BytePtr = std::unique_ptr<uInt8[]>;
+// A read-only buffer (such as a ROM image) shared by everything using it
+using ImagePtr = std::shared_ptr<const uInt8>;
 
 static const string EmptyString("");
 
@@ -7,12 +7,15 @@ MODULE_OBJS := \
 	src/common/FrameBufferSDL2.o \
 	src/common/FBSurfaceSDL2.o \
 	src/common/SoundSDL2.o \
+	src/common/Resampler.o \
+	src/common/SoundWAV.o \
 	src/common/FSNodeZIP.o \
 	src/common/PNGLibrary.o \
 	src/common/MouseControl.o \
 	src/common/RewindManager.o \
 	src/common/StateManager.o \
-	src/common/ZipHandler.o
+	src/common/ZipHandler.o \
+	src/common/ZipLoader.o
 
 MODULE_DIRS += \
 	src/common
@@ -64,7 +64,8 @@ Debugger::Debugger(OSystem& osystem, Console& console)
     mySystem(console.system()),
     myDialog(nullptr),
     myWidth(DebuggerDialog::kSmallFontMinW),
-    myHeight(DebuggerDialog::kSmallFontMinH)
+    myHeight(DebuggerDialog::kSmallFontMinH),
+    myARMOverrunTrap(osystem.settings().getBool("dbg.armoverruntrap"))
 {
   // Init parser
   myParser = make_unique<DebuggerParser>(*this, osystem.settings());
@@ -85,6 +86,9 @@ Debugger::Debugger(OSystem& osystem, Console& console)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Debugger::~Debugger()
 {
+  // Don't leave a dangling reference to the console which owned us
+  if(myStaticDebugger == this)
+    myStaticDebugger = nullptr;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -149,6 +153,27 @@ bool Debugger::startWithFatalError(const string& message)
   return false;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Debugger::checkARMOverrun(uInt32 cycles)
+{
+  if(!myARMOverrunTrap)
+    return;
+
+  TIA& tia = myConsole.tia();
+  tia.updateEmulation();
+
+  // Nothing to compare against until a frame has been completed
+  uInt32 frameCycles = tia.scanlinesLastFrame() * 76;
+  uInt32 frameCycle = tia.scanlines() * 76 + tia.clocksThisLine() / 3;
+  if(frameCycles == 0 || frameCycle + cycles <= frameCycles)
+    return;
+
+  ostringstream buf;
+  buf << "ARM code overrun: " << cycles << " cycles, "
+      << (frameCycle + cycles - frameCycles) << " past end of frame";
+  start(buf.str());
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Debugger::quit(bool exitrom)
 {
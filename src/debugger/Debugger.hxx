@@ -96,6 +96,17 @@ class Debugger : public DialogContainer
     bool start(const string& message = "", int address = -1, bool read = true);
     bool startWithFatalError(const string& message = "");
 
+    /**
+      Called by the ARM-based cartridges after running ARM code, with the
+      time it took.  When trapping on ARM overruns is enabled and the code
+      wouldn't have finished before the end of the current frame (taking
+      the last frame's length), enter the debugger with a warning.
+
+      @param cycles  The number of 6507 cycles the ARM code ran for
+    */
+    void checkARMOverrun(uInt32 cycles);
+    void setARMOverrunTrap(bool enable) { myARMOverrunTrap = enable; }
+
     /**
       Wrapper method for EventHandler::leaveDebugMode() for those classes
       that don't have access to EventHandler.
@@ -208,7 +219,12 @@ class Debugger : public DialogContainer
       everywhere, but I feel it's better to place it here then in
       YaccParser (which technically isn't related to it at all).
     */
-    static Debugger& debugger() { return *myStaticDebugger; }
+    static Debugger& debugger()
+    {
+      if(myStaticDebugger == nullptr)
+        throw runtime_error("Debugger not available");
+      return *myStaticDebugger;
+    }
 
     /** Convenience methods to access peek/poke from System */
     uInt8 peek(uInt16 addr, uInt8 flags = 0);
@@ -310,6 +326,9 @@ class Debugger : public DialogContainer
     uInt32 myWidth;
     uInt32 myHeight;
 
+    // Trap on ARM code overruns (cached, since it's checked on every ARM call)
+    bool myARMOverrunTrap;
+
     // Various builtin functions and operations
     struct BuiltinFunction {
       string name, defn, help;
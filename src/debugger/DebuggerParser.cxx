@@ -42,10 +42,14 @@ extern "C"
 #include "Expression.hxx"
 #include "FSNode.hxx"
 #include "Settings.hxx"
+#include "Sound.hxx"
 #include "PromptWidget.hxx"
 #include "RomWidget.hxx"
 #include "ProgressDialog.hxx"
 #include "PackedBitArray.hxx"
+#include "Cart.hxx"
+#include "Console.hxx"
+#include "Thumbulator.hxx"
 #include "Vec.hxx"
 
 #include "Base.hxx"
@@ -789,11 +793,173 @@ static int l_peek(lua_State* L) {
   return 1;
 }
 
+static int l_audio(lua_State* L) {
+  lua_getglobal(L, "_G");
+  lua_getfield(L, -1, "osystem");
+  OSystem* osystem = (OSystem*)lua_touserdata(L, -1);
+  lua_pop(L, 1);
+
+  const Sound::Stats stats = osystem->sound().stats();
+  lua_newtable(L);
+
+  lua_pushinteger(L, stats.callbacks);
+  lua_setfield(L, -2, "callbacks");
+  lua_pushinteger(L, stats.underruns);
+  lua_setfield(L, -2, "underruns");
+  lua_pushnumber(L, stats.queueDepth);
+  lua_setfield(L, -2, "latency");
+  lua_pushnumber(L, stats.targetDepth);
+  lua_setfield(L, -2, "target");
+  lua_pushnumber(L, stats.callbackInterval);
+  lua_setfield(L, -2, "interval");
+  lua_pushnumber(L, stats.jitter);
+  lua_setfield(L, -2, "jitter");
+  lua_pushboolean(L, stats.adaptive);
+  lua_setfield(L, -2, "adaptive");
+
+  return 1;
+}
+
+static int l_audioframe(lua_State* L) {
+  lua_getglobal(L, "_G");
+  lua_getfield(L, -1, "debugger");
+  Debugger* debugger = (Debugger*)lua_touserdata(L, -1);
+  lua_pop(L, 2);
+
+  AudioCapture& capture = debugger->tiaDebug().tia().audioCapture();
+  if(lua_isboolean(L, 1))
+    capture.enableSamples(lua_toboolean(L, 1));
+
+  static const char* const names[] = {
+    "audc0", "audc1", "audf0", "audf1", "audv0", "audv1"
+  };
+  const AudioCapture::Frame& frame = capture.lastFrame();
+  lua_newtable(L);
+
+  lua_pushinteger(L, frame.startCycle);
+  lua_setfield(L, -2, "start");
+  lua_pushinteger(L, frame.cycles);
+  lua_setfield(L, -2, "cycles");
+
+  // Register values at the start of the frame
+  lua_createtable(L, 0, 6);
+  for(int i = 0; i < 6; ++i)
+  {
+    lua_pushinteger(L, frame.registers[i]);
+    lua_setfield(L, -2, names[i]);
+  }
+  lua_setfield(L, -2, "registers");
+
+  // Every write during the frame, in order
+  lua_createtable(L, int(frame.events.size()), 0);
+  for(uInt32 i = 0; i < frame.events.size(); ++i)
+  {
+    const AudioCapture::Event& event = frame.events[i];
+    const int reg = event.address - TIARegister::AUDC0;
+
+    lua_createtable(L, 0, 4);
+    lua_pushinteger(L, event.cycle);
+    lua_setfield(L, -2, "cycle");
+    lua_pushinteger(L, reg & 1);
+    lua_setfield(L, -2, "channel");
+    lua_pushlstring(L, names[reg], 4);
+    lua_setfield(L, -2, "register");
+    lua_pushinteger(L, event.value);
+    lua_setfield(L, -2, "value");
+    lua_rawseti(L, -2, i + 1);
+  }
+  lua_setfield(L, -2, "events");
+
+  // Samples are passed as a string of native-endian 16-bit values, to avoid
+  // building a table of over a thousand numbers every frame
+  if(capture.samplesEnabled())
+  {
+    lua_pushlstring(L, reinterpret_cast<const char*>(frame.samples.data()),
+                    frame.samples.size() * sizeof(Int16));
+    lua_setfield(L, -2, "samples");
+    lua_pushinteger(L, TIASound::NATIVE_FREQUENCY);
+    lua_setfield(L, -2, "rate");
+  }
+
+  return 1;
+}
+
+static int l_armprofile(lua_State* L) {
+  lua_getglobal(L, "_G");
+  lua_getfield(L, -1, "osystem");
+  OSystem* osystem = (OSystem*)lua_touserdata(L, -1);
+  lua_pop(L, 2);
+
+  // Only the ARM-based schemes have a profile
+  Thumbulator* thumb = osystem->console().cartridge().thumbulator();
+  if(thumb == nullptr)
+  {
+    lua_pushnil(L);
+    return 1;
+  }
+  if(lua_isboolean(L, 1))
+    thumb->enableProfiling(lua_toboolean(L, 1));
+  else if(lua_isstring(L, 1) && BSPF::equalsIgnoreCase(lua_tostring(L, 1), "reset"))
+    thumb->resetProfile();
+  const uInt32 max = lua_isnumber(L, 2) ? uInt32(lua_tointeger(L, 2)) : 256;
+
+  lua_newtable(L);
+  lua_pushboolean(L, thumb->profilingEnabled());
+  lua_setfield(L, -2, "enabled");
+
+  const Thumbulator::Profile* profile = thumb->profile();
+  if(profile == nullptr)
+    return 1;
+
+  lua_pushinteger(L, profile->callCount);
+  lua_setfield(L, -2, "calls");
+  lua_pushinteger(L, profile->instructions);
+  lua_setfield(L, -2, "instructions");
+  lua_pushinteger(L, profile->cycles);
+  lua_setfield(L, -2, "cycles");
+
+  // The most recent calls, oldest first
+  lua_createtable(L, int(profile->calls.size()), 0);
+  for(uInt32 i = 0; i < profile->calls.size(); ++i)
+  {
+    lua_createtable(L, 0, 2);
+    lua_pushinteger(L, profile->calls[i].instructions);
+    lua_setfield(L, -2, "instructions");
+    lua_pushinteger(L, profile->calls[i].cycles);
+    lua_setfield(L, -2, "cycles");
+    lua_rawseti(L, -2, i + 1);
+  }
+  lua_setfield(L, -2, "recent");
+
+  // Where the cycles were spent, most first
+  const vector<Thumbulator::HotSpot> spots = thumb->hotSpots(max);
+  lua_createtable(L, int(spots.size()), 0);
+  for(uInt32 i = 0; i < spots.size(); ++i)
+  {
+    lua_createtable(L, 0, 4);
+    lua_pushinteger(L, spots[i].address);
+    lua_setfield(L, -2, "address");
+    lua_pushinteger(L, spots[i].counter.count);
+    lua_setfield(L, -2, "count");
+    lua_pushinteger(L, spots[i].counter.cycles);
+    lua_setfield(L, -2, "cycles");
+    lua_pushstring(L, thumb->disassemble(spots[i].address).c_str());
+    lua_setfield(L, -2, "disasm");
+    lua_rawseti(L, -2, i + 1);
+  }
+  lua_setfield(L, -2, "hotspots");
+
+  return 1;
+}
+
 static const struct luaL_Reg printlib [] = {
   {"print", l_my_print},
   {"cpu", l_cpu},
   {"label", l_label},
   {"peek", l_peek},
+  {"audio", l_audio},
+  {"audioframe", l_audioframe},
+  {"armprofile", l_armprofile},
   {NULL, NULL} /* end of array */
 };
 
@@ -855,6 +1021,9 @@ void DebuggerParser::executeLua()
   lua_pushlightuserdata(L, &debugger);
   lua_setfield(L, -2, "debugger");
 
+  lua_pushlightuserdata(L, &debugger.myOSystem);
+  lua_setfield(L, -2, "osystem");
+
   lua_pop(L, 1);
 
   status = luaL_loadfile(L, filename.c_str());
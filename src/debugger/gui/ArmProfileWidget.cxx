@@ -0,0 +1,139 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2018 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "EditTextWidget.hxx"
+#include "GuiObject.hxx"
+#include "Font.hxx"
+#include "StringListWidget.hxx"
+#include "Thumbulator.hxx"
+#include "Widget.hxx"
+#include "ArmProfileWidget.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ArmProfileWidget::ArmProfileWidget(
+      GuiObject* boss, const GUI::Font& lfont, const GUI::Font& nfont,
+      int x, int y, int w, int h, Thumbulator& thumb)
+  : Widget(boss, lfont, x, y, w, h),
+    CommandSender(boss),
+    myThumb(thumb)
+{
+  const int fontHeight = lfont.getFontHeight(),
+            lineHeight = lfont.getLineHeight();
+  int xpos = 2, ypos = 5;
+  int lwidth = lfont.getStringWidth("Last call "),
+      fwidth = w - lwidth - 20;
+
+  myEnable = new CheckboxWidget(boss, lfont, xpos, ypos + 1, "Profile ARM code",
+                                CheckboxWidget::kCheckActionCmd);
+  myEnable->setTarget(this);
+  addFocusWidget(myEnable);
+
+  int bwidth = lfont.getStringWidth("Reset") + 20;
+  ButtonWidget* b = new ButtonWidget(boss, lfont, w - bwidth - 10, ypos - 1,
+                                     bwidth, lineHeight + 2, "Reset", kResetCmd);
+  b->setTarget(this);
+  addFocusWidget(b);
+  ypos += lineHeight + 8;
+
+  auto addField = [&](const string& label) {
+    new StaticTextWidget(boss, lfont, xpos, ypos + 1, lwidth, fontHeight,
+                         label, TextAlign::Left);
+    EditTextWidget* etw = new EditTextWidget(boss, nfont, xpos + lwidth, ypos,
+                                             fwidth, lineHeight);
+    etw->setEditable(false);
+    ypos += lineHeight + 4;
+    return etw;
+  };
+  myCalls    = addField("Calls ");
+  myAverage  = addField("Per call ");
+  myLastCall = addField("Last call ");
+
+  ypos += 4;
+  new StaticTextWidget(boss, lfont, xpos, ypos, w - 20, fontHeight,
+                       "Hot spots (address, count, ARM cycles, share)",
+                       TextAlign::Left);
+  ypos += lineHeight;
+  myHotSpots = new StringListWidget(boss, nfont, xpos, ypos,
+                                    w - 10, h - ypos - 5, false);
+  myHotSpots->setEditable(false);
+  addFocusWidget(myHotSpots);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ArmProfileWidget::loadConfig()
+{
+  myEnable->setState(myThumb.profilingEnabled());
+
+  const Thumbulator::Profile* profile = myThumb.profile();
+  StringList hotSpots;
+  if(!profile || profile->callCount == 0)
+  {
+    myCalls->setText("");
+    myAverage->setText("");
+    myLastCall->setText("");
+    myHotSpots->setList(hotSpots);
+    return;
+  }
+
+  ostringstream buf;
+  buf << profile->callCount << " (" << profile->instructions << " instructions, "
+      << profile->cycles << " ARM cycles)";
+  myCalls->setText(buf.str());
+
+  buf.str("");
+  buf << (profile->instructions / profile->callCount) << " instructions, "
+      << (profile->cycles / profile->callCount) << " ARM cycles";
+  myAverage->setText(buf.str());
+
+  const Thumbulator::ProfileCall& last = profile->calls.back();
+  buf.str("");
+  buf << last.instructions << " instructions, " << last.cycles << " ARM cycles";
+  myLastCall->setText(buf.str());
+
+  for(const auto& spot: myThumb.hotSpots(HOT_SPOTS))
+  {
+    buf.str("");
+    buf << std::hex << std::setfill('0') << std::setw(8) << spot.address
+        << std::dec << std::setfill(' ')
+        << std::setw(11) << spot.counter.count
+        << std::setw(12) << spot.counter.cycles
+        << std::setw(6) << std::fixed << std::setprecision(1)
+        << (100.0 * spot.counter.cycles / profile->cycles) << "%  "
+        << myThumb.disassemble(spot.address);
+    hotSpots.push_back(buf.str());
+  }
+  myHotSpots->setList(hotSpots);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ArmProfileWidget::handleCommand(CommandSender* sender, int cmd, int data, int id)
+{
+  switch(cmd)
+  {
+    case CheckboxWidget::kCheckActionCmd:
+      myThumb.enableProfiling(myEnable->getState());
+      break;
+
+    case kResetCmd:
+      myThumb.resetProfile();
+      loadConfig();
+      break;
+
+    default:
+      break;
+  }
+}
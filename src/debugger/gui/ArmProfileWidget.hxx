@@ -0,0 +1,73 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2018 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef ARM_PROFILE_WIDGET_HXX
+#define ARM_PROFILE_WIDGET_HXX
+
+class GuiObject;
+class CheckboxWidget;
+class EditTextWidget;
+class StringListWidget;
+class Thumbulator;
+
+#include "Widget.hxx"
+#include "Command.hxx"
+
+/**
+  Shows the execution profile of the ARM code of DPC+, CDF and BUS carts:
+  totals for the calls into the ARM code, and the addresses where most
+  ARM cycles were spent, with their disassembly.
+*/
+class ArmProfileWidget : public Widget, public CommandSender
+{
+  public:
+    ArmProfileWidget(GuiObject* boss, const GUI::Font& lfont,
+                     const GUI::Font& nfont,
+                     int x, int y, int w, int h, Thumbulator& thumb);
+    virtual ~ArmProfileWidget() = default;
+
+    void loadConfig() override;
+
+  private:
+    void handleCommand(CommandSender* sender, int cmd, int data, int id) override;
+
+  private:
+    enum {
+      kResetCmd = 'APrs'
+    };
+
+    // The number of hot spots listed
+    static constexpr uInt32 HOT_SPOTS = 256;
+
+    Thumbulator& myThumb;
+
+    CheckboxWidget* myEnable;
+    EditTextWidget* myCalls;
+    EditTextWidget* myAverage;
+    EditTextWidget* myLastCall;
+    StringListWidget* myHotSpots;
+
+  private:
+    // Following constructors and assignment operators not supported
+    ArmProfileWidget() = delete;
+    ArmProfileWidget(const ArmProfileWidget&) = delete;
+    ArmProfileWidget(ArmProfileWidget&&) = delete;
+    ArmProfileWidget& operator=(const ArmProfileWidget&) = delete;
+    ArmProfileWidget& operator=(ArmProfileWidget&&) = delete;
+};
+
+#endif
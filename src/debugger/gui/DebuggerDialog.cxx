@@ -34,6 +34,7 @@
 #include "TiaWidget.hxx"
 #include "CartDebugWidget.hxx"
 #include "CartRamWidget.hxx"
+#include "ArmProfileWidget.hxx"
 #include "DataGridOpsWidget.hxx"
 #include "EditTextWidget.hxx"
 #include "MessageBox.hxx"
@@ -586,6 +587,18 @@ void DebuggerDialog::addRomArea()
     }
   }
 
+  // The ARM profile tab, for carts running ARM code
+  Thumbulator* thumb = instance().console().cartridge().thumbulator();
+  if(thumb)
+  {
+    tabID = myRomTab->addTab(" ARM Profile ");
+    ArmProfileWidget* arm =
+      new ArmProfileWidget(myRomTab, *myLFont, *myNFont, 2, 2, tabWidth - 1,
+                           tabHeight - myRomTab->getTabHeight() - 2, *thumb);
+    myRomTab->setParentWidget(tabID, arm);
+    addToFocusList(arm->getFocusList(), myRomTab, tabID);
+  }
+
   myRomTab->setActiveTab(0);
 }
 
@@ -30,7 +30,8 @@ Cartridge::Cartridge(const Settings& settings)
     myStartBank(0),
     myBankChanged(true),
     myCodeAccessBase(nullptr),
-    myBankLocked(false)
+    myBankLocked(false),
+    myImageSize(0)
 {
 }
 
@@ -72,7 +73,7 @@ bool Cartridge::bankChanged()
 void Cartridge::triggerReadFromWritePort(uInt16 address)
 {
 #ifdef DEBUGGER_SUPPORT
-  if(!mySystem->autodetectMode())
+  if(!mySystem->autodetectMode() && !mySystem->headless())
     Debugger::debugger().cartDebug().triggerReadFromWritePort(address);
 #endif
 }
@@ -88,6 +89,105 @@ void Cartridge::createCodeAccessBase(uInt32 size)
 #endif
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Cartridge::createBankPages(const uInt8* image, uInt16 banks, uInt16 hotspot,
+                                uInt8* ram, uInt16 ramSize)
+{
+  myBankPages.resize(banks * BANK_PAGES);
+
+  System::PageAccess* pages = myBankPages.data();
+  for(uInt32 offset = 0; offset < uInt32(banks) << 12; offset += 0x1000)
+  {
+    System::PageAccess access(this, System::PA_READ);
+
+    // Set the page accessing method for the RAM writing pages
+    uInt16 addr = 0x1000;
+    access.type = System::PA_WRITE;
+    for(; addr < 0x1000 + ramSize; addr += System::PAGE_SIZE)
+    {
+      access.directPokeBase = &ram[addr & (ramSize - 1)];
+      access.codeAccessBase = &myCodeAccessBase[addr & (ramSize - 1)];
+      *pages++ = access;
+    }
+
+    // Set the page accessing method for the RAM reading pages
+    access.directPokeBase = nullptr;
+    access.type = System::PA_READ;
+    for(; addr < 0x1000 + 2 * ramSize; addr += System::PAGE_SIZE)
+    {
+      access.directPeekBase = &ram[addr & (ramSize - 1)];
+      access.codeAccessBase = &myCodeAccessBase[ramSize + (addr & (ramSize - 1))];
+      *pages++ = access;
+    }
+
+    // Setup the page access methods for the bank
+    for(; addr < (hotspot & ~System::PAGE_MASK); addr += System::PAGE_SIZE)
+    {
+      access.directPeekBase = &image[offset + (addr & 0x0FFF)];
+      access.codeAccessBase = &myCodeAccessBase[offset + (addr & 0x0FFF)];
+      *pages++ = access;
+    }
+
+    // Set the page accessing methods for the hot spots
+    access.directPeekBase = nullptr;
+    for(; addr < 0x2000; addr += System::PAGE_SIZE)
+    {
+      access.codeAccessBase = &myCodeAccessBase[offset + (addr & 0x0FFF)];
+      *pages++ = access;
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const uInt8* Cartridge::shareImage(const ImagePtr& image, uInt32 size)
+{
+  mySharedImage = image;
+  myImageSize = size;
+
+  return mySharedImage.get();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt8* Cartridge::unshareImage(const uInt8*& image)
+{
+  if(!myUnsharedImage)
+  {
+    myUnsharedImage = make_unique<uInt8[]>(myImageSize);
+    std::copy_n(mySharedImage.get(), myImageSize, myUnsharedImage.get());
+    relocatePages(mySharedImage.get(), myUnsharedImage.get(), myImageSize);
+    mySharedImage.reset();
+  }
+
+  image = myUnsharedImage.get();
+  return myUnsharedImage.get();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Cartridge::relocatePages(const uInt8* from, const uInt8* to, uInt32 size)
+{
+  auto relocate = [from, to, size](System::PageAccess& access) {
+    if(access.directPeekBase < from || access.directPeekBase >= from + size)
+      return false;
+
+    access.directPeekBase = to + (access.directPeekBase - from);
+    return true;
+  };
+
+  // The precomputed pages come first, since the system may be using them
+  for(auto& access: myBankPages)
+    relocate(access);
+
+  if(mySystem)
+  {
+    for(uInt32 addr = 0; addr < 0x2000; addr += System::PAGE_SIZE)
+    {
+      System::PageAccess access = mySystem->getPageAccess(addr);
+      if(relocate(access))
+        mySystem->setPageAccess(addr, access);
+    }
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Cartridge::initializeRAM(uInt8* arr, uInt32 size, uInt8 val) const
 {
@@ -23,10 +23,12 @@ class Properties;
 class CartDebugWidget;
 class CartRamWidget;
 class GuiObject;
+class Thumbulator;
 
 #include "bspf.hxx"
 #include "Device.hxx"
 #include "Settings.hxx"
+#include "System.hxx"
 #include "Font.hxx"
 
 /**
@@ -160,6 +162,12 @@ class Cartridge : public Device
     */
     virtual uInt32 thumbCallback(uInt8 function, uInt32 value1, uInt32 value2) { return 0; }
 
+    /**
+      Answers the ARM emulator of the carts which run ARM code (DPC+, CDF
+      and BUS), otherwise nullptr.
+    */
+    virtual Thumbulator* thumbulator() const { return nullptr; }
+
     /**
       Get debugger widget responsible for accessing the inner workings
       of the cart.  This will need to be overridden and implemented by
@@ -186,6 +194,54 @@ class Cartridge : public Device
     */
     void createCodeAccessBase(uInt32 size);
 
+    /**
+      Precompute the page accessing methods for each of the 4K banks of
+      the given image, so that a bank can be switched into the cart space
+      with mapBank().  Each bank is read directly, except for the pages from
+      the one holding the lowest hotspot upwards, which are read through
+      peek().  Carts with RAM have its write port at the start of each bank,
+      followed by its read port.
+
+      @param image    The ROM image, consisting of the banks
+      @param banks    The number of banks
+      @param hotspot  The lowest hotspot address, or 0x2000 if there are none
+      @param ram      The RAM, or nullptr if there is none
+      @param ramSize  The size of the RAM (and of each of its ports)
+    */
+    void createBankPages(const uInt8* image, uInt16 banks, uInt16 hotspot,
+                         uInt8* ram = nullptr, uInt16 ramSize = 0);
+
+    /**
+      Switch the given bank into the cart space, using the pages
+      precomputed by createBankPages().
+    */
+    void mapBank(uInt16 bank) {
+      mySystem->mapPages(0x1000, &myBankPages[bank * BANK_PAGES], 0x1000);
+    }
+
+    /**
+      Use the given image as the ROM, without copying it.  The image is
+      shared with everything else using it (such as other consoles for the
+      same ROM), so it must not be changed; see unshareImage().
+
+      @param image  The ROM image
+      @param size   The size of the image
+
+      @return  A pointer to the image
+    */
+    const uInt8* shareImage(const ImagePtr& image, uInt32 size);
+
+    /**
+      Get a private copy of the image from shareImage(), which can then be
+      patched.  The copy is made the first time, and any pages reading the
+      shared image directly are pointed at the copy instead.
+
+      @param image  Set to the copy
+
+      @return  The copy
+    */
+    uInt8* unshareImage(const uInt8*& image);
+
     /**
       Fill the given RAM array with (possibly random) data.
 
@@ -229,11 +285,28 @@ class Cartridge : public Device
     // whether it is used as code.
     BytePtr myCodeAccessBase;
 
+    // The page accessing methods for each bank (or segment) which can be
+    // switched in, precomputed so that switching only needs to map them
+    // into the system (see System::mapPages)
+    vector<System::PageAccess> myBankPages;
+
+    // Number of pages in a 4K bank
+    static constexpr uInt16 BANK_PAGES = 0x1000 / System::PAGE_SIZE;
+
+  private:
+    // Point the pages reading directly from one image at another one
+    void relocatePages(const uInt8* from, const uInt8* to, uInt32 size);
+
   private:
     // If myBankLocked is true, ignore attempts at bankswitching. This is used
     // by the debugger, when disassembling/dumping ROM.
     bool myBankLocked;
 
+    // The image from shareImage(), until it's replaced by a private copy
+    ImagePtr mySharedImage;
+    BytePtr myUnsharedImage;
+    uInt32 myImageSize;
+
     // Contains various info about this cartridge
     // This needs to be stored separately from child classes, since
     // sometimes the information in both do not match
@@ -19,7 +19,7 @@
 #include "Cart0840.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Cartridge0840::Cartridge0840(const BytePtr& image, uInt32 size,
+Cartridge0840::Cartridge0840(const ImagePtr& image, uInt32 size,
                              const Settings& settings)
   : Cartridge(settings),
     myBankOffset(0)
@@ -60,6 +60,9 @@ void Cartridge0840::install(System& system)
   for(uInt16 addr = 0x0800; addr < 0x0FFF; addr += System::PAGE_SIZE)
     mySystem->setPageAccess(addr, access);
 
+  // Precompute the pages of all banks, which are read directly
+  createBankPages(myImage, bankCount(), 0x2000);
+
   // Install pages for bank 0
   bank(myStartBank);
 }
@@ -133,16 +136,8 @@ bool Cartridge0840::bank(uInt16 bank)
   // Remember what bank we're in
   myBankOffset = bank << 12;
 
-  // Setup the page access methods for the current bank
-  System::PageAccess access(this, System::PA_READ);
-
-  // Map ROM image into the system
-  for(uInt16 addr = 0x1000; addr < 0x2000; addr += System::PAGE_SIZE)
-  {
-    access.directPeekBase = &myImage[myBankOffset + (addr & 0x0FFF)];
-    access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
-    mySystem->setPageAccess(addr, access);
-  }
+  // Switch in the precomputed pages of the bank
+  mapBank(bank);
   return myBankChanged = true;
 }
 
@@ -206,7 +201,7 @@ bool Cartridge0840::load(Serializer& in)
   }
 
   // Remember what bank we were in
-  bank(myBankOffset);
+  bank(myBankOffset >> 12);
 
   return true;
 }
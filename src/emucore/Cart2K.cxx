@@ -19,7 +19,7 @@
 #include "Cart2K.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Cartridge2K::Cartridge2K(const BytePtr& image, uInt32 size,
+Cartridge2K::Cartridge2K(const ImagePtr& image, uInt32 size,
                          const Settings& settings)
   : Cartridge(settings)
 {
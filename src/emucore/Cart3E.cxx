@@ -20,17 +20,14 @@
 #include "Cart3E.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Cartridge3E::Cartridge3E(const BytePtr& image, uInt32 size,
+Cartridge3E::Cartridge3E(const ImagePtr& image, uInt32 size,
                          const Settings& settings)
   : Cartridge(settings),
     mySize(size),
     myCurrentBank(0)
 {
-  // Allocate array for the ROM image
-  myImage = make_unique<uInt8[]>(mySize);
-
-  // Copy the ROM image into my buffer
-  memcpy(myImage.get(), image.get(), mySize);
+  // Use the ROM image in place, rather than copying it
+  myImage = shareImage(image, mySize);
   createCodeAccessBase(mySize + 32768);
 
   // Remember startup bank
@@ -66,6 +63,41 @@ void Cartridge3E::install(System& system)
     mySystem->setPageAccess(addr, access);
   }
 
+  // Precompute the pages of every ROM bank for the first segment
+  myBankPages.clear();
+  for(uInt32 offset = 0; offset < (mySize & ~0x07FFu); offset += 2048)
+  {
+    for(uInt16 addr = 0x1000; addr < 0x1800; addr += System::PAGE_SIZE)
+    {
+      access.directPeekBase = &myImage[offset + (addr & 0x07FF)];
+      access.codeAccessBase = &myCodeAccessBase[offset + (addr & 0x07FF)];
+      myBankPages.push_back(access);
+    }
+  }
+
+  // Followed by those of every RAM bank, with the read port in the lower
+  // half of the segment and the write port in the upper half
+  for(uInt32 offset = 0; offset < 32768; offset += 1024)
+  {
+    access.directPokeBase = nullptr;
+    access.type = System::PA_READ;
+    for(uInt16 addr = 0x1000; addr < 0x1400; addr += System::PAGE_SIZE)
+    {
+      access.directPeekBase = &myRAM[offset + (addr & 0x03FF)];
+      access.codeAccessBase = &myCodeAccessBase[mySize + offset + (addr & 0x03FF)];
+      myBankPages.push_back(access);
+    }
+
+    access.directPeekBase = nullptr;
+    access.type = System::PA_WRITE;
+    for(uInt16 addr = 0x1400; addr < 0x1800; addr += System::PAGE_SIZE)
+    {
+      access.directPokeBase = &myRAM[offset + (addr & 0x03FF)];
+      access.codeAccessBase = &myCodeAccessBase[mySize + offset + (addr & 0x03FF)];
+      myBankPages.push_back(access);
+    }
+  }
+
   // Install pages for the startup bank into the first segment
   bank(myStartBank);
 }
@@ -148,16 +180,8 @@ bool Cartridge3E::bank(uInt16 bank)
 
     uInt32 offset = myCurrentBank << 11;
 
-    // Setup the page access methods for the current bank
-    System::PageAccess access(this, System::PA_READ);
-
-    // Map ROM image into the system
-    for(uInt16 addr = 0x1000; addr < 0x1800; addr += System::PAGE_SIZE)
-    {
-      access.directPeekBase = &myImage[offset + (addr & 0x07FF)];
-      access.codeAccessBase = &myCodeAccessBase[offset + (addr & 0x07FF)];
-      mySystem->setPageAccess(addr, access);
-    }
+    // Switch in the precomputed pages of the ROM bank
+    mySystem->mapPages(0x1000, &myBankPages[offset >> System::PAGE_SHIFT], 0x0800);
   }
   else
   {
@@ -165,29 +189,11 @@ bool Cartridge3E::bank(uInt16 bank)
     bank %= 32;
     myCurrentBank = bank + 256;
 
-    uInt32 offset = bank << 10;
-
-    // Setup the page access methods for the current bank
-    System::PageAccess access(this, System::PA_READ);
+    // The RAM banks follow the ROM banks, using a whole segment each
+    uInt32 offset = (mySize & ~0x07FFu) + (bank << 11);
 
-    // Map read-port RAM image into the system
-    for(uInt16 addr = 0x1000; addr < 0x1400; addr += System::PAGE_SIZE)
-    {
-      access.directPeekBase = &myRAM[offset + (addr & 0x03FF)];
-      access.codeAccessBase = &myCodeAccessBase[mySize + offset + (addr & 0x03FF)];
-      mySystem->setPageAccess(addr, access);
-    }
-
-    access.directPeekBase = nullptr;
-    access.type = System::PA_WRITE;
-
-    // Map write-port RAM image into the system
-    for(uInt16 addr = 0x1400; addr < 0x1800; addr += System::PAGE_SIZE)
-    {
-      access.directPokeBase = &myRAM[offset + (addr & 0x03FF)];
-      access.codeAccessBase = &myCodeAccessBase[mySize + offset + (addr & 0x03FF)];
-      mySystem->setPageAccess(addr, access);
-    }
+    // Switch in the precomputed pages of the RAM bank
+    mySystem->mapPages(0x1000, &myBankPages[offset >> System::PAGE_SHIFT], 0x0800);
   }
   return myBankChanged = true;
 }
@@ -217,12 +223,12 @@ bool Cartridge3E::patch(uInt16 address, uInt8 value)
   if(address < 0x0800)
   {
     if(myCurrentBank < 256)
-      myImage[(address & 0x07FF) + (myCurrentBank << 11)] = value;
+      unshareImage(myImage)[(address & 0x07FF) + (myCurrentBank << 11)] = value;
     else
       myRAM[(address & 0x03FF) + ((myCurrentBank - 256) << 10)] = value;
   }
   else
-    myImage[(address & 0x07FF) + mySize - 2048] = value;
+    unshareImage(myImage)[(address & 0x07FF) + mySize - 2048] = value;
 
   return myBankChanged = true;
 }
@@ -231,7 +237,7 @@ bool Cartridge3E::patch(uInt16 address, uInt8 value)
 const uInt8* Cartridge3E::getImage(uInt32& size) const
 {
   size = mySize;
-  return myImage.get();
+  return myImage;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -73,7 +73,7 @@ class Cartridge3E : public Cartridge
       @param size      The size of the ROM image
       @param settings  A reference to the various settings (read-only)
     */
-    Cartridge3E(const BytePtr& image, uInt32 size, const Settings& settings);
+    Cartridge3E(const ImagePtr& image, uInt32 size, const Settings& settings);
     virtual ~Cartridge3E() = default;
 
   public:
@@ -177,8 +177,8 @@ class Cartridge3E : public Cartridge
     bool poke(uInt16 address, uInt8 value) override;
 
   private:
-    // Pointer to a dynamically allocated ROM image of the cartridge
-    BytePtr myImage;
+    // The ROM image of the cartridge, shared until it's patched
+    const uInt8* myImage;
 
     // RAM contents. For now every ROM gets all 32K of potential RAM
     uInt8 myRAM[32 * 1024];
@@ -20,16 +20,13 @@
 #include "Cart3EPlus.hxx"
 
 //  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Cartridge3EPlus::Cartridge3EPlus(const BytePtr& image, uInt32 size,
+Cartridge3EPlus::Cartridge3EPlus(const ImagePtr& image, uInt32 size,
                                  const Settings& settings)
   : Cartridge(settings),
     mySize(size)
 {
-  // Allocate array for the ROM image
-  myImage = make_unique<uInt8[]>(mySize);
-
-  // Copy the ROM image into my buffer
-  memcpy(myImage.get(), image.get(), mySize);
+  // Use the ROM image in place, rather than copying it
+  myImage = shareImage(image, mySize);
   createCodeAccessBase(mySize + RAM_TOTAL_SIZE);
 
   // Remember startup bank (0 per spec, rather than last per 3E scheme).
@@ -65,6 +62,48 @@ void Cartridge3EPlus::install(System& system)
   for(uInt16 addr = 0x00; addr < 0x40; addr += System::PAGE_SIZE)
     mySystem->setPageAccess(addr, access);
 
+  // Precompute the pages of every 1K ROM bank; these are the same for
+  // each segment, which is exactly one window of the system
+  myBankPages.clear();
+  access.type = System::PA_READ;
+  for(uInt32 offset = 0; offset < romBanks() * ROM_BANK_SIZE; offset += ROM_BANK_SIZE)
+  {
+    for(uInt16 addr = 0; addr < ROM_BANK_SIZE; addr += System::PAGE_SIZE)
+    {
+      access.directPeekBase = &myImage[offset + addr];
+      access.codeAccessBase = &myCodeAccessBase[offset + addr];
+      myBankPages.push_back(access);
+    }
+  }
+
+  // Followed by those of every RAM bank, with the read port in the lower
+  // half of the segment and the write port in the upper half
+  for(uInt32 offset = 0; offset < RAM_TOTAL_SIZE; offset += RAM_BANK_SIZE)
+  {
+    access.directPokeBase = nullptr;
+    access.type = System::PA_READ;
+    for(uInt16 addr = 0; addr < RAM_BANK_SIZE; addr += System::PAGE_SIZE)
+    {
+      access.directPeekBase = &myRAM[offset + addr];
+      access.codeAccessBase = &myCodeAccessBase[mySize + offset + addr];
+      myBankPages.push_back(access);
+    }
+
+    access.directPeekBase = nullptr;
+    access.type = System::PA_WRITE;
+    for(uInt16 addr = 0; addr < RAM_BANK_SIZE; addr += System::PAGE_SIZE)
+    {
+      access.directPokeBase = &myRAM[offset + addr];
+      access.codeAccessBase = &myCodeAccessBase[mySize + offset + addr];
+      myBankPages.push_back(access);
+    }
+  }
+
+  // And finally those of a segment without a bank, which go through
+  // peek/poke
+  myBankPages.insert(myBankPages.end(), System::WINDOW_PAGES,
+                     System::PageAccess(this, System::PA_READ));
+
   // Initialise bank values for all ROM/RAM access
   // This is used to reverse-lookup from address to bank location
   for(uInt32 b = 0; b < 8; ++b)
@@ -141,56 +180,15 @@ bool Cartridge3EPlus::bankRAM(uInt8 bank)
   if(bankLocked())  // debugger can lock RAM
     return false;
 
-//cerr << "bankRAM " << int(bank) << endl;
-
   // Each RAM bank uses two slots, separated by 0x200 in memory -- one read, one write.
-  bankRAMSlot(bank | BITMASK_ROMRAM | 0);
-  bankRAMSlot(bank | BITMASK_ROMRAM | BITMASK_LOWERUPPER);
+  uInt16 segment = (bank >> BANK_BITS) & 3;  // which 1K segment we are switching (BITS D6,D7)
+  bankInUse[segment * 2]     = bank | BITMASK_ROMRAM;
+  bankInUse[segment * 2 + 1] = bank | BITMASK_ROMRAM | BITMASK_LOWERUPPER;
+  mapSegment(segment);
 
   return myBankChanged = true;
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void Cartridge3EPlus::bankRAMSlot(uInt16 bank)
-{
-  uInt16 bankNumber = (bank >> BANK_BITS) & 3;  // which bank # we are switching TO (BITS D6,D7) to 512 byte block
-  uInt16 currentBank = bank & BIT_BANK_MASK;    // Wrap around/restrict to valid range
-  bool upper = bank & BITMASK_LOWERUPPER;       // is this the read or write port
-
-  uInt32 startCurrentBank = currentBank << RAM_BANK_TO_POWER;  // Effectively * 512 bytes
-//cerr << "raw bank=" << std::dec << currentBank << endl
-//     << "startCurrentBank=$" << std::hex << startCurrentBank << endl;
-  // Setup the page access methods for the current bank
-  System::PageAccess access(this, System::PA_READ);
-
-  if(upper)    // We're mapping the write port
-  {
-    bankInUse[bankNumber * 2 + 1] = Int16(bank);
-    access.type = System::PA_WRITE;
-  }
-  else         // We're mapping the read port
-  {
-    bankInUse[bankNumber * 2] = Int16(bank);
-    access.type = System::PA_READ;
-  }
-
-  uInt16 start = 0x1000 + (bankNumber << (RAM_BANK_TO_POWER+1)) + (upper ? RAM_WRITE_OFFSET : 0);
-  uInt16 end = start + RAM_BANK_SIZE - 1;
-
-//cerr << "bank RAM: " << bankNumber << " -> " << (bankNumber * 2 + (upper ? 1 : 0)) << (upper ? " (W)" : " (R)") << endl
-//     << "start=" << std::hex << start << ", end=" << end << endl << endl;
-  for(uInt16 addr = start; addr <= end; addr += System::PAGE_SIZE)
-  {
-    if(upper)
-      access.directPokeBase = &myRAM[startCurrentBank + (addr & (RAM_BANK_SIZE - 1))];
-    else
-      access.directPeekBase = &myRAM[startCurrentBank + (addr & (RAM_BANK_SIZE - 1))];
-
-    access.codeAccessBase = &myCodeAccessBase[mySize + startCurrentBank + (addr & (RAM_BANK_SIZE - 1))];
-    mySystem->setPageAccess(addr, access);
-  }
-}
-
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool Cartridge3EPlus::bankROM(uInt8 bank)
 {
@@ -200,57 +198,38 @@ bool Cartridge3EPlus::bankROM(uInt8 bank)
   // Map ROM bank image into the system into the correct slot
   // Memory map is 1K slots at 0x1000, 0x1400, 0x1800, 0x1C00
   // Each ROM uses 2 consecutive 512 byte slots
-  bankROMSlot(bank | 0);
-  bankROMSlot(bank | BITMASK_LOWERUPPER);
+  uInt16 segment = (bank >> BANK_BITS) & 3;  // which 1K segment we are switching (BITS D6,D7)
+  bankInUse[segment * 2]     = bank;
+  bankInUse[segment * 2 + 1] = bank | BITMASK_LOWERUPPER;
+  mapSegment(segment);
 
   return myBankChanged = true;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void Cartridge3EPlus::bankROMSlot(uInt16 bank)
+void Cartridge3EPlus::mapSegment(uInt16 segment)
 {
-  uInt16 bankNumber = (bank >> BANK_BITS) & 3;    // which bank # we are switching TO (BITS D6,D7)
-  uInt16 currentBank = bank & BIT_BANK_MASK;      // Wrap around/restrict to valid range
-  bool upper = bank & BITMASK_LOWERUPPER;         // is this the lower or upper 512b
-
-  bankInUse[bankNumber * 2 + (upper ? 1 : 0)] = Int16(bank); // Record which bank switched in (as ROM)
-
-  uInt32 startCurrentBank = currentBank << ROM_BANK_TO_POWER;     // Effectively *1K
-
-  // Setup the page access methods for the current bank
-  System::PageAccess access(this, System::PA_READ);
-
-  uInt16 start = 0x1000 + (bankNumber << ROM_BANK_TO_POWER) + (upper ? ROM_BANK_SIZE / 2 : 0);
-  uInt16 end = start + ROM_BANK_SIZE / 2 - 1;
-
-  for(uInt16 addr = start; addr <= end; addr += System::PAGE_SIZE)
-  {
-    access.directPeekBase = &myImage[startCurrentBank + (addr & (ROM_BANK_SIZE - 1))];
-    access.codeAccessBase = &myCodeAccessBase[startCurrentBank + (addr & (ROM_BANK_SIZE - 1))];
-    mySystem->setPageAccess(addr, access);
-  }
+  // The precomputed pages are ordered as ROM banks, RAM banks and the
+  // undefined bank, a whole segment each
+  uInt16 bank = bankInUse[segment * 2];
+  uInt32 index;
+  if(bank == BANK_UNDEFINED)
+    index = romBanks() + MAXIMUM_BANK_COUNT;
+  else if(bank & BITMASK_ROMRAM)
+    index = romBanks() + (bank & BIT_BANK_MASK);
+  else
+    index = (bank & BIT_BANK_MASK) % romBanks();  // Wrap around to a valid bank
+
+  mySystem->mapPages(0x1000 + (segment << ROM_BANK_TO_POWER),
+                     &myBankPages[index * System::WINDOW_PAGES], ROM_BANK_SIZE);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Cartridge3EPlus::initializeBankState()
 {
-  // Switch in each 512b slot
-  for(uInt32 b = 0; b < 8; b++)
-  {
-    if(bankInUse[b] == BANK_UNDEFINED)
-    {
-      // All accesses point to peek/poke above
-      System::PageAccess access(this, System::PA_READ);
-      uInt16 start = 0x1000 + (b << RAM_BANK_TO_POWER);
-      uInt16 end = start + RAM_BANK_SIZE - 1;
-      for(uInt16 addr = start; addr <= end; addr += System::PAGE_SIZE)
-        mySystem->setPageAccess(addr, access);
-    }
-    else if (bankInUse[b] & BITMASK_ROMRAM)
-      bankRAMSlot(bankInUse[b]);
-    else
-      bankROMSlot(bankInUse[b]);
-  }
+  // Switch in each 1K segment
+  for(uInt16 segment = 0; segment < 4; ++segment)
+    mapSegment(segment);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -281,7 +260,7 @@ bool Cartridge3EPlus::patch(uInt16 address, uInt8 value)
 
     uInt32 byteOffset = address & BITMASK_ROM_BANK;
     uInt32 baseAddress = (whichBankIsThere << ROM_BANK_TO_POWER) + byteOffset;
-    myImage[baseAddress] = value;   // write to the image
+    unshareImage(myImage)[baseAddress] = value;   // write to the image
   }
 
   return myBankChanged;
@@ -294,7 +273,7 @@ bool Cartridge3EPlus::patch(uInt16 address, uInt8 value)
 const uInt8* Cartridge3EPlus::getImage(uInt32& size) const
 {
   size = mySize;
-  return myImage.get();
+  return myImage;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
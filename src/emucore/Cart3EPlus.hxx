@@ -53,7 +53,7 @@ class Cartridge3EPlus: public Cartridge
       @param size      The size of the ROM image
       @param settings  A reference to the various settings (read-only)
     */
-    Cartridge3EPlus(const BytePtr& image, uInt32 size, const Settings& settings);
+    Cartridge3EPlus(const ImagePtr& image, uInt32 size, const Settings& settings);
     virtual ~Cartridge3EPlus() = default;
 
   public:
@@ -141,8 +141,7 @@ class Cartridge3EPlus: public Cartridge
     bool bankRAM(uInt8 bank);      // switch a RAM bank
     bool bankROM(uInt8 bank);      // switch a ROM bank
 
-    void bankRAMSlot(uInt16 bank); // switch in a 512b RAM slot (lower or upper 1/2 bank)
-    void bankROMSlot(uInt16 bank); // switch in a 512b RAM slot (read or write port)
+    void mapSegment(uInt16 segment); // switch in the precomputed pages of a 1K segment
 
     void initializeBankState();    // set all banks according to current bankInUse state
 
@@ -176,7 +175,10 @@ class Cartridge3EPlus: public Cartridge
 
     static constexpr uInt16 RAM_WRITE_OFFSET = 0x200;
 
-    BytePtr myImage;  // Pointer to a dynamically allocated ROM image of the cartridge
+    // The number of (whole) 1K ROM banks in the image
+    uInt32 romBanks() const { return std::max(mySize >> ROM_BANK_TO_POWER, 1u); }
+
+    const uInt8* myImage;  // The ROM image of the cartridge, shared until it's patched
     uInt32  mySize;   // Size of the ROM image
     uInt8 myRAM[RAM_TOTAL_SIZE];
 
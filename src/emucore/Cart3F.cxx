@@ -20,17 +20,14 @@
 #include "Cart3F.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Cartridge3F::Cartridge3F(const BytePtr& image, uInt32 size,
+Cartridge3F::Cartridge3F(const ImagePtr& image, uInt32 size,
                          const Settings& settings)
   : Cartridge(settings),
     mySize(size),
     myCurrentBank(0)
 {
-  // Allocate array for the ROM image
-  myImage = make_unique<uInt8[]>(mySize);
-
-  // Copy the ROM image into my buffer
-  memcpy(myImage.get(), image.get(), mySize);
+  // Use the ROM image in place, rather than copying it
+  myImage = shareImage(image, mySize);
   createCodeAccessBase(mySize);
 
   // Remember startup bank
@@ -72,6 +69,18 @@ void Cartridge3F::install(System& system)
     mySystem->setPageAccess(addr, access);
   }
 
+  // Precompute the pages of every bank for the first segment
+  myBankPages.clear();
+  for(uInt32 offset = 0; offset < uInt32(bankCount()) << 11; offset += 2048)
+  {
+    for(uInt16 addr = 0x1000; addr < 0x1800; addr += System::PAGE_SIZE)
+    {
+      access.directPeekBase = &myImage[offset + (addr & 0x07FF)];
+      access.codeAccessBase = &myCodeAccessBase[offset + (addr & 0x07FF)];
+      myBankPages.push_back(access);
+    }
+  }
+
   // Install pages for startup bank into the first segment
   bank(myStartBank);
 }
@@ -122,16 +131,8 @@ bool Cartridge3F::bank(uInt16 bank)
 
   uInt32 offset = myCurrentBank << 11;
 
-  // Setup the page access methods for the current bank
-  System::PageAccess access(this, System::PA_READ);
-
-  // Map ROM image into the system
-  for(uInt16 addr = 0x1000; addr < 0x1800; addr += System::PAGE_SIZE)
-  {
-    access.directPeekBase = &myImage[offset + (addr & 0x07FF)];
-    access.codeAccessBase = &myCodeAccessBase[offset + (addr & 0x07FF)];
-    mySystem->setPageAccess(addr, access);
-  }
+  // Switch in the precomputed pages of the bank
+  mySystem->mapPages(0x1000, &myBankPages[offset >> System::PAGE_SHIFT], 0x0800);
   return myBankChanged = true;
 }
 
@@ -153,9 +154,9 @@ bool Cartridge3F::patch(uInt16 address, uInt8 value)
   address &= 0x0FFF;
 
   if(address < 0x0800)
-    myImage[(address & 0x07FF) + (myCurrentBank << 11)] = value;
+    unshareImage(myImage)[(address & 0x07FF) + (myCurrentBank << 11)] = value;
   else
-    myImage[(address & 0x07FF) + mySize - 2048] = value;
+    unshareImage(myImage)[(address & 0x07FF) + mySize - 2048] = value;
 
   return myBankChanged = true;
 }
@@ -164,7 +165,7 @@ bool Cartridge3F::patch(uInt16 address, uInt8 value)
 const uInt8* Cartridge3F::getImage(uInt32& size) const
 {
   size = mySize;
-  return myImage.get();
+  return myImage;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
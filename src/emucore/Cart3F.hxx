@@ -50,7 +50,7 @@ class Cartridge3F : public Cartridge
       @param size      The size of the ROM image
       @param settings  A reference to the various settings (read-only)
     */
-    Cartridge3F(const BytePtr& image, uInt32 size, const Settings& settings);
+    Cartridge3F(const ImagePtr& image, uInt32 size, const Settings& settings);
     virtual ~Cartridge3F() = default;
 
   public:
@@ -154,8 +154,8 @@ class Cartridge3F : public Cartridge
     bool poke(uInt16 address, uInt8 value) override;
 
   private:
-    // Pointer to a dynamically allocated ROM image of the cartridge
-    BytePtr myImage;
+    // The ROM image of the cartridge, shared until it's patched
+    const uInt8* myImage;
 
     // Size of the ROM image
     uInt32 mySize;
@@ -21,7 +21,7 @@
 #include "Cart4A50.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Cartridge4A50::Cartridge4A50(const BytePtr& image, uInt32 size,
+Cartridge4A50::Cartridge4A50(const ImagePtr& image, uInt32 size,
                              const Settings& settings)
   : Cartridge(settings),
     mySize(size),
@@ -34,13 +34,23 @@ Cartridge4A50::Cartridge4A50(const BytePtr& image, uInt32 size,
     myLastAddress(0),
     myLastData(0)
 {
-  // Copy the ROM image into my buffer
-  // Supported file sizes are 32/64/128K, which are duplicated if necessary
-  if(size < 65536)        size = 32768;
-  else if(size < 131072)  size = 65536;
-  else                    size = 131072;
-  for(uInt32 slice = 0; slice < 131072 / size; ++slice)
-    memcpy(myImage + (slice*size), image.get(), size);
+  // Use the ROM image in place, rather than copying it
+  // Supported file sizes are 32/64/128K, which are mirrored if necessary;
+  // a shorter image is copied and padded, since all of it can be read
+  uInt32 romSize;
+  if(size < 65536)        romSize = 32768;
+  else if(size < 131072)  romSize = 65536;
+  else                    romSize = 131072;
+  if(size < romSize)
+  {
+    BytePtr padded = make_unique<uInt8[]>(romSize);
+    std::copy_n(image.get(), size, padded.get());
+    myImage = shareImage(ImagePtr(padded.release(), std::default_delete<uInt8[]>()),
+                         romSize);
+  }
+  else
+    myImage = shareImage(image, romSize);
+  myMask = romSize - 1;
 
   // We use System::PageAccess.codeAccessBase, but don't allow its use
   // through a pointer, since the address space of 4A50 carts can change
@@ -102,23 +112,23 @@ uInt8 Cartridge4A50::peek(uInt16 address)
   {
     if((address & 0x1800) == 0x1000)           // 2K region from 0x1000 - 0x17ff
     {
-      value = myIsRomLow ? myImage[(address & 0x7ff) + mySliceLow]
+      value = myIsRomLow ? myImage[((address & 0x7ff) + mySliceLow) & myMask]
                          : myRAM[(address & 0x7ff) + mySliceLow];
     }
     else if(((address & 0x1fff) >= 0x1800) &&  // 1.5K region from 0x1800 - 0x1dff
             ((address & 0x1fff) <= 0x1dff))
     {
-      value = myIsRomMiddle ? myImage[(address & 0x7ff) + mySliceMiddle + 0x10000]
+      value = myIsRomMiddle ? myImage[((address & 0x7ff) + mySliceMiddle + 0x10000) & myMask]
                             : myRAM[(address & 0x7ff) + mySliceMiddle];
     }
     else if((address & 0x1f00) == 0x1e00)      // 256B region from 0x1e00 - 0x1eff
     {
-      value = myIsRomHigh ? myImage[(address & 0xff) + mySliceHigh + 0x10000]
+      value = myIsRomHigh ? myImage[((address & 0xff) + mySliceHigh + 0x10000) & myMask]
                           : myRAM[(address & 0xff) + mySliceHigh];
     }
     else if((address & 0x1f00) == 0x1f00)      // 256B region from 0x1f00 - 0x1fff
     {
-      value = myImage[(address & 0xff) + 0x1ff00];
+      value = myImage[((address & 0xff) + 0x1ff00) & myMask];
       if(!bankLocked() && ((myLastData & 0xe0) == 0x60) &&
          ((myLastAddress >= 0x1000) || (myLastAddress < 0x200)))
         mySliceHigh = (mySliceHigh & 0xf0ff) | ((address & 0x8) << 8) |
@@ -329,7 +339,7 @@ bool Cartridge4A50::patch(uInt16 address, uInt8 value)
   if((address & 0x1800) == 0x1000)           // 2K region from 0x1000 - 0x17ff
   {
     if(myIsRomLow)
-      myImage[(address & 0x7ff) + mySliceLow] = value;
+      unshareImage(myImage)[((address & 0x7ff) + mySliceLow) & myMask] = value;
     else
       myRAM[(address & 0x7ff) + mySliceLow] = value;
   }
@@ -337,20 +347,20 @@ bool Cartridge4A50::patch(uInt16 address, uInt8 value)
           ((address & 0x1fff) <= 0x1dff))
   {
     if(myIsRomMiddle)
-      myImage[(address & 0x7ff) + mySliceMiddle + 0x10000] = value;
+      unshareImage(myImage)[((address & 0x7ff) + mySliceMiddle + 0x10000) & myMask] = value;
     else
       myRAM[(address & 0x7ff) + mySliceMiddle] = value;
   }
   else if((address & 0x1f00) == 0x1e00)      // 256B region from 0x1e00 - 0x1eff
   {
     if(myIsRomHigh)
-      myImage[(address & 0xff) + mySliceHigh + 0x10000] = value;
+      unshareImage(myImage)[((address & 0xff) + mySliceHigh + 0x10000) & myMask] = value;
     else
       myRAM[(address & 0xff) + mySliceHigh] = value;
   }
   else if((address & 0x1f00) == 0x1f00)      // 256B region from 0x1f00 - 0x1fff
   {
-    myImage[(address & 0xff) + 0x1ff00] = value;
+    unshareImage(myImage)[((address & 0xff) + 0x1ff00) & myMask] = value;
   }
   return myBankChanged = true;
 }
@@ -64,7 +64,7 @@ class Cartridge4A50 : public Cartridge
       @param size      The size of the ROM image
       @param settings  A reference to the various settings (read-only)
     */
-    Cartridge4A50(const BytePtr& image, uInt32 size, const Settings& settings);
+    Cartridge4A50(const ImagePtr& image, uInt32 size, const Settings& settings);
     virtual ~Cartridge4A50() = default;
 
   public:
@@ -216,8 +216,11 @@ class Cartridge4A50 : public Cartridge
     }
 
   private:
-    // The 128K ROM image of the cartridge
-    uInt8 myImage[131072];
+    // The ROM image of the cartridge, shared until it's patched
+    const uInt8* myImage;
+
+    // Mask for addresses in the 128K ROM space, which mirrors smaller images
+    uInt32 myMask;
 
     // The 32K of RAM on the cartridge
     uInt8 myRAM[32768];
@@ -19,7 +19,7 @@
 #include "Cart4K.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Cartridge4K::Cartridge4K(const BytePtr& image, uInt32 size,
+Cartridge4K::Cartridge4K(const ImagePtr& image, uInt32 size,
                          const Settings& settings)
   : Cartridge(settings)
 {
@@ -44,7 +44,7 @@ class Cartridge4K : public Cartridge
       @param size      The size of the ROM image
       @param settings  A reference to the various settings (read-only)
     */
-    Cartridge4K(const BytePtr& image, uInt32 size, const Settings& settings);
+    Cartridge4K(const ImagePtr& image, uInt32 size, const Settings& settings);
     virtual ~Cartridge4K() = default;
 
   public:
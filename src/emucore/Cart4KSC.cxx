@@ -19,7 +19,7 @@
 #include "Cart4KSC.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Cartridge4KSC::Cartridge4KSC(const BytePtr& image, uInt32 size,
+Cartridge4KSC::Cartridge4KSC(const ImagePtr& image, uInt32 size,
                              const Settings& settings)
   : Cartridge(settings)
 {
@@ -20,7 +20,7 @@
 #include "CartAR.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeAR::CartridgeAR(const BytePtr& image, uInt32 size,
+CartridgeAR::CartridgeAR(const ImagePtr& image, uInt32 size,
                          const Settings& settings)
   : Cartridge(settings),
     mySize(std::max(size, 8448u)),
@@ -51,7 +51,7 @@ class CartridgeAR : public Cartridge
       @param size      The size of the ROM image
       @param settings  A reference to the various settings (read-only)
     */
-    CartridgeAR(const BytePtr& image, uInt32 size, const Settings& settings);
+    CartridgeAR(const ImagePtr& image, uInt32 size, const Settings& settings);
     virtual ~CartridgeAR() = default;
 
   public:
@@ -19,7 +19,7 @@
 #include "CartBF.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeBF::CartridgeBF(const BytePtr& image, uInt32 size,
+CartridgeBF::CartridgeBF(const ImagePtr& image, uInt32 size,
                          const Settings& settings)
   : Cartridge(settings),
     myBankOffset(0)
@@ -44,6 +44,9 @@ void CartridgeBF::install(System& system)
 {
   mySystem = &system;
 
+  // Precompute the pages of all banks
+  createBankPages(myImage, bankCount(), 0x1F80);
+
   // Install pages for the startup bank
   bank(myStartBank);
 }
@@ -84,24 +87,8 @@ bool CartridgeBF::bank(uInt16 bank)
   // Remember what bank we're in
   myBankOffset = bank << 12;
 
-  System::PageAccess access(this, System::PA_READ);
-
-  // Set the page accessing methods for the hot spots
-  for(uInt16 addr = (0x1F80 & ~System::PAGE_MASK); addr < 0x2000;
-      addr += System::PAGE_SIZE)
-  {
-    access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
-    mySystem->setPageAccess(addr, access);
-  }
-
-  // Setup the page access methods for the current bank
-  for(uInt16 addr = 0x1000; addr < (0x1F80U & ~System::PAGE_MASK);
-      addr += System::PAGE_SIZE)
-  {
-    access.directPeekBase = &myImage[myBankOffset + (addr & 0x0FFF)];
-    access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
-    mySystem->setPageAccess(addr, access);
-  }
+  // Switch in the precomputed pages of the bank
+  mapBank(bank);
   return myBankChanged = true;
 }
 
@@ -24,6 +24,7 @@
 #include "M6532.hxx"
 #include "TIA.hxx"
 #include "Thumbulator.hxx"
+#include "MusicClock.hxx"
 #include "CartBUS.hxx"
 
 // Location of data within the RAM copy of the BUS Driver.
@@ -40,12 +41,12 @@
 #define DIGITAL_AUDIO_ON ((myMode & 0xF0) == 0)
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeBUS::CartridgeBUS(const BytePtr& image, uInt32 size,
+CartridgeBUS::CartridgeBUS(const ImagePtr& image, uInt32 size,
                            const Settings& settings)
   : Cartridge(settings),
     myAudioCycles(0),
     myARMCycles(0),
-    myFractionalClocks(0.0)
+    myFractionalClocks(0)
 {
   // Copy the ROM image into my buffer
   memcpy(myImage, image.get(), std::min(32768u, size));
@@ -68,6 +69,8 @@ CartridgeBUS::CartridgeBUS(const BytePtr& image, uInt32 size,
     reinterpret_cast<uInt16*>(myImage), reinterpret_cast<uInt16*>(myBUSRAM),
     settings.getBool("thumb.trapfatal"), Thumbulator::ConfigureFor::BUS, this
   );
+  myThumbCycleCount = settings.getBool(settings.getBool("dev.settings") ?
+      "dev.thumb.cyclecount" : "plr.thumb.cyclecount");
 
   setInitialState();
 }
@@ -79,7 +82,7 @@ void CartridgeBUS::reset()
 
   // Update cycles to the current system cycles
   myAudioCycles = myARMCycles = 0;
-  myFractionalClocks = 0.0;
+  myFractionalClocks = 0;
 
   setInitialState();
 
@@ -137,9 +140,7 @@ inline void CartridgeBUS::updateMusicModeDataFetchers()
   myAudioCycles = mySystem->cycles();
 
   // Calculate the number of BUS OSC clocks since the last update
-  double clocks = ((20000.0 * cycles) / 1193191.66666667) + myFractionalClocks;
-  uInt32 wholeClocks = uInt32(clocks);
-  myFractionalClocks = clocks - double(wholeClocks);
+  uInt32 wholeClocks = MusicClock::advance(cycles, myFractionalClocks);
 
   // Let's update counters and flags of the music mode data fetchers
   if(wholeClocks > 0)
@@ -154,16 +155,26 @@ inline void CartridgeBUS::callFunction(uInt8 value)
   {
     // Call user written ARM code (will most likely be C compiled for ARM)
     case 254: // call with IRQ driven audio, no special handling needed at this
-              // time for Stella as ARM code "runs in zero 6507 cycles".
+              // time for Stella, which doesn't emulate the IRQ
     case 255: // call without IRQ driven audio
       try {
         Int32 cycles = Int32(mySystem->cycles() - myARMCycles);
         myARMCycles = mySystem->cycles();
 
         myThumbEmulator->run(cycles);
+
+        // The 6507 is fed NOPs by the driver until the ARM code returns;
+        // unless enabled, the ARM code "runs in zero 6507 cycles"
+        uInt32 armCycles = myThumbEmulator->cycles6507();
+      #ifdef DEBUGGER_SUPPORT
+        if(!mySystem->autodetectMode() && !mySystem->headless())
+          Debugger::debugger().checkARMOverrun(armCycles);
+      #endif
+        if(myThumbCycleCount)
+          mySystem->incrementCycles(armCycles);
       }
       catch(const runtime_error& e) {
-        if(!mySystem->autodetectMode())
+        if(!mySystem->autodetectMode() && !mySystem->headless())
         {
       #ifdef DEBUGGER_SUPPORT
           Debugger::debugger().startWithFatalError(e.what());
@@ -466,6 +477,10 @@ bool CartridgeBUS::patch(uInt16 address, uInt8 value)
   if(address >= 0x0040)
   {
     myProgramImage[myBankOffset + (address & 0x0FFF)] = value;
+
+    // The ARM code may run from the patched ROM as well
+    myThumbEmulator->romChanged(
+        uInt32(myProgramImage - myImage) + myBankOffset + address);
     return myBankChanged = true;
   }
   else
@@ -555,7 +570,7 @@ bool CartridgeBUS::save(Serializer& out) const
 
     // Save cycles and clocks
     out.putLong(myAudioCycles);
-    out.putDouble(myFractionalClocks);
+    out.putDouble(MusicClock::toDouble(myFractionalClocks));
     out.putLong(myARMCycles);
 
     // Audio info
@@ -599,7 +614,7 @@ bool CartridgeBUS::load(Serializer& in)
 
     // Get system cycles and fractional clocks
     myAudioCycles = in.getLong();
-    myFractionalClocks = in.getDouble();
+    myFractionalClocks = MusicClock::fromDouble(in.getDouble());
     myARMCycles = in.getLong();
 
     // Audio info
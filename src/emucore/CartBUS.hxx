@@ -53,7 +53,7 @@ class CartridgeBUS : public Cartridge
       @param size      The size of the ROM image
       @param settings  A reference to the various settings (read-only)
     */
-    CartridgeBUS(const BytePtr& image, uInt32 size, const Settings& settings);
+    CartridgeBUS(const ImagePtr& image, uInt32 size, const Settings& settings);
     virtual ~CartridgeBUS() = default;
 
   public:
@@ -143,6 +143,11 @@ class CartridgeBUS : public Cartridge
    */
   uInt32 thumbCallback(uInt8 function, uInt32 value1, uInt32 value2) override;
 
+    /**
+      Answers the ARM emulator running the code of this cart.
+    */
+    Thumbulator* thumbulator() const override { return myThumbEmulator.get(); }
+
 
   #ifdef DEBUGGER_SUPPORT
     /**
@@ -246,6 +251,10 @@ class CartridgeBUS : public Cartridge
     // ARM cycle count from when the last callFunction() occurred
     uInt64 myARMCycles;
 
+    // Whether the 6507 waits for the ARM code to finish, rather than the
+    // ARM code running in zero 6507 cycles
+    bool myThumbCycleCount;
+
     // The music mode counters
     uInt32 myMusicCounters[3];
 
@@ -255,8 +264,9 @@ class CartridgeBUS : public Cartridge
     // The music waveform sizes
     uInt8 myMusicWaveformSize[3];
 
-    // Fractional DPC music OSC clocks unused during the last update
-    double myFractionalClocks;
+    // Fractional DPC music OSC clocks unused during the last update,
+    // in units of 1/MusicClock::CYCLES
+    uInt32 myFractionalClocks;
 
     // Controls mode, lower nybble sets Fast Fetch, upper nybble sets audio
     // -0 = Bus Stuffing ON
@@ -23,6 +23,7 @@
 
 #include "System.hxx"
 #include "Thumbulator.hxx"
+#include "MusicClock.hxx"
 #include "CartCDF.hxx"
 #include "TIA.hxx"
 
@@ -41,12 +42,12 @@ const uInt16 WAVEFORM[] = {0x07F0, 0x01B0};
 #define DIGITAL_AUDIO_ON ((myMode & 0xF0) == 0)
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeCDF::CartridgeCDF(const BytePtr& image, uInt32 size,
+CartridgeCDF::CartridgeCDF(const ImagePtr& image, uInt32 size,
                            const Settings& settings)
   : Cartridge(settings),
     myAudioCycles(0),
     myARMCycles(0),
-    myFractionalClocks(0.0)
+    myFractionalClocks(0)
 {
   // Copy the ROM image into my buffer
   memcpy(myImage, image.get(), std::min(32768u, size));
@@ -71,6 +72,8 @@ CartridgeCDF::CartridgeCDF(const BytePtr& image, uInt32 size,
     reinterpret_cast<uInt16*>(myImage), reinterpret_cast<uInt16*>(myCDFRAM),
     settings.getBool("thumb.trapfatal"), myVersion ?
     Thumbulator::ConfigureFor::CDF1 : Thumbulator::ConfigureFor::CDF, this);
+  myThumbCycleCount = settings.getBool(settings.getBool("dev.settings") ?
+      "dev.thumb.cyclecount" : "plr.thumb.cyclecount");
 
   setInitialState();
 }
@@ -81,7 +84,7 @@ void CartridgeCDF::reset()
   initializeRAM(myCDFRAM+2048, 8192-2048);
 
   myAudioCycles = myARMCycles = 0;
-  myFractionalClocks = 0.0;
+  myFractionalClocks = 0;
 
   setInitialState();
 
@@ -136,9 +139,7 @@ inline void CartridgeCDF::updateMusicModeDataFetchers()
   myAudioCycles = mySystem->cycles();
 
   // Calculate the number of CDF OSC clocks since the last update
-  double clocks = ((20000.0 * cycles) / 1193191.66666667) + myFractionalClocks;
-  uInt32 wholeClocks = uInt32(clocks);
-  myFractionalClocks = clocks - double(wholeClocks);
+  uInt32 wholeClocks = MusicClock::advance(cycles, myFractionalClocks);
 
   // Let's update counters and flags of the music mode data fetchers
   if(wholeClocks > 0)
@@ -153,16 +154,26 @@ inline void CartridgeCDF::callFunction(uInt8 value)
   {
     // Call user written ARM code (will most likely be C compiled for ARM)
     case 254: // call with IRQ driven audio, no special handling needed at this
-              // time for Stella as ARM code "runs in zero 6507 cycles".
+              // time for Stella, which doesn't emulate the IRQ
     case 255: // call without IRQ driven audio
       try {
         Int32 cycles = Int32(mySystem->cycles() - myARMCycles);
         myARMCycles = mySystem->cycles();
 
         myThumbEmulator->run(cycles);
+
+        // The 6507 is fed NOPs by the driver until the ARM code returns;
+        // unless enabled, the ARM code "runs in zero 6507 cycles"
+        uInt32 armCycles = myThumbEmulator->cycles6507();
+#ifdef DEBUGGER_SUPPORT
+        if(!mySystem->autodetectMode() && !mySystem->headless())
+          Debugger::debugger().checkARMOverrun(armCycles);
+#endif
+        if(myThumbCycleCount)
+          mySystem->incrementCycles(armCycles);
       }
       catch(const runtime_error& e) {
-        if(!mySystem->autodetectMode())
+        if(!mySystem->autodetectMode() && !mySystem->headless())
         {
 #ifdef DEBUGGER_SUPPORT
           Debugger::debugger().startWithFatalError(e.what());
@@ -427,6 +438,10 @@ bool CartridgeCDF::patch(uInt16 address, uInt8 value)
   if(address >= 0x0040)
   {
     myProgramImage[myBankOffset + (address & 0x0FFF)] = value;
+
+    // The ARM code may run from the patched ROM as well
+    myThumbEmulator->romChanged(
+        uInt32(myProgramImage - myImage) + myBankOffset + address);
     return myBankChanged = true;
   }
   else
@@ -501,7 +516,7 @@ bool CartridgeCDF::save(Serializer& out) const
 
     // Save cycles and clocks
     out.putLong(myAudioCycles);
-    out.putDouble(myFractionalClocks);
+    out.putDouble(MusicClock::toDouble(myFractionalClocks));
     out.putLong(myARMCycles);
   }
   catch(...)
@@ -544,7 +559,7 @@ bool CartridgeCDF::load(Serializer& in)
 
     // Get cycles and clocks
     myAudioCycles = in.getLong();
-    myFractionalClocks = in.getDouble();
+    myFractionalClocks = MusicClock::fromDouble(in.getDouble());
     myARMCycles = in.getLong();
   }
   catch(...)
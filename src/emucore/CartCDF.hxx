@@ -53,7 +53,7 @@ class CartridgeCDF : public Cartridge
       @param size      The size of the ROM image
       @param settings  A reference to the various settings (read-only)
     */
-    CartridgeCDF(const BytePtr& image, uInt32 size, const Settings& settings);
+    CartridgeCDF(const ImagePtr& image, uInt32 size, const Settings& settings);
     virtual ~CartridgeCDF() = default;
 
   public:
@@ -141,6 +141,11 @@ class CartridgeCDF : public Cartridge
     */
     uInt32 thumbCallback(uInt8 function, uInt32 value1, uInt32 value2) override;
 
+    /**
+      Answers the ARM emulator running the code of this cart.
+    */
+    Thumbulator* thumbulator() const override { return myThumbEmulator.get(); }
+
 #ifdef DEBUGGER_SUPPORT
     /**
       Get debugger widget responsible for accessing the inner workings
@@ -231,6 +236,10 @@ class CartridgeCDF : public Cartridge
     // ARM cycle count from when the last callFunction() occurred
     uInt64 myARMCycles;
 
+    // Whether the 6507 waits for the ARM code to finish, rather than the
+    // ARM code running in zero 6507 cycles
+    bool myThumbCycleCount;
+
     // The audio routines in the driver run in 32-bit mode and take advantage
     // of the FIQ Shadow Registers which are not accessible to 16-bit thumb
     // code.  As such, Thumbulator does not support them.  The driver supplies a
@@ -256,8 +265,9 @@ class CartridgeCDF : public Cartridge
     // The music waveform sizes
     uInt8 myMusicWaveformSize[3];
 
-    // Fractional CDF music, OSC clocks unused during the last update
-    double myFractionalClocks;
+    // Fractional CDF music, OSC clocks unused during the last update,
+    // in units of 1/MusicClock::CYCLES
+    uInt32 myFractionalClocks;
 
     // Controls mode, lower nybble sets Fast Fetch, upper nybble sets audio
     // -0 = Fast Fetch ON
@@ -21,7 +21,7 @@
 #include "CartCM.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeCM::CartridgeCM(const BytePtr& image, uInt32 size,
+CartridgeCM::CartridgeCM(const ImagePtr& image, uInt32 size,
                          const Settings& settings)
   : Cartridge(settings),
     mySWCHA(0xFF),   // portA is all 1's
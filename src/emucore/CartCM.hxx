@@ -119,7 +119,7 @@ class CartridgeCM : public Cartridge
       @param size      The size of the ROM image
       @param settings  A reference to the various settings (read-only)
     */
-    CartridgeCM(const BytePtr& image, uInt32 size, const Settings& settings);
+    CartridgeCM(const ImagePtr& image, uInt32 size, const Settings& settings);
     virtual ~CartridgeCM() = default;
 
   public:
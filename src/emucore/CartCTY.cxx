@@ -19,10 +19,11 @@
 #include "Serializer.hxx"
 #include "System.hxx"
 #include "CartCTYTunes.hxx"
+#include "MusicClock.hxx"
 #include "CartCTY.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeCTY::CartridgeCTY(const BytePtr& image, uInt32 size,
+CartridgeCTY::CartridgeCTY(const ImagePtr& image, uInt32 size,
                            const OSystem& osystem)
   : Cartridge(osystem.settings()),
     myOSystem(osystem),
@@ -32,7 +33,7 @@ CartridgeCTY::CartridgeCTY(const BytePtr& image, uInt32 size,
     myRandomNumber(0x2B435044),
     myRamAccessTimeout(0),
     myAudioCycles(0),
-    myFractionalClocks(0.0),
+    myFractionalClocks(0),
     myBankOffset(0)
 {
   // Copy the ROM image into my buffer
@@ -54,7 +55,7 @@ void CartridgeCTY::reset()
   myRAM[0] = myRAM[1] = myRAM[2] = myRAM[3] = 0xFF;
 
   myAudioCycles = 0;
-  myFractionalClocks = 0.0;
+  myFractionalClocks = 0;
 
   // Upon reset we switch to the startup bank
   bank(myStartBank);
@@ -288,7 +289,7 @@ bool CartridgeCTY::save(Serializer& out) const
     out.putBool(myLDAimmediate);
     out.putInt(myRandomNumber);
     out.putLong(myAudioCycles);
-    out.putDouble(myFractionalClocks);
+    out.putDouble(MusicClock::toDouble(myFractionalClocks));
 
   }
   catch(...)
@@ -317,7 +318,7 @@ bool CartridgeCTY::load(Serializer& in)
     myLDAimmediate = in.getBool();
     myRandomNumber = in.getInt();
     myAudioCycles = in.getLong();
-    myFractionalClocks = in.getDouble();
+    myFractionalClocks = MusicClock::fromDouble(in.getDouble());
   }
   catch(...)
   {
@@ -508,9 +509,7 @@ inline void CartridgeCTY::updateMusicModeDataFetchers()
   myAudioCycles = mySystem->cycles();
 
   // Calculate the number of CTY OSC clocks since the last update
-  double clocks = ((20000.0 * cycles) / 1193191.66666667) + myFractionalClocks;
-  uInt32 wholeClocks = uInt32(clocks);
-  myFractionalClocks = clocks - double(wholeClocks);
+  uInt32 wholeClocks = MusicClock::advance(cycles, myFractionalClocks);
 
   // Let's update counters and flags of the music mode data fetchers
   if(wholeClocks > 0)
@@ -121,7 +121,7 @@ class CartridgeCTY : public Cartridge
       @param size      The size of the ROM image
       @param osystem   A reference to the OSystem currently in use
     */
-    CartridgeCTY(const BytePtr& image, uInt32 size, const OSystem& osystem);
+    CartridgeCTY(const ImagePtr& image, uInt32 size, const OSystem& osystem);
     virtual ~CartridgeCTY() = default;
 
   public:
@@ -295,8 +295,9 @@ class CartridgeCTY : public Cartridge
     // System cycle count from when the last update to music data fetchers occurred
     uInt64 myAudioCycles;
 
-    // Fractional DPC music OSC clocks unused during the last update
-    double myFractionalClocks;
+    // Fractional DPC music OSC clocks unused during the last update,
+    // in units of 1/MusicClock::CYCLES
+    uInt32 myFractionalClocks;
 
     // Indicates the offset into the ROM image (aligns to current bank)
     uInt16 myBankOffset;
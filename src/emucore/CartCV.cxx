@@ -19,7 +19,7 @@
 #include "CartCV.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeCV::CartridgeCV(const BytePtr& image, uInt32 size,
+CartridgeCV::CartridgeCV(const ImagePtr& image, uInt32 size,
                          const Settings& settings)
   : Cartridge(settings),
     mySize(size)
@@ -47,7 +47,7 @@ class CartridgeCV : public Cartridge
       @param size      The size of the ROM image
       @param settings  A reference to the various settings (read-only)
     */
-    CartridgeCV(const BytePtr& image, uInt32 size, const Settings& settings);
+    CartridgeCV(const ImagePtr& image, uInt32 size, const Settings& settings);
     virtual ~CartridgeCV() = default;
 
   public:
@@ -20,17 +20,14 @@
 #include "CartCVPlus.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeCVPlus::CartridgeCVPlus(const BytePtr& image, uInt32 size,
+CartridgeCVPlus::CartridgeCVPlus(const ImagePtr& image, uInt32 size,
                                  const Settings& settings)
   : Cartridge(settings),
     mySize(size),
     myCurrentBank(0)
 {
-  // Allocate array for the ROM image
-  myImage = make_unique<uInt8[]>(mySize);
-
-  // Copy the ROM image into my buffer
-  memcpy(myImage.get(), image.get(), mySize);
+  // Use the ROM image in place, rather than copying it
+  myImage = shareImage(image, mySize);
   createCodeAccessBase(mySize + 1024);
 
   // Remember startup bank
@@ -176,7 +173,7 @@ bool CartridgeCVPlus::patch(uInt16 address, uInt8 value)
     myRAM[address & 0x03FF] = value;
   }
   else
-    myImage[(address & 0x07FF) + (myCurrentBank << 11)] = value;
+    unshareImage(myImage)[(address & 0x07FF) + (myCurrentBank << 11)] = value;
 
   return myBankChanged = true;
 }
@@ -185,7 +182,7 @@ bool CartridgeCVPlus::patch(uInt16 address, uInt8 value)
 const uInt8* CartridgeCVPlus::getImage(uInt32& size) const
 {
   size = mySize;
-  return myImage.get();
+  return myImage;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
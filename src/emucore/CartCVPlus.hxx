@@ -57,7 +57,7 @@ class CartridgeCVPlus : public Cartridge
       @param size      The size of the ROM image
       @param settings  A reference to the various settings (read-only)
     */
-    CartridgeCVPlus(const BytePtr& image, uInt32 size, const Settings& settings);
+    CartridgeCVPlus(const ImagePtr& image, uInt32 size, const Settings& settings);
     virtual ~CartridgeCVPlus() = default;
 
   public:
@@ -161,8 +161,8 @@ class CartridgeCVPlus : public Cartridge
     bool poke(uInt16 address, uInt8 value) override;
 
   private:
-    // Pointer to a dynamically allocated ROM image of the cartridge
-    BytePtr myImage;
+    // The ROM image of the cartridge, shared until it's patched
+    const uInt8* myImage;
 
     // The 1024 bytes of RAM
     uInt8 myRAM[1024];
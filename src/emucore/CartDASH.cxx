@@ -20,16 +20,13 @@
 #include "CartDASH.hxx"
 
 //  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeDASH::CartridgeDASH(const BytePtr& image, uInt32 size,
+CartridgeDASH::CartridgeDASH(const ImagePtr& image, uInt32 size,
                              const Settings& settings)
   : Cartridge(settings),
     mySize(size)
 {
-  // Allocate array for the ROM image
-  myImage = make_unique<uInt8[]>(mySize);
-
-  // Copy the ROM image into my buffer
-  memcpy(myImage.get(), image.get(), mySize);
+  // Use the ROM image in place, rather than copying it
+  myImage = shareImage(image, mySize);
   createCodeAccessBase(mySize + RAM_TOTAL_SIZE);
 
   // Remember startup bank (0 per spec, rather than last per 3E scheme).
@@ -286,7 +283,7 @@ bool CartridgeDASH::patch(uInt16 address, uInt8 value)
 
     uInt32 byteOffset = address & BITMASK_ROM_BANK;
     uInt32 baseAddress = (whichBankIsThere << ROM_BANK_TO_POWER) + byteOffset;
-    myImage[baseAddress] = value;   // write to the image
+    unshareImage(myImage)[baseAddress] = value;   // write to the image
   }
 
   return myBankChanged;
@@ -299,7 +296,7 @@ bool CartridgeDASH::patch(uInt16 address, uInt8 value)
 const uInt8* CartridgeDASH::getImage(uInt32& size) const
 {
   size = mySize;
-  return myImage.get();
+  return myImage;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -135,7 +135,7 @@ class CartridgeDASH: public Cartridge
       @param size      The size of the ROM image
       @param settings  A reference to the various settings (read-only)
     */
-    CartridgeDASH(const BytePtr& image, uInt32 size, const Settings& settings);
+    CartridgeDASH(const ImagePtr& image, uInt32 size, const Settings& settings);
     virtual ~CartridgeDASH() = default;
 
   public:
@@ -259,7 +259,7 @@ class CartridgeDASH: public Cartridge
 
     static constexpr uInt16 RAM_WRITE_OFFSET = 0x800;
 
-    BytePtr myImage;  // Pointer to a dynamically allocated ROM image of the cartridge
+    const uInt8* myImage;  // The ROM image of the cartridge, shared until it's patched
     uInt32  mySize;   // Size of the ROM image
     uInt8 myRAM[RAM_TOTAL_SIZE];
 
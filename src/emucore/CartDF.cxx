@@ -19,7 +19,7 @@
 #include "CartDF.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeDF::CartridgeDF(const BytePtr& image, uInt32 size,
+CartridgeDF::CartridgeDF(const ImagePtr& image, uInt32 size,
                          const Settings& settings)
   : Cartridge(settings),
     myBankOffset(0)
@@ -44,6 +44,9 @@ void CartridgeDF::install(System& system)
 {
   mySystem = &system;
 
+  // Precompute the pages of all banks
+  createBankPages(myImage, bankCount(), 0x1FC0);
+
   // Install pages for the startup bank
   bank(myStartBank);
 }
@@ -80,24 +83,8 @@ bool CartridgeDF::bank(uInt16 bank)
   // Remember what bank we're in
   myBankOffset = bank << 12;
 
-  System::PageAccess access(this, System::PA_READ);
-
-  // Set the page accessing methods for the hot spots
-  for(uInt16 addr = (0x1FC0 & ~System::PAGE_MASK); addr < 0x2000;
-      addr += System::PAGE_SIZE)
-  {
-    access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
-    mySystem->setPageAccess(addr, access);
-  }
-
-  // Setup the page access methods for the current bank
-  for(uInt16 addr = 0x1000; addr < (0x1FC0U & ~System::PAGE_MASK);
-      addr += System::PAGE_SIZE)
-  {
-    access.directPeekBase = &myImage[myBankOffset + (addr & 0x0FFF)];
-    access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
-    mySystem->setPageAccess(addr, access);
-  }
+  // Switch in the precomputed pages of the bank
+  mapBank(bank);
   return myBankChanged = true;
 }
 
@@ -45,7 +45,7 @@ class CartridgeDF : public Cartridge
       @param size      The size of the ROM image
       @param settings  A reference to the various settings (read-only)
     */
-    CartridgeDF(const BytePtr& image, uInt32 size, const Settings& settings);
+    CartridgeDF(const ImagePtr& image, uInt32 size, const Settings& settings);
     virtual ~CartridgeDF() = default;
 
   public:
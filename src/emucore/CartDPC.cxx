@@ -16,15 +16,16 @@
 //============================================================================
 
 #include "System.hxx"
+#include "MusicClock.hxx"
 #include "CartDPC.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeDPC::CartridgeDPC(const BytePtr& image, uInt32 size,
+CartridgeDPC::CartridgeDPC(const ImagePtr& image, uInt32 size,
                            const Settings& settings)
   : Cartridge(settings),
     mySize(size),
     myAudioCycles(0),
-    myFractionalClocks(0.0),
+    myFractionalClocks(0),
     myBankOffset(0)
 {
   // Make a copy of the entire image
@@ -55,7 +56,7 @@ CartridgeDPC::CartridgeDPC(const BytePtr& image, uInt32 size,
 void CartridgeDPC::reset()
 {
   myAudioCycles = 0;
-  myFractionalClocks = 0.0;
+  myFractionalClocks = 0;
 
   // define random startup bank
   randomizeStartBank();
@@ -104,9 +105,7 @@ inline void CartridgeDPC::updateMusicModeDataFetchers()
   myAudioCycles = mySystem->cycles();
 
   // Calculate the number of DPC OSC clocks since the last update
-  double clocks = ((20000.0 * cycles) / 1193191.66666667) + myFractionalClocks;
-  uInt32 wholeClocks = uInt32(clocks);
-  myFractionalClocks = clocks - double(wholeClocks);
+  uInt32 wholeClocks = MusicClock::advance(cycles, myFractionalClocks);
 
   if(wholeClocks <= 0)
     return;
@@ -467,7 +466,7 @@ bool CartridgeDPC::save(Serializer& out) const
     out.putByte(myRandomNumber);
 
     out.putLong(myAudioCycles);
-    out.putDouble(myFractionalClocks);
+    out.putDouble(MusicClock::toDouble(myFractionalClocks));
   }
   catch(...)
   {
@@ -510,7 +509,7 @@ bool CartridgeDPC::load(Serializer& in)
 
     // Get system cycles and fractional clocks
     myAudioCycles = in.getLong();
-    myFractionalClocks = in.getDouble();
+    myFractionalClocks = MusicClock::fromDouble(in.getDouble());
   }
   catch(...)
   {
@@ -49,7 +49,7 @@ class CartridgeDPC : public Cartridge
       @param size      The size of the ROM image
       @param settings  A reference to the various settings (read-only)
     */
-    CartridgeDPC(const BytePtr& image, uInt32 size, const Settings& settings);
+    CartridgeDPC(const ImagePtr& image, uInt32 size, const Settings& settings);
     virtual ~CartridgeDPC() = default;
 
   public:
@@ -198,8 +198,9 @@ class CartridgeDPC : public Cartridge
     // System cycle count from when the last update to music data fetchers occurred
     uInt64 myAudioCycles;
 
-    // Fractional DPC music OSC clocks unused during the last update
-    double myFractionalClocks;
+    // Fractional DPC music OSC clocks unused during the last update,
+    // in units of 1/MusicClock::CYCLES
+    uInt32 myFractionalClocks;
 
     // Indicates the offset into the ROM image (aligns to current bank)
     uInt16 myBankOffset;
@@ -20,11 +20,12 @@
 #endif
 #include "System.hxx"
 #include "Thumbulator.hxx"
+#include "MusicClock.hxx"
 #include "CartDPCPlus.hxx"
 #include "TIA.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeDPCPlus::CartridgeDPCPlus(const BytePtr& image, uInt32 size,
+CartridgeDPCPlus::CartridgeDPCPlus(const ImagePtr& image, uInt32 size,
                                    const Settings& settings)
   : Cartridge(settings),
     myFastFetch(false),
@@ -32,7 +33,7 @@ CartridgeDPCPlus::CartridgeDPCPlus(const BytePtr& image, uInt32 size,
     myParameterPointer(0),
     myAudioCycles(0),
     myARMCycles(0),
-    myFractionalClocks(0.0),
+    myFractionalClocks(0),
     myBankOffset(0)
 {
   // Image is always 32K, but in the case of ROM > 29K, the image is
@@ -59,6 +60,8 @@ CartridgeDPCPlus::CartridgeDPCPlus(const BytePtr& image, uInt32 size,
        settings.getBool("thumb.trapfatal"),
        Thumbulator::ConfigureFor::DPCplus,
        this);
+  myThumbCycleCount = settings.getBool(settings.getBool("dev.settings") ?
+      "dev.thumb.cyclecount" : "plr.thumb.cyclecount");
 
   setInitialState();
 
@@ -70,7 +73,7 @@ CartridgeDPCPlus::CartridgeDPCPlus(const BytePtr& image, uInt32 size,
 void CartridgeDPCPlus::reset()
 {
   myAudioCycles = myARMCycles = 0;
-  myFractionalClocks = 0.0;
+  myFractionalClocks = 0;
 
   setInitialState();
 
@@ -144,9 +147,7 @@ inline void CartridgeDPCPlus::updateMusicModeDataFetchers()
   myAudioCycles = mySystem->cycles();
 
   // Calculate the number of DPC+ OSC clocks since the last update
-  double clocks = ((20000.0 * cycles) / 1193191.66666667) + myFractionalClocks;
-  uInt32 wholeClocks = uInt32(clocks);
-  myFractionalClocks = clocks - double(wholeClocks);
+  uInt32 wholeClocks = MusicClock::advance(cycles, myFractionalClocks);
 
   // Let's update counters and flags of the music mode data fetchers
   if(wholeClocks > 0)
@@ -165,27 +166,37 @@ inline void CartridgeDPCPlus::callFunction(uInt8 value)
       myParameterPointer = 0;
       break;
     case 1: // Copy ROM to fetcher
-      for(int i = 0; i < myParameter[3]; ++i)
-        myDisplayImage[myCounters[myParameter[2] & 0x7]+i] = myProgramImage[ROMdata+i];
+      memcpy(myDisplayImage + myCounters[myParameter[2] & 0x7],
+             myProgramImage + ROMdata, myParameter[3]);
       myParameterPointer = 0;
       break;
     case 2: // Copy value to fetcher
-      for(int i = 0; i < myParameter[3]; ++i)
-        myDisplayImage[myCounters[myParameter[2]]+i] = myParameter[0];
+      memset(myDisplayImage + myCounters[myParameter[2] & 0x7],
+             myParameter[0], myParameter[3]);
       myParameterPointer = 0;
       break;
       // Call user written ARM code (most likely be C compiled for ARM)
     case 254: // call with IRQ driven audio, no special handling needed at this
-              // time for Stella as ARM code "runs in zero 6507 cycles".
+              // time for Stella, which doesn't emulate the IRQ
     case 255: // call without IRQ driven audio
       try {
         Int32 cycles = Int32(mySystem->cycles() - myARMCycles);
         myARMCycles = mySystem->cycles();
 
         myThumbEmulator->run(cycles);
+
+        // The 6507 is fed NOPs by the driver until the ARM code returns;
+        // unless enabled, the ARM code "runs in zero 6507 cycles"
+        uInt32 armCycles = myThumbEmulator->cycles6507();
+      #ifdef DEBUGGER_SUPPORT
+        if(!mySystem->autodetectMode() && !mySystem->headless())
+          Debugger::debugger().checkARMOverrun(armCycles);
+      #endif
+        if(myThumbCycleCount)
+          mySystem->incrementCycles(armCycles);
       }
       catch(const runtime_error& e) {
-        if(!mySystem->autodetectMode())
+        if(!mySystem->autodetectMode() && !mySystem->headless())
         {
       #ifdef DEBUGGER_SUPPORT
           Debugger::debugger().startWithFatalError(e.what());
@@ -611,6 +622,10 @@ bool CartridgeDPCPlus::patch(uInt16 address, uInt8 value)
   if(address >= 0x0080)
   {
     myProgramImage[myBankOffset + (address & 0x0FFF)] = value;
+
+    // The ARM code may run from the patched ROM as well
+    myThumbEmulator->romChanged(
+        uInt32(myProgramImage - myImage) + myBankOffset + address);
     return myBankChanged = true;
   }
   else
@@ -673,7 +688,7 @@ bool CartridgeDPCPlus::save(Serializer& out) const
 
     // Get system cycles and fractional clocks
     out.putLong(myAudioCycles);
-    out.putDouble(myFractionalClocks);
+    out.putDouble(MusicClock::toDouble(myFractionalClocks));
 
     // Clock info for Thumbulator
     out.putLong(myARMCycles);
@@ -737,7 +752,7 @@ bool CartridgeDPCPlus::load(Serializer& in)
 
     // Get audio cycles and fractional clocks
     myAudioCycles = in.getLong();
-    myFractionalClocks = in.getDouble();
+    myFractionalClocks = MusicClock::fromDouble(in.getDouble());
 
     // Clock info for Thumbulator
     myARMCycles = in.getLong();
@@ -55,7 +55,7 @@ class CartridgeDPCPlus : public Cartridge
       @param size      The size of the ROM image
       @param settings  A reference to the various settings (read-only)
     */
-    CartridgeDPCPlus(const BytePtr& image, uInt32 size, const Settings& settings);
+    CartridgeDPCPlus(const ImagePtr& image, uInt32 size, const Settings& settings);
     virtual ~CartridgeDPCPlus() = default;
 
   public:
@@ -138,6 +138,11 @@ class CartridgeDPCPlus : public Cartridge
     */
     string name() const override { return "CartridgeDPC+"; }
 
+    /**
+      Answers the ARM emulator running the code of this cart.
+    */
+    Thumbulator* thumbulator() const override { return myThumbEmulator.get(); }
+
   #ifdef DEBUGGER_SUPPORT
     /**
       Get debugger widget responsible for accessing the inner workings
@@ -262,8 +267,13 @@ class CartridgeDPCPlus : public Cartridge
     // System cycle count when the last Thumbulator::run() occurred
     uInt64 myARMCycles;
 
-    // Fractional DPC music OSC clocks unused during the last update
-    double myFractionalClocks;
+    // Whether the 6507 waits for the ARM code to finish, rather than the
+    // ARM code running in zero 6507 cycles
+    bool myThumbCycleCount;
+
+    // Fractional DPC music OSC clocks unused during the last update,
+    // in units of 1/MusicClock::CYCLES
+    uInt32 myFractionalClocks;
 
     // Indicates the offset into the ROM image (aligns to current bank)
     uInt16 myBankOffset;
@@ -15,6 +15,9 @@
 // this file, and for a DISCLAIMER OF ALL WARRANTIES.
 //============================================================================
 
+#include <array>
+#include <queue>
+
 #include "bspf.hxx"
 #include "Cart.hxx"
 #include "Cart0840.hxx"
@@ -65,9 +68,279 @@
 
 #include "CartDetector.hxx"
 
+namespace {
+  // The schemes recognised by signatures searched for in the whole image;
+  // a scheme's bit is set when any of its signatures is found (at least
+  // the given number of times)
+  enum : uInt32 {
+    SIG_0840    = 1 << 0,
+    SIG_3E      = 1 << 1,
+    SIG_3EPLUS  = 1 << 2,
+    SIG_3F      = 1 << 3,
+    SIG_BUS     = 1 << 4,
+    SIG_CDF     = 1 << 5,
+    SIG_CV      = 1 << 6,
+    SIG_DASH    = 1 << 7,
+    SIG_DPCPLUS = 1 << 8,
+    SIG_E0      = 1 << 9,
+    SIG_E7      = 1 << 10,
+    SIG_E78K    = 1 << 11,
+    SIG_EF      = 1 << 12,
+    SIG_F8      = 1 << 13,
+    SIG_FE      = 1 << 14,
+    SIG_SB      = 1 << 15,
+    SIG_UA      = 1 << 16,
+    SIG_X07     = 1 << 17
+  };
+
+  struct Signature {
+    uInt32 scheme;
+    uInt32 minhits;
+    uInt32 size;
+    uInt8 bytes[5];
+  };
+
+  const Signature SIGNATURES[] = {
+    // 0840 cart bankswitching is triggered by accessing addresses 0x0800
+    // or 0x0840 at least twice
+    { SIG_0840, 2, 3, { 0xAD, 0x00, 0x08 } },        // LDA $0800
+    { SIG_0840, 2, 3, { 0xAD, 0x40, 0x08 } },        // LDA $0840
+    { SIG_0840, 2, 3, { 0x2C, 0x00, 0x08 } },        // BIT $0800
+    { SIG_0840, 2, 4, { 0x0C, 0x00, 0x08, 0x4C } },  // NOP $0800; JMP ...
+    { SIG_0840, 2, 4, { 0x0C, 0xFF, 0x0F, 0x4C } },  // NOP $0FFF; JMP ...
+
+    // 3E cart bankswitching is triggered by storing the bank number
+    // in address 3E using 'STA $3E', commonly followed by an
+    // immediate mode LDA
+    { SIG_3E, 1, 4, { 0x85, 0x3E, 0xA9, 0x00 } },  // STA $3E; LDA #$00
+
+    // 3E+ cart is identified key 'TJ3E' in the ROM
+    { SIG_3EPLUS, 1, 4, { 'T', 'J', '3', 'E' } },
+
+    // 3F cart bankswitching is triggered by storing the bank number
+    // in address 3F using 'STA $3F'
+    // We expect it will be present at least 2 times, since there are
+    // at least two banks
+    { SIG_3F, 2, 2, { 0x85, 0x3F } },  // STA $3F
+
+    // BUS ARM code has 2 occurrences of the string BUS
+    // Note: all Harmony/Melody custom drivers also contain the value
+    // 0x10adab1e (LOADABLE) if needed for future improvement
+    { SIG_BUS, 2, 3, { 'B', 'U', 'S' } },
+
+    // CDF ARM code has 3 occurrences of the string CDF
+    { SIG_CDF, 3, 3, { 'C', 'D', 'F' } },
+
+    // CV RAM access occurs at addresses $f3ff and $f400
+    // These signatures are attributed to the MESS project
+    { SIG_CV, 1, 3, { 0x9D, 0xFF, 0xF3 } },  // STA $F3FF.X
+    { SIG_CV, 1, 3, { 0x99, 0x00, 0xF4 } },  // STA $F400.Y
+
+    // DASH cart is identified key 'TJAD' in the ROM
+    { SIG_DASH, 1, 4, { 'T', 'J', 'A', 'D' } },
+
+    // DPC+ ARM code has 2 occurrences of the string DPC+
+    { SIG_DPCPLUS, 2, 4, { 'D', 'P', 'C', '+' } },
+
+    // E0 cart bankswitching is triggered by accessing addresses
+    // $FE0 to $FF9 using absolute non-indexed addressing
+    // To eliminate false positives (and speed up processing), we
+    // search for only certain known signatures
+    // Thanks to "stella@casperkitty.com" for this advice
+    // These signatures are attributed to the MESS project
+    { SIG_E0, 1, 3, { 0x8D, 0xE0, 0x1F } },  // STA $1FE0
+    { SIG_E0, 1, 3, { 0x8D, 0xE0, 0x5F } },  // STA $5FE0
+    { SIG_E0, 1, 3, { 0x8D, 0xE9, 0xFF } },  // STA $FFE9
+    { SIG_E0, 1, 3, { 0x0C, 0xE0, 0x1F } },  // NOP $1FE0
+    { SIG_E0, 1, 3, { 0xAD, 0xE0, 0x1F } },  // LDA $1FE0
+    { SIG_E0, 1, 3, { 0xAD, 0xE9, 0xFF } },  // LDA $FFE9
+    { SIG_E0, 1, 3, { 0xAD, 0xED, 0xFF } },  // LDA $FFED
+    { SIG_E0, 1, 3, { 0xAD, 0xF3, 0xBF } },  // LDA $BFF3
+
+    // E7 cart bankswitching is triggered by accessing addresses
+    // $FE0 to $FE6 using absolute non-indexed addressing
+    // (known signatures only, as for E0)
+    { SIG_E7, 1, 3, { 0xAD, 0xE2, 0xFF } },  // LDA $FFE2
+    { SIG_E7, 1, 3, { 0xAD, 0xE5, 0xFF } },  // LDA $FFE5
+    { SIG_E7, 1, 3, { 0xAD, 0xE5, 0x1F } },  // LDA $1FE5
+    { SIG_E7, 1, 3, { 0xAD, 0xE7, 0x1F } },  // LDA $1FE7
+    { SIG_E7, 1, 3, { 0x0C, 0xE7, 0x1F } },  // NOP $1FE7
+    { SIG_E7, 1, 3, { 0x8D, 0xE7, 0xFF } },  // STA $FFE7
+    { SIG_E7, 1, 3, { 0x8D, 0xE7, 0x1F } },  // STA $1FE7
+
+    // E78K cart bankswitching is triggered by accessing addresses
+    // $FE4 to $FE6 using absolute non-indexed addressing
+    // (known signatures only, as for E0)
+    { SIG_E78K, 1, 3, { 0xAD, 0xE4, 0xFF } },  // LDA $FFE4
+    { SIG_E78K, 1, 3, { 0xAD, 0xE5, 0xFF } },  // LDA $FFE5
+    { SIG_E78K, 1, 3, { 0xAD, 0xE6, 0xFF } },  // LDA $FFE6
+
+    // EF cart bankswitching switches banks by accessing addresses
+    // 0xFE0 to 0xFEF, usually with either a NOP or LDA
+    // It's likely that the code will switch to bank 0, so that's what is tested
+    { SIG_EF, 1, 3, { 0x0C, 0xE0, 0xFF } },  // NOP $FFE0
+    { SIG_EF, 1, 3, { 0xAD, 0xE0, 0xFF } },  // LDA $FFE0
+    { SIG_EF, 1, 3, { 0x0C, 0xE0, 0x1F } },  // NOP $1FE0
+    { SIG_EF, 1, 3, { 0xAD, 0xE0, 0x1F } },  // LDA $1FE0
+
+    // *Potential* F8, used to tell 8K F8 from FE
+    { SIG_F8, 2, 3, { 0x8D, 0xF9, 0x1F } },  // STA $1FF9
+
+    // FE bankswitching is very weird, but always seems to include a
+    // 'JSR $xxxx'
+    // These signatures are attributed to the MESS project
+    { SIG_FE, 1, 5, { 0x20, 0x00, 0xD0, 0xC6, 0xC5 } },  // JSR $D000; DEC $C5
+    { SIG_FE, 1, 5, { 0x20, 0xC3, 0xF8, 0xA5, 0x82 } },  // JSR $F8C3; LDA $82
+    { SIG_FE, 1, 5, { 0xD0, 0xFB, 0x20, 0x73, 0xFE } },  // BNE $FB; JSR $FE73
+    { SIG_FE, 1, 5, { 0x20, 0x00, 0xF0, 0x84, 0xD6 } },  // JSR $F000; STY $D6
+
+    // SB cart bankswitching switches banks by accessing address 0x0800
+    { SIG_SB, 1, 3, { 0xBD, 0x00, 0x08 } },  // LDA $0800,x
+    { SIG_SB, 1, 3, { 0xAD, 0x00, 0x08 } },  // LDA $0800
+
+    // UA cart bankswitching switches to bank 1 by accessing address 0x240
+    // using 'STA $240' or 'LDA $240'
+    { SIG_UA, 1, 3, { 0x8D, 0x40, 0x02 } },  // STA $240
+    { SIG_UA, 1, 3, { 0xAD, 0x40, 0x02 } },  // LDA $240
+    { SIG_UA, 1, 3, { 0xBD, 0x1F, 0x02 } },  // LDA $21F,X
+
+    // X07 bankswitching switches to bank 0, 1, 2, etc by accessing address 0x08xd
+    { SIG_X07, 1, 3, { 0xAD, 0x0D, 0x08 } },  // LDA $080D
+    { SIG_X07, 1, 3, { 0xAD, 0x1D, 0x08 } },  // LDA $081D
+    { SIG_X07, 1, 3, { 0xAD, 0x2D, 0x08 } },  // LDA $082D
+    { SIG_X07, 1, 3, { 0x0C, 0x0D, 0x08 } },  // NOP $080D
+    { SIG_X07, 1, 3, { 0x0C, 0x1D, 0x08 } },  // NOP $081D
+    { SIG_X07, 1, 3, { 0x0C, 0x2D, 0x08 } }   // NOP $082D
+  };
+  constexpr uInt32 NUM_SIGNATURES = sizeof(SIGNATURES) / sizeof(Signature);
+
+  /**
+    Finds all of the signatures above in a single pass over the image,
+    using an Aho-Corasick automaton.  Since the signatures are few and
+    short, the automaton is stored as a complete transition table, with
+    (far) fewer than 255 states, so that it stays in the L1 cache.
+
+    Occurrences are counted exactly as CartDetector::searchForBytes() does:
+    from the left, each one at least one byte past the end of the previous
+    one, and not at the very end of the image.
+  */
+  class SignatureScanner
+  {
+    public:
+      SignatureScanner()
+        : myNext(1), myMatches(1)
+      {
+        // Build the trie of the signatures
+        myNext[0].fill(NONE);
+        for(uInt32 s = 0; s < NUM_SIGNATURES; ++s)
+        {
+          uInt32 state = 0;
+          for(uInt32 i = 0; i < SIGNATURES[s].size; ++i)
+          {
+            const uInt8 byte = SIGNATURES[s].bytes[i];
+            if(myNext[state][byte] == NONE)
+            {
+              myNext[state][byte] = uInt8(myNext.size());
+              myNext.emplace_back();
+              myNext.back().fill(NONE);
+              myMatches.emplace_back();
+            }
+            state = myNext[state][byte];
+          }
+          myMatches[state].push_back(uInt8(s));
+        }
+
+        // Complete the transitions breadth-first, following the longest
+        // suffix that is also in the trie where a signature doesn't continue
+        vector<uInt8> fallback(myNext.size(), 0);
+        std::queue<uInt8> states;
+        for(uInt32 byte = 0; byte < 256; ++byte)
+        {
+          if(myNext[0][byte] == NONE)
+            myNext[0][byte] = 0;
+          else
+            states.push(myNext[0][byte]);
+        }
+        while(!states.empty())
+        {
+          const uInt8 state = states.front();
+          states.pop();
+
+          // Any signature ending in the fallback state also ends here
+          const vector<uInt8>& inherited = myMatches[fallback[state]];
+          myMatches[state].insert(myMatches[state].end(),
+                                  inherited.begin(), inherited.end());
+
+          for(uInt32 byte = 0; byte < 256; ++byte)
+          {
+            const uInt8 next = myNext[state][byte];
+            if(next == NONE)
+              myNext[state][byte] = myNext[fallback[state]][byte];
+            else
+            {
+              fallback[next] = myNext[fallback[state]][byte];
+              states.push(next);
+            }
+          }
+        }
+      }
+
+      /**
+        Answers the SIG_xxx bits of the schemes whose signatures were found.
+      */
+      uInt32 scan(const uInt8* image, uInt32 size) const
+      {
+        uInt32 hits[NUM_SIGNATURES] = { 0 }, nextStart[NUM_SIGNATURES] = { 0 };
+        uInt32 found = 0;
+        uInt8 state = 0;
+
+        for(uInt32 i = 0; i < size; ++i)
+        {
+          // Outside of any (partial) signature, skip ahead to the next byte
+          // that starts one; this is most of the image, and is done without
+          // waiting for each transition
+          if(state == 0)
+          {
+            while(i < size && myNext[0][image[i]] == 0)
+              ++i;
+            if(i == size)
+              break;
+          }
+
+          state = myNext[state][image[i]];
+          for(uInt8 s: myMatches[state])
+          {
+            const Signature& sig = SIGNATURES[s];
+            const uInt32 start = i + 1 - sig.size;
+            if(start >= nextStart[s] && i + 1 < size)
+            {
+              nextStart[s] = start + sig.size + 1;
+              if(++hits[s] == sig.minhits)
+                found |= sig.scheme;
+            }
+          }
+        }
+        return found;
+      }
+
+    private:
+      static constexpr uInt8 NONE = 0xFF;
+
+      vector<std::array<uInt8, 256>> myNext;   // Transitions of each state
+      vector<vector<uInt8>> myMatches;         // Signatures ending there
+  };
+
+  uInt32 findSignatures(const uInt8* image, uInt32 size)
+  {
+    static const SignatureScanner scanner;
+    return scanner.scan(image, size);
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-unique_ptr<Cartridge> CartDetector::create(const BytePtr& image, uInt32 size,
-    string& md5, const string& propertiesType, const OSystem& osystem)
+unique_ptr<Cartridge> CartDetector::create(const ImagePtr& image, uInt32 size,
+    string& md5, const string& propertiesType, BSType& autodetected,
+    const OSystem& osystem)
 {
   unique_ptr<Cartridge> cartridge;
   BSType type = Bankswitch::nameToType(propertiesType),
@@ -81,7 +354,10 @@ unique_ptr<Cartridge> CartDetector::create(const BytePtr& image, uInt32 size,
   // If we ask for extended info, always do an autodetect
   if(type == BSType::_AUTO || osystem.settings().getBool("rominfo"))
   {
-    detectedType = autodetectType(image, size);
+    // The image only needs to be scanned if it wasn't seen before
+    if(autodetected == BSType::_AUTO)
+      autodetected = autodetectType(image.get(), size);
+    detectedType = autodetected;
     if(type != BSType::_AUTO && type != detectedType)
       cerr << "Auto-detection not consistent: "
            << Bankswitch::typeToName(type) << ", "
@@ -204,17 +480,18 @@ unique_ptr<Cartridge> CartDetector::create(const BytePtr& image, uInt32 size,
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 unique_ptr<Cartridge>
-CartDetector::createFromMultiCart(const BytePtr& image, uInt32& size,
+CartDetector::createFromMultiCart(const ImagePtr& image, uInt32& size,
     uInt32 numroms, string& md5, BSType type, string& id, const OSystem& osystem)
 {
   // Get a piece of the larger image
   uInt32 i = osystem.settings().getInt("romloadcount");
   size /= numroms;
-  BytePtr slice = make_unique<uInt8[]>(size);
-  memcpy(slice.get(), image.get()+i*size, size);
+
+  // The slice shares the image, rather than copying that part of it
+  ImagePtr slice(image, image.get() + i*size);
 
   // We need a new md5 and name
-  md5 = MD5::hash(slice, size);
+  md5 = MD5::hash(slice.get(), size);
   ostringstream buf;
   buf << " [G" << (i+1) << "]";
   id = buf.str();
@@ -232,7 +509,7 @@ CartDetector::createFromMultiCart(const BytePtr& image, uInt32& size,
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 unique_ptr<Cartridge>
-CartDetector::createFromImage(const BytePtr& image, uInt32 size, BSType type,
+CartDetector::createFromImage(const ImagePtr& image, uInt32 size, BSType type,
                               const string& md5, const OSystem& osystem)
 {
   // We should know the cart's type by now so let's create it
@@ -328,11 +605,14 @@ CartDetector::createFromImage(const BytePtr& image, uInt32 size, BSType type,
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-BSType CartDetector::autodetectType(const BytePtr& image, uInt32 size)
+BSType CartDetector::autodetectType(const uInt8* image, uInt32 size)
 {
   // Guess type based on size
   BSType type = BSType::_AUTO;
 
+  // Search for all signatures at once
+  const uInt32 found = findSignatures(image, size);
+
   if(isProbablyCVPlus(image,size))
   {
     type = BSType::_CVP;
@@ -346,13 +626,13 @@ BSType CartDetector::autodetectType(const BytePtr& image, uInt32 size)
     type = BSType::_2K;
   }
   else if((size == 2048) ||
-          (size == 4096 && memcmp(image.get(), image.get() + 2048, 2048) == 0))
+          (size == 4096 && memcmp(image, image + 2048, 2048) == 0))
   {
-    type = isProbablyCV(image, size) ? BSType::_CV : BSType::_2K;
+    type = (found & SIG_CV) ? BSType::_CV : BSType::_2K;
   }
   else if(size == 4096)
   {
-    if(isProbablyCV(image, size))
+    if(found & SIG_CV)
       type = BSType::_CV;
     else if(isProbably4KSC(image, size))
       type = BSType::_4KSC;
@@ -361,27 +641,23 @@ BSType CartDetector::autodetectType(const BytePtr& image, uInt32 size)
   }
   else if(size == 8*1024)  // 8K
   {
-    // First check for *potential* F8
-    uInt8 signature[] = { 0x8D, 0xF9, 0x1F };  // STA $1FF9
-    bool f8 = searchForBytes(image.get(), size, signature, 3, 2);
-
     if(isProbablySC(image, size))
       type = BSType::_F8SC;
-    else if(memcmp(image.get(), image.get() + 4096, 4096) == 0)
+    else if(memcmp(image, image + 4096, 4096) == 0)
       type = BSType::_4K;
-    else if(isProbablyE0(image, size))
+    else if(found & SIG_E0)
       type = BSType::_E0;
-    else if(isProbably3E(image, size))
+    else if(found & SIG_3E)
       type = BSType::_3E;
-    else if(isProbably3F(image, size))
+    else if(found & SIG_3F)
       type = BSType::_3F;
-    else if(isProbablyUA(image, size))
+    else if(found & SIG_UA)
       type = BSType::_UA;
-    else if(isProbablyFE(image, size) && !f8)
+    else if((found & (SIG_FE | SIG_F8)) == SIG_FE)
       type = BSType::_FE;
-    else if(isProbably0840(image, size))
+    else if(found & SIG_0840)
       type = BSType::_0840;
-    else if(isProbablyE78K(image, size))
+    else if(found & SIG_E78K)
       type = BSType::_E78K;
     else
       type = BSType::_F8;
@@ -402,12 +678,12 @@ BSType CartDetector::autodetectType(const BytePtr& image, uInt32 size)
   {
     if(isProbablySC(image, size))
       type = BSType::_F6SC;
-    else if(isProbablyE7(image, size))
+    else if(found & SIG_E7)
       type = BSType::_E7;
-    else if(isProbably3E(image, size))
+    else if(found & SIG_3E)
       type = BSType::_3E;
   /* no known 16K 3F ROMS
-    else if(isProbably3F(image, size))
+    else if(found & SIG_3F)
       type = BSType::_3F;
   */
     else
@@ -421,22 +697,22 @@ BSType CartDetector::autodetectType(const BytePtr& image, uInt32 size)
   {
     if(isProbablyARM(image, size))
       type = BSType::_FA2;
-    else /*if(isProbablyDPCplus(image, size))*/
+    else /*if(found & SIG_DPCPLUS)*/
       type = BSType::_DPCP;
   }
   else if(size == 32*1024)  // 32K
   {
     if(isProbablySC(image, size))
       type = BSType::_F4SC;
-    else if(isProbably3E(image, size))
+    else if(found & SIG_3E)
       type = BSType::_3E;
-    else if(isProbably3F(image, size))
+    else if(found & SIG_3F)
       type = BSType::_3F;
-    else if (isProbablyBUS(image, size))
+    else if (found & SIG_BUS)
       type = BSType::_BUS;
-    else if (isProbablyCDF(image, size))
+    else if (found & SIG_CDF)
       type = BSType::_CDF;
-    else if(isProbablyDPCplus(image, size))
+    else if(found & SIG_DPCPLUS)
       type = BSType::_DPCP;
     else if(isProbablyCTY(image, size))
       type = BSType::_CTY;
@@ -447,57 +723,57 @@ BSType CartDetector::autodetectType(const BytePtr& image, uInt32 size)
   }
   else if(size == 64*1024)  // 64K
   {
-    if(isProbably3E(image, size))
+    if(found & SIG_3E)
       type = BSType::_3E;
-    else if(isProbably3F(image, size))
+    else if(found & SIG_3F)
       type = BSType::_3F;
     else if(isProbably4A50(image, size))
       type = BSType::_4A50;
-    else if(isProbablyEF(image, size, type))
+    else if(isProbablyEF(image, size, found & SIG_EF, type))
       ; // type has been set directly in the function
-    else if(isProbablyX07(image, size))
+    else if(found & SIG_X07)
       type = BSType::_X07;
     else
       type = BSType::_F0;
   }
   else if(size == 128*1024)  // 128K
   {
-    if(isProbably3E(image, size))
+    if(found & SIG_3E)
       type = BSType::_3E;
     else if(isProbablyDF(image, size, type))
       ; // type has been set directly in the function
-    else if(isProbably3F(image, size))
+    else if(found & SIG_3F)
       type = BSType::_3F;
     else if(isProbably4A50(image, size))
       type = BSType::_4A50;
-    else if(isProbablySB(image, size))
+    else if(found & SIG_SB)
       type = BSType::_SB;
   }
   else if(size == 256*1024)  // 256K
   {
-    if(isProbably3E(image, size))
+    if(found & SIG_3E)
       type = BSType::_3E;
     else if(isProbablyBF(image, size, type))
       ; // type has been set directly in the function
-    else if(isProbably3F(image, size))
+    else if(found & SIG_3F)
       type = BSType::_3F;
-    else /*if(isProbablySB(image, size))*/
+    else /*if(found & SIG_SB)*/
       type = BSType::_SB;
   }
   else  // what else can we do?
   {
-    if(isProbably3E(image, size))
+    if(found & SIG_3E)
       type = BSType::_3E;
-    else if(isProbably3F(image, size))
+    else if(found & SIG_3F)
       type = BSType::_3F;
     else
       type = BSType::_4K;  // Most common bankswitching type
   }
 
   // Variable sized ROM formats are independent of image size and come last
-  if(isProbablyDASH(image, size))
+  if(found & SIG_DASH)
     type = BSType::_DASH;
-  else if(isProbably3EPlus(image, size))
+  else if(found & SIG_3EPLUS)
     type = BSType::_3EP;
   else if(isProbablyMDM(image, size))
     type = BSType::_MDM;
@@ -534,11 +810,11 @@ bool CartDetector::searchForBytes(const uInt8* image, uInt32 imagesize,
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablySC(const BytePtr& image, uInt32 size)
+bool CartDetector::isProbablySC(const uInt8* image, uInt32 size)
 {
   // We assume a Superchip cart repeats the first 128 bytes for the second
   // 128 bytes in the RAM area, which is the first 256 bytes of each 4K bank
-  const uInt8* ptr = image.get();
+  const uInt8* ptr = image;
   while(size)
   {
     if(memcmp(ptr, ptr + 128, 128) != 0)
@@ -551,7 +827,7 @@ bool CartDetector::isProbablySC(const BytePtr& image, uInt32 size)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably4KSC(const BytePtr& image, uInt32 size)
+bool CartDetector::isProbably4KSC(const uInt8* image, uInt32 size)
 {
   // We check if the first 256 bytes are identical *and* if there's
   // an "SC" signature for one of our larger SC types at 1FFA.
@@ -568,7 +844,7 @@ bool CartDetector::isProbably4KSC(const BytePtr& image, uInt32 size)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyARM(const BytePtr& image, uInt32 size)
+bool CartDetector::isProbablyARM(const uInt8* image, uInt32 size)
 {
   // ARM code contains the following 'loader' patterns in the first 1K
   // Thanks to Thomas Jentzsch of AtariAge for this advice
@@ -576,68 +852,14 @@ bool CartDetector::isProbablyARM(const BytePtr& image, uInt32 size)
     { 0xA0, 0xC1, 0x1F, 0xE0 },
     { 0x00, 0x80, 0x02, 0xE0 }
   };
-  if(searchForBytes(image.get(), std::min(size, 1024u), signature[0], 4, 1))
+  if(searchForBytes(image, std::min(size, 1024u), signature[0], 4, 1))
     return true;
   else
-    return searchForBytes(image.get(), std::min(size, 1024u), signature[1], 4, 1);
+    return searchForBytes(image, std::min(size, 1024u), signature[1], 4, 1);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably0840(const BytePtr& image, uInt32 size)
-{
-  // 0840 cart bankswitching is triggered by accessing addresses 0x0800
-  // or 0x0840 at least twice
-  uInt8 signature1[3][3] = {
-    { 0xAD, 0x00, 0x08 },  // LDA $0800
-    { 0xAD, 0x40, 0x08 },  // LDA $0840
-    { 0x2C, 0x00, 0x08 }   // BIT $0800
-  };
-  for(uInt32 i = 0; i < 3; ++i)
-    if(searchForBytes(image.get(), size, signature1[i], 3, 2))
-      return true;
-
-  uInt8 signature2[2][4] = {
-    { 0x0C, 0x00, 0x08, 0x4C },  // NOP $0800; JMP ...
-    { 0x0C, 0xFF, 0x0F, 0x4C }   // NOP $0FFF; JMP ...
-  };
-  for(uInt32 i = 0; i < 2; ++i)
-    if(searchForBytes(image.get(), size, signature2[i], 4, 2))
-      return true;
-
-  return false;
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably3E(const BytePtr& image, uInt32 size)
-{
-  // 3E cart bankswitching is triggered by storing the bank number
-  // in address 3E using 'STA $3E', commonly followed by an
-  // immediate mode LDA
-  uInt8 signature[] = { 0x85, 0x3E, 0xA9, 0x00 };  // STA $3E; LDA #$00
-  return searchForBytes(image.get(), size, signature, 4, 1);
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably3EPlus(const BytePtr& image, uInt32 size)
-{
-  // 3E+ cart is identified key 'TJ3E' in the ROM
-  uInt8 signature[] = { 'T', 'J', '3', 'E' };
-  return searchForBytes(image.get(), size, signature, 4, 1);
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably3F(const BytePtr& image, uInt32 size)
-{
-  // 3F cart bankswitching is triggered by storing the bank number
-  // in address 3F using 'STA $3F'
-  // We expect it will be present at least 2 times, since there are
-  // at least two banks
-  uInt8 signature[] = { 0x85, 0x3F };  // STA $3F
-  return searchForBytes(image.get(), size, signature, 2, 2);
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably4A50(const BytePtr& image, uInt32 size)
+bool CartDetector::isProbably4A50(const uInt8* image, uInt32 size)
 {
   // 4A50 carts store address $4A50 at the NMI vector, which
   // in this scheme is always in the last page of ROM at
@@ -655,164 +877,43 @@ bool CartDetector::isProbably4A50(const BytePtr& image, uInt32 size)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyCTY(const BytePtr&, uInt32)
+bool CartDetector::isProbablyCTY(const uInt8*, uInt32)
 {
   return false;  // TODO - add autodetection
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyCV(const BytePtr& image, uInt32 size)
-{
-  // CV RAM access occurs at addresses $f3ff and $f400
-  // These signatures are attributed to the MESS project
-  uInt8 signature[2][3] = {
-    { 0x9D, 0xFF, 0xF3 },  // STA $F3FF.X
-    { 0x99, 0x00, 0xF4 }   // STA $F400.Y
-  };
-  if(searchForBytes(image.get(), size, signature[0], 3, 1))
-    return true;
-  else
-    return searchForBytes(image.get(), size, signature[1], 3, 1);
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyCVPlus(const BytePtr& image, uInt32)
+bool CartDetector::isProbablyCVPlus(const uInt8* image, uInt32)
 {
   // CV+ cart is identified key 'commavidplus' @ $04 in the ROM
   // We inspect only this area to speed up the search
   uInt8 signature[12] = { 'c', 'o', 'm', 'm', 'a', 'v', 'i', 'd',
                           'p', 'l', 'u', 's' };
-  return searchForBytes(image.get()+4, 24, signature, 12, 1);
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyDASH(const BytePtr& image, uInt32 size)
-{
-  // DASH cart is identified key 'TJAD' in the ROM
-  uInt8 signature[] = { 'T', 'J', 'A', 'D' };
-  return searchForBytes(image.get(), size, signature, 4, 1);
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyDPCplus(const BytePtr& image, uInt32 size)
-{
-  // DPC+ ARM code has 2 occurrences of the string DPC+
-  // Note: all Harmony/Melody custom drivers also contain the value
-  // 0x10adab1e (LOADABLE) if needed for future improvement
-  uInt8 signature[] = { 'D', 'P', 'C', '+' };
-  return searchForBytes(image.get(), size, signature, 4, 2);
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyE0(const BytePtr& image, uInt32 size)
-{
-  // E0 cart bankswitching is triggered by accessing addresses
-  // $FE0 to $FF9 using absolute non-indexed addressing
-  // To eliminate false positives (and speed up processing), we
-  // search for only certain known signatures
-  // Thanks to "stella@casperkitty.com" for this advice
-  // These signatures are attributed to the MESS project
-  uInt8 signature[8][3] = {
-    { 0x8D, 0xE0, 0x1F },  // STA $1FE0
-    { 0x8D, 0xE0, 0x5F },  // STA $5FE0
-    { 0x8D, 0xE9, 0xFF },  // STA $FFE9
-    { 0x0C, 0xE0, 0x1F },  // NOP $1FE0
-    { 0xAD, 0xE0, 0x1F },  // LDA $1FE0
-    { 0xAD, 0xE9, 0xFF },  // LDA $FFE9
-    { 0xAD, 0xED, 0xFF },  // LDA $FFED
-    { 0xAD, 0xF3, 0xBF }   // LDA $BFF3
-  };
-  for(uInt32 i = 0; i < 8; ++i)
-    if(searchForBytes(image.get(), size, signature[i], 3, 1))
-      return true;
-
-  return false;
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyE7(const BytePtr& image, uInt32 size)
-{
-  // E7 cart bankswitching is triggered by accessing addresses
-  // $FE0 to $FE6 using absolute non-indexed addressing
-  // To eliminate false positives (and speed up processing), we
-  // search for only certain known signatures
-  // Thanks to "stella@casperkitty.com" for this advice
-  // These signatures are attributed to the MESS project
-  uInt8 signature[7][3] = {
-    { 0xAD, 0xE2, 0xFF },  // LDA $FFE2
-    { 0xAD, 0xE5, 0xFF },  // LDA $FFE5
-    { 0xAD, 0xE5, 0x1F },  // LDA $1FE5
-    { 0xAD, 0xE7, 0x1F },  // LDA $1FE7
-    { 0x0C, 0xE7, 0x1F },  // NOP $1FE7
-    { 0x8D, 0xE7, 0xFF },  // STA $FFE7
-    { 0x8D, 0xE7, 0x1F }   // STA $1FE7
-  };
-  for(uInt32 i = 0; i < 7; ++i)
-    if(searchForBytes(image.get(), size, signature[i], 3, 1))
-      return true;
-
-  return false;
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyE78K(const BytePtr& image, uInt32 size)
-{
-  // E78K cart bankswitching is triggered by accessing addresses
-  // $FE4 to $FE6 using absolute non-indexed addressing
-  // To eliminate false positives (and speed up processing), we
-  // search for only certain known signatures
-  uInt8 signature[3][3] = {
-    { 0xAD, 0xE4, 0xFF },  // LDA $FFE4
-    { 0xAD, 0xE5, 0xFF },  // LDA $FFE5
-    { 0xAD, 0xE6, 0xFF },  // LDA $FFE6
-  };
-  for(uInt32 i = 0; i < 3; ++i)
-    if(searchForBytes(image.get(), size, signature[i], 3, 1))
-      return true;
-
-  return false;
+  return searchForBytes(image+4, 24, signature, 12, 1);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyEF(const BytePtr& image, uInt32 size, BSType& type)
+bool CartDetector::isProbablyEF(const uInt8* image, uInt32 size,
+                                bool bankswitching, BSType& type)
 {
   // Newer EF carts store strings 'EFEF' and 'EFSC' starting at address $FFF8
   // This signature is attributed to "RevEng" of AtariAge
   uInt8 efef[] = { 'E', 'F', 'E', 'F' };
   uInt8 efsc[] = { 'E', 'F', 'S', 'C' };
-  if(searchForBytes(image.get()+size-8, 8, efef, 4, 1))
+  if(searchForBytes(image+size-8, 8, efef, 4, 1))
   {
     type = BSType::_EF;
     return true;
   }
-  else if(searchForBytes(image.get()+size-8, 8, efsc, 4, 1))
+  else if(searchForBytes(image+size-8, 8, efsc, 4, 1))
   {
     type = BSType::_EFSC;
     return true;
   }
 
-  // Otherwise, EF cart bankswitching switches banks by accessing addresses
-  // 0xFE0 to 0xFEF, usually with either a NOP or LDA
-  // It's likely that the code will switch to bank 0, so that's what is tested
-  bool isEF = false;
-  uInt8 signature[4][3] = {
-    { 0x0C, 0xE0, 0xFF },  // NOP $FFE0
-    { 0xAD, 0xE0, 0xFF },  // LDA $FFE0
-    { 0x0C, 0xE0, 0x1F },  // NOP $1FE0
-    { 0xAD, 0xE0, 0x1F }   // LDA $1FE0
-  };
-  for(uInt32 i = 0; i < 4; ++i)
-  {
-    if(searchForBytes(image.get(), size, signature[i], 3, 1))
-    {
-      isEF = true;
-      break;
-    }
-  }
-
-  // Now that we know that the ROM is EF, we need to check if it's
-  // the SC variant
-  if(isEF)
+  // Otherwise, it's EF if its bankswitching signatures were found (see
+  // SIG_EF), and then we need to check if it's the SC variant
+  if(bankswitching)
   {
     type = isProbablySC(image, size) ? BSType::_EFSC : BSType::_EF;
     return true;
@@ -822,18 +923,18 @@ bool CartDetector::isProbablyEF(const BytePtr& image, uInt32 size, BSType& type)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyBF(const BytePtr& image, uInt32 size, BSType& type)
+bool CartDetector::isProbablyBF(const uInt8* image, uInt32 size, BSType& type)
 {
   // BF carts store strings 'BFBF' and 'BFSC' starting at address $FFF8
   // This signature is attributed to "RevEng" of AtariAge
   uInt8 bf[]   = { 'B', 'F', 'B', 'F' };
   uInt8 bfsc[] = { 'B', 'F', 'S', 'C' };
-  if(searchForBytes(image.get()+size-8, 8, bf, 4, 1))
+  if(searchForBytes(image+size-8, 8, bf, 4, 1))
   {
     type = BSType::_BF;
     return true;
   }
-  else if(searchForBytes(image.get()+size-8, 8, bfsc, 4, 1))
+  else if(searchForBytes(image+size-8, 8, bfsc, 4, 1))
   {
     type = BSType::_BFSC;
     return true;
@@ -843,39 +944,19 @@ bool CartDetector::isProbablyBF(const BytePtr& image, uInt32 size, BSType& type)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyBUS(const BytePtr& image, uInt32 size)
-{
-  // BUS ARM code has 2 occurrences of the string BUS
-  // Note: all Harmony/Melody custom drivers also contain the value
-  // 0x10adab1e (LOADABLE) if needed for future improvement
-  uInt8 bus[] = { 'B', 'U', 'S'};
-  return searchForBytes(image.get(), size, bus, 3, 2);
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyCDF(const BytePtr& image, uInt32 size)
-{
-  // CDF ARM code has 3 occurrences of the string DPC+
-  // Note: all Harmony/Melody custom drivers also contain the value
-  // 0x10adab1e (LOADABLE) if needed for future improvement
-  uInt8 signature[] = { 'C', 'D', 'F' };
-  return searchForBytes(image.get(), size, signature, 3, 3);
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyDF(const BytePtr& image, uInt32 size, BSType& type)
+bool CartDetector::isProbablyDF(const uInt8* image, uInt32 size, BSType& type)
 {
 
   // BF carts store strings 'DFDF' and 'DFSC' starting at address $FFF8
   // This signature is attributed to "RevEng" of AtariAge
   uInt8 df[]   = { 'D', 'F', 'D', 'F' };
   uInt8 dfsc[] = { 'D', 'F', 'S', 'C' };
-  if(searchForBytes(image.get()+size-8, 8, df, 4, 1))
+  if(searchForBytes(image+size-8, 8, df, 4, 1))
   {
     type = BSType::_DF;
     return true;
   }
-  else if(searchForBytes(image.get()+size-8, 8, dfsc, 4, 1))
+  else if(searchForBytes(image+size-8, 8, dfsc, 4, 1))
   {
     type = BSType::_DFSC;
     return true;
@@ -885,7 +966,7 @@ bool CartDetector::isProbablyDF(const BytePtr& image, uInt32 size, BSType& type)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyFA2(const BytePtr& image, uInt32)
+bool CartDetector::isProbablyFA2(const uInt8* image, uInt32)
 {
   // This currently tests only the 32K version of FA2; the 24 and 28K
   // versions are easy, in that they're the only possibility with those
@@ -900,78 +981,9 @@ bool CartDetector::isProbablyFA2(const BytePtr& image, uInt32)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyFE(const BytePtr& image, uInt32 size)
-{
-  // FE bankswitching is very weird, but always seems to include a
-  // 'JSR $xxxx'
-  // These signatures are attributed to the MESS project
-  uInt8 signature[4][5] = {
-    { 0x20, 0x00, 0xD0, 0xC6, 0xC5 },  // JSR $D000; DEC $C5
-    { 0x20, 0xC3, 0xF8, 0xA5, 0x82 },  // JSR $F8C3; LDA $82
-    { 0xD0, 0xFB, 0x20, 0x73, 0xFE },  // BNE $FB; JSR $FE73
-    { 0x20, 0x00, 0xF0, 0x84, 0xD6 }   // JSR $F000; STY $D6
-  };
-  for(uInt32 i = 0; i < 4; ++i)
-    if(searchForBytes(image.get(), size, signature[i], 5, 1))
-      return true;
-
-  return false;
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyMDM(const BytePtr& image, uInt32 size)
+bool CartDetector::isProbablyMDM(const uInt8* image, uInt32 size)
 {
   // MDM cart is identified key 'MDMC' in the first 8K of ROM
   uInt8 signature[] = { 'M', 'D', 'M', 'C' };
-  return searchForBytes(image.get(), std::min(size, 8192u), signature, 4, 1);
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablySB(const BytePtr& image, uInt32 size)
-{
-  // SB cart bankswitching switches banks by accessing address 0x0800
-  uInt8 signature[2][3] = {
-    { 0xBD, 0x00, 0x08 },  // LDA $0800,x
-    { 0xAD, 0x00, 0x08 }   // LDA $0800
-  };
-  if(searchForBytes(image.get(), size, signature[0], 3, 1))
-    return true;
-  else
-    return searchForBytes(image.get(), size, signature[1], 3, 1);
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyUA(const BytePtr& image, uInt32 size)
-{
-  // UA cart bankswitching switches to bank 1 by accessing address 0x240
-  // using 'STA $240' or 'LDA $240'
-  uInt8 signature[3][3] = {
-    { 0x8D, 0x40, 0x02 },  // STA $240
-    { 0xAD, 0x40, 0x02 },  // LDA $240
-    { 0xBD, 0x1F, 0x02 }   // LDA $21F,X
-  };
-  for(uInt32 i = 0; i < 3; ++i)
-    if(searchForBytes(image.get(), size, signature[i], 3, 1))
-      return true;
-
-  return false;
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyX07(const BytePtr& image, uInt32 size)
-{
-  // X07 bankswitching switches to bank 0, 1, 2, etc by accessing address 0x08xd
-  uInt8 signature[6][3] = {
-    { 0xAD, 0x0D, 0x08 },  // LDA $080D
-    { 0xAD, 0x1D, 0x08 },  // LDA $081D
-    { 0xAD, 0x2D, 0x08 },  // LDA $082D
-    { 0x0C, 0x0D, 0x08 },  // NOP $080D
-    { 0x0C, 0x1D, 0x08 },  // NOP $081D
-    { 0x0C, 0x2D, 0x08 }   // NOP $082D
-  };
-  for(uInt32 i = 0; i < 6; ++i)
-    if(searchForBytes(image.get(), size, signature[i], 3, 1))
-      return true;
-
-  return false;
+  return searchForBytes(image, std::min(size, 8192u), signature, 4, 1);
 }
@@ -37,16 +37,21 @@ class CartDetector
     /**
       Create a new cartridge object allocated on the heap.  The
       type of cartridge created depends on the properties object.
+      The cartridge may keep referencing the image rather than copying it.
 
       @param image    A pointer to the ROM image
       @param size     The size of the ROM image
       @param md5      The md5sum for the given ROM image (can be updated)
       @param dtype    The detected bankswitch type of the ROM image
+      @param autodetected  The type autodetected for this image before
+                      (used instead of autodetecting it again), or _AUTO if
+                      unknown; updated with the autodetected type (if any)
       @param system   The osystem associated with the system
       @return   Pointer to the new cartridge object allocated on the heap
     */
-    static unique_ptr<Cartridge> create(const BytePtr& image, uInt32 size,
-                 string& md5, const string& dtype, const OSystem& system);
+    static unique_ptr<Cartridge> create(const ImagePtr& image, uInt32 size,
+                 string& md5, const string& dtype, BSType& autodetected,
+                 const OSystem& system);
 
   private:
     /**
@@ -64,7 +69,7 @@ class CartDetector
       @return  Pointer to the new cartridge object allocated on the heap
     */
     static unique_ptr<Cartridge>
-      createFromMultiCart(const BytePtr& image, uInt32& size,
+      createFromMultiCart(const ImagePtr& image, uInt32& size,
         uInt32 numroms, string& md5, BSType type, string& id,
         const OSystem& osystem);
 
@@ -80,18 +85,19 @@ class CartDetector
       @return  Pointer to the new cartridge object allocated on the heap
     */
     static unique_ptr<Cartridge>
-      createFromImage(const BytePtr& image, uInt32 size, BSType type,
+      createFromImage(const ImagePtr& image, uInt32 size, BSType type,
                       const string& md5, const OSystem& osystem);
 
     /**
-      Try to auto-detect the bankswitching type of the cartridge
+      Try to auto-detect the bankswitching type of the cartridge; the
+      signatures looked for in the whole image are all found in one pass
 
       @param image  A pointer to the ROM image
       @param size   The size of the ROM image
 
       @return The "best guess" for the cartridge type
     */
-    static BSType autodetectType(const BytePtr& image, uInt32 size);
+    static BSType autodetectType(const uInt8* image, uInt32 size);
 
     /**
       Search the image for the specified byte signature
@@ -112,142 +118,64 @@ class CartDetector
       Returns true if the image is probably a SuperChip (128 bytes RAM)
       Note: should be called only on ROMs with size multiple of 4K
     */
-    static bool isProbablySC(const BytePtr& image, uInt32 size);
+    static bool isProbablySC(const uInt8* image, uInt32 size);
 
     /**
       Returns true if the image is probably a 4K SuperChip (128 bytes RAM)
     */
-    static bool isProbably4KSC(const BytePtr& image, uInt32 size);
+    static bool isProbably4KSC(const uInt8* image, uInt32 size);
 
     /**
       Returns true if the image probably contains ARM code in the first 1K
     */
-    static bool isProbablyARM(const BytePtr& image, uInt32 size);
-
-    /**
-      Returns true if the image is probably a 0840 bankswitching cartridge
-    */
-    static bool isProbably0840(const BytePtr& image, uInt32 size);
-
-    /**
-      Returns true if the image is probably a 3E bankswitching cartridge
-    */
-    static bool isProbably3E(const BytePtr& image, uInt32 size);
-
-    /**
-      Returns true if the image is probably a 3E+ bankswitching cartridge
-    */
-    static bool isProbably3EPlus(const BytePtr& image, uInt32 size);
-
-    /**
-      Returns true if the image is probably a 3F bankswitching cartridge
-    */
-    static bool isProbably3F(const BytePtr& image, uInt32 size);
+    static bool isProbablyARM(const uInt8* image, uInt32 size);
 
     /**
       Returns true if the image is probably a 4A50 bankswitching cartridge
     */
-    static bool isProbably4A50(const BytePtr& image, uInt32 size);
+    static bool isProbably4A50(const uInt8* image, uInt32 size);
 
     /**
       Returns true if the image is probably a BF/BFSC bankswitching cartridge
     */
-    static bool isProbablyBF(const BytePtr& image, uInt32 size, BSType& type);
-
-    /**
-      Returns true if the image is probably a BUS bankswitching cartridge
-    */
-    static bool isProbablyBUS(const BytePtr& image, uInt32 size);
-
-    /**
-      Returns true if the image is probably a CDF bankswitching cartridge
-    */
-    static bool isProbablyCDF(const BytePtr& image, uInt32 size);
+    static bool isProbablyBF(const uInt8* image, uInt32 size, BSType& type);
 
     /**
       Returns true if the image is probably a CTY bankswitching cartridge
     */
-    static bool isProbablyCTY(const BytePtr& image, uInt32 size);
-
-    /**
-      Returns true if the image is probably a CV bankswitching cartridge
-    */
-    static bool isProbablyCV(const BytePtr& image, uInt32 size);
+    static bool isProbablyCTY(const uInt8* image, uInt32 size);
 
     /**
       Returns true if the image is probably a CV+ bankswitching cartridge
     */
-    static bool isProbablyCVPlus(const BytePtr& image, uInt32 size);
-
-    /**
-      Returns true if the image is probably a DASH bankswitching cartridge
-    */
-    static bool isProbablyDASH(const BytePtr& image, uInt32 size);
+    static bool isProbablyCVPlus(const uInt8* image, uInt32 size);
 
     /**
       Returns true if the image is probably a DF/DFSC bankswitching cartridge
     */
-    static bool isProbablyDF(const BytePtr& image, uInt32 size, BSType& type);
-
-    /**
-      Returns true if the image is probably a DPC+ bankswitching cartridge
-    */
-    static bool isProbablyDPCplus(const BytePtr& image, uInt32 size);
-
-    /**
-      Returns true if the image is probably a E0 bankswitching cartridge
-    */
-    static bool isProbablyE0(const BytePtr& image, uInt32 size);
-
-    /**
-      Returns true if the image is probably a E7 bankswitching cartridge
-    */
-    static bool isProbablyE7(const BytePtr& image, uInt32 size);
-
-    /**
-    Returns true if the image is probably a E78K bankswitching cartridge
-    */
-    static bool isProbablyE78K(const BytePtr& image, uInt32 size);
+    static bool isProbablyDF(const uInt8* image, uInt32 size, BSType& type);
 
     /**
       Returns true if the image is probably an EF/EFSC bankswitching cartridge
+      (bankswitching: whether EF bankswitching instructions were found)
     */
-    static bool isProbablyEF(const BytePtr& image, uInt32 size, BSType& type);
+    static bool isProbablyEF(const uInt8* image, uInt32 size,
+                             bool bankswitching, BSType& type);
 
     /**
       Returns true if the image is probably an F6 bankswitching cartridge
     */
-    //static bool isProbablyF6(const BytePtr& image, uInt32 size);
+    //static bool isProbablyF6(const uInt8* image, uInt32 size);
 
     /**
       Returns true if the image is probably an FA2 bankswitching cartridge
     */
-    static bool isProbablyFA2(const BytePtr& image, uInt32 size);
-
-    /**
-      Returns true if the image is probably an FE bankswitching cartridge
-    */
-    static bool isProbablyFE(const BytePtr& image, uInt32 size);
+    static bool isProbablyFA2(const uInt8* image, uInt32 size);
 
     /**
       Returns true if the image is probably a MDM bankswitching cartridge
     */
-    static bool isProbablyMDM(const BytePtr& image, uInt32 size);
-
-    /**
-      Returns true if the image is probably a SB bankswitching cartridge
-    */
-    static bool isProbablySB(const BytePtr& image, uInt32 size);
-
-    /**
-      Returns true if the image is probably a UA bankswitching cartridge
-    */
-    static bool isProbablyUA(const BytePtr& image, uInt32 size);
-
-    /**
-      Returns true if the image is probably an X07 bankswitching cartridge
-    */
-    static bool isProbablyX07(const BytePtr& image, uInt32 size);
+    static bool isProbablyMDM(const uInt8* image, uInt32 size);
 
   private:
     // Following constructors and assignment operators not supported
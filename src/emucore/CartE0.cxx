@@ -19,7 +19,7 @@
 #include "CartE0.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeE0::CartridgeE0(const BytePtr& image, uInt32 size,
+CartridgeE0::CartridgeE0(const ImagePtr& image, uInt32 size,
                          const Settings& settings)
   : Cartridge(settings)
 {
@@ -56,6 +56,19 @@ void CartridgeE0::install(System& system)
 
   System::PageAccess access(this, System::PA_READ);
 
+  // Precompute the pages of every slice, which can then be switched into
+  // any of the first three segments
+  myBankPages.clear();
+  for(uInt16 offset = 0; offset < 8192; offset += 1024)
+  {
+    for(uInt16 addr = 0; addr < 0x0400; addr += System::PAGE_SIZE)
+    {
+      access.directPeekBase = &myImage[offset + addr];
+      access.codeAccessBase = &myCodeAccessBase[offset + addr];
+      myBankPages.push_back(access);
+    }
+  }
+
   // Set the page acessing methods for the first part of the last segment
   for(uInt16 addr = 0x1C00; addr < (0x1FE0U & ~System::PAGE_MASK);
       addr += System::PAGE_SIZE)
@@ -126,15 +139,8 @@ void CartridgeE0::segmentZero(uInt16 slice)
   myCurrentSlice[0] = slice;
   uInt16 offset = slice << 10;
 
-  // Setup the page access methods for the current bank
-  System::PageAccess access(this, System::PA_READ);
-
-  for(uInt16 addr = 0x1000; addr < 0x1400; addr += System::PAGE_SIZE)
-  {
-    access.directPeekBase = &myImage[offset + (addr & 0x03FF)];
-    access.codeAccessBase = &myCodeAccessBase[offset + (addr & 0x03FF)];
-    mySystem->setPageAccess(addr, access);
-  }
+  // Switch in the precomputed pages of the slice
+  mySystem->mapPages(0x1000, &myBankPages[offset >> System::PAGE_SHIFT], 0x0400);
   myBankChanged = true;
 }
 
@@ -147,15 +153,8 @@ void CartridgeE0::segmentOne(uInt16 slice)
   myCurrentSlice[1] = slice;
   uInt16 offset = slice << 10;
 
-  // Setup the page access methods for the current bank
-  System::PageAccess access(this, System::PA_READ);
-
-  for(uInt16 addr = 0x1400; addr < 0x1800; addr += System::PAGE_SIZE)
-  {
-    access.directPeekBase = &myImage[offset + (addr & 0x03FF)];
-    access.codeAccessBase = &myCodeAccessBase[offset + (addr & 0x03FF)];
-    mySystem->setPageAccess(addr, access);
-  }
+  // Switch in the precomputed pages of the slice
+  mySystem->mapPages(0x1400, &myBankPages[offset >> System::PAGE_SHIFT], 0x0400);
   myBankChanged = true;
 }
 
@@ -168,15 +167,8 @@ void CartridgeE0::segmentTwo(uInt16 slice)
   myCurrentSlice[2] = slice;
   uInt16 offset = slice << 10;
 
-  // Setup the page access methods for the current bank
-  System::PageAccess access(this, System::PA_READ);
-
-  for(uInt16 addr = 0x1800; addr < 0x1C00; addr += System::PAGE_SIZE)
-  {
-    access.directPeekBase = &myImage[offset + (addr & 0x03FF)];
-    access.codeAccessBase = &myCodeAccessBase[offset + (addr & 0x03FF)];
-    mySystem->setPageAccess(addr, access);
-  }
+  // Switch in the precomputed pages of the slice
+  mySystem->mapPages(0x1800, &myBankPages[offset >> System::PAGE_SHIFT], 0x0400);
   myBankChanged = true;
 }
 
@@ -53,7 +53,7 @@ class CartridgeE0 : public Cartridge
       @param size      The size of the ROM image
       @param settings  A reference to the various settings (read-only)
     */
-    CartridgeE0(const BytePtr& image, uInt32 size, const Settings& settings);
+    CartridgeE0(const ImagePtr& image, uInt32 size, const Settings& settings);
     virtual ~CartridgeE0() = default;
 
   public:
@@ -19,7 +19,7 @@
 #include "CartE7.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeE7::CartridgeE7(const BytePtr& image, uInt32 size,
+CartridgeE7::CartridgeE7(const ImagePtr& image, uInt32 size,
                          const Settings& settings)
   : CartridgeMNetwork(image, size, settings)
 {
@@ -42,7 +42,7 @@ class CartridgeE7 : public CartridgeMNetwork
       @param size      The size of the ROM image
       @param settings  A reference to the various settings (read-only)
     */
-    CartridgeE7(const BytePtr& image, uInt32 size, const Settings& settings);
+    CartridgeE7(const ImagePtr& image, uInt32 size, const Settings& settings);
     virtual ~CartridgeE7() = default;
 
   public:
@@ -19,7 +19,7 @@
 #include "CartE78K.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeE78K::CartridgeE78K(const BytePtr& image, uInt32 size,
+CartridgeE78K::CartridgeE78K(const ImagePtr& image, uInt32 size,
                          const Settings& settings)
   : CartridgeMNetwork(image, size, settings)
 {
@@ -40,7 +40,7 @@ class CartridgeE78K : public CartridgeMNetwork
       @param size      The size of the ROM image
       @param settings  A reference to the various settings (read-only)
     */
-    CartridgeE78K(const BytePtr& image, uInt32 size, const Settings& settings);
+    CartridgeE78K(const ImagePtr& image, uInt32 size, const Settings& settings);
     virtual ~CartridgeE78K() = default;
 
   public:
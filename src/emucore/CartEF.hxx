@@ -45,7 +45,7 @@ class CartridgeEF : public Cartridge
       @param size      The size of the ROM image
       @param settings  A reference to the various settings (read-only)
     */
-    CartridgeEF(const BytePtr& image, uInt32 size, const Settings& settings);
+    CartridgeEF(const ImagePtr& image, uInt32 size, const Settings& settings);
     virtual ~CartridgeEF() = default;
 
   public:
@@ -46,7 +46,7 @@ class CartridgeEFSC : public Cartridge
       @param size      The size of the ROM image
       @param settings  A reference to the various settings (read-only)
     */
-    CartridgeEFSC(const BytePtr& image, uInt32 size, const Settings& settings);
+    CartridgeEFSC(const ImagePtr& image, uInt32 size, const Settings& settings);
     virtual ~CartridgeEFSC() = default;
 
   public:
@@ -45,7 +45,7 @@ class CartridgeF0 : public Cartridge
       @param size      The size of the ROM image
       @param settings  A reference to the various settings (read-only)
     */
-    CartridgeF0(const BytePtr& image, uInt32 size, const Settings& settings);
+    CartridgeF0(const ImagePtr& image, uInt32 size, const Settings& settings);
     virtual ~CartridgeF0() = default;
 
   public:
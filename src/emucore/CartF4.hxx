@@ -44,7 +44,7 @@ class CartridgeF4 : public Cartridge
       @param size      The size of the ROM image
       @param settings  A reference to the various settings (read-only)
     */
-    CartridgeF4(const BytePtr& image, uInt32 size, const Settings& settings);
+    CartridgeF4(const ImagePtr& image, uInt32 size, const Settings& settings);
     virtual ~CartridgeF4() = default;
 
   public:
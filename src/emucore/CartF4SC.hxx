@@ -45,7 +45,7 @@ class CartridgeF4SC : public Cartridge
       @param size      The size of the ROM image
       @param settings  A reference to the various settings (read-only)
     */
-    CartridgeF4SC(const BytePtr& image, uInt32 size, const Settings& settings);
+    CartridgeF4SC(const ImagePtr& image, uInt32 size, const Settings& settings);
     virtual ~CartridgeF4SC() = default;
 
   public:
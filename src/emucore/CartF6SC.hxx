@@ -45,7 +45,7 @@ class CartridgeF6SC : public Cartridge
       @param size      The size of the ROM image
       @param settings  A reference to the various settings (read-only)
     */
-    CartridgeF6SC(const BytePtr& image, uInt32 size, const Settings& settings);
+    CartridgeF6SC(const ImagePtr& image, uInt32 size, const Settings& settings);
     virtual ~CartridgeF6SC() = default;
 
   public:
@@ -45,7 +45,7 @@ class CartridgeF8SC : public Cartridge
       @param size      The size of the ROM image
       @param settings  A reference to the various settings (read-only)
     */
-    CartridgeF8SC(const BytePtr& image, uInt32 size, const Settings& settings);
+    CartridgeF8SC(const ImagePtr& image, uInt32 size, const Settings& settings);
     virtual ~CartridgeF8SC() = default;
 
   public:
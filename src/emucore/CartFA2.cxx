@@ -21,7 +21,7 @@
 #include "CartFA2.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeFA2::CartridgeFA2(const BytePtr& image, uInt32 size,
+CartridgeFA2::CartridgeFA2(const ImagePtr& image, uInt32 size,
                            const OSystem& osystem)
   : Cartridge(osystem.settings()),
     myOSystem(osystem),
@@ -61,26 +61,8 @@ void CartridgeFA2::install(System& system)
 {
   mySystem = &system;
 
-  System::PageAccess access(this, System::PA_READ);
-
-  // Set the page accessing method for the RAM writing pages
-  access.type = System::PA_WRITE;
-  for(uInt16 addr = 0x1000; addr < 0x1100; addr += System::PAGE_SIZE)
-  {
-    access.directPokeBase = &myRAM[addr & 0x00FF];
-    access.codeAccessBase = &myCodeAccessBase[addr & 0x00FF];
-    mySystem->setPageAccess(addr, access);
-  }
-
-  // Set the page accessing method for the RAM reading pages
-  access.directPokeBase = nullptr;
-  access.type = System::PA_READ;
-  for(uInt16 addr = 0x1100; addr < 0x1200; addr += System::PAGE_SIZE)
-  {
-    access.directPeekBase = &myRAM[addr & 0x00FF];
-    access.codeAccessBase = &myCodeAccessBase[0x100 + (addr & 0x00FF)];
-    mySystem->setPageAccess(addr, access);
-  }
+  // Precompute the pages of all banks, including those of the RAM
+  createBankPages(myImage, bankCount(), 0x1FF4, myRAM, 256);
 
   // Install pages for the startup bank
   bank(myStartBank);
@@ -226,24 +208,8 @@ bool CartridgeFA2::bank(uInt16 bank)
   // Remember what bank we're in
   myBankOffset = bank << 12;
 
-  System::PageAccess access(this, System::PA_READ);
-
-  // Set the page accessing methods for the hot spots
-  for(uInt16 addr = (0x1FF4 & ~System::PAGE_MASK); addr < 0x2000;
-      addr += System::PAGE_SIZE)
-  {
-    access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
-    mySystem->setPageAccess(addr, access);
-  }
-
-  // Setup the page access methods for the current bank
-  for(uInt16 addr = 0x1200; addr < (0x1FF4U & ~System::PAGE_MASK);
-      addr += System::PAGE_SIZE)
-  {
-    access.directPeekBase = &myImage[myBankOffset + (addr & 0x0FFF)];
-    access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
-    mySystem->setPageAccess(addr, access);
-  }
+  // Switch in the precomputed pages of the bank
+  mapBank(bank);
   return myBankChanged = true;
 }
 
@@ -19,18 +19,15 @@
 #include "CartMDM.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeMDM::CartridgeMDM(const BytePtr& image, uInt32 size,
+CartridgeMDM::CartridgeMDM(const ImagePtr& image, uInt32 size,
                            const Settings& settings)
   : Cartridge(settings),
     mySize(size),
     myBankOffset(0),
     myBankingDisabled(false)
 {
-  // Allocate array for the ROM image
-  myImage = make_unique<uInt8[]>(mySize);
-
-  // Copy the ROM image into my buffer
-  memcpy(myImage.get(), image.get(), mySize);
+  // Use the ROM image in place, rather than copying it
+  myImage = shareImage(image, mySize);
   createCodeAccessBase(mySize);
 
   // Remember startup bank
@@ -139,7 +136,7 @@ uInt16 CartridgeMDM::bankCount() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool CartridgeMDM::patch(uInt16 address, uInt8 value)
 {
-  myImage[myBankOffset + (address & 0x0FFF)] = value;
+  unshareImage(myImage)[myBankOffset + (address & 0x0FFF)] = value;
   return myBankChanged = true;
 }
 
@@ -147,7 +144,7 @@ bool CartridgeMDM::patch(uInt16 address, uInt8 value)
 const uInt8* CartridgeMDM::getImage(uInt32& size) const
 {
   size = mySize;
-  return myImage.get();
+  return myImage;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -56,7 +56,7 @@ class CartridgeMDM : public Cartridge
       @param size      The size of the ROM image
       @param settings  A reference to the various settings (read-only)
     */
-    CartridgeMDM(const BytePtr& image, uInt32 size, const Settings& settings);
+    CartridgeMDM(const ImagePtr& image, uInt32 size, const Settings& settings);
     virtual ~CartridgeMDM() = default;
 
   public:
@@ -160,8 +160,8 @@ class CartridgeMDM : public Cartridge
     bool poke(uInt16 address, uInt8 value) override;
 
   private:
-    // Pointer to a dynamically allocated ROM image of the cartridge
-    BytePtr myImage;
+    // The ROM image of the cartridge, shared until it's patched
+    const uInt8* myImage;
 
     // Size of the ROM image
     uInt32 mySize;
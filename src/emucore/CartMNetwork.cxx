@@ -19,7 +19,7 @@
 #include "CartMNetwork.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeMNetwork::CartridgeMNetwork(const BytePtr& image, uInt32 size,
+CartridgeMNetwork::CartridgeMNetwork(const ImagePtr& image, uInt32 size,
                                      const Settings& settings)
   : Cartridge(settings),
     mySize(size),
@@ -28,7 +28,7 @@ CartridgeMNetwork::CartridgeMNetwork(const BytePtr& image, uInt32 size,
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void CartridgeMNetwork::initialize(const BytePtr& image, uInt32 size)
+void CartridgeMNetwork::initialize(const ImagePtr& image, uInt32 size)
 {
   // Allocate array for the ROM image
   myImage = make_unique<uInt8[]>(size);
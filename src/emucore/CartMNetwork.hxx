@@ -72,7 +72,7 @@ class CartridgeMNetwork : public Cartridge
       @param size      The size of the ROM image
       @param settings  A reference to the various settings (read-only)
     */
-    CartridgeMNetwork(const BytePtr& image, uInt32 size, const Settings& settings);
+    CartridgeMNetwork(const ImagePtr& image, uInt32 size, const Settings& settings);
     virtual ~CartridgeMNetwork() = default;
 
   public:
@@ -160,7 +160,7 @@ class CartridgeMNetwork : public Cartridge
     /**
       Class initialization
     */
-    void initialize(const BytePtr& image, uInt32 size);
+    void initialize(const ImagePtr& image, uInt32 size);
 
     /**
       Install pages for the specified 256 byte bank of RAM
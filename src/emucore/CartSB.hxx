@@ -45,7 +45,7 @@ class CartridgeSB : public Cartridge
       @param size      The size of the ROM image
       @param settings  A reference to the various settings (read-only)
     */
-    CartridgeSB(const BytePtr& image, uInt32 size, const Settings& settings);
+    CartridgeSB(const ImagePtr& image, uInt32 size, const Settings& settings);
     virtual ~CartridgeSB() = default;
 
   public:
@@ -149,8 +149,9 @@ class CartridgeSB : public Cartridge
     bool poke(uInt16 address, uInt8 value) override;
 
   private:
-    // The 128-256K ROM image and size of the cartridge
-    BytePtr myImage;
+    // The 128-256K ROM image and size of the cartridge; the image is
+    // shared until it's patched
+    const uInt8* myImage;
     uInt32 mySize;
 
     // Indicates the offset into the ROM image (aligns to current bank)
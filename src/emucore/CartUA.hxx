@@ -44,7 +44,7 @@ class CartridgeUA : public Cartridge
       @param size      The size of the ROM image
       @param settings  A reference to the various settings (read-only)
     */
-    CartridgeUA(const BytePtr& image, uInt32 size, const Settings& settings);
+    CartridgeUA(const ImagePtr& image, uInt32 size, const Settings& settings);
     virtual ~CartridgeUA() = default;
 
   public:
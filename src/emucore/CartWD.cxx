@@ -21,7 +21,7 @@
 #include "CartWD.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeWD::CartridgeWD(const BytePtr& image, uInt32 size,
+CartridgeWD::CartridgeWD(const ImagePtr& image, uInt32 size,
                          const Settings& settings)
   : Cartridge(settings),
     mySize(std::min(8195u, size)),
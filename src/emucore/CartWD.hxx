@@ -73,7 +73,7 @@ class CartridgeWD : public Cartridge
       @param size      The size of the ROM image
       @param settings  A reference to the various settings (read-only)
     */
-    CartridgeWD(const BytePtr& image, uInt32 size, const Settings& settings);
+    CartridgeWD(const ImagePtr& image, uInt32 size, const Settings& settings);
     virtual ~CartridgeWD() = default;
 
   public:
@@ -21,7 +21,7 @@
 #include "CartX07.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeX07::CartridgeX07(const BytePtr& image, uInt32 size,
+CartridgeX07::CartridgeX07(const ImagePtr& image, uInt32 size,
                            const Settings& settings)
   : Cartridge(settings),
     myCurrentBank(0)
@@ -54,7 +54,7 @@ class CartridgeX07 : public Cartridge
       @param size      The size of the ROM image
       @param settings  A reference to the various settings (read-only)
     */
-    CartridgeX07(const BytePtr& image, uInt32 size, const Settings& settings);
+    CartridgeX07(const ImagePtr& image, uInt32 size, const Settings& settings);
     virtual ~CartridgeX07() = default;
 
   public:
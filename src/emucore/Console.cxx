@@ -38,6 +38,7 @@
 #include "Paddles.hxx"
 #include "Props.hxx"
 #include "PropsSet.hxx"
+#include "RomInfoCache.hxx"
 #include "SaveKey.hxx"
 #include "Settings.hxx"
 #include "Sound.hxx"
@@ -75,7 +76,7 @@ namespace {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Console::Console(OSystem& osystem, unique_ptr<Cartridge>& cart,
-                 const Properties& props)
+                 const Properties& props, Sound* sound)
   : myOSystem(osystem),
     myEvent(osystem.eventHandler().event()),
     myProperties(props),
@@ -85,7 +86,8 @@ Console::Console(OSystem& osystem, unique_ptr<Cartridge>& cart,
     myCurrentFormat(0),   // Unknown format @ start,
     myAutodetectedYstart(0),
     myUserPaletteDefined(false),
-    myConsoleTiming(ConsoleTiming::ntsc)
+    myConsoleTiming(ConsoleTiming::ntsc),
+    myHeadless(sound != nullptr)
 {
   // Load user-defined palette for this ROM
   loadUserPalette();
@@ -93,7 +95,8 @@ Console::Console(OSystem& osystem, unique_ptr<Cartridge>& cart,
   // Create subsystems for the console
   my6502 = make_unique<M6502>(myOSystem.settings());
   myRiot = make_unique<M6532>(*this, myOSystem.settings());
-  myTIA  = make_unique<TIA>(*this, myOSystem.sound(), myOSystem.settings());
+  myTIA  = make_unique<TIA>(*this, myHeadless ? *sound : myOSystem.sound(),
+                           myOSystem.settings());
   myFrameManager = make_unique<FrameManager>();
   mySwitches = make_unique<Switches>(myEvent, myProperties, myOSystem.settings());
 
@@ -101,6 +104,7 @@ Console::Console(OSystem& osystem, unique_ptr<Cartridge>& cart,
 
   // Construct the system and components
   mySystem = make_unique<System>(osystem, *my6502, *myRiot, *myTIA, *myCart);
+  mySystem->setHeadless(myHeadless);
 
   // The real controllers for this console will be added later
   // For now, we just add dummy joystick controllers, since autodetection
@@ -118,16 +122,36 @@ Console::Console(OSystem& osystem, unique_ptr<Cartridge>& cart,
 
   // Add the real controllers for this system
   // This must be done before the debugger is initialized
+  // A headless console keeps the joysticks, since other controllers may
+  // open ports and files which the real console needs
   const string& md5 = myProperties.get(Cartridge_MD5);
-  setControllers(md5);
+  if(!myHeadless)
+  {
+    setControllers(md5);
+
+    // Mute audio and clear framebuffer while autodetection runs
+    myOSystem.sound().mute(1);
+    myOSystem.frameBuffer().clear();
+  }
 
-  // Mute audio and clear framebuffer while autodetection runs
-  myOSystem.sound().mute(1);
-  myOSystem.frameBuffer().clear();
+  // Autodetection only needs to be done the first time a ROM is opened;
+  // after that, the results are remembered
+  // A headless console must be cheap to create, so it never autodetects;
+  // it uses the remembered results if any, and NTSC defaults otherwise
+  RomInfoCache& romInfo = myOSystem.romInfoCache();
 
   if(myDisplayFormat == "AUTO" || myOSystem.settings().getBool("rominfo"))
   {
-    autodetectFrameLayout();
+    const string& layout = romInfo.frameLayout(md5);
+    if(layout != "")
+      myDisplayFormat = layout;
+    else if(myHeadless)
+      myDisplayFormat = "NTSC";
+    else
+    {
+      autodetectFrameLayout();
+      romInfo.setFrameLayout(md5, myDisplayFormat);
+    }
 
     if(myProperties.get(Display_Format) == "AUTO")
     {
@@ -137,7 +161,12 @@ Console::Console(OSystem& osystem, unique_ptr<Cartridge>& cart,
   }
 
   if (atoi(myProperties.get(Display_YStart).c_str()) == 0) {
-    autodetectYStart();
+    if(!romInfo.getYStart(md5, myDisplayFormat, myAutodetectedYstart) &&
+       !myHeadless)
+    {
+      autodetectYStart();
+      romInfo.setYStart(md5, myDisplayFormat, myAutodetectedYstart);
+    }
   }
 
   myConsoleInfo.DisplayFormat = myDisplayFormat + autodetected;
@@ -179,8 +208,11 @@ Console::Console(OSystem& osystem, unique_ptr<Cartridge>& cart,
     myConsoleTiming = ConsoleTiming::secam;
   }
 
-  bool joyallow4 = myOSystem.settings().getBool("joyallow4");
-  myOSystem.eventHandler().allowAllDirections(joyallow4);
+  if(!myHeadless)
+  {
+    bool joyallow4 = myOSystem.settings().getBool("joyallow4");
+    myOSystem.eventHandler().allowAllDirections(joyallow4);
+  }
 
   // Reset the system to its power-on state
   mySystem->reset();
@@ -434,6 +466,15 @@ void Console::togglePalette()
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Console::setPalette(const string& type)
+{
+  // Fall back to the standard palette if there is no user-defined one
+  const string& name = type == "user" && !myUserPaletteDefined ? "standard" : type;
+
+  myOSystem.frameBuffer().setPalette(palette(name, myConsoleTiming));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const uInt32* Console::palette(const string& palette, ConsoleTiming timing)
 {
   // Look at all the palettes, since we don't know which one is
   // currently active
@@ -445,20 +486,17 @@ void Console::setPalette(const string& type)
 
   // See which format we should be using
   int paletteNum = 0;
-  if(type == "standard")
+  if(palette == "standard")
     paletteNum = 0;
-  else if(type == "z26")
+  else if(palette == "z26")
     paletteNum = 1;
-  else if(type == "user" && myUserPaletteDefined)
+  else if(palette == "user")
     paletteNum = 2;
 
-  // Now consider the current display format
-  const uInt32* palette =
-    (myDisplayFormat.compare(0, 3, "PAL") == 0)   ? palettes[paletteNum][1] :
-    (myDisplayFormat.compare(0, 5, "SECAM") == 0) ? palettes[paletteNum][2] :
-     palettes[paletteNum][0];
-
-  myOSystem.frameBuffer().setPalette(palette);
+  // Now consider the colours used by the console
+  return timing == ConsoleTiming::pal   ? palettes[paletteNum][1] :
+         timing == ConsoleTiming::secam ? palettes[paletteNum][2] :
+                                          palettes[paletteNum][0];
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -946,6 +984,9 @@ void Console::generateColorLossPalette()
 void Console::setFramerate(float framerate)
 {
   myFramerate = framerate;
+  if(myHeadless)
+    return;
+
   myOSystem.setFramerate(framerate);
   myOSystem.sound().setFrameRate(framerate);
 }
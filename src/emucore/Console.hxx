@@ -27,6 +27,7 @@ class M6532;
 class Cartridge;
 class CompuMate;
 class Debugger;
+class Sound;
 
 #include "bspf.hxx"
 #include "Control.hxx"
@@ -74,12 +75,20 @@ class Console : public Serializable
       Create a new console for emulating the specified game using the
       given game image and operating system.
 
+      A headless console only emulates the game for its own purposes (for
+      example, to render a preview); it produces no sound, has joysticks
+      plugged into both ports, and leaves the framebuffer, sound and event
+      handler of the application alone.  It also skips autodetection of
+      the frame layout and ystart, using remembered or default values.
+
       @param osystem  The OSystem object to use
       @param cart     The cartridge to use with this console
       @param props    The properties for the cartridge
+      @param sound    If specified, the console is headless and uses this
+                      (normally a SoundNull) in place of the system sound
     */
     Console(OSystem& osystem, unique_ptr<Cartridge>& cart,
-            const Properties& props);
+            const Properties& props, Sound* sound = nullptr);
 
     /**
       Destructor
@@ -207,6 +216,17 @@ class Console : public Serializable
     */
     void setPalette(const string& palette);
 
+    /**
+      Get the palette with the given name ("standard", "z26" or "user")
+      for the given console timing.  The user-defined palette is only
+      valid once a console has successfully loaded it.
+
+      @param palette  The name of the palette
+      @param timing   The timing, which selects the NTSC/PAL/SECAM colours
+      @return  The RGB values of all 256 colours
+    */
+    static const uInt32* palette(const string& palette, ConsoleTiming timing);
+
     /**
       Toggles phosphor effect.
     */
@@ -415,6 +435,9 @@ class Console : public Serializable
     // Contains timing information for this console
     ConsoleTiming myConsoleTiming;
 
+    // Indicates whether this console is headless (see constructor)
+    bool myHeadless;
+
     // Table of RGB values for NTSC, PAL and SECAM
     static uInt32 ourNTSCPalette[256];
     static uInt32 ourPALPalette[256];
@@ -2084,7 +2084,6 @@ static const char* const DefProps[DEF_PROPS_SIZE][21] = {
   { "9f9ee0f60c119c831e80694b6678ca1a", "Jeffry Johnston", "", "Radial Pong - Version 8 (Jeffry Johnston) (PD)", "", "New Release", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "" },
   { "9fa0c664b157a0c27d10319dbbca812c", "Chris Walton, Justin Hairgrove, Tony Morse", "", "Hunchy II (2005)", "Homebrew", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "" },
   { "9fc2d1627dcdd8925f4c042e38eb0bc9", "Atari - GCC, John Allred, Mike Feinstein", "CX2688, CX2688P", "Jungle Hunt (1983) (Atari) (PAL)", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "" },
-  { "E68E28752D3C54EDD3CCDA42C27E320C", "Xonox - K-Tel Software, Anthony R. Henderson", "99007, 6240", "Tomarc the Barbarian (1983) (Xonox)", "Genesis controller (B is jump and throw, C switches between players)", "Hack of Tomarc the Barbarian", "", "", "", "", "", "", "GENESIS", "", "", "", "", "", "", "", "" },
   { "a0028f057d496f22b549fd8deecc6f78", "Joe Grand", "", "SCSIcide Pre-release 6 (Joe Grand)", "", "New Release", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "" },
   { "a00ec89d22fcc0c1a85bb542ddcb1178", "CCE", "C-1012", "Phoenix (1983) (CCE)", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "" },
   { "a00ee0aed5c8979add4c170f5322c706", "Barry Laws Jr.", "", "Egghead (Barry Laws Jr.) (Hack)", "Hack of Pac-Man", "Hack", "", "", "", "", "", "", "", "", "", "", "", "33", "", "", "" },
@@ -2991,6 +2990,7 @@ static const char* const DefProps[DEF_PROPS_SIZE][21] = {
   { "e64a8008812327853877a37befeb6465", "Answer Software Corporation - TY Associates", "ASC1002", "Gauntlet (1983) (Answer Software)", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "" },
   { "e6508b878145187b87b9cded097293e7", "", "", "Oystron (V2.8) (Piero Cavina) (PD)", "", "New Release", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "" },
   { "e66e5af5dea661d58420088368e4ef0d", "Activision, Bob Whitehead", "AG-011", "Stampede (1981) (Activision) (4K)", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "" },
+  { "E68E28752D3C54EDD3CCDA42C27E320C", "Xonox - K-Tel Software, Anthony R. Henderson", "99007, 6240", "Tomarc the Barbarian (1983) (Xonox)", "Genesis controller (B is jump and throw, C switches between players)", "Hack of Tomarc the Barbarian", "", "", "", "", "", "", "GENESIS", "", "", "", "", "", "", "", "" },
   { "e6d5948f451a24994dfaaca51dfdb4e1", "Jone Yuan Telephonic Enterprise Co", "", "Football (Jone Yuan) (4K)", "2600 Screen Search Console", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "" },
   { "e6de4ef9ab62e2196962aa6b0dedac59", "Imagic, Wilfredo Aguilar, Michael Becker, Dennis Koble", "720113-2A, 13206", "Solar Storm (1983) (Imagic) (PAL)", "Uses the Paddle Controllers", "", "", "", "", "", "", "", "PADDLES", "", "", "01 45", "", "", "", "", "" },
   { "e6e5bb0e4f4350da573023256268313d", "Thomas Jentzsch", "", "Missile Control (Thomas Jentzsch)", "NTSC Conversion", "Homebrew", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "" },
@@ -3346,4 +3346,3591 @@ static const char* const DefProps[DEF_PROPS_SIZE][21] = {
   { "ffebb0070689b9d322687edd9c0a2bae", "", "", "Spitfire Attack (1983) (Milton Bradley) [h1]", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "" }
 };
 
+/**
+  The md5sum of each entry above in binary form, and for each value
+  of the leading DEF_PROPS_INDEX_BITS bits, the first entry whose
+  md5sum starts with that value (so those entries are found at
+  DefPropsIndex[value] ... DefPropsIndex[value+1]-1).
+*/
+#define DEF_PROPS_INDEX_BITS 12
+
+static const uInt8 DefPropsMD5[DEF_PROPS_SIZE][16] = {
+  { 0x00, 0x05, 0x09, 0xd1, 0xed, 0x2b, 0x8d, 0x30, 0xa9, 0xd9, 0x4b, 0xe1, 0xb3, 0xb5, 0xfe, 0xbb },
+  { 0x00, 0x60, 0xa8, 0x9b, 0x4c, 0x95, 0x6b, 0x9c, 0x70, 0x3a, 0x59, 0xb1, 0x81, 0xcb, 0x30, 0x18 },
+  { 0x00, 0x7d, 0x18, 0xde, 0xdc, 0x1f, 0x05, 0x65, 0xf0, 0x9c, 0x42, 0xaa, 0x61, 0xa6, 0xf5, 0x85 },
+  { 0x00, 0x85, 0x43, 0xae, 0x43, 0x49, 0x7a, 0xf0, 0x15, 0xe9, 0x42, 0x8a, 0x5e, 0x3e, 0x87, 0x4e },
+  { 0x00, 0xb7, 0xb4, 0xcb, 0xec, 0x81, 0x57, 0x06, 0x42, 0x28, 0x3e, 0x7f, 0xc1, 0xef, 0x17, 0xaf },
+  { 0x00, 0xce, 0x0b, 0xdd, 0x43, 0xae, 0xd8, 0x4a, 0x98, 0x3b, 0xef, 0x38, 0xfe, 0x7f, 0x5e, 0xe3 },
+  { 0x00, 0xce, 0x76, 0xad, 0x69, 0xcd, 0xc2, 0xfa, 0x36, 0xad, 0xa0, 0x1a, 0xe0, 0x92, 0xd5, 0xa6 },
+  { 0x00, 0xdc, 0x28, 0xb8, 0x81, 0x98, 0x9c, 0x39, 0xa6, 0xcf, 0x87, 0xa8, 0x92, 0xbd, 0x3c, 0x6b },
+  { 0x00, 0xe1, 0x9e, 0xbf, 0x9d, 0x08, 0x17, 0xcc, 0xfb, 0x05, 0x7e, 0x26, 0x2b, 0xe1, 0xe5, 0xaf },
+  { 0x00, 0xe5, 0x5b, 0x27, 0xfe, 0x2e, 0x96, 0x35, 0x4c, 0xd2, 0x1b, 0x8b, 0x69, 0x8d, 0x1e, 0x31 },
+  { 0x00, 0xea, 0xee, 0x22, 0x03, 0x4a, 0xff, 0x60, 0x2f, 0x89, 0x9b, 0x68, 0x4c, 0x10, 0x7d, 0x77 },
+  { 0x00, 0xf7, 0x98, 0x5c, 0x20, 0xb8, 0xbd, 0xf3, 0xc5, 0x57, 0xfa, 0xc4, 0xd3, 0xf2, 0x67, 0x75 },
+  { 0x01, 0x20, 0x20, 0x62, 0x5a, 0x32, 0x27, 0x81, 0x5e, 0x47, 0xb3, 0x7f, 0xd0, 0x25, 0xe4, 0x80 },
+  { 0x01, 0x29, 0x3b, 0xd9, 0x0a, 0x45, 0x79, 0xab, 0xb7, 0xae, 0xd2, 0xf7, 0xd4, 0x40, 0x68, 0x1f },
+  { 0x01, 0x29, 0x7d, 0x9b, 0x45, 0x04, 0x55, 0xdd, 0x71, 0x6d, 0xb9, 0x65, 0x8e, 0xfb, 0x2f, 0xae },
+  { 0x01, 0x2b, 0x8e, 0x6e, 0xf3, 0xb5, 0xfd, 0x5a, 0xab, 0xc9, 0x40, 0x75, 0xc5, 0x27, 0x70, 0x9d },
+  { 0x01, 0x64, 0xf2, 0x6f, 0x6b, 0x38, 0xa3, 0x42, 0x08, 0xcd, 0x4a, 0x2d, 0x02, 0x12, 0xaf, 0xc3 },
+  { 0x01, 0x73, 0x67, 0x5d, 0x40, 0xa8, 0xd9, 0x75, 0x76, 0x3e, 0xe4, 0x93, 0x37, 0x7c, 0xa8, 0x7d },
+  { 0x01, 0xab, 0xcc, 0x1d, 0x2d, 0x3c, 0xba, 0x87, 0xa3, 0xaa, 0x0e, 0xb9, 0x7a, 0x9d, 0x7b, 0x9c },
+  { 0x01, 0xb0, 0x98, 0x72, 0xdc, 0xd9, 0x55, 0x64, 0x27, 0x76, 0x1f, 0x0e, 0xd6, 0x4a, 0xa4, 0x2a },
+  { 0x01, 0xcb, 0x3e, 0x8d, 0xfa, 0xb7, 0x20, 0x3a, 0x9c, 0x62, 0xba, 0x3b, 0x94, 0xb4, 0xe5, 0x9f },
+  { 0x01, 0xe5, 0xc8, 0x12, 0x58, 0x86, 0x0d, 0xd8, 0x2f, 0x77, 0x33, 0x9d, 0x58, 0xbc, 0x5f, 0x5c },
+  { 0x01, 0xe6, 0x0a, 0x10, 0x9a, 0x6a, 0x67, 0xc7, 0x0d, 0x3c, 0x05, 0x28, 0x38, 0x1d, 0x01, 0x87 },
+  { 0x01, 0xf5, 0x84, 0xbf, 0x67, 0xb0, 0xe4, 0x64, 0x01, 0x4a, 0x8c, 0x8b, 0x5e, 0xa4, 0x70, 0xe3 },
+  { 0x02, 0x06, 0x6b, 0x17, 0xf2, 0x90, 0x82, 0x41, 0x2c, 0x67, 0x54, 0xc1, 0xa2, 0xd6, 0x30, 0x2e },
+  { 0x02, 0x43, 0x65, 0x00, 0x7a, 0x87, 0xf2, 0x13, 0xcb, 0xe8, 0xef, 0x5f, 0x2e, 0x8e, 0x13, 0x33 },
+  { 0x02, 0x56, 0x68, 0xe3, 0x6a, 0x78, 0x8e, 0x8a, 0xf8, 0xac, 0x4f, 0x1b, 0xe7, 0xe7, 0x20, 0x43 },
+  { 0x02, 0x61, 0x80, 0xbf, 0x64, 0x1f, 0xf1, 0x7d, 0x85, 0x77, 0xc3, 0x3f, 0xac, 0xf0, 0xed, 0xea },
+  { 0x02, 0x77, 0xc4, 0x49, 0xfa, 0xe6, 0x3f, 0x6f, 0x1c, 0x8f, 0x94, 0xde, 0xdf, 0xcf, 0x00, 0x58 },
+  { 0x02, 0x7a, 0x59, 0xa5, 0x75, 0xb7, 0x88, 0x60, 0xae, 0xd7, 0x80, 0xb2, 0xae, 0x7d, 0x00, 0x1d },
+  { 0x02, 0x80, 0x24, 0xfb, 0x8e, 0x5e, 0x5f, 0x18, 0xea, 0x58, 0x66, 0x52, 0xf9, 0x79, 0x9c, 0x96 },
+  { 0x02, 0x81, 0x11, 0x51, 0x90, 0x6e, 0x47, 0x7d, 0x47, 0xc1, 0x35, 0xdb, 0x5b, 0x16, 0x99, 0xc6 },
+  { 0x02, 0xa5, 0xfc, 0x90, 0xa0, 0xd1, 0x83, 0xf8, 0x70, 0xe8, 0xee, 0xba, 0xc1, 0xf1, 0x65, 0x91 },
+  { 0x02, 0xab, 0x2c, 0x47, 0xbc, 0x21, 0xe7, 0xfe, 0xaf, 0xa0, 0x15, 0xf9, 0x0d, 0x7d, 0xf7, 0x76 },
+  { 0x02, 0xce, 0xd7, 0xea, 0x2b, 0x7c, 0xb5, 0x09, 0x74, 0x8d, 0xb6, 0xbf, 0xa2, 0x27, 0xeb, 0xec },
+  { 0x02, 0xce, 0xe0, 0xb1, 0x40, 0xd2, 0xf1, 0xa1, 0xef, 0xcf, 0xb1, 0xd4, 0x82, 0xa5, 0xc3, 0x92 },
+  { 0x02, 0xdc, 0xba, 0x28, 0xc6, 0x14, 0xfe, 0xc7, 0xca, 0x25, 0x95, 0x53, 0x27, 0x12, 0x8a, 0xbb },
+  { 0x02, 0xe3, 0xf4, 0xba, 0x15, 0x6f, 0xb5, 0x78, 0xbe, 0xf7, 0xd7, 0xa0, 0xbf, 0x34, 0x00, 0xc1 },
+  { 0x03, 0x3e, 0x21, 0x52, 0x1e, 0x0b, 0xf4, 0xe5, 0x4e, 0x88, 0x16, 0x87, 0x39, 0x43, 0x40, 0x6d },
+  { 0x03, 0x4c, 0x14, 0x34, 0x28, 0x0b, 0x0f, 0x2c, 0x9f, 0x22, 0x97, 0x77, 0xd7, 0x90, 0xd1, 0xe1 },
+  { 0x03, 0x75, 0xf5, 0x89, 0xf7, 0xda, 0x06, 0xd2, 0xd2, 0xbe, 0x53, 0x2e, 0x0d, 0x4d, 0x4b, 0x94 },
+  { 0x03, 0x83, 0xdc, 0x02, 0xcb, 0x82, 0x30, 0x2d, 0xa3, 0xd1, 0x55, 0xfd, 0x10, 0x8b, 0xfe, 0x3a },
+  { 0x03, 0x8e, 0x1e, 0x79, 0xc3, 0xd4, 0x41, 0x0d, 0xef, 0xde, 0x4b, 0xfe, 0x0b, 0x99, 0xcc, 0x32 },
+  { 0x03, 0x9c, 0xf1, 0x8b, 0x45, 0x9d, 0x33, 0xb8, 0xa8, 0xfc, 0xa3, 0x1d, 0x06, 0xc4, 0xc2, 0x44 },
+  { 0x03, 0xb1, 0x05, 0x1c, 0x93, 0x74, 0x67, 0x83, 0x63, 0xc8, 0x99, 0x91, 0x44, 0x12, 0xcf, 0xc5 },
+  { 0x03, 0xc3, 0xf7, 0xba, 0x45, 0x85, 0xe3, 0x49, 0xdd, 0x12, 0xbf, 0xa7, 0xb3, 0x4b, 0x77, 0x29 },
+  { 0x03, 0xff, 0x9e, 0x8a, 0x7a, 0xf4, 0x37, 0xf1, 0x64, 0x47, 0xfe, 0x88, 0xce, 0xa3, 0x22, 0x6c },
+  { 0x04, 0x01, 0x4d, 0x56, 0x3b, 0x09, 0x4e, 0x79, 0xac, 0x89, 0x74, 0x36, 0x6f, 0x61, 0x63, 0x08 },
+  { 0x04, 0x1b, 0x5e, 0x56, 0xbb, 0xc6, 0x50, 0xdb, 0x57, 0x4b, 0xd8, 0xdb, 0x3f, 0xae, 0x26, 0x96 },
+  { 0x04, 0x3f, 0x16, 0x5f, 0x38, 0x4f, 0xbe, 0xa3, 0xea, 0x89, 0x39, 0x35, 0x97, 0x95, 0x15, 0x12 },
+  { 0x04, 0x43, 0xcf, 0xa9, 0x87, 0x2c, 0xdb, 0x49, 0x06, 0x91, 0x86, 0x41, 0x32, 0x75, 0xfa, 0x21 },
+  { 0x04, 0x50, 0x35, 0xf9, 0x95, 0x27, 0x2e, 0xb2, 0xde, 0xb8, 0x82, 0x01, 0x11, 0x74, 0x5a, 0x07 },
+  { 0x04, 0x7a, 0xc3, 0xb9, 0xfa, 0xea, 0x64, 0x52, 0x2b, 0x7a, 0x23, 0xc4, 0x46, 0x5a, 0x7a, 0xa8 },
+  { 0x04, 0x85, 0x6e, 0x30, 0x06, 0xa4, 0xf5, 0xf7, 0xb4, 0x63, 0x8d, 0xa7, 0x1d, 0xad, 0x3d, 0x88 },
+  { 0x04, 0x96, 0x26, 0xcb, 0xfb, 0x1a, 0x5f, 0x7a, 0x5d, 0xc8, 0x85, 0xa0, 0xc4, 0xbb, 0x75, 0x8e },
+  { 0x04, 0xb4, 0x88, 0xd4, 0xee, 0xf6, 0x22, 0xd0, 0x22, 0xa0, 0x02, 0x13, 0x75, 0xe7, 0xe3, 0x39 },
+  { 0x04, 0xdf, 0xb4, 0xac, 0xac, 0x1d, 0x09, 0x09, 0xe4, 0xc3, 0x60, 0xfd, 0x2a, 0xc0, 0x44, 0x80 },
+  { 0x04, 0xe7, 0x37, 0xc9, 0xd5, 0x3c, 0xd8, 0x4b, 0xfd, 0x5e, 0xe6, 0x79, 0x95, 0x4e, 0x47, 0x06 },
+  { 0x04, 0xfc, 0xcc, 0x77, 0x35, 0x15, 0x5a, 0x6c, 0x13, 0x73, 0xd4, 0x53, 0xb1, 0x10, 0xc6, 0x40 },
+  { 0x05, 0x19, 0xf3, 0x95, 0xd5, 0xf7, 0xd7, 0x6b, 0xe8, 0x13, 0xb8, 0x34, 0xaa, 0x51, 0xc0, 0xbe },
+  { 0x05, 0x46, 0xf4, 0xe6, 0xb9, 0x46, 0xf3, 0x89, 0x56, 0x79, 0x9d, 0xd0, 0x0c, 0xaa, 0xb3, 0xb1 },
+  { 0x05, 0x6f, 0x5d, 0x88, 0x6a, 0x4e, 0x7e, 0x6f, 0xdd, 0x83, 0x65, 0x05, 0x54, 0x99, 0x7d, 0x0d },
+  { 0x05, 0x6f, 0xf6, 0x7d, 0xd9, 0x71, 0x5f, 0xaf, 0xa9, 0x1f, 0xb8, 0xb0, 0xdd, 0xcc, 0x4a, 0x46 },
+  { 0x05, 0x82, 0x4f, 0xcb, 0xe6, 0x15, 0xdb, 0xca, 0x83, 0x6d, 0x06, 0x1a, 0x14, 0x0a, 0x50, 0xe0 },
+  { 0x05, 0xae, 0xdf, 0x04, 0x80, 0x3c, 0x43, 0xeb, 0x5e, 0x09, 0xdf, 0xd0, 0x98, 0xd3, 0xfd, 0x01 },
+  { 0x05, 0xaf, 0xf8, 0xf6, 0x26, 0xef, 0x87, 0x04, 0x32, 0xae, 0x3b, 0x3d, 0x9d, 0x5a, 0xa3, 0x01 },
+  { 0x05, 0xb4, 0x5b, 0xa0, 0x9c, 0x05, 0xbe, 0xfa, 0x75, 0xac, 0x70, 0x47, 0x68, 0x29, 0xed, 0xa0 },
+  { 0x05, 0xc6, 0x04, 0x58, 0xec, 0x69, 0xe7, 0xfe, 0x8b, 0x1b, 0xe9, 0x73, 0x85, 0x2d, 0x84, 0xf1 },
+  { 0x05, 0xcc, 0xf9, 0x62, 0x47, 0xaf, 0x12, 0xee, 0xf5, 0x96, 0x98, 0xf1, 0xa0, 0x60, 0xa5, 0x4f },
+  { 0x05, 0xd6, 0x1b, 0x92, 0x5d, 0x3d, 0x24, 0x74, 0xba, 0xb8, 0x3f, 0x0a, 0x79, 0xbb, 0x5d, 0xf1 },
+  { 0x05, 0xeb, 0x43, 0x47, 0xf0, 0xec, 0x8f, 0x47, 0x83, 0x98, 0x3c, 0xa3, 0x5f, 0xfd, 0x8d, 0x1b },
+  { 0x05, 0xeb, 0xd1, 0x83, 0xea, 0x85, 0x4c, 0x0a, 0x1b, 0x56, 0xc2, 0x18, 0x24, 0x6f, 0xbb, 0xae },
+  { 0x05, 0xf1, 0x1f, 0xb2, 0xe4, 0x5c, 0x4e, 0x47, 0x42, 0x4d, 0x3c, 0xb2, 0x54, 0x14, 0xd2, 0x78 },
+  { 0x06, 0x0c, 0x86, 0x5c, 0x78, 0x2d, 0xeb, 0xb0, 0x47, 0xe6, 0xfd, 0x10, 0x1c, 0x89, 0x23, 0xfc },
+  { 0x06, 0x14, 0xed, 0x51, 0xac, 0xd0, 0x27, 0xd5, 0x31, 0xe7, 0xc8, 0x5c, 0x4f, 0x43, 0x52, 0x92 },
+  { 0x06, 0x51, 0x21, 0x6c, 0x4a, 0x4a, 0x9c, 0x9a, 0xc5, 0xad, 0xa3, 0x01, 0x3a, 0x31, 0x7c, 0x72 },
+  { 0x06, 0x74, 0x2c, 0xf5, 0x22, 0xf2, 0x37, 0x97, 0x15, 0x7f, 0x21, 0x5a, 0x1d, 0xc8, 0xa1, 0xa9 },
+  { 0x06, 0x85, 0xbd, 0x0b, 0xcb, 0x97, 0x5c, 0xee, 0xf7, 0x04, 0x17, 0x49, 0xa5, 0x45, 0x4a, 0x48 },
+  { 0x06, 0x95, 0x3e, 0xd7, 0x62, 0x22, 0x0d, 0xba, 0x63, 0xd6, 0x39, 0x30, 0xd4, 0xad, 0x0c, 0xc3 },
+  { 0x06, 0x9c, 0x17, 0xbe, 0xb1, 0xe8, 0xe0, 0x55, 0x7a, 0xdb, 0x85, 0x39, 0xfd, 0xcf, 0x6c, 0xba },
+  { 0x06, 0xb0, 0x19, 0x4c, 0xe9, 0x92, 0x58, 0x4c, 0x36, 0x52, 0x78, 0xe0, 0xd7, 0x32, 0x32, 0x79 },
+  { 0x06, 0xb6, 0xc5, 0x03, 0x1b, 0x83, 0x53, 0xf3, 0xa4, 0x24, 0xa5, 0xb8, 0x6b, 0x8f, 0xe4, 0x09 },
+  { 0x06, 0xcf, 0xd5, 0x7f, 0x05, 0x59, 0xf3, 0x8b, 0x92, 0x93, 0xad, 0xae, 0x91, 0x28, 0xff, 0x88 },
+  { 0x06, 0xdb, 0x90, 0x80, 0x11, 0x06, 0x5e, 0x5e, 0xbb, 0x37, 0xf4, 0xe2, 0x53, 0xc2, 0xa0, 0xb0 },
+  { 0x06, 0xe5, 0xdc, 0x18, 0x1a, 0x8e, 0xda, 0x1c, 0x31, 0xcc, 0x7c, 0x58, 0x1c, 0x68, 0xb6, 0xef },
+  { 0x07, 0x1f, 0x84, 0xd1, 0x0b, 0x34, 0x3c, 0x7c, 0x05, 0xce, 0x3e, 0x32, 0xaf, 0x63, 0x16, 0x87 },
+  { 0x07, 0x2a, 0x6e, 0xa2, 0x18, 0x1c, 0xa0, 0xdf, 0x88, 0xac, 0x0d, 0xed, 0xc6, 0x7b, 0x23, 0x9d },
+  { 0x07, 0x3c, 0xb7, 0x6b, 0x00, 0x6a, 0xf0, 0x34, 0xfd, 0x15, 0x0b, 0xe3, 0xf5, 0xe0, 0xe7, 0xe6 },
+  { 0x07, 0x3d, 0x7a, 0xff, 0x37, 0xb7, 0x60, 0x14, 0x31, 0xe4, 0xf7, 0x42, 0xc3, 0x6c, 0x0d, 0xc1 },
+  { 0x07, 0x4e, 0xc4, 0x25, 0xec, 0x20, 0x57, 0x9e, 0x64, 0xa7, 0xde, 0xd5, 0x92, 0x15, 0x5d, 0x48 },
+  { 0x07, 0x50, 0x69, 0xad, 0x80, 0xcd, 0xe1, 0x5e, 0xca, 0x69, 0xe3, 0xc9, 0x8b, 0xd6, 0x67, 0x14 },
+  { 0x07, 0x51, 0xf3, 0x42, 0xee, 0x4c, 0xf2, 0x8f, 0x2c, 0x9a, 0x6e, 0x84, 0x67, 0xc9, 0x01, 0xbe },
+  { 0x07, 0x97, 0x3b, 0xe3, 0xec, 0xfd, 0x55, 0x23, 0x5b, 0xf5, 0x9a, 0xa5, 0x6b, 0xde, 0xf2, 0x8c },
+  { 0x07, 0x9f, 0xe9, 0x10, 0x35, 0x15, 0xd1, 0x5b, 0xc1, 0x08, 0x57, 0x7e, 0x23, 0x4a, 0x48, 0x4d },
+  { 0x07, 0xa3, 0xaf, 0x1e, 0x18, 0xb6, 0x37, 0x65, 0xb6, 0x80, 0x78, 0x76, 0x36, 0x6f, 0x5e, 0x8a },
+  { 0x07, 0xc7, 0x6f, 0x2d, 0x88, 0x55, 0x2d, 0x20, 0xad, 0x2c, 0x0e, 0xd7, 0xae, 0xf4, 0x06, 0xc6 },
+  { 0x07, 0xf4, 0x28, 0x47, 0xa7, 0x9e, 0x4f, 0x5a, 0xe5, 0x5c, 0xc0, 0x33, 0x04, 0xb1, 0x8c, 0x25 },
+  { 0x07, 0xf8, 0x4d, 0xb3, 0x1e, 0x97, 0xef, 0x8d, 0x08, 0xdc, 0x9f, 0xa8, 0xa5, 0x25, 0x07, 0x55 },
+  { 0x07, 0xf9, 0x1e, 0x33, 0xe7, 0x6f, 0x53, 0xbb, 0x9d, 0x27, 0x31, 0xfd, 0x5d, 0x8a, 0x35, 0xa5 },
+  { 0x08, 0x05, 0x36, 0x6f, 0x1b, 0x16, 0x5a, 0x64, 0xb6, 0xd4, 0xdf, 0x20, 0xd2, 0xc3, 0x9d, 0x25 },
+  { 0x08, 0x18, 0x87, 0x85, 0xe2, 0xb8, 0x30, 0x09, 0x83, 0x52, 0x99, 0x46, 0xdb, 0xef, 0xf4, 0xd2 },
+  { 0x08, 0x1e, 0x2c, 0x11, 0x4c, 0x9c, 0x20, 0xb6, 0x1a, 0xcf, 0x25, 0xfc, 0x95, 0xc7, 0x1b, 0xf4 },
+  { 0x08, 0x2f, 0xdc, 0x8b, 0xd4, 0x7f, 0xef, 0x01, 0x48, 0x2c, 0xe5, 0x88, 0x3c, 0x4f, 0xfd, 0xb8 },
+  { 0x08, 0x32, 0xfb, 0x2e, 0xe6, 0x54, 0xbf, 0x93, 0x82, 0xbc, 0x57, 0xd2, 0xb1, 0x6d, 0x2f, 0xfc },
+  { 0x08, 0x3e, 0x7c, 0xae, 0x41, 0xa8, 0x74, 0xb2, 0xf9, 0xb6, 0x17, 0x36, 0xc3, 0x7d, 0x2f, 0xfe },
+  { 0x08, 0x53, 0x22, 0xba, 0xe4, 0x0d, 0x90, 0x4f, 0x53, 0xbd, 0xcc, 0x56, 0xdf, 0x05, 0x93, 0xfc },
+  { 0x08, 0x56, 0xf2, 0x02, 0xb1, 0x8c, 0xd4, 0x6e, 0x44, 0xfd, 0x1d, 0xc3, 0xb4, 0x2e, 0x9b, 0xfb },
+  { 0x08, 0x66, 0xe2, 0x2f, 0x6f, 0x56, 0xf9, 0x2e, 0xa1, 0xa1, 0x4c, 0x8d, 0x8d, 0x01, 0xd2, 0x9c },
+  { 0x08, 0x90, 0xa5, 0xb0, 0x89, 0x19, 0x1f, 0x45, 0xd0, 0xf0, 0x8d, 0xd1, 0xe3, 0x23, 0x56, 0x87 },
+  { 0x08, 0x94, 0xaa, 0x7b, 0xe7, 0x75, 0x21, 0xf9, 0xdf, 0x56, 0x2b, 0xe8, 0xd9, 0x55, 0x5f, 0xe6 },
+  { 0x08, 0x98, 0x9f, 0xa4, 0xff, 0x53, 0x7f, 0x5d, 0xbd, 0x61, 0x1a, 0xff, 0x40, 0x19, 0x52, 0x1a },
+  { 0x08, 0xbd, 0x4c, 0x1d, 0xcc, 0x84, 0x3f, 0x6a, 0x0b, 0x56, 0x3d, 0x9f, 0xd8, 0x0b, 0x3b, 0x11 },
+  { 0x08, 0xbf, 0x43, 0x7d, 0x01, 0x2d, 0xb0, 0x7b, 0x05, 0xff, 0x57, 0xa0, 0xc7, 0x45, 0xc4, 0x9e },
+  { 0x08, 0xd1, 0xb6, 0xd7, 0x52, 0x06, 0xed, 0xb9, 0x99, 0x25, 0x2c, 0xaf, 0x54, 0x2a, 0x2c, 0x7f },
+  { 0x08, 0xd6, 0x0a, 0x58, 0xa6, 0x91, 0xc7, 0xf6, 0x90, 0x16, 0x28, 0x50, 0x30, 0x2d, 0xc0, 0xe1 },
+  { 0x08, 0xe5, 0x96, 0x0b, 0xb5, 0x2d, 0x9a, 0x3e, 0x2c, 0x99, 0x54, 0x67, 0x7b, 0x5e, 0x44, 0x72 },
+  { 0x08, 0xf4, 0xdc, 0x6f, 0x11, 0x8f, 0x7c, 0x98, 0xe2, 0x40, 0x6c, 0x18, 0x0c, 0x08, 0xe7, 0x8e },
+  { 0x08, 0xf8, 0x53, 0xe8, 0xe0, 0x1e, 0x71, 0x19, 0x19, 0xe7, 0x34, 0xd8, 0x53, 0x49, 0x22, 0x0d },
+  { 0x09, 0x06, 0xc6, 0xe0, 0xe4, 0xbd, 0xa9, 0xc1, 0x0c, 0xfa, 0x4c, 0x5f, 0xc6, 0x4d, 0x2f, 0x4b },
+  { 0x09, 0x0f, 0x0a, 0x7e, 0xf8, 0xa3, 0xf8, 0x85, 0x04, 0x8d, 0x21, 0x3f, 0xaa, 0x59, 0xb2, 0xf8 },
+  { 0x09, 0x27, 0x4c, 0x3f, 0xc1, 0xc4, 0x3b, 0xf1, 0xe3, 0x62, 0xfd, 0xa4, 0x36, 0x65, 0x1f, 0xd8 },
+  { 0x09, 0x38, 0x8b, 0xf3, 0x90, 0xcd, 0x9a, 0x86, 0xdc, 0x08, 0x49, 0x69, 0x7b, 0x96, 0xc7, 0xdc },
+  { 0x09, 0x45, 0x08, 0x1a, 0x6b, 0xd0, 0x03, 0x45, 0xff, 0x3d, 0x58, 0xeb, 0x7a, 0x07, 0x33, 0x0a },
+  { 0x09, 0x56, 0x28, 0x5e, 0x24, 0xa1, 0x8e, 0xfa, 0x10, 0xc6, 0x8a, 0x33, 0x84, 0x6c, 0xa8, 0x4d },
+  { 0x09, 0x63, 0xaa, 0x9f, 0x7f, 0x6c, 0xf5, 0xa3, 0x6f, 0xf7, 0x00, 0x00, 0x15, 0x83, 0x62, 0x4e },
+  { 0x09, 0x66, 0x49, 0x57, 0x5e, 0x45, 0x15, 0x08, 0x00, 0x6b, 0x17, 0xe0, 0x35, 0x32, 0x59, 0xa5 },
+  { 0x09, 0x70, 0x74, 0xf2, 0x4c, 0xde, 0x14, 0x1f, 0xe6, 0xa0, 0xf2, 0x6a, 0x10, 0x33, 0x32, 0x65 },
+  { 0x09, 0x79, 0x36, 0xb0, 0x7e, 0x0e, 0x01, 0x17, 0xb9, 0x02, 0x6a, 0xe6, 0x83, 0x5e, 0xb1, 0x68 },
+  { 0x09, 0xab, 0xfe, 0x9a, 0x31, 0x2c, 0xe7, 0xc9, 0xf6, 0x61, 0x58, 0x2f, 0xdf, 0x12, 0xea, 0xb6 },
+  { 0x09, 0xd1, 0x92, 0x74, 0xc2, 0x07, 0x68, 0xf8, 0x42, 0xe8, 0xfa, 0xe8, 0x4b, 0x76, 0x6a, 0xbe },
+  { 0x09, 0xe1, 0xec, 0xf9, 0xbd, 0x2a, 0x30, 0x30, 0xd5, 0x67, 0x0d, 0xba, 0x7a, 0x65, 0xe7, 0x8d },
+  { 0x09, 0xf8, 0x9b, 0xbf, 0xa2, 0xab, 0x00, 0xf1, 0x96, 0x4d, 0x20, 0x0e, 0x12, 0xd7, 0xce, 0xd0 },
+  { 0x0a, 0x1b, 0x98, 0x93, 0x79, 0x11, 0xd6, 0x21, 0xb0, 0x04, 0xb1, 0x61, 0x74, 0x46, 0xd1, 0x24 },
+  { 0x0a, 0x98, 0x1c, 0x03, 0x20, 0x4a, 0xc2, 0xb2, 0x78, 0xba, 0x39, 0x26, 0x74, 0x68, 0x25, 0x60 },
+  { 0x0a, 0xa2, 0x08, 0x06, 0x0d, 0x7c, 0x14, 0x0f, 0x20, 0x57, 0x1e, 0x33, 0x41, 0xf5, 0xa3, 0xf8 },
+  { 0x0a, 0xbf, 0x64, 0xca, 0x50, 0x4a, 0x11, 0x6a, 0xdc, 0xa8, 0x0f, 0x77, 0xf8, 0x5e, 0x00, 0xfb },
+  { 0x0a, 0xc0, 0xd4, 0x91, 0x76, 0x31, 0x53, 0xfa, 0xc7, 0x5f, 0x53, 0x37, 0xce, 0x32, 0xa9, 0xd6 },
+  { 0x0a, 0xca, 0xf7, 0x1e, 0x60, 0xb8, 0x9f, 0x6b, 0x6e, 0xab, 0x63, 0xdb, 0x6a, 0xb8, 0x45, 0x10 },
+  { 0x0a, 0xce, 0xb7, 0xc3, 0xbd, 0x13, 0xfe, 0x04, 0x8b, 0x77, 0xa1, 0x92, 0x8e, 0xd4, 0x26, 0x7d },
+  { 0x0a, 0xd9, 0xa3, 0x58, 0xe3, 0x61, 0x25, 0x6b, 0x94, 0xf3, 0xfb, 0x4f, 0x2f, 0xa5, 0xa3, 0xb1 },
+  { 0x0a, 0xdb, 0x21, 0x20, 0x6d, 0xe9, 0x2e, 0x8a, 0xec, 0x5e, 0xf2, 0x95, 0x80, 0x5e, 0xbb, 0x90 },
+  { 0x0a, 0xe3, 0x49, 0x7e, 0x73, 0x1c, 0xa0, 0xbf, 0x6a, 0x77, 0xb2, 0x34, 0x41, 0xd9, 0xd9, 0xf9 },
+  { 0x0a, 0xf5, 0x1c, 0xeb, 0x4a, 0xec, 0xc7, 0xa8, 0xfc, 0x89, 0x78, 0x1a, 0xc4, 0x4a, 0x19, 0x73 },
+  { 0x0a, 0xfe, 0x6a, 0xe1, 0x89, 0x66, 0x79, 0x5b, 0x89, 0x31, 0x4c, 0x37, 0x97, 0xdd, 0x2b, 0x1e },
+  { 0x0b, 0x01, 0x90, 0x9b, 0xa8, 0x45, 0x12, 0xfd, 0xaf, 0x22, 0x4d, 0x3c, 0x3f, 0xd0, 0xcf, 0x8d },
+  { 0x0b, 0x10, 0x56, 0xf1, 0x09, 0x1c, 0xfd, 0xc5, 0xeb, 0x0e, 0x23, 0x01, 0xf4, 0x7a, 0xc6, 0xc3 },
+  { 0x0b, 0x17, 0xed, 0x42, 0x98, 0x40, 0x00, 0xda, 0x8b, 0x72, 0x7c, 0xa4, 0x61, 0x43, 0xf8, 0x7a },
+  { 0x0b, 0x24, 0x65, 0x87, 0x14, 0xf8, 0xdf, 0xf1, 0x10, 0xa6, 0x93, 0xa2, 0x05, 0x2c, 0xc2, 0x07 },
+  { 0x0b, 0x33, 0x25, 0x2b, 0x68, 0x0b, 0x65, 0x00, 0x1e, 0x91, 0xa4, 0x11, 0xe5, 0x6e, 0x72, 0xe9 },
+  { 0x0b, 0x4e, 0x79, 0x3c, 0x94, 0x25, 0x17, 0x54, 0x98, 0xf5, 0xa6, 0x5a, 0x3e, 0x96, 0x00, 0x86 },
+  { 0x0b, 0x55, 0x39, 0x9c, 0xf6, 0x40, 0xa2, 0xa0, 0x0b, 0xa7, 0x2d, 0xd1, 0x55, 0xa0, 0xc1, 0x40 },
+  { 0x0b, 0x57, 0x7e, 0x63, 0xb0, 0xc6, 0x4f, 0x97, 0x79, 0xf3, 0x15, 0xdc, 0xa8, 0x96, 0x75, 0x87 },
+  { 0x0b, 0x8d, 0x30, 0x02, 0xd8, 0xf7, 0x44, 0xa7, 0x53, 0xba, 0x43, 0x4a, 0x4d, 0x39, 0x24, 0x9a },
+  { 0x0b, 0xf1, 0x9e, 0x40, 0xd5, 0xcd, 0x8a, 0xa5, 0xaf, 0xb3, 0x3b, 0x16, 0x56, 0x93, 0x13, 0xe6 },
+  { 0x0b, 0xf1, 0xe3, 0x54, 0x30, 0x4f, 0x46, 0xc0, 0xca, 0xf8, 0xfc, 0x0f, 0x6f, 0x5e, 0x95, 0x25 },
+  { 0x0b, 0xfa, 0xbf, 0x1e, 0x98, 0xbd, 0xb1, 0x80, 0x64, 0x3f, 0x35, 0xf2, 0x16, 0x59, 0x95, 0xd0 },
+  { 0x0c, 0x03, 0x92, 0xdb, 0x94, 0xa2, 0x0e, 0x4d, 0x00, 0x6d, 0x88, 0x5a, 0xbb, 0xe6, 0x0d, 0x8e },
+  { 0x0c, 0x35, 0x80, 0x6f, 0xf0, 0x01, 0x9a, 0x27, 0x0a, 0x7a, 0xca, 0xe6, 0x8d, 0xe8, 0x9d, 0x28 },
+  { 0x0c, 0x48, 0xe8, 0x20, 0x30, 0x12, 0x51, 0xfb, 0xb6, 0xbc, 0xdc, 0x89, 0xbd, 0x35, 0x55, 0xd9 },
+  { 0x0c, 0x54, 0x81, 0x1c, 0xf3, 0xb1, 0xf1, 0x57, 0x3c, 0x91, 0x64, 0xd5, 0xf1, 0x9e, 0xca, 0x65 },
+  { 0x0c, 0x79, 0x26, 0xd6, 0x60, 0xf9, 0x03, 0xa2, 0xd6, 0x91, 0x0c, 0x25, 0x46, 0x60, 0xc3, 0x2c },
+  { 0x0c, 0x7b, 0xd9, 0x35, 0xd9, 0xa7, 0xf2, 0x52, 0x21, 0x55, 0xe4, 0x83, 0x15, 0xf4, 0x4f, 0xa0 },
+  { 0x0c, 0x80, 0x75, 0x1f, 0x6f, 0x7a, 0x3b, 0x37, 0x0c, 0xc9, 0xe9, 0xf3, 0x9a, 0xd5, 0x33, 0xa7 },
+  { 0x0c, 0xb7, 0xaf, 0x80, 0xfd, 0x0d, 0xde, 0xf8, 0x48, 0x44, 0x48, 0x1d, 0x85, 0xe5, 0xd2, 0x9b },
+  { 0x0c, 0xc8, 0x22, 0x4f, 0xf1, 0xed, 0xfe, 0x45, 0x8e, 0x86, 0x29, 0xe9, 0xe5, 0xfe, 0x3f, 0x5b },
+  { 0x0c, 0xdd, 0x9c, 0xc6, 0x92, 0xe8, 0xb0, 0x4b, 0xa8, 0xeb, 0x31, 0xfc, 0x31, 0xd7, 0x2e, 0x5e },
+  { 0x0c, 0xeb, 0xb0, 0xbb, 0x45, 0xa8, 0x56, 0xb2, 0x3f, 0x56, 0xd2, 0x1c, 0xe7, 0xd1, 0xbc, 0x34 },
+  { 0x0c, 0xfd, 0xd2, 0xf3, 0xb2, 0x43, 0xca, 0xc2, 0x1f, 0x38, 0xa0, 0xf0, 0x9f, 0x54, 0xbe, 0xad },
+  { 0x0d, 0x07, 0xd2, 0xc1, 0xbe, 0x1a, 0x5e, 0xaa, 0xea, 0x23, 0x5a, 0x53, 0x3b, 0xcd, 0xa7, 0x81 },
+  { 0x0d, 0x09, 0xcf, 0xf0, 0xd2, 0x80, 0x33, 0xc0, 0x2c, 0x32, 0x90, 0xed, 0xfc, 0x3a, 0x5c, 0xea },
+  { 0x0d, 0x1b, 0x3a, 0xbf, 0x68, 0x1a, 0x2f, 0xc9, 0xa6, 0xaa, 0x31, 0xa9, 0xb0, 0xe8, 0xb4, 0x45 },
+  { 0x0d, 0x27, 0xc7, 0xf5, 0xdb, 0x34, 0x9b, 0x59, 0x2f, 0x70, 0xf6, 0x8d, 0xaf, 0x5e, 0x8f, 0x3b },
+  { 0x0d, 0x35, 0x61, 0x8b, 0x6d, 0x76, 0xdd, 0xd4, 0x6d, 0x26, 0x26, 0xe9, 0xe3, 0xe4, 0x0d, 0xb5 },
+  { 0x0d, 0x5a, 0xf6, 0x5a, 0xd3, 0xf1, 0x95, 0x58, 0xe6, 0xf8, 0xe2, 0x9b, 0xf2, 0xa9, 0xd0, 0xf8 },
+  { 0x0d, 0x6b, 0x97, 0x4f, 0xe5, 0x8a, 0x1b, 0xdd, 0x45, 0x36, 0x00, 0x40, 0x1c, 0x40, 0x78, 0x56 },
+  { 0x0d, 0x78, 0x6a, 0x41, 0x69, 0x5e, 0x5f, 0xc8, 0xcf, 0xfd, 0x05, 0xa6, 0xdb, 0xb3, 0xf6, 0x59 },
+  { 0x0d, 0x7e, 0x63, 0x0a, 0x14, 0x85, 0x6f, 0x4d, 0x52, 0xc9, 0x66, 0x60, 0x40, 0x96, 0x1d, 0x4d },
+  { 0x0d, 0x90, 0xa0, 0xee, 0x73, 0xd5, 0x55, 0x39, 0xb7, 0xde, 0xf2, 0x4c, 0x88, 0xca, 0xa6, 0x51 },
+  { 0x0d, 0xb4, 0xf4, 0x15, 0x0f, 0xec, 0xf7, 0x7e, 0x4c, 0xe7, 0x2c, 0xa4, 0xd0, 0x4c, 0x05, 0x2f },
+  { 0x0d, 0xd4, 0xc6, 0x9b, 0x5f, 0x9a, 0x7a, 0xe9, 0x6a, 0x7a, 0x08, 0x32, 0x94, 0x96, 0x77, 0x9a },
+  { 0x0d, 0xe5, 0x31, 0x60, 0xa8, 0xb5, 0x4c, 0x3a, 0xa5, 0xae, 0xd8, 0xd6, 0x8c, 0x97, 0x0b, 0x62 },
+  { 0x0d, 0xfb, 0xda, 0xdf, 0x8f, 0x1b, 0xc7, 0x18, 0xe7, 0xe1, 0xbb, 0x3c, 0xcd, 0x5f, 0xef, 0x3d },
+  { 0x0e, 0x08, 0x08, 0x22, 0x7e, 0xf4, 0x1f, 0x68, 0x25, 0xc0, 0x6f, 0x25, 0x08, 0x2c, 0x2e, 0x56 },
+  { 0x0e, 0x08, 0xcd, 0x2c, 0x5b, 0xcf, 0x11, 0xc6, 0xa7, 0xe5, 0xa0, 0x09, 0xa7, 0x71, 0x5b, 0x6a },
+  { 0x0e, 0x22, 0x4e, 0xa7, 0x43, 0x10, 0xda, 0x4e, 0x7e, 0x21, 0x03, 0x40, 0x0e, 0xb1, 0xb4, 0xbf },
+  { 0x0e, 0x4b, 0x2b, 0x6e, 0x01, 0x4a, 0x93, 0xef, 0x8b, 0xe8, 0x96, 0x82, 0x3d, 0xa0, 0xd4, 0xec },
+  { 0x0e, 0x71, 0x3d, 0x4e, 0x27, 0x2e, 0xa7, 0x32, 0x2c, 0x5b, 0x27, 0xd6, 0x45, 0xf5, 0x6d, 0xd0 },
+  { 0x0e, 0x7e, 0x73, 0x42, 0x16, 0x06, 0x87, 0x3b, 0x54, 0x4e, 0x85, 0x8c, 0x59, 0xdc, 0x28, 0x3e },
+  { 0x0e, 0x86, 0x47, 0x07, 0x91, 0xb2, 0x62, 0x92, 0xab, 0xe1, 0xc6, 0x45, 0x45, 0xc4, 0x79, 0x85 },
+  { 0x0e, 0xc9, 0x3f, 0x51, 0x9b, 0xb7, 0x69, 0xe0, 0xd9, 0xf8, 0x0e, 0x61, 0xf6, 0xcc, 0x80, 0x23 },
+  { 0x0e, 0xeb, 0xfb, 0x60, 0xd4, 0x37, 0x79, 0x6d, 0x53, 0x60, 0x39, 0x70, 0x1e, 0xc4, 0x38, 0x45 },
+  { 0x0e, 0xec, 0xb5, 0xf5, 0x8f, 0x55, 0xde, 0x9d, 0xb4, 0xee, 0xdb, 0x3a, 0x0f, 0x6b, 0x74, 0xa8 },
+  { 0x0e, 0xf6, 0x4c, 0xdb, 0xec, 0xcc, 0xb7, 0x04, 0x97, 0x52, 0xa3, 0xde, 0x0b, 0x7a, 0xde, 0x14 },
+  { 0x0f, 0x14, 0xc0, 0x30, 0x50, 0xb3, 0x5d, 0x6b, 0x1d, 0x88, 0x50, 0xb0, 0x75, 0x78, 0x72, 0x2d },
+  { 0x0f, 0x24, 0xca, 0x56, 0x68, 0xb4, 0xab, 0x5d, 0xfa, 0xf2, 0x17, 0x93, 0x3c, 0x50, 0x59, 0x26 },
+  { 0x0f, 0x2e, 0x09, 0xc7, 0x1c, 0xc2, 0x16, 0xf7, 0x9d, 0x22, 0xa8, 0x04, 0x15, 0x2b, 0xa2, 0x4b },
+  { 0x0f, 0x34, 0x1d, 0x1f, 0x4e, 0x14, 0x4e, 0x31, 0x63, 0xd9, 0xa5, 0xfc, 0x5a, 0x66, 0x2b, 0x79 },
+  { 0x0f, 0x39, 0xfc, 0x03, 0xd5, 0x79, 0xd0, 0xd9, 0x3a, 0x6b, 0x72, 0x9a, 0x37, 0x46, 0x84, 0x3e },
+  { 0x0f, 0x64, 0x3c, 0x34, 0xe4, 0x0e, 0x3f, 0x1d, 0xaa, 0xfd, 0x9c, 0x52, 0x4d, 0x3f, 0xfe, 0x64 },
+  { 0x0f, 0x66, 0x76, 0xb0, 0x56, 0x21, 0xf8, 0x0c, 0x67, 0x09, 0x66, 0xe2, 0x99, 0x5b, 0x22, 0x7a },
+  { 0x0f, 0x73, 0x8d, 0xc4, 0x44, 0x37, 0x55, 0x76, 0x24, 0xeb, 0x27, 0x7e, 0xd7, 0xad, 0x91, 0xc9 },
+  { 0x0f, 0x80, 0x43, 0x71, 0x5d, 0x66, 0xa4, 0xbb, 0xed, 0x39, 0x4e, 0xf8, 0x01, 0xd9, 0x98, 0x62 },
+  { 0x0f, 0x95, 0x26, 0x40, 0x89, 0xc9, 0x9f, 0xc2, 0xa8, 0x39, 0xa1, 0x98, 0x72, 0x55, 0x20, 0x04 },
+  { 0x0f, 0xba, 0x7d, 0x8c, 0x35, 0x20, 0xbd, 0xb6, 0x81, 0xf7, 0x54, 0x94, 0xe4, 0x98, 0xec, 0x36 },
+  { 0x0f, 0xbf, 0x61, 0x8b, 0xe4, 0x3d, 0x43, 0x96, 0x85, 0x6d, 0x42, 0x44, 0x12, 0x6f, 0xe7, 0xdc },
+  { 0x0f, 0xc1, 0x61, 0x70, 0x4c, 0x46, 0xe1, 0x6f, 0x74, 0x83, 0xf9, 0x2b, 0x06, 0xc1, 0x55, 0x8d },
+  { 0x0f, 0xcf, 0xf6, 0xfe, 0x3b, 0x07, 0x69, 0xad, 0x5d, 0x0c, 0xf8, 0x28, 0x14, 0xd2, 0xa6, 0xd9 },
+  { 0x0f, 0xd7, 0x2a, 0x13, 0xb3, 0xb6, 0x10, 0x3f, 0xc8, 0x25, 0xa6, 0x92, 0xc7, 0x19, 0x63, 0xb4 },
+  { 0x10, 0x1a, 0xb6, 0x0f, 0x40, 0x00, 0xa5, 0xd1, 0x37, 0x92, 0xef, 0x0a, 0xba, 0xd5, 0xf7, 0x4b },
+  { 0x10, 0x26, 0x72, 0xbb, 0xd7, 0xe2, 0x5c, 0xd7, 0x9f, 0x43, 0x84, 0xdd, 0x72, 0x14, 0xc3, 0x2b },
+  { 0x10, 0x3d, 0x4c, 0x89, 0x0c, 0x21, 0x08, 0xcb, 0x53, 0x63, 0x72, 0xc9, 0x8d, 0x09, 0x3e, 0x5f },
+  { 0x10, 0x3e, 0x9d, 0x61, 0x63, 0x28, 0x96, 0x9f, 0x5d, 0x7b, 0x4e, 0x0a, 0x38, 0x1b, 0x25, 0xd5 },
+  { 0x10, 0x3f, 0x17, 0x56, 0xd9, 0xdc, 0x0d, 0xd2, 0xb1, 0x6b, 0x53, 0xad, 0x0f, 0x0f, 0x18, 0x59 },
+  { 0x10, 0x44, 0x68, 0xe4, 0x48, 0x98, 0xb8, 0xe9, 0xfa, 0x4a, 0x15, 0x00, 0xfd, 0xe8, 0xd4, 0xcb },
+  { 0x10, 0x63, 0x26, 0xc2, 0x62, 0xdf, 0xd3, 0xe8, 0xea, 0xea, 0xbd, 0x96, 0x1d, 0x2a, 0x05, 0x19 },
+  { 0x10, 0x68, 0x55, 0x47, 0x4c, 0x69, 0xd0, 0x8c, 0x8f, 0xfa, 0x30, 0x8d, 0x47, 0x33, 0x72, 0x69 },
+  { 0x10, 0x7c, 0xc0, 0x25, 0x33, 0x42, 0x11, 0xe6, 0xd2, 0x9d, 0xa0, 0xb6, 0xbe, 0x46, 0xae, 0xc7 },
+  { 0x10, 0x86, 0xff, 0x69, 0xf8, 0x2b, 0x68, 0xd6, 0x77, 0x66, 0x34, 0xf3, 0x36, 0xfb, 0x48, 0x57 },
+  { 0x10, 0x95, 0x8c, 0xd0, 0xa1, 0xa8, 0x1d, 0x59, 0x90, 0x05, 0xf1, 0x79, 0x7a, 0xb0, 0xe5, 0x1d },
+  { 0x10, 0xa3, 0xcd, 0x14, 0xe5, 0xdc, 0xfd, 0xde, 0x6f, 0xf2, 0x16, 0xa1, 0x4c, 0xe7, 0xb7, 0xdd },
+  { 0x10, 0xaf, 0x87, 0x28, 0xf9, 0x75, 0xaa, 0x35, 0xa9, 0x9d, 0x09, 0x65, 0xde, 0x8f, 0x71, 0x4c },
+  { 0x10, 0xc8, 0xcf, 0xd8, 0xc3, 0x75, 0x22, 0xf1, 0x1d, 0x47, 0x54, 0x0f, 0xf0, 0x24, 0xe5, 0xf9 },
+  { 0x10, 0xea, 0xe7, 0x3a, 0x07, 0xb3, 0xda, 0x04, 0x4b, 0x72, 0x47, 0x3d, 0x8d, 0x36, 0x62, 0x67 },
+  { 0x10, 0xf0, 0xec, 0xaf, 0x96, 0x2a, 0xef, 0x1f, 0xc2, 0x8a, 0xbe, 0xd8, 0x70, 0xb0, 0x1b, 0x65 },
+  { 0x10, 0xf6, 0x24, 0x43, 0xf1, 0xae, 0x08, 0x7d, 0xc5, 0x88, 0xa7, 0x7f, 0x9e, 0x8f, 0x43, 0xe9 },
+  { 0x11, 0x0a, 0xc8, 0xec, 0xaf, 0x1b, 0x69, 0xf4, 0x1b, 0xc9, 0x4c, 0x59, 0xdf, 0xcb, 0x8b, 0x2d },
+  { 0x11, 0x10, 0x29, 0x77, 0x02, 0x26, 0xb3, 0x19, 0x52, 0x41, 0x34, 0x19, 0x38, 0x86, 0xa1, 0x0e },
+  { 0x11, 0x33, 0x0e, 0xaa, 0x5d, 0xd2, 0x62, 0x90, 0x52, 0xfa, 0xc3, 0x7c, 0xfe, 0x1a, 0x0b, 0x7d },
+  { 0x11, 0x3c, 0xd0, 0x9c, 0x97, 0x71, 0xac, 0x27, 0x85, 0x44, 0xb7, 0xe9, 0x0e, 0xfe, 0x7d, 0xf2 },
+  { 0x11, 0x4c, 0x59, 0x94, 0x54, 0xd3, 0x2f, 0x74, 0xc7, 0x28, 0xa6, 0xe1, 0xf7, 0x10, 0x12, 0xba },
+  { 0x11, 0xbc, 0xf5, 0xc7, 0x52, 0x08, 0x8b, 0x5a, 0xaf, 0x86, 0xd6, 0xc7, 0xa6, 0xa1, 0x1e, 0x8d },
+  { 0x11, 0xcf, 0x75, 0x1b, 0xc8, 0x17, 0x3d, 0xb1, 0x05, 0xea, 0xbd, 0x11, 0x9c, 0x58, 0x44, 0xba },
+  { 0x11, 0xe7, 0xe0, 0xd9, 0x43, 0x7e, 0xc9, 0x8f, 0xa0, 0x85, 0x28, 0x4c, 0xf1, 0x6d, 0x0e, 0xb4 },
+  { 0x11, 0xf9, 0x53, 0x25, 0x57, 0xe4, 0xc9, 0x56, 0x9f, 0x4b, 0x24, 0x21, 0x64, 0x00, 0x61, 0x61 },
+  { 0x12, 0x01, 0xc1, 0x8c, 0xf0, 0x0d, 0x2c, 0x23, 0x6f, 0x42, 0xe4, 0xd7, 0xd8, 0xc8, 0x6a, 0xa1 },
+  { 0x12, 0x12, 0x3b, 0x53, 0x4b, 0xde, 0xe7, 0x9e, 0xd7, 0x56, 0x3b, 0x9a, 0xd7, 0x4f, 0x1c, 0xbd },
+  { 0x12, 0x28, 0xc0, 0x1c, 0xd3, 0xc4, 0xb9, 0xc4, 0x77, 0x54, 0x0c, 0x5a, 0xdb, 0x30, 0x6d, 0x2a },
+  { 0x12, 0x66, 0xb3, 0xfd, 0x63, 0x2c, 0x98, 0x1f, 0x3e, 0xf9, 0xbd, 0xbf, 0x9f, 0x86, 0xce, 0x9a },
+  { 0x12, 0x67, 0xe3, 0xc6, 0xca, 0x95, 0x1f, 0xf1, 0xdf, 0x6f, 0x22, 0x2c, 0x8f, 0x81, 0x3d, 0x97 },
+  { 0x12, 0x78, 0xf7, 0x4c, 0xa1, 0xdf, 0xaa, 0x91, 0x22, 0xdf, 0x3e, 0xca, 0x3c, 0x5b, 0xca, 0xad },
+  { 0x12, 0x87, 0x53, 0x52, 0x56, 0xbf, 0x5d, 0xff, 0x40, 0x48, 0x39, 0xac, 0x9e, 0x25, 0xc3, 0xe7 },
+  { 0x12, 0x93, 0x7d, 0xb3, 0xd4, 0xa8, 0x0d, 0xa5, 0xc4, 0x45, 0x2b, 0x75, 0x28, 0x91, 0x25, 0x2d },
+  { 0x12, 0xbc, 0xa8, 0x30, 0x5d, 0x5a, 0xb8, 0xea, 0x51, 0xfe, 0x1c, 0xfd, 0x95, 0xd7, 0xab, 0x0e },
+  { 0x12, 0xd7, 0xe0, 0xd6, 0xb1, 0x87, 0x88, 0x9f, 0x8d, 0x15, 0x0b, 0xf7, 0x03, 0x4d, 0x1d, 0xb2 },
+  { 0x13, 0x0c, 0x57, 0x42, 0xcd, 0x6c, 0xbe, 0x48, 0x77, 0x70, 0x4d, 0x73, 0x3d, 0x5b, 0x08, 0xca },
+  { 0x13, 0x23, 0xc4, 0x5d, 0x66, 0x0f, 0x5a, 0x5b, 0x6d, 0x5e, 0xa4, 0x5c, 0x6c, 0x4c, 0xbe, 0x4a },
+  { 0x13, 0x34, 0x56, 0x26, 0x9a, 0x03, 0xe3, 0xfd, 0xae, 0x6c, 0xdd, 0xd6, 0x57, 0x54, 0xc5, 0x0d },
+  { 0x13, 0x3a, 0x42, 0x34, 0x51, 0x2e, 0x8c, 0x4e, 0x9e, 0x8c, 0x56, 0x51, 0x46, 0x9d, 0x4a, 0x09 },
+  { 0x13, 0x3b, 0x56, 0xde, 0x01, 0x1d, 0x56, 0x2c, 0xba, 0xb6, 0x65, 0x96, 0x8b, 0xde, 0x35, 0x2b },
+  { 0x13, 0x43, 0xde, 0x49, 0xc2, 0xa5, 0x0d, 0x99, 0x17, 0x62, 0x55, 0xf9, 0x9f, 0x0d, 0x02, 0x34 },
+  { 0x13, 0x44, 0x8e, 0xb5, 0xba, 0x57, 0x5e, 0x8d, 0x7b, 0x8d, 0x5b, 0x28, 0x0e, 0xa6, 0x78, 0x8f },
+  { 0x13, 0x45, 0xe9, 0x72, 0xdb, 0xe0, 0x8e, 0xa3, 0xe7, 0x08, 0x50, 0x90, 0x2e, 0x20, 0xe1, 0xa5 },
+  { 0x13, 0x51, 0xc6, 0x7b, 0x42, 0x77, 0x0c, 0x1b, 0xd7, 0x58, 0xc3, 0xe4, 0x2f, 0x55, 0x3f, 0xea },
+  { 0x13, 0x57, 0x08, 0xb9, 0xa7, 0xdd, 0x20, 0x57, 0x6c, 0x1b, 0x66, 0xab, 0x2a, 0x41, 0x86, 0x0d },
+  { 0x13, 0x58, 0x44, 0x11, 0xda, 0x0a, 0x8d, 0x43, 0x19, 0x91, 0x03, 0x54, 0x23, 0xfd, 0xc0, 0xdc },
+  { 0x13, 0x67, 0xe4, 0x18, 0x58, 0xbe, 0x52, 0x57, 0x10, 0xeb, 0x04, 0xd0, 0xda, 0xb5, 0x35, 0x05 },
+  { 0x13, 0x6f, 0x75, 0xc4, 0xdd, 0x02, 0xc2, 0x92, 0x83, 0x75, 0x2b, 0x7e, 0x57, 0x99, 0xf9, 0x78 },
+  { 0x13, 0x89, 0x5e, 0xf1, 0x56, 0x10, 0xaf, 0x0d, 0x0f, 0x89, 0xd5, 0x88, 0xf3, 0x76, 0xb3, 0xfe },
+  { 0x13, 0xa3, 0x7c, 0xf8, 0x17, 0x0a, 0x3a, 0x34, 0xce, 0x31, 0x1b, 0x89, 0xbd, 0xe8, 0x20, 0x32 },
+  { 0x13, 0xa9, 0x91, 0xbc, 0x9c, 0x2f, 0xf0, 0x37, 0x53, 0xae, 0xb3, 0x22, 0xd3, 0xe3, 0xe2, 0xe5 },
+  { 0x13, 0xaa, 0x1f, 0x9a, 0xc4, 0x24, 0x99, 0x47, 0xe4, 0xaf, 0x61, 0x31, 0x9d, 0x9a, 0x08, 0xf2 },
+  { 0x13, 0xab, 0xc3, 0x2f, 0x80, 0x31, 0x65, 0xc4, 0x58, 0xbb, 0x08, 0x6f, 0xa5, 0x71, 0x95, 0xfb },
+  { 0x13, 0xcc, 0xc6, 0x92, 0xf1, 0x11, 0xd5, 0x2f, 0xec, 0x75, 0xd8, 0x3d, 0xf1, 0x61, 0x92, 0xe2 },
+  { 0x13, 0xd8, 0x32, 0x6b, 0xf5, 0x64, 0x8d, 0xb4, 0xda, 0xfc, 0xe4, 0x5d, 0x25, 0xe6, 0x2d, 0xdd },
+  { 0x13, 0xdf, 0xb0, 0x95, 0xe5, 0x19, 0xa5, 0x55, 0xa5, 0xb6, 0x0b, 0x7d, 0x9d, 0x71, 0x69, 0xf9 },
+  { 0x14, 0x09, 0x09, 0xd2, 0x04, 0xab, 0xd6, 0x84, 0x1c, 0x64, 0xcd, 0xad, 0x4d, 0x77, 0x65, 0xb4 },
+  { 0x14, 0x16, 0x3e, 0xb2, 0xa3, 0xdd, 0xd3, 0x55, 0x76, 0xbd, 0x85, 0x27, 0xea, 0xe3, 0xb4, 0x5e },
+  { 0x14, 0x23, 0xf5, 0x60, 0x06, 0x2c, 0x4f, 0x3c, 0x66, 0x9d, 0x55, 0x89, 0x1a, 0x2b, 0xcb, 0xe7 },
+  { 0x14, 0x28, 0x02, 0x9e, 0x76, 0x27, 0x97, 0x06, 0x9a, 0xd7, 0x95, 0xce, 0x7c, 0x6a, 0x1a, 0x93 },
+  { 0x14, 0x39, 0x18, 0x36, 0x8f, 0x4f, 0x4d, 0xff, 0xf9, 0x09, 0x99, 0x18, 0x8c, 0x01, 0x97, 0xc9 },
+  { 0x14, 0x42, 0xd1, 0xb3, 0x5a, 0x64, 0x78, 0xfb, 0xa2, 0x2a, 0xe7, 0xdd, 0x1f, 0xcb, 0x56, 0x34 },
+  { 0x14, 0x84, 0x71, 0x14, 0x4c, 0xce, 0xbd, 0x7f, 0x6a, 0xa9, 0xaa, 0x92, 0x15, 0x89, 0x65, 0x33 },
+  { 0x14, 0x9b, 0x54, 0x3c, 0x91, 0x7c, 0x18, 0x0a, 0x1b, 0x02, 0xd3, 0x3c, 0x12, 0x41, 0x52, 0x06 },
+  { 0x14, 0xa5, 0x6b, 0x49, 0x3a, 0x8d, 0x9d, 0x10, 0xe9, 0x4a, 0x3e, 0x10, 0x03, 0x62, 0xe3, 0xa2 },
+  { 0x14, 0xb1, 0xe3, 0x09, 0x82, 0x96, 0x2c, 0x72, 0xf4, 0x26, 0xe2, 0xe7, 0x63, 0xeb, 0x42, 0x74 },
+  { 0x14, 0xc2, 0x54, 0x87, 0x12, 0x09, 0x9c, 0x22, 0x09, 0x64, 0xd7, 0xf0, 0x44, 0xc5, 0x9f, 0xd9 },
+  { 0x14, 0xd3, 0x65, 0xbb, 0xfa, 0xac, 0x3d, 0x20, 0xc6, 0x11, 0x95, 0x91, 0xf5, 0x7a, 0xcc, 0xa4 },
+  { 0x14, 0xdb, 0xb3, 0x68, 0x6d, 0xd3, 0x19, 0x64, 0x33, 0x2d, 0xc2, 0xef, 0x0c, 0x55, 0xca, 0xd0 },
+  { 0x15, 0x1c, 0x33, 0xa7, 0x1b, 0x99, 0xe6, 0xbc, 0xff, 0xb3, 0x4b, 0x43, 0xc6, 0xf0, 0xec, 0x23 },
+  { 0x15, 0x1f, 0xa3, 0x21, 0x8d, 0x8d, 0x76, 0x00, 0x11, 0x4e, 0xb5, 0xbc, 0xd7, 0x9c, 0x85, 0xcb },
+  { 0x15, 0x2c, 0x25, 0x34, 0x78, 0xb0, 0x09, 0xc2, 0x75, 0xe1, 0x8c, 0xd7, 0x31, 0xb4, 0x85, 0x61 },
+  { 0x15, 0x3f, 0x40, 0xe3, 0x35, 0xe5, 0xcb, 0x90, 0xf5, 0xce, 0x02, 0xe5, 0x49, 0x34, 0xab, 0x62 },
+  { 0x15, 0x42, 0x66, 0x2f, 0x66, 0x5d, 0x2f, 0xfa, 0xa7, 0x7b, 0x4b, 0x89, 0x7d, 0xd2, 0xe2, 0xaf },
+  { 0x15, 0x5f, 0xa7, 0xf4, 0x79, 0xdc, 0xba, 0x3b, 0x10, 0xb1, 0x49, 0x4e, 0x23, 0x6d, 0x60, 0x10 },
+  { 0x15, 0x73, 0x56, 0xf8, 0x0c, 0x70, 0x9a, 0xb6, 0x75, 0x96, 0x1d, 0x8b, 0x8b, 0x20, 0x7e, 0x20 },
+  { 0x15, 0x7b, 0xdd, 0xb7, 0x19, 0x27, 0x54, 0xa4, 0x53, 0x72, 0xbe, 0x19, 0x67, 0x97, 0xf2, 0x84 },
+  { 0x15, 0x9e, 0x5c, 0xd6, 0xcc, 0xb9, 0x68, 0x01, 0x5f, 0x49, 0xae, 0xd5, 0xad, 0xbc, 0x91, 0xeb },
+  { 0x15, 0xb4, 0x98, 0x19, 0x9e, 0xd0, 0xed, 0x28, 0x05, 0x7b, 0xf0, 0xdb, 0xdc, 0xe9, 0xb8, 0xd8 },
+  { 0x15, 0xbc, 0xd7, 0x4f, 0x2f, 0x1f, 0x2a, 0x63, 0xe1, 0xaa, 0x93, 0xe9, 0x0d, 0x2c, 0x05, 0x55 },
+  { 0x15, 0xbf, 0x2e, 0xf7, 0x58, 0x3b, 0xfc, 0xbb, 0xba, 0x63, 0x08, 0x47, 0xa1, 0xdc, 0x55, 0x39 },
+  { 0x15, 0xc1, 0x1a, 0xb6, 0xe4, 0x50, 0x2b, 0x20, 0x10, 0xb1, 0x83, 0x66, 0x13, 0x3f, 0xc3, 0x22 },
+  { 0x15, 0xdd, 0x21, 0xc2, 0x60, 0x8e, 0x0d, 0x7d, 0x9f, 0x54, 0xc0, 0xd3, 0xf0, 0x8c, 0xca, 0x1f },
+  { 0x15, 0xfe, 0x28, 0xd0, 0xc8, 0x89, 0x3b, 0xe9, 0x22, 0x3e, 0x8c, 0xb2, 0xd0, 0x32, 0xe5, 0x57 },
+  { 0x16, 0x19, 0xbc, 0x27, 0x63, 0x2f, 0x91, 0x48, 0xd8, 0x48, 0x0c, 0xd8, 0x13, 0xaa, 0x74, 0xc3 },
+  { 0x16, 0x1d, 0xed, 0x4a, 0x85, 0xd3, 0xc7, 0x8e, 0x44, 0xff, 0xfd, 0x40, 0x42, 0x6f, 0x53, 0x7f },
+  { 0x16, 0x3e, 0x7e, 0x75, 0x7e, 0x2d, 0xc4, 0x44, 0x69, 0x12, 0x3f, 0xf0, 0xe5, 0xda, 0xec, 0x5e },
+  { 0x16, 0x9d, 0x4c, 0x7b, 0xd3, 0xa4, 0xd0, 0x9e, 0x18, 0x4a, 0x3b, 0x99, 0x38, 0x23, 0xd0, 0x48 },
+  { 0x16, 0xcb, 0x43, 0x49, 0x29, 0x87, 0xd2, 0xf3, 0x2b, 0x42, 0x38, 0x17, 0xcd, 0xaa, 0xf7, 0xc4 },
+  { 0x16, 0xcc, 0x6d, 0x1b, 0x4d, 0xdc, 0xe5, 0x1c, 0x76, 0x7a, 0x1b, 0xa8, 0xe5, 0xff, 0x19, 0x6c },
+  { 0x16, 0xe0, 0x48, 0x23, 0x88, 0x7c, 0x54, 0x7d, 0xc2, 0x4b, 0xc7, 0x0d, 0xff, 0x69, 0x3d, 0xf4 },
+  { 0x16, 0xee, 0x44, 0x3c, 0x99, 0x02, 0x15, 0xf6, 0x1f, 0x7d, 0xd1, 0xe5, 0x5a, 0x0d, 0x22, 0x56 },
+  { 0x16, 0xf4, 0x94, 0xf2, 0x0a, 0xf5, 0xdc, 0x80, 0x3b, 0xc3, 0x59, 0x39, 0xef, 0x92, 0x40, 0x20 },
+  { 0x16, 0xfb, 0xb3, 0x6a, 0x61, 0x24, 0x56, 0x74, 0x05, 0xa2, 0x35, 0x82, 0x1e, 0x8f, 0x69, 0xee },
+  { 0x17, 0x0e, 0x75, 0x89, 0xa4, 0x87, 0x39, 0xcf, 0xb9, 0xcc, 0x78, 0x2c, 0xbb, 0x0f, 0xe2, 0x5a },
+  { 0x17, 0x1c, 0xd6, 0xb5, 0x52, 0x67, 0x57, 0x3e, 0x6a, 0x9c, 0x29, 0x21, 0xfb, 0x72, 0x07, 0x94 },
+  { 0x17, 0x33, 0x77, 0x21, 0x65, 0xd7, 0xb8, 0x86, 0xa9, 0x4e, 0x2b, 0x4e, 0xd0, 0xf7, 0x4c, 0xcd },
+  { 0x17, 0x38, 0xb2, 0xe3, 0xf2, 0x5a, 0xb3, 0xee, 0xf3, 0xce, 0xcb, 0x95, 0xe1, 0xd0, 0xd9, 0x57 },
+  { 0x17, 0x51, 0x2d, 0x0c, 0x38, 0xf4, 0x48, 0x71, 0x2f, 0x49, 0xf3, 0x6f, 0x9d, 0x18, 0x5c, 0x4e },
+  { 0x17, 0x51, 0x5a, 0x4d, 0x0b, 0x7e, 0xa5, 0x02, 0x9f, 0xff, 0xf7, 0xdf, 0xa8, 0x45, 0x66, 0x71 },
+  { 0x17, 0x6d, 0x3f, 0xba, 0x7d, 0x68, 0x7f, 0x2b, 0x23, 0x15, 0x80, 0x98, 0xe1, 0x03, 0xc3, 0x4a },
+  { 0x17, 0x75, 0x04, 0xab, 0xd4, 0x26, 0x0c, 0x42, 0x65, 0xe1, 0x33, 0x89, 0x55, 0xe9, 0xfa, 0x47 },
+  { 0x17, 0x82, 0x92, 0x9e, 0x1c, 0x21, 0x4b, 0x70, 0xfb, 0x68, 0x84, 0xf7, 0x7c, 0x20, 0x7a, 0x55 },
+  { 0x17, 0xba, 0x72, 0x43, 0x3d, 0xd4, 0x13, 0x83, 0x06, 0x5d, 0x4a, 0xa6, 0xde, 0xdb, 0x3d, 0x91 },
+  { 0x17, 0xba, 0xdb, 0xb3, 0xf5, 0x4d, 0x1f, 0xc0, 0x1e, 0xe6, 0x87, 0x26, 0x88, 0x2f, 0x26, 0xa6 },
+  { 0x17, 0xbb, 0xe2, 0x88, 0xc3, 0x85, 0x5c, 0x23, 0x59, 0x50, 0xfe, 0xa9, 0x1c, 0x95, 0x04, 0xe9 },
+  { 0x17, 0xc0, 0xa6, 0x3f, 0x9a, 0x68, 0x0e, 0x7a, 0x61, 0xbe, 0xba, 0x81, 0x69, 0x2d, 0x92, 0x97 },
+  { 0x17, 0xd0, 0x00, 0xa2, 0x88, 0x2f, 0x9f, 0xda, 0xa8, 0xb4, 0xa3, 0x91, 0xad, 0x36, 0x7f, 0x00 },
+  { 0x17, 0xee, 0x15, 0x8d, 0x15, 0xe4, 0xa3, 0x4f, 0x57, 0xa8, 0x37, 0xbc, 0x1c, 0xe2, 0xb0, 0xce },
+  { 0x17, 0xee, 0x23, 0xe5, 0xda, 0x93, 0x1b, 0xe8, 0x2f, 0x73, 0x39, 0x17, 0xad, 0xcb, 0x63, 0x86 },
+  { 0x18, 0x02, 0xcc, 0x46, 0xb8, 0x79, 0xb2, 0x29, 0x27, 0x25, 0x01, 0x99, 0x8c, 0x5d, 0xe0, 0x4f },
+  { 0x18, 0x30, 0x20, 0xa8, 0x08, 0x48, 0xe0, 0x6a, 0x12, 0x38, 0xa1, 0xab, 0x74, 0x07, 0x9d, 0x52 },
+  { 0x18, 0x62, 0xfc, 0xa4, 0xf9, 0x8e, 0x66, 0xf3, 0x63, 0x30, 0x8b, 0x85, 0x9b, 0x58, 0x63, 0xaf },
+  { 0x18, 0x76, 0x0f, 0x1f, 0x9c, 0xa5, 0xe1, 0x86, 0x10, 0x11, 0x5c, 0xf7, 0xb8, 0x15, 0xb8, 0x24 },
+  { 0x18, 0xa9, 0x70, 0xbe, 0xa7, 0xac, 0x4d, 0x29, 0x70, 0x7c, 0x8d, 0x5c, 0xd5, 0x59, 0xd0, 0x3a },
+  { 0x18, 0xb2, 0x8b, 0x38, 0x6a, 0xbd, 0xad, 0xb3, 0xa7, 0x00, 0xac, 0x8f, 0xb6, 0x8e, 0x63, 0x9a },
+  { 0x18, 0xbe, 0xbb, 0xbd, 0x41, 0xc2, 0x34, 0xf8, 0x2b, 0x17, 0x17, 0xb1, 0x90, 0x5e, 0x60, 0x27 },
+  { 0x18, 0xd2, 0x61, 0x11, 0xce, 0xf6, 0x6d, 0xff, 0x0c, 0x8a, 0xf8, 0xcf, 0x0e, 0x11, 0x78, 0x43 },
+  { 0x18, 0xdc, 0x28, 0xbc, 0x22, 0x40, 0x2f, 0x21, 0xe1, 0xc9, 0xb8, 0x13, 0x44, 0xb3, 0xb8, 0xc5 },
+  { 0x18, 0xed, 0x63, 0xe3, 0xce, 0x5b, 0xc3, 0xdd, 0x2d, 0x8b, 0xd1, 0x88, 0xb8, 0x07, 0xf1, 0xa2 },
+  { 0x18, 0xf2, 0x99, 0xed, 0xb5, 0xba, 0x70, 0x9a, 0x64, 0xc8, 0x0c, 0x8c, 0x9c, 0xec, 0x24, 0xf2 },
+  { 0x19, 0x09, 0x8c, 0x46, 0xda, 0x06, 0x40, 0xf2, 0xb5, 0x76, 0x31, 0x67, 0xde, 0xa6, 0xc7, 0x16 },
+  { 0x19, 0x14, 0x49, 0xe4, 0x0b, 0x0c, 0x56, 0x41, 0x1c, 0x70, 0x77, 0x27, 0x06, 0xf7, 0x92, 0x24 },
+  { 0x19, 0x16, 0x23, 0x93, 0x78, 0x60, 0x98, 0xd5, 0x05, 0x87, 0x82, 0x75, 0x88, 0x19, 0x8a, 0x86 },
+  { 0x19, 0x1a, 0xc4, 0xee, 0xc7, 0x67, 0x35, 0x8e, 0xe3, 0xec, 0x37, 0x56, 0xc1, 0x20, 0x42, 0x3a },
+  { 0x19, 0x2a, 0xa2, 0xe8, 0xc7, 0x95, 0xc9, 0xe1, 0x0a, 0x79, 0x13, 0xe5, 0xd4, 0x1f, 0xeb, 0x81 },
+  { 0x19, 0x3f, 0x06, 0x05, 0x53, 0xba, 0x0a, 0x2a, 0x26, 0x76, 0xf9, 0x1d, 0x9e, 0xc0, 0xc5, 0x55 },
+  { 0x19, 0x99, 0x85, 0xca, 0xe1, 0xc0, 0x12, 0x3a, 0xb1, 0xae, 0xf9, 0x21, 0xda, 0xac, 0xe8, 0xbe },
+  { 0x19, 0x9e, 0xb0, 0xb8, 0xdc, 0xe1, 0x40, 0x8f, 0x3f, 0x7d, 0x46, 0x41, 0x1b, 0x71, 0x5c, 0xa9 },
+  { 0x19, 0xa9, 0xd3, 0xf9, 0xfa, 0x1b, 0x13, 0x58, 0xfb, 0x53, 0x00, 0x94, 0x44, 0x24, 0x7a, 0xaf },
+  { 0x19, 0xab, 0xaf, 0x21, 0x44, 0xb6, 0xa7, 0xb2, 0x81, 0xc4, 0x11, 0x2c, 0xff, 0x15, 0x49, 0x04 },
+  { 0x19, 0xd6, 0x95, 0x6f, 0xf1, 0x7a, 0x95, 0x9c, 0x48, 0xfc, 0xd8, 0xf4, 0x70, 0x6a, 0x84, 0x8d },
+  { 0x19, 0xd9, 0xb5, 0xf8, 0x42, 0x89, 0x47, 0xea, 0xe6, 0xf8, 0xe9, 0x7c, 0x7f, 0x33, 0xbf, 0x44 },
+  { 0x19, 0xe7, 0x39, 0xc2, 0x76, 0x4a, 0x5a, 0xb9, 0xed, 0x08, 0xf9, 0x09, 0x5a, 0xa2, 0xaf, 0x0b },
+  { 0x19, 0xe7, 0x61, 0xe5, 0x3e, 0x5e, 0xc8, 0xe9, 0xf2, 0xfc, 0xee, 0xa6, 0x27, 0x15, 0xca, 0x06 },
+  { 0x1a, 0x23, 0x54, 0x0d, 0x91, 0xf8, 0x75, 0x84, 0xa0, 0x4f, 0x18, 0x43, 0x04, 0xa0, 0x06, 0x48 },
+  { 0x1a, 0x61, 0x3c, 0xe6, 0x0f, 0xc8, 0x34, 0xd4, 0x97, 0x0e, 0x1e, 0x67, 0x4b, 0x91, 0x96, 0xb3 },
+  { 0x1a, 0x62, 0x4e, 0x23, 0x65, 0x26, 0xc4, 0xc8, 0xf3, 0x11, 0x75, 0xe9, 0xc8, 0x9b, 0x2a, 0x22 },
+  { 0x1a, 0x82, 0x04, 0xa2, 0xbc, 0xd7, 0x93, 0xf5, 0x39, 0x16, 0x87, 0x73, 0xd9, 0xad, 0x62, 0x30 },
+  { 0x1a, 0xa7, 0x34, 0x4b, 0x56, 0x3c, 0x59, 0x7e, 0xec, 0xfb, 0xfc, 0xf8, 0xe7, 0x09, 0x3c, 0x27 },
+  { 0x1b, 0x0f, 0x3d, 0x7a, 0xf6, 0x68, 0xee, 0xea, 0x38, 0xdd, 0xd6, 0x18, 0x2d, 0x8f, 0x48, 0xfb },
+  { 0x1b, 0x1d, 0xaa, 0xa9, 0xaa, 0x5c, 0xde, 0xd3, 0xd6, 0x33, 0xbf, 0xcb, 0xeb, 0x06, 0x47, 0x9c },
+  { 0x1b, 0x22, 0xa3, 0xd7, 0x9d, 0xdd, 0x79, 0x33, 0x5b, 0x69, 0xc9, 0x4d, 0xd9, 0xb3, 0xe4, 0x4e },
+  { 0x1b, 0x4b, 0x06, 0xc2, 0xa1, 0x4e, 0xd3, 0xee, 0x73, 0xb7, 0xd0, 0xfd, 0x61, 0xb6, 0xaa, 0xf5 },
+  { 0x1b, 0x8c, 0x3c, 0x0b, 0xfb, 0x81, 0x5b, 0x2a, 0x10, 0x10, 0xbb, 0xa9, 0x59, 0x98, 0xb6, 0x6e },
+  { 0x1b, 0x8d, 0x35, 0xd9, 0x36, 0x97, 0x45, 0x0e, 0xa2, 0x6e, 0xbf, 0x7f, 0xf1, 0x7b, 0xd4, 0xd1 },
+  { 0x1b, 0xb9, 0x1b, 0xae, 0x91, 0x9d, 0xdb, 0xd6, 0x55, 0xfa, 0x25, 0xc5, 0x4e, 0xa6, 0xf5, 0x32 },
+  { 0x1b, 0xc2, 0x42, 0x7a, 0xc9, 0xb0, 0x32, 0xa5, 0x2f, 0xe5, 0x27, 0xc7, 0xb2, 0x6c, 0xe2, 0x2c },
+  { 0x1b, 0xef, 0x38, 0x9e, 0x3d, 0xd2, 0xd4, 0xca, 0x4f, 0x2f, 0x60, 0xd4, 0x2c, 0x93, 0x25, 0x09 },
+  { 0x1b, 0xf5, 0x03, 0xc7, 0x24, 0x00, 0x1b, 0x09, 0xbe, 0x79, 0xc5, 0x15, 0xec, 0xfc, 0xbd, 0x03 },
+  { 0x1c, 0x3f, 0x31, 0x33, 0xa3, 0xe5, 0xb0, 0x23, 0xc7, 0x7e, 0xcb, 0xa9, 0x4f, 0xd6, 0x59, 0x95 },
+  { 0x1c, 0x57, 0x96, 0xd2, 0x77, 0xd9, 0xe4, 0xdf, 0x3f, 0x66, 0x48, 0xf7, 0x01, 0x28, 0x84, 0xc4 },
+  { 0x1c, 0x6e, 0xb7, 0x40, 0xd3, 0xc4, 0x85, 0x76, 0x6c, 0xad, 0xe5, 0x66, 0xab, 0xab, 0x82, 0x08 },
+  { 0x1c, 0x85, 0xc0, 0xfc, 0x48, 0x0b, 0xbd, 0x69, 0xdc, 0x30, 0x15, 0x91, 0xb6, 0xec, 0xb4, 0x22 },
+  { 0x1c, 0x8c, 0x42, 0xd1, 0xae, 0xe5, 0x01, 0x0b, 0x30, 0xe7, 0xf1, 0x99, 0x2d, 0x69, 0x21, 0x6e },
+  { 0x1c, 0xad, 0x3b, 0x56, 0xcc, 0x0e, 0x6e, 0x85, 0x85, 0x54, 0xe4, 0x6d, 0x08, 0x95, 0x28, 0x61 },
+  { 0x1c, 0xaf, 0xa9, 0xf3, 0xf9, 0xa2, 0xfc, 0xe4, 0xaf, 0x6e, 0x4b, 0x85, 0xa2, 0xbb, 0xd2, 0x54 },
+  { 0x1c, 0xca, 0x21, 0x97, 0xd9, 0x5c, 0x5a, 0x41, 0xf2, 0xad, 0xd4, 0x9a, 0x13, 0x73, 0x80, 0x55 },
+  { 0x1c, 0xf5, 0x9f, 0xc7, 0xb1, 0x1c, 0xdb, 0xce, 0xfe, 0x93, 0x1e, 0x41, 0x64, 0x17, 0x72, 0xf6 },
+  { 0x1d, 0x1d, 0x26, 0x03, 0xec, 0x13, 0x98, 0x67, 0xc1, 0xd1, 0xf5, 0xdd, 0xf8, 0x30, 0x93, 0xf1 },
+  { 0x1d, 0x28, 0x4d, 0x6a, 0x3f, 0x85, 0x0b, 0xaf, 0xb2, 0x56, 0x35, 0xa1, 0x2b, 0x31, 0x6f, 0x3d },
+  { 0x1d, 0x2a, 0x28, 0xeb, 0x8c, 0x95, 0xda, 0x0d, 0x6d, 0x6b, 0x18, 0x29, 0x42, 0x11, 0x83, 0x9f },
+  { 0x1d, 0x4e, 0x0a, 0x03, 0x4a, 0xd1, 0x27, 0x5b, 0xc4, 0xd7, 0x51, 0x65, 0xae, 0x23, 0x61, 0x05 },
+  { 0x1d, 0x5e, 0xac, 0x85, 0xe6, 0x7b, 0x8c, 0xff, 0x13, 0x77, 0xc8, 0xdb, 0xa1, 0x13, 0x69, 0x29 },
+  { 0x1d, 0x6e, 0xd6, 0xfe, 0x9d, 0xfb, 0xde, 0x32, 0x70, 0x8e, 0x83, 0x53, 0x54, 0x8c, 0xbb, 0x80 },
+  { 0x1d, 0xa2, 0xda, 0x79, 0x74, 0xd2, 0xca, 0x73, 0xa8, 0x23, 0x52, 0x3f, 0x82, 0xf5, 0x17, 0xb3 },
+  { 0x1d, 0xb3, 0xbc, 0x46, 0x01, 0xf2, 0x2c, 0xf4, 0x3b, 0xe7, 0xce, 0x01, 0x5d, 0x74, 0xf5, 0x9a },
+  { 0x1e, 0x06, 0x0a, 0x80, 0x25, 0x51, 0x2a, 0xd2, 0x12, 0x7e, 0x3d, 0xa1, 0x1e, 0x21, 0x2c, 0xcc },
+  { 0x1e, 0x0e, 0xf0, 0x1e, 0x33, 0x0e, 0x5b, 0x91, 0x38, 0x7f, 0x75, 0xf7, 0x00, 0xcc, 0xaf, 0x8f },
+  { 0x1e, 0x12, 0x90, 0xea, 0x10, 0x2e, 0x12, 0xd7, 0xac, 0x52, 0x82, 0x09, 0x61, 0x45, 0x7e, 0x2b },
+  { 0x1e, 0x18, 0x17, 0xd9, 0xcb, 0xcc, 0x3b, 0xa7, 0x50, 0x43, 0xb7, 0xdb, 0x4e, 0x6c, 0x22, 0x8f },
+  { 0x1e, 0x27, 0x2d, 0x09, 0xc0, 0xe5, 0x5f, 0x5e, 0xf1, 0x4f, 0xcb, 0x76, 0xa7, 0x35, 0xf6, 0xd7 },
+  { 0x1e, 0x58, 0x7c, 0xa9, 0x15, 0x18, 0xa4, 0x77, 0x53, 0xa2, 0x82, 0x17, 0xcd, 0x4f, 0xd5, 0x86 },
+  { 0x1e, 0x75, 0x00, 0x00, 0xaf, 0x77, 0xcc, 0x76, 0x23, 0x2f, 0x4d, 0x04, 0x0f, 0x4a, 0xb0, 0x60 },
+  { 0x1e, 0x85, 0xf8, 0xbc, 0xcb, 0x4b, 0x86, 0x6d, 0x4d, 0xaa, 0x9f, 0xcf, 0x89, 0x30, 0x64, 0x74 },
+  { 0x1e, 0x89, 0xf7, 0x22, 0x49, 0x46, 0x08, 0xd6, 0xea, 0x15, 0xa0, 0x0d, 0x99, 0xf8, 0x13, 0x37 },
+  { 0x1e, 0xa1, 0xab, 0xcd, 0x2d, 0x3d, 0x3d, 0x62, 0x8f, 0x59, 0xa9, 0x9a, 0x9d, 0x41, 0xb1, 0x3b },
+  { 0x1e, 0xa9, 0x80, 0x57, 0x44, 0x16, 0xbf, 0xd5, 0x04, 0xf6, 0x25, 0x75, 0xba, 0x52, 0x40, 0x05 },
+  { 0x1e, 0xc5, 0x7b, 0xbd, 0x27, 0xbd, 0xbd, 0x08, 0xb6, 0x0c, 0x39, 0x1c, 0x48, 0x95, 0xc1, 0xcf },
+  { 0x1e, 0xc5, 0xbe, 0xf7, 0x7b, 0x91, 0xe5, 0x93, 0x13, 0xcb, 0xa2, 0x05, 0xf1, 0x5b, 0x06, 0xd7 },
+  { 0x1e, 0xde, 0x4f, 0x36, 0x5c, 0xe1, 0x38, 0x6d, 0x58, 0xf1, 0x21, 0xb1, 0x5a, 0x77, 0x5e, 0x24 },
+  { 0x1e, 0xe2, 0xcf, 0xc7, 0xd0, 0x33, 0x3b, 0x96, 0xbd, 0x11, 0xf7, 0xf3, 0xec, 0x8c, 0xe8, 0xbc },
+  { 0x1e, 0xe9, 0xc1, 0xba, 0x95, 0xce, 0xf2, 0xcf, 0x98, 0x7d, 0x63, 0xf1, 0x76, 0xc5, 0x4a, 0xc3 },
+  { 0x1e, 0xf0, 0x4e, 0x7e, 0x50, 0x82, 0x96, 0xa8, 0xd9, 0xeb, 0x61, 0xcc, 0x7d, 0xae, 0x2e, 0x5d },
+  { 0x1f, 0x21, 0x66, 0x6b, 0x8f, 0x78, 0xb6, 0x50, 0x51, 0xb7, 0xa6, 0x09, 0xf1, 0xd4, 0x86, 0x08 },
+  { 0x1f, 0x2a, 0xe0, 0xc7, 0x0a, 0x04, 0xc9, 0x80, 0xc8, 0x38, 0xc2, 0xcd, 0xc4, 0x12, 0xcf, 0x45 },
+  { 0x1f, 0x34, 0x9d, 0xd4, 0x1c, 0x3f, 0x93, 0xc4, 0x21, 0x4e, 0x5e, 0x30, 0x8d, 0xcc, 0xb0, 0x56 },
+  { 0x1f, 0x40, 0xee, 0xfc, 0x74, 0x47, 0x33, 0x6a, 0xe6, 0xcd, 0x8f, 0xfa, 0x5e, 0xb3, 0x25, 0xbe },
+  { 0x1f, 0x56, 0x2b, 0x89, 0xd0, 0x81, 0xe3, 0x6d, 0x58, 0xe6, 0xfc, 0x94, 0x35, 0x12, 0xec, 0x05 },
+  { 0x1f, 0x5a, 0x29, 0x27, 0xa0, 0xb2, 0xfa, 0xf8, 0x75, 0x40, 0xb0, 0x1d, 0x9d, 0x7d, 0x7f, 0xd1 },
+  { 0x1f, 0x60, 0xe4, 0x8a, 0xd9, 0x8b, 0x65, 0x9a, 0x05, 0xce, 0x0c, 0x1a, 0x8e, 0x99, 0x9a, 0xd9 },
+  { 0x1f, 0x77, 0x3a, 0x94, 0xd9, 0x19, 0xb2, 0xa3, 0xc6, 0x47, 0x17, 0x2b, 0xbb, 0x97, 0xf6, 0xb4 },
+  { 0x1f, 0xa5, 0x86, 0x79, 0xd4, 0xa3, 0x90, 0x52, 0xbd, 0x9d, 0xb0, 0x59, 0xe8, 0xcd, 0xa4, 0xad },
+  { 0x1f, 0xa7, 0xa4, 0x2c, 0x2c, 0x7d, 0x6b, 0x7a, 0x0c, 0x6a, 0x05, 0xd3, 0x8c, 0x75, 0x08, 0xf4 },
+  { 0x1f, 0xa8, 0x62, 0x82, 0x40, 0x3f, 0xa3, 0x5d, 0x10, 0x3a, 0xb8, 0x8a, 0x9d, 0x60, 0x3c, 0x31 },
+  { 0x1f, 0xab, 0x68, 0xfd, 0x67, 0xfe, 0x5a, 0x86, 0xb2, 0xc0, 0xa9, 0x22, 0x7a, 0x59, 0xbb, 0x95 },
+  { 0x20, 0x03, 0x09, 0xc8, 0xfb, 0xa0, 0xf2, 0x48, 0xc1, 0x37, 0x51, 0xed, 0x4f, 0xc6, 0x9b, 0xab },
+  { 0x20, 0x08, 0xc7, 0x6d, 0xeb, 0xa5, 0x95, 0x32, 0x01, 0xef, 0x75, 0xa0, 0x9b, 0x2f, 0xf7, 0xdc },
+  { 0x20, 0x0a, 0x9d, 0x2a, 0x7c, 0xb4, 0x44, 0x1c, 0xe4, 0xf0, 0x02, 0xdf, 0x6a, 0xa4, 0x7e, 0x38 },
+  { 0x20, 0x16, 0x72, 0x6d, 0xb3, 0x8a, 0xd6, 0xa6, 0x8b, 0x4c, 0x48, 0xba, 0x6f, 0xe5, 0x15, 0x57 },
+  { 0x20, 0x30, 0x49, 0xf4, 0xd8, 0x29, 0x0b, 0xb4, 0x52, 0x1c, 0xc4, 0x40, 0x24, 0x15, 0xe7, 0x37 },
+  { 0x20, 0x3a, 0xbb, 0x71, 0x3c, 0x00, 0xb0, 0x88, 0x42, 0x06, 0xdc, 0xc6, 0x56, 0xca, 0xa4, 0x8f },
+  { 0x20, 0x3b, 0x1e, 0xfc, 0x61, 0x01, 0xd4, 0xb9, 0xd8, 0x3b, 0xb6, 0xcc, 0x1c, 0x71, 0xf6, 0x7f },
+  { 0x20, 0x50, 0x70, 0xb6, 0xa0, 0xd4, 0x54, 0x96, 0x1d, 0xd9, 0x19, 0x6a, 0x8e, 0x81, 0xd8, 0x77 },
+  { 0x20, 0x91, 0xaf, 0x29, 0xb4, 0xe7, 0xb8, 0x69, 0x14, 0xd7, 0x9d, 0x9a, 0xaa, 0x4c, 0xbd, 0x20 },
+  { 0x20, 0xae, 0x62, 0xfb, 0x69, 0xc6, 0xcc, 0x6e, 0x80, 0x98, 0xcc, 0xa8, 0xcd, 0x08, 0x04, 0x87 },
+  { 0x20, 0xd4, 0x45, 0x7b, 0xa2, 0x25, 0x17, 0x25, 0x3f, 0xcb, 0x62, 0x96, 0x7a, 0xf1, 0x1b, 0x37 },
+  { 0x20, 0xdc, 0xa5, 0x34, 0xb9, 0x97, 0xbf, 0x60, 0x7d, 0x65, 0x8e, 0x77, 0xfb, 0xb3, 0xc0, 0xee },
+  { 0x20, 0xed, 0xcc, 0x3a, 0xa6, 0xc1, 0x89, 0x25, 0x9f, 0xa7, 0xe2, 0xf0, 0x44, 0xa9, 0x9c, 0x49 },
+  { 0x21, 0x17, 0x74, 0xf4, 0xc5, 0x73, 0x90, 0x42, 0x61, 0x8b, 0xe8, 0xff, 0x67, 0x35, 0x11, 0x77 },
+  { 0x21, 0x1f, 0x76, 0xdf, 0xf0, 0xb7, 0xda, 0xd3, 0xf6, 0xfc, 0xac, 0x9d, 0x93, 0x8e, 0xe6, 0x1a },
+  { 0x21, 0x1f, 0xbb, 0xdb, 0xbc, 0xa1, 0x10, 0x2d, 0xc5, 0xb4, 0x3d, 0xc8, 0x15, 0x7c, 0x09, 0xb3 },
+  { 0x21, 0x24, 0xcf, 0x92, 0x97, 0x8c, 0x46, 0x68, 0x4b, 0x6c, 0x39, 0xcc, 0xc2, 0xe3, 0x37, 0x13 },
+  { 0x21, 0x29, 0x9c, 0x8c, 0x3a, 0xc1, 0xd5, 0x4f, 0x82, 0x89, 0xd8, 0x87, 0x02, 0xa7, 0x38, 0xfd },
+  { 0x21, 0x2d, 0x0b, 0x20, 0x0e, 0xd8, 0xb4, 0x5d, 0x87, 0x95, 0xad, 0x89, 0x97, 0x34, 0xd7, 0xd7 },
+  { 0x21, 0x3e, 0x5e, 0x82, 0xec, 0xb4, 0x2a, 0xf2, 0x37, 0xcf, 0xed, 0x86, 0x12, 0xc1, 0x28, 0xac },
+  { 0x21, 0x62, 0x26, 0x6b, 0x90, 0x6c, 0x93, 0x9b, 0x35, 0xc8, 0x4f, 0xf9, 0xa0, 0xf5, 0x0a, 0xd1 },
+  { 0x21, 0x79, 0xdf, 0xd7, 0xed, 0xee, 0x76, 0xef, 0xaf, 0xe6, 0x98, 0xc1, 0xbc, 0x76, 0x37, 0x35 },
+  { 0x21, 0x8b, 0x76, 0xf5, 0xa4, 0x14, 0x2d, 0xc2, 0xea, 0x90, 0x51, 0xa7, 0x68, 0x58, 0x3d, 0x70 },
+  { 0x21, 0x8c, 0x0f, 0xe5, 0x3d, 0xfa, 0xaa, 0x37, 0xf3, 0xc8, 0x23, 0xf6, 0x6e, 0xaf, 0xd3, 0xfc },
+  { 0x21, 0xa9, 0x63, 0x01, 0xbb, 0x0d, 0xf2, 0x7f, 0xde, 0x2e, 0x7e, 0xef, 0xa4, 0x9e, 0x03, 0x97 },
+  { 0x21, 0xb0, 0x9c, 0x40, 0x29, 0x5c, 0x2d, 0x70, 0x74, 0xa8, 0x3a, 0xe0, 0x40, 0xf2, 0x2e, 0xdf },
+  { 0x21, 0xd2, 0xc4, 0x35, 0xbc, 0xcc, 0xde, 0x77, 0x92, 0xd8, 0x28, 0x44, 0xb3, 0xcf, 0x60, 0xf4 },
+  { 0x21, 0xd7, 0x33, 0x4e, 0x40, 0x6c, 0x24, 0x07, 0xe6, 0x9d, 0xbd, 0xdd, 0x7c, 0xec, 0x35, 0x83 },
+  { 0x22, 0x28, 0xc6, 0x7d, 0x25, 0xe5, 0x07, 0x60, 0x3d, 0x48, 0x73, 0xd3, 0x93, 0x4f, 0x07, 0x57 },
+  { 0x22, 0x31, 0x9b, 0xe7, 0xa6, 0x40, 0xaf, 0x53, 0x14, 0xec, 0x3c, 0x48, 0x2c, 0xce, 0xb6, 0x76 },
+  { 0x22, 0x40, 0x65, 0x52, 0x47, 0xd6, 0xde, 0x1c, 0x58, 0x55, 0x64, 0x00, 0x4a, 0x85, 0x3a, 0xb7 },
+  { 0x22, 0x55, 0x22, 0x77, 0x7d, 0xc7, 0x15, 0x56, 0x27, 0x80, 0x8b, 0xde, 0x0c, 0x1d, 0x0e, 0xf0 },
+  { 0x22, 0x67, 0x5c, 0xac, 0xd9, 0xb7, 0x1d, 0xea, 0x21, 0x80, 0x0c, 0xbf, 0x85, 0x97, 0xf0, 0x00 },
+  { 0x22, 0x75, 0x32, 0xd8, 0x25, 0x05, 0xc3, 0xc1, 0x85, 0xa8, 0x78, 0x27, 0x3c, 0x28, 0x5d, 0x5f },
+  { 0x22, 0xab, 0xbd, 0xcb, 0x09, 0x4d, 0x01, 0x43, 0x88, 0xd5, 0x29, 0x35, 0x2a, 0xbe, 0x9b, 0x4b },
+  { 0x22, 0xb2, 0x2c, 0x4c, 0xe2, 0x40, 0x30, 0x30, 0x12, 0xe8, 0xa9, 0x59, 0x6a, 0xe8, 0xd1, 0x89 },
+  { 0x22, 0xf6, 0xb4, 0x0f, 0xc8, 0x21, 0x10, 0xd6, 0x8e, 0x50, 0xa1, 0x20, 0x8a, 0xe0, 0xbb, 0x97 },
+  { 0x23, 0x19, 0x92, 0x2d, 0xf4, 0xd0, 0xc8, 0x20, 0xb3, 0xe5, 0xf1, 0x5f, 0xaa, 0x87, 0x0c, 0xc3 },
+  { 0x23, 0x27, 0x45, 0x6f, 0x86, 0xd7, 0xe0, 0xde, 0xda, 0x94, 0x75, 0x8c, 0x51, 0x8d, 0x05, 0xb3 },
+  { 0x23, 0x51, 0xd2, 0x6d, 0x0b, 0xfd, 0xee, 0x30, 0x95, 0xbe, 0xc9, 0xc0, 0x5c, 0xbc, 0xf7, 0xb0 },
+  { 0x23, 0x53, 0x72, 0x5e, 0xc9, 0x8e, 0x0f, 0x00, 0x73, 0x46, 0x21, 0x09, 0xe8, 0x86, 0xef, 0xd7 },
+  { 0x23, 0x54, 0x36, 0xab, 0x08, 0x32, 0x37, 0x0e, 0x73, 0x67, 0x7c, 0x9c, 0x6f, 0x0c, 0x8b, 0x06 },
+  { 0x23, 0x65, 0xe1, 0x53, 0x4d, 0x67, 0xf9, 0x4d, 0x86, 0x70, 0x39, 0x4a, 0xb9, 0x91, 0x50, 0xce },
+  { 0x23, 0xd4, 0x45, 0xea, 0x19, 0xa1, 0x8f, 0xb7, 0x8d, 0x50, 0x35, 0x87, 0x8d, 0x9f, 0xb6, 0x49 },
+  { 0x23, 0xe4, 0xca, 0x03, 0x8a, 0xba, 0x11, 0x98, 0x2e, 0x16, 0x94, 0x55, 0x9f, 0x3b, 0xe1, 0x0f },
+  { 0x23, 0xfa, 0xd5, 0xa1, 0x25, 0xbc, 0xd4, 0x46, 0x37, 0x01, 0xc8, 0xad, 0x8a, 0x00, 0x43, 0xa9 },
+  { 0x24, 0x0b, 0xfb, 0xac, 0x51, 0x63, 0xaf, 0x4d, 0xf5, 0xae, 0x71, 0x39, 0x85, 0x38, 0x6f, 0x92 },
+  { 0x24, 0x32, 0xf3, 0x3f, 0xd2, 0x78, 0xde, 0xa5, 0xfe, 0x6a, 0xe9, 0x40, 0x73, 0x62, 0x7f, 0xcc },
+  { 0x24, 0x38, 0x5b, 0xa7, 0xf5, 0x10, 0x9f, 0xbe, 0x76, 0xaa, 0xdc, 0x0a, 0x37, 0x5d, 0xe5, 0x73 },
+  { 0x24, 0x47, 0xe1, 0x7a, 0x4e, 0x18, 0xe6, 0xb6, 0x09, 0xde, 0x49, 0x8f, 0xe4, 0xab, 0x52, 0xba },
+  { 0x24, 0x4c, 0x6d, 0xe2, 0x7f, 0xaf, 0xf5, 0x27, 0x88, 0x6f, 0xc7, 0x69, 0x9a, 0x41, 0xc3, 0xbe },
+  { 0x24, 0x50, 0xdf, 0xa1, 0xdf, 0x70, 0xd1, 0x2b, 0x60, 0x68, 0x31, 0x85, 0x77, 0x5e, 0xfe, 0xd8 },
+  { 0x24, 0x54, 0x4e, 0xe5, 0xd7, 0x6f, 0x57, 0x99, 0x92, 0xd9, 0x52, 0x2e, 0x9b, 0x23, 0x89, 0x55 },
+  { 0x24, 0x5f, 0x07, 0xc8, 0x60, 0x30, 0x77, 0xa0, 0xca, 0xf5, 0xf8, 0x3e, 0xe6, 0xcf, 0x8b, 0x43 },
+  { 0x24, 0x75, 0x9b, 0xe3, 0x1e, 0x8f, 0xe5, 0x5d, 0x28, 0x29, 0xfd, 0x86, 0xbd, 0xf3, 0x18, 0x1f },
+  { 0x24, 0x7f, 0xa1, 0xa2, 0x9a, 0xd9, 0x0e, 0x64, 0x06, 0x9e, 0xe1, 0x3d, 0x96, 0xfe, 0xa6, 0xd6 },
+  { 0x24, 0x96, 0xd4, 0x04, 0xbf, 0xc5, 0x61, 0xa4, 0x0a, 0x80, 0xbe, 0xa6, 0xa6, 0x96, 0x95, 0xc3 },
+  { 0x24, 0xad, 0x53, 0x82, 0x91, 0xeb, 0x5f, 0x5c, 0xac, 0x4b, 0x99, 0x98, 0xf3, 0xb8, 0x51, 0xc3 },
+  { 0x24, 0xaf, 0xf9, 0x72, 0xd5, 0x89, 0x90, 0xf9, 0xb8, 0x8a, 0x6d, 0x78, 0x7c, 0x79, 0x6f, 0x1e },
+  { 0x24, 0xb5, 0xf4, 0xbb, 0xdb, 0x85, 0x3e, 0xca, 0x38, 0xea, 0x0c, 0xae, 0x2d, 0xfe, 0x73, 0xa1 },
+  { 0x24, 0xb9, 0xad, 0xac, 0x1b, 0x4f, 0x85, 0xb0, 0xba, 0xc9, 0xbf, 0x9b, 0x9e, 0x18, 0x09, 0x06 },
+  { 0x24, 0xd0, 0x18, 0xc4, 0xa6, 0xde, 0x7e, 0x5b, 0xd1, 0x9a, 0x36, 0xf2, 0xb8, 0x79, 0xb3, 0x35 },
+  { 0x24, 0xd9, 0xa5, 0x5d, 0x8f, 0x06, 0x33, 0xe8, 0x86, 0xa1, 0xb3, 0x3e, 0xe1, 0xe0, 0xe7, 0x97 },
+  { 0x24, 0xdf, 0x05, 0x29, 0x02, 0xaa, 0x9d, 0xe2, 0x1c, 0x2b, 0x25, 0x25, 0xeb, 0x84, 0xa2, 0x55 },
+  { 0x24, 0xfb, 0xf8, 0x25, 0x0a, 0x71, 0x61, 0x1e, 0x40, 0xef, 0x18, 0x55, 0x2e, 0x61, 0xb0, 0x09 },
+  { 0x25, 0x16, 0xf4, 0xf4, 0xb8, 0x11, 0xed, 0xe4, 0xec, 0xf6, 0xfb, 0xeb, 0x5d, 0x54, 0xa2, 0x99 },
+  { 0x25, 0x17, 0x82, 0x79, 0x50, 0xfe, 0xe4, 0x1a, 0x3b, 0x9d, 0xe6, 0x02, 0x75, 0xc8, 0xaa, 0x6a },
+  { 0x25, 0x26, 0x5d, 0x0e, 0x7f, 0x88, 0xb3, 0x02, 0x60, 0x03, 0x80, 0x9f, 0x25, 0xee, 0x02, 0x5e },
+  { 0x25, 0x47, 0x2d, 0xfd, 0xee, 0xf6, 0xa4, 0x25, 0x81, 0xa2, 0x31, 0xd6, 0x31, 0xd6, 0xb0, 0x4d },
+  { 0x25, 0x71, 0x0b, 0xde, 0x8f, 0xa1, 0x81, 0xb0, 0xc5, 0xcf, 0x08, 0x46, 0xb9, 0x83, 0xbe, 0xc1 },
+  { 0x25, 0x7b, 0xc3, 0xb7, 0x2a, 0x6b, 0x5d, 0xb3, 0xfd, 0x0d, 0x47, 0x61, 0x91, 0x25, 0xb3, 0x87 },
+  { 0x25, 0xa2, 0x1c, 0x47, 0xaf, 0xe9, 0x25, 0xa3, 0xca, 0x08, 0x06, 0x87, 0x6a, 0x2b, 0x4f, 0x3f },
+  { 0x25, 0xb5, 0x2b, 0xf8, 0xdd, 0x21, 0x5b, 0xcb, 0xd5, 0x9c, 0x9a, 0xbd, 0xb5, 0x5c, 0x44, 0xf8 },
+  { 0x25, 0xb6, 0xdc, 0x01, 0x2c, 0xdb, 0xa6, 0x37, 0x04, 0xea, 0x95, 0x35, 0xc6, 0x98, 0x7b, 0xeb },
+  { 0x25, 0xbb, 0x08, 0x04, 0x57, 0x35, 0x1b, 0xe7, 0x24, 0xaa, 0xc8, 0xa0, 0x20, 0x21, 0xaa, 0x92 },
+  { 0x25, 0xd4, 0xbe, 0x33, 0x09, 0xb8, 0x95, 0x83, 0xc6, 0xb3, 0x9d, 0x9f, 0x93, 0xbf, 0x65, 0x4f },
+  { 0x25, 0xe7, 0x3e, 0xfb, 0x9a, 0x6e, 0xdf, 0x11, 0x91, 0x14, 0x71, 0x8b, 0xd2, 0xf6, 0x46, 0xba },
+  { 0x25, 0xf2, 0xe7, 0x60, 0xcd, 0x7f, 0x56, 0xb8, 0x8a, 0xac, 0x88, 0xd6, 0x37, 0x57, 0xd4, 0x1b },
+  { 0x25, 0xf8, 0x79, 0xff, 0x67, 0x81, 0x30, 0xfe, 0xa6, 0x15, 0xac, 0x41, 0x8e, 0x79, 0x43, 0xf1 },
+  { 0x25, 0xf9, 0xcf, 0x70, 0x35, 0x75, 0xc5, 0xd6, 0x30, 0x48, 0xc2, 0x22, 0xf5, 0x46, 0x37, 0x58 },
+  { 0x26, 0x0c, 0x78, 0x7e, 0x89, 0x25, 0xbf, 0x36, 0x49, 0xc8, 0xae, 0xae, 0x5b, 0x97, 0xdc, 0xc0 },
+  { 0x26, 0x2c, 0xcb, 0x88, 0x2f, 0xf6, 0x17, 0xd9, 0xb4, 0xb5, 0x1f, 0x24, 0xae, 0xe0, 0x2c, 0xbe },
+  { 0x26, 0x5a, 0x85, 0xf6, 0x65, 0x44, 0xea, 0xf9, 0x5f, 0xda, 0x06, 0xc3, 0xd9, 0xe4, 0x8a, 0xbf },
+  { 0x26, 0x5c, 0x74, 0xa9, 0x56, 0x50, 0x0b, 0xd3, 0x1e, 0xfd, 0x24, 0xad, 0xc6, 0xd5, 0xcc, 0xf6 },
+  { 0x26, 0x83, 0xd2, 0x9a, 0x28, 0x2d, 0xd0, 0x59, 0x53, 0x5a, 0xc3, 0xbb, 0x25, 0x0f, 0x54, 0x0d },
+  { 0x26, 0x8f, 0x46, 0x03, 0x8e, 0x29, 0x30, 0x15, 0x68, 0xfa, 0x9e, 0x44, 0x3e, 0x16, 0xe9, 0x60 },
+  { 0x26, 0xbc, 0x2b, 0xdf, 0x44, 0x7a, 0x17, 0x37, 0x6a, 0xea, 0x7e, 0xf1, 0x87, 0xff, 0x6e, 0x44 },
+  { 0x26, 0xf4, 0xf8, 0xb0, 0x98, 0x60, 0x91, 0x64, 0xef, 0xfe, 0xf7, 0x80, 0x9e, 0x01, 0x21, 0xe1 },
+  { 0x27, 0x02, 0x29, 0xc6, 0xd5, 0x57, 0x84, 0x46, 0xe6, 0xa5, 0x88, 0x49, 0x2e, 0x4e, 0x59, 0x10 },
+  { 0x27, 0x1b, 0xfd, 0x5d, 0xc2, 0x67, 0x3d, 0x38, 0x20, 0x19, 0xf1, 0xfb, 0x6c, 0xab, 0x93, 0x32 },
+  { 0x27, 0x3c, 0xe5, 0x0d, 0xb5, 0xa0, 0xd6, 0xda, 0x7e, 0xa8, 0x27, 0xa5, 0x4f, 0x44, 0xde, 0xe9 },
+  { 0x27, 0x4d, 0x17, 0xcc, 0xd8, 0x25, 0xef, 0x9c, 0x72, 0x8d, 0x68, 0x39, 0x4b, 0x45, 0x69, 0xd2 },
+  { 0x27, 0x7c, 0x72, 0x81, 0xac, 0x94, 0x5b, 0x83, 0x31, 0xe2, 0xe6, 0xfc, 0xad, 0x56, 0x0c, 0x11 },
+  { 0x27, 0x7c, 0xca, 0x62, 0x01, 0x4f, 0xce, 0xeb, 0xb4, 0x6c, 0x54, 0x9b, 0xac, 0x25, 0xa2, 0xe3 },
+  { 0x27, 0x7f, 0xa4, 0xb9, 0xa6, 0xbb, 0x7a, 0x8d, 0xce, 0xa2, 0xc5, 0xf3, 0x8a, 0x4c, 0x25, 0xf0 },
+  { 0x27, 0x81, 0x55, 0xfc, 0x99, 0x56, 0xe9, 0xb6, 0xef, 0x23, 0x59, 0xeb, 0x23, 0x8f, 0x7c, 0x7f },
+  { 0x27, 0x83, 0x00, 0x6e, 0xe6, 0x51, 0x9f, 0x15, 0xcb, 0xc9, 0x6a, 0xda, 0xe0, 0x31, 0xc9, 0xa9 },
+  { 0x27, 0x85, 0x31, 0xcc, 0x31, 0x91, 0x57, 0x47, 0x01, 0x8d, 0x22, 0x14, 0x58, 0x23, 0xd2, 0xc9 },
+  { 0x27, 0x8f, 0x14, 0x88, 0x7d, 0x60, 0x1b, 0x5e, 0x5b, 0x62, 0x0f, 0x18, 0x70, 0xbc, 0x09, 0xf6 },
+  { 0x27, 0xc4, 0xc2, 0xaf, 0x4b, 0x46, 0x39, 0x4b, 0xb9, 0x86, 0x38, 0xaf, 0x8e, 0x0f, 0x6e, 0x9d },
+  { 0x27, 0xc6, 0xa2, 0xca, 0x16, 0xad, 0x7d, 0x81, 0x46, 0x26, 0xce, 0xea, 0x62, 0xfa, 0x8f, 0xb4 },
+  { 0x27, 0xf9, 0xe2, 0xe1, 0xb9, 0x2a, 0xf9, 0xdc, 0x17, 0xc6, 0x15, 0x56, 0x05, 0xc3, 0x8e, 0x49 },
+  { 0x28, 0x08, 0xdc, 0x74, 0x5f, 0xf4, 0x32, 0x1d, 0xc5, 0xc8, 0x12, 0x2a, 0xbe, 0xf6, 0x71, 0x1f },
+  { 0x28, 0x14, 0x8a, 0x52, 0xb1, 0x95, 0x5c, 0xe1, 0x2c, 0x7a, 0x74, 0xd3, 0xa3, 0xe6, 0x20, 0xa4 },
+  { 0x28, 0x1f, 0xf9, 0xbd, 0x04, 0x70, 0x64, 0x38, 0x53, 0xde, 0x5c, 0xbd, 0x6d, 0x9e, 0x17, 0xf5 },
+  { 0x28, 0x23, 0x36, 0x47, 0x02, 0x59, 0x5f, 0xee, 0xa2, 0x4a, 0x3f, 0xbe, 0xe1, 0x38, 0xa2, 0x43 },
+  { 0x28, 0x25, 0xf4, 0xd0, 0x68, 0xfe, 0xba, 0x69, 0x73, 0xe6, 0x1c, 0x84, 0x64, 0x94, 0x89, 0xfe },
+  { 0x28, 0x2a, 0x77, 0x84, 0x1c, 0xb3, 0xd3, 0x3a, 0xf5, 0xb5, 0x61, 0x51, 0xac, 0xba, 0x77, 0x0e },
+  { 0x28, 0x3d, 0xee, 0x88, 0xf2, 0x95, 0x83, 0x4c, 0x4c, 0x07, 0x7d, 0x78, 0x8f, 0x15, 0x11, 0x25 },
+  { 0x28, 0x4c, 0xa6, 0x1b, 0x24, 0x07, 0xbd, 0xba, 0x39, 0x38, 0x04, 0x8b, 0x0a, 0x55, 0x90, 0x15 },
+  { 0x28, 0x54, 0xe5, 0xdf, 0xb8, 0x41, 0x73, 0xfa, 0xfc, 0x5b, 0xf4, 0x85, 0xc3, 0xe6, 0x9d, 0x5a },
+  { 0x28, 0x80, 0xc6, 0xb5, 0x9b, 0xd5, 0x4b, 0x15, 0x31, 0x74, 0x67, 0x6e, 0x46, 0x51, 0x67, 0xc7 },
+  { 0x28, 0xa2, 0xbe, 0xa8, 0xf8, 0x49, 0x36, 0xcb, 0x2e, 0x06, 0x3f, 0x85, 0x74, 0x14, 0xcd, 0xa0 },
+  { 0x28, 0xa4, 0xcd, 0x87, 0xfb, 0x9d, 0xe4, 0xee, 0x91, 0x69, 0x3a, 0x38, 0x61, 0x1c, 0xb5, 0x3c },
+  { 0x28, 0xd5, 0xdf, 0x3e, 0xd0, 0x36, 0xed, 0x63, 0xd3, 0x3a, 0x31, 0xd0, 0xd8, 0xb8, 0x5c, 0x47 },
+  { 0x29, 0x03, 0x89, 0x6d, 0x88, 0xa3, 0x41, 0x51, 0x15, 0x86, 0xd6, 0x9f, 0xcf, 0xc2, 0x0f, 0x7d },
+  { 0x29, 0x1b, 0xcd, 0xb0, 0x5f, 0x2b, 0x37, 0xcd, 0xf9, 0x45, 0x2d, 0x2b, 0xf0, 0x8e, 0x03, 0x21 },
+  { 0x29, 0x1c, 0xc3, 0x76, 0x04, 0xbc, 0x89, 0x9e, 0x8e, 0x06, 0x5c, 0x30, 0x15, 0x3f, 0xc4, 0xb9 },
+  { 0x29, 0x1d, 0xd4, 0x75, 0x88, 0xb9, 0x15, 0x8b, 0xee, 0xbe, 0x4a, 0xcc, 0xc3, 0xa0, 0x93, 0xa6 },
+  { 0x29, 0x2a, 0x0b, 0xb9, 0x75, 0xb2, 0x58, 0x7f, 0x9a, 0xc7, 0x84, 0xc9, 0x60, 0xe1, 0xb4, 0x53 },
+  { 0x29, 0x2f, 0x24, 0x46, 0xa0, 0x32, 0x5b, 0x7b, 0x42, 0x3e, 0x88, 0xa2, 0xeb, 0xfe, 0xb5, 0xa0 },
+  { 0x29, 0x39, 0x6d, 0xb5, 0x84, 0x06, 0x08, 0x4e, 0x41, 0x60, 0x32, 0xc3, 0x72, 0x73, 0x4a, 0x3e },
+  { 0x29, 0x42, 0x68, 0x0c, 0x47, 0xbe, 0xb9, 0xbf, 0x71, 0x3a, 0x91, 0x07, 0x06, 0xff, 0xab, 0xfe },
+  { 0x29, 0x47, 0x62, 0x00, 0x0e, 0x85, 0x3b, 0x43, 0x19, 0xf9, 0x99, 0x1c, 0x1c, 0xed, 0x5d, 0xfc },
+  { 0x29, 0x5f, 0x36, 0x79, 0xbd, 0xf9, 0x1c, 0xa5, 0xe3, 0x7d, 0xa3, 0xf7, 0x87, 0xb2, 0x99, 0x97 },
+  { 0x29, 0x63, 0x0a, 0x20, 0xd3, 0x56, 0xfb, 0x58, 0x68, 0x5b, 0x15, 0x0b, 0xfa, 0x8f, 0x00, 0xc3 },
+  { 0x29, 0x72, 0x36, 0xcb, 0x91, 0x56, 0xbe, 0x35, 0x67, 0x9f, 0x83, 0xc4, 0xe3, 0x8e, 0xe1, 0x69 },
+  { 0x29, 0x7c, 0x40, 0x5a, 0xfd, 0x01, 0xf3, 0xac, 0x48, 0xcd, 0xb6, 0x7b, 0x00, 0xd2, 0x73, 0xfe },
+  { 0x29, 0x82, 0xe6, 0x55, 0xdf, 0xfc, 0x89, 0xd2, 0x18, 0xa0, 0xa3, 0x07, 0x2c, 0xfc, 0x68, 0x11 },
+  { 0x29, 0x83, 0x87, 0xb0, 0x63, 0x71, 0x73, 0xd2, 0x00, 0x27, 0x70, 0xa6, 0x49, 0xb4, 0xfb, 0xca },
+  { 0x29, 0x84, 0x3f, 0x43, 0xb8, 0x1f, 0x37, 0x36, 0xbf, 0x35, 0xc0, 0x0b, 0x1b, 0xb8, 0x8f, 0xb2 },
+  { 0x29, 0x94, 0x9f, 0x89, 0x3e, 0xf6, 0xcb, 0x9e, 0x8e, 0xcb, 0x36, 0x8b, 0x9e, 0x99, 0xee, 0xe4 },
+  { 0x29, 0xdf, 0xa2, 0x6b, 0x79, 0x88, 0xaf, 0x99, 0x84, 0xd6, 0x17, 0x70, 0x8e, 0x4f, 0xc6, 0xe2 },
+  { 0x2a, 0x0b, 0xa5, 0x5e, 0x56, 0xe7, 0xa5, 0x96, 0x14, 0x6f, 0xa7, 0x29, 0xac, 0xf0, 0xe1, 0x09 },
+  { 0x2a, 0x10, 0x05, 0x3f, 0xd0, 0x86, 0x64, 0xc7, 0xcf, 0xbb, 0xb1, 0x04, 0x38, 0x6e, 0xd7, 0x7f },
+  { 0x2a, 0x1b, 0x45, 0x4a, 0x5c, 0x38, 0x32, 0xb0, 0x24, 0x01, 0x11, 0xe7, 0xfd, 0x73, 0xde, 0x8a },
+  { 0x2a, 0x2f, 0x46, 0xb3, 0xf4, 0x00, 0x04, 0x95, 0x23, 0x9c, 0xbd, 0xad, 0x70, 0xf1, 0x7c, 0x59 },
+  { 0x2a, 0x33, 0xe2, 0x14, 0x47, 0xbf, 0x9e, 0x13, 0xdc, 0xfe, 0xd8, 0x50, 0x77, 0xff, 0x6b, 0x40 },
+  { 0x2a, 0x36, 0x0b, 0xc8, 0x5b, 0xf2, 0x2d, 0xe4, 0x38, 0x65, 0x1c, 0xf9, 0x2f, 0xfd, 0xa1, 0xde },
+  { 0x2a, 0x9f, 0x90, 0x01, 0x54, 0x0c, 0x55, 0xa3, 0x02, 0xbe, 0xfd, 0x8e, 0x9d, 0x54, 0xb4, 0x7b },
+  { 0x2a, 0xa5, 0xe5, 0x6d, 0x36, 0xc2, 0xe5, 0x8b, 0x6f, 0x28, 0x56, 0x10, 0x9f, 0x20, 0x99, 0xa9 },
+  { 0x2a, 0xba, 0x6a, 0x1b, 0x01, 0xa5, 0x85, 0x9e, 0x96, 0xd6, 0xa6, 0x6d, 0x22, 0x86, 0x77, 0x2f },
+  { 0x2a, 0xbc, 0x3d, 0x46, 0xb3, 0xf2, 0x14, 0x01, 0x60, 0x75, 0x9e, 0x2e, 0x10, 0xbc, 0x86, 0xd9 },
+  { 0x2a, 0xc3, 0xa0, 0x8c, 0xfb, 0xf1, 0x94, 0x2b, 0xa1, 0x69, 0xc3, 0xe9, 0xe6, 0xc4, 0x7e, 0x09 },
+  { 0x2a, 0xe7, 0x00, 0xc9, 0xdb, 0xa8, 0x43, 0xa6, 0x8d, 0xfd, 0xca, 0x40, 0xd7, 0xd8, 0x6b, 0xd6 },
+  { 0x2a, 0xee, 0xdc, 0xc6, 0xeb, 0x16, 0x02, 0xef, 0xb7, 0x71, 0x61, 0xb0, 0xce, 0xf8, 0x32, 0xab },
+  { 0x2b, 0x15, 0x89, 0xc7, 0xe1, 0xf3, 0x94, 0xae, 0x6a, 0x1c, 0x04, 0x69, 0x44, 0xf0, 0x66, 0x88 },
+  { 0x2b, 0x27, 0xeb, 0x19, 0x4e, 0x13, 0xf3, 0xb3, 0x8d, 0x23, 0xc8, 0x79, 0xcc, 0x1e, 0x3a, 0xbf },
+  { 0x2b, 0x42, 0xda, 0x79, 0xa6, 0x82, 0xed, 0x6e, 0x2d, 0x73, 0x5f, 0xac, 0xbf, 0x70, 0x10, 0x7e },
+  { 0x2b, 0x43, 0x0c, 0x00, 0xdc, 0x79, 0xe4, 0x95, 0x76, 0x2a, 0xc5, 0x9b, 0x2f, 0x9b, 0x4f, 0xcd },
+  { 0x2b, 0x71, 0xa5, 0x9a, 0x53, 0xbe, 0x58, 0x83, 0x39, 0x99, 0x17, 0xbf, 0x58, 0x2b, 0x77, 0x72 },
+  { 0x2b, 0xa0, 0x2f, 0x50, 0x9a, 0x49, 0x91, 0xaa, 0x17, 0x6b, 0xa8, 0xd9, 0xe5, 0x40, 0xdf, 0x3d },
+  { 0x2b, 0xb0, 0xa1, 0xf1, 0xde, 0xe5, 0x22, 0x6d, 0xe6, 0x48, 0xeb, 0x5f, 0x1c, 0x97, 0xf0, 0x67 },
+  { 0x2b, 0xb9, 0xf4, 0x68, 0x6f, 0x7e, 0x08, 0xc5, 0xfc, 0xc6, 0x9e, 0xc1, 0xa1, 0xc6, 0x6f, 0xe7 },
+  { 0x2b, 0xc2, 0x66, 0x19, 0xe3, 0x17, 0x10, 0xa9, 0x88, 0x4c, 0x11, 0x0d, 0x84, 0x30, 0xc1, 0xda },
+  { 0x2b, 0xc6, 0xc5, 0x3b, 0x19, 0xe0, 0x09, 0x7a, 0x24, 0x2f, 0x22, 0x37, 0x5a, 0x6a, 0x60, 0xff },
+  { 0x2b, 0xee, 0x7f, 0x22, 0x6d, 0x50, 0x6c, 0x21, 0x71, 0x63, 0xba, 0xd4, 0xab, 0x17, 0x68, 0xc0 },
+  { 0x2b, 0xf3, 0x4b, 0x6a, 0xd7, 0xd2, 0x31, 0x7a, 0x2d, 0x08, 0x08, 0xb3, 0xfb, 0x93, 0x57, 0x1b },
+  { 0x2c, 0x0d, 0xc8, 0x85, 0xd5, 0xed, 0xe9, 0x4a, 0xa6, 0x64, 0xbf, 0x30, 0x81, 0xad, 0xd3, 0x4e },
+  { 0x2c, 0x29, 0x18, 0x2e, 0xdf, 0x09, 0x65, 0xa7, 0xf5, 0x6f, 0xe0, 0x89, 0x7d, 0x2f, 0x84, 0xba },
+  { 0x2c, 0x2a, 0xea, 0x31, 0xb0, 0x1c, 0x61, 0x26, 0xc1, 0xa4, 0x3e, 0x10, 0xca, 0xcb, 0xfd, 0x58 },
+  { 0x2c, 0x3b, 0x28, 0x43, 0x29, 0x5c, 0x9d, 0x6b, 0x16, 0x99, 0x69, 0x71, 0x18, 0x0a, 0x3f, 0xe9 },
+  { 0x2c, 0x3b, 0x9c, 0x17, 0x1e, 0x21, 0x4e, 0x9e, 0x46, 0xbb, 0xaa, 0x12, 0xbd, 0xf8, 0x97, 0x7e },
+  { 0x2c, 0x45, 0xc3, 0xeb, 0x81, 0x9a, 0x79, 0x72, 0x37, 0x82, 0x0a, 0x18, 0x16, 0xc5, 0x32, 0xeb },
+  { 0x2c, 0x88, 0x35, 0xae, 0xd7, 0xf5, 0x2a, 0x0d, 0xa9, 0xad, 0xe5, 0x22, 0x6e, 0xe5, 0xaa, 0x75 },
+  { 0x2c, 0x8c, 0x11, 0x29, 0x5d, 0x86, 0x13, 0xf8, 0x75, 0xb7, 0xbc, 0xf5, 0x25, 0x3a, 0xb9, 0xbb },
+  { 0x2c, 0x9f, 0xad, 0xd5, 0x10, 0x50, 0x9c, 0xc7, 0xf2, 0x8f, 0x1c, 0xcb, 0xa9, 0x31, 0x85, 0x5f },
+  { 0x2c, 0xa6, 0x44, 0x52, 0x04, 0xff, 0xb7, 0x68, 0x6d, 0xde, 0xe3, 0xe3, 0x3b, 0xa6, 0x4d, 0x5b },
+  { 0x2c, 0xb4, 0x2c, 0xf6, 0x2b, 0x2f, 0x25, 0xf5, 0x9f, 0x90, 0x9b, 0x54, 0x47, 0x82, 0x1b, 0x14 },
+  { 0x2c, 0xcc, 0xc0, 0x79, 0xc1, 0x5e, 0x9a, 0xf9, 0x42, 0x46, 0xf8, 0x67, 0xff, 0xc7, 0xe9, 0xbf },
+  { 0x2c, 0xef, 0xa6, 0x95, 0xdf, 0x2e, 0xd0, 0x20, 0x89, 0x9a, 0x7d, 0xf7, 0xbb, 0x1e, 0x3a, 0x95 },
+  { 0x2c, 0xf2, 0x0f, 0x82, 0xab, 0xca, 0xe2, 0xde, 0xcf, 0xf8, 0x8d, 0xb9, 0x93, 0x31, 0xe0, 0x71 },
+  { 0x2c, 0xfb, 0x18, 0x8c, 0x10, 0x91, 0xcc, 0x7e, 0xc2, 0xa7, 0xe6, 0x00, 0x64, 0xd2, 0xa7, 0x58 },
+  { 0x2d, 0x15, 0xb0, 0x92, 0xe8, 0x35, 0x09, 0x12, 0xec, 0x4b, 0x2e, 0x5e, 0x75, 0x0f, 0xa1, 0xc6 },
+  { 0x2d, 0x16, 0xa8, 0xb5, 0x9a, 0x22, 0x5e, 0xa5, 0x51, 0x66, 0x7b, 0xe4, 0x5f, 0x55, 0x46, 0x52 },
+  { 0x2d, 0x1c, 0xf8, 0x5f, 0xbc, 0x73, 0x28, 0x56, 0xbf, 0x76, 0x47, 0x0c, 0xd4, 0x06, 0x0f, 0x4a },
+  { 0x2d, 0x2c, 0x5f, 0x07, 0x61, 0xe6, 0x09, 0xe3, 0xc5, 0x22, 0x87, 0x66, 0xf4, 0x46, 0xf7, 0xf8 },
+  { 0x2d, 0x40, 0x5d, 0xa7, 0x0a, 0xf8, 0x2b, 0x20, 0xa6, 0xb3, 0xec, 0xc3, 0xd1, 0xd2, 0xc4, 0xec },
+  { 0x2d, 0x67, 0x41, 0xcd, 0xa3, 0x00, 0x02, 0x30, 0xf6, 0xbb, 0xdd, 0x5e, 0x31, 0x94, 0x1c, 0x01 },
+  { 0x2d, 0x69, 0xa5, 0xf2, 0x37, 0x84, 0xf1, 0xc2, 0x23, 0x01, 0x43, 0x29, 0x2a, 0x07, 0x3b, 0x53 },
+  { 0x2d, 0x6d, 0xa0, 0xeb, 0x85, 0xea, 0xbc, 0x93, 0x27, 0x0e, 0x5b, 0xb8, 0xa4, 0x66, 0xca, 0x51 },
+  { 0x2d, 0x76, 0xc5, 0xd1, 0xaa, 0xd5, 0x06, 0x44, 0x2b, 0x9e, 0x9f, 0xb6, 0x77, 0x65, 0xe0, 0x51 },
+  { 0x2d, 0x9e, 0x5d, 0x8d, 0x08, 0x3b, 0x63, 0x67, 0xed, 0xa8, 0x80, 0xe8, 0x0d, 0xfd, 0xfa, 0xeb },
+  { 0x2d, 0x9e, 0x65, 0x95, 0x98, 0x08, 0xa6, 0x09, 0x8c, 0x16, 0xc8, 0x2a, 0x59, 0xc9, 0xd9, 0xdc },
+  { 0x2d, 0xbc, 0x92, 0x68, 0x8f, 0x9b, 0xa9, 0x2a, 0x7e, 0x08, 0x6d, 0x62, 0xbe, 0x9d, 0xf7, 0x9d },
+  { 0x2d, 0xbd, 0xca, 0x30, 0x58, 0x03, 0x5d, 0x2b, 0x40, 0xc7, 0x34, 0xdc, 0xf0, 0x6a, 0x86, 0xd9 },
+  { 0x2d, 0xcf, 0x9c, 0xe4, 0x86, 0x39, 0x3c, 0xd3, 0x6c, 0xa0, 0x92, 0x8c, 0xd5, 0x3b, 0x96, 0xcb },
+  { 0x2d, 0xe4, 0x1a, 0x11, 0xc6, 0x76, 0x7e, 0x54, 0xa5, 0xee, 0x9e, 0xba, 0xff, 0xec, 0x72, 0xaf },
+  { 0x2d, 0xfe, 0xc1, 0x61, 0x5c, 0x49, 0x50, 0x1f, 0xef, 0xc0, 0x21, 0x65, 0xc8, 0x19, 0x55, 0xe6 },
+  { 0x2e, 0x0a, 0xed, 0x5b, 0xb6, 0x19, 0xed, 0xce, 0xfa, 0x3f, 0xaf, 0xb4, 0xfb, 0xe7, 0xc5, 0x51 },
+  { 0x2e, 0x28, 0x85, 0xe6, 0x8f, 0xa1, 0x04, 0x58, 0x71, 0xce, 0x13, 0x82, 0xb6, 0x8f, 0x6e, 0xfc },
+  { 0x2e, 0x2a, 0xce, 0xf8, 0x51, 0x3e, 0xdc, 0xca, 0x99, 0x1e, 0x7e, 0x51, 0x49, 0x41, 0x2e, 0x11 },
+  { 0x2e, 0x37, 0x28, 0xf3, 0x08, 0x6d, 0xc3, 0xe7, 0x10, 0x47, 0xff, 0xd6, 0xb2, 0xd9, 0xf0, 0x15 },
+  { 0x2e, 0x5b, 0x18, 0x4d, 0xa8, 0xa2, 0x7c, 0x4d, 0x36, 0x2b, 0x5a, 0x81, 0xf0, 0xb4, 0xa6, 0x8f },
+  { 0x2e, 0x66, 0x3e, 0xaa, 0x0d, 0x6b, 0x72, 0x3b, 0x64, 0x5e, 0x64, 0x37, 0x50, 0xb9, 0x42, 0xfd },
+  { 0x2e, 0x7e, 0x9c, 0x6d, 0xcf, 0xcc, 0xea, 0xff, 0xc6, 0xfa, 0x73, 0xf0, 0xd0, 0x8a, 0x40, 0x2a },
+  { 0x2e, 0x82, 0xa1, 0x62, 0x8e, 0xf6, 0xc7, 0x35, 0xc0, 0xab, 0x8f, 0xa9, 0x29, 0x27, 0xe9, 0xb0 },
+  { 0x2e, 0x84, 0x2c, 0x2e, 0xe2, 0x2e, 0x9d, 0xad, 0x9d, 0xf1, 0x6e, 0xed, 0x09, 0x13, 0x15, 0xc4 },
+  { 0x2e, 0xaf, 0x8f, 0xa9, 0xe9, 0xfd, 0xf1, 0xfc, 0xfc, 0x89, 0x69, 0x26, 0xa4, 0xbd, 0xbf, 0x85 },
+  { 0x2e, 0xc6, 0xb0, 0x45, 0xcf, 0xd7, 0xbc, 0x52, 0xd9, 0xcd, 0xfd, 0x1b, 0x14, 0x47, 0xd1, 0xe5 },
+  { 0x2e, 0xda, 0x6a, 0x49, 0xa4, 0x9f, 0xcb, 0x2b, 0x67, 0x4e, 0xa9, 0xe1, 0x60, 0xb6, 0xa6, 0x17 },
+  { 0x2e, 0xf3, 0x63, 0x41, 0xd1, 0xbf, 0x42, 0xe0, 0x2c, 0x7e, 0xa2, 0xf7, 0x1e, 0x02, 0x49, 0x82 },
+  { 0x2f, 0x05, 0x46, 0xc4, 0xd2, 0x38, 0x55, 0x1c, 0x7d, 0x64, 0xd8, 0x84, 0xb6, 0x18, 0x10, 0x0c },
+  { 0x2f, 0x0a, 0x8b, 0xb4, 0xe1, 0x88, 0x39, 0xf9, 0xb1, 0xdc, 0xaa, 0x2f, 0x5d, 0x02, 0xfd, 0x1d },
+  { 0x2f, 0x11, 0xba, 0x54, 0x60, 0x97, 0x77, 0xe2, 0xc6, 0xa5, 0xda, 0x9b, 0x30, 0x2c, 0x98, 0xe8 },
+  { 0x2f, 0x16, 0x66, 0x3b, 0x01, 0x59, 0x15, 0x39, 0x62, 0x4d, 0x0e, 0xf5, 0x29, 0x34, 0xa1, 0x7d },
+  { 0x2f, 0x2f, 0x90, 0x61, 0x39, 0x8a, 0x74, 0xc8, 0x04, 0x20, 0xb9, 0x9d, 0xde, 0xcf, 0x64, 0x48 },
+  { 0x2f, 0x66, 0xeb, 0xf0, 0x37, 0x32, 0x1e, 0xd0, 0x44, 0x2a, 0xc4, 0xb8, 0x9c, 0xe2, 0x26, 0x33 },
+  { 0x2f, 0x77, 0x72, 0x87, 0x9a, 0x1e, 0xd0, 0x4f, 0x66, 0x0a, 0xa9, 0xd7, 0x7a, 0x86, 0xa4, 0xbd },
+  { 0x2f, 0x77, 0xf0, 0x15, 0xfc, 0x88, 0x0b, 0x05, 0xf2, 0x8e, 0x84, 0x15, 0x6f, 0x98, 0x9a, 0x0c },
+  { 0x2f, 0x79, 0x49, 0xf7, 0x10, 0x76, 0xdb, 0x42, 0x48, 0x0d, 0x3f, 0x50, 0x36, 0xb4, 0xa3, 0x32 },
+  { 0x2f, 0xac, 0xd4, 0x60, 0xa6, 0x82, 0x8e, 0x0e, 0x47, 0x6d, 0x3a, 0xc4, 0xb8, 0xc5, 0xf4, 0xf7 },
+  { 0x30, 0x25, 0xbd, 0xc3, 0x0b, 0x5a, 0xec, 0x9f, 0xb4, 0x06, 0x68, 0x78, 0x7f, 0x67, 0xd2, 0x4c },
+  { 0x30, 0x32, 0x42, 0xc2, 0x39, 0x47, 0x4f, 0x2d, 0x77, 0x63, 0xb8, 0x43, 0xde, 0x58, 0xc1, 0xc3 },
+  { 0x30, 0x45, 0x12, 0x52, 0x8a, 0x55, 0x30, 0xa9, 0x36, 0x1e, 0x8a, 0x23, 0x1e, 0xd9, 0xa6, 0xde },
+  { 0x30, 0x51, 0x2e, 0x0e, 0x83, 0x90, 0x3f, 0xc0, 0x55, 0x41, 0xd2, 0xf6, 0xa6, 0xa6, 0x26, 0x54 },
+  { 0x30, 0x51, 0x6c, 0xfb, 0xaa, 0x1b, 0xc3, 0xb5, 0x33, 0x5e, 0xe5, 0x3a, 0xd8, 0x11, 0xf1, 0x7a },
+  { 0x30, 0x51, 0xb6, 0x07, 0x1c, 0xb2, 0x63, 0x77, 0xcd, 0x42, 0x8a, 0xf1, 0x55, 0xe1, 0xbf, 0xc4 },
+  { 0x30, 0x68, 0x5b, 0x9b, 0x6e, 0xbd, 0x9b, 0xa7, 0x15, 0x36, 0xdd, 0x76, 0x32, 0xa1, 0xe3, 0xb6 },
+  { 0x30, 0x91, 0xaf, 0x0e, 0xf1, 0xa6, 0x1e, 0x80, 0x1f, 0x48, 0x67, 0x78, 0x3c, 0x21, 0xd4, 0x5c },
+  { 0x30, 0x99, 0x70, 0x31, 0xb6, 0x68, 0xe3, 0x71, 0x68, 0xd4, 0xd0, 0xe2, 0x99, 0xcc, 0xc4, 0x6f },
+  { 0x30, 0xc9, 0x2c, 0x68, 0x52, 0x24, 0xdc, 0x7a, 0x72, 0xb9, 0xbb, 0xe5, 0xeb, 0x62, 0xd0, 0x04 },
+  { 0x30, 0xe0, 0x12, 0xe8, 0xd5, 0x03, 0x30, 0xc8, 0x97, 0x2f, 0x12, 0x6b, 0x8e, 0x91, 0x3b, 0xc4 },
+  { 0x30, 0xe0, 0xab, 0x8b, 0xe7, 0x13, 0x20, 0x8a, 0xe9, 0xa9, 0x78, 0xb3, 0x4e, 0x9e, 0x8e, 0x8c },
+  { 0x30, 0xf0, 0xb4, 0x96, 0x61, 0xcf, 0xcf, 0xd4, 0xec, 0x63, 0x39, 0x5f, 0xab, 0x83, 0x7d, 0xc3 },
+  { 0x31, 0x05, 0x96, 0x7f, 0x72, 0x22, 0xcc, 0x36, 0xa5, 0xac, 0x6e, 0x5f, 0x6e, 0x89, 0xa0, 0xb4 },
+  { 0x31, 0x0b, 0xa3, 0x0e, 0x25, 0xea, 0x89, 0x57, 0xe5, 0x81, 0x80, 0xb6, 0x63, 0x50, 0x3c, 0x0c },
+  { 0x31, 0x32, 0x43, 0xfc, 0x41, 0xe4, 0x9e, 0xf6, 0xbd, 0x3a, 0xa9, 0xeb, 0xc0, 0xd3, 0x72, 0xdd },
+  { 0x31, 0x51, 0x2c, 0xdf, 0xad, 0xfd, 0x82, 0xbf, 0xb6, 0xf1, 0x96, 0xe3, 0xb0, 0xfd, 0x83, 0xcd },
+  { 0x31, 0x77, 0xcc, 0x5c, 0x04, 0xc1, 0xa4, 0x08, 0x0a, 0x92, 0x7d, 0xfa, 0x40, 0x99, 0x48, 0x2b },
+  { 0x31, 0x7a, 0x4c, 0xdb, 0xab, 0x09, 0x0d, 0xcc, 0x99, 0x68, 0x33, 0xd0, 0x7c, 0xb4, 0x01, 0x65 },
+  { 0x31, 0x80, 0x46, 0xae, 0x37, 0x11, 0xc0, 0x5f, 0xd1, 0x6e, 0x47, 0x9b, 0x29, 0x8e, 0x5f, 0xcc },
+  { 0x31, 0x8a, 0x9d, 0x6d, 0xda, 0x79, 0x12, 0x68, 0xdf, 0x92, 0xd7, 0x26, 0x79, 0x91, 0x4a, 0xc3 },
+  { 0x31, 0x9a, 0x14, 0x2a, 0xab, 0x62, 0x60, 0x84, 0x2a, 0xb6, 0x16, 0x38, 0x28, 0x48, 0xc2, 0x04 },
+  { 0x31, 0xbb, 0x9b, 0x8c, 0xee, 0xd4, 0x6c, 0xb3, 0xe5, 0x06, 0x77, 0x7a, 0x9e, 0x65, 0xf3, 0xce },
+  { 0x31, 0xc5, 0xfd, 0x55, 0xa3, 0x9d, 0xb5, 0xff, 0x30, 0xa0, 0xda, 0x06, 0x5f, 0x86, 0xc1, 0x40 },
+  { 0x31, 0xd0, 0x8c, 0xb4, 0x65, 0x96, 0x5f, 0x80, 0xd3, 0x54, 0x1a, 0x57, 0xec, 0x82, 0xc6, 0x25 },
+  { 0x31, 0xdf, 0x1c, 0x50, 0xc4, 0x35, 0x1e, 0x14, 0x4c, 0x9a, 0x37, 0x8a, 0xdb, 0x8c, 0x10, 0xba },
+  { 0x31, 0xe5, 0x18, 0xde, 0xbb, 0xa4, 0x6d, 0xf6, 0x22, 0x6b, 0x53, 0x5f, 0xa8, 0xbd, 0x25, 0x43 },
+  { 0x31, 0xf4, 0x69, 0x2e, 0xe2, 0xca, 0x07, 0xa7, 0xce, 0x1f, 0x7a, 0x6a, 0x1d, 0xab, 0x4a, 0xc9 },
+  { 0x31, 0xfc, 0xbc, 0xe1, 0xcf, 0xa6, 0xec, 0x9f, 0x5b, 0x6d, 0xe3, 0x18, 0xe1, 0xf5, 0x76, 0x47 },
+  { 0x32, 0x19, 0x92, 0x71, 0xdc, 0x98, 0x0e, 0xb3, 0x1a, 0x2c, 0xc9, 0x6e, 0x10, 0xa9, 0xe2, 0x44 },
+  { 0x32, 0x1c, 0x34, 0x51, 0x12, 0x93, 0x57, 0xaf, 0x42, 0xa3, 0x75, 0xd1, 0x2a, 0xfd, 0x44, 0x50 },
+  { 0x32, 0x24, 0x4e, 0x55, 0xce, 0x6e, 0xc6, 0xbf, 0xbd, 0x76, 0x3f, 0x33, 0x38, 0x4b, 0xdc, 0x2e },
+  { 0x32, 0x25, 0x67, 0x6f, 0x5c, 0x0c, 0x57, 0x7a, 0xec, 0xcf, 0xaa, 0x7e, 0x6b, 0xed, 0xd7, 0x65 },
+  { 0x32, 0x2b, 0x29, 0xe8, 0x44, 0x55, 0xaa, 0x41, 0xe7, 0xcc, 0x9a, 0xf4, 0x63, 0xbf, 0xfa, 0x89 },
+  { 0x32, 0x4c, 0xb4, 0xa7, 0x49, 0xbc, 0xac, 0x4f, 0x3d, 0xb9, 0xda, 0x84, 0x2b, 0x85, 0xd2, 0xf7 },
+  { 0x32, 0x74, 0x68, 0xd6, 0xc1, 0x96, 0x97, 0xe6, 0x5a, 0xb7, 0x02, 0xf0, 0x65, 0x02, 0xc7, 0xed },
+  { 0x32, 0x76, 0xc7, 0x77, 0xcb, 0xe9, 0x7c, 0xdd, 0x2b, 0x4a, 0x63, 0xff, 0xc1, 0x6b, 0x71, 0x51 },
+  { 0x32, 0x78, 0x15, 0x8e, 0x5c, 0x1f, 0x7e, 0xb5, 0xc5, 0xd2, 0x8c, 0xcf, 0xd7, 0x28, 0x52, 0x50 },
+  { 0x32, 0x7f, 0xe8, 0xcf, 0x94, 0xf3, 0xa4, 0x5c, 0x35, 0xa8, 0x40, 0xa4, 0x53, 0xdf, 0x12, 0x35 },
+  { 0x32, 0x89, 0x49, 0x87, 0x2e, 0x45, 0x41, 0x81, 0x22, 0x3a, 0x80, 0x38, 0x9d, 0x03, 0xc1, 0x22 },
+  { 0x32, 0xae, 0x78, 0xab, 0xbb, 0x5e, 0x67, 0x7e, 0x2a, 0xab, 0xae, 0x5c, 0xc8, 0x6c, 0xec, 0x29 },
+  { 0x32, 0xd1, 0x26, 0x0e, 0xa6, 0x82, 0xe1, 0xbb, 0x10, 0x85, 0x0f, 0xa9, 0x4c, 0x04, 0xec, 0x5f },
+  { 0x32, 0xdc, 0xd1, 0xb5, 0x35, 0xf5, 0x64, 0xee, 0x38, 0x14, 0x3a, 0x70, 0xa8, 0x14, 0x6e, 0xfe },
+  { 0x32, 0xe6, 0x5d, 0x1e, 0x4d, 0xfc, 0xbc, 0xd9, 0xb5, 0x7f, 0xee, 0x72, 0xca, 0xfe, 0x07, 0x4c },
+  { 0x32, 0xec, 0xb5, 0xa6, 0x52, 0xeb, 0x73, 0xd2, 0x87, 0xe8, 0x83, 0xee, 0xa7, 0x51, 0xd9, 0x9c },
+  { 0x32, 0xf4, 0xe4, 0x7a, 0x71, 0x60, 0x1a, 0xb0, 0x6c, 0xfb, 0x59, 0xe1, 0xc6, 0xa0, 0xb8, 0x46 },
+  { 0x33, 0x16, 0xee, 0x2f, 0x88, 0x7e, 0x9c, 0xb9, 0xb5, 0x4d, 0xd2, 0x3c, 0x5b, 0x98, 0xc3, 0xe2 },
+  { 0x33, 0x19, 0x38, 0x98, 0x9f, 0x0f, 0x33, 0xca, 0x39, 0xc1, 0x0a, 0xf4, 0xc0, 0x9f, 0xf6, 0x40 },
+  { 0x33, 0x2f, 0x01, 0xfd, 0x18, 0xe9, 0x9c, 0x65, 0x84, 0xf6, 0x1a, 0xa4, 0x5e, 0xe7, 0x79, 0x1e },
+  { 0x33, 0x47, 0xa6, 0xdd, 0x59, 0x04, 0x9b, 0x15, 0xa3, 0x83, 0x94, 0xaa, 0x2d, 0xaf, 0xa5, 0x85 },
+  { 0x33, 0x57, 0x93, 0x73, 0x6c, 0xbf, 0x6f, 0xc9, 0x9c, 0x93, 0x59, 0xed, 0x2a, 0x32, 0xa4, 0x9d },
+  { 0x33, 0x5a, 0x7c, 0x5c, 0xfa, 0x6f, 0xee, 0x0f, 0x35, 0xf5, 0x82, 0x4d, 0x1f, 0xa0, 0x9a, 0xed },
+  { 0x33, 0x67, 0xee, 0xba, 0x32, 0x69, 0xaa, 0x04, 0x72, 0x0a, 0xbe, 0x61, 0x69, 0x76, 0x75, 0x02 },
+  { 0x33, 0x91, 0xf7, 0xc4, 0xc6, 0x56, 0x79, 0x3f, 0x92, 0x29, 0x9f, 0x41, 0x87, 0xe1, 0x39, 0xf7 },
+  { 0x33, 0xca, 0xc5, 0xe7, 0x67, 0xa5, 0x34, 0xc9, 0x5d, 0x29, 0x2b, 0x04, 0xf4, 0x39, 0xdc, 0x37 },
+  { 0x33, 0xd6, 0x8c, 0x3c, 0xd7, 0x4e, 0x5b, 0xc4, 0xcf, 0x0d, 0xf3, 0x71, 0x6c, 0x58, 0x48, 0xbc },
+  { 0x33, 0xed, 0x6d, 0xfa, 0xc4, 0xb9, 0xea, 0x2f, 0x81, 0xf7, 0x78, 0xce, 0xdd, 0xbb, 0x4a, 0x75 },
+  { 0x34, 0x0f, 0x54, 0x6d, 0x59, 0xe7, 0x2f, 0xb3, 0x58, 0xc4, 0x9a, 0xc2, 0xca, 0x84, 0x82, 0xbb },
+  { 0x34, 0x34, 0x0c, 0x8e, 0xec, 0xd1, 0xe5, 0x57, 0x31, 0x47, 0x89, 0xcc, 0x64, 0x77, 0xe6, 0x50 },
+  { 0x34, 0x54, 0x88, 0xd3, 0xb0, 0x14, 0xb6, 0x84, 0xa1, 0x81, 0x10, 0x8f, 0x0e, 0xf8, 0x23, 0xcb },
+  { 0x34, 0x57, 0x58, 0x74, 0x7b, 0x89, 0x3e, 0x4c, 0x9b, 0xdd, 0xe8, 0x87, 0x7d, 0xe4, 0x77, 0x88 },
+  { 0x34, 0x57, 0x69, 0xd0, 0x85, 0x11, 0x3d, 0x57, 0x93, 0x71, 0x98, 0x26, 0x2a, 0xf5, 0x22, 0x98 },
+  { 0x34, 0x65, 0x55, 0x77, 0x9a, 0x2d, 0x51, 0xb4, 0x88, 0x33, 0x46, 0x3b, 0x54, 0x33, 0x47, 0x2f },
+  { 0x34, 0x86, 0x15, 0xff, 0xa3, 0x0f, 0xab, 0x3c, 0xec, 0x14, 0x41, 0xb5, 0xa7, 0x6e, 0x94, 0x60 },
+  { 0x34, 0xb2, 0x69, 0x38, 0x7f, 0xa1, 0xaa, 0x5a, 0x39, 0x66, 0x36, 0xf5, 0xec, 0xdd, 0x63, 0xdd },
+  { 0x34, 0xc8, 0x08, 0xad, 0x65, 0x77, 0xdb, 0xfa, 0x46, 0x16, 0x9b, 0x73, 0x17, 0x15, 0x85, 0xa3 },
+  { 0x34, 0xca, 0x2f, 0xcb, 0xc8, 0xba, 0x4a, 0x0b, 0x54, 0x4a, 0xcd, 0x94, 0x99, 0x1c, 0xfb, 0x50 },
+  { 0x34, 0xe3, 0x7e, 0xaf, 0xfc, 0x0d, 0x34, 0xe0, 0x5e, 0x40, 0xed, 0x88, 0x3f, 0x84, 0x8b, 0x40 },
+  { 0x34, 0xf4, 0xb1, 0xd8, 0x09, 0xaa, 0x70, 0x5a, 0xce, 0x6e, 0x46, 0xb1, 0x32, 0x53, 0xfd, 0x3b },
+  { 0x34, 0xfd, 0x4f, 0xcb, 0x40, 0xff, 0x5b, 0xab, 0xce, 0x67, 0xf8, 0xb8, 0x06, 0xd5, 0x96, 0x9c },
+  { 0x35, 0x0e, 0x0f, 0x7b, 0x56, 0x2e, 0xc5, 0xe4, 0x57, 0xb3, 0xf5, 0xaf, 0x01, 0x36, 0x48, 0xdb },
+  { 0x35, 0x15, 0x64, 0x07, 0xe5, 0x4f, 0x67, 0xeb, 0x1f, 0x62, 0x54, 0x50, 0xd5, 0xc0, 0x93, 0xe1 },
+  { 0x35, 0x16, 0x3b, 0x56, 0xf4, 0xa6, 0x92, 0xa2, 0x32, 0xae, 0x96, 0xad, 0x3e, 0x23, 0x31, 0x0f },
+  { 0x35, 0x56, 0xe1, 0x25, 0x68, 0x1a, 0xea, 0x86, 0x4e, 0x17, 0xb0, 0x9f, 0x3f, 0x3b, 0x2a, 0x75 },
+  { 0x35, 0x76, 0x03, 0x7c, 0x92, 0x81, 0x65, 0x66, 0x55, 0xfa, 0x11, 0x4a, 0x83, 0x5b, 0xe5, 0x53 },
+  { 0x35, 0x77, 0xe1, 0x97, 0x14, 0x92, 0x19, 0x12, 0x68, 0x5b, 0xb0, 0xe3, 0x2d, 0xdf, 0x94, 0x3c },
+  { 0x35, 0xae, 0x90, 0x3d, 0xff, 0x73, 0x89, 0x75, 0x5a, 0xd4, 0xa0, 0x7f, 0x2f, 0xb7, 0x40, 0x0c },
+  { 0x35, 0xb1, 0x0a, 0x24, 0x8a, 0x7e, 0x67, 0x49, 0x3e, 0xc4, 0x3a, 0xeb, 0x97, 0x43, 0x53, 0x8c },
+  { 0x35, 0xb4, 0x3b, 0x54, 0xe8, 0x34, 0x03, 0xbb, 0x3d, 0x71, 0xf5, 0x19, 0x73, 0x9a, 0x95, 0x49 },
+  { 0x35, 0xbe, 0x55, 0x42, 0x6c, 0x1f, 0xec, 0x32, 0xdf, 0xb5, 0x03, 0xb4, 0xf0, 0x65, 0x15, 0x72 },
+  { 0x35, 0xfa, 0x32, 0x25, 0x69, 0x82, 0x77, 0x4a, 0x4f, 0x13, 0x4c, 0x33, 0x47, 0x88, 0x2d, 0xff },
+  { 0x36, 0x0b, 0xa6, 0x40, 0xf6, 0x81, 0x0e, 0xc9, 0x02, 0xb0, 0x1a, 0x09, 0xcc, 0x8a, 0xb5, 0x56 },
+  { 0x36, 0x0c, 0x0d, 0xcb, 0x11, 0x50, 0x6e, 0x73, 0xbd, 0x0b, 0x77, 0x20, 0x7c, 0x81, 0xbc, 0x62 },
+  { 0x36, 0x19, 0x78, 0x6f, 0x6a, 0x32, 0xef, 0xc1, 0xe4, 0xa2, 0x62, 0xd5, 0xac, 0xa8, 0xa0, 0x70 },
+  { 0x36, 0x24, 0xe5, 0x56, 0x83, 0x68, 0x92, 0x9f, 0xab, 0xb5, 0x5d, 0x7f, 0x9d, 0xf1, 0x02, 0x2e },
+  { 0x36, 0x30, 0x60, 0x70, 0xf0, 0xc9, 0x0a, 0x72, 0x46, 0x15, 0x51, 0xa7, 0xa4, 0xf3, 0xa2, 0x09 },
+  { 0x36, 0x54, 0x7b, 0xc6, 0xfa, 0xa5, 0x13, 0x2b, 0x87, 0x50, 0x4e, 0x18, 0xd0, 0x88, 0xe1, 0xd7 },
+  { 0x36, 0x74, 0x11, 0xb7, 0x81, 0x19, 0x29, 0x92, 0x34, 0x77, 0x2c, 0x08, 0xdf, 0x10, 0xe1, 0x34 },
+  { 0x36, 0x85, 0x06, 0x07, 0x07, 0xdf, 0x27, 0xd4, 0x09, 0x1b, 0xa0, 0xea, 0x2d, 0xc4, 0xb0, 0x59 },
+  { 0x36, 0x8d, 0x88, 0xa6, 0xc0, 0x71, 0xca, 0xba, 0x60, 0xb4, 0xf7, 0x78, 0x61, 0x5a, 0xae, 0x94 },
+  { 0x36, 0xa7, 0x01, 0xc6, 0x0a, 0x9f, 0x97, 0x68, 0xd0, 0x57, 0xbc, 0x2a, 0x83, 0x52, 0x6a, 0x80 },
+  { 0x36, 0xb2, 0x0c, 0x42, 0x79, 0x75, 0x76, 0x0c, 0xb9, 0xcf, 0x4a, 0x47, 0xe4, 0x13, 0x69, 0xe4 },
+  { 0x36, 0xc2, 0x9c, 0xee, 0xe2, 0xc1, 0x51, 0xb2, 0x3a, 0x1a, 0xd7, 0xaa, 0x04, 0xbd, 0x52, 0x9d },
+  { 0x36, 0xc3, 0x1b, 0xb5, 0xda, 0xeb, 0x10, 0x3f, 0x48, 0x8c, 0x66, 0xde, 0x67, 0xac, 0x50, 0x75 },
+  { 0x36, 0xc9, 0x93, 0xdc, 0x32, 0x89, 0x33, 0xe4, 0xdd, 0x63, 0x74, 0xa8, 0xff, 0xe2, 0x24, 0xf4 },
+  { 0x36, 0xe4, 0x7e, 0xd7, 0x49, 0x68, 0xc3, 0x65, 0x12, 0x1e, 0xab, 0x60, 0xf4, 0x8c, 0x65, 0x17 },
+  { 0x36, 0xed, 0xef, 0x44, 0x6a, 0xb4, 0xc2, 0x39, 0x56, 0x66, 0xef, 0xc6, 0x72, 0xb9, 0x2e, 0xd0 },
+  { 0x36, 0xf9, 0xa9, 0x53, 0xeb, 0xdd, 0x9a, 0x8b, 0xe9, 0x7c, 0xcf, 0x27, 0xa2, 0x04, 0x19, 0x03 },
+  { 0x37, 0x25, 0x27, 0x57, 0xa7, 0x9d, 0xc5, 0xb1, 0x74, 0xe3, 0xc0, 0x3d, 0x6e, 0xa0, 0xbd, 0xcb },
+  { 0x37, 0x2b, 0xdd, 0xf1, 0x13, 0xd0, 0x88, 0xbc, 0x57, 0x2f, 0x94, 0xe9, 0x8d, 0x82, 0x49, 0xf5 },
+  { 0x37, 0x3b, 0x8a, 0x08, 0x1a, 0xcd, 0x98, 0xa8, 0x95, 0xdb, 0x0c, 0xb0, 0x2d, 0xf3, 0x56, 0x73 },
+  { 0x37, 0x50, 0xf2, 0x37, 0x52, 0x52, 0xb6, 0xa2, 0x0e, 0x46, 0x28, 0x69, 0x2e, 0x94, 0xe8, 0xb1 },
+  { 0x37, 0x52, 0x79, 0x66, 0x82, 0x3e, 0xe9, 0x24, 0x3d, 0x34, 0xc7, 0xda, 0x83, 0x02, 0x77, 0x4f },
+  { 0x37, 0x69, 0x44, 0x88, 0x9d, 0xcf, 0xa9, 0x6c, 0x73, 0xd3, 0x07, 0x9f, 0x30, 0x8e, 0x3d, 0x32 },
+  { 0x37, 0x83, 0xf1, 0x28, 0x21, 0xb8, 0x8b, 0x08, 0x81, 0x4d, 0xa8, 0xad, 0xb1, 0xa9, 0xf2, 0x20 },
+  { 0x37, 0x8a, 0x62, 0xaf, 0x6e, 0x9c, 0x12, 0xa7, 0x60, 0x79, 0x5f, 0xf4, 0xfc, 0x93, 0x96, 0x56 },
+  { 0x37, 0x8c, 0x11, 0x8b, 0x3b, 0xda, 0x50, 0x2c, 0x73, 0xe7, 0x61, 0x90, 0xca, 0x08, 0x9e, 0xef },
+  { 0x37, 0xab, 0x3a, 0xff, 0xc7, 0x98, 0x79, 0x95, 0x78, 0x4b, 0x59, 0xfc, 0xd3, 0xfc, 0xbd, 0x31 },
+  { 0x37, 0xb9, 0x83, 0x44, 0xc8, 0xe0, 0x74, 0x6c, 0x48, 0x6c, 0xaf, 0x5a, 0xae, 0xec, 0x89, 0x2a },
+  { 0x37, 0xe8, 0x28, 0x67, 0x5d, 0x55, 0x67, 0x75, 0xae, 0x82, 0x85, 0xc0, 0xca, 0xf7, 0xd1, 0x1c },
+  { 0x37, 0xf4, 0x2a, 0xb5, 0x00, 0x18, 0x49, 0x71, 0x14, 0xf6, 0xb0, 0xf4, 0xf0, 0x1a, 0xa9, 0xa1 },
+  { 0x37, 0xfd, 0x7f, 0xa5, 0x2d, 0x35, 0x8f, 0x66, 0x98, 0x49, 0x48, 0x99, 0x9f, 0x12, 0x13, 0xc5 },
+  { 0x38, 0x4d, 0xb9, 0x76, 0x70, 0x81, 0x71, 0x03, 0xdd, 0x8c, 0x0b, 0xbd, 0xef, 0x13, 0x24, 0x45 },
+  { 0x38, 0x4f, 0x5f, 0xbf, 0x57, 0xb5, 0xe9, 0x2e, 0xd7, 0x08, 0x93, 0x5e, 0xbf, 0x8a, 0x86, 0x10 },
+  { 0x38, 0x56, 0xb9, 0x42, 0x5c, 0xc0, 0x18, 0x5e, 0xd7, 0x70, 0x37, 0x6a, 0x62, 0xaf, 0x02, 0x82 },
+  { 0x38, 0x6f, 0xf2, 0x8a, 0xc5, 0xe2, 0x54, 0xba, 0x1b, 0x1b, 0xac, 0x69, 0x16, 0xbc, 0xc9, 0x3a },
+  { 0x38, 0x82, 0x22, 0x4a, 0xdb, 0xd0, 0xca, 0x7c, 0x74, 0x8b, 0x2a, 0x1c, 0x9b, 0x87, 0x26, 0x3e },
+  { 0x38, 0x89, 0x35, 0x1c, 0x6c, 0x21, 0x00, 0xb9, 0xf3, 0xae, 0xf8, 0x17, 0xa7, 0xe1, 0x7a, 0x7a },
+  { 0x38, 0x97, 0x74, 0x4d, 0xd3, 0xc7, 0x56, 0xea, 0x4b, 0x15, 0x42, 0xe5, 0xe1, 0x81, 0xe0, 0x2a },
+  { 0x38, 0xbd, 0x17, 0x2d, 0xa8, 0xb2, 0xa3, 0xa1, 0x76, 0xe5, 0x17, 0xc2, 0x13, 0xfc, 0xd5, 0xa6 },
+  { 0x38, 0xc3, 0x62, 0xdc, 0xd5, 0xca, 0xd5, 0xa6, 0x2e, 0x73, 0xae, 0x52, 0x63, 0x1b, 0xd9, 0xd8 },
+  { 0x38, 0xcf, 0x93, 0xea, 0xcf, 0xb2, 0xfa, 0x9a, 0x2c, 0x5e, 0x39, 0x05, 0x9f, 0xf3, 0x5a, 0x74 },
+  { 0x38, 0xde, 0x7b, 0x68, 0x37, 0x97, 0x70, 0xb9, 0xbd, 0x3f, 0x7b, 0xf0, 0x00, 0x13, 0x6e, 0xb0 },
+  { 0x39, 0x17, 0x64, 0x72, 0x01, 0x40, 0xc4, 0x32, 0xae, 0xc4, 0x54, 0xa4, 0x68, 0xf7, 0x7a, 0x40 },
+  { 0x39, 0x2d, 0x34, 0xc0, 0x49, 0x80, 0x75, 0xdd, 0x58, 0xdf, 0x0c, 0xe7, 0xcd, 0x49, 0x1e, 0xa2 },
+  { 0x39, 0x2f, 0x00, 0xfd, 0x1a, 0x07, 0x4a, 0x3c, 0x15, 0xbc, 0x96, 0xb0, 0xa5, 0x7d, 0x52, 0xa1 },
+  { 0x39, 0x39, 0x48, 0x43, 0x6d, 0x1f, 0x4c, 0xc3, 0x19, 0x24, 0x10, 0xbb, 0x91, 0x8f, 0x97, 0x24 },
+  { 0x39, 0x3e, 0x41, 0xca, 0x8b, 0xdd, 0x35, 0xb5, 0x2b, 0xf6, 0x25, 0x6a, 0x96, 0x8a, 0x9b, 0x89 },
+  { 0x39, 0x47, 0xeb, 0x73, 0x05, 0xb0, 0xc9, 0x04, 0x25, 0x6c, 0xdb, 0xc5, 0xc5, 0x95, 0x6c, 0x0f },
+  { 0x39, 0x6f, 0x7b, 0xc9, 0x0a, 0xb4, 0xfa, 0x49, 0x75, 0xf8, 0xc7, 0x4a, 0xbe, 0x4e, 0x81, 0xf0 },
+  { 0x39, 0x79, 0x0a, 0x2e, 0x90, 0x30, 0x75, 0x1d, 0x7d, 0xb4, 0x14, 0xe1, 0x3f, 0x1b, 0x69, 0x60 },
+  { 0x39, 0xa6, 0xa5, 0xa2, 0xe1, 0xf6, 0x29, 0x7c, 0xce, 0xaa, 0x48, 0xbb, 0x03, 0xaf, 0x02, 0xe9 },
+  { 0x39, 0xb9, 0x4d, 0x41, 0xbd, 0x3b, 0x01, 0xc1, 0x2b, 0x40, 0x54, 0xc1, 0xa8, 0x73, 0x37, 0x83 },
+  { 0x39, 0xc7, 0x8d, 0x68, 0x25, 0x16, 0xd7, 0x91, 0x30, 0xb3, 0x79, 0xfa, 0x9d, 0xeb, 0x8d, 0x1c },
+  { 0x39, 0xd3, 0x63, 0x66, 0xae, 0x7e, 0x6d, 0xfd, 0x53, 0x39, 0x3f, 0xb9, 0xeb, 0xab, 0x02, 0xa0 },
+  { 0x39, 0xda, 0x69, 0xff, 0x98, 0x33, 0xf8, 0xc1, 0x43, 0xf0, 0x3b, 0x6e, 0x0e, 0x7a, 0x99, 0x6b },
+  { 0x39, 0xfe, 0x31, 0x69, 0x52, 0x13, 0x4b, 0x12, 0x77, 0xb6, 0xa8, 0x1a, 0xf8, 0xe0, 0x57, 0x76 },
+  { 0x3a, 0x2e, 0x2d, 0x0c, 0x68, 0x92, 0xaa, 0x14, 0x54, 0x40, 0x83, 0xdf, 0xb7, 0x76, 0x27, 0x82 },
+  { 0x3a, 0x35, 0xd7, 0xf1, 0xdc, 0x2a, 0x33, 0x56, 0x5c, 0x8d, 0xca, 0x52, 0xba, 0xa8, 0x6b, 0xc4 },
+  { 0x3a, 0x51, 0xa6, 0x86, 0x08, 0x48, 0xe3, 0x6e, 0x6d, 0x06, 0xff, 0xe0, 0x1b, 0x71, 0xfb, 0x13 },
+  { 0x3a, 0x52, 0x6e, 0x6a, 0x1f, 0x9f, 0xe9, 0x18, 0xaf, 0x0f, 0x2c, 0xe9, 0x97, 0xdf, 0xea, 0x73 },
+  { 0x3a, 0x53, 0x96, 0x3f, 0x05, 0x3b, 0x22, 0x59, 0x9d, 0xb6, 0xac, 0x96, 0x86, 0xf7, 0x72, 0x2f },
+  { 0x3a, 0x77, 0x18, 0x76, 0xe4, 0xb6, 0x1d, 0x42, 0xe3, 0xa3, 0x89, 0x2a, 0xd8, 0x85, 0xd8, 0x89 },
+  { 0x3a, 0xad, 0x0e, 0xf6, 0x28, 0x85, 0x73, 0x6a, 0x5b, 0x8c, 0x6c, 0xca, 0xc0, 0xdb, 0xe0, 0x0c },
+  { 0x3a, 0xb5, 0xd1, 0x38, 0xe2, 0x6d, 0x88, 0xc8, 0x19, 0x0e, 0x7c, 0xc6, 0x29, 0xa8, 0x94, 0x93 },
+  { 0x3a, 0xc6, 0xc5, 0x0a, 0x8e, 0x62, 0xd4, 0xce, 0x71, 0x59, 0x51, 0x34, 0xcb, 0xd8, 0x03, 0x5e },
+  { 0x3a, 0xd3, 0xdc, 0x79, 0x92, 0x11, 0xcc, 0xd4, 0x24, 0xd7, 0xc6, 0xd4, 0x54, 0x40, 0x14, 0x36 },
+  { 0x3a, 0xd5, 0x8b, 0x53, 0xa1, 0xe9, 0x72, 0x39, 0x68, 0x90, 0xbd, 0x86, 0xc7, 0x35, 0xe7, 0x8d },
+  { 0x3b, 0x04, 0x0e, 0xd7, 0xd1, 0xef, 0x8a, 0xcb, 0x4e, 0xfd, 0xee, 0xbe, 0xbd, 0xaa, 0x20, 0x52 },
+  { 0x3b, 0x09, 0x7a, 0x7e, 0xd5, 0xbd, 0x2a, 0x84, 0xdc, 0x3d, 0x3e, 0xd3, 0x61, 0xe9, 0xc3, 0x1c },
+  { 0x3b, 0x10, 0x10, 0x68, 0x36, 0x56, 0x5e, 0x5d, 0xb2, 0x8c, 0x78, 0x23, 0xc0, 0x89, 0x8f, 0xbb },
+  { 0x3b, 0x2c, 0x32, 0xfc, 0xd3, 0x31, 0x66, 0x4d, 0x03, 0x79, 0x52, 0xbc, 0xaa, 0x62, 0xdf, 0x94 },
+  { 0x3b, 0x57, 0x51, 0xa8, 0xd2, 0x0f, 0x7d, 0xe4, 0x1e, 0xb0, 0x69, 0xf7, 0x6f, 0xec, 0xd5, 0xd7 },
+  { 0x3b, 0x64, 0xa0, 0x0c, 0xe1, 0x47, 0xc3, 0xc2, 0x9f, 0x7f, 0x8f, 0x8e, 0x53, 0x1d, 0x08, 0xd8 },
+  { 0x3b, 0x69, 0xf8, 0x92, 0x93, 0x73, 0x59, 0x8e, 0x17, 0x52, 0xf4, 0x3f, 0x8d, 0xa6, 0x1a, 0xa4 },
+  { 0x3b, 0x6d, 0xba, 0x1a, 0x24, 0xbb, 0x28, 0x93, 0xbd, 0x3b, 0xd0, 0x59, 0x3f, 0x92, 0x01, 0x6b },
+  { 0x3b, 0x76, 0x24, 0x26, 0x91, 0x73, 0x0b, 0x2d, 0xd2, 0x2e, 0xc0, 0xce, 0xab, 0x35, 0x1b, 0xc6 },
+  { 0x3b, 0x80, 0xb8, 0xf5, 0x2a, 0x09, 0x39, 0xe1, 0x6b, 0x50, 0x59, 0xf9, 0x3a, 0x3f, 0xc1, 0x9a },
+  { 0x3b, 0x86, 0xa2, 0x71, 0x32, 0xfb, 0x74, 0xd9, 0xb3, 0x5d, 0x47, 0x83, 0x60, 0x5a, 0x1b, 0xcb },
+  { 0x3b, 0x8a, 0xac, 0xf5, 0xf5, 0x63, 0x84, 0x92, 0xb9, 0x26, 0xb5, 0x12, 0x4d, 0xe1, 0x9f, 0x18 },
+  { 0x3b, 0x91, 0xc3, 0x47, 0xd8, 0xe6, 0x42, 0x7e, 0xdb, 0xe9, 0x42, 0xa7, 0xa4, 0x05, 0x29, 0x0d },
+  { 0x3b, 0x94, 0x80, 0xbb, 0x6f, 0xb1, 0xe3, 0x58, 0xc9, 0xc0, 0xa6, 0x4e, 0x86, 0x94, 0x5a, 0xee },
+  { 0x3b, 0x96, 0x6b, 0xf3, 0xc2, 0xca, 0x34, 0xac, 0x6c, 0xa1, 0xde, 0x4c, 0xf6, 0x38, 0x35, 0x82 },
+  { 0x3b, 0xb9, 0x79, 0x3c, 0x60, 0xc9, 0x29, 0x11, 0x89, 0x5c, 0xf4, 0x45, 0x30, 0x84, 0x61, 0x36 },
+  { 0x3c, 0x21, 0xa8, 0x9b, 0xc3, 0x8d, 0x8c, 0xd0, 0xb0, 0x10, 0xa2, 0x91, 0x6b, 0xcf, 0xf5, 0xc2 },
+  { 0x3c, 0x3a, 0x2b, 0xb7, 0x76, 0xde, 0xc2, 0x45, 0xc7, 0xd6, 0x67, 0x8b, 0x5a, 0x56, 0xac, 0x10 },
+  { 0x3c, 0x42, 0x23, 0x31, 0x6c, 0x83, 0x5c, 0xea, 0xad, 0x61, 0x96, 0x51, 0xe2, 0x5d, 0xf0, 0xf9 },
+  { 0x3c, 0x4a, 0x6f, 0x61, 0x3c, 0xa8, 0xba, 0x27, 0xce, 0x9e, 0x43, 0xc6, 0xc9, 0x2a, 0x31, 0x28 },
+  { 0x3c, 0x57, 0x74, 0x8c, 0x82, 0x86, 0xcf, 0x9e, 0x82, 0x1e, 0xcd, 0x06, 0x4f, 0x21, 0xaa, 0xa9 },
+  { 0x3c, 0x72, 0xdd, 0xaf, 0x41, 0x15, 0x8f, 0xdd, 0x66, 0xe4, 0xf1, 0xcb, 0x90, 0xd4, 0xfd, 0x29 },
+  { 0x3c, 0x7a, 0x7b, 0x3a, 0x0a, 0x7e, 0x63, 0x19, 0xb2, 0xfa, 0x0f, 0x92, 0x3e, 0xf6, 0xc9, 0xaf },
+  { 0x3c, 0x7a, 0x96, 0x97, 0x8f, 0x52, 0xb2, 0xb1, 0x54, 0x26, 0xcd, 0xd5, 0x0f, 0x2c, 0x40, 0x48 },
+  { 0x3c, 0x82, 0xe8, 0x08, 0xfe, 0x0e, 0x6a, 0x00, 0x6d, 0xc0, 0xc4, 0xe7, 0x14, 0xd3, 0x62, 0x09 },
+  { 0x3c, 0x85, 0x3d, 0x86, 0x4a, 0x1d, 0x55, 0x34, 0xed, 0x0d, 0x4b, 0x32, 0x53, 0x47, 0xf1, 0x31 },
+  { 0x3c, 0x8e, 0x57, 0xa2, 0x46, 0x74, 0x2f, 0xa5, 0xd5, 0x9e, 0x51, 0x71, 0x34, 0xc0, 0xb4, 0xe6 },
+  { 0x3c, 0xa5, 0x1b, 0x5c, 0x08, 0xf5, 0xa0, 0xec, 0xfb, 0x17, 0xd0, 0xc1, 0xec, 0x6d, 0x09, 0x42 },
+  { 0x3c, 0xaa, 0x90, 0x2a, 0xc0, 0xce, 0x45, 0x09, 0x30, 0x89, 0x90, 0x64, 0x58, 0x76, 0x42, 0x6a },
+  { 0x3c, 0xbd, 0xf7, 0x1b, 0xb9, 0xfd, 0x26, 0x1f, 0xbc, 0x43, 0x37, 0x17, 0xf5, 0x47, 0xd7, 0x38 },
+  { 0x3c, 0xdd, 0x91, 0xe1, 0xc2, 0x8d, 0x28, 0xe8, 0x56, 0xc0, 0x06, 0x3d, 0x60, 0x2d, 0xa1, 0x66 },
+  { 0x3d, 0x1e, 0x83, 0xaf, 0xdb, 0x42, 0x65, 0xfa, 0x2f, 0xb8, 0x48, 0x19, 0xc9, 0xcf, 0xd3, 0x9c },
+  { 0x3d, 0x23, 0x67, 0xb2, 0xb0, 0x9c, 0x28, 0xf1, 0x65, 0x9c, 0x08, 0x2b, 0xb4, 0x6a, 0x73, 0x34 },
+  { 0x3d, 0x26, 0x52, 0xcb, 0xea, 0x46, 0x2a, 0x88, 0x6a, 0x41, 0x79, 0x1d, 0xd7, 0xc8, 0xd0, 0x73 },
+  { 0x3d, 0x48, 0xb8, 0xb5, 0x86, 0xa0, 0x9b, 0xdb, 0xf4, 0x9f, 0x1a, 0x01, 0x6b, 0xf4, 0xd2, 0x9a },
+  { 0x3d, 0x6f, 0xc7, 0xa1, 0x9b, 0xe7, 0x6d, 0x80, 0x8a, 0xa2, 0x33, 0x41, 0x5c, 0xb5, 0x83, 0xfc },
+  { 0x3d, 0x77, 0x49, 0xfb, 0x9c, 0x2f, 0x91, 0xa2, 0x76, 0xdf, 0xe4, 0x94, 0x49, 0x52, 0x34, 0xc5 },
+  { 0x3d, 0x7a, 0xad, 0x37, 0xc5, 0x56, 0x92, 0x81, 0x42, 0x11, 0xc8, 0xb5, 0x90, 0xa0, 0x33, 0x4c },
+  { 0x3d, 0x8a, 0x2d, 0x64, 0x93, 0x12, 0x3a, 0x53, 0xad, 0xe4, 0x5e, 0x3e, 0x2c, 0x5c, 0xaf, 0xa0 },
+  { 0x3d, 0x93, 0x4b, 0xb9, 0x80, 0xe2, 0xe6, 0x3e, 0x1e, 0xad, 0x3e, 0x77, 0x56, 0x92, 0x8c, 0xcd },
+  { 0x3d, 0x9c, 0x2f, 0xcc, 0xf8, 0xb1, 0x16, 0x30, 0x76, 0x2f, 0xf0, 0x08, 0x11, 0xc1, 0x92, 0x77 },
+  { 0x3d, 0xa7, 0xcc, 0x70, 0x49, 0xd7, 0x3d, 0x34, 0x92, 0x0b, 0xb7, 0x38, 0x17, 0xbd, 0x05, 0xa9 },
+  { 0x3d, 0xfb, 0x7c, 0x18, 0x03, 0xf9, 0x37, 0xfa, 0xdc, 0x65, 0x2a, 0x3e, 0x95, 0xff, 0x7d, 0xc6 },
+  { 0x3e, 0x03, 0x08, 0x6d, 0xa5, 0x3e, 0xcc, 0x29, 0xd8, 0x55, 0xd8, 0xed, 0xf1, 0x09, 0x62, 0xcb },
+  { 0x3e, 0x16, 0x82, 0xdd, 0xae, 0xc4, 0x86, 0xd8, 0xb6, 0xb9, 0x0b, 0x52, 0x7a, 0xaa, 0x0f, 0xc4 },
+  { 0x3e, 0x22, 0xc7, 0xea, 0xf6, 0x45, 0x9b, 0x67, 0x38, 0x86, 0x02, 0xe4, 0xbe, 0xbb, 0xb3, 0xa8 },
+  { 0x3e, 0x33, 0xac, 0x10, 0xdc, 0xf2, 0xdf, 0xf0, 0x14, 0xbc, 0x1d, 0xec, 0xf8, 0xa9, 0xae, 0xa4 },
+  { 0x3e, 0x49, 0xda, 0x62, 0x11, 0x93, 0xd2, 0x61, 0x1a, 0x4e, 0xa1, 0x52, 0xd5, 0xd5, 0xca, 0x3a },
+  { 0x3e, 0x4b, 0x11, 0x37, 0x43, 0x3c, 0xc1, 0xe6, 0x17, 0xb5, 0x50, 0x86, 0x19, 0xe1, 0x30, 0x63 },
+  { 0x3e, 0x5c, 0xa1, 0xaf, 0xaa, 0x27, 0xc5, 0xda, 0x3c, 0x54, 0xc9, 0x94, 0x2f, 0xec, 0x52, 0x8b },
+  { 0x3e, 0x6d, 0xab, 0x92, 0x00, 0x9d, 0x60, 0x34, 0x61, 0x8c, 0xb6, 0xb7, 0x84, 0x4c, 0x52, 0x16 },
+  { 0x3e, 0x7d, 0x10, 0xd0, 0xa9, 0x11, 0xaf, 0xc4, 0xb4, 0x92, 0xd0, 0x6c, 0x99, 0x86, 0x3e, 0x65 },
+  { 0x3e, 0x88, 0xcc, 0xa5, 0xb8, 0x60, 0xd0, 0xbd, 0x89, 0x47, 0x47, 0x9e, 0x74, 0xc4, 0x42, 0x84 },
+  { 0x3e, 0x89, 0x9e, 0xba, 0x0c, 0xa8, 0xcd, 0x29, 0x72, 0xda, 0x1a, 0xe5, 0x47, 0x9b, 0x4f, 0x0d },
+  { 0x3e, 0x90, 0xcf, 0x23, 0x10, 0x6f, 0x2e, 0x08, 0xb2, 0x78, 0x1e, 0x41, 0x29, 0x9d, 0xe5, 0x56 },
+  { 0x3e, 0xae, 0x06, 0x2a, 0x9b, 0x72, 0x2b, 0xda, 0x12, 0x55, 0xd4, 0x74, 0xa8, 0x7e, 0xca, 0x5c },
+  { 0x3e, 0xb1, 0xe3, 0x4a, 0x4f, 0x0e, 0xec, 0x36, 0xf1, 0x2e, 0x73, 0x36, 0xba, 0xdc, 0xec, 0xf2 },
+  { 0x3e, 0xb2, 0x13, 0x13, 0xea, 0x5d, 0x57, 0x64, 0xc5, 0xed, 0x91, 0x60, 0xa5, 0xa5, 0x5a, 0x83 },
+  { 0x3e, 0xc1, 0x23, 0x72, 0xca, 0x3e, 0x87, 0x0b, 0x11, 0xca, 0x70, 0xed, 0xc7, 0xec, 0x26, 0xa4 },
+  { 0x3e, 0xcc, 0xf9, 0xf3, 0x63, 0xf5, 0xc5, 0xde, 0x0c, 0x8b, 0x17, 0x4a, 0x53, 0x5d, 0xc8, 0x3b },
+  { 0x3e, 0xf9, 0x57, 0x35, 0x36, 0x73, 0x0d, 0xcd, 0x6d, 0x9c, 0x20, 0xb6, 0x82, 0x2d, 0xbd, 0xc4 },
+  { 0x3f, 0x01, 0xbd, 0x6d, 0x05, 0x93, 0x96, 0xf4, 0x95, 0xa4, 0xcd, 0xe7, 0xde, 0x0a, 0xb1, 0x80 },
+  { 0x3f, 0x03, 0x99, 0x81, 0x25, 0x56, 0x91, 0xd3, 0x85, 0x9d, 0x04, 0xef, 0x81, 0x3a, 0x12, 0x64 },
+  { 0x3f, 0x25, 0x1c, 0x50, 0xaa, 0x72, 0x37, 0xe6, 0x1a, 0x38, 0xab, 0x42, 0x31, 0x5e, 0xbe, 0xd4 },
+  { 0x3f, 0x3a, 0xd2, 0x76, 0x5c, 0x87, 0x4c, 0xa1, 0x3c, 0x01, 0x5c, 0xa6, 0xa4, 0x4a, 0x40, 0xa1 },
+  { 0x3f, 0x54, 0x0a, 0x30, 0xfd, 0xee, 0x0b, 0x20, 0xae, 0xd7, 0x28, 0x8e, 0x4a, 0x5e, 0xa5, 0x28 },
+  { 0x3f, 0x58, 0xf9, 0x72, 0x27, 0x6d, 0x1e, 0x4e, 0x0e, 0x09, 0x58, 0x25, 0x21, 0xed, 0x7a, 0x5b },
+  { 0x3f, 0x5a, 0x43, 0x60, 0x2f, 0x96, 0x0e, 0xde, 0x33, 0x0c, 0xd2, 0xf4, 0x3a, 0x25, 0x13, 0x9e },
+  { 0x3f, 0x69, 0x38, 0xaa, 0x6c, 0xe6, 0x6e, 0x6f, 0x42, 0xe5, 0x82, 0xc1, 0xeb, 0x19, 0xb1, 0x8c },
+  { 0x3f, 0x6d, 0xbf, 0x44, 0x8f, 0x25, 0xe2, 0xbd, 0x06, 0xde, 0xa4, 0x42, 0x48, 0xeb, 0x12, 0x2d },
+  { 0x3f, 0x75, 0xa5, 0xda, 0x3e, 0x40, 0xd4, 0x86, 0xb2, 0x1d, 0xfc, 0x1c, 0x85, 0x17, 0xad, 0xc0 },
+  { 0x3f, 0x94, 0x31, 0xcc, 0x8c, 0x5e, 0x2f, 0x22, 0x0b, 0x2a, 0xc1, 0x4b, 0xbc, 0x82, 0x31, 0xf4 },
+  { 0x3f, 0x96, 0xeb, 0x71, 0x19, 0x28, 0xa6, 0xfa, 0xc6, 0x67, 0xc0, 0x4e, 0xcd, 0x41, 0xf5, 0x9f },
+  { 0x3f, 0x9c, 0xb1, 0xab, 0xa8, 0xec, 0x20, 0xe2, 0xc2, 0x43, 0xae, 0x64, 0x2f, 0x99, 0x42, 0xbf },
+  { 0x3f, 0xd1, 0xf9, 0xd6, 0x6a, 0x41, 0x8c, 0x9f, 0x78, 0x7f, 0xc5, 0x79, 0x91, 0x74, 0xdd, 0xb7 },
+  { 0x3f, 0xd5, 0x3b, 0xfe, 0xee, 0x39, 0x06, 0x4c, 0x94, 0x5a, 0x76, 0x9f, 0x17, 0x81, 0x5a, 0x7f },
+  { 0x3f, 0xe4, 0x39, 0x15, 0xe5, 0x65, 0x5c, 0xf6, 0x94, 0x85, 0x36, 0x4e, 0x9f, 0x46, 0x40, 0x97 },
+  { 0x3f, 0xf5, 0x16, 0x53, 0x78, 0x21, 0x3d, 0xab, 0x53, 0x1f, 0xfa, 0x4f, 0x1a, 0x41, 0xae, 0x45 },
+  { 0x40, 0x2b, 0x1c, 0xa3, 0xc2, 0x30, 0xa6, 0x0f, 0xb2, 0x79, 0xd4, 0xa2, 0xa1, 0x0f, 0xa6, 0x77 },
+  { 0x40, 0x2d, 0x87, 0x6e, 0xc4, 0xa7, 0x3f, 0x9e, 0x31, 0x33, 0xf8, 0xf7, 0xf7, 0x99, 0x2a, 0x1e },
+  { 0x40, 0x5f, 0x85, 0x91, 0xb6, 0x94, 0x1c, 0xff, 0x56, 0xc9, 0xb3, 0x92, 0xc2, 0xd5, 0xe4, 0xe5 },
+  { 0x40, 0x66, 0x30, 0x9e, 0xb3, 0xfa, 0x3e, 0x7a, 0x72, 0x55, 0x85, 0xb9, 0x81, 0x4b, 0xc3, 0x75 },
+  { 0x40, 0x66, 0xd7, 0xd8, 0x8e, 0xc4, 0xa2, 0xc6, 0x56, 0x12, 0x7a, 0x67, 0xfa, 0x52, 0xdc, 0xf1 },
+  { 0x40, 0x7a, 0x0c, 0x6c, 0xc0, 0xff, 0x77, 0x7f, 0x67, 0xb6, 0x69, 0x44, 0x0d, 0x68, 0xa2, 0x42 },
+  { 0x40, 0x93, 0x38, 0x21, 0x87, 0xf8, 0x38, 0x7e, 0x6d, 0x01, 0x18, 0x83, 0xe8, 0xea, 0x51, 0x9b },
+  { 0x40, 0xaa, 0x85, 0x1e, 0x8d, 0x0f, 0x1c, 0x55, 0x51, 0x76, 0xa5, 0xe2, 0x09, 0xa5, 0xfa, 0xbb },
+  { 0x40, 0xb1, 0x83, 0x21, 0x77, 0xc6, 0x3e, 0xbf, 0x81, 0xe6, 0xc5, 0xb6, 0x1a, 0xaf, 0xfd, 0x3a },
+  { 0x40, 0xb5, 0x92, 0x49, 0xe0, 0x51, 0x35, 0xbc, 0xa3, 0x38, 0x61, 0xe3, 0x83, 0x73, 0x5e, 0x9e },
+  { 0x40, 0xd7, 0xcc, 0xd4, 0x60, 0xc9, 0xb1, 0x19, 0x82, 0x38, 0xaf, 0x6c, 0xee, 0xa1, 0x73, 0x7d },
+  { 0x40, 0xd8, 0xed, 0x6a, 0x51, 0x06, 0x24, 0x5a, 0xa7, 0x9f, 0x05, 0x64, 0x2a, 0x96, 0x14, 0x85 },
+  { 0x40, 0xd9, 0xf5, 0x70, 0x98, 0x77, 0xec, 0xf3, 0xdd, 0x11, 0x84, 0xf9, 0x79, 0x1d, 0xd3, 0x5e },
+  { 0x40, 0xe1, 0x2c, 0x00, 0x80, 0x37, 0xa3, 0x23, 0xa1, 0x29, 0x0c, 0x8f, 0xa4, 0xd2, 0xfe, 0x7f },
+  { 0x40, 0xeb, 0x4e, 0x26, 0x35, 0x81, 0xb3, 0xdf, 0xec, 0x6d, 0xd8, 0x92, 0x0b, 0x68, 0xe0, 0x0f },
+  { 0x41, 0x3c, 0x92, 0x5c, 0x5f, 0xdc, 0xea, 0x62, 0x84, 0x2a, 0x63, 0xa4, 0xc6, 0x71, 0xa5, 0xf2 },
+  { 0x41, 0x53, 0xdd, 0x2b, 0xee, 0xd6, 0x48, 0xe9, 0xdc, 0x08, 0x21, 0x40, 0xeb, 0xe8, 0xe8, 0x36 },
+  { 0x41, 0x5c, 0x11, 0xfc, 0xac, 0x66, 0xbb, 0xd2, 0xac, 0xe2, 0x09, 0x66, 0x87, 0x77, 0x4b, 0x5a },
+  { 0x41, 0x81, 0x08, 0x73, 0x89, 0xa7, 0x9c, 0x7f, 0x59, 0x61, 0x1f, 0xb5, 0x1c, 0x26, 0x31, 0x37 },
+  { 0x41, 0x81, 0x0d, 0xd9, 0x4b, 0xd0, 0xde, 0x11, 0x10, 0xbe, 0xdc, 0x50, 0x92, 0xbe, 0xf5, 0xb0 },
+  { 0x41, 0x81, 0x87, 0x38, 0xab, 0x17, 0x45, 0xe8, 0x79, 0x02, 0x4a, 0x17, 0x78, 0x4d, 0x71, 0xf5 },
+  { 0x41, 0x89, 0xad, 0xfc, 0x1b, 0x30, 0xc1, 0x21, 0x24, 0x88, 0x76, 0xe3, 0xa1, 0xa3, 0xac, 0x7e },
+  { 0x41, 0x91, 0xb6, 0x71, 0xbc, 0xd8, 0x23, 0x7f, 0xc8, 0xe2, 0x97, 0xb4, 0x94, 0x7f, 0x29, 0x90 },
+  { 0x41, 0xc4, 0xe3, 0xd4, 0x5a, 0x06, 0xdf, 0x9d, 0x21, 0xb7, 0xaa, 0xe6, 0xae, 0x7e, 0x99, 0x12 },
+  { 0x41, 0xf2, 0x52, 0xa6, 0x6c, 0x63, 0x01, 0xf1, 0xe8, 0xab, 0x36, 0x12, 0xc1, 0x9b, 0xc5, 0xd4 },
+  { 0x42, 0x09, 0xe9, 0xdc, 0xdf, 0x05, 0x61, 0x4e, 0x29, 0x01, 0x67, 0xa1, 0xc0, 0x33, 0xcf, 0xd2 },
+  { 0x42, 0x24, 0x9e, 0xc8, 0x04, 0x3a, 0x9a, 0x02, 0x03, 0xdd, 0xe0, 0xb5, 0xbb, 0x46, 0xd8, 0xc4 },
+  { 0x42, 0x33, 0xeb, 0x82, 0x4c, 0x2b, 0x48, 0x11, 0xab, 0xef, 0x9b, 0x6d, 0x00, 0x35, 0x5a, 0xe9 },
+  { 0x42, 0x51, 0xb4, 0x55, 0x7e, 0xa6, 0x95, 0x3e, 0x88, 0xaf, 0xb2, 0x2a, 0x3a, 0x86, 0x87, 0x24 },
+  { 0x42, 0x5e, 0xe4, 0x44, 0xa4, 0x1d, 0x21, 0x85, 0x98, 0x89, 0x3d, 0x6b, 0x6e, 0x03, 0x43, 0x1a },
+  { 0x42, 0x79, 0x48, 0x5e, 0x92, 0x2b, 0x34, 0xf1, 0x27, 0xa8, 0x89, 0x04, 0xb3, 0x1c, 0xe9, 0xfa },
+  { 0x42, 0x8b, 0x2d, 0x36, 0xf5, 0xd7, 0x16, 0x76, 0x54, 0x60, 0x70, 0x1f, 0x70, 0x16, 0xac, 0x91 },
+  { 0x42, 0xae, 0x81, 0xae, 0x8a, 0xc5, 0x1e, 0x5c, 0x23, 0x86, 0x39, 0xf9, 0xf7, 0x7d, 0x91, 0xae },
+  { 0x42, 0xb2, 0xc3, 0xb4, 0x54, 0x5f, 0x14, 0x99, 0xa0, 0x83, 0xcf, 0xbc, 0x4a, 0x3b, 0x76, 0x40 },
+  { 0x42, 0xb3, 0xab, 0x3c, 0xf6, 0x61, 0x92, 0x9b, 0xdc, 0x77, 0xb6, 0x21, 0xa8, 0xc3, 0x75, 0x74 },
+  { 0x42, 0xb5, 0xe3, 0xa3, 0x5b, 0x03, 0x2f, 0x03, 0x38, 0x09, 0xaf, 0xb0, 0xea, 0x28, 0x80, 0x2d },
+  { 0x42, 0xcd, 0xd6, 0xa9, 0xe4, 0x2a, 0x36, 0x39, 0xe1, 0x90, 0x72, 0x2b, 0x8e, 0xa3, 0xfc, 0x51 },
+  { 0x42, 0xdc, 0xc0, 0x27, 0x77, 0xb0, 0xbc, 0xfa, 0xcd, 0x85, 0xae, 0xb6, 0x1d, 0x33, 0x55, 0x8a },
+  { 0x42, 0xe0, 0xec, 0x5a, 0xb8, 0xf5, 0xde, 0xba, 0x53, 0xe4, 0x16, 0x9f, 0xf2, 0xa5, 0xef, 0xbe },
+  { 0x43, 0x11, 0xa4, 0x11, 0x5f, 0xb7, 0xbc, 0x68, 0x47, 0x7c, 0x96, 0xcf, 0x44, 0xce, 0xba, 0xcf },
+  { 0x43, 0x26, 0xed, 0xb7, 0x0f, 0xf2, 0x0d, 0x0e, 0xe5, 0xba, 0x58, 0xfa, 0x5c, 0xb0, 0x9d, 0x60 },
+  { 0x43, 0x5f, 0xd4, 0x69, 0xf0, 0x88, 0x46, 0x8c, 0x4d, 0x66, 0xbe, 0x6b, 0x52, 0x04, 0xd8, 0x87 },
+  { 0x43, 0x89, 0x68, 0xa2, 0x6b, 0x7c, 0xfe, 0x14, 0xa4, 0x99, 0xf5, 0xbb, 0xbb, 0xf8, 0x44, 0xdb },
+  { 0x43, 0xad, 0xf6, 0x0e, 0xbd, 0xd6, 0xb5, 0xa0, 0xfa, 0xe2, 0x15, 0x94, 0xec, 0xf1, 0x71, 0x54 },
+  { 0x43, 0xc6, 0xcf, 0xff, 0xed, 0xda, 0xb6, 0xb3, 0x78, 0x73, 0x57, 0xfe, 0xd9, 0xd4, 0x45, 0x29 },
+  { 0x43, 0xe6, 0xc5, 0x15, 0x9c, 0x3a, 0x09, 0x3f, 0xca, 0x88, 0x65, 0x66, 0x28, 0xc6, 0xef, 0x34 },
+  { 0x43, 0xf3, 0x3c, 0x6d, 0xfd, 0xea, 0xf5, 0x13, 0x8c, 0xe6, 0xe6, 0x96, 0x8a, 0xd7, 0xc5, 0xce },
+  { 0x43, 0xf8, 0x45, 0x9d, 0x39, 0xfb, 0x4e, 0xdd, 0xf9, 0x18, 0x6d, 0x62, 0x72, 0x2f, 0xf7, 0x95 },
+  { 0x44, 0x26, 0x02, 0x71, 0x3c, 0xb4, 0x5b, 0x93, 0x21, 0xee, 0x93, 0xc6, 0xea, 0x28, 0xa5, 0xd0 },
+  { 0x44, 0x2b, 0x78, 0x63, 0x68, 0x3e, 0x5f, 0x08, 0x47, 0x16, 0xfd, 0xa0, 0x50, 0x47, 0x4f, 0xeb },
+  { 0x44, 0x31, 0x42, 0x8a, 0x75, 0x00, 0xc9, 0x6f, 0xc0, 0xe2, 0x79, 0x8a, 0x5d, 0xbd, 0x36, 0xd6 },
+  { 0x44, 0x56, 0x0e, 0x32, 0x4f, 0xfb, 0x30, 0x74, 0x1a, 0x48, 0x32, 0x18, 0xba, 0x5b, 0x43, 0x42 },
+  { 0x44, 0x74, 0xb3, 0xad, 0x3b, 0xf6, 0xaa, 0xbe, 0x71, 0x9a, 0x2d, 0x7f, 0x1d, 0x1f, 0xb4, 0xcc },
+  { 0x44, 0x76, 0xc3, 0x97, 0x36, 0x09, 0x0d, 0xab, 0xac, 0x09, 0xf6, 0xca, 0xf8, 0x35, 0xfc, 0x49 },
+  { 0x44, 0x8c, 0x2a, 0x17, 0x5a, 0xfc, 0x8d, 0xf1, 0x74, 0xd6, 0xff, 0x4c, 0xce, 0x12, 0xc7, 0x94 },
+  { 0x44, 0xe9, 0xc4, 0xa0, 0x47, 0xc3, 0x48, 0xdb, 0xeb, 0x7a, 0xce, 0x60, 0xf4, 0x54, 0x84, 0xb4 },
+  { 0x44, 0xf7, 0x1e, 0x70, 0xb8, 0x9d, 0xcc, 0x7c, 0xf3, 0x9d, 0xfd, 0x62, 0x2c, 0xfb, 0x9a, 0x27 },
+  { 0x45, 0x02, 0x7d, 0xde, 0x2b, 0xe5, 0xbd, 0xd0, 0xca, 0xb5, 0x22, 0xb8, 0x06, 0x32, 0x71, 0x7d },
+  { 0x45, 0x04, 0x06, 0x79, 0xd7, 0x2b, 0x10, 0x11, 0x89, 0xc2, 0x98, 0xa8, 0x64, 0xa5, 0xb5, 0xba },
+  { 0x45, 0x43, 0xb7, 0x69, 0x19, 0x14, 0xdf, 0xd6, 0x9c, 0x37, 0x55, 0xa5, 0x28, 0x7a, 0x95, 0xe1 },
+  { 0x45, 0x64, 0x53, 0xa5, 0x4c, 0xa6, 0x51, 0x91, 0x78, 0x1a, 0xef, 0x31, 0x63, 0x43, 0xae, 0x00 },
+  { 0x45, 0x65, 0xc1, 0xa7, 0xab, 0xce, 0x77, 0x3e, 0x53, 0xc7, 0x5b, 0x35, 0x41, 0x4a, 0xde, 0xfd },
+  { 0x45, 0x7b, 0x03, 0xcd, 0x48, 0xff, 0x6d, 0x89, 0x57, 0x95, 0xef, 0x04, 0x3c, 0x6b, 0x0f, 0x1e },
+  { 0x45, 0x7e, 0x7d, 0x4f, 0xcd, 0x56, 0xeb, 0xc4, 0x7f, 0x59, 0x25, 0xdb, 0xea, 0x3e, 0xe4, 0x27 },
+  { 0x45, 0x7f, 0x4a, 0xd2, 0xcd, 0xa5, 0xf4, 0x80, 0x3f, 0x12, 0x25, 0x08, 0xbf, 0xbd, 0xe3, 0xf5 },
+  { 0x45, 0x88, 0x83, 0xf1, 0xd9, 0x52, 0xcd, 0x77, 0x2c, 0xf0, 0x05, 0x7a, 0xbc, 0xa5, 0x74, 0x97 },
+  { 0x45, 0xa0, 0x95, 0x64, 0x56, 0x96, 0xa2, 0x17, 0xe4, 0x16, 0xe4, 0xbd, 0x2b, 0xae, 0xa7, 0x23 },
+  { 0x45, 0xa4, 0xf5, 0x5b, 0xb9, 0xa5, 0x08, 0x3d, 0x47, 0x0a, 0xd4, 0x79, 0xaf, 0xd8, 0xbc, 0xa2 },
+  { 0x45, 0xbe, 0xef, 0x9d, 0xa1, 0xa7, 0xe4, 0x5f, 0x37, 0xf3, 0xf4, 0x45, 0xf7, 0x69, 0xa0, 0xb3 },
+  { 0x45, 0xc4, 0x41, 0x3d, 0xd7, 0x03, 0xb9, 0xcf, 0xea, 0x49, 0xa1, 0x37, 0x09, 0xd5, 0x60, 0xeb },
+  { 0x45, 0xcb, 0x0f, 0x41, 0x77, 0x4b, 0x78, 0xde, 0xf5, 0x33, 0x31, 0xe4, 0xc3, 0xbf, 0x33, 0x62 },
+  { 0x46, 0x05, 0xa0, 0x0f, 0x5b, 0x44, 0xa9, 0xcb, 0xd5, 0x80, 0x3a, 0x7a, 0x55, 0xde, 0x15, 0x0e },
+  { 0x46, 0x10, 0x29, 0xab, 0x23, 0x80, 0x08, 0x33, 0xe9, 0x64, 0x5b, 0xe3, 0xe4, 0x72, 0xd4, 0x70 },
+  { 0x46, 0x25, 0x8b, 0xd9, 0x2b, 0x1f, 0x66, 0xf4, 0xcb, 0x47, 0x86, 0x4d, 0x76, 0x54, 0xf5, 0x42 },
+  { 0x46, 0x3d, 0xd4, 0x77, 0x05, 0x06, 0xe6, 0xc0, 0xef, 0x99, 0x3a, 0x40, 0xc5, 0x2c, 0x47, 0xbe },
+  { 0x46, 0x3e, 0x66, 0xad, 0x98, 0x80, 0x6a, 0x49, 0x10, 0x6c, 0xff, 0xa4, 0x9c, 0x08, 0xe2, 0xed },
+  { 0x46, 0x73, 0x40, 0xa1, 0x81, 0x58, 0x64, 0x9a, 0xa5, 0xe0, 0x2a, 0x43, 0x72, 0xdc, 0xfc, 0xcd },
+  { 0x46, 0x89, 0x08, 0x1b, 0x73, 0x63, 0x72, 0x18, 0x58, 0x75, 0x6f, 0xe7, 0x81, 0xcc, 0x77, 0x13 },
+  { 0x46, 0x8f, 0x2d, 0xec, 0x98, 0x4f, 0x3d, 0x41, 0x14, 0xea, 0x84, 0xf0, 0x5e, 0xdf, 0x82, 0xb6 },
+  { 0x46, 0x90, 0xfd, 0xb7, 0x0c, 0x86, 0x60, 0x4b, 0xb3, 0x5d, 0xa2, 0x66, 0x96, 0x81, 0x86, 0x67 },
+  { 0x46, 0x94, 0x73, 0xff, 0x6f, 0xed, 0x8c, 0xc8, 0xd6, 0x5f, 0x3c, 0x33, 0x4f, 0x96, 0x3a, 0xab },
+  { 0x46, 0xc0, 0x21, 0xa3, 0xe9, 0xe2, 0xfd, 0x00, 0x91, 0x9c, 0xa3, 0xdd, 0x1a, 0x6b, 0x76, 0xd8 },
+  { 0x46, 0xc4, 0x3f, 0xdc, 0xbc, 0xe8, 0xfd, 0xe3, 0xa9, 0x1e, 0xbe, 0xaf, 0xc0, 0x5b, 0x7c, 0xbd },
+  { 0x46, 0xe9, 0x42, 0x88, 0x48, 0xc9, 0xea, 0x71, 0xa4, 0xd8, 0xf9, 0x1f, 0xf8, 0x1a, 0xc9, 0xcc },
+  { 0x47, 0x02, 0xd8, 0xd9, 0xb4, 0x8a, 0x33, 0x27, 0x24, 0xaf, 0x19, 0x8a, 0xea, 0xc9, 0xe4, 0x69 },
+  { 0x47, 0x08, 0x78, 0xb9, 0x91, 0x7e, 0xa0, 0x34, 0x8d, 0x64, 0xb5, 0x75, 0x0a, 0xf1, 0x49, 0xaa },
+  { 0x47, 0x46, 0x46, 0x94, 0xe9, 0xcc, 0xe0, 0x7f, 0xdb, 0xfd, 0x09, 0x66, 0x05, 0xbf, 0x39, 0xd4 },
+  { 0x47, 0x67, 0x35, 0x6f, 0xa0, 0xed, 0x3e, 0xbe, 0x21, 0x43, 0x7b, 0x44, 0x73, 0xd4, 0xee, 0x28 },
+  { 0x47, 0x71, 0x1c, 0x44, 0x72, 0x3d, 0xa5, 0xd6, 0x70, 0x47, 0x99, 0x01, 0x57, 0xdc, 0xb5, 0xdd },
+  { 0x47, 0x91, 0x17, 0x52, 0xbf, 0x11, 0x3a, 0x24, 0x96, 0xdb, 0xb6, 0x6c, 0x70, 0xc9, 0xe7, 0x0c },
+  { 0x47, 0x99, 0xa4, 0x0b, 0x6e, 0x88, 0x93, 0x70, 0xb7, 0xee, 0x55, 0xc1, 0x7b, 0xa6, 0x51, 0x41 },
+  { 0x47, 0xaa, 0xd2, 0x47, 0xcc, 0xe2, 0x53, 0x4f, 0xd7, 0x0c, 0x41, 0x2c, 0xb4, 0x83, 0xc7, 0xe0 },
+  { 0x47, 0xab, 0xfb, 0x99, 0x3f, 0xf1, 0x4f, 0x50, 0x2f, 0x88, 0xcf, 0x98, 0x80, 0x92, 0xe0, 0x55 },
+  { 0x47, 0xae, 0xf1, 0x85, 0x09, 0x05, 0x1b, 0xab, 0x49, 0x35, 0x89, 0xcb, 0x26, 0x19, 0x17, 0x0b },
+  { 0x47, 0xb8, 0x2d, 0x47, 0xe4, 0x91, 0xac, 0x7f, 0xdb, 0x50, 0x53, 0xa8, 0x8f, 0xcc, 0xc8, 0x32 },
+  { 0x47, 0xbb, 0x1c, 0x67, 0x7f, 0xe7, 0xba, 0x5f, 0x37, 0x63, 0x72, 0xae, 0x73, 0x58, 0xe7, 0x90 },
+  { 0x47, 0xcd, 0x61, 0xf8, 0x34, 0x57, 0xa0, 0x89, 0x0d, 0xe3, 0x81, 0xe4, 0x78, 0xf5, 0xcf, 0x5f },
+  { 0x48, 0x1d, 0x20, 0xec, 0x22, 0xe7, 0xa6, 0x3e, 0x81, 0x8d, 0x5e, 0xf9, 0x67, 0x9d, 0x54, 0x8b },
+  { 0x48, 0x1f, 0x9a, 0x74, 0x20, 0x52, 0x80, 0x1c, 0xc5, 0xf3, 0xde, 0xfb, 0x41, 0xcb, 0x63, 0x8e },
+  { 0x48, 0x28, 0x7a, 0x93, 0x23, 0xa0, 0xae, 0x6a, 0xb1, 0x5e, 0x67, 0x1a, 0xc2, 0xa8, 0x75, 0x98 },
+  { 0x48, 0x41, 0x1c, 0x9e, 0xf7, 0xe2, 0xce, 0xf1, 0xd6, 0xb2, 0xbe, 0xe0, 0xe6, 0x05, 0x5c, 0x27 },
+  { 0x48, 0x4b, 0x00, 0x76, 0x81, 0x6a, 0x10, 0x48, 0x75, 0xe0, 0x04, 0x67, 0xd4, 0x31, 0xc2, 0xd2 },
+  { 0x48, 0x68, 0xa8, 0x1e, 0x1b, 0x60, 0x31, 0xed, 0x66, 0xec, 0xd6, 0x05, 0x47, 0xe6, 0xec, 0x85 },
+  { 0x48, 0x84, 0xb1, 0x29, 0x75, 0x00, 0xbd, 0x12, 0x43, 0x65, 0x9e, 0x43, 0xc7, 0xe7, 0x57, 0x9e },
+  { 0x48, 0x92, 0xb8, 0x5c, 0x24, 0x81, 0x31, 0xd6, 0xa4, 0x2c, 0x66, 0xa4, 0x16, 0x3a, 0x40, 0xd0 },
+  { 0x48, 0xbc, 0xf2, 0xc5, 0xa8, 0xc8, 0x0f, 0x18, 0xb2, 0x4c, 0x55, 0xdb, 0x96, 0x84, 0x54, 0x72 },
+  { 0x48, 0xe5, 0xc4, 0xae, 0x4f, 0x2d, 0x3b, 0x62, 0xb3, 0x5a, 0x87, 0xbc, 0xa1, 0x8d, 0xc9, 0xf5 },
+  { 0x48, 0xf1, 0x8d, 0x69, 0x79, 0x9a, 0x5f, 0x54, 0x51, 0xa5, 0xf0, 0xd1, 0x78, 0x76, 0xac, 0xef },
+  { 0x49, 0x01, 0xc0, 0x50, 0x68, 0x51, 0x28, 0x28, 0x36, 0x7f, 0xde, 0x3f, 0xb2, 0x21, 0x99, 0xfe },
+  { 0x49, 0x04, 0xa2, 0x55, 0x07, 0x59, 0xb9, 0xb4, 0x57, 0x0e, 0x88, 0x63, 0x74, 0xf9, 0xd0, 0x92 },
+  { 0x49, 0x0e, 0x3c, 0xc5, 0x9d, 0x82, 0xf8, 0x5f, 0xae, 0x81, 0x7c, 0xdf, 0x76, 0x7e, 0xa7, 0xa0 },
+  { 0x49, 0x0e, 0xed, 0x07, 0xd4, 0x69, 0x1b, 0x27, 0xf4, 0x73, 0x95, 0x3f, 0xbe, 0xa6, 0x54, 0x1a },
+  { 0x49, 0x3d, 0xaa, 0xf9, 0xfb, 0x1b, 0xa4, 0x50, 0xeb, 0xa6, 0xb8, 0xed, 0x53, 0xff, 0xb3, 0x7d },
+  { 0x49, 0x3d, 0xe0, 0x59, 0xb3, 0x2f, 0x84, 0xab, 0x29, 0xcd, 0xe6, 0x21, 0x39, 0x64, 0xae, 0xee },
+  { 0x49, 0x3e, 0x90, 0x60, 0x2a, 0x44, 0x34, 0xb1, 0x17, 0xc9, 0x1c, 0x95, 0xe7, 0x38, 0x28, 0xd1 },
+  { 0x49, 0x47, 0xc9, 0xde, 0x2e, 0x28, 0xb2, 0xf5, 0xf3, 0xb0, 0xc4, 0x0c, 0xe7, 0xe5, 0x6d, 0x93 },
+  { 0x49, 0x4c, 0xda, 0x91, 0xcc, 0x64, 0x05, 0x51, 0xb4, 0x89, 0x8c, 0x82, 0xbe, 0x05, 0x8d, 0xd9 },
+  { 0x49, 0x57, 0x1b, 0x26, 0xf4, 0x66, 0x20, 0xa8, 0x5f, 0x93, 0x44, 0x83, 0x59, 0x32, 0x4c, 0x28 },
+  { 0x49, 0x7f, 0x3d, 0x29, 0x70, 0xc4, 0x3e, 0x52, 0x24, 0xbe, 0x99, 0xf7, 0x5e, 0x97, 0xcb, 0xbb },
+  { 0x49, 0x81, 0xce, 0xfe, 0x54, 0x93, 0xea, 0x51, 0x22, 0x84, 0xe7, 0xf9, 0xf2, 0x7d, 0x1e, 0x54 },
+  { 0x49, 0x99, 0xb4, 0x5b, 0xe0, 0xab, 0x5a, 0x85, 0xba, 0xc1, 0xb7, 0xc0, 0xe5, 0x51, 0x54, 0x2b },
+  { 0x49, 0x9b, 0x61, 0x2f, 0x65, 0x44, 0xae, 0x71, 0xd4, 0x91, 0x5a, 0xa6, 0x3e, 0x40, 0x3e, 0x10 },
+  { 0x4a, 0x19, 0x67, 0x13, 0xa2, 0x1e, 0xf0, 0x7a, 0x3f, 0x74, 0xcf, 0x51, 0x78, 0x4c, 0x6b, 0x12 },
+  { 0x4a, 0x2f, 0xe6, 0xf0, 0xf6, 0x31, 0x7f, 0x00, 0x6f, 0xd6, 0xd4, 0xb3, 0x45, 0x15, 0x44, 0x8b },
+  { 0x4a, 0x45, 0xc6, 0xd7, 0x5b, 0x1b, 0xa1, 0x31, 0xf9, 0x4a, 0x9c, 0x13, 0x19, 0x4d, 0x8e, 0x46 },
+  { 0x4a, 0x5f, 0xdd, 0xf8, 0x98, 0x01, 0x33, 0x66, 0x37, 0xac, 0x8e, 0x57, 0xa7, 0xc9, 0xa8, 0x81 },
+  { 0x4a, 0x6b, 0xe7, 0x93, 0x10, 0xf8, 0x6f, 0x0b, 0xeb, 0xc7, 0xdf, 0xcb, 0xa4, 0xd7, 0x41, 0x61 },
+  { 0x4a, 0x7e, 0xee, 0x19, 0xc2, 0xdf, 0xb6, 0xae, 0xb4, 0xd9, 0xd0, 0xa0, 0x1d, 0x37, 0xe1, 0x27 },
+  { 0x4a, 0x8c, 0x74, 0x33, 0x96, 0xb8, 0xad, 0x69, 0xd9, 0x7e, 0x6f, 0xd3, 0xdd, 0x3e, 0x31, 0x32 },
+  { 0x4a, 0x90, 0x09, 0x62, 0x00, 0x38, 0xf7, 0xf3, 0x0a, 0xae, 0xb2, 0xa0, 0x0a, 0xe5, 0x8f, 0xde },
+  { 0x4a, 0xb2, 0xeb, 0xd9, 0x5a, 0x8f, 0x86, 0x1e, 0xa4, 0x51, 0xab, 0xeb, 0xda, 0xd9, 0x14, 0xa5 },
+  { 0x4a, 0xb4, 0xaf, 0x3a, 0xdc, 0xda, 0xe8, 0xcd, 0xac, 0xc3, 0xd0, 0x60, 0x84, 0xfc, 0x8d, 0x6a },
+  { 0x4a, 0xbb, 0x4c, 0x87, 0xa4, 0xc5, 0xf5, 0xd0, 0xc1, 0x4e, 0xad, 0x2b, 0xb3, 0x62, 0x51, 0xbe },
+  { 0x4a, 0xc9, 0xf4, 0x0d, 0xdf, 0xcf, 0x19, 0x4b, 0xd8, 0x73, 0x2a, 0x75, 0xb3, 0xf2, 0xf2, 0x14 },
+  { 0x4a, 0xe8, 0xc7, 0x6c, 0xd6, 0xf2, 0x4a, 0x2e, 0x18, 0x1a, 0xe8, 0x74, 0xd4, 0xd2, 0xaa, 0x3d },
+  { 0x4a, 0xf4, 0x10, 0x37, 0x59, 0xd6, 0x03, 0xc8, 0x2b, 0x1c, 0x9c, 0x5a, 0xcd, 0x2d, 0x8f, 0xaf },
+  { 0x4a, 0xfa, 0x7f, 0x37, 0x7e, 0xae, 0x1c, 0xaf, 0xb4, 0x26, 0x5c, 0x68, 0xf7, 0x3f, 0x27, 0x18 },
+  { 0x4a, 0xfe, 0x52, 0x8a, 0x08, 0x2f, 0x0d, 0x00, 0x8e, 0x73, 0x19, 0xeb, 0xd4, 0x81, 0x24, 0x8d },
+  { 0x4b, 0x14, 0x3d, 0x7d, 0xcf, 0x6c, 0x96, 0x79, 0x6c, 0x37, 0x09, 0x0c, 0xba, 0x04, 0x5f, 0x4f },
+  { 0x4b, 0x20, 0x5e, 0xf7, 0x3a, 0x57, 0x79, 0xac, 0xc5, 0x75, 0x9b, 0xde, 0x3f, 0x6d, 0x33, 0xed },
+  { 0x4b, 0x27, 0xf5, 0x39, 0x7c, 0x44, 0x2d, 0x25, 0xf0, 0xc4, 0x18, 0xcc, 0xda, 0xcf, 0x19, 0x26 },
+  { 0x4b, 0x71, 0x19, 0x71, 0x53, 0xd6, 0x51, 0x48, 0x08, 0x30, 0x63, 0x8c, 0xb6, 0xa0, 0x32, 0x49 },
+  { 0x4b, 0x75, 0x3a, 0x97, 0xae, 0xe9, 0x1e, 0x4b, 0x3e, 0x4e, 0x02, 0xf5, 0xe9, 0x75, 0x8c, 0x72 },
+  { 0x4b, 0x94, 0xfd, 0x27, 0x27, 0x85, 0xd7, 0xec, 0x6c, 0x95, 0xfb, 0x72, 0x79, 0xd0, 0xf5, 0x22 },
+  { 0x4b, 0x95, 0x81, 0xc3, 0x10, 0x0a, 0x1e, 0xf0, 0x5e, 0xac, 0x15, 0x35, 0xd2, 0x53, 0x85, 0xaa },
+  { 0x4b, 0xaa, 0xda, 0x22, 0x43, 0x53, 0x20, 0xd1, 0x85, 0xc9, 0x5b, 0x7d, 0xd2, 0xbc, 0xdb, 0x24 },
+  { 0x4b, 0xcc, 0x7f, 0x6b, 0xa5, 0x01, 0xa2, 0x6e, 0xe7, 0x85, 0xb7, 0xef, 0xbf, 0xb0, 0xfd, 0xc8 },
+  { 0x4b, 0xda, 0xe9, 0x24, 0x6d, 0x6e, 0xe2, 0x58, 0xc2, 0x66, 0x65, 0x51, 0x2c, 0x1c, 0x8d, 0xe3 },
+  { 0x4c, 0x03, 0x06, 0x67, 0xd0, 0x7d, 0x14, 0x38, 0xf0, 0xe5, 0xc4, 0x58, 0xa9, 0x09, 0x78, 0xd8 },
+  { 0x4c, 0x0f, 0xb2, 0x54, 0x4a, 0xe0, 0xf8, 0xb5, 0xf7, 0xae, 0x8b, 0xce, 0x7b, 0xd7, 0xf1, 0x34 },
+  { 0x4c, 0x20, 0x5f, 0x16, 0x61, 0x57, 0x15, 0x4d, 0xf2, 0xf1, 0xef, 0x60, 0xd8, 0x7e, 0x55, 0x2f },
+  { 0x4c, 0x39, 0xa2, 0xc9, 0x79, 0x17, 0xd3, 0xd7, 0x17, 0x39, 0xb3, 0xe2, 0x1f, 0x60, 0xbb, 0xa5 },
+  { 0x4c, 0x46, 0x2b, 0x2b, 0x6f, 0xb0, 0xa1, 0x9a, 0x14, 0x37, 0xeb, 0x2c, 0x3d, 0xc2, 0x07, 0x83 },
+  { 0x4c, 0x4c, 0xe8, 0x02, 0xcb, 0xfd, 0x16, 0x0f, 0x7b, 0x3e, 0xc0, 0xf1, 0x3f, 0x2a, 0x29, 0xdf },
+  { 0x4c, 0x60, 0x62, 0x35, 0xf4, 0xec, 0x5d, 0x2a, 0x4b, 0x89, 0x13, 0x90, 0x93, 0xa6, 0x94, 0x37 },
+  { 0x4c, 0x6a, 0xfb, 0x8a, 0x44, 0xad, 0xf8, 0xe2, 0x8f, 0x49, 0x16, 0x4c, 0x84, 0x14, 0x4b, 0xfe },
+  { 0x4c, 0x88, 0x32, 0xed, 0x38, 0x7b, 0xba, 0xfc, 0x05, 0x53, 0x20, 0xc0, 0x52, 0x05, 0xbc, 0x08 },
+  { 0x4c, 0x89, 0x70, 0xf6, 0xc2, 0x94, 0xa0, 0xa5, 0x4c, 0x9c, 0x45, 0xe5, 0xe8, 0x44, 0x5f, 0x93 },
+  { 0x4c, 0x93, 0x07, 0xde, 0x72, 0x4c, 0x36, 0xfd, 0x48, 0x7a, 0xf6, 0xc9, 0x9c, 0xa0, 0x78, 0xf2 },
+  { 0x4c, 0xa0, 0x95, 0x9f, 0x84, 0x6d, 0x2b, 0xea, 0xda, 0x18, 0xec, 0xf2, 0x9e, 0xfe, 0x13, 0x7e },
+  { 0x4c, 0xa7, 0x3e, 0xb9, 0x59, 0x29, 0x94, 0x71, 0x78, 0x8f, 0x0b, 0x68, 0x5c, 0x3b, 0xa0, 0xb5 },
+  { 0x4c, 0xa9, 0x0b, 0xa4, 0x5e, 0xce, 0xd6, 0xf5, 0xad, 0x56, 0x0e, 0xa8, 0x93, 0x86, 0x41, 0xb2 },
+  { 0x4c, 0xab, 0xc8, 0x95, 0xea, 0x54, 0x60, 0x22, 0xc2, 0xec, 0xaa, 0x51, 0x29, 0x03, 0x66, 0x34 },
+  { 0x4c, 0xd7, 0x96, 0xb5, 0x91, 0x1e, 0xd3, 0xf1, 0x06, 0x2e, 0x80, 0x5a, 0x3d, 0xf3, 0x3d, 0x98 },
+  { 0x4d, 0x0a, 0x28, 0x44, 0x3f, 0x7d, 0xf5, 0xf8, 0x83, 0xcf, 0x66, 0x98, 0x94, 0x16, 0x4c, 0xfa },
+  { 0x4d, 0x2c, 0xef, 0x8f, 0x19, 0xca, 0xfe, 0xec, 0x72, 0xd1, 0x42, 0xe3, 0x4a, 0x1b, 0xbc, 0x03 },
+  { 0x4d, 0x38, 0xe1, 0x10, 0x5c, 0x3a, 0x5f, 0x0b, 0x31, 0x19, 0xa8, 0x05, 0xf2, 0x61, 0xfc, 0xb5 },
+  { 0x4d, 0x50, 0x2d, 0x6f, 0xb5, 0xb9, 0x92, 0xee, 0x05, 0x91, 0x56, 0x91, 0x44, 0x12, 0x8f, 0x99 },
+  { 0x4d, 0x5f, 0x6d, 0xb5, 0x5f, 0x7f, 0x44, 0xfd, 0x02, 0x53, 0x25, 0x8e, 0x81, 0x0b, 0xde, 0x21 },
+  { 0x4d, 0x75, 0x17, 0xae, 0x69, 0xf9, 0x5c, 0xfb, 0xc0, 0x53, 0xbe, 0x01, 0x31, 0x2b, 0x7d, 0xba },
+  { 0x4d, 0x77, 0xf2, 0x91, 0xdc, 0xa1, 0x51, 0x8d, 0x7d, 0x8e, 0x47, 0x83, 0x86, 0x95, 0xf5, 0x4b },
+  { 0x4d, 0x83, 0x96, 0xde, 0xea, 0xbb, 0x40, 0xb5, 0xe8, 0x57, 0x82, 0x76, 0xeb, 0x5a, 0x8b, 0x6d },
+  { 0x4d, 0xbf, 0x47, 0xc7, 0xf5, 0xac, 0x76, 0x7a, 0x3b, 0x07, 0x84, 0x3a, 0x53, 0x0d, 0x29, 0xa5 },
+  { 0x4d, 0xcc, 0x7e, 0x7c, 0x2e, 0xc0, 0x73, 0x8e, 0x26, 0xc8, 0x17, 0xb9, 0x38, 0x30, 0x91, 0xaf },
+  { 0x4d, 0xd6, 0xc7, 0xab, 0x9e, 0xf7, 0x7f, 0x2b, 0x49, 0x50, 0xd8, 0xfc, 0x7c, 0xd4, 0x2e, 0xe1 },
+  { 0x4d, 0xf6, 0x12, 0x40, 0x93, 0xcc, 0xb4, 0xf0, 0xb6, 0xc2, 0x6a, 0x71, 0x9f, 0x4b, 0x77, 0x06 },
+  { 0x4d, 0xf9, 0xd7, 0x35, 0x2a, 0x56, 0xa4, 0x58, 0xab, 0xb7, 0x96, 0x1b, 0xf1, 0x0a, 0xba, 0x4e },
+  { 0x4e, 0x01, 0xd9, 0x07, 0x2c, 0x50, 0x03, 0x31, 0xe6, 0x5b, 0xb8, 0x7c, 0x24, 0x02, 0x0d, 0x3f },
+  { 0x4e, 0x02, 0x88, 0x0b, 0xee, 0xb8, 0xdb, 0xd4, 0xda, 0x72, 0x4a, 0x3f, 0x33, 0xf0, 0x97, 0x1f },
+  { 0x4e, 0x15, 0xdd, 0xfd, 0x48, 0xbc, 0xa4, 0xf0, 0xbf, 0x99, 0x92, 0x40, 0xc4, 0x7b, 0x49, 0xf5 },
+  { 0x4e, 0x2c, 0x88, 0x4d, 0x04, 0xb5, 0x7b, 0x43, 0xf2, 0x3a, 0x5a, 0x2f, 0x4e, 0x9d, 0x97, 0x50 },
+  { 0x4e, 0x37, 0x99, 0x2a, 0x37, 0xea, 0x36, 0x48, 0x92, 0x83, 0xf7, 0xeb, 0x90, 0x91, 0x3b, 0xbc },
+  { 0x4e, 0x48, 0x95, 0xc3, 0x38, 0x1a, 0xa4, 0x22, 0x0f, 0x8c, 0x27, 0x95, 0xd6, 0x33, 0x82, 0x37 },
+  { 0x4e, 0x66, 0xc8, 0xe7, 0xc6, 0x70, 0x53, 0x25, 0x69, 0xc7, 0x0d, 0x20, 0x5f, 0x61, 0x5d, 0xad },
+  { 0x4e, 0x86, 0x86, 0x6d, 0x9c, 0xde, 0x73, 0x8d, 0x16, 0x30, 0xe2, 0xe3, 0x5d, 0x72, 0x88, 0xce },
+  { 0x4e, 0x99, 0xeb, 0xd6, 0x5a, 0x96, 0x7c, 0xab, 0xf3, 0x50, 0xdb, 0x54, 0x40, 0x5d, 0x57, 0x7c },
+  { 0x4e, 0xb4, 0xfd, 0x54, 0x48, 0x05, 0xba, 0xba, 0xfc, 0x37, 0x5d, 0xcd, 0xb8, 0xc2, 0xa5, 0x97 },
+  { 0x4e, 0xdb, 0x25, 0x1f, 0x5f, 0x28, 0x7c, 0x22, 0xef, 0xc6, 0x4b, 0x3a, 0x2d, 0x09, 0x55, 0x04 },
+  { 0x4f, 0x00, 0x71, 0x94, 0x6e, 0x80, 0xca, 0x68, 0xed, 0xfd, 0xcc, 0xba, 0xc8, 0x6d, 0xcc, 0xe0 },
+  { 0x4f, 0x2d, 0x47, 0x79, 0x2a, 0x06, 0xda, 0x22, 0x4b, 0xa9, 0x96, 0xc4, 0x89, 0xa8, 0x79, 0x39 },
+  { 0x4f, 0x32, 0xb2, 0x48, 0x69, 0xd8, 0xc1, 0x31, 0x0f, 0xec, 0xf0, 0x39, 0xc6, 0x42, 0x4d, 0xb6 },
+  { 0x4f, 0x61, 0x8c, 0x24, 0x29, 0x13, 0x8e, 0x02, 0x80, 0x96, 0x91, 0x93, 0xed, 0x6c, 0x10, 0x7e },
+  { 0x4f, 0x63, 0x48, 0x93, 0xd5, 0x4e, 0x9c, 0xab, 0xe1, 0x06, 0xe0, 0xec, 0x0b, 0x7b, 0xdc, 0xdf },
+  { 0x4f, 0x64, 0xd6, 0xd0, 0x69, 0x4d, 0x9b, 0x7a, 0x1e, 0xd7, 0xb0, 0xcb, 0x0b, 0x83, 0xe7, 0x59 },
+  { 0x4f, 0x67, 0x02, 0xc3, 0xba, 0x6e, 0x0e, 0xe2, 0xe2, 0x86, 0x8d, 0x05, 0x4b, 0x00, 0xc0, 0x64 },
+  { 0x4f, 0x78, 0x1f, 0x04, 0x76, 0x49, 0x3c, 0x50, 0xdc, 0x57, 0x83, 0x36, 0xf1, 0x13, 0x2a, 0x67 },
+  { 0x4f, 0x7b, 0x07, 0xec, 0x2b, 0xef, 0x5c, 0xcf, 0xfe, 0x06, 0x40, 0x3a, 0x14, 0x2f, 0x80, 0xdb },
+  { 0x4f, 0x82, 0xd8, 0xd7, 0x80, 0x99, 0xdd, 0x71, 0xe8, 0xe1, 0x69, 0x64, 0x6e, 0x79, 0x9d, 0x05 },
+  { 0x4f, 0x89, 0xb8, 0x97, 0x44, 0x4e, 0x7c, 0x3b, 0x36, 0xae, 0xd4, 0x69, 0xb8, 0x83, 0x68, 0x39 },
+  { 0x4f, 0xae, 0x08, 0x02, 0x73, 0x65, 0xd3, 0x1c, 0x55, 0x8e, 0x40, 0x0b, 0x68, 0x7a, 0xdf, 0x21 },
+  { 0x4f, 0xae, 0xb0, 0x4b, 0x1b, 0x7f, 0xb0, 0xfa, 0x25, 0xdb, 0x05, 0x75, 0x31, 0x82, 0xa8, 0x98 },
+  { 0x4f, 0xbe, 0x0f, 0x10, 0xa6, 0x32, 0x7a, 0x76, 0xf8, 0x3f, 0x83, 0x95, 0x8c, 0x3c, 0xbe, 0xff },
+  { 0x4f, 0xc1, 0xb8, 0x5b, 0x80, 0x74, 0xb4, 0xb9, 0x43, 0x6d, 0x09, 0x79, 0x00, 0xe3, 0x4f, 0x29 },
+  { 0x50, 0x20, 0x0f, 0x69, 0x7a, 0xee, 0xf3, 0x8a, 0x3c, 0xe3, 0x1c, 0x4f, 0x49, 0x73, 0x95, 0x51 },
+  { 0x50, 0x20, 0x44, 0xb1, 0xac, 0x11, 0x1b, 0x39, 0x4e, 0x6f, 0xbb, 0x0d, 0x82, 0x1f, 0xca, 0x41 },
+  { 0x50, 0x21, 0x68, 0x66, 0x0b, 0xfd, 0x9c, 0x1d, 0x26, 0x49, 0xd4, 0x15, 0xdc, 0x89, 0xc6, 0x9d },
+  { 0x50, 0x46, 0x88, 0xd4, 0x9a, 0x41, 0xbf, 0x03, 0xd8, 0xa9, 0x55, 0x51, 0x26, 0x09, 0xf3, 0xf2 },
+  { 0x50, 0x56, 0x8c, 0x80, 0xac, 0x61, 0xca, 0xb7, 0x89, 0xd9, 0x92, 0x3c, 0x9b, 0x05, 0xb6, 0x8e },
+  { 0x50, 0x69, 0xfe, 0xcb, 0xe4, 0x70, 0x63, 0x71, 0xf1, 0x77, 0x37, 0xb0, 0x35, 0x7c, 0xfa, 0x68 },
+  { 0x50, 0x79, 0xbf, 0xbc, 0x7b, 0x8f, 0x57, 0x70, 0xf8, 0x42, 0x15, 0xed, 0x2e, 0x3b, 0xdd, 0x1b },
+  { 0x50, 0xa4, 0x10, 0xa5, 0xde, 0xd0, 0xfc, 0x9a, 0xa6, 0x57, 0x6b, 0xe4, 0x5a, 0x04, 0xf2, 0x15 },
+  { 0x50, 0xc7, 0xed, 0xc9, 0xf9, 0xdc, 0x03, 0x69, 0xab, 0xcd, 0xab, 0x3b, 0x4e, 0xfe, 0xb5, 0xe9 },
+  { 0x50, 0xef, 0x88, 0xf9, 0xa5, 0xe0, 0xe1, 0xe6, 0xb8, 0x6e, 0x17, 0x53, 0x62, 0xa2, 0x7f, 0xdb },
+  { 0x51, 0x2e, 0x87, 0x4a, 0x24, 0x07, 0x31, 0xd7, 0x37, 0x85, 0x86, 0xa0, 0x5f, 0x28, 0xae, 0xc6 },
+  { 0x51, 0x31, 0xab, 0x37, 0x97, 0xfe, 0x8c, 0x12, 0x7e, 0x3e, 0x13, 0x5b, 0x18, 0xb4, 0xd2, 0xc8 },
+  { 0x51, 0x4f, 0x91, 0x1e, 0xcf, 0xf2, 0xbe, 0x5e, 0xef, 0xf2, 0xf3, 0x9c, 0x49, 0xa9, 0x72, 0x5c },
+  { 0x51, 0x50, 0x46, 0xe3, 0x06, 0x1b, 0x7b, 0x18, 0xaa, 0x3a, 0x55, 0x1c, 0x3a, 0xe1, 0x26, 0x73 },
+  { 0x51, 0x6f, 0xfd, 0x00, 0x80, 0x57, 0xa1, 0xd7, 0x8d, 0x00, 0x7c, 0x85, 0x1e, 0x6e, 0xff, 0x37 },
+  { 0x51, 0x75, 0x92, 0xe6, 0xe0, 0xc7, 0x17, 0x31, 0x01, 0x9c, 0x0c, 0xeb, 0xc2, 0xce, 0x04, 0x4f },
+  { 0x51, 0x79, 0x23, 0xe6, 0x55, 0x75, 0x50, 0x86, 0xa3, 0xb7, 0x2c, 0x0b, 0x17, 0xb4, 0x30, 0xe6 },
+  { 0x51, 0x88, 0xfe, 0xe0, 0x71, 0xd3, 0xc5, 0xef, 0x0d, 0x66, 0xfb, 0x45, 0xc1, 0x23, 0xe4, 0xa5 },
+  { 0x51, 0x9f, 0x00, 0x7c, 0x0e, 0x14, 0xfb, 0x90, 0x20, 0x8d, 0xbb, 0x51, 0x99, 0xdf, 0xb6, 0x04 },
+  { 0x51, 0xde, 0x32, 0x8e, 0x79, 0xd9, 0x19, 0xd7, 0x23, 0x4c, 0xf1, 0x9c, 0x1c, 0xd7, 0x7f, 0xbc },
+  { 0x51, 0xe3, 0x90, 0x42, 0x4f, 0x20, 0xe4, 0x68, 0xd2, 0xb4, 0x80, 0x03, 0x0c, 0xe9, 0x5d, 0x7b },
+  { 0x51, 0xf1, 0x5b, 0x39, 0xd9, 0xf5, 0x02, 0xc2, 0x36, 0x1b, 0x6b, 0xa6, 0xa7, 0x34, 0x64, 0xd4 },
+  { 0x51, 0xf2, 0x11, 0xc8, 0xfc, 0x87, 0x93, 0x91, 0xfe, 0xe2, 0x6e, 0xdf, 0xa7, 0xd3, 0xf1, 0x1c },
+  { 0x52, 0x1f, 0x4d, 0xd1, 0xeb, 0x84, 0xa0, 0x9b, 0x2b, 0x19, 0x95, 0x9a, 0x41, 0x83, 0x9a, 0xad },
+  { 0x52, 0x2c, 0x9c, 0xf6, 0x84, 0xec, 0xd7, 0x2d, 0xb2, 0xf8, 0x50, 0x53, 0xe6, 0xf6, 0xf7, 0x20 },
+  { 0x52, 0x38, 0x53, 0x34, 0xac, 0x9e, 0x9b, 0x71, 0x3e, 0x13, 0xff, 0xa4, 0xcc, 0x5c, 0xb9, 0x40 },
+  { 0x52, 0x3f, 0x5c, 0xbb, 0x99, 0x2f, 0x12, 0x1e, 0x2d, 0x10, 0x0f, 0x0f, 0x99, 0x65, 0xe3, 0x3f },
+  { 0x52, 0x46, 0x93, 0xb3, 0x37, 0xf7, 0xec, 0xc9, 0xe8, 0xb9, 0x12, 0x6e, 0x04, 0xa2, 0x32, 0xaf },
+  { 0x52, 0x56, 0xf6, 0x8d, 0x14, 0x91, 0x98, 0x6a, 0xae, 0x5c, 0xfd, 0xff, 0x53, 0x9b, 0xfe, 0xb5 },
+  { 0x52, 0x5e, 0xa7, 0x47, 0xd7, 0x46, 0xf3, 0xe8, 0x0e, 0x30, 0x27, 0x72, 0x0e, 0x1f, 0xa7, 0xac },
+  { 0x52, 0x5f, 0x2d, 0xfc, 0x8b, 0x21, 0xb0, 0x18, 0x6c, 0xff, 0x25, 0x68, 0xe0, 0x50, 0x9b, 0xfc },
+  { 0x52, 0x61, 0x5a, 0xe3, 0x58, 0xa6, 0x8d, 0xe6, 0xe7, 0x64, 0x67, 0xe9, 0x5e, 0xb4, 0x04, 0xc7 },
+  { 0x52, 0x84, 0x00, 0xfa, 0xd9, 0xa7, 0x7f, 0xd5, 0xad, 0x7f, 0xc5, 0xfd, 0xc2, 0xb7, 0xd6, 0x9d },
+  { 0x52, 0xa0, 0x00, 0x3e, 0xfb, 0x3b, 0x1c, 0x49, 0xfc, 0xde, 0x4d, 0xbc, 0x2c, 0x68, 0x5d, 0x8f },
+  { 0x52, 0xb4, 0x48, 0x75, 0x70, 0x81, 0xfd, 0x9f, 0xab, 0xf8, 0x59, 0xf4, 0xe2, 0xf9, 0x1f, 0x6b },
+  { 0x52, 0xba, 0xe1, 0x72, 0x6d, 0x2d, 0x7a, 0x53, 0x1c, 0x9c, 0xa8, 0x1e, 0x25, 0x37, 0x7f, 0xc3 },
+  { 0x52, 0xe1, 0x95, 0x4d, 0xc0, 0x14, 0x54, 0xc0, 0x3a, 0x33, 0x6b, 0x30, 0xc3, 0x90, 0xfb, 0x8d },
+  { 0x52, 0xe9, 0xdb, 0x3f, 0xe8, 0xb5, 0xd3, 0x36, 0x84, 0x3a, 0xca, 0xc2, 0x34, 0xaa, 0xea, 0x79 },
+  { 0x53, 0x05, 0xf6, 0x9f, 0xbf, 0x77, 0x2f, 0xac, 0x47, 0x60, 0xcd, 0xcf, 0x87, 0xf1, 0xab, 0x1f },
+  { 0x53, 0x24, 0xcf, 0x5b, 0x6d, 0xc1, 0x7a, 0xf4, 0xc6, 0x4b, 0xf8, 0x69, 0x6c, 0x39, 0xc2, 0xc1 },
+  { 0x53, 0x36, 0xf8, 0x6f, 0x6b, 0x98, 0x2c, 0xc9, 0x25, 0x53, 0x2f, 0x2e, 0x80, 0xaa, 0x1e, 0x17 },
+  { 0x53, 0x4e, 0x23, 0x21, 0x0d, 0xd1, 0x99, 0x3c, 0x82, 0x8d, 0x94, 0x4c, 0x6a, 0xc4, 0xd9, 0xfb },
+  { 0x53, 0x55, 0xf8, 0x0c, 0xac, 0xf0, 0xe6, 0x3a, 0x49, 0xcb, 0xf4, 0xad, 0xe4, 0xe2, 0x70, 0x34 },
+  { 0x53, 0x60, 0x69, 0x3f, 0x1e, 0xb9, 0x08, 0x56, 0x17, 0x6b, 0xd1, 0xc0, 0xa7, 0xb1, 0x74, 0x32 },
+  { 0x53, 0x7e, 0xd1, 0xe0, 0xd8, 0x0e, 0x6c, 0x9f, 0x75, 0x2b, 0x33, 0xea, 0x7a, 0xcb, 0xe0, 0x79 },
+  { 0x53, 0x85, 0xcf, 0x2a, 0x04, 0xde, 0x1d, 0x36, 0xab, 0x55, 0xc7, 0x31, 0x74, 0xb8, 0x4d, 0xb0 },
+  { 0x53, 0x9b, 0x70, 0x38, 0xac, 0xec, 0x0c, 0xce, 0xde, 0xae, 0x40, 0xf2, 0x38, 0x99, 0x85, 0x79 },
+  { 0x53, 0x9d, 0x26, 0xb6, 0xe9, 0xdf, 0x0d, 0xa8, 0xe7, 0x46, 0x5f, 0x0f, 0x5a, 0xd8, 0x63, 0xb7 },
+  { 0x53, 0xb6, 0x6f, 0x11, 0xf6, 0x7c, 0x3b, 0x53, 0xb2, 0x99, 0x5e, 0x0e, 0x02, 0x01, 0x7b, 0xd7 },
+  { 0x53, 0xd1, 0x81, 0xcd, 0xe2, 0xe0, 0x21, 0x9b, 0x57, 0x54, 0xca, 0xad, 0x24, 0x6f, 0xcb, 0x66 },
+  { 0x53, 0xf1, 0x47, 0xb9, 0x74, 0x6f, 0xdc, 0x99, 0x7c, 0x62, 0xf3, 0xdd, 0x67, 0x88, 0x8e, 0xe5 },
+  { 0x54, 0x00, 0x75, 0xf6, 0x57, 0xd4, 0xb2, 0x44, 0xa1, 0xf7, 0x4d, 0xa1, 0xb9, 0xe4, 0xbf, 0x92 },
+  { 0x54, 0x09, 0xd2, 0x0c, 0x1a, 0xea, 0x0b, 0x89, 0xc5, 0x69, 0x93, 0xae, 0xc5, 0xdc, 0x57, 0x40 },
+  { 0x54, 0x28, 0xcd, 0xfa, 0xda, 0x28, 0x1c, 0x56, 0x9c, 0x74, 0xc7, 0x30, 0x8c, 0x7f, 0x2c, 0x26 },
+  { 0x54, 0x2c, 0x6d, 0xd5, 0xf7, 0x28, 0x01, 0x79, 0xb5, 0x19, 0x17, 0xa4, 0xcb, 0xa4, 0xfa, 0xff },
+  { 0x54, 0x38, 0xe8, 0x4b, 0x90, 0xe5, 0x0a, 0x53, 0x62, 0xf0, 0x1c, 0xc8, 0x43, 0xb3, 0x58, 0xd4 },
+  { 0x54, 0x3b, 0x4b, 0x8f, 0xf1, 0xd6, 0x16, 0xfa, 0x25, 0x0c, 0x64, 0x8b, 0xe4, 0x28, 0xa7, 0x5c },
+  { 0x54, 0x50, 0x48, 0xcc, 0xb0, 0x45, 0xf9, 0xef, 0xc6, 0xcf, 0x2b, 0x12, 0x5c, 0xd0, 0xdf, 0xa8 },
+  { 0x54, 0x78, 0x5f, 0xa2, 0x9e, 0x28, 0xaa, 0xe6, 0x03, 0x89, 0x29, 0xba, 0x29, 0xd3, 0x3d, 0x38 },
+  { 0x54, 0x94, 0xb9, 0xee, 0x40, 0x3d, 0x97, 0x57, 0xf0, 0xfd, 0x1f, 0x74, 0x9e, 0x80, 0x21, 0x4a },
+  { 0x54, 0xa1, 0xc1, 0x25, 0x5e, 0xd4, 0x5e, 0xb8, 0xf7, 0x14, 0x14, 0xda, 0xdb, 0x1c, 0xf6, 0x69 },
+  { 0x54, 0xba, 0xfc, 0x29, 0x94, 0x23, 0xf5, 0xa5, 0x0b, 0x8b, 0xc3, 0xa7, 0x97, 0x91, 0x47, 0x06 },
+  { 0x54, 0xda, 0x3b, 0x0b, 0x3f, 0x43, 0xf5, 0xb3, 0x79, 0x11, 0xc1, 0x35, 0xb9, 0x43, 0x2b, 0x49 },
+  { 0x54, 0xf7, 0xef, 0xa6, 0x42, 0x8f, 0x14, 0xb9, 0xf6, 0x10, 0xad, 0x0c, 0xa7, 0x57, 0xe2, 0x6c },
+  { 0x55, 0x1a, 0x64, 0xa9, 0x45, 0xd7, 0xd6, 0xec, 0xe8, 0x1e, 0x9c, 0x10, 0x47, 0xac, 0xed, 0xbc },
+  { 0x55, 0x1e, 0xf7, 0x55, 0x93, 0xec, 0x18, 0xd0, 0x78, 0xe8, 0xf5, 0xcc, 0x02, 0x29, 0xe1, 0xc4 },
+  { 0x55, 0x24, 0x71, 0x8a, 0x19, 0x10, 0x7a, 0x04, 0xec, 0x32, 0x65, 0xc9, 0x31, 0x36, 0xa7, 0xb5 },
+  { 0x55, 0x7e, 0x89, 0x36, 0x16, 0x64, 0x8c, 0x37, 0xa2, 0x7a, 0xab, 0x5a, 0x47, 0xac, 0xbf, 0x10 },
+  { 0x55, 0x93, 0x17, 0x71, 0x2f, 0x98, 0x9f, 0x09, 0x7e, 0xa4, 0x64, 0x51, 0x7f, 0x1a, 0x83, 0x18 },
+  { 0x55, 0x94, 0x9c, 0xb7, 0x88, 0x4f, 0x9d, 0xb0, 0xf8, 0xdf, 0xcf, 0x87, 0x07, 0xc7, 0xe5, 0xcb },
+  { 0x55, 0xac, 0xe3, 0xc7, 0x75, 0xf4, 0x2e, 0xb4, 0x6f, 0x08, 0xbb, 0x1d, 0xca, 0x91, 0x14, 0xe7 },
+  { 0x55, 0xef, 0x6a, 0xb2, 0x32, 0x1c, 0xa0, 0xc3, 0xd3, 0x69, 0xe6, 0x3d, 0x59, 0xc0, 0x59, 0xc8 },
+  { 0x55, 0xef, 0x7b, 0x65, 0x06, 0x64, 0x28, 0x36, 0x78, 0x44, 0x34, 0x2e, 0xd5, 0x9f, 0x95, 0x6c },
+  { 0x56, 0x2a, 0xcb, 0x1b, 0x7f, 0xf1, 0x82, 0xab, 0xa1, 0x33, 0xbd, 0xa8, 0xe2, 0x1a, 0xd7, 0xc1 },
+  { 0x56, 0x2b, 0xf0, 0x2f, 0x50, 0x31, 0xd5, 0x1c, 0x6b, 0x53, 0xb0, 0x39, 0x72, 0xa5, 0x6b, 0x22 },
+  { 0x56, 0x30, 0x0e, 0xd3, 0x1f, 0xef, 0x01, 0x8b, 0xd9, 0x67, 0x68, 0xcc, 0xc9, 0x82, 0xf7, 0xb4 },
+  { 0x56, 0x41, 0xc0, 0xff, 0x70, 0x76, 0x30, 0xd2, 0xdd, 0x82, 0x9b, 0x26, 0xa9, 0xf2, 0xe9, 0x8f },
+  { 0x56, 0x43, 0xee, 0x91, 0x6f, 0x7d, 0xc7, 0x60, 0x14, 0x8f, 0xca, 0x4d, 0xb3, 0xaa, 0x7d, 0x10 },
+  { 0x56, 0x78, 0xeb, 0xaa, 0x09, 0xca, 0x3b, 0x69, 0x95, 0x16, 0xdb, 0xa4, 0x67, 0x16, 0x43, 0xed },
+  { 0x56, 0x83, 0x71, 0xfb, 0xae, 0x6f, 0x5e, 0x5b, 0x93, 0x6a, 0xf8, 0x00, 0x31, 0xcd, 0x88, 0x88 },
+  { 0x57, 0x1c, 0x6d, 0x9b, 0xc7, 0x1c, 0xb9, 0x76, 0x17, 0x42, 0x28, 0x51, 0xf7, 0x87, 0xf8, 0xfe },
+  { 0x57, 0x2d, 0x0a, 0x46, 0x33, 0xd6, 0xa9, 0x40, 0x7d, 0x3b, 0xa8, 0x30, 0x83, 0x53, 0x6e, 0x0f },
+  { 0x57, 0x5c, 0x0f, 0xb6, 0x1e, 0x66, 0xa3, 0x1d, 0x98, 0x2c, 0x95, 0xc9, 0xde, 0xa6, 0x86, 0x5c },
+  { 0x57, 0x93, 0x9b, 0x32, 0x6d, 0xf8, 0x6b, 0x74, 0xca, 0x64, 0x04, 0xf6, 0x4f, 0x89, 0xfc, 0xe9 },
+  { 0x57, 0x9b, 0xaa, 0x6a, 0x4a, 0xa4, 0x4f, 0x03, 0x5d, 0x24, 0x59, 0x08, 0xea, 0x7a, 0x04, 0x4d },
+  { 0x57, 0xa6, 0x6b, 0x6d, 0xb7, 0xef, 0xc5, 0xdf, 0x17, 0xb0, 0xb0, 0xf2, 0xf2, 0xc2, 0xf0, 0x78 },
+  { 0x57, 0xc5, 0xb3, 0x51, 0xd4, 0xde, 0x02, 0x17, 0x85, 0xcf, 0x8e, 0xd8, 0x19, 0x1a, 0x19, 0x5c },
+  { 0x58, 0x35, 0xa7, 0x8a, 0x88, 0xf9, 0x7a, 0xce, 0xa3, 0x8c, 0x96, 0x49, 0x80, 0xb7, 0xdb, 0xc6 },
+  { 0x58, 0x46, 0xb1, 0xd3, 0x4c, 0x29, 0x6b, 0xf7, 0xaf, 0xc2, 0xfa, 0x05, 0xbb, 0xc1, 0x6e, 0x98 },
+  { 0x58, 0x51, 0x3b, 0xae, 0x77, 0x43, 0x60, 0xb9, 0x68, 0x66, 0xa0, 0x7c, 0xa0, 0xe8, 0xfd, 0x8e },
+  { 0x58, 0x56, 0x00, 0x52, 0x2b, 0x1f, 0x22, 0xf6, 0x17, 0x65, 0x2c, 0x96, 0x2e, 0x35, 0x8a, 0x5d },
+  { 0x58, 0x5f, 0x73, 0x01, 0x0e, 0x20, 0x5a, 0xe5, 0xb0, 0x4e, 0xe5, 0xc1, 0xa6, 0x7e, 0x63, 0x2d },
+  { 0x58, 0x64, 0xca, 0xb0, 0xbc, 0x21, 0xa6, 0x0b, 0xe3, 0x85, 0x3b, 0x6b, 0xcd, 0x50, 0xc5, 0x9f },
+  { 0x58, 0x74, 0x62, 0x19, 0xd8, 0x09, 0x4e, 0xdf, 0xf8, 0x69, 0xf0, 0xf5, 0xc2, 0xae, 0xaa, 0xd5 },
+  { 0x58, 0x94, 0xc9, 0xc0, 0xc1, 0xe7, 0xe2, 0x9f, 0x3a, 0xb8, 0x6c, 0x6d, 0x3f, 0x67, 0x33, 0x61 },
+  { 0x58, 0x9c, 0x73, 0xbb, 0xcd, 0x77, 0xdb, 0x79, 0x8c, 0xb9, 0x2a, 0x99, 0x2b, 0x4c, 0x06, 0xc3 },
+  { 0x58, 0xa8, 0x2e, 0x1d, 0xa6, 0x4a, 0x69, 0x2f, 0xd7, 0x27, 0xc2, 0x5f, 0xae, 0xf2, 0xec, 0xc9 },
+  { 0x58, 0xc3, 0x96, 0x32, 0x3e, 0xa3, 0xe8, 0x56, 0x71, 0xe3, 0x4c, 0x98, 0xeb, 0x54, 0xe2, 0xa4 },
+  { 0x58, 0xd3, 0x31, 0xc2, 0x32, 0x97, 0xed, 0x98, 0x66, 0x3d, 0x11, 0xb8, 0x69, 0x63, 0x6f, 0x16 },
+  { 0x58, 0xe3, 0x13, 0xe2, 0xb5, 0x61, 0x3b, 0x24, 0x39, 0xb5, 0xf1, 0x2b, 0xb4, 0x1e, 0x3e, 0xef },
+  { 0x59, 0x0a, 0xc7, 0x1f, 0xa5, 0xf7, 0x1d, 0x3e, 0xb2, 0x9c, 0x41, 0x02, 0x3b, 0x09, 0xad, 0xe9 },
+  { 0x59, 0x13, 0x5f, 0x13, 0x98, 0x5b, 0x84, 0xc4, 0xf1, 0x3c, 0xc9, 0xe5, 0x5e, 0xec, 0x86, 0x9a },
+  { 0x59, 0x4d, 0xbc, 0x80, 0xb9, 0x3f, 0xa5, 0x80, 0x4e, 0x0f, 0x13, 0x68, 0xc0, 0x37, 0x33, 0x1d },
+  { 0x59, 0x61, 0xd2, 0x59, 0x11, 0x5e, 0x99, 0xc3, 0x0b, 0x64, 0xfe, 0x70, 0x58, 0x25, 0x6b, 0xcf },
+  { 0x59, 0x73, 0x4e, 0x1c, 0xc4, 0x18, 0x22, 0x37, 0x38, 0x45, 0xa0, 0x9c, 0x51, 0xe6, 0xba, 0x21 },
+  { 0x59, 0x8a, 0x4e, 0x6e, 0x12, 0xf8, 0x23, 0x8b, 0x7e, 0x75, 0x55, 0xf5, 0xa7, 0x77, 0x7b, 0x46 },
+  { 0x59, 0x9c, 0xbf, 0x91, 0x9d, 0x47, 0xa0, 0x5a, 0xf9, 0x75, 0xad, 0x44, 0x7d, 0xf2, 0x94, 0x97 },
+  { 0x59, 0xb7, 0x06, 0x58, 0xf9, 0xdd, 0x0e, 0x20, 0x75, 0x77, 0x0b, 0x07, 0xbe, 0x1a, 0x35, 0xcf },
+  { 0x59, 0xd3, 0x3e, 0x00, 0xc0, 0x76, 0x65, 0x39, 0x52, 0x09, 0xc1, 0xe5, 0x5d, 0xa0, 0xb1, 0x39 },
+  { 0x59, 0xe5, 0x38, 0x94, 0xb3, 0x89, 0x9e, 0xe1, 0x64, 0xc9, 0x1c, 0xfa, 0x78, 0x42, 0xda, 0x66 },
+  { 0x59, 0xe9, 0x6d, 0xe9, 0x62, 0x8e, 0x83, 0x73, 0xd1, 0xc6, 0x85, 0xf5, 0xe5, 0x7d, 0xcf, 0x10 },
+  { 0x59, 0xf5, 0x96, 0x28, 0x5d, 0x17, 0x42, 0x33, 0xc8, 0x45, 0x97, 0xde, 0xe6, 0xf3, 0x4f, 0x1f },
+  { 0x5a, 0x0f, 0xf9, 0x9b, 0xa1, 0x0b, 0xd2, 0x6d, 0x54, 0x2e, 0x1d, 0x6f, 0x59, 0xf5, 0x68, 0x50 },
+  { 0x5a, 0x17, 0xe3, 0x0e, 0x6e, 0x91, 0x1e, 0x74, 0xcc, 0xd7, 0xb7, 0x16, 0xd0, 0x2b, 0x16, 0xc6 },
+  { 0x5a, 0x27, 0x20, 0x12, 0xa6, 0x2b, 0xec, 0xab, 0xcd, 0x52, 0x92, 0x03, 0x48, 0xc7, 0xc6, 0x0b },
+  { 0x5a, 0x2f, 0x2d, 0xcd, 0x77, 0x52, 0x07, 0x53, 0x6d, 0x92, 0x99, 0xe7, 0x68, 0xbc, 0xd2, 0xdf },
+  { 0x5a, 0x53, 0x90, 0xf9, 0x14, 0x37, 0xaf, 0x99, 0x51, 0xa5, 0xf8, 0x45, 0x5b, 0x61, 0xcd, 0x43 },
+  { 0x5a, 0x6f, 0xeb, 0xb9, 0x55, 0x44, 0x83, 0xd8, 0xc7, 0x1c, 0x86, 0xa8, 0x4a, 0x0a, 0xa7, 0x4e },
+  { 0x5a, 0x73, 0x47, 0x79, 0xd7, 0x97, 0xcc, 0xef, 0x25, 0xdc, 0x8a, 0xcf, 0xa4, 0x72, 0x44, 0xc7 },
+  { 0x5a, 0x80, 0xb8, 0x57, 0xeb, 0x8b, 0x90, 0x8a, 0xb4, 0x77, 0xec, 0x4e, 0xf9, 0x02, 0xed, 0xc8 },
+  { 0x5a, 0x81, 0xad, 0x4e, 0x18, 0x40, 0x50, 0x85, 0x1e, 0x63, 0xc8, 0xe1, 0x6e, 0x3d, 0xac, 0x77 },
+  { 0x5a, 0x8a, 0xfe, 0x54, 0x22, 0xab, 0xbf, 0xb0, 0xa3, 0x42, 0xfb, 0x15, 0xaf, 0xd7, 0x41, 0x5f },
+  { 0x5a, 0x93, 0x26, 0x50, 0x95, 0x14, 0x64, 0x58, 0xdf, 0x2b, 0xaf, 0x21, 0x62, 0x01, 0x48, 0x89 },
+  { 0x5a, 0x96, 0x85, 0xc4, 0xd5, 0x1a, 0x6c, 0x1d, 0x6a, 0x95, 0x44, 0x94, 0x6d, 0x9e, 0x8d, 0xc3 },
+  { 0x5a, 0x9d, 0x18, 0x82, 0x45, 0xaf, 0xf8, 0x29, 0xef, 0xde, 0x81, 0x6f, 0xca, 0xde, 0x0b, 0x16 },
+  { 0x5a, 0xcf, 0x98, 0x65, 0xa7, 0x2c, 0x0c, 0xe9, 0x44, 0x97, 0x9f, 0x76, 0xff, 0x96, 0x10, 0xf0 },
+  { 0x5a, 0xe7, 0x39, 0x16, 0xfa, 0x1d, 0xa8, 0xd3, 0x8c, 0xef, 0xf6, 0x74, 0xfa, 0x25, 0xa7, 0x8a },
+  { 0x5a, 0xea, 0x99, 0x74, 0xb9, 0x75, 0xa6, 0xa8, 0x44, 0xe6, 0xdf, 0x10, 0xd2, 0xb8, 0x61, 0xc4 },
+  { 0x5a, 0xf9, 0xcd, 0x34, 0x62, 0x66, 0xa1, 0xf2, 0x51, 0x5e, 0x1f, 0xbc, 0x86, 0xf5, 0x18, 0x6a },
+  { 0x5b, 0x12, 0x48, 0x50, 0xde, 0x9e, 0xea, 0x66, 0x78, 0x1a, 0x50, 0xb2, 0xe9, 0x83, 0x70, 0x00 },
+  { 0x5b, 0x57, 0x4f, 0xaa, 0x56, 0x83, 0x6d, 0xa0, 0x86, 0x6b, 0xa3, 0x2a, 0xe3, 0x25, 0x47, 0xf2 },
+  { 0x5b, 0x5d, 0x04, 0x88, 0x79, 0x22, 0xb4, 0x30, 0xde, 0x0b, 0x7b, 0x2a, 0x21, 0xf9, 0xcd, 0x25 },
+  { 0x5b, 0x6f, 0x5b, 0xcb, 0xbd, 0xe4, 0x2f, 0xc7, 0x7d, 0x0b, 0xdb, 0x31, 0x46, 0x69, 0x35, 0x65 },
+  { 0x5b, 0x7e, 0xa6, 0xaa, 0x6b, 0x35, 0xdc, 0x94, 0x7c, 0x65, 0xce, 0x66, 0x5f, 0xde, 0x62, 0x4b },
+  { 0x5b, 0x85, 0xe9, 0x87, 0xe2, 0xb1, 0x61, 0x87, 0x69, 0xd9, 0x7b, 0xa9, 0x18, 0x23, 0x33, 0xd0 },
+  { 0x5b, 0x92, 0xa9, 0x3b, 0x23, 0x52, 0x3f, 0xf1, 0x6e, 0x27, 0x89, 0xb8, 0x20, 0xe2, 0xa4, 0xc5 },
+  { 0x5b, 0x98, 0xe0, 0x53, 0x6c, 0x3f, 0x60, 0x54, 0x7d, 0xd7, 0x08, 0xae, 0x22, 0xad, 0xb0, 0x4b },
+  { 0x5b, 0x9c, 0x2e, 0x00, 0x12, 0xfb, 0xfd, 0x29, 0xef, 0xd3, 0x30, 0x63, 0x59, 0xbb, 0xfc, 0x4a },
+  { 0x5b, 0xab, 0xe0, 0xca, 0xd3, 0xec, 0x99, 0xd7, 0x6b, 0x0a, 0xa1, 0xd3, 0x6a, 0x69, 0x5d, 0x2f },
+  { 0x5b, 0xba, 0x25, 0x4e, 0x18, 0x25, 0x7e, 0x57, 0x8c, 0x24, 0x5e, 0xd9, 0x6f, 0x6b, 0x00, 0x3b },
+  { 0x5b, 0xba, 0xb3, 0xf3, 0xe4, 0xb4, 0x7e, 0x3e, 0x23, 0xf9, 0x82, 0x07, 0x65, 0xdb, 0xb4, 0x5c },
+  { 0x5b, 0xc9, 0x99, 0x8b, 0x7e, 0x9a, 0x97, 0x0e, 0x31, 0xd2, 0xcb, 0x60, 0xe8, 0x69, 0x6c, 0xc4 },
+  { 0x5b, 0xcc, 0x83, 0x67, 0x7d, 0x68, 0xf7, 0xef, 0x74, 0xc1, 0xb4, 0xa0, 0x69, 0x7b, 0xa2, 0xa8 },
+  { 0x5b, 0xd7, 0x91, 0x39, 0xa0, 0xc0, 0x3b, 0x63, 0xf6, 0xf2, 0xcf, 0x00, 0xa7, 0xd3, 0x85, 0xd2 },
+  { 0x5b, 0xe0, 0x3a, 0x1f, 0xe7, 0xb2, 0xc1, 0x14, 0x72, 0x51, 0x50, 0xbe, 0x04, 0xb3, 0x87, 0x04 },
+  { 0x5c, 0x02, 0x27, 0xad, 0x63, 0x30, 0x06, 0x70, 0xa6, 0x47, 0xfc, 0xeb, 0xf5, 0x95, 0xea, 0x37 },
+  { 0x5c, 0x05, 0x20, 0xc0, 0x01, 0x63, 0x91, 0x5a, 0x43, 0x36, 0xe4, 0x81, 0xca, 0x4e, 0x7e, 0xf4 },
+  { 0x5c, 0x19, 0xf6, 0xda, 0x63, 0x8c, 0x4c, 0x7c, 0x1f, 0x98, 0xd0, 0x9e, 0x63, 0xdf, 0x43, 0xe4 },
+  { 0x5c, 0x1b, 0x1a, 0xa7, 0x8b, 0x76, 0x09, 0xd4, 0x3c, 0x51, 0x44, 0xc3, 0xb3, 0xb6, 0x0a, 0xdf },
+  { 0x5c, 0x3a, 0x6d, 0x27, 0xc0, 0x26, 0xf5, 0x9a, 0x96, 0xb7, 0xaf, 0x91, 0xe8, 0xb1, 0xbf, 0x26 },
+  { 0x5c, 0x61, 0x8a, 0x50, 0xdf, 0xa2, 0x3d, 0xaa, 0xc9, 0x7b, 0xa4, 0x59, 0xb9, 0xff, 0x52, 0x06 },
+  { 0x5c, 0x73, 0x69, 0x3a, 0x89, 0xb0, 0x6e, 0x5a, 0x09, 0xf1, 0x72, 0x1a, 0x13, 0x17, 0x6f, 0x95 },
+  { 0x5c, 0x86, 0xe9, 0x38, 0xe0, 0x84, 0x5b, 0x9d, 0x61, 0xf4, 0x58, 0x53, 0x9e, 0x9a, 0x55, 0x2b },
+  { 0x5c, 0xbd, 0x7c, 0x31, 0x44, 0x3f, 0xb9, 0xc3, 0x08, 0xe9, 0xf0, 0xb5, 0x4d, 0x94, 0xa3, 0x95 },
+  { 0x5c, 0xe9, 0x8f, 0x22, 0xad, 0xe9, 0x15, 0x10, 0x88, 0x60, 0x42, 0x4d, 0x8d, 0xde, 0x0d, 0x35 },
+  { 0x5d, 0x0e, 0x8a, 0x25, 0xcb, 0xd2, 0x3e, 0x76, 0xf8, 0x43, 0xc7, 0x5a, 0x86, 0xb7, 0xe1, 0x5b },
+  { 0x5d, 0x13, 0x2d, 0x12, 0x1a, 0xab, 0xc5, 0x23, 0x5d, 0xd0, 0x39, 0xdf, 0xc4, 0x6a, 0xa0, 0x24 },
+  { 0x5d, 0x25, 0xdf, 0x9d, 0xc2, 0xcd, 0xe7, 0x46, 0xce, 0xac, 0x48, 0xe8, 0x34, 0xcf, 0x84, 0xa7 },
+  { 0x5d, 0x2c, 0xc3, 0x3c, 0xa7, 0x98, 0x78, 0x3d, 0xee, 0x43, 0x5e, 0xb2, 0x9d, 0xeb, 0xf6, 0xd6 },
+  { 0x5d, 0x79, 0x9b, 0xfa, 0x9e, 0x1e, 0x7b, 0x62, 0x24, 0x87, 0x71, 0x62, 0xac, 0xca, 0xda, 0x0d },
+  { 0x5d, 0x8f, 0x1a, 0xb9, 0x53, 0x62, 0xac, 0xdf, 0x34, 0x26, 0xd5, 0x72, 0xa6, 0x30, 0x1b, 0xf2 },
+  { 0x5d, 0x8f, 0xb1, 0x48, 0x60, 0xc2, 0xf1, 0x98, 0x47, 0x2b, 0x23, 0x38, 0x74, 0xf6, 0xb0, 0xc9 },
+  { 0x5d, 0x95, 0x92, 0x75, 0x64, 0x25, 0x19, 0x2e, 0xc6, 0x21, 0xd2, 0x61, 0x3d, 0x0e, 0x68, 0x3d },
+  { 0x5d, 0xa8, 0xfd, 0x0b, 0x5e, 0xd3, 0x3a, 0x36, 0x0b, 0xff, 0x37, 0xf8, 0xb5, 0xd0, 0xcd, 0x58 },
+  { 0x5d, 0xae, 0x54, 0x03, 0x47, 0xcf, 0x0a, 0x55, 0x99, 0x62, 0xd6, 0x26, 0x04, 0xec, 0xf7, 0x50 },
+  { 0x5d, 0xb9, 0xe5, 0xbf, 0x66, 0x3c, 0xad, 0x6b, 0xf1, 0x59, 0xbc, 0x39, 0x5f, 0x6e, 0xad, 0x53 },
+  { 0x5d, 0xcc, 0xf2, 0x15, 0xfd, 0xb9, 0xbb, 0xf5, 0xd4, 0xa6, 0xd0, 0x13, 0x9e, 0x5e, 0x8b, 0xcb },
+  { 0x5d, 0xe8, 0x80, 0x3a, 0x59, 0xc3, 0x67, 0x25, 0x88, 0x83, 0x46, 0xfd, 0xc6, 0xe7, 0x42, 0x9d },
+  { 0x5d, 0xf3, 0x24, 0x50, 0xb9, 0xfb, 0xca, 0xf4, 0x3f, 0x9d, 0x83, 0xbd, 0x66, 0xbd, 0x5a, 0x81 },
+  { 0x5d, 0xf5, 0x59, 0xa3, 0x63, 0x47, 0xd8, 0x57, 0x2f, 0x9a, 0x6e, 0x80, 0x75, 0xa3, 0x13, 0x22 },
+  { 0x5e, 0x0c, 0x37, 0xf5, 0x34, 0xab, 0x5c, 0xcc, 0x46, 0x61, 0x76, 0x8e, 0x2d, 0xdf, 0x01, 0x62 },
+  { 0x5e, 0x1b, 0x46, 0x29, 0x42, 0x6f, 0x49, 0x92, 0xcf, 0x3b, 0x29, 0x05, 0xa6, 0x96, 0xe1, 0xa7 },
+  { 0x5e, 0x1b, 0x7a, 0x60, 0x78, 0xaf, 0x42, 0x8e, 0xf0, 0x56, 0xfe, 0x85, 0xa3, 0x7a, 0x95, 0xca },
+  { 0x5e, 0x1c, 0xd1, 0x1a, 0x6d, 0x41, 0xfc, 0x15, 0xcf, 0x47, 0x92, 0x25, 0x74, 0x00, 0xa3, 0x1e },
+  { 0x5e, 0x20, 0x1d, 0x6b, 0xfc, 0x52, 0x04, 0x24, 0xa2, 0x8f, 0x12, 0x9e, 0xe5, 0xe5, 0x68, 0x35 },
+  { 0x5e, 0x24, 0x95, 0xd4, 0x3b, 0x98, 0x10, 0x10, 0x30, 0x4a, 0xf5, 0x5e, 0xfe, 0xd1, 0xe7, 0x98 },
+  { 0x5e, 0x29, 0x28, 0xf0, 0x89, 0x49, 0x00, 0x17, 0xe8, 0x8e, 0x9f, 0x9e, 0x5a, 0x88, 0x1a, 0x25 },
+  { 0x5e, 0x99, 0xaa, 0x93, 0xd0, 0xac, 0xc7, 0x41, 0xdc, 0xda, 0x87, 0x52, 0xc4, 0xe8, 0x13, 0xce },
+  { 0x5e, 0xc7, 0x3a, 0xc7, 0xd2, 0xac, 0x95, 0xac, 0x95, 0x30, 0xc6, 0xd3, 0x3e, 0x71, 0x3d, 0x14 },
+  { 0x5e, 0xeb, 0x81, 0x29, 0x29, 0x92, 0xe0, 0x57, 0xb2, 0x90, 0xa5, 0xcd, 0x19, 0x6f, 0x15, 0x5d },
+  { 0x5e, 0xf3, 0x03, 0xb9, 0xf0, 0xaa, 0x8c, 0xf2, 0x07, 0x20, 0xc5, 0x60, 0xe5, 0xf9, 0xba, 0xa1 },
+  { 0x5f, 0x1b, 0x7d, 0x5f, 0xa7, 0x3a, 0xa0, 0x71, 0xba, 0x0a, 0x3c, 0x28, 0x19, 0x51, 0x15, 0x05 },
+  { 0x5f, 0x2b, 0x4c, 0x15, 0x59, 0x49, 0xf0, 0x1c, 0x06, 0x50, 0x7f, 0xb3, 0x23, 0x69, 0xd4, 0x2a },
+  { 0x5f, 0x31, 0x69, 0x73, 0xff, 0xd1, 0x07, 0xf7, 0xab, 0x91, 0x17, 0xe9, 0x3f, 0x50, 0xe4, 0xbd },
+  { 0x5f, 0x39, 0x35, 0x3f, 0x7c, 0x69, 0x25, 0x77, 0x9b, 0x01, 0x69, 0xa8, 0x7f, 0xf8, 0x6f, 0x1e },
+  { 0x5f, 0x46, 0xd1, 0xff, 0x6d, 0x7c, 0xde, 0xb4, 0xb0, 0x9c, 0x39, 0xd0, 0x4d, 0xfd, 0x50, 0xa1 },
+  { 0x5f, 0x56, 0x08, 0x37, 0x39, 0x63, 0x87, 0x45, 0x5c, 0x9d, 0xcb, 0x05, 0xcd, 0xd4, 0xb0, 0x53 },
+  { 0x5f, 0x68, 0x14, 0x03, 0xb1, 0x05, 0x1a, 0x08, 0x22, 0x34, 0x4f, 0x46, 0x7b, 0x05, 0xa9, 0x4d },
+  { 0x5f, 0x69, 0x45, 0x3a, 0x69, 0xf2, 0x1d, 0xc4, 0x96, 0x97, 0xa8, 0x0d, 0x2e, 0x93, 0x34, 0x91 },
+  { 0x5f, 0x70, 0x8c, 0xa3, 0x96, 0x27, 0x69, 0x7e, 0x85, 0x9d, 0x1c, 0x53, 0xf8, 0xd8, 0xd7, 0xd2 },
+  { 0x5f, 0x73, 0xe7, 0x17, 0x54, 0x74, 0xc1, 0xc2, 0x2f, 0xb8, 0x03, 0x0c, 0x31, 0x58, 0xe9, 0xb3 },
+  { 0x5f, 0x78, 0x6b, 0x67, 0xe0, 0x5f, 0xb9, 0x98, 0x5b, 0x77, 0xd4, 0xbe, 0xb3, 0x5e, 0x06, 0xee },
+  { 0x5f, 0x7a, 0xe9, 0xa7, 0xf8, 0xd7, 0x9a, 0x3b, 0x37, 0xe8, 0xfc, 0x84, 0x1f, 0x65, 0x64, 0x3a },
+  { 0x5f, 0x7d, 0xe6, 0x2a, 0x40, 0x8b, 0x9d, 0xe3, 0xa1, 0x16, 0x88, 0x98, 0x29, 0x8f, 0xd3, 0x1d },
+  { 0x5f, 0x95, 0x0a, 0x2d, 0x1e, 0xb3, 0x31, 0xa1, 0x27, 0x68, 0x19, 0x52, 0x07, 0x05, 0xdf, 0x94 },
+  { 0x5f, 0x9b, 0x62, 0x35, 0x0b, 0x31, 0xbe, 0x8b, 0xd2, 0x70, 0xd9, 0xa2, 0x41, 0xcb, 0xd5, 0x0e },
+  { 0x5f, 0xaf, 0xfe, 0x1c, 0x4c, 0x57, 0x43, 0x09, 0x78, 0xde, 0xc5, 0xce, 0xd3, 0x2b, 0x9f, 0x4a },
+  { 0x5f, 0xb7, 0x1c, 0xc6, 0x0e, 0x29, 0x3f, 0xe1, 0x0a, 0x50, 0x23, 0xf1, 0x1c, 0x73, 0x4e, 0x55 },
+  { 0x60, 0x0d, 0x48, 0xee, 0xf5, 0xc0, 0xec, 0x27, 0xdb, 0x55, 0x4b, 0x73, 0x28, 0xb3, 0x25, 0x1c },
+  { 0x60, 0x15, 0xa9, 0xce, 0xf7, 0x83, 0xe9, 0x7e, 0x98, 0xa2, 0xaa, 0x2c, 0xf0, 0x70, 0xae, 0x06 },
+  { 0x60, 0x35, 0x8e, 0xdf, 0x0c, 0x2c, 0xc7, 0x6b, 0x1e, 0x54, 0x9e, 0x03, 0x1e, 0x50, 0xe1, 0x30 },
+  { 0x60, 0x3c, 0x7a, 0x0d, 0x12, 0xc9, 0x35, 0xdf, 0x58, 0x10, 0xf4, 0x00, 0xf3, 0x97, 0x1b, 0x67 },
+  { 0x60, 0x41, 0xf4, 0x00, 0xb4, 0x55, 0x11, 0xaa, 0x3a, 0x69, 0xfa, 0xb4, 0xb8, 0xfc, 0x8f, 0x41 },
+  { 0x60, 0x4e, 0x09, 0x72, 0x45, 0x55, 0x80, 0x7c, 0x28, 0x10, 0x80, 0x49, 0xef, 0xe3, 0x4a, 0x13 },
+  { 0x60, 0x58, 0xe4, 0x0c, 0xe7, 0x9d, 0x74, 0x34, 0xc7, 0xf7, 0x47, 0x7b, 0x29, 0xab, 0xd4, 0xa5 },
+  { 0x60, 0x5d, 0xcb, 0x73, 0xd2, 0x2f, 0x4e, 0xfd, 0xb9, 0x0e, 0xf9, 0xda, 0x2f, 0x29, 0x0f, 0x7c },
+  { 0x60, 0x5f, 0xd5, 0x9b, 0xfe, 0xf8, 0x89, 0x01, 0xc8, 0xc4, 0x79, 0x41, 0x93, 0xa4, 0xcb, 0xad },
+  { 0x60, 0x6c, 0x2c, 0x17, 0x53, 0x05, 0x1e, 0x03, 0xc1, 0xf1, 0xac, 0x09, 0x6c, 0x9d, 0x28, 0x32 },
+  { 0x60, 0x76, 0xb1, 0x87, 0xa5, 0xd8, 0xea, 0x7a, 0x2a, 0x05, 0x11, 0x1c, 0x19, 0xb5, 0xd5, 0xcd },
+  { 0x60, 0xa6, 0x1d, 0xa9, 0xb2, 0xf4, 0x3d, 0xd7, 0xe1, 0x3a, 0x50, 0x93, 0xec, 0x41, 0xa5, 0x3d },
+  { 0x60, 0xbb, 0xd4, 0x25, 0xcb, 0x72, 0x14, 0xdd, 0xb9, 0xf9, 0xa3, 0x19, 0x48, 0xe9, 0x1e, 0xcb },
+  { 0x60, 0xcd, 0x61, 0xa2, 0xdf, 0xcc, 0xb0, 0xe2, 0x73, 0x64, 0x34, 0xf9, 0x79, 0x2c, 0x16, 0x72 },
+  { 0x60, 0xd3, 0x04, 0x58, 0x2d, 0x33, 0xe2, 0x95, 0x7b, 0x73, 0xeb, 0x30, 0x0a, 0x74, 0x95, 0xbb },
+  { 0x60, 0xe0, 0xea, 0x3c, 0xbe, 0x09, 0x13, 0xd3, 0x98, 0x03, 0x47, 0x79, 0x45, 0xe9, 0xe5, 0xec },
+  { 0x61, 0x3a, 0xbf, 0x59, 0x6c, 0x30, 0x4e, 0xf6, 0xdb, 0xd8, 0xf3, 0x35, 0x19, 0x20, 0xc3, 0x7a },
+  { 0x61, 0x41, 0xc0, 0x95, 0xd0, 0xae, 0xe4, 0xe7, 0x34, 0xbe, 0xbf, 0xaa, 0xc9, 0x39, 0x03, 0x0a },
+  { 0x61, 0x42, 0x6c, 0xee, 0x01, 0x33, 0x06, 0xe7, 0xf7, 0x36, 0x75, 0x34, 0xab, 0x12, 0x47, 0x47 },
+  { 0x61, 0x5a, 0x3b, 0xf2, 0x51, 0xa3, 0x8e, 0xb6, 0x63, 0x8c, 0xdc, 0x7f, 0xfb, 0xde, 0x54, 0x80 },
+  { 0x61, 0x62, 0x1a, 0x55, 0x6a, 0xd3, 0x22, 0x8f, 0x02, 0x34, 0xf5, 0xfe, 0xb3, 0xab, 0x13, 0x5c },
+  { 0x61, 0x63, 0x1c, 0x2f, 0x96, 0x22, 0x15, 0x27, 0xe7, 0xda, 0x98, 0x02, 0xb4, 0x70, 0x4f, 0x93 },
+  { 0x61, 0x71, 0x9a, 0x8b, 0xda, 0xfb, 0xd8, 0xda, 0xb3, 0xca, 0x9c, 0xe7, 0xb1, 0x71, 0xb9, 0xe2 },
+  { 0x61, 0x72, 0x8c, 0x6c, 0xfb, 0x05, 0x2e, 0x62, 0xa9, 0xed, 0x08, 0x8c, 0x5b, 0xf4, 0x07, 0xba },
+  { 0x61, 0x9d, 0xe4, 0x62, 0x81, 0xeb, 0x2e, 0x0a, 0xdb, 0xb9, 0x82, 0x55, 0x73, 0x24, 0x83, 0xb4 },
+  { 0x61, 0xdb, 0xe9, 0x4f, 0x11, 0x0f, 0x30, 0xca, 0x4e, 0xc5, 0x24, 0xae, 0x5c, 0xe2, 0xd0, 0x26 },
+  { 0x61, 0xe0, 0xf5, 0xe1, 0xcc, 0x20, 0x7e, 0x98, 0x70, 0x4d, 0x07, 0x58, 0xc6, 0x8d, 0xf3, 0x17 },
+  { 0x61, 0xef, 0x8c, 0x2f, 0xc4, 0x3b, 0xe9, 0xa0, 0x4f, 0xe1, 0x3f, 0xdb, 0x79, 0xff, 0x2b, 0xd9 },
+  { 0x62, 0x05, 0x85, 0x5c, 0xc8, 0x48, 0xd1, 0xf6, 0xc4, 0x55, 0x13, 0x91, 0xb9, 0xbf, 0xa2, 0x79 },
+  { 0x62, 0x4e, 0x0a, 0x77, 0xf9, 0xec, 0x67, 0xd6, 0x28, 0x21, 0x1a, 0xaf, 0x24, 0xd8, 0xae, 0xa6 },
+  { 0x62, 0x6d, 0x67, 0x91, 0x8f, 0x4b, 0x5e, 0x3f, 0x96, 0x1e, 0x4b, 0x2a, 0xf2, 0xf4, 0x1f, 0x1d },
+  { 0x62, 0x72, 0xf3, 0x48, 0xa9, 0xa7, 0xf2, 0xd5, 0x00, 0xa4, 0x00, 0x6a, 0xa9, 0x3e, 0x0d, 0x08 },
+  { 0x62, 0x89, 0x94, 0x30, 0x33, 0x8e, 0x05, 0x38, 0xee, 0x93, 0x39, 0x78, 0x67, 0xd8, 0x59, 0x57 },
+  { 0x62, 0x92, 0x16, 0x52, 0xf6, 0x63, 0x4e, 0xb1, 0xa0, 0x94, 0x0e, 0xd5, 0x48, 0x9c, 0x7e, 0x18 },
+  { 0x62, 0x99, 0x23, 0x92, 0xea, 0x65, 0x1a, 0x16, 0xaa, 0x72, 0x4a, 0x92, 0xe4, 0x59, 0x6e, 0xd6 },
+  { 0x62, 0xd1, 0xf5, 0x02, 0x19, 0xed, 0xf9, 0xa4, 0x29, 0xa9, 0xf0, 0x04, 0xc1, 0x9f, 0x31, 0xb3 },
+  { 0x62, 0xf7, 0x4a, 0x27, 0x36, 0x84, 0x11, 0x91, 0x13, 0x55, 0x14, 0x42, 0x2b, 0x20, 0x38, 0x2d },
+  { 0x62, 0xff, 0xd1, 0x75, 0xca, 0xc3, 0xf7, 0x81, 0xef, 0x6e, 0x48, 0x70, 0x13, 0x6a, 0x25, 0x20 },
+  { 0x63, 0x16, 0x68, 0x67, 0xf7, 0x58, 0x69, 0xa3, 0x59, 0x2b, 0x7a, 0x94, 0xea, 0x62, 0xd1, 0x47 },
+  { 0x63, 0x33, 0xef, 0x5b, 0x5c, 0xbb, 0x77, 0xac, 0xd4, 0x7f, 0x55, 0x8c, 0x8b, 0x7a, 0x95, 0xd3 },
+  { 0x63, 0x37, 0x92, 0x7a, 0xd9, 0x09, 0xaa, 0x73, 0x9d, 0x6d, 0x00, 0x44, 0x69, 0x9a, 0x91, 0x6d },
+  { 0x63, 0x39, 0xd2, 0x8c, 0x9a, 0x7f, 0x92, 0x05, 0x4e, 0x70, 0x02, 0x9e, 0xb0, 0x37, 0x58, 0x37 },
+  { 0x63, 0x42, 0xaf, 0xe9, 0xc9, 0xad, 0x1b, 0x61, 0x20, 0xb8, 0xf6, 0xfb, 0x04, 0x0d, 0x09, 0x26 },
+  { 0x63, 0x54, 0xf9, 0xc7, 0x58, 0x8a, 0x27, 0x10, 0x9c, 0x66, 0x90, 0x5b, 0x04, 0x05, 0x82, 0x5b },
+  { 0x63, 0x5c, 0xc7, 0xa0, 0xdb, 0x33, 0x77, 0x39, 0x59, 0xd7, 0x39, 0xd0, 0x4e, 0xff, 0x96, 0xc2 },
+  { 0x63, 0x62, 0x39, 0x6c, 0x83, 0x44, 0xee, 0xc3, 0xe8, 0x67, 0x31, 0xa7, 0x00, 0xb1, 0x3a, 0xbf },
+  { 0x63, 0x7e, 0xfa, 0xc6, 0x76, 0xff, 0x06, 0x3f, 0x2f, 0xbb, 0x0a, 0xbf, 0xf7, 0x7c, 0x4f, 0xa5 },
+  { 0x63, 0x81, 0x1e, 0xd6, 0x9b, 0xdb, 0xc3, 0x5c, 0x69, 0xd8, 0xaa, 0x78, 0x06, 0xc3, 0xd6, 0xe9 },
+  { 0x63, 0x8c, 0xc8, 0x2e, 0xa9, 0x6f, 0x67, 0x67, 0x45, 0x95, 0xba, 0x9a, 0xe0, 0x5d, 0xa6, 0xc6 },
+  { 0x63, 0xa6, 0xed, 0xa1, 0xda, 0x30, 0x44, 0x65, 0x69, 0xac, 0x76, 0x21, 0x1d, 0x0f, 0x86, 0x1c },
+  { 0x63, 0xa7, 0x44, 0x5b, 0x1d, 0x30, 0x46, 0xd3, 0xcd, 0xcd, 0xbd, 0x48, 0x8d, 0xca, 0x38, 0xd9 },
+  { 0x63, 0xc5, 0xfe, 0xf3, 0x20, 0x8b, 0xb1, 0x42, 0x4d, 0x26, 0xcf, 0x1a, 0xb9, 0x84, 0xb4, 0x0c },
+  { 0x63, 0xc7, 0x39, 0x5d, 0x41, 0x2a, 0x3c, 0xd0, 0x95, 0xcc, 0xdd, 0x9b, 0x57, 0x11, 0xf3, 0x87 },
+  { 0x63, 0xd6, 0x24, 0x7f, 0x35, 0x90, 0x2b, 0xa3, 0x2a, 0xa4, 0x9e, 0x76, 0x60, 0xb0, 0xec, 0xaa },
+  { 0x63, 0xe4, 0x2d, 0x57, 0x68, 0x00, 0x08, 0x64, 0x88, 0x67, 0x94, 0x90, 0xa8, 0x33, 0xe0, 0x97 },
+  { 0x63, 0xe7, 0x83, 0x99, 0x4d, 0xf8, 0x24, 0xca, 0xf2, 0x89, 0xb6, 0x9a, 0x08, 0x4c, 0xbf, 0x3e },
+  { 0x63, 0xe9, 0xe6, 0x12, 0xbb, 0xee, 0x31, 0x04, 0x5f, 0x8d, 0x18, 0x4a, 0x4e, 0x53, 0xf8, 0xec },
+  { 0x64, 0x0a, 0x08, 0xe9, 0xca, 0x01, 0x91, 0x72, 0xd6, 0x12, 0xdf, 0x22, 0xa9, 0x19, 0x0a, 0xfb },
+  { 0x64, 0x19, 0x8b, 0xb6, 0x47, 0x0c, 0x78, 0xac, 0x24, 0xfc, 0xf1, 0x3f, 0xe7, 0x6a, 0xb2, 0x8c },
+  { 0x64, 0x3e, 0x64, 0x51, 0xeb, 0x6b, 0x8a, 0xb7, 0x93, 0xeb, 0x60, 0xba, 0x9c, 0x02, 0xe0, 0x00 },
+  { 0x64, 0x5b, 0xf7, 0xf9, 0x14, 0x6f, 0x0e, 0x48, 0x11, 0xff, 0x9c, 0x78, 0x98, 0xf5, 0xcd, 0x93 },
+  { 0x64, 0x68, 0xd7, 0x44, 0xbe, 0x99, 0x84, 0xf2, 0xa3, 0x9c, 0xa9, 0x28, 0x54, 0x43, 0xa2, 0xb2 },
+  { 0x64, 0x71, 0x62, 0xcc, 0xeb, 0x55, 0x0f, 0xd4, 0x98, 0x20, 0xe2, 0x20, 0x6d, 0x9e, 0xe7, 0xe8 },
+  { 0x64, 0xb8, 0xe1, 0x9c, 0x76, 0x71, 0x91, 0xcc, 0xdc, 0x97, 0xac, 0xc6, 0x90, 0x4c, 0x39, 0x7b },
+  { 0x64, 0xca, 0x51, 0x89, 0x05, 0x31, 0x1d, 0x2d, 0x9a, 0xeb, 0x56, 0x27, 0x3f, 0x6c, 0xaa, 0x04 },
+  { 0x64, 0xd4, 0x38, 0x59, 0x25, 0x8d, 0xc8, 0xca, 0x54, 0x94, 0x9e, 0x9f, 0xf4, 0x17, 0x42, 0x02 },
+  { 0x64, 0xfa, 0xb9, 0xd1, 0x5d, 0xf9, 0x37, 0x91, 0x5b, 0x1c, 0x39, 0x2f, 0xc1, 0x19, 0xb8, 0x3b },
+  { 0x65, 0x0d, 0xf7, 0x78, 0xc6, 0xce, 0x22, 0xd3, 0xfd, 0x1a, 0x7c, 0x33, 0xc5, 0x65, 0xbc, 0xc3 },
+  { 0x65, 0x1d, 0x2b, 0x67, 0x43, 0xa3, 0xa1, 0x8b, 0x42, 0x6b, 0xce, 0x2c, 0x88, 0x1a, 0xf2, 0x12 },
+  { 0x65, 0x22, 0x71, 0x7c, 0xfd, 0x75, 0xd1, 0xdb, 0xa2, 0x52, 0xcb, 0xde, 0x76, 0x99, 0x20, 0x90 },
+  { 0x65, 0x38, 0xe4, 0x54, 0xb0, 0x49, 0x8a, 0xd2, 0xbe, 0xfe, 0x1e, 0xf0, 0xf8, 0x78, 0x15, 0xc0 },
+  { 0x65, 0x49, 0x0d, 0x61, 0x92, 0x2f, 0x3e, 0x38, 0x83, 0xee, 0x1d, 0x58, 0x3c, 0xe1, 0x08, 0x55 },
+  { 0x65, 0x56, 0x2f, 0x68, 0x6b, 0x26, 0x7b, 0x21, 0xb8, 0x1c, 0x4d, 0xdd, 0xc1, 0x29, 0xd7, 0x24 },
+  { 0x65, 0x5c, 0x84, 0xe5, 0xb9, 0x51, 0x25, 0x8c, 0x9d, 0x20, 0xf0, 0xbf, 0x2b, 0x9d, 0x49, 0x6d },
+  { 0x65, 0x6d, 0xc2, 0x47, 0xdb, 0x28, 0x71, 0x76, 0x6d, 0xff, 0xd9, 0x78, 0xc7, 0x1d, 0xa8, 0x0c },
+  { 0x65, 0x91, 0x7a, 0xe2, 0x9a, 0x8c, 0x97, 0x85, 0xbb, 0x1f, 0x2a, 0xcb, 0x0d, 0x6a, 0xaf, 0xd0 },
+  { 0x65, 0x96, 0xb3, 0x73, 0x7a, 0xe4, 0xb9, 0x76, 0xe4, 0xaa, 0xdb, 0x68, 0xd8, 0x36, 0xc5, 0xc7 },
+  { 0x65, 0x9a, 0x20, 0x01, 0x9d, 0xe4, 0xa2, 0x3c, 0x74, 0x8e, 0xc2, 0x29, 0x2e, 0xa5, 0xf2, 0x21 },
+  { 0x65, 0xb1, 0x06, 0xeb, 0xa3, 0xe4, 0x5f, 0x3d, 0xab, 0x72, 0xea, 0x90, 0x7f, 0x39, 0xf8, 0xb4 },
+  { 0x65, 0xba, 0x1a, 0x4c, 0x64, 0x3d, 0x1a, 0xb4, 0x44, 0x81, 0xbd, 0xdd, 0xeb, 0x40, 0x38, 0x27 },
+  { 0x65, 0xbd, 0x29, 0xe8, 0xab, 0x1b, 0x84, 0x73, 0x09, 0x77, 0x5b, 0x0d, 0xe6, 0xb2, 0xe4, 0xfe },
+  { 0x65, 0xc6, 0x40, 0x6f, 0x5a, 0xf9, 0x34, 0x59, 0x00, 0x97, 0xc8, 0xc0, 0x32, 0xeb, 0xb4, 0x82 },
+  { 0x66, 0x04, 0xf7, 0x2a, 0x96, 0x6c, 0xa6, 0xb2, 0xdf, 0x6a, 0x94, 0xee, 0x4a, 0x68, 0xeb, 0x82 },
+  { 0x66, 0x2e, 0xca, 0x7e, 0x3d, 0x89, 0x17, 0x5b, 0xa0, 0x80, 0x2e, 0x8e, 0x34, 0x25, 0xde, 0xdb },
+  { 0x66, 0x36, 0x28, 0x90, 0xeb, 0x78, 0xd6, 0xea, 0x65, 0x30, 0x15, 0x92, 0xcc, 0xe6, 0x5f, 0x5b },
+  { 0x66, 0x3e, 0xf2, 0x2e, 0xb3, 0x99, 0x50, 0x4d, 0x52, 0x04, 0xc5, 0x43, 0xb8, 0xa8, 0x6b, 0xcd },
+  { 0x66, 0x51, 0xe2, 0x79, 0x1d, 0x38, 0xed, 0xc0, 0x2c, 0x5a, 0x5f, 0xd7, 0xb4, 0x7a, 0x16, 0x27 },
+  { 0x66, 0x5b, 0x8f, 0x8e, 0xad, 0x0e, 0xef, 0x22, 0x0e, 0xd5, 0x38, 0x86, 0xfb, 0xd6, 0x1e, 0xc9 },
+  { 0x66, 0x70, 0x64, 0x59, 0xe6, 0x25, 0x14, 0xd0, 0xc3, 0x9c, 0x37, 0x97, 0xcb, 0xf7, 0x3f, 0xf1 },
+  { 0x66, 0x72, 0xde, 0x8f, 0x82, 0xc4, 0xf7, 0xb8, 0xf7, 0xf1, 0xef, 0x8b, 0x6b, 0x4f, 0x61, 0x4d },
+  { 0x66, 0x8d, 0xc5, 0x28, 0xb7, 0xea, 0x93, 0x45, 0x14, 0x0f, 0x4f, 0xcf, 0xbe, 0xcf, 0x70, 0x66 },
+  { 0x66, 0x97, 0xf1, 0x77, 0x84, 0x7c, 0x70, 0x50, 0x58, 0x24, 0x42, 0x2e, 0x76, 0xaa, 0xd5, 0x86 },
+  { 0x66, 0x98, 0x40, 0xb0, 0x41, 0x1b, 0xfb, 0xab, 0x5c, 0x05, 0xb7, 0x86, 0x94, 0x7d, 0x55, 0xd4 },
+  { 0x66, 0xb8, 0x9b, 0xa4, 0x4e, 0x7a, 0xe0, 0xb5, 0x1f, 0x9e, 0xf0, 0x00, 0xeb, 0xba, 0x1e, 0xb7 },
+  { 0x66, 0xb9, 0x2e, 0xde, 0x65, 0x5b, 0x73, 0xb4, 0x02, 0xec, 0xd1, 0xf4, 0xd8, 0xcd, 0x9c, 0x50 },
+  { 0x66, 0xbc, 0x1b, 0xef, 0x26, 0x9e, 0xa5, 0x90, 0x33, 0x92, 0x8b, 0xac, 0x2d, 0x1d, 0x81, 0xe6 },
+  { 0x66, 0xc2, 0x38, 0x0c, 0x71, 0x70, 0x9e, 0xfa, 0x7b, 0x16, 0x66, 0x21, 0xe5, 0xbb, 0x45, 0x58 },
+  { 0x66, 0xc4, 0xe0, 0x29, 0x8d, 0x41, 0x20, 0xdf, 0x33, 0x3b, 0xc2, 0xf3, 0xe1, 0x63, 0x65, 0x7e },
+  { 0x66, 0xfc, 0xf7, 0x64, 0x3d, 0x55, 0x4f, 0x5e, 0x15, 0xd4, 0xd0, 0x6b, 0xab, 0x59, 0xfe, 0x70 },
+  { 0x67, 0x06, 0xa0, 0x0f, 0x96, 0x35, 0x50, 0x8c, 0xfe, 0xda, 0x20, 0x63, 0x91, 0x56, 0xe6, 0x6e },
+  { 0x67, 0x20, 0x12, 0xd4, 0x03, 0x36, 0xb4, 0x03, 0xed, 0xea, 0x4a, 0x98, 0xce, 0x70, 0xc7, 0x6d },
+  { 0x67, 0x5a, 0xe9, 0xc2, 0x3f, 0xa1, 0xaa, 0xe3, 0x76, 0xce, 0xa8, 0x6c, 0xad, 0x96, 0xf9, 0xa5 },
+  { 0x67, 0x63, 0x1e, 0xa5, 0xcf, 0xe4, 0x40, 0x66, 0xa1, 0xe7, 0x6d, 0xdc, 0xb6, 0xbc, 0xb5, 0x12 },
+  { 0x67, 0x68, 0x4a, 0x1d, 0x18, 0xc8, 0x5f, 0xfa, 0x5d, 0x82, 0xda, 0xb4, 0x8f, 0xd1, 0xcb, 0x51 },
+  { 0x67, 0x8c, 0x1d, 0x71, 0xa1, 0x61, 0x6d, 0x9d, 0x02, 0x2f, 0x03, 0xd8, 0x54, 0x5b, 0x64, 0xbb },
+  { 0x67, 0x93, 0x1b, 0x0d, 0x37, 0xdc, 0x99, 0xaf, 0x25, 0x0d, 0xd0, 0x6f, 0x1c, 0x09, 0x5e, 0x8d },
+  { 0x67, 0x9d, 0x30, 0xc7, 0x88, 0x6b, 0x28, 0x3c, 0xbe, 0x1d, 0xb4, 0xe7, 0xdb, 0xe5, 0xf2, 0xa6 },
+  { 0x67, 0x9e, 0x91, 0x0b, 0x27, 0x40, 0x6c, 0x6a, 0x20, 0x72, 0xf9, 0x56, 0x9a, 0xe3, 0x5f, 0xc8 },
+  { 0x67, 0xbd, 0x3d, 0x4d, 0xc5, 0xac, 0x6a, 0x42, 0xa9, 0x99, 0x50, 0xb4, 0x24, 0x5b, 0xdc, 0x81 },
+  { 0x67, 0xc0, 0x5a, 0xe9, 0x4b, 0xf8, 0xb8, 0x3a, 0x66, 0x6c, 0x3a, 0xe2, 0xc4, 0xbc, 0x14, 0xde },
+  { 0x67, 0xcd, 0xde, 0x41, 0x76, 0xe0, 0x44, 0x7f, 0xc4, 0x5a, 0x71, 0xe0, 0xa1, 0xcd, 0xd2, 0x88 },
+  { 0x67, 0xce, 0x6c, 0xdf, 0x78, 0x8d, 0x32, 0x49, 0x35, 0xfd, 0x31, 0x7d, 0x06, 0x4e, 0xd8, 0x42 },
+  { 0x67, 0xcf, 0x91, 0x3d, 0x1d, 0xf0, 0xbf, 0x2d, 0x7a, 0xe6, 0x68, 0x06, 0x0d, 0x0b, 0x66, 0x94 },
+  { 0x68, 0x03, 0xfa, 0x7c, 0x2c, 0x09, 0x4b, 0x42, 0x8b, 0x85, 0x9a, 0x58, 0xdc, 0x1d, 0xd0, 0x6a },
+  { 0x68, 0x05, 0x73, 0x4a, 0x0b, 0x7b, 0xcc, 0x89, 0x25, 0xd9, 0x30, 0x5b, 0x07, 0x1b, 0xf1, 0x47 },
+  { 0x68, 0x12, 0x06, 0xa6, 0xbd, 0xe7, 0x3e, 0x71, 0xc1, 0x97, 0x43, 0x60, 0x7e, 0x96, 0xc4, 0xbb },
+  { 0x68, 0x3b, 0xb0, 0xd0, 0xf0, 0xc5, 0xdf, 0x58, 0x55, 0x7f, 0xba, 0x9d, 0xff, 0xc3, 0x2c, 0x40 },
+  { 0x68, 0x3d, 0xc6, 0x4e, 0xf7, 0x31, 0x6c, 0x13, 0xba, 0x04, 0xee, 0x43, 0x98, 0xe2, 0xb9, 0x3a },
+  { 0x68, 0x44, 0x9e, 0x4a, 0xab, 0xa6, 0x77, 0xab, 0xcd, 0x7c, 0xde, 0x42, 0x64, 0xe0, 0x21, 0x68 },
+  { 0x68, 0x47, 0xce, 0x70, 0x81, 0x9b, 0x74, 0xfe, 0xbc, 0xfd, 0x03, 0xe9, 0x96, 0x10, 0x24, 0x3b },
+  { 0x68, 0x48, 0x9e, 0x60, 0x26, 0x8a, 0x5e, 0x6e, 0x05, 0x2b, 0xad, 0x9c, 0x62, 0x68, 0x16, 0x35 },
+  { 0x68, 0x59, 0x72, 0x64, 0xc8, 0xe5, 0x7a, 0xda, 0x93, 0xbe, 0x3a, 0x5b, 0xe4, 0x56, 0x50, 0x96 },
+  { 0x68, 0x5e, 0x96, 0x68, 0xdc, 0x27, 0x0b, 0x6d, 0xee, 0xb9, 0xcf, 0xbf, 0xd4, 0xd6, 0x33, 0xc3 },
+  { 0x68, 0x76, 0x0b, 0x82, 0xfc, 0x5d, 0xcf, 0x3f, 0xed, 0xf8, 0x43, 0x76, 0xa4, 0x94, 0x4b, 0xf9 },
+  { 0x68, 0x7c, 0x23, 0x22, 0x4e, 0x26, 0xf8, 0x1c, 0x56, 0xe4, 0x31, 0xc2, 0x4f, 0xae, 0xa3, 0x6d },
+  { 0x68, 0x87, 0x82, 0x50, 0xe1, 0x06, 0xeb, 0x6c, 0x77, 0x54, 0xbc, 0x25, 0x19, 0xd7, 0x80, 0xa0 },
+  { 0x68, 0xc8, 0x0e, 0x7e, 0x1d, 0x30, 0xdf, 0x98, 0xa0, 0xcf, 0x67, 0xec, 0xbf, 0x39, 0xcc, 0x67 },
+  { 0x68, 0xcd, 0x2a, 0xdc, 0x6b, 0x1f, 0xc9, 0xa1, 0xf2, 0x63, 0xab, 0x45, 0x61, 0x11, 0x2f, 0x30 },
+  { 0x68, 0xfe, 0xb6, 0xd6, 0xff, 0x63, 0xe8, 0x0d, 0xf1, 0x30, 0x2d, 0x85, 0x47, 0x97, 0x9a, 0xec },
+  { 0x69, 0x0a, 0x60, 0x49, 0xdb, 0x78, 0xb9, 0x40, 0x0c, 0x13, 0x52, 0x16, 0x46, 0x70, 0x8e, 0x9c },
+  { 0x69, 0x13, 0xc9, 0x00, 0x02, 0x63, 0x6c, 0x14, 0x87, 0x53, 0x8d, 0x40, 0x04, 0xf7, 0xca, 0xc2 },
+  { 0x69, 0x1d, 0x67, 0x91, 0x0b, 0x08, 0xb6, 0x3d, 0xe8, 0x63, 0x19, 0x01, 0xd1, 0x88, 0x7c, 0x1f },
+  { 0x69, 0x22, 0x02, 0x77, 0x2d, 0x8b, 0x38, 0xcc, 0xf8, 0x5a, 0x90, 0xc8, 0x00, 0x3a, 0x13, 0x24 },
+  { 0x69, 0x31, 0x37, 0x59, 0x2a, 0x7f, 0x5c, 0xcc, 0x9b, 0xaa, 0xe2, 0xd1, 0x04, 0x1b, 0x7a, 0x85 },
+  { 0x69, 0x79, 0xf3, 0x02, 0x04, 0x14, 0x9b, 0xe3, 0xe2, 0x27, 0x55, 0x8c, 0xff, 0xe2, 0x1c, 0x1d },
+  { 0x69, 0x82, 0x85, 0x46, 0x57, 0xa2, 0xcc, 0x87, 0xd7, 0x12, 0xf7, 0x18, 0xe4, 0x02, 0xbf, 0x85 },
+  { 0x69, 0x8f, 0x56, 0x9e, 0xab, 0x5a, 0x99, 0x06, 0xee, 0xc3, 0xbc, 0x7c, 0x6b, 0x3e, 0x09, 0x80 },
+  { 0x69, 0x97, 0x4d, 0xd5, 0xd6, 0x42, 0x0b, 0x90, 0x89, 0x8c, 0xde, 0x50, 0xae, 0xc5, 0xef, 0x39 },
+  { 0x69, 0xdf, 0x04, 0x11, 0xd4, 0xd1, 0x76, 0xe5, 0x58, 0x01, 0x7f, 0x96, 0x1f, 0x5c, 0x58, 0x49 },
+  { 0x69, 0xe7, 0x9b, 0x13, 0x52, 0xb9, 0xee, 0x17, 0x54, 0xbb, 0xe6, 0x3b, 0x4a, 0x70, 0x62, 0xc3 },
+  { 0x69, 0xeb, 0xf9, 0x10, 0xab, 0x9b, 0x63, 0xe5, 0xb8, 0x34, 0x5f, 0x01, 0x60, 0x95, 0x00, 0x3b },
+  { 0x69, 0xfa, 0xc8, 0x2c, 0xd2, 0x31, 0x2d, 0xd9, 0xce, 0x5d, 0x90, 0xe2, 0x2e, 0x2f, 0x07, 0x0a },
+  { 0x6a, 0x03, 0xc2, 0x8d, 0x50, 0x5b, 0xab, 0x71, 0x0b, 0xf2, 0x0b, 0x95, 0x4e, 0x14, 0xd5, 0x21 },
+  { 0x6a, 0x07, 0x83, 0x6c, 0x38, 0x21, 0x95, 0xdd, 0x53, 0x05, 0xce, 0x61, 0xd9, 0x92, 0xaa, 0xa6 },
+  { 0x6a, 0x09, 0x1b, 0x8f, 0xfe, 0xac, 0xd0, 0x93, 0x98, 0x50, 0xda, 0x20, 0x94, 0xb5, 0x15, 0x64 },
+  { 0x6a, 0x2c, 0x68, 0xf7, 0xa7, 0x77, 0x36, 0xba, 0x02, 0xc0, 0xf2, 0x1a, 0x6b, 0xa0, 0x98, 0x5b },
+  { 0x6a, 0x3b, 0x0c, 0x33, 0xcf, 0x74, 0xb1, 0xe2, 0x13, 0xa6, 0x29, 0xe3, 0xc1, 0x42, 0xb7, 0x3c },
+  { 0x6a, 0x76, 0xd5, 0xf0, 0xed, 0x72, 0x16, 0x39, 0x47, 0x4a, 0xa9, 0xbb, 0xde, 0x69, 0xeb, 0xf0 },
+  { 0x6a, 0x82, 0xb8, 0xec, 0xc6, 0x63, 0xf3, 0x71, 0xb1, 0x90, 0x76, 0xd9, 0x9f, 0x46, 0xc5, 0x98 },
+  { 0x6a, 0x88, 0x2f, 0xb1, 0x41, 0x39, 0x12, 0xd2, 0xce, 0x5c, 0xf5, 0xfa, 0x62, 0xcf, 0x38, 0x75 },
+  { 0x6a, 0x8c, 0x69, 0x40, 0xd3, 0xbe, 0x6f, 0xd0, 0x12, 0x74, 0x36, 0x3c, 0x4d, 0x4b, 0x29, 0x8e },
+  { 0x6a, 0x9b, 0x30, 0xca, 0x46, 0xb0, 0xdb, 0xa9, 0xe7, 0x19, 0xf4, 0xcb, 0xd3, 0x40, 0xe0, 0x1c },
+  { 0x6a, 0x9e, 0x0c, 0x72, 0xfa, 0xb9, 0x2d, 0xf7, 0x00, 0x84, 0xec, 0xcd, 0x90, 0x61, 0xfd, 0xbd },
+  { 0x6a, 0xa6, 0x6e, 0x9c, 0x3e, 0xea, 0x76, 0xa0, 0xc4, 0x0e, 0xf0, 0x55, 0x13, 0x49, 0x7c, 0x40 },
+  { 0x6a, 0xc3, 0xfd, 0x31, 0xa5, 0x17, 0x30, 0x35, 0x87, 0x08, 0xc7, 0xfd, 0xc6, 0x24, 0x87, 0xf8 },
+  { 0x6a, 0xe4, 0xdc, 0x6d, 0x73, 0x51, 0xda, 0xcd, 0x10, 0x12, 0x74, 0x9c, 0xa8, 0x2f, 0x9a, 0x56 },
+  { 0x6b, 0x01, 0xa5, 0x19, 0xb4, 0x13, 0xf8, 0xcf, 0xa2, 0xf3, 0x99, 0xf4, 0xd2, 0x84, 0x1b, 0x42 },
+  { 0x6b, 0x1f, 0xc9, 0x59, 0xe2, 0x8b, 0xd7, 0x1a, 0xed, 0x7b, 0x89, 0x01, 0x45, 0x74, 0xbd, 0xc2 },
+  { 0x6b, 0x4e, 0xb5, 0xb3, 0xdf, 0x80, 0x99, 0x5b, 0x8d, 0x91, 0x17, 0xcb, 0x7e, 0x9a, 0xeb, 0x3c },
+  { 0x6b, 0x68, 0x3b, 0xe6, 0x9f, 0x92, 0x95, 0x8a, 0xbe, 0x0e, 0x2a, 0x99, 0x45, 0x15, 0x7a, 0xd5 },
+  { 0x6b, 0x6c, 0xa3, 0x22, 0x28, 0xae, 0x35, 0x2b, 0x42, 0x67, 0xe4, 0xbd, 0x2c, 0xdd, 0xf1, 0x0c },
+  { 0x6b, 0x71, 0xf2, 0x0c, 0x85, 0x75, 0x74, 0xb7, 0x32, 0xe7, 0xa8, 0xe8, 0x40, 0xbd, 0x3c, 0xb2 },
+  { 0x6b, 0x72, 0xb6, 0x91, 0xea, 0x86, 0xf6, 0x14, 0x38, 0xed, 0x0d, 0x84, 0xc4, 0xd7, 0x11, 0xde },
+  { 0x6b, 0x75, 0xf8, 0xfa, 0x4f, 0xd0, 0x11, 0xa6, 0x69, 0x8c, 0x58, 0x31, 0x5f, 0x83, 0xd2, 0xac },
+  { 0x6b, 0x7a, 0x56, 0xb6, 0xac, 0x2c, 0xa4, 0xbf, 0x92, 0x54, 0x47, 0x4b, 0xf6, 0xed, 0x7d, 0x80 },
+  { 0x6b, 0x7e, 0x1c, 0x11, 0x44, 0x8c, 0x4d, 0x3f, 0x28, 0x16, 0x0d, 0x2d, 0xe8, 0x84, 0xeb, 0xc8 },
+  { 0x6b, 0x8f, 0xb0, 0x21, 0xbb, 0x2e, 0x1f, 0x1e, 0x9b, 0xd7, 0xee, 0x57, 0xf2, 0xa8, 0xe7, 0x09 },
+  { 0x6b, 0xb0, 0x9b, 0xc9, 0x15, 0xa7, 0x41, 0x1f, 0xe1, 0x60, 0xd0, 0xb2, 0xe4, 0xd6, 0x60, 0x47 },
+  { 0x6b, 0xb2, 0x2e, 0xfa, 0x89, 0x2b, 0x89, 0xb6, 0x9b, 0x9b, 0xf5, 0xea, 0x54, 0x7e, 0x62, 0xb8 },
+  { 0x6b, 0xde, 0x3f, 0x6a, 0xc3, 0x1a, 0xce, 0xef, 0x44, 0x7c, 0xe5, 0x7d, 0x4d, 0x2c, 0x2e, 0xc0 },
+  { 0x6c, 0x12, 0x8b, 0xc9, 0x50, 0xfc, 0xbd, 0xbc, 0xaf, 0x0d, 0x99, 0x93, 0x5d, 0xa7, 0x01, 0x56 },
+  { 0x6c, 0x15, 0x53, 0xca, 0x90, 0xb4, 0x13, 0xbf, 0x76, 0x2d, 0xfc, 0x65, 0xf2, 0xb8, 0x81, 0xc7 },
+  { 0x6c, 0x1f, 0x3f, 0x2e, 0x35, 0x9d, 0xbf, 0x55, 0xdf, 0x46, 0x2c, 0xcb, 0xcd, 0xd2, 0xf6, 0xbf },
+  { 0x6c, 0x25, 0xf5, 0x8f, 0xd1, 0x84, 0x63, 0x2c, 0xa7, 0x60, 0x20, 0xf5, 0x89, 0xbb, 0x37, 0x67 },
+  { 0x6c, 0x44, 0x9d, 0xb9, 0xbb, 0xbd, 0x90, 0x97, 0x2a, 0xd1, 0x93, 0x2d, 0x6a, 0xf8, 0x73, 0x30 },
+  { 0x6c, 0x65, 0x8b, 0x52, 0xd0, 0x3e, 0x01, 0x82, 0x8b, 0x9d, 0x2d, 0x47, 0x18, 0xa9, 0x98, 0xac },
+  { 0x6c, 0x76, 0xfe, 0x09, 0xaa, 0x8b, 0x39, 0xee, 0x52, 0x03, 0x5e, 0x0d, 0xa6, 0xd0, 0x80, 0x8b },
+  { 0x6c, 0x85, 0x09, 0x85, 0x18, 0xd3, 0xf9, 0x4f, 0x76, 0x22, 0xc4, 0x2f, 0xd1, 0xd8, 0x19, 0xac },
+  { 0x6c, 0x91, 0xac, 0x51, 0x42, 0x1c, 0xb9, 0xfc, 0x72, 0xc9, 0x83, 0x3c, 0x4f, 0x44, 0x0d, 0x65 },
+  { 0x6c, 0x9a, 0x32, 0xad, 0x83, 0xbc, 0xfd, 0xe3, 0x77, 0x45, 0x36, 0xe5, 0x2b, 0xe1, 0xcc, 0xe7 },
+  { 0x6c, 0xbe, 0x94, 0x5e, 0x16, 0xd9, 0xf8, 0x27, 0xd0, 0xd2, 0x95, 0x54, 0x6a, 0xc1, 0x1b, 0x22 },
+  { 0x6c, 0xcd, 0x8c, 0xa1, 0x7a, 0x0e, 0x44, 0x29, 0xb4, 0x46, 0xcd, 0xcb, 0x66, 0x32, 0x7b, 0xf1 },
+  { 0x6c, 0xd1, 0xdc, 0x96, 0x0e, 0x3e, 0x8d, 0x5c, 0x5e, 0x0f, 0xbe, 0x67, 0xab, 0x49, 0x08, 0x7a },
+  { 0x6c, 0xd5, 0x06, 0x50, 0x9e, 0x8f, 0xd5, 0x62, 0x7f, 0x55, 0x60, 0x37, 0x80, 0xe8, 0x62, 0xa8 },
+  { 0x6c, 0xe2, 0x11, 0x0a, 0xc5, 0xdd, 0x89, 0xab, 0x39, 0x8d, 0x94, 0x52, 0x89, 0x17, 0x52, 0xab },
+  { 0x6c, 0xea, 0x35, 0xde, 0xd0, 0x79, 0x86, 0x3a, 0x84, 0x61, 0x59, 0xc3, 0xa1, 0x10, 0x1c, 0xc7 },
+  { 0x6c, 0xeb, 0x7d, 0x6a, 0x54, 0xe9, 0xa5, 0xe6, 0x2d, 0x26, 0x87, 0x4d, 0x1c, 0xc8, 0x8d, 0xbc },
+  { 0x6c, 0xf0, 0x54, 0xcd, 0x23, 0xa0, 0x2e, 0x09, 0x29, 0x8d, 0x2c, 0x6f, 0x78, 0x7e, 0xb2, 0x1d },
+  { 0x6d, 0x21, 0x8d, 0xaf, 0xbf, 0x5a, 0x69, 0x10, 0x45, 0xcd, 0xc1, 0xf6, 0x7c, 0xeb, 0x6a, 0x8f },
+  { 0x6d, 0x47, 0x50, 0x19, 0xea, 0x30, 0xd0, 0xb2, 0x9f, 0x69, 0x5e, 0x9d, 0xcf, 0xd8, 0xf7, 0x30 },
+  { 0x6d, 0x74, 0xeb, 0xab, 0xa9, 0x14, 0xa5, 0xcf, 0xc8, 0x68, 0xde, 0x9d, 0xd1, 0xa5, 0xc4, 0x34 },
+  { 0x6d, 0x84, 0x2c, 0x96, 0xd5, 0xa0, 0x19, 0x67, 0xbe, 0x96, 0x80, 0x08, 0x0d, 0xd5, 0xbe, 0x54 },
+  { 0x6d, 0x8a, 0x04, 0xee, 0x15, 0x95, 0x14, 0x80, 0xcb, 0x7c, 0x46, 0x6e, 0x59, 0x51, 0xee, 0xe0 },
+  { 0x6d, 0x9a, 0xfd, 0x70, 0xe9, 0x36, 0x9c, 0x2a, 0x6b, 0xff, 0x96, 0xc4, 0x96, 0x44, 0x13, 0xb7 },
+  { 0x6d, 0xda, 0x84, 0xfb, 0x8e, 0x44, 0x2e, 0xcf, 0x34, 0x24, 0x1a, 0xc0, 0xd1, 0xd9, 0x1d, 0x69 },
+  { 0x6d, 0xe9, 0x24, 0xc2, 0x29, 0x7c, 0x87, 0x33, 0x52, 0x49, 0x52, 0x44, 0x8d, 0x54, 0xa3, 0x3c },
+  { 0x6d, 0xfa, 0xd2, 0xdd, 0x2c, 0x7c, 0x16, 0xac, 0x0f, 0xa2, 0x57, 0xb6, 0xce, 0x0b, 0xe2, 0xf0 },
+  { 0x6e, 0x17, 0x9e, 0xee, 0x3d, 0x46, 0x31, 0xa7, 0x43, 0x4d, 0x40, 0xcf, 0x7a, 0xee, 0xa6, 0xe8 },
+  { 0x6e, 0x19, 0x42, 0x83, 0x87, 0x68, 0x6a, 0x77, 0xd8, 0xc8, 0xd2, 0xf7, 0x31, 0xcb, 0x09, 0xe0 },
+  { 0x6e, 0x37, 0x2f, 0x07, 0x6f, 0xb9, 0x58, 0x6a, 0xff, 0x41, 0x61, 0x44, 0xf5, 0xcf, 0xe1, 0xcb },
+  { 0x6e, 0x45, 0x21, 0x98, 0x9a, 0x60, 0xa0, 0xdd, 0xf4, 0xff, 0x1f, 0xc6, 0xe6, 0xe5, 0xfc, 0x3d },
+  { 0x6e, 0x59, 0xdd, 0x52, 0xf8, 0x8c, 0x00, 0xd5, 0x06, 0x0e, 0xac, 0x56, 0xc1, 0xa0, 0xb0, 0xd3 },
+  { 0x6e, 0x5d, 0x5b, 0xa1, 0x93, 0xd2, 0x54, 0x0a, 0xec, 0x2e, 0x84, 0x7a, 0xaf, 0xb2, 0xa5, 0xfb },
+  { 0x6e, 0x7e, 0xd7, 0x40, 0x82, 0xf3, 0x9a, 0xd4, 0x16, 0x6c, 0x82, 0x37, 0x65, 0xa5, 0x99, 0x09 },
+  { 0x6e, 0xd5, 0x01, 0x27, 0x93, 0xf5, 0xdd, 0xf4, 0x35, 0x3a, 0x48, 0xc1, 0x1e, 0xa9, 0xb8, 0xd3 },
+  { 0x6e, 0xd6, 0xbd, 0xa5, 0xc4, 0x2b, 0x2e, 0xb7, 0xa2, 0x1c, 0x54, 0xe5, 0xb3, 0xac, 0xe3, 0xe3 },
+  { 0x6e, 0xfe, 0x87, 0x61, 0x68, 0xe2, 0xd4, 0x5d, 0x47, 0x19, 0xb6, 0xa6, 0x13, 0x55, 0xe5, 0xfe },
+  { 0x6f, 0x08, 0x4d, 0xaf, 0x26, 0x55, 0x99, 0xf6, 0x54, 0x22, 0xef, 0x41, 0x73, 0xb6, 0x9b, 0xc7 },
+  { 0x6f, 0x2a, 0xaf, 0xfa, 0xaf, 0x53, 0xd2, 0x3a, 0x28, 0xbf, 0x66, 0x77, 0xb8, 0x6a, 0xc0, 0xe3 },
+  { 0x6f, 0x3e, 0x33, 0x06, 0xda, 0x2a, 0xa6, 0xe7, 0x4a, 0x5e, 0x04, 0x6f, 0xf4, 0x3b, 0xf0, 0x28 },
+  { 0x6f, 0x74, 0xed, 0x91, 0x5f, 0xfe, 0x73, 0xb5, 0x24, 0xef, 0x0f, 0x63, 0x81, 0x9e, 0x2a, 0x1d },
+  { 0x6f, 0x75, 0xd7, 0x2e, 0x4c, 0xf9, 0x96, 0x10, 0x0c, 0xcd, 0xd1, 0x63, 0xd5, 0x7b, 0xda, 0xc2 },
+  { 0x6f, 0xa0, 0xac, 0x69, 0x43, 0xe3, 0x36, 0x37, 0xd8, 0xe7, 0x7d, 0xf1, 0x49, 0x62, 0xfb, 0xfc },
+  { 0x6f, 0xac, 0x68, 0x0f, 0xc9, 0xa7, 0x2e, 0x0e, 0x54, 0x25, 0x55, 0x67, 0xc7, 0x2a, 0xfe, 0x34 },
+  { 0x6f, 0xbd, 0x05, 0xb0, 0xad, 0x65, 0xb2, 0xa2, 0x61, 0xfa, 0x15, 0x4b, 0x34, 0x32, 0x8a, 0x7f },
+  { 0x6f, 0xc0, 0x17, 0x6c, 0xcf, 0x53, 0xd7, 0xbc, 0xe2, 0x49, 0xae, 0xb5, 0x6d, 0x59, 0xd4, 0x14 },
+  { 0x6f, 0xc2, 0x7a, 0x92, 0x33, 0xfc, 0x69, 0xd2, 0x8d, 0x3f, 0x19, 0x0b, 0x4f, 0xf8, 0x0f, 0x03 },
+  { 0x6f, 0xc3, 0x94, 0xdb, 0xf2, 0x1c, 0xf5, 0x41, 0xa6, 0x0e, 0x3b, 0x36, 0x31, 0xb8, 0x17, 0xf1 },
+  { 0x6f, 0xd7, 0xc7, 0x05, 0x7e, 0xea, 0xb2, 0x73, 0xb2, 0x9c, 0x7a, 0xaf, 0xc7, 0x42, 0x9a, 0x96 },
+  { 0x6f, 0xe6, 0x7f, 0x52, 0x5c, 0x39, 0x20, 0x0a, 0x79, 0x89, 0x85, 0xe4, 0x19, 0x43, 0x18, 0x05 },
+  { 0x6f, 0xf4, 0x15, 0x6d, 0x10, 0xb3, 0x57, 0xf6, 0x1f, 0x09, 0x82, 0x0d, 0x03, 0xc0, 0xf8, 0x52 },
+  { 0x6f, 0xfc, 0x95, 0x10, 0x8e, 0x5a, 0xdd, 0x6f, 0x9b, 0x8a, 0xbc, 0xaf, 0x33, 0x0b, 0xe8, 0x35 },
+  { 0x70, 0x0a, 0x78, 0x64, 0x71, 0xc8, 0xa9, 0x1e, 0xc0, 0x9e, 0x2f, 0x8e, 0x47, 0xf1, 0x4a, 0x04 },
+  { 0x70, 0x3d, 0x32, 0x06, 0x24, 0x36, 0xe4, 0xc2, 0x0c, 0x48, 0x31, 0x3d, 0xff, 0x30, 0xe2, 0x57 },
+  { 0x70, 0x3f, 0x0f, 0x7a, 0xf3, 0x50, 0xb0, 0xfa, 0x29, 0xdf, 0xe5, 0xfb, 0xf4, 0x5d, 0x0d, 0x75 },
+  { 0x70, 0x5f, 0xe7, 0x19, 0x17, 0x9e, 0x65, 0xb0, 0xaf, 0x32, 0x86, 0x44, 0xf3, 0xa0, 0x49, 0x00 },
+  { 0x70, 0x6e, 0x3c, 0xc4, 0x93, 0x1f, 0x98, 0x44, 0x47, 0x21, 0x3b, 0x92, 0xd1, 0x41, 0x7a, 0xff },
+  { 0x70, 0x7e, 0xcd, 0x80, 0x03, 0x0e, 0x85, 0x75, 0x1e, 0xf3, 0x11, 0xce, 0xd6, 0x62, 0x20, 0xbc },
+  { 0x70, 0x96, 0xa1, 0x98, 0x53, 0x1d, 0x3f, 0x16, 0xa9, 0x9d, 0x51, 0x8a, 0xc0, 0xd7, 0x51, 0x9a },
+  { 0x70, 0x99, 0x10, 0xc2, 0xe8, 0x33, 0x61, 0xbc, 0x4b, 0xf8, 0xcd, 0x0c, 0x20, 0xc3, 0x4f, 0xbf },
+  { 0x70, 0xa8, 0x48, 0x0c, 0xfa, 0xf0, 0x87, 0x76, 0xe5, 0x42, 0x03, 0x65, 0x73, 0x21, 0x59, 0xd2 },
+  { 0x70, 0xce, 0x03, 0x6e, 0x59, 0xbe, 0x92, 0x82, 0x1c, 0x4c, 0x7f, 0xd7, 0x35, 0xec, 0x6f, 0x68 },
+  { 0x70, 0xd1, 0x4c, 0x66, 0xc3, 0x19, 0x68, 0x3b, 0x4c, 0x19, 0xab, 0xbe, 0x0e, 0x3d, 0xb5, 0x7c },
+  { 0x71, 0x04, 0x97, 0xdf, 0x2c, 0xaa, 0xb6, 0x9c, 0xdc, 0xc4, 0x5e, 0x91, 0x9c, 0x69, 0xe1, 0x3f },
+  { 0x71, 0x3f, 0xde, 0x2a, 0xf8, 0x65, 0xb6, 0xec, 0x46, 0x4d, 0xfd, 0x72, 0xe2, 0xeb, 0xb8, 0x3e },
+  { 0x71, 0x46, 0x4c, 0x54, 0xda, 0x46, 0xad, 0xae, 0x94, 0x47, 0x92, 0x6f, 0xdb, 0xfc, 0x1a, 0xbe },
+  { 0x71, 0x4e, 0x13, 0xc0, 0x85, 0x08, 0xee, 0x9a, 0x77, 0x85, 0xce, 0xac, 0x90, 0x8a, 0xe8, 0x31 },
+  { 0x71, 0x5d, 0xbf, 0x2e, 0x39, 0xba, 0x8a, 0x52, 0xc5, 0xfe, 0x5c, 0xdd, 0x92, 0x7b, 0x37, 0xe0 },
+  { 0x71, 0x5d, 0xd9, 0xe0, 0x24, 0x06, 0x38, 0xd4, 0x41, 0xa3, 0xad, 0xd4, 0x93, 0x16, 0xc0, 0x18 },
+  { 0x71, 0x87, 0x11, 0x86, 0x74, 0xff, 0x3c, 0x0b, 0xb9, 0x32, 0xe0, 0x49, 0xd9, 0xdb, 0xb3, 0x79 },
+  { 0x71, 0x8a, 0xe6, 0x2c, 0x70, 0xaf, 0x4e, 0x5f, 0xd8, 0xe9, 0x32, 0xfe, 0xe2, 0x16, 0x94, 0x8a },
+  { 0x71, 0x8e, 0xe8, 0x5e, 0xa7, 0xec, 0x27, 0xd5, 0xbe, 0xa6, 0x0d, 0x11, 0xf6, 0xd4, 0x00, 0x30 },
+  { 0x71, 0x97, 0xb6, 0xcb, 0xde, 0x6e, 0xcd, 0x10, 0x37, 0x61, 0x55, 0xe6, 0xb8, 0x48, 0xe8, 0x0d },
+  { 0x71, 0xb1, 0x93, 0xf4, 0x6c, 0x88, 0xfb, 0x23, 0x43, 0x29, 0x85, 0x54, 0x52, 0xdf, 0xac, 0x5b },
+  { 0x71, 0xd0, 0x05, 0xb6, 0x0c, 0xf6, 0xe6, 0x08, 0xd0, 0x4e, 0xfb, 0x99, 0xa3, 0x73, 0x62, 0xc3 },
+  { 0x71, 0xf0, 0x9f, 0x12, 0x8e, 0x76, 0xeb, 0x14, 0xe2, 0x44, 0xbe, 0x8f, 0x44, 0x84, 0x87, 0x59 },
+  { 0x71, 0xf8, 0xba, 0xcf, 0xbd, 0xca, 0x01, 0x91, 0x13, 0xf3, 0xf0, 0x80, 0x18, 0x49, 0x05, 0x7e },
+  { 0x72, 0x09, 0x7e, 0x9d, 0xc3, 0x66, 0x90, 0x0b, 0xa2, 0xda, 0x73, 0xa4, 0x7e, 0x3e, 0x80, 0xf5 },
+  { 0x72, 0x1a, 0x55, 0x67, 0xf7, 0x68, 0x56, 0xf6, 0xb5, 0x0a, 0x67, 0x07, 0xaa, 0x8f, 0x83, 0x16 },
+  { 0x72, 0x30, 0x5c, 0x99, 0x7f, 0x2c, 0xec, 0x41, 0x4f, 0xe6, 0xf8, 0xc9, 0x46, 0x17, 0x2f, 0x83 },
+  { 0x72, 0x46, 0x13, 0xef, 0xfa, 0xf7, 0x74, 0x3c, 0xbc, 0xd6, 0x95, 0xfa, 0xb4, 0x69, 0xc2, 0xa8 },
+  { 0x72, 0x81, 0x52, 0xf5, 0xae, 0x6f, 0xdd, 0x0d, 0x3a, 0x9b, 0x88, 0x70, 0x9b, 0xee, 0x6c, 0x7a },
+  { 0x72, 0x87, 0x6f, 0xd7, 0xc7, 0x43, 0x5f, 0x41, 0xd5, 0x71, 0xf1, 0x10, 0x1f, 0xc4, 0x56, 0xea },
+  { 0x72, 0xa4, 0x6e, 0x0c, 0x21, 0xf8, 0x25, 0x51, 0x8b, 0x72, 0x61, 0xc2, 0x67, 0xab, 0x88, 0x6e },
+  { 0x72, 0xa5, 0xb5, 0x05, 0x22, 0x72, 0xac, 0x78, 0x5f, 0xa0, 0x76, 0x70, 0x9d, 0x16, 0xce, 0xf4 },
+  { 0x72, 0xbd, 0xa7, 0x0c, 0x75, 0xdf, 0xa2, 0x36, 0x5b, 0x3f, 0x88, 0x94, 0xba, 0xce, 0x9e, 0x6a },
+  { 0x72, 0xd0, 0xac, 0xb5, 0xde, 0x0d, 0xb6, 0x62, 0xde, 0x03, 0x60, 0xa6, 0xfc, 0x59, 0x33, 0x4d },
+  { 0x72, 0xdb, 0x11, 0x94, 0xb1, 0xcc, 0x7d, 0x45, 0xb2, 0x42, 0xf2, 0x5e, 0xb1, 0xc1, 0x48, 0xd3 },
+  { 0x72, 0xfd, 0x08, 0xde, 0xed, 0x1d, 0x61, 0x95, 0x94, 0x2e, 0x0c, 0x6f, 0x39, 0x2e, 0x98, 0x48 },
+  { 0x72, 0xff, 0xbe, 0xf6, 0x50, 0x4b, 0x75, 0xe6, 0x9e, 0xe1, 0x04, 0x5a, 0xf9, 0x07, 0x5f, 0x66 },
+  { 0x73, 0x15, 0x8e, 0xa5, 0x1d, 0x77, 0xbf, 0x52, 0x1e, 0x13, 0x69, 0x31, 0x1d, 0x26, 0xc2, 0x7b },
+  { 0x73, 0x52, 0x1c, 0x6b, 0x9f, 0xed, 0x6a, 0x24, 0x3d, 0x9b, 0x7b, 0x16, 0x1a, 0x0f, 0xb7, 0x93 },
+  { 0x73, 0x63, 0x88, 0xd7, 0x31, 0x98, 0x55, 0x2d, 0x77, 0xd4, 0x23, 0x96, 0x20, 0x00, 0x00, 0x6f },
+  { 0x73, 0xa7, 0x10, 0xe6, 0x21, 0xd4, 0x4e, 0x97, 0x03, 0x9d, 0x64, 0x00, 0x71, 0x90, 0x8a, 0xef },
+  { 0x73, 0xaa, 0x02, 0x45, 0x8b, 0x41, 0x30, 0x91, 0xac, 0x94, 0x0c, 0x04, 0x89, 0x30, 0x17, 0x10 },
+  { 0x73, 0xb4, 0xe8, 0xf8, 0xb0, 0x45, 0x15, 0xd9, 0x19, 0x37, 0x51, 0x0e, 0x68, 0x02, 0x14, 0xbc },
+  { 0x73, 0xc5, 0x45, 0xdb, 0x2a, 0xfd, 0x57, 0x83, 0xd3, 0x7c, 0x46, 0x00, 0x4e, 0x40, 0x24, 0xc2 },
+  { 0x73, 0xc8, 0x39, 0xaf, 0xf6, 0xa0, 0x55, 0x64, 0x30, 0x44, 0xd2, 0xce, 0x16, 0xb3, 0xaa, 0xf7 },
+  { 0x73, 0xcb, 0x1f, 0x16, 0x66, 0xf3, 0xfd, 0x30, 0xb5, 0x2b, 0x4f, 0x3d, 0x76, 0x0c, 0x92, 0x8f },
+  { 0x73, 0xe6, 0x6e, 0x82, 0xac, 0x22, 0xb3, 0x05, 0xeb, 0x4d, 0x95, 0x78, 0xe8, 0x66, 0x23, 0x6e },
+  { 0x73, 0xef, 0xa9, 0xf3, 0xcb, 0xe1, 0x97, 0xf2, 0x6e, 0x0f, 0xb8, 0x71, 0x32, 0x82, 0x92, 0x32 },
+  { 0x74, 0x02, 0x3e, 0x0f, 0x2e, 0x73, 0x9f, 0xc5, 0xa9, 0xba, 0x7c, 0xaa, 0xee, 0xee, 0x8b, 0x6b },
+  { 0x74, 0x0a, 0x7f, 0xa8, 0x0f, 0x52, 0xcc, 0x72, 0x87, 0xba, 0x37, 0x67, 0x7a, 0xfb, 0x6b, 0x21 },
+  { 0x74, 0x0b, 0x47, 0xdf, 0x42, 0x23, 0x72, 0xfb, 0xef, 0x70, 0x0b, 0x42, 0xce, 0xa4, 0xe0, 0xbf },
+  { 0x74, 0x0f, 0x39, 0xe7, 0x11, 0x04, 0xe9, 0x04, 0x16, 0xc2, 0x9a, 0x73, 0x56, 0x0b, 0x9c, 0x6b },
+  { 0x74, 0x2d, 0xe9, 0x3b, 0x8d, 0x84, 0x92, 0x20, 0xf2, 0x66, 0xb6, 0x27, 0xfb, 0xab, 0xba, 0x82 },
+  { 0x74, 0x50, 0xae, 0x4e, 0x10, 0xba, 0x83, 0x80, 0xc5, 0x5b, 0x25, 0x9d, 0x7c, 0x2b, 0x13, 0xe8 },
+  { 0x74, 0x54, 0x78, 0x6a, 0xf7, 0x12, 0x6c, 0xcc, 0x7a, 0x0c, 0x31, 0xfc, 0xf5, 0xaf, 0x40, 0xf1 },
+  { 0x74, 0x65, 0xb0, 0x6b, 0x6e, 0x25, 0xa4, 0xa6, 0xc6, 0xd7, 0x7d, 0x02, 0x24, 0x2a, 0xf6, 0xd6 },
+  { 0x74, 0x81, 0xf0, 0x77, 0x1b, 0xff, 0x13, 0x88, 0x5b, 0x2f, 0xf2, 0x57, 0x0c, 0xf9, 0x0d, 0x7b },
+  { 0x74, 0x9f, 0xec, 0x99, 0x18, 0x16, 0x09, 0x21, 0x57, 0x6f, 0x85, 0x0b, 0x23, 0x75, 0xb5, 0x16 },
+  { 0x74, 0xca, 0x9b, 0xdc, 0x91, 0xee, 0x38, 0x7a, 0x5b, 0xd9, 0x29, 0xb7, 0x3a, 0xec, 0x5c, 0x2c },
+  { 0x74, 0xd0, 0x72, 0xe8, 0xa3, 0x45, 0x60, 0xc3, 0x6c, 0xac, 0xbc, 0x57, 0xb2, 0x46, 0x23, 0x60 },
+  { 0x74, 0xeb, 0xac, 0xa1, 0x01, 0xcc, 0x42, 0x8c, 0xf2, 0x19, 0xf1, 0x5d, 0xda, 0x84, 0xb6, 0xf8 },
+  { 0x74, 0xf6, 0x23, 0x83, 0x34, 0x29, 0xd3, 0x53, 0x41, 0xb7, 0xa8, 0x4b, 0xc0, 0x97, 0x93, 0xc0 },
+  { 0x75, 0x02, 0x81, 0x62, 0xbf, 0xc4, 0xcc, 0x8e, 0x74, 0xb0, 0x4e, 0x32, 0x0f, 0x9e, 0x6a, 0x3f },
+  { 0x75, 0x11, 0xc3, 0x45, 0x18, 0xa9, 0xa1, 0x24, 0xea, 0x77, 0x3f, 0x5b, 0x0b, 0x5c, 0x9a, 0x48 },
+  { 0x75, 0x16, 0x9c, 0x08, 0xb5, 0x6e, 0x4e, 0x6c, 0x36, 0x68, 0x1e, 0x59, 0x9c, 0x4d, 0x8c, 0xc5 },
+  { 0x75, 0x33, 0x75, 0xd1, 0x83, 0xc7, 0x13, 0xcf, 0xa0, 0xaa, 0x72, 0x98, 0xd1, 0xf3, 0x06, 0x7b },
+  { 0x75, 0x50, 0xb8, 0x21, 0xee, 0x56, 0xfb, 0x58, 0x33, 0xdc, 0xa2, 0xbe, 0x88, 0x62, 0x2d, 0x5a },
+  { 0x75, 0x51, 0x1b, 0xb6, 0x94, 0x66, 0x23, 0x01, 0xc9, 0xe7, 0x1d, 0xf6, 0x45, 0xf4, 0xb5, 0xa7 },
+  { 0x75, 0x5f, 0xed, 0x16, 0xb4, 0x8e, 0x81, 0xde, 0x05, 0x13, 0x07, 0x08, 0xa9, 0x05, 0xd0, 0x0d },
+  { 0x75, 0x6c, 0xa0, 0x7a, 0x65, 0xa4, 0xfb, 0xbe, 0xde, 0xb5, 0xf0, 0xdd, 0xfc, 0x04, 0xd0, 0xbe },
+  { 0x75, 0x74, 0x48, 0x0a, 0xe2, 0xab, 0x0d, 0x28, 0x2c, 0x88, 0x7e, 0x90, 0x15, 0xfd, 0xb5, 0x4c },
+  { 0x75, 0x76, 0xdd, 0x46, 0xc2, 0xf8, 0xd8, 0xab, 0x15, 0x9d, 0x97, 0xe3, 0xa3, 0xf2, 0x05, 0x2f },
+  { 0x75, 0x7f, 0x52, 0x90, 0x26, 0x69, 0x6e, 0x13, 0x83, 0x83, 0x64, 0xde, 0xa3, 0x82, 0xa4, 0xed },
+  { 0x75, 0xa3, 0x03, 0xfd, 0x46, 0xad, 0x12, 0x45, 0x7e, 0xd8, 0xe8, 0x53, 0x01, 0x68, 0x15, 0xa0 },
+  { 0x75, 0xb2, 0x2f, 0xdf, 0x63, 0x2d, 0x76, 0xe2, 0x46, 0x43, 0x3d, 0xb1, 0xeb, 0xcc, 0xd3, 0xc4 },
+  { 0x75, 0xb5, 0x57, 0xbe, 0x7f, 0x08, 0xdb, 0x84, 0xec, 0x5b, 0x24, 0x22, 0x07, 0xb9, 0xf2, 0x41 },
+  { 0x75, 0xe2, 0x76, 0xba, 0x12, 0xdc, 0x45, 0x04, 0x65, 0x94, 0x81, 0xc3, 0x13, 0x45, 0x70, 0x3a },
+  { 0x75, 0xe8, 0xd8, 0xb9, 0xe9, 0xc5, 0xc6, 0x7c, 0x22, 0x26, 0xdb, 0xfd, 0x77, 0xdc, 0xfa, 0x7d },
+  { 0x75, 0xea, 0x12, 0x8b, 0xa9, 0x6a, 0xc6, 0xdb, 0x8e, 0xdf, 0x54, 0xb0, 0x71, 0x02, 0x7c, 0x4e },
+  { 0x75, 0xea, 0x60, 0x88, 0x4c, 0x05, 0xba, 0x49, 0x64, 0x73, 0xc2, 0x3a, 0x58, 0xed, 0xf1, 0x2f },
+  { 0x75, 0xee, 0x37, 0x1c, 0xcf, 0xc4, 0xf4, 0x3e, 0x7d, 0x9b, 0x8f, 0x24, 0xe1, 0x26, 0x6b, 0x55 },
+  { 0x76, 0x08, 0xab, 0xdf, 0xd9, 0xb2, 0x6f, 0x4a, 0x0e, 0xce, 0xc1, 0x8b, 0x23, 0x2b, 0xea, 0x54 },
+  { 0x76, 0x23, 0xa6, 0x39, 0xa6, 0xff, 0xfd, 0xb2, 0x46, 0x77, 0x5f, 0xe2, 0xea, 0xbc, 0x8d, 0x01 },
+  { 0x76, 0x28, 0xd3, 0xca, 0xde, 0xee, 0x0f, 0xd2, 0xe4, 0x1e, 0x68, 0xb3, 0xb8, 0xfb, 0xe2, 0x29 },
+  { 0x76, 0x48, 0xe7, 0x2a, 0x5b, 0x58, 0x99, 0x07, 0x66, 0x88, 0xdf, 0x18, 0xa1, 0xdd, 0xcf, 0x72 },
+  { 0x76, 0x80, 0x9e, 0xb1, 0xee, 0x0d, 0xb8, 0xa3, 0x18, 0x30, 0x8a, 0x5c, 0xdd, 0xa0, 0xf4, 0xe2 },
+  { 0x76, 0x9d, 0xdc, 0x99, 0x5d, 0xbb, 0x9e, 0xdb, 0x81, 0x67, 0xef, 0xce, 0xa9, 0xf3, 0x4a, 0x7c },
+  { 0x76, 0xa9, 0xbf, 0x05, 0xa6, 0xde, 0x84, 0x18, 0xa3, 0xeb, 0xc7, 0xfc, 0x25, 0x4b, 0x71, 0xb4 },
+  { 0x76, 0xc6, 0x85, 0xd1, 0xa6, 0x0c, 0x01, 0x07, 0xaa, 0x54, 0xa7, 0x72, 0x11, 0x3a, 0x29, 0x72 },
+  { 0x76, 0xc8, 0x83, 0x41, 0x01, 0x7e, 0xae, 0x66, 0x0e, 0xfc, 0x6e, 0x49, 0xc4, 0xb6, 0xab, 0x40 },
+  { 0x76, 0xee, 0x91, 0x7d, 0x81, 0x7e, 0xf9, 0xa6, 0x54, 0xbc, 0x47, 0x83, 0xe0, 0x27, 0x3a, 0xc4 },
+  { 0x76, 0xf5, 0x3a, 0xbb, 0xbf, 0x39, 0xa0, 0x06, 0x3f, 0x24, 0x03, 0x6d, 0x6e, 0xe0, 0x96, 0x8a },
+  { 0x76, 0xf6, 0x6c, 0xe3, 0xb8, 0x3d, 0x7a, 0x10, 0x4a, 0x89, 0x9b, 0x4b, 0x33, 0x54, 0xa2, 0xf2 },
+  { 0x77, 0x05, 0x7d, 0x9d, 0x14, 0xb9, 0x9e, 0x46, 0x5e, 0xa9, 0xe2, 0x97, 0x83, 0xaf, 0x0a, 0xe3 },
+  { 0x77, 0x32, 0xe4, 0xe4, 0xcc, 0x26, 0x44, 0xf1, 0x63, 0xd6, 0x65, 0x0d, 0xdc, 0xc9, 0xd9, 0xdf },
+  { 0x77, 0x78, 0xac, 0x65, 0xd7, 0x75, 0xa0, 0x79, 0xf5, 0x37, 0xe9, 0x7c, 0xbd, 0xad, 0x54, 0x1c },
+  { 0x77, 0x7a, 0xec, 0xe9, 0x8d, 0x73, 0x73, 0x99, 0x8f, 0xfb, 0x8b, 0xc0, 0xb5, 0xef, 0xf1, 0xa2 },
+  { 0x77, 0x88, 0x7e, 0x41, 0x92, 0xa6, 0xb0, 0xa7, 0x81, 0x53, 0x0e, 0x6c, 0xf9, 0xbe, 0x71, 0x99 },
+  { 0x77, 0xbe, 0x57, 0xd8, 0x72, 0xe3, 0xf5, 0xb7, 0xec, 0xf8, 0xd1, 0x9d, 0x97, 0xf7, 0x32, 0x81 },
+  { 0x77, 0xcd, 0x9a, 0x9d, 0xd8, 0x10, 0xce, 0x80, 0x42, 0xbd, 0xb9, 0xd4, 0x0e, 0x25, 0x6d, 0xfe },
+  { 0x77, 0xd0, 0xa5, 0x77, 0x63, 0x6e, 0x1c, 0x92, 0x12, 0xae, 0xcc, 0xde, 0x9d, 0x0b, 0xaa, 0x4b },
+  { 0x78, 0x29, 0x7d, 0xb7, 0xf4, 0x16, 0xaf, 0x30, 0x52, 0xdd, 0x79, 0x3b, 0x53, 0xff, 0x01, 0x4e },
+  { 0x78, 0x36, 0x79, 0x4b, 0x79, 0xe8, 0x06, 0x0c, 0x2b, 0x83, 0x26, 0xa2, 0xdb, 0x74, 0xee, 0xf0 },
+  { 0x78, 0x41, 0x76, 0x34, 0x6e, 0x94, 0x22, 0x73, 0x3d, 0x55, 0xc4, 0x27, 0x23, 0x0e, 0x5b, 0xad },
+  { 0x78, 0x60, 0x71, 0x6f, 0xa5, 0xdb, 0xc0, 0xff, 0xfa, 0xb9, 0x3f, 0xb9, 0xa4, 0xcb, 0x41, 0x32 },
+  { 0x78, 0x67, 0xee, 0x81, 0x9b, 0x53, 0xd6, 0x9c, 0xfc, 0xfe, 0x74, 0x0f, 0x7d, 0xdc, 0xa5, 0x74 },
+  { 0x78, 0x7e, 0xbc, 0x26, 0x09, 0xa3, 0x1e, 0xb5, 0xc5, 0x7c, 0x4a, 0x18, 0x83, 0x7d, 0x1a, 0xee },
+  { 0x78, 0x82, 0x1e, 0xf7, 0x6e, 0xbc, 0x39, 0x34, 0x85, 0x0d, 0x1b, 0xc1, 0xb9, 0xe4, 0xf4, 0xb0 },
+  { 0x78, 0x96, 0x32, 0x90, 0x05, 0x2f, 0xd1, 0x7c, 0x6c, 0x79, 0x98, 0x30, 0x5a, 0xb3, 0xa6, 0xa0 },
+  { 0x78, 0xb8, 0x4c, 0xfb, 0x1c, 0x57, 0xb0, 0x48, 0x8d, 0x67, 0x4d, 0x23, 0x74, 0xe6, 0x56, 0xe6 },
+  { 0x78, 0xc2, 0xde, 0x58, 0xe4, 0x2c, 0xd1, 0xfa, 0xac, 0x2e, 0xa7, 0xdf, 0x78, 0x3e, 0xae, 0xb3 },
+  { 0x79, 0x00, 0x4f, 0x84, 0xbd, 0xee, 0xe7, 0x8d, 0x14, 0x2e, 0x44, 0x50, 0x57, 0x88, 0x31, 0x69 },
+  { 0x79, 0x1b, 0xc8, 0xac, 0xeb, 0x6b, 0x0f, 0x4d, 0x99, 0x90, 0xd6, 0x06, 0x2b, 0x30, 0xad, 0xfa },
+  { 0x79, 0x26, 0x08, 0x3a, 0xd4, 0x23, 0xed, 0x68, 0x5d, 0xe3, 0xb3, 0xa0, 0x4a, 0x91, 0x43, 0x15 },
+  { 0x79, 0x2b, 0x1d, 0x93, 0xeb, 0x1d, 0x80, 0x45, 0x26, 0x0c, 0x84, 0x0b, 0x06, 0x88, 0xec, 0x8f },
+  { 0x79, 0x72, 0xe5, 0x10, 0x1f, 0xa5, 0x48, 0xb9, 0x52, 0xd8, 0x52, 0xdb, 0x24, 0xad, 0x60, 0x60 },
+  { 0x79, 0x8b, 0x89, 0x21, 0x27, 0x6e, 0xec, 0x9e, 0x33, 0x2d, 0xfc, 0xb4, 0x7a, 0x2d, 0xbb, 0x17 },
+  { 0x79, 0x8c, 0xc1, 0x14, 0xf1, 0x62, 0x3c, 0x14, 0x08, 0x58, 0x68, 0xcd, 0x34, 0x94, 0xfe, 0x8e },
+  { 0x79, 0x91, 0xe1, 0x79, 0x7e, 0x5e, 0x9f, 0x31, 0x1f, 0xd9, 0x57, 0xe6, 0x2d, 0x88, 0x9d, 0xff },
+  { 0x79, 0x96, 0xb8, 0xd0, 0x74, 0x62, 0xa1, 0x92, 0x59, 0xba, 0xa4, 0xc8, 0x11, 0xc2, 0xb4, 0xb4 },
+  { 0x79, 0xab, 0x41, 0x23, 0xa8, 0x3d, 0xc1, 0x1d, 0x46, 0x8f, 0xb2, 0x10, 0x8e, 0xa0, 0x9e, 0x2e },
+  { 0x79, 0xb6, 0x49, 0xfb, 0x81, 0x2c, 0x50, 0xb4, 0x34, 0x7d, 0x12, 0xe7, 0xdd, 0xbb, 0x84, 0x00 },
+  { 0x79, 0xc2, 0x7f, 0x90, 0x59, 0x1e, 0x3f, 0xdc, 0x7d, 0x2e, 0xd0, 0x20, 0xec, 0xbe, 0xde, 0xb3 },
+  { 0x79, 0xd4, 0xaf, 0x56, 0x03, 0x6e, 0xc2, 0x8f, 0x29, 0x8c, 0xad, 0x96, 0x4a, 0x2e, 0x24, 0x94 },
+  { 0x79, 0xd6, 0xf6, 0x1d, 0xa3, 0xc6, 0x46, 0x88, 0xac, 0x8e, 0x07, 0x56, 0x67, 0xf8, 0xa3, 0x9f },
+  { 0x79, 0xe5, 0x33, 0x8d, 0xbf, 0xa6, 0xb6, 0x40, 0x08, 0xbb, 0x0d, 0x72, 0xa3, 0x17, 0x9d, 0x3c },
+  { 0x79, 0xfc, 0xde, 0xe6, 0xd7, 0x1f, 0x23, 0xf6, 0xcf, 0x3d, 0x01, 0x25, 0x82, 0x36, 0xc3, 0xb9 },
+  { 0x7a, 0x09, 0x29, 0x9f, 0x47, 0x31, 0x05, 0xae, 0x1e, 0xf3, 0xad, 0x6f, 0x9f, 0x2c, 0xd8, 0x07 },
+  { 0x7a, 0x2a, 0xf3, 0x83, 0x01, 0x4f, 0x5d, 0x81, 0x0a, 0xd2, 0x6d, 0x32, 0x28, 0x23, 0x54, 0x9d },
+  { 0x7a, 0x54, 0x63, 0x54, 0x5d, 0xfb, 0x2d, 0xcf, 0xda, 0xfa, 0x60, 0x74, 0xb2, 0xf2, 0xc1, 0x5e },
+  { 0x7a, 0x63, 0xd7, 0xea, 0x3f, 0x28, 0x51, 0xbc, 0xf0, 0x4f, 0x0b, 0xb4, 0xba, 0x1a, 0x39, 0x29 },
+  { 0x7a, 0x64, 0xa8, 0xb7, 0x27, 0xc8, 0x21, 0x5d, 0x94, 0x5e, 0x37, 0xd5, 0x65, 0xca, 0x95, 0xa5 },
+  { 0x7a, 0x64, 0xb5, 0xa6, 0xe9, 0x06, 0x19, 0xc6, 0xaa, 0xcf, 0x24, 0x4c, 0xdd, 0x75, 0x02, 0xf8 },
+  { 0x7a, 0x7f, 0x6a, 0xb9, 0x21, 0x5a, 0x3a, 0x6b, 0x59, 0x40, 0xb8, 0x73, 0x7f, 0x11, 0x63, 0x59 },
+  { 0x7a, 0x93, 0xd0, 0xc0, 0x29, 0xea, 0xa7, 0x22, 0x36, 0x52, 0x3e, 0xed, 0xc3, 0xf1, 0x96, 0x45 },
+  { 0x7a, 0xb0, 0x91, 0x71, 0x07, 0xb6, 0xec, 0x76, 0x8a, 0x5e, 0xba, 0xad, 0xf2, 0x8c, 0x49, 0x7a },
+  { 0x7a, 0xb2, 0x10, 0xf4, 0x48, 0xde, 0x51, 0x8f, 0xa6, 0x1a, 0x59, 0x24, 0x12, 0x0b, 0xa8, 0x72 },
+  { 0x7a, 0xb2, 0xf1, 0x90, 0xd4, 0xe5, 0x9e, 0x87, 0x42, 0xe7, 0x6a, 0x6e, 0x87, 0x0b, 0x56, 0x7e },
+  { 0x7a, 0xc4, 0xf4, 0xfb, 0x42, 0x5d, 0xb3, 0x82, 0x88, 0xfa, 0x07, 0xfb, 0x8f, 0xf4, 0xb2, 0x1d },
+  { 0x7a, 0xd2, 0x57, 0x83, 0x31, 0x90, 0xbc, 0x60, 0x27, 0x7c, 0x1c, 0xa4, 0x75, 0x05, 0x70, 0x51 },
+  { 0x7a, 0xd7, 0x82, 0x95, 0x2e, 0x51, 0x47, 0xb8, 0x8b, 0x65, 0xa2, 0x5c, 0xad, 0xcd, 0xf9, 0xe0 },
+  { 0x7a, 0xdb, 0xcf, 0x78, 0x39, 0x9b, 0x19, 0x59, 0x66, 0x71, 0xed, 0xbf, 0xfc, 0x3d, 0x34, 0xaa },
+  { 0x7a, 0xf4, 0x0c, 0x14, 0x85, 0xce, 0x9f, 0x29, 0xb1, 0xa7, 0xb0, 0x69, 0xa2, 0xeb, 0x04, 0xa7 },
+  { 0x7b, 0x24, 0xbf, 0xe1, 0xb6, 0x18, 0x64, 0xe7, 0x58, 0xad, 0xa1, 0xfe, 0x9a, 0xda, 0xa0, 0x98 },
+  { 0x7b, 0x33, 0x40, 0x7b, 0x2b, 0x19, 0x8a, 0xf7, 0x49, 0x06, 0xb9, 0x36, 0xce, 0x1e, 0xec, 0xbb },
+  { 0x7b, 0x3c, 0xf0, 0x25, 0x6e, 0x1f, 0xa0, 0xfd, 0xc5, 0x38, 0xca, 0xf3, 0xd5, 0xd8, 0x63, 0x37 },
+  { 0x7b, 0x43, 0xc3, 0x2e, 0x3d, 0x4f, 0xf5, 0x93, 0x2f, 0x39, 0xaf, 0xcb, 0x4c, 0x55, 0x16, 0x27 },
+  { 0x7b, 0x52, 0x07, 0xe6, 0x8e, 0xe8, 0x5b, 0x16, 0x99, 0x8b, 0xea, 0x86, 0x19, 0x87, 0xc6, 0x90 },
+  { 0x7b, 0x6f, 0x33, 0x48, 0xdb, 0xf7, 0x1a, 0xda, 0x88, 0xdb, 0x0f, 0xda, 0xf7, 0xfe, 0xef, 0xe0 },
+  { 0x7b, 0x79, 0xbe, 0xb3, 0x78, 0xd1, 0xb4, 0x47, 0x1d, 0xef, 0x90, 0xce, 0xcc, 0xf4, 0x13, 0xde },
+  { 0x7b, 0x7b, 0x4a, 0xc0, 0x52, 0x32, 0x49, 0x0c, 0x28, 0xf9, 0xb6, 0x80, 0xc7, 0x29, 0x98, 0xf9 },
+  { 0x7b, 0x8a, 0x48, 0x1e, 0x0c, 0x5a, 0xa7, 0x81, 0x50, 0xb5, 0x55, 0x5d, 0xff, 0x01, 0xf6, 0x4e },
+  { 0x7b, 0x93, 0x8c, 0x7d, 0xdf, 0x18, 0xe8, 0x36, 0x29, 0x49, 0xb6, 0x2c, 0x7e, 0xaa, 0x66, 0x0a },
+  { 0x7b, 0xa0, 0x7d, 0x4e, 0xa1, 0x8b, 0xf3, 0xb3, 0x24, 0x5c, 0x37, 0x4d, 0x87, 0x20, 0xad, 0x30 },
+  { 0x7b, 0xb2, 0x86, 0xcb, 0x65, 0x9d, 0x14, 0x6a, 0xf3, 0x96, 0x6d, 0x69, 0x9b, 0x51, 0xf5, 0x09 },
+  { 0x7b, 0xc4, 0xfd, 0x25, 0x4e, 0xc8, 0xc0, 0xa2, 0x5a, 0x13, 0xf0, 0x2f, 0xd3, 0xf7, 0x62, 0xff },
+  { 0x7c, 0x00, 0xe7, 0xa2, 0x05, 0xd3, 0xfd, 0xa9, 0x8e, 0xb2, 0x0d, 0xa7, 0xc9, 0xc5, 0x0a, 0x55 },
+  { 0x7c, 0x4a, 0x49, 0x9d, 0x34, 0x3f, 0xca, 0x0c, 0xef, 0x2d, 0x59, 0xdd, 0x16, 0xaf, 0x62, 0x1a },
+  { 0x7c, 0x75, 0x7b, 0xb1, 0x51, 0x26, 0x9b, 0x2a, 0x62, 0x6c, 0x90, 0x7a, 0x22, 0xf5, 0xda, 0xe7 },
+  { 0x7c, 0x7a, 0x4a, 0x2d, 0x50, 0x5c, 0x2d, 0x0c, 0x75, 0x33, 0x7c, 0x44, 0x71, 0x1d, 0x8d, 0x54 },
+  { 0x7c, 0x9b, 0x3b, 0x8b, 0x25, 0xac, 0xf2, 0xfe, 0x3b, 0x8d, 0xa8, 0x34, 0xf6, 0x96, 0x29, 0xc6 },
+  { 0x7c, 0xa7, 0xa4, 0x71, 0xd7, 0x03, 0x05, 0xc6, 0x73, 0xfe, 0xdd, 0x08, 0x17, 0x4a, 0x81, 0xe8 },
+  { 0x7c, 0xc7, 0x7f, 0x67, 0x45, 0xe1, 0xf2, 0xb2, 0x0d, 0xf4, 0xa4, 0x32, 0x7d, 0x35, 0x05, 0x45 },
+  { 0x7c, 0xcf, 0x35, 0x03, 0x54, 0xee, 0x15, 0xcd, 0x9b, 0x85, 0x56, 0x4a, 0x20, 0x14, 0xb0, 0x8c },
+  { 0x7c, 0xd3, 0x79, 0xda, 0x92, 0xc9, 0x36, 0x79, 0xf3, 0xb6, 0xd2, 0x54, 0x86, 0x17, 0x74, 0x6a },
+  { 0x7c, 0xd9, 0x00, 0xe9, 0xec, 0xcb, 0xb2, 0x40, 0xfe, 0x9c, 0x37, 0xfa, 0x28, 0xf9, 0x17, 0xb5 },
+  { 0x7c, 0xed, 0x67, 0x09, 0xf0, 0x91, 0xe7, 0x9a, 0x2a, 0xb9, 0x57, 0x5d, 0x35, 0x16, 0xa4, 0xac },
+  { 0x7c, 0xed, 0xff, 0xa0, 0xdb, 0x65, 0xd6, 0x10, 0x56, 0x8b, 0x90, 0xae, 0xca, 0x70, 0x5a, 0xc6 },
+  { 0x7d, 0x0b, 0x49, 0xea, 0x4f, 0xe3, 0xa5, 0xf1, 0xe1, 0x19, 0xa6, 0xd1, 0x48, 0x43, 0xdb, 0x17 },
+  { 0x7d, 0x10, 0x34, 0xbc, 0xb3, 0x8c, 0x9b, 0x74, 0x6e, 0xa2, 0xc0, 0xae, 0x37, 0xd9, 0xdf, 0xf2 },
+  { 0x7d, 0x3c, 0xdd, 0xe6, 0x3b, 0x16, 0xfa, 0x63, 0x7c, 0x44, 0x84, 0xe7, 0x16, 0x83, 0x9c, 0x94 },
+  { 0x7d, 0x48, 0x3b, 0x70, 0x2c, 0x44, 0xee, 0x65, 0xcd, 0x2d, 0xf2, 0x2c, 0xbc, 0xc8, 0xb7, 0xed },
+  { 0x7d, 0x5c, 0x3b, 0x7b, 0x90, 0x87, 0x52, 0xb9, 0x8e, 0x30, 0x69, 0x0e, 0x2a, 0x33, 0x22, 0xc2 },
+  { 0x7d, 0x72, 0x6f, 0xa4, 0x94, 0xf7, 0x06, 0x78, 0x4b, 0xaf, 0xeb, 0x1b, 0x50, 0xd8, 0x7f, 0x23 },
+  { 0x7d, 0x90, 0x34, 0x11, 0x80, 0x77, 0x04, 0xe7, 0x25, 0xcf, 0x3f, 0xaf, 0xbe, 0xb9, 0x72, 0x55 },
+  { 0x7d, 0x93, 0x07, 0x1b, 0x3e, 0x36, 0x16, 0x09, 0x3a, 0x6b, 0x5a, 0x98, 0xb0, 0x31, 0x57, 0x51 },
+  { 0x7d, 0x94, 0x0d, 0x74, 0x9e, 0x55, 0xb9, 0x6b, 0x7b, 0x74, 0x65, 0x19, 0xfa, 0x06, 0xf2, 0xde },
+  { 0x7d, 0x9c, 0x96, 0xb2, 0x15, 0xd1, 0x94, 0x1e, 0x87, 0xb6, 0xfb, 0x41, 0x2e, 0xb9, 0x20, 0x4f },
+  { 0x7d, 0xa9, 0xde, 0x8d, 0x62, 0xfc, 0xdd, 0x3a, 0x2c, 0x54, 0x5b, 0x2e, 0x72, 0x0c, 0x2a, 0x61 },
+  { 0x7d, 0xbc, 0x8f, 0xa2, 0xe4, 0x88, 0xe3, 0xf6, 0xb8, 0x7f, 0xbe, 0x0f, 0x76, 0xc5, 0xb8, 0x9f },
+  { 0x7d, 0xc0, 0x3a, 0x1f, 0x56, 0xd0, 0xe6, 0xa8, 0xaa, 0xe3, 0xe3, 0xe5, 0x0d, 0x65, 0x4a, 0x08 },
+  { 0x7d, 0xcb, 0xfd, 0x2a, 0xcc, 0x01, 0x3e, 0x81, 0x7f, 0x01, 0x13, 0x09, 0xc7, 0x50, 0x4d, 0xaa },
+  { 0x7d, 0xd9, 0xc5, 0x28, 0x44, 0x22, 0xf7, 0x29, 0x06, 0x6a, 0xb2, 0x2a, 0x28, 0x4c, 0x82, 0x83 },
+  { 0x7d, 0xfd, 0x10, 0x0b, 0xda, 0x9a, 0xbb, 0x0f, 0x37, 0x44, 0x36, 0x1b, 0xc7, 0x11, 0x26, 0x81 },
+  { 0x7e, 0x2f, 0xe4, 0x0a, 0x78, 0x8e, 0x56, 0x76, 0x5f, 0xe5, 0x6a, 0x35, 0x76, 0x01, 0x99, 0x68 },
+  { 0x7e, 0x46, 0x41, 0x86, 0xba, 0x38, 0x40, 0x69, 0x58, 0x2d, 0x9f, 0x0c, 0x14, 0x1f, 0x74, 0x91 },
+  { 0x7e, 0x47, 0x83, 0xa5, 0x99, 0x72, 0xae, 0x2c, 0xd8, 0x38, 0x4f, 0x23, 0x17, 0x57, 0xea, 0x0b },
+  { 0x7e, 0x51, 0xa5, 0x8d, 0xe2, 0xc0, 0xdb, 0x7d, 0x33, 0x71, 0x5f, 0x51, 0x88, 0x93, 0xb0, 0xdb },
+  { 0x7e, 0x52, 0xa9, 0x50, 0x74, 0xa6, 0x66, 0x40, 0xfc, 0xfd, 0xe1, 0x24, 0xff, 0xfd, 0x49, 0x1a },
+  { 0x7e, 0x7c, 0x4c, 0x59, 0xd5, 0x54, 0x94, 0xe6, 0x6e, 0xef, 0x5e, 0x04, 0xec, 0x1c, 0x61, 0x57 },
+  { 0x7e, 0x8a, 0xa1, 0x8b, 0xc9, 0x50, 0x2e, 0xb5, 0x7d, 0xaa, 0xf5, 0xe7, 0xc1, 0xe9, 0x4d, 0xa7 },
+  { 0x7e, 0x9d, 0xa5, 0xcb, 0x84, 0xd5, 0xbc, 0x86, 0x98, 0x54, 0x93, 0x8f, 0xe3, 0xe8, 0x5f, 0xfa },
+  { 0x7e, 0xab, 0x02, 0x84, 0xa0, 0xcd, 0x10, 0x43, 0x46, 0x1d, 0x44, 0x6a, 0x08, 0xd0, 0x8c, 0xec },
+  { 0x7e, 0xad, 0x25, 0x7e, 0x8b, 0x5a, 0x44, 0xca, 0xc5, 0x38, 0xf5, 0xf5, 0x4c, 0x7a, 0x00, 0x23 },
+  { 0x7e, 0xaf, 0x00, 0x9a, 0x89, 0x2f, 0x03, 0xd9, 0x06, 0x82, 0xdc, 0x1e, 0x67, 0xe8, 0x5f, 0x07 },
+  { 0x7e, 0xaf, 0xc9, 0x82, 0x7e, 0x8d, 0x5b, 0x13, 0x36, 0x90, 0x59, 0x39, 0xe0, 0x97, 0xaa, 0xe7 },
+  { 0x7e, 0xba, 0x20, 0xc2, 0x29, 0x1a, 0x98, 0x22, 0x14, 0xcc, 0x7c, 0xbe, 0x8d, 0x0b, 0x47, 0xcd },
+  { 0x7e, 0xd6, 0x1a, 0x18, 0xce, 0xbd, 0xec, 0xa0, 0xa9, 0x3b, 0xe1, 0xf5, 0x46, 0x17, 0x31, 0xe5 },
+  { 0x7e, 0xd7, 0x13, 0x0a, 0x6e, 0x40, 0x20, 0x16, 0x18, 0x36, 0x41, 0x43, 0x32, 0xb1, 0x19, 0x83 },
+  { 0x7e, 0xdc, 0x8f, 0xcb, 0x31, 0x9b, 0x3f, 0xb6, 0x1c, 0xac, 0x87, 0x61, 0x4a, 0xfd, 0x4f, 0xfa },
+  { 0x7e, 0xf3, 0xca, 0x08, 0xab, 0xde, 0x43, 0x9c, 0x6c, 0xcc, 0xa8, 0x46, 0x93, 0x83, 0x9c, 0x57 },
+  { 0x7e, 0xf7, 0x48, 0x79, 0xd7, 0xcb, 0x9f, 0xa0, 0xef, 0x16, 0x1b, 0x91, 0xad, 0x55, 0xb3, 0xbb },
+  { 0x7f, 0x02, 0x09, 0xcf, 0xcc, 0x3d, 0x18, 0x17, 0x15, 0x46, 0x3f, 0x4d, 0x64, 0x51, 0xce, 0xcf },
+  { 0x7f, 0x07, 0xcd, 0x2e, 0x89, 0xdd, 0xa5, 0xa3, 0xa9, 0x0d, 0x3a, 0xb0, 0x64, 0xbf, 0xd1, 0xf6 },
+  { 0x7f, 0x43, 0x0c, 0x33, 0x04, 0x4e, 0x03, 0x54, 0x81, 0x53, 0x92, 0xb5, 0x3a, 0x9a, 0x77, 0x2d },
+  { 0x7f, 0x52, 0x5b, 0x07, 0xbc, 0x98, 0x08, 0x0c, 0xc8, 0x95, 0x0f, 0x72, 0x84, 0xe5, 0x2e, 0xde },
+  { 0x7f, 0x54, 0xfa, 0x6a, 0xa8, 0x24, 0x00, 0x1a, 0xf4, 0x15, 0x50, 0x3c, 0x31, 0x32, 0x62, 0xf2 },
+  { 0x7f, 0x65, 0x33, 0x38, 0x66, 0x44, 0xc7, 0xd6, 0x35, 0x8f, 0x87, 0x16, 0x66, 0xc8, 0x6e, 0x79 },
+  { 0x7f, 0x73, 0xac, 0x39, 0xe5, 0xe3, 0xe1, 0x3e, 0x40, 0xfd, 0x8a, 0xd8, 0x85, 0x56, 0x1a, 0x0f },
+  { 0x7f, 0x79, 0x09, 0x39, 0xf7, 0xea, 0xa8, 0xc4, 0x7a, 0x24, 0x6c, 0x42, 0x83, 0x98, 0x1f, 0x84 },
+  { 0x7f, 0x81, 0x94, 0x54, 0x73, 0x4d, 0xdf, 0x93, 0xf8, 0x3f, 0xef, 0xcf, 0xfc, 0xd3, 0xe2, 0x12 },
+  { 0x7f, 0x9f, 0xbe, 0x3e, 0x00, 0xa2, 0x1e, 0xa0, 0x6e, 0x6a, 0xe5, 0xe0, 0xe5, 0xdb, 0x21, 0x43 },
+  { 0x7f, 0xcd, 0x17, 0x66, 0xde, 0x75, 0xc6, 0x14, 0xa3, 0xcc, 0xc3, 0x1b, 0x25, 0xdd, 0x5b, 0x7a },
+  { 0x7f, 0xcd, 0x5f, 0xb5, 0x9e, 0x88, 0xfc, 0x7b, 0x84, 0x73, 0xc6, 0x41, 0xf4, 0x42, 0x26, 0xc3 },
+  { 0x7f, 0xf5, 0x3f, 0x69, 0x22, 0x70, 0x81, 0x19, 0xe7, 0xbf, 0x47, 0x8d, 0x7d, 0x61, 0x8c, 0x86 },
+  { 0x7f, 0xfc, 0x2d, 0x80, 0xfd, 0x49, 0xa1, 0x24, 0x80, 0x83, 0x15, 0x30, 0x6d, 0x19, 0x86, 0x8e },
+  { 0x80, 0x1b, 0xa4, 0x0f, 0x32, 0x90, 0xfc, 0x41, 0x3e, 0x8c, 0x81, 0x6c, 0x46, 0x7c, 0x76, 0x5c },
+  { 0x80, 0x33, 0x93, 0xed, 0x29, 0xa9, 0xe9, 0x34, 0x65, 0x69, 0xdd, 0x1b, 0xf2, 0x09, 0x90, 0x7b },
+  { 0x80, 0x4e, 0xd8, 0x5e, 0xad, 0xf1, 0xce, 0x3e, 0x93, 0x72, 0x15, 0x47, 0xcb, 0xea, 0x75, 0x92 },
+  { 0x80, 0x55, 0xb9, 0xc2, 0x62, 0x21, 0x36, 0xfd, 0x91, 0xed, 0xfe, 0xa6, 0xdf, 0x64, 0x2d, 0xaf },
+  { 0x80, 0x5f, 0x9a, 0x32, 0xef, 0x97, 0xac, 0x25, 0xf9, 0x99, 0xa2, 0x50, 0x14, 0xdc, 0x5c, 0x23 },
+  { 0x80, 0x68, 0xe0, 0x7b, 0x48, 0x4d, 0xfd, 0x66, 0x11, 0x58, 0xb3, 0x77, 0x1d, 0x66, 0x21, 0xca },
+  { 0x80, 0x78, 0x41, 0xdf, 0x22, 0x8e, 0xe8, 0xaa, 0xb0, 0xa0, 0x6e, 0xe6, 0x39, 0xce, 0x5a, 0x8a },
+  { 0x80, 0x7a, 0x8f, 0xf6, 0x21, 0x6b, 0x00, 0xd5, 0x2a, 0xba, 0x2d, 0xfe, 0xa5, 0xd8, 0xd8, 0x60 },
+  { 0x80, 0x8c, 0x3b, 0x1e, 0x60, 0xee, 0x0e, 0x7c, 0x65, 0x20, 0x5f, 0xa4, 0xbd, 0x77, 0x22, 0x21 },
+  { 0x80, 0xcd, 0x42, 0x88, 0x1e, 0x67, 0x0e, 0x4b, 0x74, 0xa9, 0xcc, 0xd1, 0x0d, 0x0d, 0x7b, 0x2e },
+  { 0x80, 0xce, 0xc8, 0x22, 0x39, 0x91, 0x3c, 0xb8, 0xc4, 0x01, 0x6e, 0xb1, 0x37, 0x49, 0xde, 0x44 },
+  { 0x80, 0xe1, 0x41, 0x0e, 0xc9, 0x80, 0x89, 0xe0, 0x73, 0x3c, 0xc0, 0x9e, 0x58, 0x4d, 0xba, 0x4b },
+  { 0x80, 0xe5, 0x23, 0x15, 0x91, 0x9b, 0xd8, 0xa8, 0xb8, 0x2a, 0x40, 0x7c, 0xcd, 0x9b, 0xb1, 0x3f },
+  { 0x80, 0xe5, 0x40, 0x04, 0x70, 0xac, 0x78, 0x81, 0x43, 0xe6, 0xdb, 0x9b, 0xc8, 0xdd, 0x88, 0xcf },
+  { 0x81, 0x01, 0xef, 0xaf, 0xcf, 0x0a, 0xf3, 0x2f, 0xed, 0xda, 0x45, 0x79, 0xc9, 0x41, 0xe6, 0xf4 },
+  { 0x81, 0x07, 0x3d, 0x03, 0x77, 0xa2, 0xba, 0xde, 0xf8, 0xd5, 0xe7, 0x4f, 0xc4, 0x4f, 0xc3, 0x23 },
+  { 0x81, 0x08, 0x16, 0x2b, 0xc8, 0x8b, 0x5a, 0x14, 0xad, 0xc3, 0xe0, 0x31, 0xcf, 0x41, 0x75, 0xad },
+  { 0x81, 0x08, 0xad, 0x26, 0x79, 0xbd, 0x05, 0x5a, 0xfe, 0xc0, 0xa3, 0x5a, 0x1d, 0xca, 0x46, 0xa4 },
+  { 0x81, 0x0d, 0x89, 0x52, 0xaf, 0x5a, 0x60, 0x36, 0xfc, 0xa8, 0xd0, 0xc4, 0xe1, 0xb2, 0x3d, 0xb6 },
+  { 0x81, 0x25, 0x4e, 0xbc, 0xe8, 0x8f, 0xa4, 0x6c, 0x4f, 0xf5, 0xa2, 0xf4, 0xd2, 0xba, 0xd5, 0x38 },
+  { 0x81, 0x34, 0x1f, 0x00, 0xb6, 0x1a, 0xb3, 0x7d, 0x19, 0xd1, 0x52, 0x9f, 0x48, 0x3d, 0x49, 0x6d },
+  { 0x81, 0x39, 0x85, 0xa9, 0x40, 0xaa, 0x73, 0x9c, 0xc2, 0x8d, 0xf1, 0x9e, 0x0e, 0xdd, 0x47, 0x22 },
+  { 0x81, 0x41, 0x41, 0x74, 0xf1, 0x81, 0x6d, 0x5c, 0x1e, 0x58, 0x3a, 0xf4, 0x27, 0xac, 0x89, 0xfc },
+  { 0x81, 0x42, 0x10, 0xc0, 0xe1, 0x21, 0xf7, 0xdb, 0xc2, 0x56, 0x61, 0xb9, 0x3c, 0x06, 0x31, 0x1c },
+  { 0x81, 0x59, 0x1a, 0x22, 0x14, 0x19, 0x02, 0x40, 0x60, 0xb8, 0x90, 0x66, 0x5b, 0xeb, 0x0f, 0xb8 },
+  { 0x81, 0x90, 0xb4, 0x03, 0xd6, 0x7b, 0xf9, 0x79, 0x2f, 0xe2, 0x2f, 0xa5, 0xd2, 0x2f, 0x35, 0x56 },
+  { 0x81, 0x9a, 0xee, 0xb9, 0xa2, 0xe1, 0x1d, 0xeb, 0x54, 0xe6, 0xde, 0x33, 0x4f, 0x84, 0x38, 0x94 },
+  { 0x81, 0xa0, 0x10, 0xab, 0xdb, 0xa1, 0xa6, 0x40, 0xf7, 0xad, 0xf7, 0xf8, 0x4e, 0x13, 0xd3, 0x07 },
+  { 0x81, 0xb3, 0xbf, 0x17, 0xcf, 0x01, 0x03, 0x9d, 0x31, 0x1b, 0x4c, 0xd7, 0x38, 0xae, 0x60, 0x8e },
+  { 0x81, 0xf4, 0xf0, 0x28, 0x5f, 0x65, 0x13, 0x99, 0xa1, 0x2f, 0xf2, 0xe2, 0xf3, 0x5b, 0xab, 0x77 },
+  { 0x82, 0x2a, 0x95, 0x0f, 0x27, 0xff, 0x01, 0x22, 0x87, 0x05, 0x58, 0xa8, 0x9a, 0x49, 0xca, 0xd3 },
+  { 0x82, 0x33, 0x7e, 0x5f, 0xe0, 0xf4, 0x18, 0xca, 0x94, 0x84, 0xca, 0x85, 0x1d, 0xfc, 0x22, 0x6a },
+  { 0x82, 0x64, 0x81, 0xf6, 0xfc, 0x53, 0xea, 0x47, 0xc9, 0xf2, 0x72, 0xf7, 0x05, 0x0e, 0xed, 0xf7 },
+  { 0x82, 0x7a, 0x22, 0xb9, 0xdf, 0xfe, 0xe2, 0x4e, 0x93, 0xed, 0x0d, 0xf0, 0x9f, 0xf8, 0x41, 0x4a },
+  { 0x82, 0x90, 0xda, 0xea, 0x83, 0x91, 0xf9, 0x6d, 0x7c, 0x8e, 0x14, 0x82, 0xe1, 0x84, 0xd1, 0x9c },
+  { 0x82, 0xbf, 0x0d, 0xff, 0x20, 0xce, 0xe6, 0xa1, 0xed, 0x4b, 0xb8, 0x34, 0xb0, 0x00, 0x74, 0xe6 },
+  { 0x82, 0xc2, 0x5d, 0x1c, 0x35, 0xe6, 0xac, 0x6f, 0x89, 0x3d, 0x1d, 0x7c, 0x2f, 0xc2, 0xf9, 0xc8 },
+  { 0x82, 0xde, 0x95, 0x7d, 0x15, 0x5f, 0xc0, 0x41, 0xfc, 0x6a, 0xfb, 0x83, 0x15, 0xa2, 0x85, 0x50 },
+  { 0x82, 0xe7, 0xaa, 0xb6, 0x02, 0xc3, 0x78, 0xcf, 0xfd, 0xd8, 0x18, 0x6a, 0x09, 0x9e, 0x80, 0x7e },
+  { 0x82, 0xef, 0xe7, 0x98, 0x47, 0x83, 0xe2, 0x3a, 0x7c, 0x55, 0x26, 0x6a, 0x51, 0x25, 0xc6, 0x8e },
+  { 0x83, 0x4a, 0x22, 0x73, 0xe9, 0x7a, 0xec, 0x31, 0x81, 0xee, 0x12, 0x79, 0x17, 0xb4, 0xb2, 0x69 },
+  { 0x83, 0x57, 0x59, 0xff, 0x95, 0xc2, 0xcd, 0xc2, 0x32, 0x4d, 0x7c, 0x1e, 0x7c, 0x5f, 0xa2, 0x37 },
+  { 0x83, 0x72, 0xee, 0xc0, 0x1a, 0x08, 0xc6, 0x0d, 0xbe, 0xd0, 0x63, 0xc5, 0x52, 0x4c, 0xdf, 0xb1 },
+  { 0x83, 0x88, 0xd6, 0xfe, 0x59, 0xc3, 0x8c, 0x0b, 0x3a, 0x6a, 0xb2, 0xc5, 0x84, 0x20, 0x03, 0x6a },
+  { 0x83, 0xb8, 0xc0, 0x1c, 0x72, 0x30, 0x6d, 0x60, 0xdd, 0x9b, 0x75, 0x33, 0x32, 0xeb, 0xd2, 0x76 },
+  { 0x83, 0xbd, 0xc8, 0x19, 0x98, 0x0d, 0xb9, 0x9b, 0xf8, 0x9a, 0x7f, 0x2e, 0xd6, 0xa2, 0xde, 0x59 },
+  { 0x83, 0xd1, 0x5f, 0xb9, 0x84, 0x3d, 0x9f, 0x84, 0xaa, 0x37, 0x10, 0x53, 0x84, 0x03, 0xf4, 0x34 },
+  { 0x83, 0xf0, 0x5e, 0xce, 0xca, 0xe8, 0xbe, 0x59, 0xba, 0x1e, 0x51, 0x13, 0x5f, 0x4b, 0xdc, 0xbf },
+  { 0x83, 0xf5, 0x0f, 0xa0, 0xfb, 0xae, 0x54, 0x5e, 0x4b, 0x88, 0xbb, 0x53, 0xb7, 0x88, 0xc3, 0x41 },
+  { 0x83, 0xfa, 0xfd, 0x7b, 0xd1, 0x2e, 0x33, 0x35, 0x16, 0x6c, 0x63, 0x14, 0xb3, 0xbd, 0xe5, 0x28 },
+  { 0x84, 0x0a, 0x5a, 0x2e, 0xae, 0xa2, 0x4d, 0x95, 0xd2, 0x89, 0xf5, 0x14, 0xfd, 0x12, 0xf9, 0xbb },
+  { 0x84, 0x10, 0x57, 0xf8, 0x3c, 0xe3, 0x73, 0x1e, 0x6b, 0xbf, 0xda, 0x17, 0x07, 0xcb, 0xca, 0x58 },
+  { 0x84, 0x1b, 0x7b, 0xc1, 0xca, 0xd0, 0x5f, 0x54, 0x08, 0x30, 0x23, 0x08, 0x77, 0x7d, 0x49, 0xdc },
+  { 0x84, 0x29, 0x0e, 0x33, 0x3f, 0xf7, 0x56, 0x7c, 0x23, 0x80, 0xf1, 0x79, 0x43, 0x00, 0x83, 0xb8 },
+  { 0x84, 0x34, 0x35, 0xeb, 0x36, 0x0e, 0xd7, 0x20, 0x85, 0xf7, 0xab, 0x93, 0x74, 0xf9, 0x74, 0x9a },
+  { 0x84, 0x53, 0x5a, 0xfb, 0x9a, 0x69, 0x71, 0x2e, 0xc0, 0xaf, 0x49, 0x47, 0x32, 0x9e, 0x08, 0xb8 },
+  { 0x84, 0x54, 0xed, 0x97, 0x87, 0xc9, 0xd8, 0x21, 0x17, 0x48, 0xcc, 0xdd, 0xb6, 0x73, 0xe9, 0x20 },
+  { 0x84, 0x90, 0xe1, 0x01, 0x4c, 0x2b, 0xaa, 0x0d, 0x3a, 0x3a, 0x08, 0x85, 0x4e, 0x5d, 0x68, 0xb3 },
+  { 0x84, 0xdb, 0x81, 0x8c, 0xd4, 0x11, 0x15, 0x42, 0xa1, 0x5c, 0x2a, 0x79, 0x53, 0x69, 0xa2, 0x56 },
+  { 0x85, 0x0f, 0xfd, 0x58, 0x49, 0xc9, 0x11, 0x94, 0x6b, 0x24, 0x54, 0x4e, 0xa1, 0xe6, 0x04, 0x96 },
+  { 0x85, 0x1c, 0xc1, 0xf3, 0xc6, 0x4e, 0xae, 0xdd, 0x10, 0x36, 0x1e, 0xa2, 0x63, 0x45, 0xac, 0xea },
+  { 0x85, 0x22, 0x71, 0x60, 0xf3, 0x7a, 0xaa, 0x29, 0xf5, 0xe3, 0xa6, 0xc7, 0xa3, 0x21, 0x9f, 0x54 },
+  { 0x85, 0x30, 0xca, 0xaa, 0xf4, 0x0a, 0xcb, 0xdc, 0xd1, 0x18, 0xc2, 0x82, 0xb5, 0xf8, 0xa3, 0x7a },
+  { 0x85, 0x38, 0xc5, 0xe3, 0xee, 0x83, 0x26, 0x77, 0x74, 0x48, 0x06, 0x49, 0xf8, 0x3f, 0xa8, 0xd6 },
+  { 0x85, 0x3c, 0x11, 0xc4, 0xd0, 0x70, 0x50, 0xc2, 0x2e, 0xf3, 0xe0, 0x72, 0x15, 0x33, 0xe0, 0xc5 },
+  { 0x85, 0x47, 0x0d, 0xcb, 0x79, 0x89, 0xe5, 0xe8, 0x56, 0xf3, 0x6b, 0x96, 0x2d, 0x81, 0x55, 0x37 },
+  { 0x85, 0x47, 0x8b, 0xb2, 0x89, 0xdf, 0xa5, 0xc6, 0x37, 0x26, 0xb9, 0x15, 0x39, 0x92, 0xa9, 0x20 },
+  { 0x85, 0x4b, 0x68, 0xb9, 0x3e, 0x71, 0x23, 0xa3, 0xbe, 0x42, 0xb5, 0xa2, 0xa4, 0x1f, 0x75, 0xd7 },
+  { 0x85, 0x50, 0x2d, 0x69, 0xfe, 0x46, 0xb7, 0xf5, 0x4e, 0xf2, 0x59, 0x82, 0x25, 0x67, 0x8b, 0x47 },
+  { 0x85, 0x56, 0x4d, 0xd0, 0x66, 0x5a, 0xa0, 0xa1, 0x35, 0x90, 0x37, 0xae, 0xf1, 0xa4, 0x8d, 0x58 },
+  { 0x85, 0x56, 0xb4, 0x2a, 0xa0, 0x5f, 0x94, 0xbc, 0x29, 0xff, 0x39, 0xc3, 0x9b, 0x11, 0xbf, 0xf4 },
+  { 0x85, 0x5a, 0x42, 0x07, 0x8b, 0x14, 0x71, 0x4b, 0xcf, 0xd4, 0x90, 0xd2, 0xcf, 0x57, 0xe6, 0x8d },
+  { 0x85, 0xa4, 0x13, 0x3f, 0x6d, 0xcf, 0x41, 0x80, 0xe3, 0x6e, 0x70, 0xad, 0x0f, 0xca, 0x09, 0x21 },
+  { 0x85, 0xb1, 0xbc, 0xa9, 0x3e, 0x69, 0xf1, 0x39, 0x05, 0x10, 0x7c, 0xc8, 0x02, 0xa0, 0x24, 0x70 },
+  { 0x85, 0xbb, 0xef, 0xb9, 0x0e, 0x16, 0xbf, 0x38, 0x6b, 0x30, 0x4c, 0x1e, 0x9a, 0x1f, 0x60, 0x84 },
+  { 0x85, 0xe4, 0x8d, 0x68, 0xc8, 0xd8, 0x02, 0xe3, 0xba, 0x9d, 0x49, 0x4a, 0x47, 0xd6, 0xe0, 0x16 },
+  { 0x85, 0xe5, 0x64, 0xda, 0xe5, 0x68, 0x7e, 0x43, 0x19, 0x55, 0x05, 0x6f, 0xbd, 0xa1, 0x09, 0x78 },
+  { 0x86, 0x12, 0x80, 0x01, 0xe6, 0x9a, 0xb0, 0x49, 0x93, 0x7f, 0x26, 0x59, 0x11, 0xce, 0x7e, 0x8a },
+  { 0x86, 0x2c, 0xf6, 0x69, 0xcb, 0xce, 0xd7, 0x8f, 0x9e, 0xd3, 0x1a, 0x5d, 0x37, 0x5b, 0x2e, 0xbe },
+  { 0x86, 0x44, 0x35, 0x2b, 0x80, 0x69, 0x85, 0xef, 0xde, 0x49, 0x9a, 0xe6, 0xfc, 0x7b, 0x0f, 0xec },
+  { 0x86, 0x54, 0xd7, 0xf0, 0xfb, 0x35, 0x19, 0x60, 0x01, 0x6e, 0x06, 0x64, 0x6f, 0x63, 0x9b, 0x02 },
+  { 0x86, 0x6e, 0x51, 0x50, 0xc9, 0x95, 0xc4, 0xae, 0x51, 0x72, 0xe5, 0x20, 0x7b, 0xa9, 0x48, 0xc7 },
+  { 0x86, 0x9a, 0xbe, 0x04, 0x26, 0xe6, 0xe9, 0xfc, 0xb6, 0xd7, 0x5a, 0x3c, 0x2d, 0x6e, 0x05, 0xd1 },
+  { 0x86, 0xb4, 0xaa, 0x76, 0xbb, 0xeb, 0x70, 0xe1, 0xa4, 0xf9, 0x21, 0x1a, 0x98, 0x80, 0xba, 0x8e },
+  { 0x86, 0xf5, 0xe5, 0x5c, 0xa9, 0xa9, 0xbd, 0xe7, 0x33, 0x8a, 0x15, 0x75, 0x70, 0x82, 0x8e, 0x79 },
+  { 0x87, 0x12, 0xcc, 0xee, 0xc5, 0x64, 0x4a, 0xac, 0xc2, 0xc2, 0x12, 0x03, 0xd9, 0xeb, 0xe2, 0xec },
+  { 0x87, 0x26, 0xc1, 0x7e, 0xe7, 0xb5, 0x59, 0xcb, 0x7b, 0xf2, 0x33, 0x0d, 0x20, 0x97, 0x2a, 0xd0 },
+  { 0x87, 0x3f, 0xb7, 0x5a, 0x77, 0x88, 0xba, 0x0f, 0x4a, 0xe7, 0x15, 0x22, 0x9a, 0x05, 0x54, 0x5e },
+  { 0x87, 0x47, 0xba, 0x79, 0xcd, 0x39, 0xfa, 0x83, 0xa5, 0x29, 0xbb, 0x26, 0x01, 0x0d, 0xb2, 0x1b },
+  { 0x87, 0x49, 0xa0, 0xd0, 0x88, 0xdf, 0x25, 0x21, 0x8c, 0x14, 0x9d, 0xc3, 0x25, 0xab, 0xc7, 0xca },
+  { 0x87, 0x4c, 0x76, 0x72, 0x6f, 0x68, 0xc1, 0x66, 0xfc, 0xfa, 0xc4, 0x8c, 0xe7, 0x8e, 0xef, 0x95 },
+  { 0x87, 0x64, 0x46, 0x2d, 0x7d, 0x19, 0xa3, 0x3b, 0x07, 0x17, 0xaf, 0x22, 0xb9, 0x9f, 0xc8, 0x8f },
+  { 0x87, 0x66, 0x28, 0x15, 0xbc, 0x4f, 0x3c, 0x3c, 0x86, 0x07, 0x1d, 0xc9, 0x94, 0xe3, 0xf3, 0x0e },
+  { 0x87, 0x6a, 0x95, 0x3d, 0xaa, 0xe0, 0xe9, 0x46, 0x62, 0x0c, 0xf0, 0x5e, 0xd4, 0x19, 0x89, 0xf4 },
+  { 0x87, 0x7a, 0x53, 0x97, 0xf3, 0xf2, 0x05, 0xbf, 0x67, 0x50, 0x39, 0x8c, 0x98, 0xf3, 0x3d, 0xe1 },
+  { 0x87, 0x86, 0xc1, 0xe5, 0x6e, 0xf2, 0x21, 0xd9, 0x46, 0xc6, 0x4f, 0x6b, 0x65, 0xb6, 0x97, 0xe9 },
+  { 0x87, 0x86, 0xf2, 0x29, 0xb9, 0x74, 0xc3, 0x93, 0x22, 0x28, 0x74, 0xf7, 0x3a, 0x9f, 0x32, 0x06 },
+  { 0x87, 0x86, 0xf4, 0x60, 0x9a, 0x66, 0xfb, 0xea, 0x2c, 0xd9, 0xaa, 0x48, 0xca, 0x7a, 0xa1, 0x1c },
+  { 0x87, 0xb4, 0x60, 0xdf, 0x21, 0xb7, 0xbb, 0xcf, 0xc5, 0x7b, 0x1c, 0x08, 0x2c, 0x67, 0x94, 0xb0 },
+  { 0x87, 0xb6, 0xa1, 0x71, 0x32, 0xfc, 0x32, 0xf5, 0x76, 0xbc, 0x49, 0xea, 0x18, 0x72, 0x95, 0x06 },
+  { 0x87, 0xbe, 0xa7, 0x77, 0xa3, 0x42, 0x78, 0xd2, 0x9b, 0x3b, 0x60, 0x29, 0x83, 0x3c, 0x54, 0x22 },
+  { 0x87, 0xe7, 0x9c, 0xd4, 0x1c, 0xe1, 0x36, 0xfd, 0x4f, 0x72, 0xcc, 0x6e, 0x2c, 0x16, 0x1b, 0xee },
+  { 0x87, 0xf0, 0x20, 0xda, 0xa9, 0x8d, 0x01, 0x32, 0xe9, 0x8e, 0x43, 0xdb, 0x7d, 0x8f, 0xea, 0x7e },
+  { 0x88, 0x32, 0x58, 0xdc, 0xd6, 0x8c, 0xef, 0xc6, 0xcd, 0x4d, 0x40, 0xb1, 0x18, 0x51, 0x16, 0xdc },
+  { 0x88, 0x74, 0xb6, 0x87, 0x51, 0xfd, 0x2b, 0xa6, 0xd3, 0x30, 0x6a, 0x26, 0x3a, 0xe5, 0x7a, 0x7d },
+  { 0x88, 0x85, 0xd0, 0xce, 0x11, 0xc5, 0xb4, 0x0c, 0x3a, 0x8a, 0x8d, 0x9e, 0xd2, 0x8c, 0xef, 0xef },
+  { 0x88, 0x8d, 0xeb, 0xb1, 0x62, 0xd7, 0xd1, 0xae, 0x71, 0x02, 0x5b, 0x4a, 0xb7, 0x94, 0x25, 0x7f },
+  { 0x88, 0xa6, 0xc9, 0xc8, 0x8c, 0xb3, 0x29, 0xee, 0x5f, 0xa7, 0xd1, 0x68, 0xbd, 0x6c, 0x7c, 0x63 },
+  { 0x88, 0xd3, 0x00, 0xa3, 0x8b, 0xdd, 0x7c, 0xab, 0x9e, 0xda, 0xd2, 0x71, 0xc1, 0x8c, 0xd0, 0x2b },
+  { 0x88, 0xd7, 0xb6, 0xb3, 0x96, 0x7d, 0xe0, 0xdb, 0x24, 0xcd, 0xae, 0x1c, 0x7f, 0x71, 0x81, 0xbd },
+  { 0x88, 0xd8, 0xa1, 0xac, 0xca, 0xb5, 0x8c, 0xf1, 0xab, 0xb0, 0x43, 0x61, 0x3c, 0xf1, 0x85, 0xe9 },
+  { 0x88, 0xdc, 0xe4, 0x03, 0x74, 0x71, 0x42, 0x4b, 0xb3, 0x8a, 0xb6, 0x84, 0x1a, 0xaa, 0x8c, 0xab },
+  { 0x88, 0xed, 0x87, 0xc0, 0x11, 0xf6, 0x99, 0xdd, 0x27, 0x32, 0x1d, 0xbe, 0x40, 0x4d, 0xb6, 0xc8 },
+  { 0x88, 0xf7, 0x4e, 0xc7, 0x5e, 0xf6, 0x96, 0xe7, 0x29, 0x4b, 0x7b, 0x6a, 0xc5, 0xca, 0x46, 0x5f },
+  { 0x89, 0x05, 0xd5, 0x4f, 0x48, 0xb8, 0x02, 0x4f, 0xc7, 0x18, 0xed, 0x64, 0x3e, 0x90, 0x33, 0xf7 },
+  { 0x89, 0x0c, 0x13, 0x59, 0x0e, 0x0d, 0x8d, 0x5d, 0x61, 0x49, 0x73, 0x7d, 0x93, 0x0e, 0x4d, 0x95 },
+  { 0x89, 0x17, 0xf7, 0xc1, 0xac, 0x5e, 0xb0, 0x5b, 0x82, 0x33, 0x1c, 0xf0, 0x1c, 0x49, 0x5a, 0xf2 },
+  { 0x89, 0x33, 0x97, 0x6f, 0x20, 0x29, 0xc0, 0xd8, 0x49, 0x2e, 0xbd, 0x8f, 0x4e, 0xb2, 0x14, 0x92 },
+  { 0x89, 0x53, 0xbc, 0x11, 0x35, 0x2d, 0x79, 0x44, 0x31, 0xd3, 0x30, 0x3e, 0x31, 0xd3, 0xb8, 0x92 },
+  { 0x89, 0x6e, 0xc5, 0x8f, 0x26, 0xe9, 0x30, 0xe0, 0x2f, 0x5e, 0x4f, 0x04, 0x66, 0x02, 0xc3, 0xa1 },
+  { 0x89, 0x81, 0x43, 0x77, 0x38, 0x24, 0x66, 0x3e, 0xfe, 0x88, 0xd0, 0xa3, 0xa0, 0xbb, 0x1b, 0xa4 },
+  { 0x89, 0x87, 0x48, 0xd5, 0xea, 0xac, 0x31, 0x64, 0xb0, 0x39, 0x1a, 0x64, 0xae, 0x1e, 0x0e, 0x32 },
+  { 0x89, 0x8b, 0x54, 0x67, 0x55, 0x1d, 0x32, 0xaf, 0x48, 0xa6, 0x04, 0x80, 0x24, 0x07, 0xb6, 0xe8 },
+  { 0x89, 0xa6, 0x5b, 0x83, 0x20, 0x39, 0x80, 0xd5, 0xd4, 0xd6, 0x0f, 0x52, 0xa5, 0x84, 0xa5, 0xb8 },
+  { 0x89, 0xa6, 0x87, 0x46, 0xef, 0xf7, 0xf2, 0x66, 0xbb, 0xf0, 0x8d, 0xe2, 0x48, 0x3a, 0xbe, 0x55 },
+  { 0x89, 0xaf, 0xff, 0x4a, 0x10, 0x80, 0x70, 0x93, 0xc1, 0x05, 0x74, 0x0c, 0x73, 0xe9, 0xb5, 0x44 },
+  { 0x89, 0xea, 0xba, 0x47, 0xa5, 0x9c, 0xbf, 0xd2, 0x6e, 0x74, 0xaa, 0xd3, 0x2f, 0x55, 0x3c, 0xd7 },
+  { 0x8a, 0x15, 0x9e, 0xe5, 0x8b, 0x2f, 0x0a, 0x54, 0x80, 0x51, 0x62, 0x98, 0x4b, 0x0f, 0x07, 0xe5 },
+  { 0x8a, 0x18, 0x3b, 0x63, 0x57, 0x98, 0x7d, 0xb5, 0x17, 0x0c, 0x5c, 0xf9, 0xf4, 0xa1, 0x13, 0xe5 },
+  { 0x8a, 0x42, 0xe2, 0xc7, 0x26, 0x64, 0x39, 0xd8, 0x99, 0x7a, 0x55, 0xd0, 0x12, 0x4c, 0x91, 0x2c },
+  { 0x8a, 0x49, 0xcf, 0x17, 0x85, 0xe3, 0xde, 0xa2, 0x01, 0x2d, 0x33, 0x1a, 0x3a, 0xd4, 0x76, 0xe1 },
+  { 0x8a, 0x6c, 0x84, 0xf4, 0x81, 0xac, 0xf4, 0x2a, 0xbc, 0xb7, 0x8b, 0xa5, 0x06, 0x4a, 0xd7, 0x55 },
+  { 0x8a, 0x8e, 0x40, 0x13, 0x69, 0xe2, 0xb6, 0x3a, 0x13, 0xe1, 0x8a, 0x4d, 0x68, 0x53, 0x87, 0xc6 },
+  { 0x8a, 0x9d, 0x87, 0x4a, 0x38, 0x60, 0x89, 0x64, 0xf3, 0x3e, 0xc0, 0xc3, 0x5c, 0xab, 0x61, 0x8d },
+  { 0x8a, 0x9d, 0x95, 0x3a, 0xc3, 0xdb, 0x52, 0xa3, 0x13, 0xa9, 0x0d, 0x6a, 0x9b, 0x13, 0x9c, 0x76 },
+  { 0x8a, 0xad, 0x33, 0xda, 0x90, 0x7b, 0xed, 0x78, 0xb7, 0x6b, 0x87, 0xfc, 0xea, 0xa8, 0x38, 0xc1 },
+  { 0x8a, 0xc1, 0x80, 0x76, 0xd0, 0x1a, 0x6b, 0x63, 0xac, 0xf6, 0xe2, 0xca, 0xb4, 0x96, 0x89, 0x40 },
+  { 0x8a, 0xf5, 0x8a, 0x9b, 0x90, 0xb2, 0x59, 0x07, 0xda, 0x02, 0x51, 0xec, 0x0f, 0xac, 0xf3, 0xb8 },
+  { 0x8b, 0x04, 0xe9, 0xd1, 0x32, 0xb8, 0xe3, 0x0d, 0x44, 0x7a, 0xca, 0xa6, 0xbd, 0x04, 0x9c, 0x32 },
+  { 0x8b, 0x40, 0xa9, 0xca, 0x1c, 0xfc, 0xd1, 0x48, 0x22, 0xe2, 0x54, 0x7e, 0xaa, 0x9d, 0xf5, 0xc1 },
+  { 0x8b, 0x50, 0x4b, 0x41, 0x7c, 0x86, 0x26, 0x16, 0x7a, 0x7e, 0x02, 0xf4, 0x42, 0x29, 0xf0, 0xe7 },
+  { 0x8b, 0x55, 0x6c, 0x3d, 0x9c, 0xa8, 0xe5, 0xe6, 0xe6, 0x65, 0xbd, 0x75, 0x9b, 0x93, 0xff, 0xae },
+  { 0x8b, 0x5b, 0x1e, 0x3a, 0x43, 0x4e, 0xbb, 0xdc, 0x2c, 0x2a, 0x49, 0xdc, 0x68, 0xf4, 0x63, 0x60 },
+  { 0x8b, 0x7c, 0xa2, 0x9a, 0x55, 0x43, 0x2f, 0x88, 0x6c, 0xee, 0x3d, 0x45, 0x2f, 0xb0, 0x04, 0x81 },
+  { 0x8b, 0x81, 0x52, 0xd6, 0x08, 0x1f, 0x31, 0x36, 0x54, 0x06, 0xcb, 0x71, 0x6b, 0xd9, 0x55, 0x67 },
+  { 0x8b, 0x87, 0x89, 0xc6, 0x66, 0x9a, 0x4c, 0xee, 0x86, 0xc5, 0x79, 0xa6, 0x53, 0x32, 0xf8, 0x52 },
+  { 0x8b, 0xbf, 0xd9, 0x51, 0xc8, 0x9c, 0xc0, 0x9c, 0x14, 0x8b, 0xfa, 0xbd, 0xef, 0xa0, 0x8b, 0xec },
+  { 0x8b, 0xc0, 0xd2, 0x05, 0x2b, 0x4f, 0x25, 0x9e, 0x7a, 0x50, 0xa7, 0xc7, 0x71, 0xb4, 0x52, 0x41 },
+  { 0x8b, 0xd8, 0xf6, 0x53, 0x77, 0x02, 0x3b, 0xdb, 0x7c, 0x5f, 0xcf, 0x46, 0xdd, 0xda, 0x5d, 0x31 },
+  { 0x8b, 0xeb, 0xac, 0x61, 0x45, 0x71, 0x13, 0x59, 0x33, 0x11, 0x60, 0x45, 0x20, 0x4f, 0x0f, 0x00 },
+  { 0x8c, 0x10, 0x3a, 0x79, 0xb0, 0x07, 0xa2, 0xfd, 0x5a, 0xf6, 0x02, 0x33, 0x49, 0x37, 0xb4, 0xe1 },
+  { 0x8c, 0x13, 0x6e, 0x97, 0xc0, 0xa4, 0xaf, 0x66, 0xda, 0x4a, 0x24, 0x95, 0x61, 0xed, 0x17, 0xdb },
+  { 0x8c, 0x2f, 0xa3, 0x30, 0x48, 0xf0, 0x55, 0xf3, 0x83, 0x58, 0xd5, 0x1e, 0xef, 0xe4, 0x17, 0xdb },
+  { 0x8c, 0x36, 0xed, 0x23, 0x52, 0x80, 0x10, 0x31, 0x51, 0x66, 0x95, 0xd1, 0xee, 0xef, 0xe6, 0x17 },
+  { 0x8c, 0x7e, 0x5e, 0x23, 0x29, 0xf4, 0xf4, 0xe0, 0x6c, 0xbc, 0xc9, 0x94, 0xa3, 0x0f, 0xd3, 0x52 },
+  { 0x8c, 0x8a, 0x26, 0xed, 0x57, 0x87, 0x0d, 0xab, 0xa8, 0xe1, 0x31, 0x62, 0xd4, 0x97, 0xba, 0xd1 },
+  { 0x8c, 0x8b, 0x15, 0xb3, 0x25, 0x9e, 0x60, 0x75, 0x79, 0x87, 0xed, 0x13, 0xcd, 0xd7, 0x4d, 0x41 },
+  { 0x8c, 0x94, 0x1f, 0xa3, 0x2c, 0x77, 0x18, 0xa1, 0x00, 0x61, 0xd8, 0xc3, 0x28, 0x90, 0x95, 0x77 },
+  { 0x8c, 0xca, 0xa4, 0x42, 0xd2, 0x6b, 0x09, 0x13, 0x96, 0x85, 0xf5, 0xb2, 0x2b, 0xf1, 0x89, 0xc4 },
+  { 0x8c, 0xd2, 0x6d, 0xcf, 0x24, 0x94, 0x56, 0xfe, 0x4a, 0xeb, 0x8d, 0xb4, 0x2d, 0x49, 0xdf, 0x74 },
+  { 0x8c, 0xe9, 0x12, 0x60, 0x66, 0xf2, 0xdd, 0xd5, 0x17, 0x3e, 0x9f, 0x1f, 0x9c, 0xe1, 0x49, 0x4e },
+  { 0x8c, 0xf0, 0xd3, 0x33, 0xbb, 0xe8, 0x5b, 0x95, 0x49, 0xb1, 0xe6, 0xb1, 0xe2, 0x39, 0x0b, 0x8d },
+  { 0x8d, 0x00, 0xa3, 0x8f, 0x4c, 0x8f, 0x88, 0x00, 0xf1, 0xc2, 0x37, 0x21, 0x5a, 0xc2, 0x43, 0xfc },
+  { 0x8d, 0x1e, 0x2a, 0x6d, 0x28, 0x85, 0x96, 0x6e, 0x6d, 0x86, 0x71, 0x71, 0x80, 0x93, 0x8f, 0x87 },
+  { 0x8d, 0x8b, 0x7d, 0x7b, 0x98, 0x3f, 0x75, 0xde, 0xbb, 0xda, 0xac, 0x65, 0x1e, 0x81, 0x47, 0x68 },
+  { 0x8d, 0x9a, 0x06, 0x10, 0x1e, 0xbb, 0x0f, 0x14, 0x79, 0x36, 0x35, 0x6e, 0x64, 0x53, 0x09, 0xb8 },
+  { 0x8d, 0xa5, 0x1e, 0x0c, 0x4b, 0x6b, 0x46, 0xf7, 0x61, 0x94, 0x25, 0x11, 0x9c, 0x7d, 0x01, 0x8e },
+  { 0x8d, 0xb1, 0x52, 0x45, 0x8a, 0xba, 0xef, 0x3c, 0xfa, 0x7a, 0x4e, 0x42, 0x0d, 0xdb, 0xda, 0x59 },
+  { 0x8d, 0xf4, 0xbe, 0x9d, 0xdc, 0x54, 0xac, 0x36, 0x3b, 0x13, 0xdc, 0x57, 0xce, 0xaf, 0x16, 0x1a },
+  { 0x8e, 0x0a, 0xb8, 0x01, 0xb1, 0x70, 0x5a, 0x74, 0x0b, 0x47, 0x6b, 0x7f, 0x58, 0x8c, 0x6d, 0x16 },
+  { 0x8e, 0x42, 0x67, 0x49, 0x72, 0xd6, 0x80, 0x50, 0x68, 0xfc, 0x65, 0x3e, 0x01, 0x43, 0x70, 0xfd },
+  { 0x8e, 0x48, 0xea, 0x6e, 0xa5, 0x37, 0x09, 0xb9, 0x8e, 0x6f, 0x4b, 0xd8, 0xaa, 0x01, 0x89, 0x08 },
+  { 0x8e, 0x4c, 0xd6, 0x0d, 0x93, 0xfc, 0xde, 0x80, 0x65, 0xc1, 0xa2, 0xb9, 0x72, 0xa2, 0x63, 0x77 },
+  { 0x8e, 0x4f, 0xa8, 0xc6, 0xad, 0x8d, 0x8d, 0xce, 0x0d, 0xb8, 0xc9, 0x91, 0xc1, 0x66, 0xcd, 0xaa },
+  { 0x8e, 0x51, 0x2a, 0xd4, 0x50, 0x68, 0x00, 0x45, 0x8f, 0x99, 0xde, 0xc0, 0x84, 0xfc, 0x2c, 0x64 },
+  { 0x8e, 0x72, 0x41, 0xbf, 0xc8, 0x38, 0x0a, 0xac, 0x3c, 0x0e, 0xf1, 0xb6, 0x88, 0x1c, 0xdd, 0xed },
+  { 0x8e, 0x73, 0x7a, 0x88, 0xa5, 0x66, 0xcc, 0x94, 0xbd, 0x50, 0x17, 0x4c, 0x2d, 0x01, 0x95, 0x93 },
+  { 0x8e, 0x82, 0x2b, 0x39, 0xa7, 0x1c, 0x84, 0xac, 0x87, 0x5f, 0x01, 0x07, 0xfb, 0x61, 0xd6, 0xf0 },
+  { 0x8e, 0x87, 0x9a, 0xa5, 0x8d, 0xb4, 0x1e, 0xdb, 0x67, 0xcb, 0xf3, 0x18, 0xb7, 0x77, 0x66, 0xc4 },
+  { 0x8e, 0x88, 0x7d, 0x1b, 0xa5, 0xf3, 0xa7, 0x1a, 0xe8, 0xa0, 0xea, 0x16, 0xa4, 0xaf, 0x9f, 0xc9 },
+  { 0x8e, 0xd5, 0xa7, 0x46, 0xc5, 0x95, 0x71, 0xfe, 0xb2, 0x55, 0xea, 0xa7, 0xd6, 0xd0, 0xcf, 0x98 },
+  { 0x8e, 0xd7, 0x31, 0x06, 0xe2, 0xf4, 0x2f, 0x91, 0x44, 0x7f, 0xb9, 0x0b, 0x6f, 0x0e, 0xa4, 0xa4 },
+  { 0x8e, 0xe3, 0xf6, 0x4d, 0xc0, 0xf3, 0x49, 0xad, 0xc8, 0x93, 0xfe, 0x93, 0xdf, 0x52, 0x45, 0xd8 },
+  { 0x8f, 0x33, 0xbc, 0xe5, 0xba, 0x10, 0x53, 0xdc, 0xf4, 0xce, 0xa9, 0xc1, 0xc6, 0x99, 0x81, 0xe4 },
+  { 0x8f, 0x53, 0xa3, 0xb9, 0x25, 0xf0, 0xfd, 0x96, 0x1d, 0x9b, 0x8c, 0x4d, 0x46, 0xee, 0x67, 0x55 },
+  { 0x8f, 0x5a, 0xc5, 0x13, 0x94, 0x19, 0xc5, 0xd4, 0x9b, 0xac, 0xc2, 0x96, 0xe3, 0x42, 0xa2, 0x47 },
+  { 0x8f, 0x60, 0x55, 0x1d, 0xb6, 0xd1, 0x53, 0x5e, 0xf0, 0x03, 0x0f, 0x15, 0x50, 0x18, 0xc7, 0x38 },
+  { 0x8f, 0x61, 0x3e, 0xa7, 0xc3, 0x2a, 0x58, 0x7d, 0x67, 0x41, 0x79, 0x0e, 0x32, 0x87, 0x2d, 0xdd },
+  { 0x8f, 0x88, 0x30, 0x9a, 0xfa, 0xd1, 0x08, 0x93, 0x6c, 0xa7, 0x0f, 0x8b, 0x2b, 0x08, 0x47, 0x18 },
+  { 0x8f, 0x90, 0x59, 0x0d, 0xba, 0x14, 0x3d, 0x78, 0x3d, 0xf5, 0xa6, 0xcf, 0xf2, 0x00, 0x0e, 0x4d },
+  { 0x8f, 0x98, 0x51, 0x9a, 0x91, 0xdb, 0xbf, 0x48, 0x64, 0xf1, 0x35, 0xa1, 0x00, 0x50, 0xd9, 0xed },
+  { 0x8f, 0xa4, 0x7e, 0x52, 0x42, 0x77, 0x6e, 0x84, 0x1d, 0xf7, 0xe7, 0x08, 0xb1, 0x2e, 0xb9, 0x98 },
+  { 0x8f, 0xba, 0xba, 0xa8, 0x79, 0x41, 0xcd, 0xf3, 0xa3, 0x77, 0xc1, 0x5e, 0x95, 0xbd, 0xb0, 0xf3 },
+  { 0x8f, 0xe0, 0x01, 0x72, 0xe7, 0xff, 0xf4, 0xc1, 0x87, 0x8d, 0xab, 0xcf, 0x11, 0xbb, 0x8d, 0xce },
+  { 0x8f, 0xeb, 0xdd, 0x91, 0x42, 0x96, 0x0d, 0x08, 0x4a, 0xb6, 0xee, 0xb1, 0xd3, 0xe8, 0x89, 0x69 },
+  { 0x8f, 0xff, 0xc8, 0xf1, 0x5b, 0xb2, 0xe6, 0xd2, 0x4e, 0x21, 0x18, 0x84, 0xa5, 0x47, 0x9a, 0xa5 },
+  { 0x90, 0x48, 0xcc, 0xb7, 0xe0, 0x80, 0x2c, 0xd8, 0xfa, 0x5b, 0xfc, 0x26, 0x09, 0xf2, 0x92, 0xd8 },
+  { 0x90, 0x57, 0x69, 0x4d, 0xce, 0x84, 0x49, 0x52, 0x1e, 0x61, 0x64, 0xd2, 0x63, 0x70, 0x21, 0x85 },
+  { 0x90, 0x57, 0x8a, 0x63, 0x44, 0x1d, 0xe4, 0x52, 0x0b, 0xe5, 0x32, 0x4e, 0x8f, 0x01, 0x53, 0x52 },
+  { 0x90, 0x72, 0xc1, 0x42, 0x72, 0x8a, 0x3a, 0x3d, 0x99, 0x49, 0x56, 0xd0, 0x3b, 0xfa, 0xcb, 0xa2 },
+  { 0x90, 0xb1, 0x79, 0x9d, 0xdd, 0xb8, 0xbf, 0x74, 0x8e, 0xe2, 0x86, 0xd2, 0x2e, 0x60, 0x94, 0x80 },
+  { 0x90, 0xb6, 0x47, 0xbf, 0xb6, 0xb1, 0x8a, 0xf3, 0x5f, 0xcf, 0x61, 0x35, 0x73, 0xad, 0x2e, 0xec },
+  { 0x90, 0xcc, 0xf4, 0xf3, 0x0a, 0x5a, 0xd8, 0xc8, 0x01, 0x09, 0x0b, 0x38, 0x8d, 0xdd, 0x56, 0x13 },
+  { 0x90, 0xd7, 0x7e, 0x96, 0x67, 0x93, 0x75, 0x4a, 0xb4, 0x31, 0x2c, 0x47, 0xb4, 0x29, 0x00, 0xb1 },
+  { 0x90, 0xf5, 0x02, 0xcb, 0xf4, 0x43, 0x8a, 0x95, 0xf6, 0x9f, 0x84, 0x8c, 0xef, 0x36, 0xeb, 0x64 },
+  { 0x91, 0x0d, 0xd9, 0xbf, 0x98, 0xcc, 0x5b, 0xc0, 0x80, 0x94, 0x3e, 0x51, 0x28, 0xb1, 0x5b, 0xf5 },
+  { 0x91, 0x1d, 0x38, 0x5e, 0xe0, 0x80, 0x5f, 0xf5, 0xb8, 0xf9, 0x6c, 0x5a, 0x63, 0xda, 0x7d, 0xe5 },
+  { 0x91, 0x3d, 0x5d, 0x95, 0x9b, 0x50, 0x21, 0xf8, 0x79, 0x03, 0x3c, 0x89, 0x79, 0x7b, 0xab, 0x5e },
+  { 0x91, 0x4a, 0x8f, 0xea, 0xf6, 0xd0, 0xa1, 0xbb, 0xed, 0x9e, 0xb6, 0x1d, 0x33, 0x81, 0x76, 0x79 },
+  { 0x91, 0x92, 0x5a, 0xbc, 0xe3, 0xa2, 0x9e, 0x33, 0xb6, 0xa8, 0xb8, 0x14, 0x82, 0xf4, 0xf5, 0xaf },
+  { 0x91, 0x93, 0xb6, 0xff, 0xf6, 0x89, 0x7d, 0x43, 0x27, 0x47, 0x41, 0xd4, 0xf9, 0x85, 0x5b, 0x6d },
+  { 0x91, 0xa3, 0x74, 0x9f, 0xf7, 0xb7, 0xe7, 0x2b, 0x7f, 0xa0, 0x9e, 0x05, 0x39, 0x6a, 0x0e, 0x7b },
+  { 0x91, 0xb0, 0x07, 0xf3, 0x3f, 0x9b, 0x79, 0x0b, 0xe6, 0x4f, 0x57, 0x22, 0x0e, 0xc5, 0x2e, 0x80 },
+  { 0x91, 0xc2, 0x09, 0x8e, 0x88, 0xa6, 0xb1, 0x3f, 0x97, 0x7a, 0xf8, 0xc0, 0x03, 0xe0, 0xbc, 0xa5 },
+  { 0x91, 0xd1, 0xc8, 0x2c, 0xea, 0xf8, 0xaf, 0x2a, 0xdd, 0x39, 0x73, 0xa3, 0xc3, 0x4b, 0xc0, 0xcb },
+  { 0x91, 0xf0, 0xa7, 0x08, 0xee, 0xb9, 0x3c, 0x13, 0x3e, 0x96, 0x72, 0xad, 0x2c, 0x8e, 0x04, 0x29 },
+  { 0x91, 0xfd, 0xb6, 0x54, 0x1f, 0x70, 0xc4, 0x0b, 0x16, 0xaa, 0xbf, 0x83, 0x08, 0x12, 0x3b, 0xe8 },
+  { 0x92, 0x22, 0xb2, 0x5a, 0x08, 0x75, 0x02, 0x2b, 0x41, 0x2e, 0x8d, 0xa3, 0x7e, 0x7f, 0x68, 0x87 },
+  { 0x92, 0x45, 0xa8, 0x4e, 0x98, 0x51, 0x56, 0x5d, 0x56, 0x5c, 0xb6, 0xc9, 0xfa, 0xc5, 0x80, 0x2b },
+  { 0x92, 0x7d, 0x42, 0x2d, 0x63, 0x35, 0x01, 0x8d, 0xa4, 0x69, 0xa9, 0xa0, 0x7c, 0xd8, 0x03, 0x90 },
+  { 0x92, 0x81, 0xec, 0xcd, 0x7f, 0x6e, 0xf4, 0xb3, 0xeb, 0xdc, 0xfd, 0x22, 0x04, 0xc9, 0x76, 0x3a },
+  { 0x92, 0x95, 0x57, 0x0a, 0x14, 0x1c, 0xde, 0xc1, 0x80, 0x74, 0xc5, 0x5d, 0xc7, 0x22, 0x9d, 0x08 },
+  { 0x92, 0x9e, 0x8a, 0x84, 0xed, 0x50, 0x60, 0x1d, 0x9a, 0xf8, 0xc4, 0x9b, 0x04, 0x25, 0xc7, 0xea },
+  { 0x92, 0xa1, 0xa6, 0x05, 0xb7, 0xad, 0x56, 0xd8, 0x63, 0xa5, 0x63, 0x73, 0xa8, 0x66, 0x76, 0x1b },
+  { 0x92, 0xc5, 0xab, 0xb7, 0xa8, 0xbb, 0x1c, 0x3f, 0xc6, 0x6c, 0x92, 0xba, 0x35, 0x3a, 0x3d, 0x21 },
+  { 0x92, 0xd1, 0xf6, 0xac, 0x17, 0x9e, 0xbe, 0x59, 0x63, 0x86, 0x8d, 0x6b, 0xc1, 0xbd, 0xda, 0x8d },
+  { 0x92, 0xe7, 0x2f, 0x7c, 0xc5, 0x69, 0x58, 0x4c, 0x44, 0xc9, 0x53, 0x0d, 0x64, 0x5a, 0xe0, 0x4e },
+  { 0x92, 0xed, 0xe7, 0x2e, 0xd8, 0xf6, 0x1d, 0x25, 0x5b, 0xc5, 0x8d, 0x2f, 0x16, 0x6d, 0xc6, 0xb6 },
+  { 0x93, 0x1b, 0x91, 0xa8, 0xea, 0x2d, 0x39, 0xfe, 0x4d, 0xca, 0x1a, 0x23, 0x83, 0x2b, 0x59, 0x1a },
+  { 0x93, 0x33, 0x17, 0x2e, 0x3c, 0x49, 0x92, 0xec, 0xf5, 0x48, 0xd3, 0xac, 0x1f, 0x25, 0x53, 0xeb },
+  { 0x93, 0x42, 0x0c, 0xc4, 0xcb, 0x1a, 0xf1, 0xf2, 0x17, 0x5c, 0x63, 0xe5, 0x2e, 0xc1, 0x83, 0x32 },
+  { 0x93, 0x64, 0xad, 0x51, 0xc3, 0x21, 0xe0, 0xf1, 0x5c, 0x96, 0xa8, 0xc0, 0xaf, 0xf4, 0x7c, 0xeb },
+  { 0x93, 0x6e, 0xf1, 0xd6, 0xf8, 0xa5, 0x7b, 0x9f, 0xf5, 0x75, 0xdc, 0x19, 0x5e, 0xe3, 0x6b, 0x80 },
+  { 0x93, 0x6f, 0x55, 0x5b, 0x4b, 0x1a, 0x2c, 0xd0, 0x61, 0xb6, 0x59, 0xff, 0x63, 0xf4, 0xf5, 0xf2 },
+  { 0x93, 0x77, 0x36, 0xd8, 0x99, 0x33, 0x70, 0x36, 0xde, 0x81, 0x83, 0x91, 0xa8, 0x72, 0x71, 0xe0 },
+  { 0x93, 0x9c, 0xe5, 0x54, 0xf5, 0xc0, 0xe7, 0x4c, 0xc6, 0xe4, 0xe6, 0x28, 0x10, 0xec, 0x21, 0x11 },
+  { 0x93, 0xac, 0xd5, 0x02, 0x0a, 0xe8, 0xeb, 0x56, 0x73, 0x60, 0x1e, 0x2e, 0xde, 0xcb, 0xc1, 0x58 },
+  { 0x93, 0xb9, 0x22, 0x9f, 0xc0, 0xea, 0x4f, 0xb9, 0x59, 0xd6, 0x04, 0xf8, 0x3f, 0x8f, 0x60, 0x3c },
+  { 0x93, 0xc5, 0x21, 0x41, 0xd3, 0xc4, 0xe1, 0xb5, 0x57, 0x4d, 0x07, 0x2f, 0x1a, 0xfd, 0xe6, 0xcd },
+  { 0x93, 0xc8, 0xd9, 0xd2, 0x4f, 0x9c, 0x5f, 0x1f, 0x57, 0x06, 0x94, 0x84, 0x8d, 0x08, 0x7d, 0xf7 },
+  { 0x93, 0xc9, 0xf9, 0x23, 0x9a, 0x4e, 0x5c, 0x95, 0x66, 0x63, 0xdd, 0x7a, 0xff, 0xa7, 0x0d, 0xa2 },
+  { 0x93, 0xdc, 0x15, 0xd1, 0x5e, 0x77, 0xa7, 0xb2, 0x31, 0x62, 0x46, 0x7f, 0x95, 0xa5, 0xf2, 0x2d },
+  { 0x93, 0xeb, 0x17, 0x95, 0xc8, 0xb1, 0x06, 0x5b, 0x1b, 0x3d, 0x62, 0xbb, 0x9e, 0xc0, 0xcc, 0xdc },
+  { 0x94, 0x10, 0x2f, 0xeb, 0xc5, 0x3b, 0x4a, 0x78, 0x34, 0x2d, 0x11, 0xb6, 0x45, 0x34, 0x2e, 0xd4 },
+  { 0x94, 0x36, 0xb7, 0xad, 0x13, 0x1b, 0x5a, 0x1f, 0x77, 0x53, 0xce, 0x43, 0x09, 0xba, 0x3d, 0xee },
+  { 0x94, 0x69, 0xd1, 0x82, 0x38, 0x34, 0x5d, 0x87, 0x76, 0x8e, 0x89, 0x65, 0xf9, 0xf4, 0xa6, 0xb2 },
+  { 0x94, 0x73, 0x17, 0xa8, 0x9a, 0xf3, 0x8a, 0x49, 0xc4, 0x86, 0x4d, 0x6b, 0xdd, 0x6a, 0x91, 0xfb },
+  { 0x94, 0xb9, 0x2a, 0x88, 0x2f, 0x6d, 0xba, 0xa6, 0x99, 0x3a, 0x46, 0xe2, 0xdc, 0xc5, 0x84, 0x02 },
+  { 0x94, 0xd9, 0x0f, 0x63, 0x67, 0x8e, 0x08, 0x6f, 0x6b, 0x6d, 0x5e, 0x1b, 0xc6, 0xc4, 0xc8, 0xc2 },
+  { 0x94, 0xe3, 0xfb, 0xc1, 0x91, 0x07, 0xa1, 0x69, 0x90, 0x9e, 0x27, 0x41, 0x87, 0x24, 0x7a, 0x9d },
+  { 0x94, 0xe4, 0xc9, 0xb9, 0x24, 0x28, 0x60, 0x38, 0x52, 0x7f, 0x49, 0xcd, 0xc2, 0x0f, 0xda, 0x69 },
+  { 0x94, 0xe7, 0xcc, 0x63, 0x42, 0xd1, 0x1e, 0x50, 0x8e, 0x7e, 0x8b, 0x2d, 0xdf, 0x53, 0xc2, 0x55 },
+  { 0x94, 0xff, 0x6b, 0x74, 0x89, 0xed, 0x40, 0x1d, 0xca, 0xaf, 0x95, 0x2f, 0xec, 0xe1, 0x0f, 0x67 },
+  { 0x95, 0x1e, 0x8c, 0xec, 0x7a, 0x1a, 0x1d, 0x6c, 0x01, 0xfd, 0x64, 0x9e, 0x7f, 0xf7, 0x74, 0x3a },
+  { 0x95, 0x26, 0xe3, 0xdb, 0x3b, 0xdf, 0xbc, 0x27, 0x98, 0x9a, 0x9c, 0xbf, 0xd0, 0xee, 0x34, 0xbf },
+  { 0x95, 0x35, 0x1b, 0x46, 0xfa, 0x9c, 0x45, 0x47, 0x1d, 0x85, 0x2d, 0x28, 0xb9, 0xb4, 0xe0, 0x0b },
+  { 0x95, 0x5c, 0x40, 0x82, 0x65, 0xad, 0x69, 0x94, 0xf6, 0x1f, 0x9b, 0x66, 0x65, 0x7b, 0xba, 0xe9 },
+  { 0x95, 0x64, 0x96, 0xf8, 0x17, 0x75, 0xde, 0x0b, 0x69, 0xa1, 0x16, 0xa0, 0xd1, 0xad, 0x41, 0xcc },
+  { 0x95, 0x6b, 0x99, 0x51, 0x1c, 0x0f, 0x47, 0xb3, 0xa1, 0x1d, 0x18, 0xe8, 0xb7, 0xac, 0x8d, 0x47 },
+  { 0x95, 0x95, 0x61, 0x08, 0x28, 0x9a, 0x91, 0x7f, 0x80, 0x66, 0x7e, 0xcc, 0xd3, 0xce, 0x98, 0xa9 },
+  { 0x95, 0xa6, 0x9c, 0xf8, 0xc0, 0x8e, 0xf1, 0x52, 0x2b, 0x05, 0x05, 0x29, 0x46, 0x4f, 0x0b, 0xca },
+  { 0x95, 0xa8, 0x9d, 0x1b, 0xf7, 0x67, 0xd7, 0xcc, 0x9d, 0x0d, 0x50, 0x93, 0xd5, 0x79, 0xba, 0x61 },
+  { 0x95, 0xe1, 0xd8, 0x34, 0xc5, 0x7c, 0xdd, 0x52, 0x5d, 0xd0, 0xbd, 0x60, 0x48, 0xa5, 0x7f, 0x7b },
+  { 0x95, 0xe5, 0x42, 0xa7, 0x46, 0x7c, 0x94, 0xb1, 0xe4, 0xab, 0x24, 0xa3, 0xeb, 0xe9, 0x07, 0xf1 },
+  { 0x95, 0xfd, 0x60, 0x97, 0xdc, 0x27, 0xc2, 0x06, 0x66, 0xf0, 0x39, 0xcf, 0xe3, 0x4f, 0x7c, 0x69 },
+  { 0x96, 0x11, 0x12, 0xb7, 0x4a, 0x92, 0x0a, 0x52, 0x42, 0xe2, 0x33, 0x48, 0x03, 0x26, 0xc3, 0x56 },
+  { 0x96, 0x2f, 0xfd, 0x3e, 0xaf, 0x86, 0x52, 0x30, 0xa7, 0xa3, 0x12, 0xb8, 0x0e, 0x6c, 0x5c, 0xfd },
+  { 0x96, 0x67, 0x0d, 0x0b, 0xf3, 0x61, 0x0d, 0xa2, 0xaf, 0xca, 0xbd, 0x8e, 0x21, 0xd8, 0xea, 0xbf },
+  { 0x96, 0x6b, 0x11, 0xd3, 0xc1, 0x47, 0xd8, 0x94, 0xdd, 0x9e, 0x4e, 0xbb, 0x97, 0x1e, 0xa3, 0x09 },
+  { 0x96, 0x71, 0xb6, 0x58, 0x28, 0x6e, 0x27, 0x6c, 0xc4, 0xa3, 0xd0, 0x2a, 0xa2, 0x59, 0x31, 0xd2 },
+  { 0x96, 0x8e, 0xfc, 0x79, 0xd5, 0x00, 0xdc, 0xe5, 0x2a, 0x90, 0x68, 0x70, 0xa9, 0x73, 0x58, 0xab },
+  { 0x96, 0x9b, 0x96, 0x83, 0x83, 0xd9, 0xf0, 0xe9, 0xd8, 0xff, 0xd1, 0x05, 0x6b, 0xca, 0xef, 0x49 },
+  { 0x96, 0xbc, 0xb3, 0xd9, 0x7c, 0xe4, 0xff, 0x75, 0x86, 0x32, 0x6d, 0x18, 0x3a, 0xc3, 0x38, 0xa2 },
+  { 0x96, 0xe7, 0x98, 0x99, 0x5a, 0xf6, 0xed, 0x9d, 0x86, 0x01, 0x16, 0x6d, 0x43, 0x50, 0xf2, 0x76 },
+  { 0x96, 0xec, 0xcc, 0x22, 0x77, 0x04, 0x35, 0x08, 0xa6, 0xc4, 0x81, 0xea, 0x43, 0x2d, 0x7d, 0xd9 },
+  { 0x96, 0xf8, 0x06, 0xfc, 0x62, 0x00, 0x52, 0x05, 0xd8, 0x51, 0xe7, 0x58, 0xd0, 0x50, 0xdf, 0xca },
+  { 0x97, 0x18, 0x4b, 0x26, 0x37, 0x22, 0x74, 0x87, 0x57, 0xcf, 0xdc, 0x41, 0x10, 0x7c, 0xa5, 0xc0 },
+  { 0x97, 0x18, 0xb8, 0x5a, 0xc5, 0xa5, 0x5c, 0xbc, 0x73, 0x48, 0x96, 0x3c, 0x63, 0xff, 0xa3, 0x5a },
+  { 0x97, 0x24, 0x86, 0x11, 0x09, 0x33, 0x62, 0x30, 0x39, 0xa3, 0x58, 0x1d, 0xb3, 0x08, 0xfd, 0xa6 },
+  { 0x97, 0x32, 0x7d, 0x69, 0x62, 0xf8, 0xc6, 0x4e, 0x6f, 0x92, 0x6f, 0x79, 0xcd, 0x01, 0xc6, 0xb9 },
+  { 0x97, 0x72, 0x94, 0xae, 0x65, 0x26, 0xc3, 0x1c, 0x7f, 0x9a, 0x16, 0x6e, 0xe0, 0x09, 0x64, 0xad },
+  { 0x97, 0x84, 0x2f, 0xe8, 0x47, 0xe8, 0xeb, 0x71, 0x26, 0x3d, 0x6f, 0x92, 0xf7, 0xe1, 0x22, 0xbd },
+  { 0x97, 0x93, 0x3c, 0x9f, 0x20, 0x87, 0x34, 0x46, 0xe4, 0xc1, 0xf8, 0xa4, 0xda, 0x21, 0x57, 0x5f },
+  { 0x97, 0xa9, 0xbb, 0x5c, 0x36, 0x79, 0xd6, 0x7f, 0x5c, 0x2c, 0xd1, 0x7f, 0x30, 0xb8, 0x5d, 0x95 },
+  { 0x97, 0xcd, 0x63, 0xc4, 0x83, 0xfe, 0x3c, 0x68, 0xb7, 0xce, 0x93, 0x9a, 0xb8, 0xf7, 0xa3, 0x18 },
+  { 0x97, 0xd0, 0x15, 0x1b, 0xeb, 0x84, 0xac, 0xbe, 0x82, 0xaa, 0x6d, 0xb1, 0x8c, 0xd9, 0x1b, 0x98 },
+  { 0x97, 0xd0, 0x79, 0x31, 0x5c, 0x09, 0x79, 0x6f, 0xf6, 0xd9, 0x5a, 0x06, 0xe4, 0xb7, 0x01, 0x71 },
+  { 0x98, 0x13, 0xb9, 0xe4, 0xb8, 0xa6, 0xfd, 0x91, 0x9c, 0x86, 0xa4, 0x0c, 0x6b, 0xda, 0x8c, 0x93 },
+  { 0x98, 0x31, 0xef, 0xc7, 0xf4, 0xcb, 0x8f, 0xfb, 0x4d, 0xf0, 0x08, 0x2b, 0xab, 0x2f, 0x07, 0xa3 },
+  { 0x98, 0x48, 0xb5, 0xef, 0x7a, 0x0c, 0x02, 0xfe, 0x80, 0x8b, 0x92, 0x0a, 0x2a, 0xc5, 0x66, 0xd2 },
+  { 0x98, 0x53, 0x08, 0x96, 0x72, 0x11, 0x61, 0x17, 0x25, 0x80, 0x97, 0xdb, 0xbd, 0xb9, 0x39, 0xb7 },
+  { 0x98, 0x55, 0x5b, 0x95, 0xcb, 0x38, 0xe0, 0xe0, 0xb2, 0x2b, 0x48, 0x2b, 0x2b, 0x60, 0xa5, 0xb6 },
+  { 0x98, 0xba, 0x60, 0x1a, 0x60, 0x17, 0x2c, 0xb4, 0x6c, 0x5b, 0xf9, 0xa9, 0x62, 0xfd, 0x5b, 0x1f },
+  { 0x98, 0xcc, 0xd1, 0x53, 0x45, 0xb1, 0xae, 0xe6, 0xca, 0xf5, 0x1e, 0x05, 0x95, 0x5f, 0x02, 0x61 },
+  { 0x98, 0xe5, 0xe4, 0xd5, 0xc4, 0xdd, 0x9a, 0x98, 0x6d, 0x30, 0xfd, 0x62, 0xbd, 0x2f, 0x75, 0xae },
+  { 0x98, 0xe6, 0xe3, 0x4a, 0xf4, 0x5a, 0x06, 0x64, 0x59, 0x79, 0x72, 0xc3, 0xbb, 0x31, 0x18, 0x0f },
+  { 0x98, 0xe7, 0xca, 0xaa, 0xb8, 0xec, 0x23, 0x75, 0x58, 0x37, 0x8d, 0x27, 0x76, 0xc6, 0x66, 0x16 },
+  { 0x98, 0xea, 0x10, 0xc4, 0x7c, 0x13, 0xf1, 0xb3, 0x30, 0x6c, 0x7b, 0x13, 0xdb, 0x30, 0x48, 0x65 },
+  { 0x98, 0xec, 0x0f, 0xa4, 0x19, 0x9b, 0x9c, 0x01, 0xf7, 0xb8, 0xfa, 0x37, 0x32, 0xe4, 0x33, 0x72 },
+  { 0x98, 0xef, 0x15, 0x93, 0x62, 0x4b, 0x40, 0x9b, 0x9f, 0xb8, 0x3a, 0x1c, 0x27, 0x2a, 0x0a, 0xa7 },
+  { 0x98, 0xf6, 0x39, 0x49, 0xe6, 0x56, 0xff, 0x30, 0x9c, 0xef, 0xa6, 0x72, 0x14, 0x6d, 0xc1, 0xb8 },
+  { 0x98, 0xfa, 0x3a, 0xd7, 0x78, 0xa6, 0x68, 0xa7, 0x94, 0x49, 0x35, 0x0d, 0xe4, 0xb3, 0xb9, 0x5b },
+  { 0x99, 0x05, 0xf9, 0xf4, 0x70, 0x62, 0x23, 0xda, 0xde, 0xe8, 0x4f, 0x68, 0x67, 0xed, 0xe8, 0xe3 },
+  { 0x99, 0x12, 0xd0, 0x6e, 0xea, 0x42, 0x20, 0x0a, 0x19, 0x8d, 0xd3, 0xe2, 0xbe, 0x18, 0xc6, 0x01 },
+  { 0x99, 0x1d, 0x57, 0xbb, 0xcd, 0x52, 0x9a, 0xd6, 0x29, 0x25, 0x09, 0x8e, 0x0a, 0xec, 0x12, 0x41 },
+  { 0x99, 0x45, 0xa2, 0x2f, 0x60, 0xbb, 0xaf, 0x6d, 0x04, 0xa8, 0xd7, 0x3b, 0x3c, 0xf3, 0xdb, 0x75 },
+  { 0x99, 0x47, 0xf1, 0xeb, 0xab, 0xb5, 0x6f, 0xd0, 0x75, 0xa9, 0x6c, 0x6d, 0x37, 0x35, 0x1e, 0xfa },
+  { 0x99, 0x62, 0x03, 0x4e, 0xa7, 0xb3, 0xd4, 0xa9, 0x05, 0xd0, 0x99, 0x18, 0x04, 0x67, 0x00, 0x87 },
+  { 0x99, 0x89, 0xf9, 0x74, 0xc3, 0xcf, 0x9c, 0x64, 0x1d, 0xb6, 0xc8, 0xa7, 0x0a, 0x2a, 0x22, 0x67 },
+  { 0x99, 0xa2, 0x4d, 0x7b, 0xb3, 0x1d, 0x49, 0xb7, 0x20, 0xb4, 0x22, 0x55, 0x0b, 0x32, 0xc3, 0x5f },
+  { 0x99, 0xf7, 0xc6, 0xc2, 0x60, 0x46, 0xbb, 0xe9, 0x5f, 0x1c, 0x60, 0x4b, 0x25, 0xda, 0x83, 0x60 },
+  { 0x9a, 0x01, 0x11, 0x52, 0x06, 0xf3, 0x2e, 0xb0, 0xb5, 0x39, 0xc7, 0xe5, 0xa4, 0x7c, 0xca, 0xfa },
+  { 0x9a, 0x16, 0x5c, 0x39, 0xaf, 0x3f, 0x05, 0x0f, 0xde, 0xe6, 0x58, 0x3f, 0xdf, 0xcd, 0xc9, 0xbe },
+  { 0x9a, 0x21, 0xfb, 0xa9, 0xee, 0x97, 0x94, 0xe0, 0xfa, 0xdd, 0x7c, 0x7e, 0xb6, 0xbe, 0x4e, 0x12 },
+  { 0x9a, 0x25, 0xb3, 0xcf, 0xe2, 0xbb, 0xb8, 0x47, 0xb6, 0x6a, 0x97, 0x28, 0x22, 0x00, 0xcc, 0xa2 },
+  { 0x9a, 0x42, 0x74, 0x40, 0x92, 0x16, 0xff, 0x09, 0xec, 0xde, 0x79, 0x9f, 0x2a, 0x56, 0xac, 0x73 },
+  { 0x9a, 0xb7, 0x2d, 0x3f, 0xd2, 0xcc, 0x1a, 0x0c, 0x9a, 0xdb, 0x50, 0x45, 0x02, 0x57, 0x90, 0x37 },
+  { 0x9a, 0xd3, 0x62, 0x17, 0x9c, 0x2e, 0xea, 0x4e, 0xa1, 0x15, 0xc7, 0x64, 0x0b, 0x4b, 0x00, 0x3e },
+  { 0x9a, 0xd3, 0x6e, 0x69, 0x9e, 0xf6, 0xf4, 0x5d, 0x9e, 0xb6, 0xc4, 0xcf, 0x90, 0x47, 0x5c, 0x9f },
+  { 0x9a, 0xeb, 0x52, 0x06, 0xc5, 0xbf, 0x97, 0x48, 0x92, 0xa9, 0xcc, 0x59, 0xf1, 0x47, 0x8d, 0xb3 },
+  { 0x9a, 0xf6, 0x15, 0x95, 0x1e, 0x97, 0x19, 0xdf, 0x22, 0x44, 0xbc, 0x77, 0xfc, 0x50, 0xcb, 0x95 },
+  { 0x9a, 0xfd, 0xfe, 0x1c, 0xff, 0x7f, 0x37, 0xf1, 0xc9, 0x71, 0xfe, 0x3f, 0x0c, 0x90, 0x06, 0x06 },
+  { 0x9b, 0x15, 0x0a, 0x42, 0xfc, 0x78, 0x89, 0x60, 0xfb, 0xb4, 0xcb, 0xe2, 0x50, 0x25, 0x9e, 0xe2 },
+  { 0x9b, 0x21, 0xd8, 0xfc, 0x78, 0xcc, 0x43, 0x08, 0x99, 0x0d, 0x99, 0xa4, 0xd9, 0x06, 0xec, 0x52 },
+  { 0x9b, 0x24, 0x66, 0x83, 0xf4, 0x4c, 0x96, 0x3a, 0x50, 0xe4, 0x1d, 0x6b, 0x48, 0x5b, 0xee, 0x77 },
+  { 0x9b, 0xb1, 0x36, 0xb6, 0x25, 0x21, 0xc6, 0x7a, 0xc8, 0x93, 0x21, 0x3e, 0x01, 0xdd, 0x33, 0x8f },
+  { 0x9b, 0xd4, 0xe0, 0xd5, 0xf2, 0x8b, 0xa6, 0xda, 0x41, 0x7c, 0x26, 0x64, 0x91, 0x71, 0xf8, 0xe4 },
+  { 0x9b, 0xe5, 0x8a, 0x14, 0xe0, 0x55, 0xb0, 0xe7, 0x58, 0x1f, 0xc4, 0xd6, 0xc2, 0xf6, 0xb3, 0x1d },
+  { 0x9c, 0x27, 0xef, 0x3b, 0xd0, 0x1c, 0x61, 0x1c, 0xdb, 0x80, 0x18, 0x2a, 0x59, 0x46, 0x3a, 0x82 },
+  { 0x9c, 0x40, 0xbf, 0x81, 0x0f, 0x76, 0x1f, 0xfc, 0x9c, 0x1b, 0x69, 0xc4, 0x64, 0x7a, 0x8b, 0x84 },
+  { 0x9c, 0x6d, 0x65, 0xbd, 0x3b, 0x47, 0x7a, 0xac, 0xe0, 0x37, 0x6f, 0x70, 0x5b, 0x35, 0x4d, 0x68 },
+  { 0x9c, 0x6f, 0xaa, 0x4f, 0xf7, 0xf2, 0xae, 0x54, 0x9b, 0xbc, 0xb1, 0x4f, 0x58, 0x2b, 0x70, 0xe4 },
+  { 0x9c, 0x6f, 0xd6, 0xed, 0x35, 0x99, 0x97, 0x8a, 0xb7, 0xb6, 0xf9, 0x00, 0x48, 0x4b, 0x9b, 0xe6 },
+  { 0x9c, 0x72, 0x90, 0x17, 0xdd, 0x2f, 0x9c, 0xcb, 0xad, 0xcb, 0x51, 0x11, 0x87, 0xf8, 0x0e, 0x6b },
+  { 0x9c, 0x7f, 0xa3, 0xcf, 0xca, 0xaa, 0xfb, 0x4e, 0x6d, 0xaf, 0x1e, 0x25, 0x17, 0xd4, 0x3d, 0x88 },
+  { 0x9c, 0xa2, 0xde, 0xb6, 0x13, 0x18, 0xeb, 0xa4, 0xfb, 0x78, 0x4d, 0x4b, 0xf7, 0x44, 0x1d, 0x8b },
+  { 0x9c, 0xbb, 0x07, 0xf1, 0x99, 0x3a, 0x02, 0x7b, 0xc2, 0xf8, 0x7d, 0x52, 0x05, 0x45, 0x7e, 0xc9 },
+  { 0x9d, 0x0b, 0xef, 0xa5, 0x55, 0xf0, 0x03, 0x06, 0x9a, 0x21, 0xd2, 0xf6, 0x84, 0x7a, 0xd9, 0x62 },
+  { 0x9d, 0x15, 0x56, 0xae, 0x58, 0x90, 0x39, 0x8b, 0xe7, 0xe3, 0xd5, 0x74, 0x49, 0x77, 0x4b, 0x40 },
+  { 0x9d, 0x29, 0x38, 0xeb, 0x2b, 0x17, 0xbb, 0x73, 0xe9, 0xa7, 0x9b, 0xbc, 0x06, 0x05, 0x35, 0x06 },
+  { 0x9d, 0x2f, 0x05, 0xd0, 0xfe, 0x8b, 0x2d, 0xfc, 0xf7, 0x70, 0xb0, 0x2e, 0xda, 0x06, 0x6f, 0xc1 },
+  { 0x9d, 0x33, 0xd3, 0x1f, 0xb1, 0xde, 0x58, 0xc5, 0x46, 0x0d, 0x8a, 0x67, 0xb5, 0x7b, 0x36, 0xda },
+  { 0x9d, 0x37, 0xa1, 0xbe, 0x4a, 0x6e, 0x89, 0x80, 0x26, 0x41, 0x4b, 0x8f, 0xee, 0x2f, 0xc8, 0x26 },
+  { 0x9d, 0x4b, 0xc7, 0xc6, 0xfe, 0x9a, 0x7c, 0x8c, 0x4a, 0xa2, 0x4a, 0x23, 0x7c, 0x34, 0x0a, 0xdb },
+  { 0x9d, 0x52, 0x2a, 0x37, 0x59, 0xaa, 0x85, 0x56, 0x68, 0xe7, 0x59, 0x62, 0xc8, 0x45, 0x46, 0xf7 },
+  { 0x9d, 0x7f, 0x04, 0x61, 0x8b, 0xb4, 0x04, 0x3f, 0x53, 0x1d, 0x08, 0x7e, 0x3a, 0xaa, 0x7a, 0xc8 },
+  { 0x9d, 0xe0, 0xd4, 0x57, 0x31, 0xf9, 0x0a, 0x0a, 0x92, 0x2a, 0xb0, 0x92, 0x28, 0x51, 0x03, 0x93 },
+  { 0x9d, 0xec, 0x0b, 0xe1, 0x4d, 0x89, 0x9e, 0x1a, 0xac, 0x43, 0x37, 0xac, 0xef, 0x5a, 0xb9, 0x4a },
+  { 0x9e, 0x01, 0xf7, 0xf9, 0x5c, 0xb8, 0x59, 0x67, 0x65, 0xe0, 0x3b, 0x9a, 0x36, 0xe8, 0xe3, 0x3c },
+  { 0x9e, 0x19, 0x26, 0x01, 0x82, 0x9f, 0x5f, 0x5c, 0x2d, 0x3b, 0x51, 0xf8, 0xae, 0x25, 0xdb, 0xe5 },
+  { 0x9e, 0x2c, 0x72, 0x99, 0xc6, 0x9b, 0x60, 0x24, 0x43, 0xd3, 0x27, 0xc7, 0xda, 0xd5, 0x1c, 0xbf },
+  { 0x9e, 0x43, 0x72, 0x29, 0x13, 0x6f, 0x1c, 0x5e, 0x6e, 0xf4, 0xc5, 0xf3, 0x61, 0x78, 0xed, 0x18 },
+  { 0x9e, 0x50, 0x07, 0x13, 0x16, 0x95, 0x62, 0x1d, 0x06, 0x90, 0x2a, 0xb3, 0xc9, 0x60, 0x62, 0x2a },
+  { 0x9e, 0x6f, 0xa0, 0x31, 0xec, 0xe0, 0x79, 0x19, 0xc8, 0x16, 0xfb, 0xa5, 0xdc, 0x8d, 0xe4, 0x3e },
+  { 0x9e, 0x79, 0x2a, 0x59, 0xf8, 0x79, 0x56, 0x64, 0xcb, 0xaa, 0xff, 0x1b, 0xa1, 0x52, 0xd7, 0x31 },
+  { 0x9e, 0x90, 0x4e, 0x2e, 0xaa, 0x47, 0x1c, 0x05, 0x0c, 0x49, 0x12, 0x89, 0xb8, 0xb8, 0x0f, 0x60 },
+  { 0x9e, 0xa8, 0xed, 0x9d, 0xec, 0x03, 0x08, 0x29, 0x73, 0x24, 0x4a, 0x08, 0x09, 0x41, 0xe5, 0x8a },
+  { 0x9e, 0xc1, 0xb2, 0x59, 0xa1, 0xbc, 0xff, 0xa6, 0x30, 0x42, 0xa3, 0xc2, 0xb3, 0xb9, 0x0f, 0x0a },
+  { 0x9e, 0xca, 0x52, 0x1d, 0xb1, 0x95, 0x91, 0x56, 0xa1, 0x15, 0xde, 0xe8, 0x5a, 0x40, 0x51, 0x94 },
+  { 0x9e, 0xd0, 0xf2, 0xaa, 0x22, 0x6c, 0x34, 0xd4, 0xf5, 0x5f, 0x66, 0x14, 0x42, 0xe8, 0xf2, 0x2a },
+  { 0x9e, 0xeb, 0x40, 0xf0, 0x4a, 0x27, 0xef, 0xb1, 0xc6, 0x8b, 0xa1, 0xd2, 0x5e, 0x60, 0x66, 0x07 },
+  { 0x9e, 0xfa, 0x87, 0x7a, 0x98, 0xdd, 0x5a, 0x07, 0x5e, 0x05, 0x82, 0x14, 0xda, 0x42, 0x8a, 0xbb },
+  { 0x9e, 0xfb, 0x4e, 0x1a, 0x15, 0xa6, 0xcd, 0xd2, 0x86, 0xe4, 0xbc, 0xd7, 0xcd, 0x94, 0xb7, 0xb8 },
+  { 0x9f, 0x2d, 0x58, 0xdc, 0xe1, 0xb8, 0x1c, 0x6b, 0xa2, 0x01, 0xed, 0x10, 0x35, 0x07, 0xc0, 0x25 },
+  { 0x9f, 0x48, 0xee, 0xb4, 0x78, 0x36, 0xcf, 0x14, 0x5a, 0x15, 0x77, 0x17, 0x75, 0xf0, 0x76, 0x7a },
+  { 0x9f, 0x50, 0x96, 0xa6, 0xf1, 0xa5, 0x04, 0x9d, 0xf8, 0x77, 0x98, 0xeb, 0x59, 0x70, 0x75, 0x83 },
+  { 0x9f, 0x59, 0xed, 0xdf, 0x9b, 0xa9, 0x1a, 0x7d, 0x93, 0xbc, 0xe7, 0xee, 0x4b, 0x76, 0x93, 0xbc },
+  { 0x9f, 0x8f, 0xad, 0x4b, 0xad, 0xcd, 0x7b, 0xe6, 0x1b, 0xbd, 0x2b, 0xca, 0xee, 0xf3, 0xc5, 0x8f },
+  { 0x9f, 0x90, 0x15, 0x09, 0xf0, 0x47, 0x4b, 0xf9, 0x76, 0x0e, 0x6e, 0xbd, 0x80, 0xe6, 0x29, 0xcd },
+  { 0x9f, 0x93, 0x73, 0x4c, 0x68, 0xf6, 0x47, 0x9e, 0xb0, 0x22, 0xca, 0xb4, 0x08, 0x14, 0x14, 0x2e },
+  { 0x9f, 0x9e, 0xe0, 0xf6, 0x0c, 0x11, 0x9c, 0x83, 0x1e, 0x80, 0x69, 0x4b, 0x66, 0x78, 0xca, 0x1a },
+  { 0x9f, 0xa0, 0xc6, 0x64, 0xb1, 0x57, 0xa0, 0xc2, 0x7d, 0x10, 0x31, 0x9d, 0xbb, 0xca, 0x81, 0x2c },
+  { 0x9f, 0xc2, 0xd1, 0x62, 0x7d, 0xcd, 0xd8, 0x92, 0x5f, 0x4c, 0x04, 0x2e, 0x38, 0xeb, 0x0b, 0xc9 },
+  { 0xa0, 0x02, 0x8f, 0x05, 0x7d, 0x49, 0x6f, 0x22, 0xb5, 0x49, 0xfd, 0x8d, 0xee, 0xcc, 0x6f, 0x78 },
+  { 0xa0, 0x0e, 0xc8, 0x9d, 0x22, 0xfc, 0xc0, 0xc1, 0xa8, 0x5b, 0xb5, 0x42, 0xdd, 0xcb, 0x11, 0x78 },
+  { 0xa0, 0x0e, 0xe0, 0xae, 0xd5, 0xc8, 0x97, 0x9a, 0xdd, 0x4c, 0x17, 0x0f, 0x53, 0x22, 0xc7, 0x06 },
+  { 0xa0, 0x18, 0x5c, 0x06, 0x29, 0x7b, 0x28, 0x18, 0xf7, 0x86, 0xd1, 0x1a, 0x3f, 0x9e, 0x42, 0xc3 },
+  { 0xa0, 0x25, 0xa8, 0xf8, 0x3a, 0x42, 0xa4, 0xd6, 0xd4, 0x6c, 0x48, 0x87, 0xe7, 0x99, 0xbf, 0xac },
+  { 0xa0, 0x29, 0x7c, 0x47, 0x88, 0xf9, 0xe9, 0x1d, 0x43, 0xe5, 0x22, 0xf4, 0xc5, 0x61, 0xb4, 0xad },
+  { 0xa0, 0x56, 0x3d, 0xd6, 0xd8, 0x21, 0x5c, 0x38, 0xc4, 0x88, 0xfb, 0xbd, 0x61, 0x43, 0x56, 0x26 },
+  { 0xa0, 0x67, 0x58, 0x83, 0xf9, 0xb0, 0x9a, 0x35, 0x95, 0xdd, 0xd6, 0x6a, 0x6f, 0x5d, 0x34, 0x98 },
+  { 0xa0, 0x75, 0xad, 0x33, 0x29, 0x42, 0x74, 0x0c, 0x38, 0x6f, 0x4c, 0x38, 0x14, 0x92, 0x5e, 0xce },
+  { 0xa0, 0xd5, 0x02, 0xdc, 0x8b, 0x90, 0xb1, 0xd7, 0xda, 0xa5, 0xf6, 0xef, 0xfb, 0x10, 0xd3, 0x49 },
+  { 0xa0, 0xe2, 0xd3, 0x10, 0xe3, 0xe9, 0x86, 0x46, 0x26, 0x82, 0x00, 0xc8, 0xf0, 0xf0, 0x8f, 0x46 },
+  { 0xa1, 0x00, 0xef, 0xf2, 0xd7, 0xae, 0x61, 0xca, 0x2b, 0x8e, 0x65, 0xba, 0xf7, 0xe2, 0xaa, 0xe8 },
+  { 0xa1, 0x10, 0x99, 0xb6, 0xec, 0x24, 0xe4, 0xb0, 0x0b, 0x87, 0x95, 0x74, 0x4f, 0xb1, 0x20, 0x05 },
+  { 0xa1, 0x40, 0x3f, 0xef, 0x01, 0x64, 0x1d, 0xcd, 0x39, 0x80, 0xca, 0xc9, 0xf2, 0x4d, 0x63, 0xf9 },
+  { 0xa1, 0x4d, 0x8a, 0x38, 0x80, 0x83, 0xc6, 0x02, 0x83, 0xe0, 0x05, 0x92, 0xb1, 0x8d, 0x4c, 0x6c },
+  { 0xa1, 0x5b, 0x58, 0x31, 0xa1, 0xfa, 0xb5, 0x2e, 0x4c, 0x41, 0x60, 0x68, 0xc8, 0x5e, 0xc0, 0x11 },
+  { 0xa1, 0x74, 0xce, 0xce, 0x06, 0xb3, 0xab, 0xc0, 0xae, 0xc3, 0x51, 0x69, 0x13, 0xcd, 0xf9, 0xcc },
+  { 0xa1, 0x77, 0x0e, 0xf4, 0x71, 0x46, 0xab, 0x7b, 0x12, 0xe2, 0xc4, 0xbe, 0xcc, 0xd6, 0x88, 0x06 },
+  { 0xa1, 0x84, 0x84, 0x6d, 0x89, 0x04, 0x39, 0x68, 0x30, 0x95, 0x12, 0x17, 0xb4, 0x7d, 0x13, 0xd9 },
+  { 0xa1, 0x89, 0xf2, 0x80, 0x52, 0x1f, 0x4e, 0x52, 0x24, 0xd3, 0x45, 0xef, 0xb4, 0xe7, 0x55, 0x06 },
+  { 0xa1, 0xbc, 0xbe, 0x0b, 0xfe, 0x65, 0x70, 0xda, 0x26, 0x61, 0xfc, 0x4d, 0xe2, 0xf7, 0x4e, 0x8a },
+  { 0xa1, 0xca, 0x37, 0x23, 0x88, 0xb6, 0x46, 0x5a, 0x69, 0x3e, 0x46, 0x26, 0xcc, 0x98, 0xb8, 0x65 },
+  { 0xa1, 0xea, 0xd9, 0xc1, 0x81, 0xd6, 0x78, 0x59, 0xaa, 0x93, 0xc4, 0x4e, 0x40, 0xf1, 0x70, 0x9c },
+  { 0xa1, 0xf9, 0x15, 0x91, 0x21, 0x14, 0x2d, 0x42, 0xe6, 0x3e, 0x6f, 0xb8, 0x07, 0xd3, 0x37, 0xaa },
+  { 0xa2, 0x04, 0xcd, 0x4f, 0xb1, 0x94, 0x4c, 0x86, 0xe8, 0x00, 0x12, 0x07, 0x06, 0x51, 0x2a, 0x64 },
+  { 0xa2, 0x0b, 0x7a, 0xbb, 0xcd, 0xf9, 0x0f, 0xbc, 0x29, 0xac, 0x0f, 0xaf, 0xa1, 0x95, 0xbd, 0x12 },
+  { 0xa2, 0x0d, 0x93, 0x1a, 0x8f, 0xdd, 0xcd, 0x6f, 0x61, 0x16, 0xed, 0x21, 0xff, 0x5c, 0x48, 0x32 },
+  { 0xa2, 0x17, 0x03, 0x18, 0xa8, 0xef, 0x4b, 0x50, 0xa1, 0xb1, 0xd3, 0x85, 0x67, 0xc2, 0x20, 0xd6 },
+  { 0xa2, 0x3f, 0xfc, 0x86, 0x80, 0x42, 0x40, 0xce, 0x77, 0x13, 0x4a, 0x1c, 0x91, 0x92, 0x66, 0x85 },
+  { 0xa2, 0x42, 0x4c, 0x1a, 0x0c, 0x78, 0x3d, 0x75, 0x85, 0xd7, 0x01, 0xb1, 0xc7, 0x1b, 0x5f, 0xdc },
+  { 0xa2, 0x5b, 0xb7, 0x6e, 0x9e, 0x77, 0x31, 0x17, 0xe5, 0x67, 0xfd, 0x43, 0x00, 0xb1, 0xbb, 0x23 },
+  { 0xa2, 0x8d, 0x87, 0x2f, 0xc5, 0x0f, 0xa6, 0xb6, 0x4e, 0xb3, 0x59, 0x81, 0xd0, 0xf4, 0xbb, 0x8d },
+  { 0xa2, 0x9d, 0xf3, 0x55, 0x57, 0xf3, 0x1d, 0xfe, 0xa2, 0xe2, 0xae, 0x46, 0x09, 0xc6, 0xeb, 0xb7 },
+  { 0xa2, 0x9f, 0xc8, 0x54, 0x83, 0x8e, 0x08, 0xc2, 0x47, 0x55, 0x3a, 0x7d, 0x88, 0x3d, 0xd6, 0x5b },
+  { 0xa2, 0xaa, 0xe7, 0x59, 0xe4, 0xe7, 0x6f, 0x85, 0xc8, 0xaf, 0xec, 0x3b, 0x86, 0x52, 0x93, 0x17 },
+  { 0xa2, 0xde, 0x0f, 0xc8, 0x55, 0x48, 0x87, 0x12, 0x79, 0xed, 0x2a, 0x3c, 0x13, 0x25, 0xc1, 0x3e },
+  { 0xa2, 0xeb, 0x84, 0xcf, 0xee, 0xd5, 0x5a, 0xcd, 0x7f, 0xec, 0xe7, 0xfe, 0xfd, 0xc8, 0x3f, 0xbb },
+  { 0xa2, 0xf2, 0x96, 0xea, 0x2d, 0x6d, 0x4b, 0x59, 0x97, 0x9b, 0xac, 0x5d, 0xfb, 0xf4, 0xed, 0xf0 },
+  { 0xa3, 0x02, 0xb9, 0x22, 0xa8, 0xdb, 0xec, 0x47, 0x74, 0x3f, 0x28, 0xb7, 0xf9, 0x1d, 0x4c, 0xd8 },
+  { 0xa3, 0x0e, 0xce, 0x6d, 0xc4, 0x78, 0x7e, 0x47, 0x4f, 0xbc, 0x40, 0x90, 0x51, 0x28, 0x38, 0xdc },
+  { 0xa3, 0x10, 0x49, 0x4a, 0xd5, 0xba, 0x2b, 0x5b, 0x22, 0x1a, 0x30, 0xd7, 0x18, 0x0a, 0x03, 0x36 },
+  { 0xa3, 0x36, 0xbe, 0xac, 0x1f, 0x0a, 0x83, 0x56, 0x14, 0x20, 0x0e, 0xcd, 0x9c, 0x41, 0xfd, 0x70 },
+  { 0xa3, 0x45, 0x60, 0x84, 0x1e, 0x08, 0x78, 0xc7, 0xb1, 0x4c, 0xc6, 0x5f, 0x79, 0xf6, 0x96, 0x7d },
+  { 0xa3, 0x48, 0x6c, 0x0b, 0x81, 0x10, 0xd9, 0xd4, 0xb1, 0xdb, 0x5d, 0x8a, 0x28, 0x07, 0x23, 0xc6 },
+  { 0xa3, 0x5d, 0x47, 0x89, 0x8b, 0x2b, 0x16, 0xec, 0x64, 0x1d, 0x1d, 0xfa, 0x8a, 0x45, 0xc2, 0xb7 },
+  { 0xa3, 0x87, 0x3d, 0x7c, 0x54, 0x4a, 0xf4, 0x59, 0xf4, 0x0d, 0x58, 0xdf, 0xcf, 0xb7, 0x88, 0x87 },
+  { 0xa3, 0xb9, 0xd2, 0xbe, 0x82, 0x2e, 0xab, 0x07, 0xe7, 0xf4, 0xb1, 0x05, 0x93, 0xfb, 0x5e, 0xaa },
+  { 0xa3, 0xc1, 0xc7, 0x00, 0x24, 0xd7, 0xaa, 0xbb, 0x41, 0x38, 0x1a, 0xdb, 0xfb, 0x6d, 0x3b, 0x25 },
+  { 0xa3, 0xd7, 0xc2, 0x99, 0xfb, 0xcd, 0x7b, 0x63, 0x78, 0x98, 0xee, 0x0f, 0xdc, 0xfc, 0x47, 0xfc },
+  { 0xa3, 0xf2, 0xa0, 0xfc, 0xf7, 0x4b, 0xbc, 0x5f, 0xa7, 0x63, 0xb0, 0xee, 0x97, 0x9b, 0x05, 0xb1 },
+  { 0xa3, 0xf8, 0xae, 0xbb, 0x38, 0x18, 0x27, 0x49, 0xcb, 0x8d, 0xa8, 0x5c, 0xfb, 0xc6, 0x3d, 0x7c },
+  { 0xa3, 0xfe, 0xe8, 0xce, 0x15, 0x52, 0x5e, 0xa0, 0x0d, 0x45, 0xa0, 0x6f, 0x04, 0xc2, 0x15, 0xd1 },
+  { 0xa4, 0x06, 0xd2, 0xf6, 0xd8, 0x4e, 0x61, 0xd8, 0x42, 0xf4, 0xcb, 0x13, 0xb2, 0xb1, 0xcf, 0xa7 },
+  { 0xa4, 0x12, 0xc8, 0x57, 0x7b, 0x2d, 0x57, 0xb0, 0x91, 0x85, 0xae, 0x51, 0x73, 0x9a, 0xc5, 0x4f },
+  { 0xa4, 0x14, 0x50, 0x33, 0x3f, 0x8d, 0xd0, 0xe9, 0x6e, 0x5e, 0x9f, 0x0a, 0xf3, 0x77, 0x0a, 0xe9 },
+  { 0xa4, 0x22, 0x19, 0x42, 0x90, 0xc6, 0x4e, 0xf9, 0xd4, 0x44, 0xda, 0x9d, 0x6a, 0x20, 0x78, 0x07 },
+  { 0xa4, 0x43, 0xd8, 0x55, 0x7d, 0x71, 0x28, 0x45, 0xc8, 0xcd, 0x36, 0x99, 0x36, 0x3a, 0x42, 0xe6 },
+  { 0xa4, 0x78, 0x78, 0xa7, 0x60, 0xf5, 0xfa, 0x3a, 0xa9, 0x9f, 0x95, 0xc3, 0xfd, 0xc7, 0x0a, 0x0b },
+  { 0xa4, 0x79, 0x02, 0x24, 0xbd, 0x5a, 0xfa, 0xbd, 0x53, 0xcb, 0xe9, 0x3e, 0x46, 0xa7, 0xf2, 0x41 },
+  { 0xa4, 0x7e, 0x26, 0x09, 0x6d, 0xe6, 0xf6, 0x48, 0x7b, 0xf5, 0xdd, 0x2d, 0x1c, 0xce, 0xd2, 0x94 },
+  { 0xa4, 0x99, 0xd7, 0x20, 0xe7, 0xee, 0x35, 0xc6, 0x24, 0x24, 0xde, 0x88, 0x2a, 0x33, 0x51, 0xb6 },
+  { 0xa4, 0xaa, 0x76, 0x30, 0xe4, 0xc0, 0xad, 0x7e, 0xbb, 0x98, 0x37, 0xd2, 0xd8, 0x1d, 0xe8, 0x01 },
+  { 0xa4, 0xab, 0x33, 0x1e, 0x87, 0x68, 0xea, 0xfd, 0xc2, 0x0c, 0xe8, 0xb0, 0x41, 0x1f, 0xf7, 0x7a },
+  { 0xa4, 0xb9, 0x42, 0x38, 0x77, 0xa0, 0xb8, 0x6c, 0xa3, 0x5b, 0x52, 0xca, 0x3c, 0x99, 0x4a, 0xc5 },
+  { 0xa4, 0xb9, 0x9a, 0xa5, 0xed, 0x85, 0xcf, 0xdb, 0x7d, 0x10, 0x19, 0x23, 0x14, 0x7d, 0xe0, 0x35 },
+  { 0xa4, 0xc0, 0x8c, 0x49, 0x94, 0xeb, 0x9d, 0x24, 0xfb, 0x78, 0xbe, 0x17, 0x93, 0xe8, 0x2e, 0x26 },
+  { 0xa4, 0xd0, 0x26, 0xa5, 0xc2, 0x00, 0xef, 0x98, 0x51, 0x8e, 0xbb, 0x77, 0x71, 0x9f, 0xe8, 0xdc },
+  { 0xa4, 0xe8, 0x85, 0x72, 0x6a, 0xf9, 0xd9, 0x7b, 0x12, 0xbb, 0x5a, 0x36, 0x79, 0x2e, 0xab, 0x63 },
+  { 0xa4, 0xec, 0xb5, 0x4f, 0x87, 0x7c, 0xd9, 0x45, 0x15, 0x52, 0x7b, 0x11, 0xe6, 0x98, 0x60, 0x8c },
+  { 0xa4, 0xf1, 0xce, 0xa2, 0xc8, 0x47, 0x92, 0x84, 0xe2, 0xa2, 0x29, 0x2f, 0x8d, 0x51, 0xb5, 0xfa },
+  { 0xa4, 0xff, 0x39, 0xd5, 0x13, 0xb9, 0x93, 0x15, 0x99, 0x11, 0xef, 0xe0, 0x1a, 0xc1, 0x2e, 0xba },
+  { 0xa5, 0x11, 0xf7, 0xee, 0x13, 0xe4, 0xb3, 0x55, 0x12, 0xf9, 0x21, 0x7a, 0x67, 0x7b, 0x40, 0x28 },
+  { 0xa5, 0x26, 0x2f, 0xe6, 0xd0, 0x1d, 0x6a, 0x12, 0x53, 0x69, 0x26, 0x82, 0xa4, 0x7f, 0x79, 0xdd },
+  { 0xa5, 0x37, 0x87, 0x9d, 0x8e, 0x82, 0xe1, 0x06, 0x1d, 0x3a, 0xd8, 0x00, 0x47, 0x9d, 0x3b, 0x84 },
+  { 0xa5, 0x39, 0xb9, 0xfd, 0x1b, 0xa5, 0x7e, 0x46, 0x44, 0x2b, 0x3e, 0x93, 0x51, 0xe6, 0x38, 0x3b },
+  { 0xa5, 0x6b, 0x64, 0x2a, 0x3d, 0x3a, 0xb9, 0xbb, 0xee, 0xe6, 0x3c, 0xd4, 0x4e, 0xb7, 0x32, 0x16 },
+  { 0xa5, 0x85, 0x5d, 0x73, 0xd3, 0x04, 0xd8, 0x3e, 0xf0, 0x7d, 0xde, 0x03, 0xe3, 0x79, 0x61, 0x9f },
+  { 0xa5, 0x8b, 0x11, 0x14, 0x8c, 0x18, 0xd8, 0x5e, 0x4c, 0x2a, 0xef, 0x4f, 0xf4, 0x6a, 0xde, 0x67 },
+  { 0xa5, 0x91, 0xb5, 0xe8, 0x58, 0x7a, 0xae, 0x0d, 0x98, 0x4a, 0x0f, 0x6f, 0xe2, 0xcc, 0x7d, 0x1c },
+  { 0xa5, 0xb7, 0xf4, 0x20, 0xca, 0x6c, 0xc1, 0x38, 0x4d, 0xa0, 0xfe, 0xd5, 0x23, 0x92, 0x0d, 0x8e },
+  { 0xa5, 0xc9, 0x6b, 0x04, 0x6d, 0x5f, 0x8b, 0x7c, 0x96, 0xda, 0xaa, 0x12, 0xf9, 0x25, 0xbe, 0xf8 },
+  { 0xa5, 0xe9, 0xed, 0x30, 0x33, 0xfb, 0x28, 0x36, 0xe8, 0x0a, 0xa7, 0xa4, 0x20, 0x37, 0x67, 0x88 },
+  { 0xa6, 0x05, 0x98, 0xad, 0x7e, 0xe9, 0xc5, 0xcc, 0xad, 0x42, 0xd5, 0xb0, 0xdf, 0x15, 0x70, 0xa1 },
+  { 0xa6, 0x12, 0x7f, 0x47, 0x03, 0x06, 0xee, 0xd3, 0x59, 0xd8, 0x5e, 0xb4, 0xa9, 0xcf, 0x3c, 0x96 },
+  { 0xa6, 0x2e, 0x3e, 0x19, 0x28, 0x0f, 0xf9, 0x58, 0x40, 0x7e, 0x05, 0xca, 0x0a, 0x2d, 0x5e, 0xc7 },
+  { 0xa6, 0x73, 0x7c, 0x81, 0x54, 0x2a, 0x99, 0xee, 0x71, 0xcb, 0x5f, 0x5f, 0xf1, 0x47, 0x03, 0xd9 },
+  { 0xa6, 0x9f, 0x5b, 0x17, 0x61, 0xa8, 0xa1, 0x1c, 0x98, 0xe7, 0x06, 0xec, 0x72, 0x04, 0x93, 0x7f },
+  { 0xa7, 0x46, 0x89, 0xa0, 0x87, 0x46, 0xa6, 0x67, 0xa2, 0x99, 0xb0, 0x50, 0x7e, 0x1e, 0x6d, 0xd9 },
+  { 0xa7, 0x52, 0x3d, 0xb9, 0xa3, 0x3e, 0x94, 0x17, 0x63, 0x7b, 0xe0, 0xe7, 0x1f, 0xa4, 0x37, 0x7c },
+  { 0xa7, 0x67, 0x38, 0x09, 0x06, 0x80, 0x62, 0x10, 0x6d, 0xb8, 0xe9, 0xd1, 0x0b, 0x56, 0xa5, 0xb3 },
+  { 0xa7, 0x79, 0xb9, 0xfa, 0x02, 0xc6, 0x2d, 0x00, 0xd7, 0xc3, 0x1e, 0xd5, 0x12, 0x68, 0xf1, 0x8a },
+  { 0xa7, 0xa5, 0x8e, 0x92, 0x91, 0xae, 0xfa, 0x10, 0x64, 0xe9, 0x33, 0x07, 0x1f, 0x60, 0xd4, 0xef },
+  { 0xa7, 0xb5, 0x84, 0x93, 0x79, 0x11, 0xd6, 0x0c, 0x12, 0x06, 0x77, 0xfe, 0x0d, 0x47, 0xf3, 0x6f },
+  { 0xa7, 0xb9, 0x6a, 0x81, 0x50, 0x60, 0x0b, 0x3e, 0x80, 0x0a, 0x46, 0x89, 0xc3, 0xec, 0x60, 0xa2 },
+  { 0xa7, 0xcf, 0x2b, 0x9a, 0xfd, 0xbb, 0x3a, 0x16, 0x1b, 0xf4, 0x18, 0xdb, 0xcf, 0x03, 0x21, 0xdc },
+  { 0xa7, 0xed, 0x7d, 0xc5, 0xcb, 0xc9, 0x01, 0x38, 0x8a, 0xfa, 0x59, 0x03, 0x0f, 0xb1, 0x1d, 0x26 },
+  { 0xa7, 0xef, 0x44, 0xcc, 0xb5, 0xb9, 0x00, 0x0c, 0xaf, 0x02, 0xdf, 0x3e, 0x6d, 0xa7, 0x1a, 0x92 },
+  { 0xa8, 0x10, 0x1c, 0xb6, 0x67, 0xe5, 0x0a, 0x46, 0x16, 0x5c, 0x6f, 0xb4, 0x8c, 0x60, 0x8b, 0x6b },
+  { 0xa8, 0x16, 0x97, 0xb0, 0xc8, 0xbb, 0xc3, 0x38, 0xae, 0x4d, 0x00, 0x46, 0xed, 0xe0, 0x64, 0x6b },
+  { 0xa8, 0x1b, 0x29, 0x17, 0x7f, 0x25, 0x84, 0x94, 0xb4, 0x99, 0xfb, 0xac, 0x69, 0x78, 0x9c, 0xef },
+  { 0xa8, 0x3b, 0x07, 0x0b, 0x48, 0x5c, 0xf1, 0xfb, 0x4d, 0x5a, 0x48, 0xda, 0x15, 0x3f, 0xdf, 0x1a },
+  { 0xa8, 0x43, 0x5e, 0xc5, 0x70, 0x14, 0x1d, 0xe5, 0xd8, 0x33, 0xc4, 0xab, 0xec, 0x49, 0x9e, 0x55 },
+  { 0xa8, 0x63, 0x30, 0x50, 0xa6, 0x86, 0x27, 0x0f, 0xcf, 0x6c, 0x0c, 0xc4, 0xdc, 0xba, 0xd6, 0x30 },
+  { 0xa8, 0x67, 0xb7, 0x60, 0x98, 0x78, 0x6c, 0x40, 0x91, 0xdb, 0xa2, 0xfc, 0xee, 0x50, 0x84, 0xc3 },
+  { 0xa8, 0x75, 0xf0, 0xa9, 0x19, 0x12, 0x9b, 0x4f, 0x1b, 0x51, 0x03, 0xdd, 0xd2, 0x00, 0xd2, 0xfe },
+  { 0xa8, 0x91, 0x67, 0x34, 0xff, 0x8c, 0x64, 0xec, 0x33, 0x42, 0xf4, 0xc7, 0x3f, 0xd5, 0xb5, 0x7d },
+  { 0xa8, 0x9a, 0x3e, 0x05, 0x47, 0xd6, 0x88, 0x72, 0x79, 0xc3, 0x4a, 0xba, 0x4b, 0x17, 0xa5, 0x60 },
+  { 0xa8, 0xa7, 0x03, 0xe0, 0x73, 0x18, 0x3a, 0x89, 0xc9, 0x4d, 0x4d, 0x99, 0xb9, 0x66, 0x1b, 0x7f },
+  { 0xa8, 0xb3, 0xea, 0x68, 0x36, 0xb9, 0x9b, 0xea, 0x77, 0xc8, 0xf6, 0x03, 0xcf, 0x1e, 0xa1, 0x87 },
+  { 0xa8, 0xc4, 0x8b, 0x4e, 0x0b, 0xf3, 0x5f, 0xe9, 0x7c, 0xc8, 0x4f, 0xdd, 0x2c, 0x50, 0x7f, 0x78 },
+  { 0xa8, 0xd0, 0xa4, 0xa7, 0x7c, 0xd7, 0x1a, 0xc6, 0x01, 0xbd, 0x71, 0xdf, 0x5a, 0x06, 0x0e, 0x4c },
+  { 0xa8, 0xd4, 0xa9, 0x50, 0x0b, 0x18, 0xb0, 0xa0, 0x67, 0xa1, 0xf2, 0x72, 0xf8, 0x69, 0xe0, 0x94 },
+  { 0xa8, 0xe4, 0x9d, 0x7e, 0x24, 0xce, 0x29, 0x36, 0x29, 0xca, 0x29, 0x61, 0x48, 0x62, 0x82, 0x1b },
+  { 0xa9, 0x1d, 0x08, 0x58, 0xa5, 0x2d, 0xe3, 0xa2, 0xe6, 0x46, 0x84, 0x37, 0x21, 0x2d, 0x93, 0xe8 },
+  { 0xa9, 0x36, 0xd8, 0x00, 0x83, 0xe9, 0x9d, 0x48, 0x75, 0x2a, 0xd1, 0x5c, 0x2b, 0x5f, 0x7c, 0x96 },
+  { 0xa9, 0x3e, 0x8e, 0xa1, 0xf5, 0x65, 0xc3, 0xc1, 0xe8, 0x6b, 0x70, 0x8c, 0xf0, 0xdc, 0x2f, 0xa9 },
+  { 0xa9, 0x45, 0x28, 0xae, 0x05, 0xdd, 0x05, 0x18, 0x94, 0xe9, 0x45, 0xd4, 0xd2, 0x34, 0x9b, 0x3b },
+  { 0xa9, 0x4b, 0x8c, 0xa6, 0x30, 0xf4, 0x67, 0xb5, 0x74, 0xb6, 0x14, 0x80, 0x8d, 0x81, 0x39, 0x19 },
+  { 0xa9, 0x53, 0x1c, 0x76, 0x30, 0x77, 0x46, 0x43, 0x07, 0x08, 0x6e, 0xc9, 0xa1, 0xfd, 0x05, 0x7d },
+  { 0xa9, 0x57, 0xdb, 0xe7, 0xd8, 0x5e, 0xa8, 0x91, 0x33, 0x34, 0x6a, 0xd5, 0x6f, 0xbd, 0xa0, 0x3f },
+  { 0xa9, 0x77, 0x33, 0xb0, 0x85, 0x2e, 0xe3, 0x09, 0x63, 0x00, 0x10, 0x2c, 0xb0, 0x68, 0x91, 0x75 },
+  { 0xa9, 0x78, 0x4c, 0x24, 0xcd, 0xdb, 0x33, 0xbd, 0x0d, 0x14, 0x44, 0x2b, 0x97, 0x78, 0x4f, 0x3d },
+  { 0xa9, 0x8b, 0x64, 0x99, 0x12, 0xb6, 0xca, 0x19, 0xea, 0xf5, 0xc2, 0xd2, 0xfa, 0xf3, 0x85, 0x62 },
+  { 0xa9, 0x95, 0xb6, 0xcb, 0xdb, 0x1f, 0x04, 0x33, 0xab, 0xc7, 0x40, 0x50, 0x80, 0x85, 0x90, 0xe6 },
+  { 0xa9, 0xcb, 0x63, 0x8c, 0xd2, 0xcb, 0x2e, 0x8e, 0x06, 0x43, 0xd7, 0xa6, 0x7d, 0xb4, 0x28, 0x1c },
+  { 0xa9, 0xd9, 0xe1, 0x9d, 0x0c, 0x89, 0xfb, 0x31, 0x78, 0x0b, 0x5d, 0x63, 0xe1, 0xf8, 0xc6, 0xa4 },
+  { 0xa9, 0xe3, 0xc2, 0x35, 0x99, 0xc0, 0xd7, 0x71, 0x51, 0x60, 0x2f, 0x8e, 0x31, 0xda, 0xf8, 0x79 },
+  { 0xaa, 0x1c, 0x41, 0xf8, 0x6e, 0xc4, 0x4c, 0x0a, 0x44, 0xeb, 0x64, 0xc3, 0x32, 0xce, 0x08, 0xaf },
+  { 0xaa, 0x2c, 0x4b, 0x32, 0x65, 0x6b, 0xde, 0x9a, 0x75, 0x04, 0x2a, 0x4d, 0x15, 0x85, 0x83, 0xe1 },
+  { 0xaa, 0x5c, 0xfe, 0x3b, 0x20, 0x39, 0x5a, 0xba, 0x1d, 0x47, 0x91, 0x35, 0x94, 0x3a, 0xd8, 0x5c },
+  { 0xaa, 0x7b, 0xb5, 0x4d, 0x2c, 0x18, 0x9a, 0x31, 0xbb, 0x1f, 0xa2, 0x00, 0x99, 0xe4, 0x28, 0x59 },
+  { 0xaa, 0x8e, 0x4b, 0x2c, 0xb8, 0xa7, 0x8f, 0xfe, 0x6b, 0x20, 0x58, 0x00, 0x33, 0xf4, 0xde, 0xc9 },
+  { 0xaa, 0xac, 0x0d, 0x27, 0x7e, 0xda, 0x05, 0x48, 0x61, 0xe6, 0x13, 0xc5, 0x9c, 0x2e, 0x4f, 0xf2 },
+  { 0xaa, 0xb8, 0x40, 0xdb, 0x22, 0x07, 0x5a, 0xa0, 0xf6, 0xa6, 0xb8, 0x3a, 0x59, 0x7f, 0x88, 0x90 },
+  { 0xaa, 0xd6, 0x18, 0x98, 0x63, 0x3f, 0x47, 0x0c, 0xe5, 0x28, 0xe3, 0xd7, 0xef, 0x3d, 0x0a, 0xdb },
+  { 0xaa, 0xd9, 0x1b, 0xe0, 0xbf, 0x78, 0xd3, 0x3d, 0x29, 0x75, 0x88, 0x76, 0xd9, 0x99, 0x84, 0x8a },
+  { 0xaa, 0xea, 0x37, 0xb6, 0x5d, 0xb9, 0xe4, 0x92, 0x79, 0x8f, 0x01, 0x05, 0xa6, 0x91, 0x5e, 0x96 },
+  { 0xaa, 0xfc, 0x79, 0xff, 0xc3, 0x2c, 0x4c, 0x9b, 0x2d, 0x73, 0xc8, 0xad, 0xa7, 0x60, 0x2c, 0xfe },
+  { 0xab, 0x10, 0xf2, 0x97, 0x4d, 0xee, 0x73, 0xda, 0xb4, 0x57, 0x9f, 0x0c, 0xab, 0x35, 0xfc, 0xa6 },
+  { 0xab, 0x2c, 0xfc, 0xaa, 0xd3, 0xda, 0xaf, 0x67, 0x3b, 0x2b, 0x14, 0xfd, 0xbb, 0x8d, 0xac, 0x33 },
+  { 0xab, 0x2e, 0xa3, 0x5d, 0xcc, 0x10, 0x98, 0xc8, 0x74, 0x55, 0xbb, 0x82, 0x10, 0xb0, 0x18, 0xcf },
+  { 0xab, 0x30, 0x1d, 0x3d, 0x7f, 0x2f, 0x4f, 0xe3, 0xfd, 0xd8, 0xa3, 0x54, 0x0b, 0x7a, 0x74, 0xf5 },
+  { 0xab, 0x43, 0x4f, 0x4c, 0x94, 0x2d, 0x64, 0x72, 0xe7, 0x5d, 0x54, 0x90, 0xcc, 0x4d, 0xd1, 0x28 },
+  { 0xab, 0x4a, 0xc9, 0x94, 0x86, 0x5f, 0xb1, 0x6e, 0xbb, 0x85, 0x73, 0x83, 0x16, 0x30, 0x94, 0x57 },
+  { 0xab, 0x56, 0xf1, 0xb2, 0x54, 0x2a, 0x05, 0xbe, 0xbc, 0x4f, 0xbc, 0xcf, 0xc4, 0x80, 0x3a, 0x38 },
+  { 0xab, 0x5b, 0xf1, 0xef, 0x5e, 0x46, 0x3a, 0xd1, 0xcb, 0xb1, 0x1b, 0x6a, 0x33, 0x79, 0x72, 0x28 },
+  { 0xab, 0x60, 0xea, 0x7b, 0x70, 0x7c, 0x58, 0xd3, 0x56, 0xca, 0xd8, 0x58, 0xeb, 0x18, 0xdb, 0x43 },
+  { 0xab, 0x8d, 0x31, 0x8d, 0xa4, 0xad, 0xdd, 0x39, 0xc6, 0x5b, 0x7f, 0x9c, 0x40, 0x8d, 0xf2, 0xa6 },
+  { 0xab, 0xb7, 0x40, 0xbe, 0xa0, 0xa6, 0x84, 0x28, 0x31, 0xb4, 0xf5, 0x31, 0x12, 0xfb, 0x81, 0x45 },
+  { 0xab, 0xb7, 0x41, 0xc8, 0x3f, 0x66, 0x5d, 0x73, 0xc8, 0x6d, 0x90, 0xa7, 0xd9, 0x29, 0x2a, 0x9b },
+  { 0xab, 0xc6, 0x40, 0x37, 0xca, 0x5d, 0x5b, 0x04, 0xae, 0x8a, 0x7e, 0xed, 0xbc, 0xa3, 0xed, 0x74 },
+  { 0xab, 0xe4, 0x05, 0x42, 0xe4, 0xff, 0x2d, 0x1c, 0x51, 0xaa, 0x2b, 0xb0, 0x33, 0xf0, 0x99, 0x84 },
+  { 0xac, 0x05, 0xc0, 0xe5, 0x3a, 0x5e, 0x70, 0x09, 0xdd, 0xd7, 0x5e, 0xd4, 0xb9, 0x99, 0x49, 0xfc },
+  { 0xac, 0x0d, 0xdb, 0xcf, 0xf3, 0x4d, 0x06, 0x40, 0x09, 0x59, 0x16, 0x07, 0x74, 0x6e, 0x33, 0xb8 },
+  { 0xac, 0x26, 0xd7, 0xd3, 0x72, 0x48, 0xd1, 0xd8, 0xea, 0xc5, 0xec, 0xca, 0xcd, 0xbe, 0xf8, 0xdb },
+  { 0xac, 0x3d, 0xd2, 0x2d, 0xd9, 0x45, 0x72, 0x4b, 0xe7, 0x05, 0xdd, 0xd2, 0x78, 0x54, 0x87, 0xc2 },
+  { 0xac, 0x53, 0xb8, 0x3e, 0x1b, 0x57, 0xa6, 0x01, 0xee, 0xae, 0x9d, 0x3c, 0xe1, 0xb4, 0xa4, 0x58 },
+  { 0xac, 0x5f, 0x78, 0xba, 0xe0, 0x63, 0x8c, 0xf3, 0xf2, 0xa0, 0xc8, 0xd0, 0x7e, 0xb4, 0xdf, 0x69 },
+  { 0xac, 0x7c, 0x22, 0x60, 0x37, 0x89, 0x75, 0x61, 0x41, 0x92, 0xca, 0x2b, 0xc3, 0xd2, 0x0e, 0x0b },
+  { 0xac, 0x9a, 0xdb, 0xd6, 0xde, 0x78, 0x6a, 0x24, 0x2e, 0x19, 0xd4, 0xbe, 0xc5, 0x27, 0x98, 0x2b },
+  { 0xac, 0xa0, 0x9f, 0xfe, 0xa7, 0x71, 0x74, 0xb1, 0x48, 0xb9, 0x6b, 0x20, 0x51, 0x09, 0xdb, 0x4d },
+  { 0xac, 0xaa, 0x27, 0xd2, 0x14, 0x03, 0x9d, 0x89, 0xd7, 0x03, 0x16, 0x09, 0xaa, 0xfa, 0x55, 0xc3 },
+  { 0xac, 0xb6, 0x78, 0x7b, 0x93, 0x80, 0x79, 0xf4, 0xe7, 0x43, 0x13, 0xa9, 0x05, 0xec, 0x3c, 0xeb },
+  { 0xac, 0xb7, 0x75, 0x0b, 0x4d, 0x0c, 0x4b, 0xd3, 0x49, 0x69, 0x80, 0x2a, 0x7d, 0xeb, 0x29, 0x90 },
+  { 0xac, 0xb9, 0x62, 0x47, 0x31, 0x85, 0xd7, 0xa6, 0x52, 0xf9, 0x0e, 0xd6, 0x59, 0x1a, 0xe1, 0x3b },
+  { 0xac, 0xe3, 0x19, 0xdc, 0x4f, 0x76, 0x54, 0x86, 0x59, 0x87, 0x67, 0x41, 0xa6, 0x69, 0x0d, 0x57 },
+  { 0xad, 0x2e, 0x6b, 0xfb, 0x3b, 0x9b, 0x9b, 0x36, 0xba, 0x8b, 0xf4, 0x93, 0xce, 0x76, 0x4c, 0x49 },
+  { 0xad, 0x42, 0xe3, 0xca, 0x31, 0x44, 0xe2, 0x15, 0x9e, 0x26, 0xbe, 0x12, 0x34, 0x71, 0xbf, 0xfc },
+  { 0xad, 0x7e, 0x97, 0xc1, 0x9b, 0xd2, 0x5d, 0x5a, 0xa3, 0x99, 0x94, 0x30, 0x84, 0x5c, 0x75, 0x5b },
+  { 0xad, 0x80, 0x72, 0x67, 0x51, 0x09, 0xd1, 0x3f, 0xdd, 0x31, 0xa2, 0xe0, 0x40, 0x3d, 0x5c, 0xff },
+  { 0xad, 0xb7, 0x70, 0xff, 0x70, 0xe9, 0xad, 0xf0, 0x8b, 0xbb, 0x90, 0x7a, 0x7e, 0xcc, 0xd2, 0x40 },
+  { 0xad, 0xb7, 0x9f, 0x9a, 0xc1, 0xa6, 0x33, 0xcd, 0xd4, 0x49, 0x54, 0xe2, 0xea, 0xc1, 0x47, 0x74 },
+  { 0xad, 0xf1, 0xaf, 0xac, 0x3b, 0xdd, 0x7b, 0x36, 0xd2, 0xed, 0xa5, 0x94, 0x9f, 0x1a, 0x0f, 0xa3 },
+  { 0xad, 0xfb, 0xd2, 0xe8, 0xa3, 0x8f, 0x96, 0xe0, 0x37, 0x51, 0x71, 0x7f, 0x74, 0x22, 0x85, 0x1d },
+  { 0xae, 0x04, 0x7e, 0x94, 0x68, 0xbd, 0xa9, 0x61, 0xd8, 0xe9, 0xe9, 0xd8, 0xff, 0x52, 0x98, 0x0f },
+  { 0xae, 0x0d, 0x4f, 0x33, 0x96, 0xcb, 0x49, 0xde, 0x0f, 0xab, 0xdf, 0xf0, 0x3c, 0xb2, 0x75, 0x6f },
+  { 0xae, 0x10, 0x52, 0x78, 0x40, 0xa1, 0xac, 0x24, 0xde, 0x43, 0x73, 0x06, 0x45, 0xed, 0x50, 0x8d },
+  { 0xae, 0x18, 0xc1, 0x1e, 0x4d, 0x7e, 0xd2, 0x43, 0x7f, 0x0b, 0xf5, 0xd1, 0x67, 0xc0, 0xe9, 0x6c },
+  { 0xae, 0x2f, 0x1f, 0x69, 0xbb, 0x38, 0x35, 0x53, 0x95, 0xc1, 0xc7, 0x5c, 0x81, 0xac, 0xc6, 0x44 },
+  { 0xae, 0x46, 0x50, 0x44, 0xdf, 0xba, 0x28, 0x7d, 0x34, 0x4b, 0xa4, 0x68, 0x82, 0x09, 0x95, 0xd7 },
+  { 0xae, 0x4b, 0xe3, 0xa3, 0x6b, 0x28, 0x5c, 0x1a, 0x1d, 0xff, 0x20, 0x21, 0x57, 0xe2, 0x15, 0x5d },
+  { 0xae, 0x68, 0x28, 0x86, 0x05, 0x8c, 0xd6, 0x98, 0x1c, 0x4b, 0x8e, 0x93, 0xe7, 0xb0, 0x19, 0xcf },
+  { 0xae, 0x6c, 0xb3, 0x35, 0x47, 0x07, 0x88, 0xb9, 0x4b, 0xeb, 0x57, 0x87, 0x97, 0x6e, 0x88, 0x18 },
+  { 0xae, 0x83, 0x54, 0x1c, 0xf4, 0xa4, 0xc0, 0xbc, 0xe0, 0xad, 0xcc, 0xd2, 0xc1, 0xbf, 0x62, 0x88 },
+  { 0xae, 0x97, 0xcf, 0x8e, 0xd2, 0x1f, 0x41, 0x54, 0xb4, 0x36, 0x0a, 0x3c, 0xf6, 0xc9, 0x5c, 0x5e },
+  { 0xae, 0xb1, 0x04, 0xf1, 0xe7, 0xb1, 0x66, 0xbc, 0x0c, 0xba, 0xca, 0x0a, 0x96, 0x8f, 0xde, 0x51 },
+  { 0xae, 0xc9, 0xb8, 0x85, 0xd0, 0xe8, 0xb2, 0x4e, 0x87, 0x19, 0x25, 0x63, 0x08, 0x84, 0x09, 0x5c },
+  { 0xae, 0xd0, 0xb7, 0xbd, 0x64, 0xcc, 0x38, 0x4f, 0x85, 0xfd, 0xea, 0x33, 0xe2, 0x8d, 0xaf, 0x3b },
+  { 0xae, 0xd8, 0x20, 0x52, 0xf7, 0x58, 0x9d, 0xf0, 0x5a, 0x3f, 0x41, 0x7b, 0xb4, 0xe4, 0x5f, 0x0c },
+  { 0xaf, 0x6a, 0xb8, 0x8d, 0x3d, 0x7c, 0x74, 0x17, 0xdb, 0x2b, 0x3b, 0x3c, 0x70, 0xb0, 0xda, 0x0a },
+  { 0xaf, 0x6f, 0x3e, 0x97, 0x18, 0xbc, 0xcf, 0xcd, 0x8a, 0xfb, 0x42, 0x1f, 0x96, 0x56, 0x1a, 0x34 },
+  { 0xaf, 0xb3, 0xbc, 0x45, 0xc6, 0xa8, 0x27, 0x39, 0xcc, 0x82, 0x58, 0x21, 0x27, 0xcd, 0x96, 0xe6 },
+  { 0xaf, 0xc1, 0x94, 0x53, 0x4c, 0x1b, 0x34, 0x66, 0x09, 0xef, 0x05, 0xef, 0xf6, 0xd3, 0xce, 0xf6 },
+  { 0xaf, 0xd2, 0xcf, 0x25, 0x8d, 0x51, 0xae, 0x49, 0x65, 0xee, 0x21, 0xab, 0xba, 0x36, 0x27, 0xab },
+  { 0xaf, 0xe4, 0xee, 0xfc, 0x7d, 0x88, 0x5c, 0x27, 0x7f, 0xc0, 0x64, 0x95, 0x07, 0xfb, 0xcd, 0x84 },
+  { 0xaf, 0xe7, 0x76, 0xdb, 0x50, 0xe3, 0x37, 0x8c, 0xd6, 0xf2, 0x9c, 0x7c, 0xdd, 0x79, 0x10, 0x4a },
+  { 0xaf, 0xe8, 0x8a, 0xae, 0x81, 0xd9, 0x9e, 0x09, 0x47, 0xc0, 0xcf, 0xb6, 0x87, 0xb1, 0x62, 0x51 },
+  { 0xaf, 0xf8, 0xcb, 0xa0, 0xf2, 0xd2, 0xeb, 0x23, 0x99, 0x53, 0xdd, 0x71, 0x16, 0x89, 0x4a, 0x08 },
+  { 0xb0, 0x00, 0x88, 0x41, 0x8f, 0xc8, 0x91, 0xf3, 0xfa, 0xa3, 0xd4, 0xdd, 0xde, 0x6a, 0xce, 0x94 },
+  { 0xb0, 0x0a, 0x8b, 0xc9, 0xd7, 0xfe, 0x70, 0x80, 0x98, 0x0a, 0x51, 0x40, 0x05, 0xcb, 0xad, 0x13 },
+  { 0xb0, 0x0e, 0x82, 0x17, 0x63, 0x3e, 0x87, 0x0b, 0xf3, 0x9d, 0x94, 0x86, 0x62, 0xa5, 0x2a, 0xac },
+  { 0xb0, 0x49, 0xfc, 0x8a, 0xc5, 0x0b, 0xe7, 0xc2, 0xf2, 0x84, 0x18, 0x81, 0x79, 0x79, 0xc6, 0x37 },
+  { 0xb0, 0x60, 0x50, 0xf6, 0x86, 0xc6, 0xb8, 0x57, 0xd0, 0xdf, 0x1b, 0x79, 0xfe, 0xa4, 0x7b, 0xb4 },
+  { 0xb0, 0x61, 0xe9, 0x8a, 0x4c, 0x85, 0x4a, 0x67, 0x2a, 0xad, 0xef, 0xa2, 0x33, 0x23, 0x6e, 0x51 },
+  { 0xb0, 0x95, 0x00, 0x90, 0x04, 0xdf, 0x34, 0x13, 0x86, 0xd2, 0x2b, 0x2a, 0x3f, 0xae, 0x3c, 0x81 },
+  { 0xb0, 0x9b, 0x79, 0xc9, 0x62, 0x88, 0x78, 0xbe, 0x05, 0x1e, 0x89, 0xf7, 0xf1, 0xe7, 0x73, 0x78 },
+  { 0xb0, 0xba, 0x51, 0x72, 0x3b, 0x93, 0x30, 0x79, 0x79, 0x85, 0x80, 0x8d, 0xb5, 0x98, 0xfc, 0x31 },
+  { 0xb0, 0xc4, 0x7e, 0x42, 0x6c, 0x7f, 0x79, 0x9a, 0xee, 0x2c, 0x40, 0x42, 0x2d, 0xf8, 0xf5, 0x6a },
+  { 0xb0, 0xc9, 0xcf, 0x89, 0xa6, 0xd4, 0xe6, 0x12, 0x52, 0x4f, 0x4f, 0xd4, 0x8b, 0x5b, 0xb5, 0x62 },
+  { 0xb0, 0xe1, 0xee, 0x07, 0xfb, 0xc7, 0x34, 0x93, 0xea, 0xc5, 0x65, 0x1a, 0x52, 0xf9, 0x0f, 0x00 },
+  { 0xb1, 0x2a, 0x7f, 0x63, 0x78, 0x7a, 0x6b, 0xb0, 0x8e, 0x68, 0x38, 0x37, 0xa8, 0xed, 0x3f, 0x18 },
+  { 0xb1, 0x33, 0x9c, 0x56, 0xa9, 0xea, 0x63, 0x12, 0x22, 0x32, 0xfe, 0x43, 0x28, 0x37, 0x3a, 0xc5 },
+  { 0xb1, 0x48, 0x6e, 0x12, 0xde, 0x71, 0x70, 0x13, 0x37, 0x64, 0x47, 0xac, 0x6f, 0x7f, 0x3a, 0x80 },
+  { 0xb1, 0x50, 0x26, 0xb4, 0x3c, 0x67, 0x58, 0x60, 0x96, 0x67, 0x46, 0x84, 0x34, 0x76, 0x6d, 0xd8 },
+  { 0xb1, 0x6c, 0xd9, 0x78, 0x45, 0x89, 0x21, 0x93, 0x91, 0xc8, 0x39, 0xcb, 0x68, 0xc4, 0x7b, 0x9c },
+  { 0xb1, 0x7b, 0x9c, 0xc4, 0x10, 0x38, 0x44, 0xdc, 0xda, 0x54, 0xf7, 0x7f, 0x44, 0xac, 0xc9, 0x3a },
+  { 0xb1, 0xa6, 0xc9, 0x6e, 0x90, 0x93, 0x35, 0x21, 0x06, 0xbc, 0x33, 0x5e, 0x96, 0xca, 0xa1, 0x54 },
+  { 0xb1, 0xb2, 0x05, 0x36, 0xae, 0xf4, 0xee, 0xd9, 0xc7, 0x9d, 0xc5, 0x80, 0x4f, 0x07, 0x78, 0x62 },
+  { 0xb1, 0xc1, 0x4b, 0x5a, 0xc8, 0x96, 0x40, 0x0c, 0xc9, 0x1c, 0x8e, 0x5d, 0xd6, 0x7a, 0xcb, 0x59 },
+  { 0xb1, 0xd1, 0xe0, 0x83, 0xdc, 0x9e, 0x7d, 0x9a, 0x5d, 0xc1, 0x62, 0x78, 0x69, 0xd2, 0xad, 0xe7 },
+  { 0xb1, 0xe2, 0xd5, 0xdc, 0x13, 0x53, 0xaf, 0x6d, 0x56, 0xcd, 0x2f, 0xe7, 0xcf, 0xe7, 0x52, 0x54 },
+  { 0xb1, 0xfd, 0x0b, 0x71, 0xde, 0x9f, 0x6e, 0xeb, 0x51, 0x43, 0xa9, 0x79, 0x63, 0x67, 0x4c, 0xb6 },
+  { 0xb2, 0x27, 0x17, 0x56, 0x99, 0xe3, 0x72, 0xb8, 0xfe, 0x10, 0xce, 0x24, 0x3a, 0xd6, 0xdd, 0xa5 },
+  { 0xb2, 0x3e, 0xbf, 0x42, 0x77, 0x13, 0xdd, 0x01, 0x98, 0xb7, 0xef, 0x47, 0xdb, 0xd0, 0x7e, 0xf4 },
+  { 0xb2, 0x4f, 0x6a, 0x58, 0x20, 0xa4, 0xb7, 0x76, 0x3a, 0x3d, 0x54, 0x7e, 0x3e, 0x07, 0x44, 0x1d },
+  { 0xb2, 0x65, 0x06, 0xfb, 0xf4, 0x11, 0x00, 0x9e, 0x5e, 0x3f, 0x73, 0x65, 0xf4, 0x42, 0x96, 0x0e },
+  { 0xb2, 0x73, 0x70, 0x34, 0xf9, 0x74, 0x53, 0x5f, 0x5c, 0x0c, 0x64, 0x31, 0xab, 0x8c, 0xaf, 0x73 },
+  { 0xb2, 0x76, 0x1e, 0xfb, 0x8a, 0x11, 0xfc, 0x59, 0xb0, 0x0a, 0x3b, 0x9d, 0x78, 0x02, 0x2a, 0xd6 },
+  { 0xb2, 0x90, 0xc2, 0xb1, 0x39, 0x34, 0x4f, 0xcf, 0xf5, 0xb3, 0x12, 0xc7, 0x1b, 0x9a, 0xc3, 0xb2 },
+  { 0xb2, 0x93, 0x59, 0xf7, 0xde, 0x62, 0xfe, 0xd6, 0xe6, 0xad, 0x4c, 0x94, 0x8f, 0x69, 0x9d, 0xf8 },
+  { 0xb2, 0xa6, 0xf3, 0x16, 0x36, 0xb6, 0x99, 0xae, 0xda, 0x90, 0x0f, 0x07, 0x15, 0x2b, 0xab, 0x6e },
+  { 0xb2, 0xd1, 0xe6, 0x3f, 0x7f, 0x22, 0x86, 0x40, 0x96, 0xb7, 0xb6, 0xc1, 0x54, 0x15, 0x1d, 0x55 },
+  { 0xb2, 0xd3, 0xbc, 0xee, 0x00, 0x1c, 0xff, 0x2b, 0xd2, 0xd8, 0xa2, 0x1b, 0x2c, 0xb5, 0x51, 0x09 },
+  { 0xb2, 0xd5, 0xd2, 0x00, 0xf0, 0xaf, 0x84, 0x85, 0x41, 0x3f, 0xad, 0x95, 0x78, 0x28, 0x58, 0x2a },
+  { 0xb2, 0xf0, 0xd7, 0x21, 0x71, 0x47, 0x16, 0x0b, 0x2f, 0x48, 0x19, 0x54, 0xce, 0xdf, 0x81, 0x4b },
+  { 0xb3, 0x01, 0x7e, 0x39, 0x7f, 0x74, 0xef, 0xd5, 0x3c, 0xaf, 0x8f, 0xae, 0x0a, 0x38, 0xe3, 0xfe },
+  { 0xb3, 0x11, 0xab, 0x95, 0xe8, 0x5b, 0xc0, 0x16, 0x23, 0x08, 0x39, 0x07, 0x28, 0xa7, 0x36, 0x1d },
+  { 0xb3, 0x1d, 0xc9, 0x89, 0xf5, 0x94, 0x76, 0x4e, 0xac, 0xfa, 0x79, 0x31, 0xce, 0xad, 0x00, 0x50 },
+  { 0xb3, 0x1f, 0x17, 0x8a, 0xa0, 0xd5, 0x69, 0xcc, 0xca, 0xc7, 0x95, 0x9f, 0x84, 0xe0, 0xa7, 0x24 },
+  { 0xb3, 0x20, 0x3e, 0x38, 0x3b, 0x43, 0x5f, 0x7e, 0x43, 0xf9, 0x49, 0x28, 0x93, 0xc7, 0x46, 0x9f },
+  { 0xb3, 0x60, 0x40, 0xa2, 0xf9, 0xec, 0xaf, 0xa7, 0x3d, 0x83, 0x5d, 0x80, 0x4a, 0x57, 0x2d, 0xbf },
+  { 0xb3, 0x7f, 0x0f, 0xe8, 0x22, 0xb9, 0x2c, 0xa8, 0xf5, 0xe3, 0x30, 0xbf, 0x62, 0xd5, 0x6e, 0xa9 },
+  { 0xb3, 0x92, 0x96, 0x4e, 0x8b, 0x1c, 0x9c, 0x2b, 0xed, 0x12, 0x24, 0x6f, 0x22, 0x80, 0x11, 0xb2 },
+  { 0xb4, 0x03, 0x0c, 0x38, 0xa7, 0x20, 0xdd, 0x84, 0xb8, 0x41, 0x78, 0xb6, 0xce, 0x1f, 0xc7, 0x49 },
+  { 0xb4, 0x0d, 0xea, 0x35, 0x7d, 0x41, 0xc5, 0x40, 0x85, 0x46, 0xe4, 0xe4, 0xd5, 0xf2, 0x77, 0x79 },
+  { 0xb4, 0x1f, 0xdd, 0x4a, 0x52, 0x2e, 0x1d, 0x5a, 0x27, 0x21, 0x84, 0x00, 0x28, 0x68, 0x4a, 0xc2 },
+  { 0xb4, 0x2d, 0xf8, 0xd9, 0x2e, 0x31, 0x18, 0xdc, 0x59, 0x4c, 0xec, 0xd5, 0x75, 0xf5, 0x15, 0xd7 },
+  { 0xb4, 0x38, 0xa6, 0xaa, 0x9d, 0x4b, 0x9b, 0x8f, 0x0b, 0x2d, 0xdb, 0x51, 0x32, 0x3b, 0x21, 0xe4 },
+  { 0xb4, 0x51, 0x30, 0x7b, 0x8b, 0x5e, 0x29, 0xf1, 0xc5, 0xf2, 0xcf, 0x06, 0x4f, 0x6c, 0x72, 0x27 },
+  { 0xb4, 0x93, 0x31, 0xb2, 0x37, 0xc8, 0xf1, 0x1d, 0x5f, 0x36, 0xfe, 0x20, 0x54, 0xa7, 0xb9, 0x2b },
+  { 0xb4, 0xa4, 0xc8, 0x78, 0x40, 0x61, 0x3f, 0x10, 0x2a, 0xcb, 0x5b, 0x3a, 0x64, 0x7d, 0x0a, 0x67 },
+  { 0xb4, 0xda, 0xed, 0xb4, 0x35, 0x11, 0x52, 0x1d, 0xb9, 0x03, 0x6d, 0x50, 0x3b, 0x3c, 0x1b, 0x69 },
+  { 0xb4, 0xe2, 0xfd, 0x27, 0xd3, 0x18, 0x0f, 0x0f, 0x4e, 0xb1, 0x06, 0x5a, 0xfc, 0x0d, 0x7f, 0xc9 },
+  { 0xb4, 0xf0, 0x5e, 0x54, 0x48, 0x34, 0xd0, 0x23, 0x8a, 0x0c, 0x26, 0x34, 0x91, 0x77, 0x5e, 0xdf },
+  { 0xb4, 0xf3, 0x1e, 0xa8, 0xa6, 0xcc, 0x9f, 0x1f, 0xd4, 0xd5, 0x58, 0x5a, 0x87, 0xc3, 0xb4, 0x87 },
+  { 0xb4, 0xf8, 0x7c, 0xe7, 0x5f, 0x73, 0x29, 0xc1, 0x83, 0x01, 0xa2, 0x50, 0x5f, 0xe5, 0x9c, 0xd3 },
+  { 0xb5, 0x0a, 0xe5, 0x5a, 0xac, 0x93, 0xfb, 0xed, 0x25, 0x8b, 0xc5, 0xa8, 0x73, 0xed, 0xd2, 0xcb },
+  { 0xb5, 0x11, 0x0f, 0x55, 0xed, 0x99, 0xd5, 0x27, 0x9f, 0x18, 0x26, 0x6d, 0x00, 0x1a, 0x8c, 0xd5 },
+  { 0xb5, 0x62, 0x64, 0xf7, 0x38, 0xb2, 0xeb, 0x2c, 0x8f, 0x7c, 0xf5, 0xa2, 0xa7, 0x5e, 0x5f, 0xdc },
+  { 0xb5, 0x65, 0x7d, 0x4c, 0x1c, 0x73, 0x2f, 0xbb, 0x6a, 0xf1, 0x50, 0x66, 0x84, 0x64, 0x24, 0x7f },
+  { 0xb5, 0x94, 0x17, 0xd0, 0x83, 0xb0, 0xbe, 0x2d, 0x49, 0xa7, 0xd9, 0x37, 0x69, 0x88, 0x0a, 0x4b },
+  { 0xb5, 0x9f, 0xd4, 0x65, 0xab, 0xf7, 0x6f, 0x64, 0xc8, 0x56, 0x52, 0xff, 0x29, 0xd5, 0x95, 0x2d },
+  { 0xb5, 0xa1, 0xa1, 0x89, 0x60, 0x1a, 0x78, 0x5b, 0xdb, 0x2f, 0x02, 0xa4, 0x24, 0x08, 0x04, 0x12 },
+  { 0xb5, 0xcb, 0x9c, 0xf6, 0xe6, 0x68, 0xea, 0x3f, 0x4c, 0xc2, 0xbe, 0x00, 0xea, 0x70, 0xec, 0x3c },
+  { 0xb5, 0xcd, 0xba, 0xb5, 0x14, 0xea, 0x72, 0x6a, 0x14, 0x38, 0x3c, 0xff, 0x6d, 0xb4, 0x0e, 0x26 },
+  { 0xb5, 0xef, 0xe0, 0x27, 0x1d, 0x22, 0x14, 0xe4, 0xd5, 0xdc, 0x79, 0x88, 0x81, 0x48, 0x68, 0x84 },
+  { 0xb6, 0x16, 0x6f, 0x15, 0x72, 0x0f, 0xdf, 0x19, 0x29, 0x32, 0xf1, 0xf7, 0x6d, 0xf5, 0xb6, 0x5d },
+  { 0xb6, 0x44, 0x26, 0xe7, 0x87, 0xf0, 0x4f, 0xf2, 0x3e, 0xe6, 0x29, 0x18, 0x2c, 0x16, 0x86, 0x03 },
+  { 0xb6, 0x5d, 0x4a, 0x38, 0xd6, 0x04, 0x77, 0x35, 0x82, 0x4e, 0xe9, 0x96, 0x84, 0xf3, 0x51, 0x5e },
+  { 0xb6, 0x76, 0xa9, 0xb7, 0x09, 0x4e, 0x03, 0x45, 0xa7, 0x6e, 0xf0, 0x27, 0x09, 0x1d, 0x91, 0x6b },
+  { 0xb6, 0x81, 0x2e, 0xaf, 0x87, 0x12, 0x7f, 0x04, 0x3e, 0x78, 0xf9, 0x1f, 0x20, 0x28, 0xf9, 0xf4 },
+  { 0xb6, 0x82, 0x1a, 0xc5, 0x1c, 0x4c, 0x1d, 0xcb, 0x28, 0x3f, 0x01, 0xbe, 0x2f, 0x04, 0x7d, 0xc1 },
+  { 0xb6, 0x96, 0x0b, 0xe2, 0x6b, 0xee, 0x87, 0xd5, 0x3b, 0xa4, 0xe2, 0xe7, 0x1c, 0xfe, 0x77, 0x2f },
+  { 0xb6, 0xd5, 0x2a, 0x0c, 0xf5, 0x3a, 0xd4, 0x21, 0x6f, 0xeb, 0x04, 0x14, 0x73, 0x01, 0xf8, 0x7d },
+  { 0xb6, 0xe4, 0x0b, 0xce, 0x55, 0x06, 0x72, 0xe5, 0x49, 0x5a, 0x8c, 0xdd, 0xe7, 0x07, 0x5b, 0x8b },
+  { 0xb7, 0x02, 0x64, 0x1d, 0x69, 0x8c, 0x60, 0xbc, 0xdc, 0x92, 0x2d, 0xbd, 0x8c, 0x9d, 0xd4, 0x9c },
+  { 0xb7, 0x19, 0xad, 0xa1, 0x77, 0x71, 0xa8, 0xd2, 0x06, 0xc7, 0x97, 0x65, 0x53, 0x82, 0x51, 0x39 },
+  { 0xb7, 0x31, 0xd3, 0x5e, 0x4a, 0xc6, 0xb3, 0xb4, 0x7e, 0xba, 0x5d, 0xd0, 0x99, 0x1f, 0x45, 0x2f },
+  { 0xb7, 0x34, 0x52, 0x20, 0xa0, 0xc5, 0x87, 0xf3, 0xb0, 0xc4, 0x7a, 0xf3, 0x3e, 0xbe, 0x53, 0x3c },
+  { 0xb7, 0x6f, 0xba, 0xdc, 0x8f, 0xfb, 0x1f, 0x83, 0xe2, 0xca, 0x08, 0xb6, 0xfb, 0x4d, 0x6c, 0x9f },
+  { 0xb7, 0x74, 0x68, 0xd5, 0x86, 0x95, 0x7d, 0x1b, 0x7f, 0xb4, 0xcc, 0xcd, 0xa2, 0x68, 0x4f, 0x47 },
+  { 0xb7, 0x90, 0x32, 0x68, 0xe2, 0x35, 0x31, 0x0d, 0xc3, 0x46, 0xa1, 0x64, 0xaf, 0x4c, 0x70, 0x22 },
+  { 0xb7, 0x9f, 0xe3, 0x23, 0x20, 0x38, 0x8a, 0x19, 0x7a, 0xc3, 0xa0, 0xb9, 0x32, 0xcc, 0x21, 0x89 },
+  { 0xb7, 0xa7, 0xe3, 0x4e, 0x30, 0x4e, 0x4b, 0x7b, 0xc5, 0x65, 0xec, 0x01, 0xba, 0x33, 0xea, 0x27 },
+  { 0xb7, 0xb1, 0xd3, 0xce, 0x07, 0xe7, 0x59, 0x76, 0xc4, 0x3a, 0x2d, 0xca, 0x38, 0x66, 0x23, 0x7e },
+  { 0xb7, 0xe4, 0x59, 0xd5, 0x41, 0x6e, 0xeb, 0x19, 0x6a, 0xaa, 0x8e, 0x09, 0x2d, 0xb1, 0x44, 0x63 },
+  { 0xb7, 0xf1, 0x84, 0x01, 0x39, 0x91, 0x82, 0x3f, 0xc0, 0x2a, 0x65, 0x57, 0x34, 0x1d, 0x2a, 0x7a },
+  { 0xb8, 0x0d, 0x50, 0xec, 0xee, 0x73, 0x91, 0x9a, 0x50, 0x74, 0x98, 0xd0, 0xa4, 0xd9, 0x22, 0xae },
+  { 0xb8, 0x16, 0x29, 0x63, 0x11, 0x01, 0x9a, 0xb6, 0x9a, 0x21, 0xcb, 0x9e, 0x9e, 0x23, 0x5d, 0x12 },
+  { 0xb8, 0x22, 0xfb, 0xa8, 0xb7, 0xc8, 0xa9, 0x7e, 0xa4, 0xe9, 0x2a, 0xeb, 0x2c, 0x45, 0x5e, 0xf9 },
+  { 0xb8, 0x35, 0x79, 0xc4, 0x45, 0x0f, 0xcb, 0xdf, 0x2b, 0x10, 0x89, 0x03, 0x73, 0x1f, 0xa7, 0x34 },
+  { 0xb8, 0x3d, 0xf1, 0xf3, 0x2b, 0x45, 0x39, 0xc3, 0x24, 0xbd, 0xf9, 0x48, 0x51, 0xb4, 0xdb, 0x55 },
+  { 0xb8, 0x65, 0x52, 0x19, 0x8f, 0x52, 0xcf, 0xce, 0x72, 0x1b, 0xaf, 0xb4, 0x96, 0x36, 0x30, 0x99 },
+  { 0xb8, 0x6a, 0x12, 0xe5, 0x3a, 0xb1, 0x07, 0xb6, 0xca, 0xed, 0xd4, 0xe0, 0x27, 0x2a, 0xa0, 0x34 },
+  { 0xb8, 0x79, 0xe1, 0x3f, 0xd9, 0x93, 0x82, 0xe0, 0x9b, 0xca, 0xf1, 0xd8, 0x7a, 0xd8, 0x4a, 0xdd },
+  { 0xb8, 0x86, 0x5f, 0x05, 0x67, 0x6e, 0x64, 0xf3, 0xbe, 0xc7, 0x2b, 0x9d, 0xef, 0xda, 0xcf, 0xa7 },
+  { 0xb8, 0x97, 0xf9, 0xe3, 0xf9, 0x39, 0xb9, 0xf2, 0x15, 0x66, 0xd5, 0x6d, 0xb8, 0x12, 0xa8, 0x4e },
+  { 0xb8, 0xed, 0x78, 0xaf, 0xdb, 0x1e, 0x6c, 0xfe, 0x44, 0xef, 0x6e, 0x34, 0x28, 0x78, 0x9d, 0x5f },
+  { 0xb9, 0x23, 0x2c, 0x1d, 0xe4, 0x94, 0x87, 0x5e, 0xfe, 0x18, 0x58, 0xfc, 0x83, 0x90, 0x61, 0x6d },
+  { 0xb9, 0x33, 0x6e, 0xd6, 0xd9, 0x4a, 0x5c, 0xc8, 0x1a, 0x16, 0x48, 0x3b, 0x0a, 0x94, 0x6a, 0x73 },
+  { 0xb9, 0x58, 0xd5, 0xfd, 0x95, 0x74, 0xc5, 0xcf, 0x9e, 0xce, 0x4b, 0x94, 0x21, 0xc2, 0x8e, 0xcd },
+  { 0xb9, 0x5a, 0x62, 0x74, 0xca, 0x0e, 0x0c, 0x77, 0x3b, 0xfd, 0xc0, 0x6b, 0x4c, 0x3d, 0xaa, 0x42 },
+  { 0xb9, 0x8c, 0xc2, 0xc6, 0xf7, 0xa0, 0xf0, 0x51, 0x76, 0xf7, 0x4f, 0x0f, 0x62, 0xc4, 0x54, 0x88 },
+  { 0xb9, 0xb4, 0x61, 0x23, 0x58, 0xa0, 0xb2, 0xc1, 0xb4, 0xd6, 0x6b, 0xb1, 0x46, 0x76, 0x73, 0x06 },
+  { 0xb9, 0xd1, 0xe3, 0xbe, 0x30, 0xb1, 0x31, 0x32, 0x44, 0x82, 0x34, 0x59, 0x59, 0xae, 0xd5, 0xe5 },
+  { 0xb9, 0xf6, 0xfa, 0x39, 0x9b, 0x8c, 0xd3, 0x86, 0xc2, 0x35, 0x98, 0x3e, 0xc4, 0x5e, 0x43, 0x55 },
+  { 0xb9, 0xf9, 0xc0, 0xfe, 0xd0, 0xdb, 0x08, 0xc3, 0x43, 0x46, 0x31, 0x7f, 0x39, 0x57, 0xa9, 0x45 },
+  { 0xba, 0x25, 0x74, 0x38, 0xf8, 0xa7, 0x88, 0x62, 0xa9, 0xe0, 0x14, 0xd8, 0x31, 0x14, 0x36, 0x90 },
+  { 0xba, 0x31, 0x7f, 0x83, 0xcd, 0xfc, 0xd5, 0x8c, 0xbc, 0x65, 0xaa, 0xc1, 0xcc, 0xb8, 0x7b, 0xc5 },
+  { 0xba, 0x3a, 0x17, 0xef, 0xd2, 0x6d, 0xb8, 0xb4, 0xf0, 0x9c, 0x0c, 0xf7, 0xaf, 0xdf, 0x84, 0xd1 },
+  { 0xba, 0x3b, 0x0e, 0xeb, 0xcc, 0xc7, 0xb7, 0x91, 0x10, 0x7d, 0xe5, 0xb4, 0xab, 0xb6, 0x71, 0xb4 },
+  { 0xba, 0x65, 0x7d, 0x94, 0x0a, 0x11, 0xe8, 0x07, 0xff, 0x31, 0x4b, 0xba, 0x2c, 0x8b, 0x38, 0x9b },
+  { 0xba, 0xc2, 0x8d, 0x06, 0xdf, 0xc0, 0x3d, 0x3d, 0x2f, 0x4a, 0x7c, 0x13, 0x38, 0x3e, 0x84, 0xee },
+  { 0xba, 0xe1, 0xa2, 0x3f, 0x9b, 0x6a, 0xcd, 0xad, 0xf4, 0x65, 0xcf, 0xb3, 0x30, 0xba, 0x0a, 0xcb },
+  { 0xba, 0xe6, 0x69, 0x07, 0xc3, 0x20, 0x0b, 0xc6, 0x35, 0x92, 0xef, 0xe5, 0xa9, 0xa6, 0x9d, 0xbb },
+  { 0xba, 0xf4, 0xce, 0x88, 0x5a, 0xa2, 0x81, 0xfd, 0x31, 0x71, 0x1d, 0xa9, 0xb9, 0x79, 0x54, 0x85 },
+  { 0xbb, 0x07, 0xf9, 0x17, 0x61, 0x1c, 0xde, 0x42, 0xb7, 0xd8, 0x37, 0x46, 0xee, 0x27, 0x14, 0x7d },
+  { 0xbb, 0x18, 0x18, 0x90, 0x21, 0xd5, 0x83, 0x62, 0xd9, 0xe4, 0xd3, 0x17, 0xcd, 0x2e, 0x28, 0xb7 },
+  { 0xbb, 0x50, 0x49, 0xe4, 0x55, 0x8d, 0xaa, 0xde, 0x0f, 0x87, 0xfe, 0xd6, 0x9a, 0x24, 0x4c, 0x59 },
+  { 0xbb, 0x57, 0x94, 0x04, 0x92, 0x4c, 0x40, 0xca, 0x37, 0x8b, 0x4a, 0xff, 0x6c, 0xcf, 0x30, 0x2d },
+  { 0xbb, 0x6a, 0x5a, 0x2f, 0x7b, 0x67, 0xbe, 0xe5, 0xd1, 0xf2, 0x37, 0xf6, 0x2f, 0x1e, 0x64, 0x3f },
+  { 0xbb, 0x74, 0x5c, 0x89, 0x39, 0x99, 0xb0, 0xef, 0xc9, 0x6e, 0xa9, 0x02, 0x9e, 0x3c, 0x62, 0xca },
+  { 0xbb, 0x75, 0x6a, 0xa9, 0x8b, 0x84, 0x7d, 0xdd, 0xc8, 0xfc, 0x17, 0x0b, 0xc7, 0x9f, 0x92, 0xb2 },
+  { 0xbb, 0x9f, 0x06, 0xb2, 0x88, 0xb5, 0x27, 0x5b, 0xc0, 0xd3, 0x8b, 0x67, 0x31, 0xb2, 0x52, 0x6a },
+  { 0xbb, 0xf8, 0xc7, 0xc9, 0xed, 0x28, 0x01, 0x51, 0x93, 0x4a, 0xab, 0xe1, 0x38, 0xe4, 0x1b, 0xa7 },
+  { 0xbc, 0x30, 0x57, 0xa3, 0x53, 0x19, 0xaa, 0xe3, 0xa5, 0xcd, 0x87, 0xa2, 0x03, 0x73, 0x6a, 0xbe },
+  { 0xbc, 0x33, 0xc6, 0x85, 0xe6, 0xff, 0xce, 0xd8, 0x3a, 0xbe, 0x7a, 0x43, 0xf3, 0x0d, 0xf7, 0xf9 },
+  { 0xbc, 0x4c, 0xf3, 0x8a, 0x4b, 0xee, 0x45, 0x75, 0x2d, 0xc4, 0x66, 0xc9, 0x8e, 0xd7, 0xad, 0x09 },
+  { 0xbc, 0x52, 0x61, 0x85, 0xad, 0x32, 0x42, 0x41, 0x78, 0x2d, 0xc6, 0x8b, 0xa5, 0xd0, 0x54, 0x0b },
+  { 0xbc, 0x53, 0x89, 0x83, 0x98, 0x57, 0x61, 0x2c, 0xfa, 0xbe, 0xb8, 0x10, 0xba, 0x7e, 0xff, 0xdc },
+  { 0xbc, 0x64, 0x32, 0xcb, 0xed, 0x32, 0xc6, 0x95, 0x65, 0x85, 0x14, 0xc4, 0xeb, 0x41, 0xd9, 0x05 },
+  { 0xbc, 0x70, 0x3e, 0xa6, 0xaf, 0xb2, 0x0b, 0xc0, 0x89, 0xf0, 0x4d, 0x8c, 0x9d, 0x79, 0xa2, 0xbd },
+  { 0xbc, 0x97, 0xd5, 0x44, 0xf1, 0xd4, 0x83, 0x4c, 0xc7, 0x2b, 0xcc, 0x92, 0xa3, 0x7b, 0x8c, 0x1b },
+  { 0xbc, 0xb3, 0x1f, 0x22, 0x85, 0x6b, 0x00, 0x28, 0xc0, 0x0d, 0x12, 0xf0, 0xe4, 0xc0, 0xa9, 0x52 },
+  { 0xbc, 0xcb, 0x4e, 0x2c, 0xfa, 0xd5, 0xef, 0xc9, 0x3f, 0x6d, 0x55, 0xdc, 0x99, 0x21, 0x18, 0xce },
+  { 0xbc, 0xe4, 0xc2, 0x91, 0xd0, 0x00, 0x7f, 0x16, 0x99, 0x7f, 0xaa, 0x5c, 0x4d, 0xb0, 0xa6, 0xb8 },
+  { 0xbc, 0xe9, 0x39, 0x84, 0xb9, 0x20, 0xe9, 0xb5, 0x6c, 0xf2, 0x40, 0x64, 0xf7, 0x40, 0xfe, 0x78 },
+  { 0xbc, 0xef, 0x78, 0x80, 0x82, 0x8a, 0x39, 0x1c, 0xf6, 0xb5, 0x0d, 0x5a, 0x6d, 0xce, 0xf7, 0x19 },
+  { 0xbd, 0x1b, 0xd6, 0xf6, 0xb9, 0x28, 0xdf, 0x17, 0xa7, 0x02, 0xde, 0xf0, 0x30, 0x2f, 0x46, 0xf4 },
+  { 0xbd, 0x39, 0x59, 0x8f, 0x06, 0x7a, 0x11, 0x93, 0xae, 0x81, 0xbd, 0x61, 0x82, 0xe7, 0x56, 0xd1 },
+  { 0xbd, 0x43, 0x0c, 0x21, 0x93, 0x04, 0x5c, 0x68, 0xd1, 0xa2, 0x0a, 0x01, 0x8a, 0x97, 0x62, 0x48 },
+  { 0xbd, 0xa1, 0x46, 0x3e, 0x02, 0xae, 0x3a, 0x6e, 0x11, 0x07, 0xff, 0xe1, 0xb5, 0x72, 0xef, 0xd2 },
+  { 0xbd, 0xb4, 0xb5, 0x84, 0xdd, 0xc9, 0x0c, 0x9d, 0x2e, 0xc7, 0xe2, 0x16, 0x32, 0xa2, 0x36, 0xb6 },
+  { 0xbd, 0xba, 0xef, 0xf1, 0xf7, 0x13, 0x23, 0x58, 0xea, 0x64, 0xc7, 0xbe, 0x9e, 0x46, 0xc1, 0xac },
+  { 0xbd, 0xc3, 0x81, 0xba, 0xf7, 0xc2, 0x52, 0xc6, 0x37, 0x39, 0xc5, 0xe9, 0xed, 0x08, 0x7a, 0x5c },
+  { 0xbd, 0xec, 0xc8, 0x1f, 0x74, 0x02, 0x00, 0x78, 0x0d, 0xb0, 0x4a, 0x10, 0x7c, 0x3a, 0x1e, 0xba },
+  { 0xbd, 0xf1, 0x99, 0x6e, 0x2d, 0xd6, 0x4b, 0xaf, 0x8e, 0xff, 0x55, 0x11, 0x81, 0x1c, 0xa6, 0xca },
+  { 0xbe, 0x06, 0x0a, 0x70, 0x48, 0x03, 0x44, 0x6c, 0x02, 0xe6, 0xf0, 0x39, 0xab, 0x12, 0xeb, 0x91 },
+  { 0xbe, 0x19, 0x22, 0xbd, 0x8e, 0x09, 0xd7, 0x4d, 0xa4, 0x71, 0x28, 0x7e, 0x1e, 0x96, 0x86, 0x53 },
+  { 0xbe, 0x28, 0x70, 0xa0, 0x12, 0x0f, 0xd2, 0x8d, 0x25, 0x28, 0x4e, 0x9c, 0xcd, 0xcb, 0xdc, 0x99 },
+  { 0xbe, 0x35, 0xd8, 0xb3, 0x7b, 0xbc, 0x03, 0x84, 0x8a, 0x5f, 0x02, 0x06, 0x62, 0xa9, 0x99, 0x09 },
+  { 0xbe, 0x3f, 0x0e, 0x82, 0x7e, 0x2f, 0x74, 0x88, 0x19, 0xda, 0xc2, 0xa2, 0x2d, 0x6a, 0xc8, 0x23 },
+  { 0xbe, 0x41, 0x46, 0x3c, 0xd9, 0x18, 0xda, 0xef, 0x10, 0x7d, 0x24, 0x9f, 0x8c, 0xde, 0x34, 0x09 },
+  { 0xbe, 0x56, 0x1b, 0x28, 0x6b, 0x64, 0x32, 0xca, 0xc7, 0x1b, 0xcc, 0xba, 0xe6, 0x80, 0x02, 0xf7 },
+  { 0xbe, 0x92, 0x94, 0x19, 0x90, 0x2e, 0x21, 0xbd, 0x78, 0x30, 0xa7, 0xa7, 0xd7, 0x46, 0x19, 0x5d },
+  { 0xbe, 0xcd, 0x90, 0x8f, 0x9d, 0x7b, 0xb3, 0x61, 0x98, 0x2c, 0x3d, 0xc0, 0x2d, 0x64, 0x75, 0xc6 },
+  { 0xbe, 0xdf, 0xbd, 0xe7, 0x1f, 0xb6, 0x06, 0x60, 0x1f, 0x93, 0x6b, 0x5b, 0x05, 0x7f, 0x26, 0xf7 },
+  { 0xbe, 0xfc, 0xe0, 0xde, 0x20, 0x12, 0xb2, 0x4f, 0xd6, 0xcb, 0x8b, 0x53, 0xc1, 0x7c, 0x82, 0x71 },
+  { 0xbf, 0x52, 0x32, 0x7c, 0x21, 0x97, 0xd9, 0xd2, 0xc4, 0x54, 0x4b, 0xe0, 0x53, 0xca, 0xde, 0xd1 },
+  { 0xbf, 0x5e, 0x20, 0x79, 0x58, 0x6c, 0xb3, 0x07, 0xbf, 0x5e, 0xb2, 0x41, 0x3e, 0x2e, 0x61, 0xaf },
+  { 0xbf, 0x84, 0xf5, 0x28, 0xde, 0x44, 0x22, 0x5d, 0xd7, 0x33, 0xc0, 0xe6, 0xa8, 0xe4, 0x00, 0xa0 },
+  { 0xbf, 0x97, 0x6c, 0xf8, 0x0b, 0xcf, 0x52, 0xc5, 0xf1, 0x64, 0xc1, 0xd4, 0x5f, 0x2b, 0x31, 0x6b },
+  { 0xbf, 0x9d, 0xdc, 0x5d, 0xd9, 0x05, 0x66, 0x33, 0xd4, 0xac, 0x0d, 0xac, 0x8b, 0x87, 0x1d, 0xfe },
+  { 0xbf, 0xa5, 0x81, 0x98, 0xc6, 0xb9, 0xcd, 0x80, 0x62, 0xee, 0x76, 0xa2, 0xb3, 0x8e, 0x9b, 0x33 },
+  { 0xbf, 0xb7, 0x3a, 0xab, 0xb2, 0x48, 0x93, 0x16, 0xcd, 0x58, 0x82, 0xc3, 0xcd, 0x11, 0xd9, 0xf9 },
+  { 0xbf, 0xca, 0xbc, 0x69, 0x95, 0xef, 0x42, 0xd0, 0xb6, 0xc0, 0x67, 0x86, 0x99, 0x3d, 0xc4, 0xd6 },
+  { 0xbf, 0xf8, 0xf8, 0xf5, 0x3a, 0x8a, 0xeb, 0x1e, 0xe8, 0x04, 0x00, 0x4c, 0xcb, 0xb0, 0x83, 0x13 },
+  { 0xbf, 0xfe, 0x34, 0x51, 0x6a, 0xaa, 0x3c, 0xbf, 0x5d, 0x30, 0x7e, 0xab, 0x38, 0x2a, 0x7e, 0x95 },
+  { 0xc0, 0x07, 0x34, 0xa2, 0x23, 0x3e, 0xf6, 0x83, 0xd9, 0xb6, 0xe6, 0x22, 0xac, 0x97, 0xa5, 0xc8 },
+  { 0xc0, 0x0b, 0x65, 0xd1, 0xba, 0xe0, 0xae, 0xf6, 0xa1, 0xb5, 0x65, 0x2c, 0x9c, 0x21, 0x56, 0xa1 },
+  { 0xc0, 0x2e, 0x1a, 0xfa, 0x06, 0x71, 0xe4, 0x38, 0xfd, 0x52, 0x60, 0x55, 0xc5, 0x56, 0xd2, 0x31 },
+  { 0xc0, 0x32, 0xc2, 0xbd, 0x70, 0x17, 0xfd, 0xfb, 0xba, 0x9a, 0x10, 0x5e, 0xc5, 0x0f, 0x80, 0x0e },
+  { 0xc0, 0x33, 0xdc, 0x1d, 0x7b, 0x6f, 0xde, 0x41, 0xb9, 0xca, 0xdc, 0xe9, 0x63, 0x89, 0x09, 0xbb },
+  { 0xc0, 0x58, 0x9b, 0xb7, 0x38, 0x58, 0x92, 0x43, 0x89, 0x07, 0x7f, 0xa3, 0xc2, 0xe9, 0x44, 0x1a },
+  { 0xc0, 0x5f, 0x36, 0x7f, 0xa4, 0x76, 0x7c, 0xeb, 0x27, 0xab, 0xad, 0xf0, 0x06, 0x6d, 0xf7, 0xf4 },
+  { 0xc0, 0x8d, 0x0c, 0xee, 0x43, 0x07, 0x7d, 0x30, 0x55, 0xfe, 0xbb, 0x00, 0xe5, 0x74, 0x5c, 0x1d },
+  { 0xc0, 0xa6, 0x88, 0x37, 0xc6, 0x0e, 0x15, 0xd1, 0xfc, 0x5a, 0x40, 0xc9, 0xa6, 0x28, 0x94, 0xbc },
+  { 0xc0, 0xd2, 0x43, 0x43, 0x48, 0xde, 0x72, 0xfa, 0x6e, 0xdc, 0xc6, 0xd8, 0xe4, 0x0f, 0x28, 0xd7 },
+  { 0xc1, 0x18, 0x85, 0x4d, 0x67, 0x02, 0x89, 0xa8, 0xb5, 0xd5, 0x15, 0x6a, 0xa7, 0x4b, 0x0c, 0x49 },
+  { 0xc1, 0x26, 0x65, 0x6d, 0xf6, 0xba, 0xdf, 0xa5, 0x19, 0xcc, 0x63, 0xe6, 0x81, 0xfb, 0x35, 0x96 },
+  { 0xc1, 0x50, 0xc7, 0x6c, 0xbd, 0xe2, 0xc9, 0xb5, 0xa9, 0x7e, 0xb5, 0x39, 0x9d, 0x46, 0xc6, 0x4f },
+  { 0xc1, 0x6c, 0x79, 0xaa, 0xd6, 0x27, 0x2b, 0xaf, 0xfb, 0x8a, 0xae, 0x9a, 0x7f, 0xff, 0x08, 0x64 },
+  { 0xc1, 0x6f, 0xbf, 0xdb, 0xfd, 0xf5, 0x59, 0x0c, 0xc8, 0x17, 0x9e, 0x4b, 0x0f, 0x5f, 0x5a, 0xeb },
+  { 0xc1, 0x7b, 0xdc, 0x7d, 0x14, 0xa3, 0x6e, 0x10, 0x83, 0x7d, 0x03, 0x9f, 0x43, 0xee, 0x5f, 0xa3 },
+  { 0xc1, 0xa8, 0x3f, 0x44, 0x13, 0x7e, 0xa9, 0x14, 0xb4, 0x95, 0xfc, 0x6a, 0xc0, 0x36, 0xc4, 0x93 },
+  { 0xc1, 0xb0, 0x38, 0xce, 0x5c, 0xb6, 0xd8, 0x5e, 0x95, 0x6c, 0x55, 0x09, 0xb0, 0xe0, 0xd0, 0xd8 },
+  { 0xc1, 0xb1, 0x04, 0x9b, 0x88, 0xbc, 0xd9, 0x84, 0x37, 0xd8, 0x87, 0x2d, 0x1d, 0x62, 0xba, 0x31 },
+  { 0xc1, 0xb7, 0xae, 0xab, 0xc3, 0xec, 0x41, 0x55, 0x6d, 0x92, 0x4c, 0x83, 0x72, 0xa9, 0xba, 0x5b },
+  { 0xc1, 0xcb, 0x22, 0x84, 0x70, 0xa8, 0x7b, 0xeb, 0x5f, 0x36, 0xe9, 0x0a, 0xc7, 0x45, 0xda, 0x26 },
+  { 0xc1, 0xe6, 0xe4, 0xe7, 0xef, 0x5f, 0x14, 0x63, 0x88, 0xa0, 0x90, 0xf1, 0xc4, 0x69, 0xa2, 0xfa },
+  { 0xc1, 0xf2, 0x09, 0xd8, 0x0f, 0x06, 0x24, 0xda, 0xda, 0x58, 0x66, 0xce, 0x05, 0xdd, 0x33, 0x99 },
+  { 0xc1, 0xfd, 0xd4, 0x4e, 0xfd, 0xa9, 0x16, 0x41, 0x4b, 0xe3, 0x52, 0x7a, 0x47, 0x75, 0x2c, 0x75 },
+  { 0xc2, 0x0f, 0x15, 0x28, 0x2a, 0x1a, 0xa8, 0x72, 0x4d, 0x70, 0xc1, 0x17, 0xe5, 0xc9, 0x70, 0x9e },
+  { 0xc2, 0x14, 0x50, 0xc2, 0x1e, 0xfb, 0x77, 0x15, 0x74, 0x6e, 0x9f, 0xa8, 0x7a, 0xd6, 0xf1, 0x45 },
+  { 0xc2, 0x16, 0xb9, 0x1f, 0x5d, 0xb2, 0x1a, 0x09, 0x3d, 0xed, 0x6a, 0x5a, 0xae, 0xc8, 0x57, 0x09 },
+  { 0xc2, 0x21, 0x60, 0x75, 0x29, 0xca, 0xbc, 0x93, 0x45, 0x0e, 0xf2, 0x5d, 0xba, 0xc6, 0xe8, 0xd2 },
+  { 0xc2, 0x25, 0x37, 0x9e, 0x7c, 0x4f, 0xb6, 0xf8, 0x86, 0xef, 0x9c, 0x8c, 0x52, 0x22, 0x75, 0xb4 },
+  { 0xc2, 0x25, 0xab, 0xfb, 0x58, 0x49, 0x60, 0xef, 0xe1, 0xf3, 0x59, 0xfc, 0x94, 0xb7, 0x33, 0x79 },
+  { 0xc2, 0x41, 0x0d, 0x03, 0x82, 0x0e, 0x0f, 0xf0, 0xa4, 0x49, 0xfa, 0x61, 0x70, 0xf5, 0x12, 0x11 },
+  { 0xc2, 0x46, 0xe0, 0x5b, 0x52, 0xf6, 0x8a, 0xb2, 0xe9, 0xae, 0xe4, 0x0f, 0x27, 0x8c, 0xd1, 0x58 },
+  { 0xc2, 0x77, 0x85, 0x07, 0xb8, 0x3d, 0x95, 0x40, 0xe9, 0xbe, 0x57, 0x13, 0x75, 0x8f, 0xf9, 0x45 },
+  { 0xc2, 0x8b, 0x29, 0x76, 0x4c, 0x23, 0x38, 0xb0, 0xcf, 0x95, 0x53, 0x7c, 0xc9, 0xaa, 0xd8, 0xc9 },
+  { 0xc2, 0x9d, 0x17, 0xee, 0xf6, 0xb0, 0x78, 0x4d, 0xb4, 0x58, 0x6c, 0x12, 0xcb, 0x5f, 0xd4, 0x54 },
+  { 0xc2, 0x9f, 0x8d, 0xb6, 0x80, 0x99, 0x0c, 0xb4, 0x5e, 0xf7, 0xfe, 0xf6, 0xab, 0x57, 0xa2, 0xc2 },
+  { 0xc2, 0xa3, 0x7f, 0x1c, 0x76, 0x03, 0xc5, 0xfd, 0x97, 0xdf, 0x47, 0xd6, 0xc5, 0x62, 0xab, 0xfa },
+  { 0xc2, 0xb5, 0xc5, 0x0c, 0xcb, 0x59, 0x81, 0x68, 0x67, 0x03, 0x6d, 0x7c, 0xf7, 0x30, 0xbf, 0x75 },
+  { 0xc2, 0xbc, 0xd8, 0xf2, 0x37, 0x8c, 0x37, 0x79, 0x06, 0x7f, 0x3a, 0x55, 0x1f, 0x66, 0x2b, 0xb7 },
+  { 0xc2, 0xc7, 0xa1, 0x17, 0x17, 0xe2, 0x55, 0x59, 0x3e, 0x54, 0xd0, 0xac, 0xaf, 0x65, 0x3e, 0xe5 },
+  { 0xc2, 0xfb, 0xef, 0x02, 0xb6, 0xee, 0xa3, 0x7d, 0x8d, 0xf3, 0xe9, 0x11, 0x07, 0xf8, 0x99, 0x50 },
+  { 0xc3, 0x1a, 0x17, 0x94, 0x2d, 0x16, 0x2b, 0x80, 0x96, 0x2c, 0xb1, 0xf7, 0x57, 0x1c, 0xd1, 0xd5 },
+  { 0xc3, 0x20, 0x5e, 0x37, 0x07, 0xf6, 0x46, 0xe1, 0xa1, 0x06, 0xe0, 0x9c, 0x5c, 0x49, 0xc1, 0xbf },
+  { 0xc3, 0x47, 0x2f, 0xa9, 0x8c, 0x3b, 0x45, 0x2f, 0xa2, 0xfd, 0x37, 0xd1, 0xc2, 0x19, 0xfb, 0x6f },
+  { 0xc3, 0x70, 0xc3, 0x26, 0x8a, 0xd9, 0x5b, 0x32, 0x66, 0xd6, 0xe3, 0x6f, 0xf2, 0x3d, 0x1f, 0x0c },
+  { 0xc3, 0xa9, 0x55, 0x0f, 0x63, 0x45, 0xf4, 0xc2, 0x5b, 0x37, 0x2c, 0x42, 0xdc, 0x86, 0x57, 0x03 },
+  { 0xc3, 0xae, 0xb7, 0x96, 0xfd, 0xaf, 0x94, 0x29, 0xe8, 0xcd, 0x6a, 0xf6, 0x34, 0x6f, 0x33, 0x7e },
+  { 0xc3, 0xbb, 0xc6, 0x73, 0xac, 0xf2, 0x70, 0x1b, 0x52, 0x75, 0xe8, 0x5d, 0x93, 0x72, 0xfa, 0xcf },
+  { 0xc3, 0xe4, 0xaa, 0x71, 0x8f, 0x46, 0x29, 0x13, 0x11, 0xf1, 0xcc, 0xe5, 0x3e, 0x6c, 0xcd, 0x79 },
+  { 0xc3, 0xef, 0x5c, 0x46, 0x53, 0x21, 0x20, 0x88, 0xed, 0xa5, 0x4d, 0xc9, 0x1d, 0x78, 0x78, 0x70 },
+  { 0xc3, 0xf5, 0x39, 0x93, 0xad, 0xe5, 0x34, 0xb0, 0x98, 0x2c, 0xa3, 0xa2, 0x86, 0xc8, 0x5b, 0xb5 },
+  { 0xc4, 0x06, 0x0a, 0x31, 0xd6, 0x1b, 0xa8, 0x57, 0xe7, 0x56, 0x43, 0x0a, 0x0a, 0x15, 0xed, 0x2e },
+  { 0xc4, 0x1e, 0x77, 0x35, 0xf6, 0x70, 0x1d, 0xd5, 0x0e, 0x84, 0xee, 0x71, 0xd3, 0xed, 0x1d, 0x8f },
+  { 0xc4, 0x3b, 0xd3, 0x63, 0xe1, 0xf1, 0x28, 0xe7, 0x3b, 0xa5, 0xf0, 0x38, 0x0b, 0x6f, 0xd7, 0xe3 },
+  { 0xc4, 0x46, 0x28, 0x8f, 0xe6, 0x2c, 0x0c, 0x27, 0x37, 0x63, 0x9f, 0xd7, 0x88, 0xae, 0x4a, 0x21 },
+  { 0xc4, 0x50, 0xa2, 0x85, 0xda, 0xa7, 0xa3, 0xb6, 0x51, 0x88, 0xc2, 0xc3, 0xcf, 0x04, 0xfb, 0x3e },
+  { 0xc4, 0x69, 0x15, 0x16, 0x55, 0xe3, 0x33, 0x79, 0x34, 0x72, 0x77, 0x70, 0x52, 0x01, 0x3f, 0x4f },
+  { 0xc4, 0x71, 0xb9, 0x74, 0x46, 0xa8, 0x53, 0x04, 0xbb, 0xac, 0x02, 0x1c, 0x57, 0xc2, 0xcb, 0x49 },
+  { 0xc4, 0x72, 0x44, 0xf5, 0x55, 0x7a, 0xe1, 0x2c, 0x61, 0xe8, 0xe0, 0x1c, 0x14, 0x0e, 0x21, 0x73 },
+  { 0xc4, 0x73, 0xb2, 0x22, 0xb7, 0xc5, 0x30, 0x8d, 0x07, 0x73, 0x32, 0x64, 0x16, 0x09, 0x42, 0x72 },
+  { 0xc4, 0x7b, 0x73, 0x89, 0xe7, 0x69, 0x74, 0xfd, 0x0d, 0xe3, 0xf0, 0x88, 0xfe, 0xa3, 0x55, 0x76 },
+  { 0xc4, 0x82, 0xf8, 0xee, 0xbd, 0x45, 0xe0, 0xb8, 0xd4, 0x79, 0xd9, 0xb7, 0x1d, 0xd7, 0x2b, 0xb8 },
+  { 0xc4, 0x9f, 0xe4, 0x37, 0x80, 0x0a, 0xd7, 0xfd, 0x93, 0x02, 0xf3, 0xa9, 0x0a, 0x38, 0xfb, 0x7d },
+  { 0xc4, 0xb7, 0x3c, 0x35, 0xbc, 0x2f, 0x54, 0xb6, 0x6c, 0xd7, 0x86, 0xf5, 0x5b, 0x66, 0x8a, 0x82 },
+  { 0xc4, 0xbb, 0xbb, 0x0c, 0x8f, 0xe2, 0x03, 0xcb, 0xd3, 0xbe, 0x2e, 0x31, 0x8e, 0x55, 0xbc, 0xc0 },
+  { 0xc4, 0xbc, 0x8c, 0x2e, 0x13, 0x0d, 0x76, 0x34, 0x6e, 0xbf, 0x8e, 0xb5, 0x44, 0x99, 0x1b, 0x46 },
+  { 0xc4, 0xd8, 0x88, 0xbc, 0xf5, 0x32, 0xe7, 0xc9, 0xc5, 0xfd, 0xea, 0xfb, 0xb1, 0x45, 0x26, 0x6a },
+  { 0xc5, 0x04, 0xa7, 0x1c, 0x41, 0x1a, 0x60, 0x1d, 0x1f, 0xc3, 0x17, 0x33, 0x69, 0xcf, 0xdc, 0xa4 },
+  { 0xc5, 0x12, 0x4e, 0x7d, 0x7a, 0x8c, 0x76, 0x8e, 0x5a, 0x18, 0xbd, 0xe8, 0xb5, 0x4a, 0xeb, 0x1d },
+  { 0xc5, 0x17, 0x14, 0x4e, 0x3d, 0x3a, 0xc5, 0xc0, 0x6f, 0x2f, 0x68, 0x2e, 0xbf, 0x21, 0x2d, 0xd7 },
+  { 0xc5, 0x29, 0xe6, 0x30, 0x13, 0x69, 0x80, 0x64, 0x14, 0x9b, 0x9e, 0x04, 0x68, 0xaf, 0xd9, 0x41 },
+  { 0xc5, 0x2d, 0x9b, 0xbd, 0xc5, 0x53, 0x0e, 0x1e, 0xf8, 0xe8, 0xba, 0x7b, 0xe6, 0x92, 0xb0, 0x1e },
+  { 0xc5, 0x30, 0x1f, 0x54, 0x9d, 0x07, 0x22, 0x04, 0x9b, 0xb0, 0xad, 0xd6, 0xb1, 0x0d, 0x1e, 0x09 },
+  { 0xc5, 0x38, 0x7f, 0xc1, 0xaa, 0x71, 0xf1, 0x1d, 0x2f, 0xa8, 0x24, 0x59, 0xe1, 0x89, 0xa5, 0xf0 },
+  { 0xc5, 0x41, 0xa5, 0xf6, 0xfc, 0x23, 0xb4, 0x0a, 0x21, 0x11, 0x96, 0xdd, 0x78, 0x23, 0x37, 0x80 },
+  { 0xc5, 0x4b, 0x42, 0x07, 0xce, 0x1d, 0x4b, 0xf7, 0x2f, 0xad, 0xbb, 0x1a, 0x80, 0x5d, 0x4a, 0x39 },
+  { 0xc5, 0x69, 0xe5, 0x7d, 0xca, 0x93, 0xd3, 0xbe, 0xe1, 0x15, 0xa4, 0x99, 0x23, 0x05, 0x7f, 0xd7 },
+  { 0xc5, 0x87, 0x08, 0xc0, 0x9c, 0xcb, 0x61, 0x62, 0x5c, 0xda, 0x9d, 0x15, 0xdd, 0xcd, 0x8b, 0xe6 },
+  { 0xc5, 0x93, 0x0d, 0x0e, 0x8c, 0xda, 0xe3, 0xe0, 0x37, 0x34, 0x9b, 0xfa, 0x08, 0xe8, 0x71, 0xbe },
+  { 0xc5, 0x96, 0x33, 0xdb, 0xeb, 0xd9, 0x26, 0xc1, 0x50, 0xfb, 0x6d, 0x30, 0xb0, 0x57, 0x64, 0x05 },
+  { 0xc5, 0xa7, 0x6b, 0xaf, 0xc4, 0x67, 0x6e, 0xdb, 0x76, 0xe0, 0x12, 0x6f, 0xb9, 0xf0, 0xfb, 0x2d },
+  { 0xc5, 0xba, 0xb9, 0x53, 0xac, 0x13, 0xdb, 0xb2, 0xcb, 0xa0, 0x3c, 0xd0, 0x68, 0x4f, 0xb1, 0x25 },
+  { 0xc5, 0xc7, 0xcc, 0x66, 0xfe, 0xbf, 0x2d, 0x4e, 0x74, 0x3b, 0x44, 0x59, 0xde, 0x7e, 0xd8, 0x68 },
+  { 0xc5, 0xd2, 0x83, 0x4b, 0xf9, 0x8e, 0x90, 0x24, 0x5e, 0x54, 0x55, 0x73, 0xeb, 0x7e, 0x6b, 0xbc },
+  { 0xc5, 0xdd, 0x83, 0x99, 0x25, 0x7d, 0x88, 0x62, 0xf3, 0x95, 0x2b, 0xe7, 0x5c, 0x23, 0xe0, 0xeb },
+  { 0xc5, 0xfe, 0x45, 0xf2, 0x73, 0x4a, 0xfd, 0x47, 0xe2, 0x7c, 0xa3, 0xb0, 0x4a, 0x90, 0x21, 0x3c },
+  { 0xc6, 0x3a, 0x98, 0xca, 0x40, 0x4a, 0xa5, 0xee, 0x9f, 0xcf, 0xf1, 0xde, 0x48, 0x8c, 0x3f, 0x43 },
+  { 0xc6, 0x55, 0x6e, 0x08, 0x2a, 0xac, 0x04, 0x26, 0x05, 0x96, 0xb4, 0x04, 0x5b, 0xc1, 0x22, 0xde },
+  { 0xc6, 0x68, 0x87, 0x81, 0xf4, 0xab, 0x84, 0x48, 0x52, 0xf4, 0xe3, 0x35, 0x27, 0x72, 0x28, 0x9b },
+  { 0xc6, 0x7f, 0xf4, 0x09, 0xf2, 0x8f, 0x44, 0x88, 0x3b, 0xd5, 0x25, 0x1c, 0xea, 0x79, 0x72, 0x7d },
+  { 0xc6, 0x89, 0x14, 0x8a, 0xd9, 0x27, 0x56, 0x67, 0x92, 0x4a, 0xb3, 0x34, 0x10, 0x7b, 0x51, 0x7e },
+  { 0xc6, 0x8a, 0x6b, 0xaf, 0xb6, 0x67, 0xba, 0xd2, 0xf6, 0xd0, 0x20, 0xf8, 0x79, 0xbe, 0x1d, 0x11 },
+  { 0xc6, 0xae, 0x21, 0xca, 0xce, 0xaa, 0xd7, 0x34, 0x98, 0x7c, 0xb2, 0x42, 0x43, 0x79, 0x3b, 0xd5 },
+  { 0xc6, 0xc6, 0x3d, 0xa3, 0xbc, 0x2e, 0x47, 0x29, 0x1f, 0x63, 0x28, 0x0e, 0x05, 0x70, 0x61, 0xd0 },
+  { 0xc6, 0xce, 0xdb, 0x25, 0xb7, 0xd3, 0x90, 0xb5, 0x80, 0xea, 0x8e, 0xdb, 0x61, 0x4b, 0x16, 0x8b },
+  { 0xc6, 0xd4, 0x8c, 0x6a, 0xe6, 0x46, 0x1e, 0x0e, 0x82, 0x75, 0x35, 0x40, 0xa9, 0x85, 0xac, 0x9e },
+  { 0xc6, 0xd7, 0xfe, 0x7a, 0x46, 0xdc, 0x46, 0xf9, 0x62, 0xfe, 0x84, 0x13, 0xc6, 0xf5, 0x3f, 0xc9 },
+  { 0xc6, 0xdb, 0x73, 0x3e, 0x0b, 0x10, 0x8c, 0x25, 0x80, 0xa1, 0xd6, 0x52, 0x11, 0xf0, 0x6d, 0xbf },
+  { 0xc7, 0x38, 0xfc, 0x3f, 0x5a, 0xae, 0x1e, 0x8f, 0x86, 0xf7, 0x24, 0x9f, 0x6c, 0x82, 0xac, 0x81 },
+  { 0xc7, 0x3a, 0xe5, 0xba, 0x5a, 0x0a, 0x3f, 0x3a, 0xc7, 0x7f, 0x0a, 0x9e, 0x14, 0x77, 0x0e, 0x73 },
+  { 0xc7, 0x45, 0x48, 0x78, 0x28, 0xa1, 0xa6, 0xa7, 0x43, 0x48, 0x8e, 0xce, 0xbc, 0x55, 0xad, 0x44 },
+  { 0xc7, 0x4b, 0xfd, 0x02, 0xc7, 0xf1, 0x87, 0x7b, 0xbe, 0x71, 0x2c, 0x1d, 0xa5, 0xc4, 0xc1, 0x94 },
+  { 0xc7, 0x60, 0x0d, 0x72, 0x24, 0x7c, 0x5d, 0xfa, 0x1e, 0xc1, 0xa8, 0x8d, 0x23, 0xe6, 0xc8, 0x5e },
+  { 0xc7, 0x7c, 0x35, 0xa6, 0xfc, 0x3c, 0x0f, 0x12, 0xbf, 0x9e, 0x8b, 0xae, 0x48, 0xcb, 0xa5, 0x4b },
+  { 0xc7, 0x7d, 0x3b, 0x47, 0xf2, 0x29, 0x3e, 0x69, 0x41, 0x9b, 0x92, 0x52, 0x2c, 0x6f, 0x66, 0x47 },
+  { 0xc7, 0x90, 0x0a, 0x7f, 0xe9, 0x5a, 0x47, 0xee, 0xf3, 0xb3, 0x25, 0x07, 0x2a, 0xd2, 0xc2, 0x32 },
+  { 0xc7, 0xd5, 0x81, 0x9b, 0x26, 0xb4, 0x80, 0xa4, 0x9e, 0xb2, 0x6a, 0xeb, 0x63, 0xcc, 0x83, 0x1e },
+  { 0xc7, 0xe4, 0x3a, 0xd7, 0x9c, 0x5e, 0x5c, 0x02, 0x9d, 0x9f, 0x5f, 0xfd, 0xe2, 0x3e, 0x32, 0xcf },
+  { 0xc7, 0xea, 0xb6, 0x65, 0x76, 0x69, 0x6e, 0x11, 0xe3, 0xc1, 0x1f, 0xff, 0xf9, 0x2e, 0x13, 0xcc },
+  { 0xc7, 0xf1, 0x3e, 0xf3, 0x8f, 0x61, 0xee, 0x23, 0x67, 0xad, 0xa9, 0x4f, 0xdc, 0xc6, 0xd2, 0x06 },
+  { 0xc8, 0x2e, 0xc0, 0x03, 0x35, 0xcb, 0xb4, 0xb7, 0x44, 0x94, 0xae, 0xcf, 0x31, 0x60, 0x8f, 0xa1 },
+  { 0xc8, 0x30, 0xf6, 0xae, 0x7e, 0xe5, 0x8b, 0xcc, 0x2a, 0x67, 0x12, 0xfb, 0x33, 0xe9, 0x2d, 0x55 },
+  { 0xc8, 0x66, 0xc9, 0x95, 0xc0, 0xd2, 0xca, 0x7d, 0x01, 0x7f, 0xef, 0x0f, 0xc0, 0xc2, 0xe2, 0x68 },
+  { 0xc8, 0x80, 0xc6, 0x59, 0xcd, 0xc0, 0xf8, 0x4c, 0x4a, 0x66, 0xbc, 0x81, 0x8f, 0x89, 0x61, 0x8e },
+  { 0xc8, 0xc7, 0xda, 0x12, 0xf0, 0x87, 0xe8, 0xd1, 0x6d, 0x3e, 0x6a, 0x21, 0xb3, 0x71, 0xa5, 0xd3 },
+  { 0xc8, 0xfa, 0x5d, 0x69, 0xd9, 0xe5, 0x55, 0xeb, 0x16, 0x06, 0x8e, 0xf8, 0x7b, 0x1c, 0x9c, 0x45 },
+  { 0xc9, 0x19, 0x6e, 0x28, 0x36, 0x7e, 0x46, 0xf8, 0xa5, 0x5e, 0x04, 0xc2, 0x77, 0x43, 0x14, 0x8f },
+  { 0xc9, 0x2c, 0xfa, 0x54, 0xb5, 0xd0, 0x22, 0x63, 0x7f, 0xdc, 0xbd, 0xc1, 0xef, 0x64, 0x0d, 0x82 },
+  { 0xc9, 0xb7, 0xaf, 0xad, 0x3b, 0xfd, 0x92, 0x2e, 0x00, 0x6a, 0x6b, 0xfc, 0x1d, 0x4f, 0x3f, 0xe7 },
+  { 0xc9, 0xc2, 0x5f, 0xc5, 0x36, 0xde, 0x9a, 0x7c, 0xdc, 0x5b, 0x9a, 0x91, 0x6c, 0x45, 0x91, 0x10 },
+  { 0xc9, 0xd0, 0x2d, 0x3c, 0xfe, 0xef, 0x8b, 0x48, 0xfb, 0x71, 0xcb, 0x45, 0x20, 0xa4, 0xaa, 0x84 },
+  { 0xc9, 0xe7, 0x21, 0xeb, 0x29, 0xc9, 0x40, 0xc2, 0xe7, 0x43, 0x48, 0x5b, 0x04, 0x4c, 0x0a, 0x3f },
+  { 0xc9, 0xf6, 0xe5, 0x21, 0xa4, 0x9a, 0x2d, 0x15, 0xda, 0xc5, 0x6b, 0x6d, 0xdb, 0x3f, 0xb4, 0xc7 },
+  { 0xca, 0x09, 0xfa, 0x74, 0x06, 0xb7, 0xd2, 0xae, 0xa1, 0x0d, 0x96, 0x9b, 0x6f, 0xc9, 0x01, 0x95 },
+  { 0xca, 0x4f, 0x8c, 0x5b, 0x4d, 0x6f, 0xb9, 0xd6, 0x08, 0xbb, 0x96, 0xbc, 0x7e, 0xbd, 0x26, 0xc7 },
+  { 0xca, 0x50, 0xcc, 0x4b, 0x21, 0xb0, 0x15, 0x52, 0x55, 0xe0, 0x66, 0xfc, 0xd6, 0x39, 0x63, 0x31 },
+  { 0xca, 0x53, 0xfc, 0x8f, 0xd8, 0xb3, 0xc4, 0xa7, 0xdf, 0x89, 0xac, 0x86, 0xb2, 0x22, 0xeb, 0xa0 },
+  { 0xca, 0x54, 0xde, 0x69, 0xf7, 0xcd, 0xf4, 0xd7, 0x99, 0x6e, 0x86, 0xf3, 0x47, 0x12, 0x98, 0x92 },
+  { 0xca, 0x7a, 0xae, 0xbd, 0x86, 0x1a, 0x9e, 0xf4, 0x79, 0x67, 0xd3, 0x1c, 0x5a, 0x6c, 0x45, 0x55 },
+  { 0xca, 0x7a, 0xbc, 0x77, 0x4a, 0x2f, 0xa9, 0x50, 0x14, 0x68, 0x8b, 0xc0, 0x84, 0x9e, 0xee, 0x47 },
+  { 0xca, 0x7f, 0x16, 0x6a, 0x94, 0xee, 0xd1, 0xa3, 0x49, 0xde, 0xc6, 0xd6, 0xa3, 0x58, 0xbc, 0xad },
+  { 0xca, 0xc9, 0x92, 0x8a, 0x84, 0xe1, 0x00, 0x18, 0x17, 0xb2, 0x23, 0xf0, 0xce, 0xca, 0xa3, 0xf2 },
+  { 0xca, 0xd9, 0x82, 0xc9, 0xb4, 0x5b, 0xc5, 0xef, 0xf3, 0x4e, 0x4e, 0xa9, 0x82, 0xd5, 0xf1, 0xca },
+  { 0xca, 0xde, 0x12, 0x37, 0x47, 0x42, 0x6d, 0xf6, 0x95, 0x70, 0xa2, 0xbc, 0x87, 0x1d, 0x3b, 0xaf },
+  { 0xca, 0xe8, 0xf8, 0x3c, 0x06, 0x83, 0x1e, 0xc7, 0xbb, 0x6a, 0x3c, 0x07, 0xe9, 0x8e, 0x93, 0x42 },
+  { 0xcb, 0x18, 0xd8, 0xd5, 0xfb, 0xdc, 0xb1, 0xcd, 0x7b, 0xd3, 0x6c, 0x54, 0x23, 0x34, 0x88, 0x59 },
+  { 0xcb, 0x24, 0x21, 0x0d, 0xc8, 0x6d, 0x92, 0xdf, 0x97, 0xb3, 0x8c, 0xf2, 0xa5, 0x17, 0x82, 0xda },
+  { 0xcb, 0x4a, 0x7b, 0x50, 0x73, 0x72, 0xc2, 0x4f, 0x8b, 0x93, 0x90, 0xd2, 0x2d, 0x54, 0xa9, 0x18 },
+  { 0xcb, 0x83, 0x99, 0xdc, 0x0d, 0x40, 0x9f, 0xf1, 0xf5, 0x31, 0xef, 0x86, 0xb3, 0xb3, 0x49, 0x53 },
+  { 0xcb, 0x96, 0x26, 0x51, 0x7b, 0x44, 0x0f, 0x09, 0x9c, 0x0b, 0x6b, 0x27, 0xca, 0x65, 0x14, 0x2c },
+  { 0xcb, 0x96, 0xb0, 0xcf, 0x90, 0xab, 0x77, 0x77, 0xa2, 0xf6, 0xf0, 0x5e, 0x8a, 0xd3, 0xf6, 0x94 },
+  { 0xcb, 0x9b, 0x2e, 0x98, 0x06, 0xa7, 0xfb, 0xab, 0x3d, 0x81, 0x9c, 0xfe, 0x15, 0xf0, 0xf0, 0x5a },
+  { 0xcb, 0xa5, 0x6e, 0x93, 0x92, 0x52, 0xb0, 0x5d, 0xf7, 0xb7, 0xde, 0x87, 0x30, 0x7d, 0x12, 0xca },
+  { 0xcb, 0xad, 0x92, 0x8e, 0x10, 0xae, 0xee, 0x84, 0x87, 0x86, 0xcc, 0x55, 0x39, 0x4f, 0xb6, 0x92 },
+  { 0xcb, 0xb0, 0xee, 0x17, 0xc1, 0x30, 0x81, 0x48, 0x82, 0x3c, 0xc6, 0xda, 0x85, 0xbf, 0xf2, 0x5c },
+  { 0xcb, 0xc3, 0x73, 0xfb, 0xcb, 0x16, 0x53, 0xb4, 0xc5, 0x6b, 0xfa, 0xbb, 0xa3, 0x3e, 0xa5, 0x0d },
+  { 0xcb, 0xce, 0xd2, 0x09, 0xdd, 0x05, 0x75, 0xa2, 0x72, 0x12, 0xd3, 0xee, 0xe6, 0xae, 0xe3, 0xbc },
+  { 0xcb, 0xd9, 0x81, 0xa2, 0x3c, 0x59, 0x2f, 0xb9, 0xab, 0x97, 0x92, 0x23, 0xbb, 0x36, 0x8c, 0xd5 },
+  { 0xcb, 0xe5, 0xa1, 0x66, 0x55, 0x0a, 0x81, 0x29, 0xa5, 0xe6, 0xd3, 0x74, 0x90, 0x1d, 0xff, 0xad },
+  { 0xcb, 0xea, 0xfd, 0x37, 0xf1, 0x5e, 0x0d, 0xdd, 0xb0, 0x54, 0x0d, 0xbe, 0x15, 0xc5, 0x45, 0xa4 },
+  { 0xcc, 0x03, 0xc6, 0x8b, 0x83, 0x48, 0xb6, 0x23, 0x31, 0x96, 0x4d, 0x7a, 0x3d, 0xbe, 0xc3, 0x81 },
+  { 0xcc, 0x12, 0x58, 0x1e, 0x07, 0x9c, 0xd1, 0x83, 0x30, 0xa8, 0x99, 0x02, 0x62, 0x5b, 0x83, 0x47 },
+  { 0xcc, 0x19, 0x39, 0xe4, 0x76, 0x9d, 0x0c, 0x15, 0x7a, 0xce, 0x32, 0x6e, 0xfc, 0xfd, 0xcf, 0x80 },
+  { 0xcc, 0x29, 0x73, 0x68, 0x0c, 0x15, 0x08, 0x86, 0xcc, 0xe1, 0xed, 0x86, 0x93, 0xc3, 0xac, 0xa2 },
+  { 0xcc, 0x3d, 0x94, 0x2c, 0x69, 0x58, 0xbd, 0x16, 0xb1, 0xc6, 0x02, 0x62, 0x3f, 0x59, 0xe6, 0xe1 },
+  { 0xcc, 0x71, 0x38, 0x20, 0x2c, 0xd8, 0xf6, 0x77, 0x62, 0x12, 0xeb, 0xfc, 0x3a, 0x82, 0x0e, 0xcc },
+  { 0xcc, 0x72, 0x4e, 0xbe, 0x74, 0xa1, 0x09, 0xe3, 0x9c, 0x0b, 0x27, 0x84, 0xdd, 0xc9, 0x80, 0xca },
+  { 0xcc, 0x74, 0xdd, 0xb4, 0x5d, 0x7b, 0xc4, 0xd0, 0x4c, 0x2e, 0x6f, 0x19, 0x07, 0x41, 0x66, 0x99 },
+  { 0xcc, 0xa3, 0x3a, 0xe3, 0x0a, 0x58, 0xf3, 0x9e, 0x3f, 0xc5, 0xd8, 0x0f, 0x94, 0xdc, 0x03, 0x62 },
+  { 0xcc, 0xb5, 0x61, 0x07, 0xff, 0x04, 0x92, 0x23, 0x20, 0x65, 0xb8, 0x54, 0x93, 0xda, 0xa6, 0x35 },
+  { 0xcc, 0xb5, 0xfa, 0x95, 0x4f, 0xb7, 0x6f, 0x09, 0xca, 0xae, 0x9a, 0x8c, 0x66, 0x46, 0x21, 0x90 },
+  { 0xcc, 0xb8, 0x07, 0xeb, 0x79, 0xb0, 0xed, 0x0f, 0x5f, 0xdc, 0x46, 0x04, 0x45, 0xef, 0x70, 0x3a },
+  { 0xcc, 0xbd, 0x36, 0x74, 0x6e, 0xd4, 0x52, 0x58, 0x21, 0xa8, 0x08, 0x3b, 0x0d, 0x6d, 0x2c, 0x2c },
+  { 0xcc, 0xcf, 0xe9, 0xe9, 0xa1, 0x1b, 0x1d, 0xad, 0x04, 0xbe, 0xba, 0x46, 0xee, 0xfb, 0x73, 0x51 },
+  { 0xcc, 0xd6, 0xce, 0x50, 0x8e, 0xee, 0x4b, 0x3f, 0xca, 0x67, 0x21, 0x28, 0x33, 0xed, 0xcd, 0x85 },
+  { 0xcd, 0x03, 0x2a, 0xb6, 0x76, 0x4b, 0x55, 0x43, 0x8a, 0x7b, 0x0b, 0xfb, 0x5e, 0x78, 0x59, 0x5a },
+  { 0xcd, 0x13, 0x9a, 0xe6, 0xd0, 0x9f, 0x36, 0x65, 0xad, 0x09, 0xeb, 0x79, 0xda, 0x3f, 0x9e, 0x49 },
+  { 0xcd, 0x34, 0xb3, 0xb3, 0xef, 0x9e, 0x48, 0x52, 0x01, 0xe8, 0x41, 0xba, 0x71, 0xbe, 0xb2, 0x53 },
+  { 0xcd, 0x38, 0xad, 0x19, 0xf5, 0x1b, 0x10, 0x48, 0xd8, 0xe5, 0xe9, 0x9c, 0x86, 0xa2, 0xa6, 0x55 },
+  { 0xcd, 0x39, 0x9b, 0xc4, 0x22, 0x99, 0x2a, 0x36, 0x1b, 0xa9, 0x32, 0xcc, 0x50, 0xf4, 0x8b, 0x65 },
+  { 0xcd, 0x3e, 0x26, 0x78, 0x61, 0x36, 0xa4, 0x69, 0x2f, 0xd2, 0xcb, 0x2d, 0xfb, 0xc1, 0x92, 0x7e },
+  { 0xcd, 0x44, 0x23, 0xbd, 0x9f, 0x07, 0x63, 0x40, 0x9b, 0xae, 0x91, 0x11, 0xf8, 0x88, 0xf7, 0xc2 },
+  { 0xcd, 0x4d, 0xed, 0x1e, 0xde, 0x63, 0xc4, 0xdd, 0x09, 0xf3, 0xdd, 0x01, 0xbd, 0xa7, 0x45, 0x8c },
+  { 0xcd, 0x56, 0x8d, 0x6a, 0xcb, 0x2f, 0x14, 0x47, 0x7e, 0xbf, 0x7e, 0x59, 0xfb, 0x38, 0x22, 0x92 },
+  { 0xcd, 0x5a, 0xf6, 0x82, 0x68, 0x5c, 0xfe, 0xcb, 0xc2, 0x5a, 0x98, 0x3e, 0x16, 0xb9, 0xd8, 0x33 },
+  { 0xcd, 0x88, 0xef, 0x17, 0x36, 0x49, 0x72, 0x88, 0xc4, 0x53, 0x3b, 0xcc, 0xa3, 0x39, 0xf8, 0x81 },
+  { 0xcd, 0x8f, 0xa2, 0xe9, 0xf6, 0x25, 0x5e, 0xf3, 0xd3, 0xb9, 0xb5, 0xa4, 0xf2, 0x4a, 0x54, 0xf7 },
+  { 0xcd, 0x98, 0xbe, 0x8a, 0x48, 0xeb, 0xf6, 0x10, 0xc9, 0x60, 0x9a, 0x68, 0x8b, 0x9c, 0x57, 0xf2 },
+  { 0xcd, 0x9f, 0xea, 0x12, 0x05, 0x1e, 0x41, 0x4a, 0x6d, 0xfe, 0x17, 0x05, 0x20, 0x67, 0xda, 0x8e },
+  { 0xcd, 0xa3, 0x87, 0x14, 0x26, 0x79, 0x78, 0xb9, 0xa8, 0xb0, 0xb2, 0x4b, 0xee, 0x35, 0x29, 0xae },
+  { 0xcd, 0xb8, 0x1b, 0xf3, 0x3d, 0x83, 0x0e, 0xe4, 0xee, 0x06, 0x06, 0xee, 0x99, 0xe8, 0x4d, 0xba },
+  { 0xcd, 0xc1, 0xa5, 0xc6, 0x1d, 0x74, 0x88, 0xea, 0xdc, 0x9a, 0xba, 0x36, 0x16, 0x6b, 0x25, 0x3d },
+  { 0xcd, 0xda, 0xbf, 0xd6, 0x83, 0x63, 0xa7, 0x6c, 0xd3, 0x0b, 0xee, 0x4e, 0x80, 0x94, 0xc6, 0x46 },
+  { 0xce, 0x17, 0x32, 0x58, 0x34, 0xbf, 0x8b, 0x0a, 0x0d, 0x0d, 0x8d, 0xe0, 0x84, 0x78, 0xd4, 0x36 },
+  { 0xce, 0x24, 0x37, 0x47, 0xbf, 0x34, 0xa2, 0xde, 0x36, 0x6f, 0x84, 0x6b, 0x3f, 0x4c, 0xa7, 0x72 },
+  { 0xce, 0x4b, 0xbe, 0x11, 0xd6, 0x82, 0xc1, 0x5a, 0x49, 0x0a, 0xe1, 0x5a, 0x4a, 0x87, 0x16, 0xcf },
+  { 0xce, 0x5c, 0xc6, 0x26, 0x08, 0xbe, 0x2c, 0xd3, 0xed, 0x8a, 0xbd, 0x84, 0x4e, 0xfb, 0x89, 0x19 },
+  { 0xce, 0x64, 0x81, 0x2e, 0xb8, 0x3c, 0x95, 0x72, 0x3b, 0x04, 0xfb, 0x56, 0xd8, 0x16, 0x91, 0x0b },
+  { 0xce, 0x6c, 0x42, 0x70, 0xf6, 0x05, 0xad, 0x3c, 0xe5, 0xe8, 0x26, 0x78, 0xb0, 0xfc, 0x71, 0xf8 },
+  { 0xce, 0x82, 0xa6, 0x75, 0xc7, 0x73, 0xff, 0x21, 0xe0, 0xff, 0xc0, 0xa4, 0xd1, 0xc9, 0x0a, 0x71 },
+  { 0xce, 0x84, 0x67, 0xae, 0x2a, 0x3a, 0x5b, 0xc8, 0x8c, 0xa7, 0x2a, 0x2c, 0xe4, 0x4c, 0xe2, 0x8c },
+  { 0xce, 0x89, 0x52, 0x9d, 0x6e, 0x98, 0xa1, 0x3d, 0xdf, 0x3d, 0x84, 0x82, 0x7b, 0xbd, 0xfe, 0x68 },
+  { 0xce, 0x90, 0x4c, 0x0a, 0xe5, 0x8d, 0x36, 0xd0, 0x85, 0xcd, 0x50, 0x69, 0x89, 0x11, 0x6b, 0x0b },
+  { 0xce, 0xa9, 0xf7, 0x20, 0x36, 0xdc, 0x6f, 0x7a, 0xf5, 0xef, 0xf5, 0x24, 0x59, 0x06, 0x62, 0x90 },
+  { 0xce, 0xdb, 0xd6, 0x7d, 0x1f, 0xf3, 0x21, 0xc9, 0x96, 0x05, 0x1e, 0xec, 0x84, 0x3f, 0x87, 0x16 },
+  { 0xce, 0xf0, 0x15, 0x95, 0x00, 0x06, 0x27, 0xee, 0x50, 0x86, 0x3d, 0x42, 0x90, 0x37, 0x2c, 0x27 },
+  { 0xce, 0xf2, 0x28, 0x7d, 0x5f, 0xd8, 0x02, 0x16, 0xb2, 0x20, 0x0f, 0xb2, 0xef, 0x1a, 0xdf, 0xa8 },
+  { 0xcf, 0x0c, 0x59, 0x3c, 0x56, 0x3c, 0x84, 0xfd, 0xaf, 0x0f, 0x74, 0x1a, 0xdb, 0x36, 0x74, 0x45 },
+  { 0xcf, 0x3a, 0x9a, 0xda, 0x26, 0x92, 0xbb, 0x42, 0xf8, 0x11, 0x92, 0x89, 0x77, 0x52, 0xb9, 0x12 },
+  { 0xcf, 0x3c, 0x27, 0x25, 0xf7, 0x36, 0xd4, 0xbc, 0xb8, 0x4a, 0xd6, 0xf4, 0x2d, 0xe6, 0x2a, 0x41 },
+  { 0xcf, 0x50, 0x79, 0x10, 0xd6, 0xe7, 0x45, 0x68, 0xa6, 0x8a, 0xc9, 0x49, 0x53, 0x7b, 0xcc, 0xf9 },
+  { 0xcf, 0x63, 0xff, 0xac, 0x9d, 0xa8, 0x9e, 0xf0, 0x9c, 0x6c, 0x97, 0x30, 0x83, 0x06, 0x1a, 0x47 },
+  { 0xcf, 0x90, 0x69, 0xf9, 0x2a, 0x43, 0xf7, 0x19, 0x97, 0x4e, 0xe7, 0x12, 0xc5, 0x0c, 0xd9, 0x32 },
+  { 0xcf, 0xad, 0x2b, 0x9c, 0xa8, 0xb8, 0xfe, 0xc7, 0xfb, 0x16, 0x11, 0xd6, 0x56, 0xcc, 0x76, 0x5b },
+  { 0xcf, 0xb3, 0x26, 0x0c, 0x60, 0x3b, 0x03, 0x41, 0xd4, 0x9d, 0xdf, 0xc9, 0x40, 0x51, 0xec, 0x10 },
+  { 0xcf, 0xb8, 0x3a, 0x3b, 0x05, 0x13, 0xac, 0xaf, 0x8b, 0xe4, 0xca, 0xe1, 0x51, 0x22, 0x81, 0xdc },
+  { 0xcf, 0xc2, 0x26, 0xd0, 0x4d, 0x74, 0x90, 0xb6, 0x9e, 0x15, 0x5a, 0xbd, 0x77, 0x41, 0xe9, 0x8c },
+  { 0xcf, 0xce, 0x55, 0x96, 0xa7, 0xe8, 0xca, 0x13, 0x52, 0x9e, 0x98, 0x04, 0xca, 0xd6, 0x93, 0xef },
+  { 0xcf, 0xd6, 0xa8, 0xb2, 0x3d, 0x12, 0xb0, 0x46, 0x2b, 0xaf, 0x6a, 0x05, 0xef, 0x34, 0x7c, 0xd8 },
+  { 0xcf, 0xdb, 0x4d, 0x04, 0x27, 0xa1, 0xea, 0x80, 0x85, 0xc6, 0xbc, 0x6e, 0xb9, 0x02, 0x59, 0xd8 },
+  { 0xcf, 0xe2, 0x18, 0x5f, 0x84, 0xce, 0x85, 0x01, 0x93, 0x3b, 0xeb, 0x5c, 0x5e, 0x1f, 0xd0, 0x53 },
+  { 0xcf, 0xe6, 0x2e, 0xd7, 0x12, 0x5f, 0xf9, 0xfa, 0xe9, 0x9b, 0x4c, 0x8a, 0x36, 0x7c, 0x03, 0x99 },
+  { 0xcf, 0xee, 0x10, 0xbd, 0x71, 0x19, 0xf1, 0x0b, 0x13, 0x69, 0x21, 0xce, 0xd2, 0xee, 0x89, 0x72 },
+  { 0xcf, 0xef, 0x1a, 0x2d, 0x1f, 0x6a, 0x5e, 0xe7, 0xa5, 0xe1, 0xf4, 0x3f, 0x30, 0x56, 0xf1, 0x12 },
+  { 0xcf, 0xf1, 0xe9, 0x17, 0x0b, 0xdb, 0xc2, 0x98, 0x59, 0xb8, 0x15, 0x20, 0x3e, 0xdf, 0x18, 0xfa },
+  { 0xcf, 0xf5, 0x78, 0xe5, 0xc6, 0x0d, 0xe8, 0xca, 0xec, 0xbe, 0xe7, 0xf2, 0xc9, 0xbb, 0xb5, 0x7b },
+  { 0xcf, 0xf9, 0x95, 0x0d, 0x4e, 0x65, 0x00, 0x94, 0xf6, 0x5f, 0x40, 0xd1, 0x79, 0xa9, 0x88, 0x2d },
+  { 0xcf, 0xff, 0xc4, 0xb9, 0x7d, 0x01, 0xcc, 0x3e, 0x7b, 0x9f, 0x47, 0x57, 0x5f, 0x7b, 0x11, 0xec },
+  { 0xd0, 0x0f, 0x6f, 0x8b, 0xa8, 0x95, 0x59, 0xe4, 0xb2, 0x09, 0x72, 0xa4, 0x78, 0xfc, 0x03, 0x70 },
+  { 0xd0, 0x10, 0xe3, 0xdf, 0xe7, 0x36, 0x6e, 0x47, 0x56, 0x1c, 0x08, 0x80, 0x79, 0xa5, 0x94, 0x39 },
+  { 0xd0, 0x26, 0x71, 0x6b, 0x3c, 0x5b, 0xe2, 0xc9, 0x51, 0xcc, 0x4c, 0x06, 0x43, 0x17, 0xc5, 0x24 },
+  { 0xd0, 0x49, 0x8b, 0xac, 0xa9, 0x89, 0xe7, 0x92, 0xdb, 0x4b, 0x82, 0x70, 0xa0, 0x2b, 0x96, 0x24 },
+  { 0xd0, 0x71, 0xd2, 0xec, 0x86, 0xb9, 0xd5, 0x2b, 0x58, 0x5c, 0xc0, 0x38, 0x24, 0x80, 0xb3, 0x51 },
+  { 0xd0, 0x78, 0x67, 0x4a, 0xfd, 0xf2, 0x4a, 0x45, 0x47, 0xb4, 0xb3, 0x28, 0x90, 0xfd, 0xc6, 0x14 },
+  { 0xd0, 0x78, 0xd2, 0x58, 0x73, 0xc5, 0xb9, 0x9f, 0x78, 0xfa, 0x26, 0x72, 0x45, 0xa2, 0xaf, 0x02 },
+  { 0xd0, 0x8f, 0xcc, 0xfb, 0xeb, 0xaa, 0x53, 0x1c, 0x4a, 0x4f, 0xa7, 0x35, 0x93, 0x93, 0xa0, 0xa9 },
+  { 0xd0, 0x90, 0x83, 0x6f, 0x0a, 0x4e, 0xa8, 0xdb, 0x9a, 0xc7, 0xab, 0xb7, 0xd6, 0xad, 0xf6, 0x1e },
+  { 0xd0, 0x99, 0x35, 0x80, 0x2d, 0x67, 0x60, 0xae, 0x58, 0x25, 0x36, 0x85, 0xff, 0x64, 0x92, 0x68 },
+  { 0xd0, 0x9a, 0x75, 0x04, 0xee, 0x8c, 0x87, 0x17, 0xac, 0x3e, 0x24, 0xd2, 0x63, 0xe7, 0x81, 0x4d },
+  { 0xd0, 0x9f, 0x18, 0x30, 0xfb, 0x31, 0x65, 0x15, 0xb9, 0x06, 0x94, 0xc4, 0x57, 0x28, 0xd7, 0x02 },
+  { 0xd0, 0xa3, 0x79, 0x94, 0x6e, 0xd7, 0x7b, 0x1b, 0x12, 0x62, 0x30, 0xca, 0x68, 0x46, 0x13, 0x33 },
+  { 0xd0, 0xaf, 0x33, 0x86, 0x55, 0x12, 0xe9, 0xb6, 0x90, 0x07, 0x14, 0xc2, 0x6d, 0xb5, 0xfa, 0x23 },
+  { 0xd0, 0xb2, 0x6e, 0x90, 0x83, 0x70, 0x68, 0x3a, 0xd9, 0x9b, 0xc6, 0xb5, 0x21, 0x37, 0xa7, 0x84 },
+  { 0xd0, 0xb9, 0xdf, 0x57, 0xbf, 0xea, 0x66, 0x37, 0x8c, 0x04, 0x18, 0xec, 0x68, 0xcf, 0xe3, 0x7f },
+  { 0xd0, 0xb9, 0xf7, 0x05, 0xaa, 0x5f, 0x61, 0xf4, 0x7a, 0x74, 0x8a, 0x66, 0x00, 0x9a, 0xe2, 0xd2 },
+  { 0xd0, 0xcb, 0x28, 0xe1, 0xb7, 0xbd, 0x6c, 0x7f, 0x68, 0x3a, 0x09, 0x17, 0xb5, 0x9f, 0x70, 0x7e },
+  { 0xd0, 0xcd, 0xaf, 0xcb, 0x00, 0x0b, 0x9a, 0xe0, 0x4a, 0xc4, 0x65, 0xf1, 0x77, 0x88, 0xad, 0x11 },
+  { 0xd0, 0xe1, 0x5a, 0x3c, 0xe3, 0x22, 0xc5, 0xaf, 0x60, 0xf0, 0x73, 0x43, 0x59, 0x43, 0x92, 0xaf },
+  { 0xd0, 0xe9, 0xbe, 0xb2, 0x34, 0x75, 0x95, 0xc6, 0xc7, 0xd1, 0x58, 0xe9, 0xd8, 0x3d, 0x2d, 0xa8 },
+  { 0xd1, 0x00, 0xb1, 0x1b, 0xe3, 0x4a, 0x1e, 0x5b, 0x78, 0x32, 0xb1, 0xb5, 0x3f, 0x71, 0x14, 0x97 },
+  { 0xd1, 0x70, 0x31, 0x7a, 0xe4, 0xc7, 0xd9, 0x97, 0xa9, 0x89, 0xc7, 0xd6, 0x56, 0x7c, 0x28, 0x40 },
+  { 0xd1, 0x75, 0x25, 0x8b, 0x29, 0x73, 0xb9, 0x17, 0xa0, 0x5b, 0x46, 0xdf, 0x4e, 0x1c, 0xf1, 0x5d },
+  { 0xd1, 0x7a, 0x67, 0x10, 0x29, 0xb1, 0x53, 0x2b, 0x19, 0x7d, 0xef, 0xca, 0x5f, 0x36, 0x49, 0xa7 },
+  { 0xd1, 0x7a, 0x8c, 0x44, 0x0d, 0x6b, 0xe7, 0x9f, 0xae, 0x39, 0x3a, 0x4b, 0x46, 0x66, 0x11, 0x64 },
+  { 0xd1, 0xa1, 0x84, 0x1b, 0x7f, 0x20, 0x07, 0xa2, 0x44, 0x39, 0xac, 0x24, 0x83, 0x74, 0x63, 0x0a },
+  { 0xd1, 0xa9, 0x47, 0x8b, 0x99, 0xd6, 0xa5, 0x5e, 0x13, 0xa9, 0xfd, 0x42, 0x62, 0xda, 0x7c, 0xd4 },
+  { 0xd1, 0xb4, 0x07, 0x59, 0x25, 0xe8, 0xd3, 0x03, 0x1a, 0x76, 0x16, 0xd2, 0xf0, 0x2f, 0xdd, 0x1f },
+  { 0xd1, 0xc3, 0x52, 0x0b, 0x57, 0xc3, 0x48, 0xbc, 0x21, 0xd5, 0x43, 0x69, 0x9b, 0xc8, 0x8e, 0x7e },
+  { 0xd1, 0xd7, 0x04, 0xa7, 0x14, 0x6e, 0x95, 0x70, 0x9b, 0x57, 0xb6, 0xd4, 0xca, 0xc3, 0xf7, 0x88 },
+  { 0xd2, 0x0e, 0x61, 0xc8, 0x6e, 0xd7, 0x29, 0x78, 0x0f, 0xec, 0xa1, 0x62, 0x16, 0x69, 0x12, 0xca },
+  { 0xd2, 0x23, 0xbc, 0x6f, 0x13, 0x35, 0x86, 0x42, 0xf0, 0x2d, 0xda, 0xcf, 0xaf, 0x4a, 0x90, 0xc9 },
+  { 0xd2, 0x45, 0xe2, 0xf2, 0x7c, 0x84, 0x01, 0x60, 0x41, 0xe9, 0x49, 0x6b, 0x66, 0xb7, 0x22, 0xfe },
+  { 0xd2, 0x50, 0x18, 0x34, 0x9c, 0x54, 0x43, 0x20, 0xbf, 0x3f, 0xd5, 0x09, 0x2e, 0xe0, 0x72, 0xbc },
+  { 0xd2, 0x8a, 0xfe, 0x05, 0x17, 0xa0, 0x46, 0x26, 0x5c, 0x41, 0x81, 0x81, 0xfa, 0x9d, 0xd9, 0xa1 },
+  { 0xd2, 0x90, 0x1c, 0x34, 0xbb, 0x64, 0x96, 0xbb, 0x96, 0xc7, 0xbc, 0x78, 0xa9, 0xe6, 0x14, 0x2a },
+  { 0xd2, 0xc3, 0x05, 0xa4, 0x43, 0xdf, 0xc4, 0x9e, 0x84, 0x30, 0x96, 0x4d, 0x7c, 0x1b, 0xd1, 0xb7 },
+  { 0xd2, 0xc4, 0xf8, 0xa4, 0xa9, 0x8a, 0x90, 0x5a, 0x9d, 0xee, 0xf3, 0xba, 0x73, 0x80, 0xed, 0x64 },
+  { 0xd2, 0xc8, 0xe6, 0xaa, 0x81, 0x72, 0xb1, 0x6c, 0x8a, 0xa9, 0xaa, 0xe7, 0x39, 0xac, 0x9c, 0x5e },
+  { 0xd2, 0xc9, 0x57, 0xdd, 0x77, 0x46, 0x52, 0x1b, 0x51, 0xbb, 0x09, 0xfd, 0xe2, 0x5c, 0x57, 0x74 },
+  { 0xd2, 0xd8, 0xc4, 0xf1, 0xea, 0x7f, 0x34, 0x7c, 0x8b, 0xcc, 0x7d, 0x24, 0xf4, 0x5a, 0xa3, 0x38 },
+  { 0xd2, 0xde, 0xdd, 0xb7, 0x7c, 0x8b, 0x82, 0x3e, 0x4b, 0xe9, 0xc5, 0x7c, 0xb3, 0xc6, 0x9a, 0xdc },
+  { 0xd2, 0xf7, 0x13, 0xc7, 0x8a, 0x9e, 0xbb, 0xa9, 0xda, 0x6d, 0x10, 0xae, 0xef, 0xc6, 0xf2, 0x0f },
+  { 0xd3, 0x17, 0x14, 0x07, 0xc3, 0xa8, 0xbb, 0x40, 0x1a, 0x3a, 0x62, 0xeb, 0x57, 0x8f, 0x48, 0xfb },
+  { 0xd3, 0x26, 0xdb, 0x52, 0x4d, 0x93, 0xfa, 0x28, 0x97, 0xab, 0x69, 0xc4, 0x2d, 0x6f, 0xb6, 0x98 },
+  { 0xd3, 0x39, 0xb9, 0x5f, 0x27, 0x3f, 0x8c, 0x35, 0x50, 0xdc, 0x4d, 0xaa, 0x67, 0xa4, 0xaa, 0x94 },
+  { 0xd3, 0x41, 0xd3, 0x97, 0x74, 0x27, 0x7c, 0xee, 0x6a, 0x1d, 0x37, 0x8a, 0x01, 0x3f, 0x92, 0xac },
+  { 0xd3, 0x42, 0x3d, 0x76, 0x00, 0x87, 0x91, 0x74, 0xc0, 0x38, 0xf5, 0x3e, 0x5e, 0xbb, 0xf9, 0xd3 },
+  { 0xd3, 0x45, 0x6b, 0x4c, 0xf1, 0xbd, 0x1a, 0x7b, 0x8f, 0xb9, 0x07, 0xaf, 0x1a, 0x80, 0xee, 0x15 },
+  { 0xd3, 0x4b, 0x93, 0x36, 0x60, 0xe2, 0x9c, 0x0a, 0x0a, 0x04, 0x00, 0x4f, 0x15, 0xd7, 0xe1, 0x60 },
+  { 0xd3, 0x63, 0x08, 0x38, 0x72, 0x41, 0xe9, 0x8f, 0x81, 0x36, 0x46, 0xf3, 0x46, 0xe7, 0xf9, 0xf7 },
+  { 0xd3, 0x9e, 0x29, 0xb0, 0x3a, 0xf3, 0xc2, 0x86, 0x41, 0x08, 0x4d, 0xd1, 0x52, 0x8a, 0xae, 0x05 },
+  { 0xd3, 0xbb, 0x42, 0x22, 0x8a, 0x6c, 0xd4, 0x52, 0xc1, 0x11, 0xc1, 0x93, 0x25, 0x03, 0xcc, 0x03 },
+  { 0xd4, 0x4d, 0x90, 0xe7, 0xc3, 0x89, 0x16, 0x5f, 0x50, 0x34, 0xb5, 0x84, 0x40, 0x77, 0x77, 0x7f },
+  { 0xd4, 0x5b, 0xf7, 0x18, 0x71, 0xb1, 0x96, 0x02, 0x28, 0x29, 0xaa, 0x3b, 0x96, 0xbf, 0xcf, 0xd4 },
+  { 0xd4, 0x5e, 0xbf, 0x13, 0x0e, 0xd9, 0x07, 0x0e, 0xa8, 0xeb, 0xd5, 0x61, 0x76, 0xe4, 0x8a, 0x38 },
+  { 0xd4, 0x73, 0x87, 0x65, 0x8e, 0xd4, 0x50, 0xdb, 0x77, 0xc3, 0xf1, 0x89, 0xb9, 0x69, 0xcc, 0x00 },
+  { 0xd4, 0x80, 0x67, 0x75, 0x69, 0x3f, 0xca, 0xaa, 0x24, 0xcf, 0x00, 0xfc, 0x00, 0xed, 0xcd, 0xf3 },
+  { 0xd4, 0x83, 0xf6, 0x54, 0x68, 0xd9, 0xa2, 0x65, 0x66, 0x19, 0x17, 0xba, 0xe1, 0xa5, 0x4f, 0x3e },
+  { 0xd4, 0x94, 0x2f, 0x4b, 0x55, 0x31, 0x3f, 0xf2, 0x69, 0x48, 0x85, 0x27, 0xd8, 0x4c, 0xe3, 0x5c },
+  { 0xd4, 0x9a, 0xff, 0x83, 0xf7, 0x7a, 0x1b, 0x90, 0x41, 0xad, 0x71, 0x85, 0xdf, 0x3c, 0x22, 0x77 },
+  { 0xd4, 0xaa, 0x89, 0xe9, 0x6d, 0x29, 0x02, 0x69, 0x2f, 0x5c, 0x45, 0xf3, 0x69, 0x03, 0xd3, 0x36 },
+  { 0xd4, 0xc5, 0x90, 0xcc, 0xfb, 0x61, 0x1a, 0x73, 0xb3, 0x33, 0x13, 0x59, 0x70, 0x0c, 0x01, 0xa3 },
+  { 0xd5, 0x41, 0xb2, 0x0e, 0xae, 0x22, 0x1a, 0x8e, 0xe3, 0x21, 0x37, 0x5e, 0x59, 0x71, 0xe7, 0x66 },
+  { 0xd5, 0x4c, 0xd4, 0x1e, 0xcf, 0xd5, 0x9e, 0x4b, 0x72, 0xd2, 0xc0, 0x86, 0x15, 0x2b, 0x9a, 0x75 },
+  { 0xd5, 0x61, 0x84, 0x64, 0xdb, 0xdc, 0x29, 0x81, 0xf6, 0xaa, 0x8b, 0x95, 0x58, 0x28, 0xee, 0xb4 },
+  { 0xd5, 0x63, 0xba, 0x38, 0x15, 0x1b, 0x82, 0x04, 0xc9, 0xf5, 0xc9, 0xf5, 0x8e, 0x78, 0x14, 0x55 },
+  { 0xd5, 0x73, 0x08, 0x95, 0x34, 0xca, 0x59, 0x6e, 0x64, 0xef, 0xef, 0x47, 0x4b, 0xe7, 0xb6, 0xbc },
+  { 0xd5, 0x79, 0x13, 0x08, 0x8e, 0x0c, 0x49, 0xac, 0x3a, 0x71, 0x6b, 0xf9, 0x83, 0x7b, 0x28, 0x4f },
+  { 0xd5, 0x7e, 0xb2, 0x82, 0xd7, 0x54, 0x00, 0x51, 0xbc, 0x9b, 0x54, 0x27, 0xcf, 0x96, 0x6f, 0x03 },
+  { 0xd5, 0x97, 0xd3, 0x5c, 0x60, 0x22, 0xc5, 0x90, 0xd6, 0xe7, 0x5e, 0x86, 0x57, 0x38, 0x55, 0x8a },
+  { 0xd5, 0xaa, 0x74, 0x72, 0xe7, 0xf2, 0xcc, 0x17, 0xe8, 0x93, 0xa1, 0xa3, 0x6f, 0x8d, 0xad, 0xf0 },
+  { 0xd5, 0xc6, 0xb8, 0x12, 0x12, 0xad, 0x86, 0xfd, 0x95, 0x42, 0xa1, 0xfe, 0xda, 0xf5, 0x7c, 0xae },
+  { 0xd5, 0xd2, 0xd4, 0x4f, 0xb7, 0x37, 0x85, 0x99, 0x6c, 0xcc, 0x24, 0xae, 0x3a, 0x0f, 0x5c, 0xef },
+  { 0xd5, 0xe1, 0x70, 0x22, 0xd1, 0xec, 0xc2, 0x0f, 0xd9, 0xb5, 0x3d, 0xc4, 0x64, 0xc3, 0x02, 0xf1 },
+  { 0xd5, 0xe2, 0x70, 0x51, 0x51, 0x2c, 0x1e, 0x74, 0x45, 0xa9, 0xbf, 0x91, 0x50, 0x1b, 0xda, 0x09 },
+  { 0xd5, 0xe5, 0xb3, 0xec, 0x07, 0x4f, 0xff, 0x89, 0x76, 0x01, 0x7e, 0xf1, 0x21, 0xd2, 0x61, 0x29 },
+  { 0xd5, 0xf9, 0x65, 0xc1, 0x59, 0xe2, 0x6a, 0x1f, 0xb4, 0x9a, 0x22, 0xa4, 0x7f, 0xbd, 0x1d, 0xd0 },
+  { 0xd6, 0x05, 0xed, 0x12, 0xf4, 0xea, 0xaa, 0xec, 0x3d, 0xcd, 0x5a, 0xa9, 0x09, 0xa4, 0xba, 0xd7 },
+  { 0xd6, 0x16, 0x29, 0xbb, 0xbe, 0x03, 0x5f, 0x45, 0x55, 0x2e, 0x31, 0xce, 0xf7, 0xd5, 0x91, 0xb2 },
+  { 0xd6, 0x22, 0x83, 0xae, 0xd0, 0xf4, 0x19, 0x9a, 0xdb, 0x23, 0x33, 0xde, 0x4c, 0x26, 0x3e, 0x9c },
+  { 0xd6, 0x2d, 0x7d, 0x1a, 0x97, 0x4c, 0x31, 0xc5, 0x80, 0x3f, 0x96, 0xa8, 0xc1, 0x55, 0x25, 0x10 },
+  { 0xd6, 0x32, 0xb7, 0x4f, 0xea, 0x53, 0x3d, 0x59, 0x3a, 0xf8, 0x2c, 0xf1, 0x6e, 0x7c, 0x5e, 0x4a },
+  { 0xd6, 0x50, 0x28, 0x52, 0x47, 0x61, 0xef, 0x52, 0xfb, 0xbd, 0xeb, 0xab, 0x46, 0xf7, 0x9d, 0x0f },
+  { 0xd6, 0x59, 0x00, 0xfe, 0xfa, 0x7d, 0xc1, 0x8a, 0xc3, 0xad, 0x99, 0xc2, 0x13, 0xe2, 0xfa, 0x4e },
+  { 0xd6, 0x95, 0x59, 0xf9, 0xc9, 0xdc, 0x6e, 0xf5, 0x28, 0xd8, 0x41, 0xbf, 0x9d, 0x91, 0xb2, 0x75 },
+  { 0xd6, 0xa4, 0x42, 0x77, 0xc3, 0xeb, 0x4f, 0x9d, 0x03, 0x91, 0x85, 0xe0, 0xec, 0xf7, 0xbf, 0xa6 },
+  { 0xd6, 0xac, 0xff, 0x6a, 0xed, 0x0f, 0x04, 0x69, 0x0f, 0xe4, 0x02, 0x4d, 0x58, 0xff, 0x4c, 0xe3 },
+  { 0xd6, 0xb8, 0xbe, 0xeb, 0x05, 0xe5, 0xb7, 0x30, 0x08, 0x4d, 0x4b, 0x8f, 0x38, 0x1b, 0xbf, 0x8d },
+  { 0xd6, 0xd1, 0xdd, 0xd2, 0x1e, 0x9d, 0x17, 0xea, 0x5f, 0x32, 0x5f, 0xa0, 0x93, 0x05, 0x06, 0x9c },
+  { 0xd6, 0xd5, 0xdd, 0x8f, 0xd3, 0x22, 0xd3, 0xcf, 0x87, 0x4e, 0x65, 0x1e, 0x7b, 0x6c, 0x16, 0x57 },
+  { 0xd6, 0xdc, 0x9b, 0x45, 0x08, 0xda, 0x40, 0x7e, 0x24, 0x37, 0xbf, 0xa4, 0xde, 0x53, 0xd1, 0xb2 },
+  { 0xd7, 0x26, 0x62, 0x1c, 0x67, 0x65, 0x52, 0xaf, 0xa5, 0x03, 0xb7, 0x94, 0x2a, 0xf5, 0xaf, 0xa2 },
+  { 0xd7, 0x3a, 0xd6, 0x14, 0xf1, 0xc2, 0x35, 0x79, 0x97, 0xc8, 0x8f, 0x37, 0xe7, 0x5b, 0x18, 0xfe },
+  { 0xd7, 0x4a, 0x81, 0xfc, 0xd8, 0x9c, 0x5c, 0xf0, 0xbd, 0x4c, 0x88, 0xeb, 0x20, 0x7e, 0xbd, 0x62 },
+  { 0xd7, 0x63, 0xe3, 0xa9, 0xcd, 0xcd, 0xd5, 0x6c, 0x71, 0x5e, 0xc8, 0x26, 0x10, 0x6f, 0xab, 0x6a },
+  { 0xd7, 0x75, 0x9f, 0xa9, 0x19, 0x02, 0xed, 0xd9, 0x3f, 0x15, 0x68, 0xa3, 0x7d, 0xc7, 0x0c, 0xdb },
+  { 0xd7, 0x82, 0x54, 0x38, 0x18, 0xb6, 0x32, 0x0e, 0x4f, 0x60, 0xd7, 0x7d, 0xa2, 0xb5, 0x96, 0xde },
+  { 0xd7, 0x87, 0xec, 0x67, 0x85, 0xb0, 0xcc, 0xfb, 0xd8, 0x44, 0xc7, 0x86, 0x6d, 0xb9, 0x66, 0x7d },
+  { 0xd7, 0x89, 0x1b, 0x0f, 0xaa, 0x4c, 0x7f, 0x76, 0x44, 0x82, 0x76, 0x2d, 0x0e, 0xd4, 0x27, 0xa5 },
+  { 0xd7, 0x9d, 0xf0, 0x68, 0x94, 0xe3, 0xc1, 0x58, 0x5a, 0x47, 0xc2, 0x80, 0x73, 0x32, 0xb3, 0x19 },
+  { 0xd7, 0xb5, 0x83, 0x03, 0xec, 0x8d, 0x8c, 0x4d, 0xbc, 0xbf, 0x54, 0xd3, 0xb9, 0x73, 0x4c, 0x7e },
+  { 0xd7, 0xdd, 0x56, 0x67, 0x7e, 0x4e, 0xc1, 0xe6, 0x62, 0x74, 0x19, 0x47, 0x8a, 0x4a, 0x96, 0x68 },
+  { 0xd7, 0xf5, 0xbf, 0x13, 0x8c, 0xfc, 0x7f, 0xea, 0xb7, 0xb8, 0xef, 0x15, 0x34, 0xc8, 0xb4, 0x77 },
+  { 0xd8, 0x16, 0xfe, 0xa5, 0x59, 0xb4, 0x7f, 0x9a, 0x67, 0x26, 0x04, 0xdf, 0x06, 0xf9, 0xd2, 0xe3 },
+  { 0xd8, 0x1b, 0xb6, 0x96, 0x5e, 0x6c, 0x99, 0xb3, 0xbe, 0x99, 0xff, 0xd8, 0x97, 0x87, 0x40, 0xe4 },
+  { 0xd8, 0x26, 0x75, 0xce, 0x67, 0xca, 0xf1, 0x6a, 0xfe, 0x5e, 0xd6, 0xb6, 0xfa, 0xc8, 0xaa, 0x37 },
+  { 0xd8, 0x29, 0x5e, 0xff, 0x5d, 0xcc, 0x43, 0x36, 0x0a, 0xfa, 0x87, 0x22, 0x1e, 0xa6, 0x02, 0x1f },
+  { 0xd8, 0x2c, 0x8a, 0x58, 0x09, 0x8a, 0x6b, 0x46, 0xc5, 0xb8, 0x1c, 0x16, 0x18, 0x03, 0x54, 0xd1 },
+  { 0xd8, 0x5f, 0x1e, 0x35, 0xc5, 0x44, 0x5a, 0xc8, 0x98, 0x74, 0x67, 0x19, 0xa3, 0xd9, 0x3f, 0x09 },
+  { 0xd8, 0x6d, 0xeb, 0x10, 0x0c, 0x6a, 0xbe, 0xd1, 0x58, 0x8a, 0xa8, 0x4b, 0x2f, 0x7b, 0x3a, 0x98 },
+  { 0xd8, 0x86, 0x91, 0xc9, 0x95, 0x00, 0x8b, 0x9a, 0xb6, 0x1a, 0x44, 0xbb, 0x68, 0x6b, 0x32, 0xe4 },
+  { 0xd8, 0x9f, 0xed, 0xde, 0xd0, 0x43, 0x6f, 0xde, 0xda, 0x7c, 0x3c, 0x37, 0xe2, 0xfb, 0x7c, 0xf1 },
+  { 0xd8, 0xac, 0xaa, 0x98, 0x0c, 0xda, 0x94, 0xb6, 0x50, 0x66, 0x56, 0x8d, 0xd0, 0x4d, 0x9e, 0xb0 },
+  { 0xd8, 0xb2, 0xc8, 0x1c, 0xea, 0x5a, 0xf0, 0x4f, 0x79, 0x5e, 0xb3, 0xdc, 0x65, 0x73, 0xd7, 0x2b },
+  { 0xd8, 0xdf, 0x25, 0x6c, 0x0d, 0x89, 0xe4, 0x94, 0xa9, 0xfb, 0x3e, 0x9a, 0xbb, 0x8e, 0x44, 0xac },
+  { 0xd8, 0xe4, 0xc8, 0xe2, 0xd2, 0x10, 0x27, 0x0c, 0xd1, 0xe0, 0xf6, 0xd1, 0xb4, 0x58, 0x2b, 0x91 },
+  { 0xd9, 0x02, 0x05, 0xe2, 0x9b, 0xb7, 0x3a, 0x4c, 0xdf, 0x28, 0xea, 0x76, 0x62, 0xba, 0x0c, 0x3c },
+  { 0xd9, 0x12, 0x31, 0x23, 0x49, 0xd9, 0x0e, 0x9d, 0x41, 0xa9, 0xdb, 0x0d, 0x5c, 0xd3, 0xdb, 0x70 },
+  { 0xd9, 0x54, 0x8a, 0xd4, 0x4e, 0x67, 0xed, 0xec, 0x20, 0x2d, 0x1b, 0x8b, 0x32, 0x5e, 0x5a, 0xdf },
+  { 0xd9, 0x7e, 0x3d, 0x0b, 0x45, 0x75, 0xce, 0x0b, 0x9a, 0x61, 0x32, 0xe1, 0x9c, 0xfe, 0xac, 0x6e },
+  { 0xd9, 0x7f, 0xd5, 0xe6, 0xe1, 0xda, 0xac, 0xd9, 0x09, 0x55, 0x9a, 0x71, 0xf1, 0x89, 0xf1, 0x4b },
+  { 0xd9, 0xab, 0x6b, 0x67, 0xa1, 0x7d, 0xa5, 0x1e, 0x5a, 0xd1, 0x37, 0x17, 0xe9, 0x3f, 0xa2, 0xe2 },
+  { 0xd9, 0xb4, 0x9f, 0x06, 0x78, 0x77, 0x6e, 0x04, 0x91, 0x6f, 0xa5, 0x47, 0x86, 0x85, 0xa8, 0x19 },
+  { 0xd9, 0xbd, 0x34, 0x35, 0x33, 0xb6, 0x13, 0x89, 0xb2, 0x70, 0xc0, 0x78, 0x72, 0x10, 0x94, 0x3b },
+  { 0xd9, 0xc9, 0xce, 0xce, 0x2e, 0x76, 0x9c, 0x79, 0x85, 0x49, 0x4b, 0x14, 0x03, 0xa2, 0x57, 0x21 },
+  { 0xd9, 0xda, 0x2a, 0xe7, 0xc7, 0x89, 0x4a, 0x29, 0xb4, 0x3b, 0x3c, 0x6b, 0x79, 0xf3, 0xb7, 0xa2 },
+  { 0xd9, 0xfb, 0xf1, 0x11, 0x31, 0x14, 0xfb, 0x3a, 0x3c, 0x97, 0x55, 0x0a, 0x06, 0x89, 0xf1, 0x0f },
+  { 0xda, 0x0f, 0xb2, 0xa4, 0x84, 0xd0, 0xd2, 0xd8, 0xf7, 0x9d, 0x6e, 0x06, 0x3c, 0x94, 0x06, 0x3d },
+  { 0xda, 0x4e, 0x33, 0x96, 0xaa, 0x2d, 0xb3, 0xbd, 0x66, 0x7f, 0x83, 0xa1, 0xcb, 0x9e, 0x4a, 0x36 },
+  { 0xda, 0x50, 0x96, 0x00, 0x0d, 0xb5, 0xfd, 0xaa, 0x8d, 0x02, 0xdb, 0x57, 0xd9, 0x36, 0x79, 0x98 },
+  { 0xda, 0x64, 0x65, 0xa3, 0x4d, 0x2e, 0x44, 0xd2, 0x6a, 0xa9, 0xa2, 0xa0, 0xcd, 0x1b, 0xce, 0x4d },
+  { 0xda, 0x64, 0xf3, 0x3d, 0x05, 0x21, 0xd5, 0xc9, 0x95, 0x8e, 0x5d, 0x2d, 0x44, 0x34, 0xff, 0x95 },
+  { 0xda, 0x66, 0xd7, 0x5e, 0x4b, 0x47, 0xfa, 0xb9, 0x97, 0x33, 0x52, 0x97, 0x43, 0xf8, 0x6f, 0x4f },
+  { 0xda, 0x73, 0x2c, 0x57, 0x69, 0x7a, 0xd7, 0xd7, 0xaf, 0x41, 0x49, 0x98, 0xfa, 0x52, 0x7e, 0x75 },
+  { 0xda, 0x79, 0xaa, 0xd1, 0x15, 0x72, 0xc8, 0x0a, 0x96, 0xe2, 0x61, 0xe4, 0xac, 0x63, 0x92, 0xd0 },
+  { 0xda, 0x7a, 0x17, 0xdc, 0xda, 0xa6, 0x2d, 0x69, 0x71, 0x39, 0x3c, 0x0a, 0x6f, 0xaf, 0x20, 0x2a },
+  { 0xda, 0xb8, 0x44, 0xde, 0xed, 0x4c, 0x75, 0x26, 0x32, 0xb5, 0xe7, 0x86, 0xb0, 0xf4, 0x79, 0x99 },
+  { 0xda, 0xc3, 0x8b, 0x4d, 0xd3, 0xda, 0x73, 0xbb, 0x7b, 0x2e, 0x9d, 0x70, 0xc6, 0x1d, 0x2b, 0x7c },
+  { 0xda, 0xc5, 0xc0, 0xfe, 0x74, 0x53, 0x1f, 0x07, 0x7c, 0x10, 0x5b, 0x39, 0x68, 0x74, 0xa9, 0xf1 },
+  { 0xda, 0xc7, 0x62, 0xe4, 0xd0, 0x1d, 0x44, 0x5b, 0xde, 0xf2, 0x0b, 0x77, 0x71, 0xf6, 0x57, 0x0e },
+  { 0xda, 0xd2, 0xab, 0x5f, 0x66, 0xf9, 0x86, 0x74, 0xf1, 0x2c, 0x92, 0xab, 0xcf, 0xbf, 0x3a, 0x20 },
+  { 0xda, 0xeb, 0x54, 0x95, 0x78, 0x75, 0xc5, 0x01, 0x98, 0xa7, 0xe6, 0x16, 0xf9, 0xcc, 0x81, 0x44 },
+  { 0xda, 0xef, 0x7d, 0x8e, 0x5a, 0x09, 0x98, 0x1c, 0x4a, 0xa8, 0x15, 0x73, 0xd4, 0xdb, 0xb3, 0x80 },
+  { 0xda, 0xfc, 0x39, 0x45, 0x67, 0x7c, 0xcc, 0x32, 0x2c, 0xe3, 0x23, 0xd1, 0xe9, 0x93, 0x0b, 0xeb },
+  { 0xdb, 0x17, 0x53, 0xcc, 0x70, 0x2c, 0x18, 0xd3, 0x91, 0x7e, 0xc7, 0xf3, 0xb0, 0xe8, 0x65, 0x9f },
+  { 0xdb, 0x33, 0x9a, 0xea, 0x2b, 0x65, 0xb8, 0x4c, 0x7c, 0xfe, 0x0e, 0xea, 0xb1, 0x1e, 0x11, 0x0a },
+  { 0xdb, 0x4e, 0xb4, 0x4b, 0xc5, 0xd6, 0x52, 0xd9, 0x19, 0x24, 0x51, 0x38, 0x3d, 0x32, 0x49, 0xfc },
+  { 0xdb, 0x50, 0x73, 0xbd, 0x75, 0xeb, 0x05, 0xf7, 0xd6, 0x2a, 0x72, 0x68, 0x39, 0x6d, 0x1e, 0x77 },
+  { 0xdb, 0x76, 0xf7, 0xa0, 0x81, 0x96, 0x59, 0xd9, 0xe5, 0x85, 0xf2, 0xcd, 0xde, 0x91, 0x75, 0xc7 },
+  { 0xdb, 0x80, 0xd8, 0xef, 0x90, 0x87, 0xaf, 0x47, 0x64, 0x23, 0x6f, 0x7b, 0x56, 0x49, 0xfa, 0x12 },
+  { 0xdb, 0x97, 0x1b, 0x6a, 0xfc, 0x9d, 0x24, 0x3f, 0x61, 0x4e, 0xbf, 0x38, 0x0a, 0xf0, 0xac, 0x60 },
+  { 0xdb, 0xa2, 0x69, 0x2a, 0x21, 0x6c, 0xb6, 0xc2, 0x62, 0xc7, 0x8f, 0x8b, 0x11, 0x1a, 0x81, 0x3e },
+  { 0xdb, 0xa2, 0x70, 0x85, 0x0a, 0xe9, 0x97, 0x96, 0x9a, 0x18, 0xee, 0x00, 0x01, 0x67, 0x58, 0x21 },
+  { 0xdb, 0xab, 0xb8, 0x0e, 0x92, 0xff, 0x18, 0xd8, 0xee, 0xcf, 0x61, 0x5c, 0x05, 0x39, 0x15, 0x1e },
+  { 0xdb, 0xb1, 0x0b, 0x90, 0x42, 0x42, 0xfc, 0xfb, 0x84, 0x28, 0xf3, 0x72, 0xe0, 0x0c, 0x01, 0xaf },
+  { 0xdb, 0xc7, 0x48, 0x5a, 0xd5, 0x81, 0x4d, 0x46, 0x6d, 0xe7, 0x80, 0xa3, 0xe7, 0xed, 0x3b, 0x46 },
+  { 0xdb, 0xc8, 0x82, 0x9e, 0xf6, 0xf1, 0x2d, 0xb8, 0xf4, 0x63, 0xe3, 0x0f, 0x60, 0xaf, 0x20, 0x9f },
+  { 0xdb, 0xda, 0xf8, 0x2f, 0x4f, 0x0c, 0x41, 0x5a, 0x94, 0xd1, 0x03, 0x02, 0x71, 0xa9, 0xef, 0x44 },
+  { 0xdb, 0xdd, 0x21, 0xe1, 0xee, 0x3d, 0x72, 0x11, 0x9e, 0x8c, 0xd1, 0x4d, 0x94, 0x3c, 0x58, 0x5b },
+  { 0xdc, 0x13, 0xdf, 0x84, 0x20, 0xec, 0x69, 0x84, 0x1a, 0x7c, 0x51, 0xe4, 0x1b, 0x9f, 0xbb, 0xa5 },
+  { 0xdc, 0x33, 0x47, 0x9d, 0x66, 0x61, 0x5a, 0x3b, 0x09, 0x67, 0x07, 0x75, 0xde, 0x4c, 0x2a, 0x38 },
+  { 0xdc, 0x6a, 0xa0, 0xbb, 0x21, 0xa6, 0xe6, 0x6e, 0x80, 0xe7, 0x5b, 0xa5, 0xed, 0xc5, 0xc0, 0xdd },
+  { 0xdc, 0x81, 0xc4, 0x80, 0x5b, 0xf2, 0x39, 0x59, 0xfc, 0xf2, 0xc6, 0x49, 0x70, 0x0b, 0x82, 0xbf },
+  { 0xdc, 0x90, 0x5b, 0x22, 0xde, 0x0f, 0x19, 0x1a, 0x02, 0x9d, 0xf1, 0x3e, 0xdd, 0xfc, 0xab, 0xc4 },
+  { 0xdc, 0xa9, 0x0e, 0xa1, 0x08, 0x4a, 0x2f, 0xdb, 0xe3, 0x00, 0xd7, 0x17, 0x8c, 0xa1, 0xa1, 0x38 },
+  { 0xdc, 0xa9, 0x41, 0xda, 0xb5, 0xc6, 0xf8, 0x59, 0xb7, 0x18, 0x83, 0xb1, 0x3a, 0xde, 0x97, 0x44 },
+  { 0xdc, 0xba, 0x0e, 0x33, 0xaa, 0x4a, 0xed, 0x67, 0x63, 0x0a, 0x4b, 0x29, 0x23, 0x86, 0xf4, 0x05 },
+  { 0xdc, 0xc2, 0x95, 0x6c, 0x7a, 0x39, 0xfd, 0xbf, 0x1e, 0x86, 0x1f, 0xc5, 0xc5, 0x95, 0xda, 0x0d },
+  { 0xdc, 0xec, 0x46, 0xa9, 0x8f, 0x45, 0xb1, 0x93, 0xf0, 0x72, 0x39, 0x61, 0x1e, 0xb8, 0x78, 0xc2 },
+  { 0xdd, 0x08, 0xe1, 0x8c, 0xfe, 0xe8, 0x7a, 0x0e, 0x7f, 0xc1, 0x9a, 0x68, 0x4b, 0x36, 0xe1, 0x24 },
+  { 0xdd, 0x0c, 0xbe, 0x53, 0x51, 0x55, 0x1a, 0x53, 0x84, 0x14, 0xfb, 0x9e, 0x37, 0xfc, 0x56, 0xe8 },
+  { 0xdd, 0x0d, 0xe0, 0xf6, 0x1a, 0xf2, 0xa2, 0xa4, 0x87, 0x8e, 0x37, 0x7b, 0x88, 0x0a, 0x39, 0x33 },
+  { 0xdd, 0x10, 0xb5, 0xee, 0x37, 0xfd, 0xbf, 0x90, 0x94, 0x23, 0xf2, 0x99, 0x8a, 0x1f, 0x31, 0x79 },
+  { 0xdd, 0x14, 0x22, 0xff, 0xd5, 0x38, 0xe2, 0xe3, 0x3b, 0x33, 0x9e, 0xbe, 0xef, 0x4f, 0x25, 0x9d },
+  { 0xdd, 0x17, 0x71, 0x1a, 0x30, 0xad, 0x60, 0x10, 0x9c, 0x8b, 0xea, 0xce, 0x0d, 0x4a, 0x76, 0xe8 },
+  { 0xdd, 0x4f, 0x4e, 0x0f, 0xbd, 0x81, 0x76, 0x25, 0x33, 0xe3, 0x9e, 0x6f, 0x5b, 0x55, 0xbb, 0x3a },
+  { 0xdd, 0x75, 0x98, 0xb8, 0xbc, 0xb8, 0x15, 0x90, 0x42, 0x89, 0x00, 0xf7, 0x1b, 0x72, 0x0e, 0xfb },
+  { 0xdd, 0x78, 0x84, 0xb4, 0xf9, 0x3c, 0xab, 0x42, 0x3a, 0xc4, 0x71, 0xaa, 0x19, 0x35, 0xe3, 0xdf },
+  { 0xdd, 0x8a, 0x21, 0x24, 0xd4, 0xed, 0xa2, 0x00, 0xdf, 0x71, 0x5c, 0x69, 0x8a, 0x6e, 0xa8, 0x87 },
+  { 0xdd, 0x92, 0xd6, 0xad, 0x50, 0x97, 0x6f, 0x88, 0x1d, 0x86, 0xb5, 0x2d, 0x38, 0x61, 0x61, 0x18 },
+  { 0xdd, 0xa2, 0x37, 0x57, 0x40, 0x7c, 0x4e, 0x21, 0x7f, 0x64, 0x96, 0x2c, 0x87, 0xad, 0x0c, 0x82 },
+  { 0xdd, 0xd1, 0xef, 0xc1, 0x86, 0x2c, 0xd3, 0xeb, 0x3b, 0xaf, 0x4c, 0xba, 0x81, 0xff, 0x50, 0x50 },
+  { 0xde, 0x01, 0x73, 0xed, 0x6b, 0xe9, 0xde, 0x6f, 0xd0, 0x49, 0x80, 0x38, 0x11, 0xe5, 0xf1, 0xa8 },
+  { 0xde, 0x07, 0xe9, 0xcb, 0x43, 0xad, 0x8d, 0x06, 0xa3, 0x5f, 0x65, 0x06, 0xe2, 0x2c, 0x62, 0xe9 },
+  { 0xde, 0x1a, 0x63, 0x6d, 0x09, 0x83, 0x49, 0xbe, 0x11, 0xbb, 0xc2, 0xd0, 0x90, 0xf4, 0xe9, 0xcf },
+  { 0xde, 0x1e, 0x9f, 0xb7, 0x00, 0xba, 0xf8, 0xd2, 0xe5, 0xae, 0x24, 0x2b, 0xff, 0xe2, 0xdb, 0xda },
+  { 0xde, 0x24, 0xf7, 0x00, 0xfd, 0x28, 0xd5, 0xb8, 0x38, 0x1d, 0xe1, 0x3a, 0xbd, 0x09, 0x1d, 0xb9 },
+  { 0xde, 0x29, 0xe4, 0x6d, 0xbe, 0xa0, 0x03, 0xc3, 0xc0, 0x9c, 0x89, 0x2d, 0x66, 0x8b, 0x94, 0x13 },
+  { 0xde, 0x3d, 0x0e, 0x37, 0x72, 0x9d, 0x85, 0xaf, 0xcb, 0x25, 0xa8, 0xd0, 0x52, 0xa6, 0xe2, 0x36 },
+  { 0xde, 0x44, 0x36, 0xea, 0xa4, 0x1e, 0x5d, 0x7b, 0x76, 0x09, 0x51, 0x26, 0x32, 0xb9, 0x00, 0x78 },
+  { 0xde, 0x5a, 0xab, 0x22, 0xe5, 0xab, 0xa5, 0xed, 0xcb, 0x29, 0xa3, 0xe7, 0x49, 0x1f, 0xf3, 0x19 },
+  { 0xde, 0x61, 0xa0, 0xb1, 0x71, 0xe9, 0x09, 0xa5, 0xa4, 0xcf, 0xcf, 0x81, 0xd1, 0x46, 0xdb, 0xcb },
+  { 0xde, 0x62, 0xf8, 0xa3, 0x02, 0x98, 0xe2, 0x32, 0x52, 0x49, 0xfe, 0x11, 0x2e, 0xcb, 0x5c, 0x10 },
+  { 0xde, 0x78, 0xb3, 0xa0, 0x64, 0xd3, 0x74, 0x39, 0x0a, 0xc0, 0x71, 0x0f, 0x95, 0xed, 0xde, 0x92 },
+  { 0xde, 0x7a, 0x64, 0x10, 0x80, 0x74, 0x09, 0x8b, 0xa3, 0x33, 0xcc, 0x0c, 0x70, 0xee, 0xf1, 0x8a },
+  { 0xde, 0x7b, 0xca, 0x4e, 0x56, 0x9a, 0xd9, 0xd3, 0xfd, 0x08, 0xff, 0x13, 0x95, 0xe5, 0x3d, 0x2d },
+  { 0xde, 0x84, 0x43, 0xff, 0x47, 0x28, 0x3e, 0x7b, 0x27, 0x4a, 0x78, 0x38, 0xcb, 0x07, 0x1f, 0xb6 },
+  { 0xde, 0xa0, 0xad, 0xe2, 0x96, 0xf7, 0x09, 0x3e, 0x71, 0x18, 0x5e, 0x80, 0x2b, 0x50, 0x0d, 0xb8 },
+  { 0xde, 0xb3, 0x94, 0x82, 0xe7, 0x7f, 0x98, 0x4d, 0x4c, 0xe7, 0x3b, 0xe9, 0xfd, 0x8a, 0xda, 0xbd },
+  { 0xde, 0xd2, 0x6e, 0x1c, 0xb1, 0x7f, 0x87, 0x5a, 0x9c, 0x17, 0x51, 0x5c, 0x90, 0x0f, 0x99, 0x33 },
+  { 0xdf, 0x12, 0x95, 0x3b, 0x91, 0x98, 0x44, 0xda, 0xd2, 0x07, 0x0e, 0xd2, 0xe7, 0x0c, 0x9f, 0xa2 },
+  { 0xdf, 0x27, 0x45, 0xd5, 0x85, 0x23, 0x87, 0x80, 0x10, 0x1d, 0xf8, 0x12, 0xd0, 0x0b, 0x49, 0xf4 },
+  { 0xdf, 0x3e, 0x6a, 0x9b, 0x69, 0x27, 0xcf, 0x59, 0xb7, 0xaf, 0xb6, 0x26, 0xf6, 0xfd, 0x7e, 0xea },
+  { 0xdf, 0x40, 0xaf, 0x24, 0x4a, 0x8d, 0x68, 0xb4, 0x92, 0xbf, 0xba, 0x9e, 0x97, 0xde, 0xa4, 0xd6 },
+  { 0xdf, 0x5c, 0xc5, 0xcc, 0xcd, 0xc1, 0x40, 0xeb, 0x71, 0x07, 0xf5, 0xb8, 0xad, 0xfa, 0xcd, 0xa1 },
+  { 0xdf, 0x62, 0xa6, 0x58, 0x49, 0x6a, 0xc9, 0x8a, 0x3a, 0xa4, 0xa6, 0xee, 0x57, 0x19, 0xc2, 0x51 },
+  { 0xdf, 0x6a, 0x28, 0xa8, 0x96, 0x00, 0xaf, 0xfe, 0x36, 0xd9, 0x43, 0x94, 0xef, 0x59, 0x72, 0x14 },
+  { 0xdf, 0x6a, 0x46, 0x71, 0x49, 0x60, 0xa3, 0xe3, 0x9b, 0x57, 0xb3, 0xc3, 0x98, 0x38, 0x01, 0xb5 },
+  { 0xdf, 0x75, 0x3c, 0xb8, 0x7d, 0x3a, 0xf4, 0xd0, 0x3f, 0x69, 0x4a, 0xb8, 0x48, 0x63, 0x81, 0x08 },
+  { 0xdf, 0x95, 0xe4, 0xaf, 0x46, 0x6c, 0x80, 0x96, 0x19, 0x29, 0x9f, 0x49, 0xec, 0xe9, 0x23, 0x65 },
+  { 0xdf, 0xad, 0x86, 0xdd, 0x85, 0xa1, 0x1c, 0x80, 0x25, 0x9f, 0x3d, 0xdb, 0x61, 0x51, 0xf4, 0x8f },
+  { 0xdf, 0xaf, 0xa3, 0xfa, 0x58, 0xf5, 0xcc, 0x3f, 0x03, 0x42, 0xcc, 0xa4, 0x75, 0xdf, 0x60, 0x95 },
+  { 0xdf, 0xc0, 0x3e, 0xf3, 0x71, 0xcf, 0x51, 0x63, 0xf5, 0x4c, 0x50, 0xd8, 0xee, 0x73, 0xc8, 0xcf },
+  { 0xdf, 0xc3, 0xdb, 0xbb, 0x39, 0xf0, 0x5d, 0x7d, 0xd8, 0xee, 0x3a, 0xc9, 0x87, 0x47, 0x89, 0x70 },
+  { 0xdf, 0xcd, 0xd6, 0xf5, 0x93, 0xbb, 0x7b, 0x05, 0xdb, 0xc2, 0xe8, 0xe1, 0xfc, 0x6e, 0xe0, 0xde },
+  { 0xdf, 0xe0, 0x34, 0x29, 0x72, 0x00, 0xdf, 0xf6, 0x72, 0xdf, 0x95, 0x33, 0xed, 0x14, 0x49, 0xa9 },
+  { 0xdf, 0xe6, 0xaa, 0x74, 0x43, 0xbb, 0x81, 0x3c, 0xef, 0xa3, 0x5a, 0x4c, 0xf4, 0x88, 0x74, 0x22 },
+  { 0xdf, 0xf3, 0x35, 0x23, 0xcc, 0xd2, 0xfd, 0xc8, 0x91, 0x2e, 0x84, 0xca, 0xb8, 0xe0, 0xd9, 0x82 },
+  { 0xe0, 0x1e, 0x00, 0x50, 0x4e, 0x6d, 0x4b, 0x88, 0xfa, 0x74, 0x3c, 0x0b, 0xbe, 0x8a, 0x96, 0xe5 },
+  { 0xe0, 0x20, 0xf6, 0x12, 0x25, 0x5e, 0x26, 0x6a, 0x8a, 0x6a, 0x97, 0x95, 0xa4, 0xdf, 0x0c, 0x0f },
+  { 0xe0, 0x21, 0x56, 0x29, 0x43, 0x93, 0x81, 0x8f, 0xf8, 0x72, 0xd4, 0x31, 0x4f, 0xc2, 0xf3, 0x8e },
+  { 0xe0, 0x22, 0x1c, 0x95, 0xaa, 0x65, 0x7f, 0x57, 0x64, 0xee, 0xeb, 0x64, 0xc8, 0x42, 0x92, 0x58 },
+  { 0xe0, 0x3b, 0x0b, 0x09, 0x1b, 0xea, 0x5b, 0xc9, 0xd3, 0xf1, 0x4e, 0xe0, 0x22, 0x1e, 0x71, 0x4d },
+  { 0xe0, 0x40, 0xdf, 0x95, 0xa0, 0x55, 0xb1, 0x8e, 0xbd, 0xb0, 0x94, 0xe9, 0x04, 0xcb, 0x71, 0xb2 },
+  { 0xe0, 0x4f, 0x1c, 0x1e, 0x44, 0x01, 0xd5, 0x84, 0xd3, 0xf4, 0x34, 0x34, 0x10, 0xa5, 0xbc, 0xc4 },
+  { 0xe0, 0xb2, 0x4c, 0x3f, 0x40, 0xa4, 0x6c, 0xda, 0x52, 0xe2, 0x98, 0x35, 0xab, 0x7a, 0xd6, 0x60 },
+  { 0xe0, 0xcf, 0x2d, 0xcc, 0x4c, 0x13, 0x48, 0xc4, 0x68, 0xf5, 0xbb, 0x1e, 0x42, 0x1c, 0x91, 0x64 },
+  { 0xe0, 0xde, 0x37, 0x73, 0xf5, 0xb8, 0x67, 0x79, 0x5d, 0xb5, 0x57, 0xbe, 0x7b, 0x8a, 0x70, 0x3e },
+  { 0xe0, 0xef, 0xf0, 0x71, 0xf5, 0x78, 0xec, 0xf1, 0x9e, 0xdc, 0x2a, 0xb2, 0x76, 0x64, 0x4e, 0x46 },
+  { 0xe1, 0x02, 0x96, 0x76, 0xed, 0xb3, 0xd3, 0x5b, 0x76, 0xca, 0x94, 0x3d, 0xa7, 0x43, 0x4d, 0xa8 },
+  { 0xe1, 0x0b, 0xf1, 0xaf, 0x6b, 0xf3, 0xb4, 0xa2, 0x53, 0xc5, 0xbe, 0xf6, 0x57, 0x7f, 0xe9, 0x23 },
+  { 0xe1, 0x0d, 0x2c, 0x78, 0x5a, 0xad, 0xb4, 0x2c, 0x06, 0x39, 0x0f, 0xae, 0x0d, 0x92, 0xf2, 0x82 },
+  { 0xe1, 0x14, 0x3b, 0x72, 0xa3, 0x0d, 0x4d, 0x3f, 0xee, 0x38, 0x5e, 0xec, 0x38, 0xb4, 0xaa, 0x4d },
+  { 0xe1, 0x2e, 0x32, 0xde, 0xe6, 0x82, 0x01, 0xb6, 0x76, 0x5f, 0xcd, 0x0e, 0xd5, 0x4d, 0x66, 0x46 },
+  { 0xe1, 0x38, 0x18, 0xa5, 0xc0, 0xcb, 0x2f, 0x84, 0xdd, 0x84, 0x36, 0x80, 0x70, 0xe9, 0xf0, 0x99 },
+  { 0xe1, 0x3c, 0x76, 0x27, 0xb2, 0xe1, 0x36, 0xb9, 0xc4, 0x49, 0xd9, 0xe8, 0x92, 0x5b, 0x45, 0x47 },
+  { 0xe1, 0x48, 0x6c, 0x78, 0x22, 0xc0, 0x71, 0x17, 0xb4, 0xf9, 0x4a, 0x32, 0xe5, 0xed, 0x68, 0xc1 },
+  { 0xe1, 0x4d, 0xc3, 0x6b, 0x24, 0xfe, 0x22, 0xc0, 0x4f, 0xa0, 0x76, 0xe2, 0x98, 0xf2, 0xe1, 0x5f },
+  { 0xe1, 0x4f, 0xed, 0xde, 0xb8, 0x2f, 0x51, 0x60, 0xed, 0x5c, 0xf9, 0xca, 0x40, 0x78, 0xe5, 0x8d },
+  { 0xe1, 0x50, 0xf0, 0xd1, 0x4f, 0x01, 0x3a, 0x10, 0x4b, 0x03, 0x23, 0x05, 0xc0, 0xce, 0x23, 0xef },
+  { 0xe1, 0x5b, 0x55, 0x25, 0xcf, 0x8f, 0x77, 0x29, 0x7b, 0x32, 0x28, 0x38, 0xdf, 0x8d, 0x99, 0x9c },
+  { 0xe1, 0x71, 0x55, 0x8c, 0x51, 0xbb, 0x3b, 0xac, 0x97, 0xbf, 0xa7, 0x9f, 0xa2, 0xc1, 0xa1, 0x9c },
+  { 0xe1, 0x76, 0x99, 0xa5, 0x4c, 0x90, 0xf3, 0xa5, 0x6a, 0xe4, 0x82, 0x0f, 0x77, 0x9f, 0x72, 0xc4 },
+  { 0xe1, 0x8a, 0xbe, 0x87, 0x03, 0x53, 0x79, 0xc5, 0x6b, 0x43, 0x5b, 0xfe, 0x81, 0x75, 0x07, 0x7b },
+  { 0xe1, 0xa5, 0x16, 0x90, 0x79, 0x28, 0x38, 0xc5, 0xc6, 0x87, 0xda, 0x80, 0xcd, 0x76, 0x4d, 0x78 },
+  { 0xe1, 0xb9, 0x0f, 0x1e, 0x01, 0xb1, 0xa3, 0x16, 0xd7, 0xbb, 0xf1, 0x41, 0x52, 0x5c, 0xc0, 0x0e },
+  { 0xe1, 0xd5, 0xc8, 0x21, 0x3e, 0x82, 0x82, 0x01, 0x28, 0xfa, 0x9c, 0x47, 0x75, 0xf1, 0xe1, 0x66 },
+  { 0xe1, 0xd7, 0x9e, 0x4e, 0x7c, 0x15, 0x0f, 0x38, 0x61, 0x25, 0x6c, 0x54, 0x1e, 0xc7, 0x15, 0xa1 },
+  { 0xe1, 0xe0, 0x9e, 0x2f, 0x28, 0x0e, 0x8e, 0x14, 0x21, 0x21, 0xa3, 0x77, 0xd0, 0xdc, 0x1b, 0x46 },
+  { 0xe1, 0xef, 0xe2, 0xef, 0x76, 0x64, 0xbb, 0x67, 0x58, 0xb1, 0xa2, 0x2f, 0xf8, 0xea, 0x16, 0xa1 },
+  { 0xe1, 0xf8, 0x8d, 0xa6, 0xda, 0x8a, 0x7d, 0x52, 0x1c, 0xa1, 0xdc, 0xbf, 0x2b, 0xc6, 0x97, 0x8b },
+  { 0xe2, 0x1e, 0xe3, 0x54, 0x1e, 0xbd, 0x2c, 0x23, 0xe8, 0x17, 0xff, 0xb4, 0x49, 0x93, 0x9c, 0x37 },
+  { 0xe2, 0x37, 0xee, 0x91, 0x51, 0x4d, 0x5e, 0xd5, 0x35, 0xc9, 0x5a, 0x14, 0xfc, 0x60, 0x8c, 0x11 },
+  { 0xe2, 0x38, 0x9c, 0x0b, 0xe5, 0xb5, 0xb8, 0x4e, 0x0d, 0x3c, 0xa3, 0x6e, 0xc7, 0xe6, 0x75, 0x14 },
+  { 0xe2, 0x4d, 0x7d, 0x87, 0x92, 0x81, 0xff, 0xec, 0x06, 0x41, 0xe9, 0xc3, 0xf5, 0x2e, 0x50, 0x5a },
+  { 0xe2, 0x5e, 0x17, 0x37, 0x40, 0xf7, 0xec, 0xc0, 0xe2, 0x30, 0x25, 0x44, 0x5c, 0x45, 0x91, 0xf3 },
+  { 0xe2, 0x75, 0xcb, 0xe7, 0xd4, 0xe1, 0x1e, 0x62, 0xc3, 0xbf, 0xcf, 0xb3, 0x8f, 0xca, 0x3d, 0x49 },
+  { 0xe2, 0x81, 0x13, 0xd1, 0x0c, 0x0c, 0x14, 0xcc, 0x3b, 0x5f, 0x43, 0x0b, 0x0d, 0x14, 0x2f, 0xcb },
+  { 0xe2, 0x84, 0x6a, 0xf3, 0xe4, 0xd1, 0x72, 0xb2, 0x51, 0xab, 0x77, 0xcb, 0xdd, 0x01, 0x76, 0x1e },
+  { 0xe2, 0x90, 0x47, 0x48, 0xda, 0x63, 0xdf, 0xef, 0xc8, 0x81, 0x66, 0x52, 0xb9, 0x24, 0xb6, 0x42 },
+  { 0xe2, 0xb6, 0x82, 0xf6, 0xe6, 0xd7, 0x6b, 0x35, 0xc1, 0x80, 0xc7, 0xd8, 0x47, 0xe9, 0x3b, 0x4f },
+  { 0xe2, 0xc1, 0xb6, 0x0e, 0xaa, 0x8e, 0xda, 0x13, 0x16, 0x32, 0xd7, 0x3e, 0x4e, 0x0c, 0x14, 0x6b },
+  { 0xe2, 0xc8, 0x9f, 0x27, 0x0f, 0x72, 0xcd, 0x25, 0x6e, 0xd6, 0x67, 0x50, 0x7f, 0xa0, 0x38, 0xa2 },
+  { 0xe2, 0xca, 0x84, 0xa2, 0xbb, 0x63, 0xd1, 0xa2, 0x10, 0xeb, 0xb6, 0x59, 0x92, 0x97, 0x47, 0xa9 },
+  { 0xe2, 0xec, 0xcb, 0xbe, 0x96, 0x3f, 0x80, 0xf2, 0x91, 0xcb, 0x1f, 0x18, 0x80, 0x3b, 0xf5, 0x57 },
+  { 0xe3, 0x14, 0xb4, 0x27, 0x61, 0xcd, 0x13, 0xc0, 0x3d, 0xef, 0x74, 0x4b, 0x4a, 0xfc, 0x7b, 0x1b },
+  { 0xe3, 0x4c, 0x23, 0x66, 0x30, 0xc9, 0x45, 0x08, 0x9f, 0xcd, 0xef, 0x08, 0x8c, 0x4b, 0x6e, 0x06 },
+  { 0xe3, 0x53, 0x36, 0x84, 0xa7, 0xef, 0x93, 0x0a, 0x7f, 0xbd, 0x0c, 0x4d, 0xd8, 0xec, 0x48, 0x47 },
+  { 0xe3, 0x60, 0x0b, 0xe9, 0xeb, 0x98, 0x14, 0x6a, 0xda, 0xfd, 0xc1, 0x2d, 0x91, 0x32, 0x3d, 0x0f },
+  { 0xe3, 0x63, 0xe4, 0x67, 0xf6, 0x05, 0x53, 0x7f, 0x37, 0x77, 0xad, 0x33, 0xe7, 0x4e, 0x11, 0x3a },
+  { 0xe3, 0x77, 0xc3, 0xaf, 0x4f, 0x54, 0xa5, 0x1b, 0x85, 0xef, 0xe3, 0x7d, 0x4b, 0x70, 0x29, 0xe6 },
+  { 0xe3, 0x7c, 0x80, 0x55, 0xd7, 0x09, 0x79, 0xaf, 0x35, 0x42, 0x51, 0xeb, 0xe9, 0xf1, 0xb7, 0xdd },
+  { 0xe3, 0x8d, 0xc1, 0xf8, 0x1a, 0x02, 0xe3, 0x25, 0x56, 0x2c, 0xd2, 0x85, 0x12, 0x3f, 0x57, 0x9b },
+  { 0xe3, 0x98, 0x43, 0xc5, 0x6b, 0x7a, 0x4a, 0x08, 0xb1, 0x8f, 0xa7, 0x94, 0x9e, 0xc3, 0xee, 0x6b },
+  { 0xe3, 0x9a, 0x13, 0xb1, 0x3d, 0xc8, 0x2c, 0x5f, 0xdb, 0xfb, 0xbf, 0xd5, 0x5b, 0xa1, 0x23, 0x0e },
+  { 0xe3, 0xc0, 0x45, 0x1d, 0x29, 0xda, 0xd7, 0x24, 0x23, 0x1b, 0xc5, 0x81, 0x8e, 0xc4, 0xba, 0xe0 },
+  { 0xe3, 0xc3, 0x5e, 0xac, 0x23, 0x45, 0x37, 0x39, 0x6a, 0x86, 0x5d, 0x23, 0xba, 0xfb, 0x1c, 0x84 },
+  { 0xe3, 0xed, 0x4b, 0xa3, 0x36, 0x17, 0x56, 0x97, 0x0f, 0x07, 0x6e, 0x46, 0xe9, 0xca, 0xd1, 0xd2 },
+  { 0xe4, 0x0a, 0x81, 0x8d, 0xac, 0x4d, 0xd8, 0x51, 0xf3, 0xb4, 0xaa, 0xfb, 0xe2, 0xf1, 0xe0, 0xc1 },
+  { 0xe4, 0x2b, 0x93, 0x7c, 0x30, 0xc6, 0x17, 0x24, 0x1c, 0xa9, 0xe0, 0x1e, 0x45, 0x10, 0xc3, 0xf6 },
+  { 0xe4, 0x34, 0xc0, 0xe1, 0x61, 0xdd, 0x3c, 0x3f, 0xb4, 0x35, 0xeb, 0x6b, 0xad, 0x2e, 0x18, 0x2c },
+  { 0xe4, 0x9a, 0xc0, 0xec, 0x87, 0x9a, 0x0d, 0x78, 0x20, 0xbc, 0x25, 0x98, 0xfc, 0x2c, 0xfc, 0xd4 },
+  { 0xe4, 0xa0, 0xb2, 0x8b, 0xef, 0xaa, 0xa2, 0x91, 0x5d, 0xf1, 0xfa, 0x01, 0x23, 0x8b, 0x1e, 0x29 },
+  { 0xe4, 0xaf, 0xe1, 0x57, 0xc0, 0x99, 0x62, 0xcf, 0x39, 0xcd, 0xb2, 0x58, 0x45, 0xd8, 0x3d, 0x47 },
+  { 0xe4, 0xb1, 0x2d, 0xea, 0xaf, 0xd1, 0xdb, 0xf5, 0xac, 0x31, 0xaf, 0xe4, 0xb8, 0xe9, 0xc2, 0x33 },
+  { 0xe4, 0xbf, 0xf1, 0xd5, 0xdf, 0x70, 0x16, 0x3c, 0x04, 0x28, 0xa1, 0xea, 0xd3, 0x09, 0xc2, 0x2d },
+  { 0xe4, 0xc0, 0x0b, 0xeb, 0x17, 0xfd, 0xc5, 0x88, 0x17, 0x57, 0x85, 0x5f, 0x28, 0x38, 0xc8, 0x16 },
+  { 0xe4, 0xc2, 0x07, 0x7a, 0x18, 0xe3, 0xc2, 0x7f, 0x48, 0x19, 0xaa, 0x77, 0x57, 0x90, 0x3a, 0xa0 },
+  { 0xe4, 0xc6, 0x66, 0xca, 0x0c, 0x36, 0x92, 0x8b, 0x95, 0xb1, 0x3d, 0x33, 0x47, 0x4d, 0xbb, 0x44 },
+  { 0xe4, 0xd4, 0x1f, 0x2d, 0x59, 0xa5, 0x6a, 0x9d, 0x91, 0x70, 0x38, 0x68, 0x2b, 0x8e, 0x0b, 0x8c },
+  { 0xe4, 0xe9, 0x12, 0x5a, 0x87, 0x41, 0x97, 0x75, 0x83, 0x77, 0x67, 0x29, 0x35, 0x96, 0x14, 0xe1 },
+  { 0xe5, 0x05, 0xbd, 0x8e, 0x59, 0xe3, 0x1a, 0xae, 0xd2, 0x07, 0x18, 0xd4, 0x7b, 0x15, 0xc6, 0x1b },
+  { 0xe5, 0x10, 0x30, 0x25, 0x1e, 0x44, 0x0c, 0xff, 0xaa, 0xb1, 0xac, 0x63, 0x43, 0x8b, 0x44, 0xae },
+  { 0xe5, 0x1c, 0x23, 0x38, 0x9e, 0x43, 0xab, 0x32, 0x8c, 0xcf, 0xb0, 0x5b, 0xe7, 0xd4, 0x51, 0xda },
+  { 0xe5, 0x35, 0x9c, 0xbb, 0xbf, 0xf9, 0xc6, 0xd7, 0xfe, 0x8a, 0xef, 0xf5, 0xfb, 0x47, 0x1b, 0x46 },
+  { 0xe5, 0x49, 0xf1, 0x17, 0x8e, 0x03, 0x8f, 0xa8, 0x8d, 0xc6, 0xd6, 0x57, 0xdc, 0x44, 0x11, 0x46 },
+  { 0xe5, 0x56, 0xe0, 0x7c, 0xc0, 0x6c, 0x80, 0x3f, 0x29, 0x55, 0x98, 0x6f, 0x53, 0xef, 0x63, 0xed },
+  { 0xe5, 0x58, 0xbe, 0x88, 0xee, 0xf5, 0x69, 0xf3, 0x37, 0x16, 0xe8, 0xe3, 0x30, 0xd2, 0xf5, 0xbc },
+  { 0xe5, 0x6d, 0xa6, 0x74, 0x18, 0x8b, 0xa2, 0xf0, 0x2c, 0x7a, 0x0a, 0x34, 0x3a, 0x01, 0x23, 0x6f },
+  { 0xe5, 0xa6, 0xe0, 0xbb, 0x7d, 0x56, 0xe2, 0xf0, 0x8b, 0x23, 0x7e, 0x15, 0x07, 0x6e, 0x56, 0x99 },
+  { 0xe5, 0xba, 0xcf, 0x52, 0x60, 0x36, 0xd3, 0xc8, 0xc9, 0x9d, 0xb5, 0xb0, 0x30, 0xcf, 0x00, 0xe7 },
+  { 0xe5, 0xd5, 0x08, 0x51, 0x23, 0xa9, 0x8c, 0x1e, 0x61, 0x81, 0x8c, 0xaa, 0x29, 0x71, 0xe9, 0x99 },
+  { 0xe5, 0xd7, 0x2f, 0xf8, 0xba, 0xb4, 0x45, 0x0b, 0xe5, 0x77, 0x85, 0xcc, 0x9e, 0x83, 0xf3, 0xc0 },
+  { 0xe5, 0xec, 0xd7, 0x8e, 0xdd, 0x24, 0x32, 0x6a, 0x96, 0x88, 0x09, 0xde, 0xcb, 0xc7, 0xb9, 0x16 },
+  { 0xe5, 0xf1, 0x7b, 0x3e, 0x62, 0xa2, 0x1d, 0x0d, 0xf1, 0xca, 0x9a, 0xee, 0x1a, 0xa8, 0xc7, 0xc5 },
+  { 0xe5, 0xf3, 0x60, 0x22, 0x6d, 0xc5, 0x52, 0xab, 0xa3, 0xe7, 0xe9, 0xb2, 0x02, 0x33, 0x0f, 0x48 },
+  { 0xe5, 0xf8, 0x49, 0x30, 0xaa, 0x46, 0x8d, 0xb3, 0x3c, 0x0d, 0x0f, 0x7b, 0x26, 0xdd, 0x82, 0x93 },
+  { 0xe5, 0xfc, 0xc6, 0x2e, 0x1d, 0x73, 0x70, 0x6b, 0xe7, 0xb8, 0x95, 0xe8, 0x87, 0xe9, 0x0f, 0x84 },
+  { 0xe6, 0x00, 0xf5, 0xe9, 0x8a, 0x20, 0xfa, 0xfa, 0x47, 0x67, 0x61, 0x98, 0xef, 0xe6, 0x83, 0x4d },
+  { 0xe6, 0x09, 0xe8, 0xa0, 0x07, 0x12, 0x7b, 0x8f, 0xcf, 0xf7, 0x9f, 0xfc, 0x38, 0x0d, 0xa6, 0xb1 },
+  { 0xe6, 0x12, 0x10, 0x29, 0x3b, 0x14, 0xc9, 0xc4, 0xec, 0xc9, 0x17, 0x05, 0x07, 0x2c, 0x6a, 0x7e },
+  { 0xe6, 0x2e, 0x60, 0xa3, 0xe6, 0xcb, 0x55, 0x63, 0xf7, 0x29, 0x82, 0xfc, 0xd8, 0x3d, 0xe2, 0x5a },
+  { 0xe6, 0x3a, 0x87, 0xc2, 0x31, 0xee, 0x9a, 0x50, 0x6f, 0x95, 0x99, 0xaa, 0x4e, 0xf7, 0xdf, 0xb9 },
+  { 0xe6, 0x3e, 0xfd, 0xfd, 0xa9, 0xa4, 0x00, 0x3d, 0xcd, 0x77, 0xa8, 0x54, 0xa7, 0x81, 0xa0, 0x6a },
+  { 0xe6, 0x43, 0xaa, 0xec, 0x9a, 0x9e, 0x1c, 0x8a, 0xb7, 0xfe, 0x1e, 0xae, 0x90, 0xbc, 0x77, 0xd7 },
+  { 0xe6, 0x4a, 0x80, 0x08, 0x81, 0x23, 0x27, 0x85, 0x38, 0x77, 0xa3, 0x7b, 0xef, 0xeb, 0x64, 0x65 },
+  { 0xe6, 0x50, 0x8b, 0x87, 0x81, 0x45, 0x18, 0x7b, 0x87, 0xb9, 0xcd, 0xed, 0x09, 0x72, 0x93, 0xe7 },
+  { 0xe6, 0x6e, 0x5a, 0xf5, 0xde, 0xa6, 0x61, 0xd5, 0x84, 0x20, 0x08, 0x83, 0x68, 0xe4, 0xef, 0x0d },
+  { 0xe6, 0x8e, 0x28, 0x75, 0x2d, 0x3c, 0x54, 0xed, 0xd3, 0xcc, 0xda, 0x42, 0xc2, 0x7e, 0x32, 0x0c },
+  { 0xe6, 0xd5, 0x94, 0x8f, 0x45, 0x1a, 0x24, 0x99, 0x4d, 0xfa, 0xac, 0xa5, 0x1d, 0xfd, 0xb4, 0xe1 },
+  { 0xe6, 0xde, 0x4e, 0xf9, 0xab, 0x62, 0xe2, 0x19, 0x69, 0x62, 0xaa, 0x6b, 0x0d, 0xed, 0xac, 0x59 },
+  { 0xe6, 0xe5, 0xbb, 0x0e, 0x4f, 0x43, 0x50, 0xda, 0x57, 0x30, 0x23, 0x25, 0x62, 0x68, 0x31, 0x3d },
+  { 0xe6, 0xf4, 0x9a, 0x10, 0x53, 0xc7, 0x92, 0x11, 0xf8, 0x2b, 0xe4, 0xd9, 0x0d, 0xc9, 0xfe, 0x3d },
+  { 0xe7, 0x23, 0xad, 0x8f, 0x40, 0x6c, 0xb2, 0x58, 0xb8, 0x96, 0x81, 0xef, 0x4c, 0xef, 0x0e, 0xff },
+  { 0xe7, 0x2e, 0xb8, 0xd4, 0x41, 0x01, 0x52, 0xbd, 0xcb, 0x69, 0xe7, 0xfb, 0xa3, 0x27, 0xb4, 0x20 },
+  { 0xe7, 0x2e, 0xe2, 0xd6, 0xe5, 0x01, 0xf0, 0x7e, 0xc5, 0xe8, 0xa0, 0xef, 0xbe, 0x52, 0x0b, 0xee },
+  { 0xe7, 0x38, 0x38, 0xc4, 0x30, 0x40, 0xbc, 0xbc, 0x83, 0xe4, 0x20, 0x4a, 0x3e, 0x72, 0xee, 0xf4 },
+  { 0xe7, 0x40, 0x22, 0xcf, 0xe3, 0x1e, 0xc8, 0x90, 0x88, 0x44, 0x71, 0x8d, 0xfb, 0xde, 0xdf, 0x7a },
+  { 0xe7, 0x7e, 0xc2, 0x59, 0xe1, 0x38, 0x7b, 0xc3, 0x08, 0xb0, 0x53, 0x46, 0x47, 0xa8, 0x91, 0x98 },
+  { 0xe7, 0x7f, 0x33, 0x2b, 0x71, 0xf1, 0x38, 0x84, 0xc8, 0x47, 0x71, 0xe7, 0xa1, 0x21, 0x18, 0x2d },
+  { 0xe7, 0x84, 0xa9, 0xd2, 0x67, 0x07, 0xcf, 0xcd, 0x17, 0x0a, 0x4c, 0x1c, 0x60, 0x42, 0x2a, 0x72 },
+  { 0xe7, 0x86, 0x4c, 0xaa, 0xf9, 0xec, 0x49, 0xed, 0x67, 0xb1, 0x90, 0x4c, 0xe8, 0x60, 0x26, 0x90 },
+  { 0xe7, 0xa7, 0x58, 0xbb, 0x0b, 0x43, 0xd0, 0xf7, 0x00, 0x4e, 0x92, 0xb9, 0xab, 0xf4, 0xbc, 0x83 },
+  { 0xe7, 0xdd, 0x8c, 0x2e, 0x6c, 0x10, 0x00, 0x44, 0x00, 0x2c, 0x10, 0x86, 0xd0, 0x2b, 0x36, 0x6e },
+  { 0xe7, 0xf0, 0x05, 0xdd, 0xb6, 0x90, 0x2c, 0x64, 0x8d, 0xe0, 0x98, 0x51, 0x1f, 0x6a, 0xe2, 0xe5 },
+  { 0xe8, 0x00, 0xe4, 0xae, 0xc7, 0xc6, 0xc5, 0x4c, 0x9c, 0xf3, 0xdb, 0x0d, 0x1d, 0x03, 0x00, 0x58 },
+  { 0xe8, 0x0a, 0x40, 0x26, 0xd2, 0x97, 0x77, 0xc3, 0xc7, 0x99, 0x3f, 0xbf, 0xae, 0xe8, 0x92, 0x0f },
+  { 0xe8, 0x23, 0xb1, 0x37, 0x51, 0xe4, 0x38, 0x8f, 0x1f, 0x2a, 0x37, 0x5d, 0x35, 0x60, 0xa8, 0xd7 },
+  { 0xe8, 0x79, 0xb7, 0x09, 0x3a, 0xc4, 0xcf, 0xad, 0x74, 0xc8, 0x8d, 0x63, 0x6c, 0xa9, 0x7d, 0x00 },
+  { 0xe8, 0x83, 0x40, 0xf5, 0xbd, 0x2f, 0x03, 0xe2, 0xe9, 0xce, 0x5e, 0xcf, 0xa9, 0xc6, 0x44, 0xf5 },
+  { 0xe8, 0xa3, 0x47, 0x3b, 0xf7, 0x86, 0xcf, 0x79, 0x6d, 0x13, 0x36, 0xd2, 0xd0, 0x3a, 0x00, 0x08 },
+  { 0xe8, 0xaa, 0x36, 0xe3, 0xd4, 0x9e, 0x9b, 0xfa, 0x65, 0x4c, 0x25, 0xdc, 0xc1, 0x9c, 0x74, 0xe6 },
+  { 0xe8, 0xe7, 0xb9, 0xbd, 0xf4, 0xbf, 0x04, 0x93, 0x0c, 0x2b, 0xca, 0xa0, 0x27, 0x8e, 0xe6, 0x37 },
+  { 0xe8, 0xf7, 0x67, 0x93, 0x59, 0xc4, 0xf5, 0x32, 0xf5, 0xd5, 0xe9, 0x3a, 0xf7, 0xd8, 0xa9, 0x85 },
+  { 0xe9, 0x03, 0x4b, 0x41, 0x74, 0x1d, 0xce, 0xe6, 0x4a, 0xb6, 0x60, 0x5a, 0xba, 0x9d, 0xe4, 0x55 },
+  { 0xe9, 0x08, 0x61, 0x1d, 0x99, 0x89, 0x07, 0x33, 0xbe, 0x31, 0x73, 0x3a, 0x97, 0x9c, 0x62, 0xd8 },
+  { 0xe9, 0x1d, 0x2e, 0xcf, 0x88, 0x03, 0xae, 0x52, 0xb5, 0x5b, 0xbf, 0x10, 0x5a, 0xf0, 0x4d, 0x4b },
+  { 0xe9, 0x23, 0x00, 0x10, 0x15, 0xbe, 0xdd, 0x79, 0x01, 0x56, 0x9f, 0x03, 0x5d, 0x9c, 0x59, 0x2c },
+  { 0xe9, 0x27, 0xec, 0xf8, 0x0f, 0x37, 0x84, 0xd7, 0x45, 0xab, 0xd8, 0x36, 0x8d, 0x78, 0xf2, 0xf3 },
+  { 0xe9, 0x32, 0xf4, 0x4f, 0xad, 0x2a, 0x66, 0xb6, 0xd5, 0xfa, 0xec, 0x9a, 0xdd, 0xec, 0x20, 0x8e },
+  { 0xe9, 0x46, 0x32, 0xb0, 0xd8, 0x63, 0xdd, 0x76, 0x45, 0x9d, 0x68, 0x9a, 0x98, 0x65, 0xbb, 0x33 },
+  { 0xe9, 0x57, 0xeb, 0x46, 0x12, 0xd6, 0xbd, 0x59, 0x40, 0xd3, 0x49, 0x2d, 0xfa, 0x74, 0x96, 0x68 },
+  { 0xe9, 0x59, 0xb5, 0xa2, 0xc8, 0x82, 0xcc, 0xaa, 0xcb, 0x43, 0xc3, 0x27, 0x90, 0x95, 0x7c, 0x2d },
+  { 0xe9, 0x7e, 0xaf, 0xd0, 0x63, 0x56, 0x51, 0xd3, 0x99, 0x9c, 0xec, 0xe9, 0x53, 0xc0, 0x6b, 0xd5 },
+  { 0xe9, 0xbe, 0x3e, 0x8e, 0x4a, 0x7e, 0x73, 0xdd, 0x63, 0xed, 0x42, 0x35, 0xa3, 0xa1, 0xa2, 0x5f },
+  { 0xe9, 0xc5, 0xd0, 0x46, 0x43, 0x85, 0x59, 0x49, 0xa2, 0x3f, 0xf2, 0x93, 0x49, 0xaf, 0x74, 0xea },
+  { 0xe9, 0xc7, 0x1f, 0x8c, 0xdb, 0xa6, 0x03, 0x75, 0x21, 0xc9, 0xa3, 0xc7, 0x08, 0x19, 0xd1, 0x71 },
+  { 0xe9, 0xcb, 0x18, 0x77, 0x0a, 0x41, 0xa1, 0x6d, 0xe6, 0x3b, 0x12, 0x4c, 0x1e, 0x8b, 0xd4, 0x93 },
+  { 0xe9, 0xe6, 0x46, 0xf7, 0x30, 0xb8, 0x40, 0x0c, 0xd5, 0xda, 0x08, 0xc8, 0x49, 0xef, 0x3e, 0x3b },
+  { 0xe9, 0xe6, 0xad, 0x30, 0x54, 0x9a, 0x6e, 0x2c, 0xd8, 0x9f, 0xe9, 0x3b, 0x76, 0x91, 0xd4, 0x47 },
+  { 0xe9, 0xf2, 0x5c, 0x7a, 0xf4, 0xf2, 0x7c, 0x9e, 0x1b, 0x5b, 0x8f, 0x6f, 0xe6, 0x14, 0x1e, 0x8c },
+  { 0xea, 0x38, 0xfc, 0xfc, 0x06, 0xad, 0x87, 0xa0, 0xae, 0xd1, 0xa3, 0xd1, 0x58, 0x87, 0x44, 0xe4 },
+  { 0xea, 0x6d, 0x40, 0xdb, 0x54, 0x98, 0xd6, 0x38, 0x65, 0x71, 0xa7, 0x6d, 0xf4, 0x48, 0xaa, 0x4c },
+  { 0xea, 0x7e, 0x25, 0xad, 0xe3, 0xfe, 0x68, 0xf5, 0xb7, 0x86, 0xee, 0x0a, 0xa8, 0x2b, 0x1f, 0xe5 },
+  { 0xea, 0x83, 0x2e, 0x2c, 0xb6, 0xaa, 0xe6, 0xf5, 0x25, 0xf0, 0x74, 0x52, 0xc3, 0x81, 0xfa, 0x48 },
+  { 0xea, 0x86, 0x17, 0x6b, 0x27, 0xab, 0x0d, 0xa8, 0xcc, 0xe8, 0xf0, 0x17, 0x98, 0x84, 0xbf, 0xaa },
+  { 0xea, 0xac, 0xfc, 0xdc, 0x1d, 0x4e, 0xe1, 0x25, 0x84, 0x29, 0xb7, 0xae, 0x7f, 0x08, 0x41, 0x25 },
+  { 0xea, 0xd6, 0x04, 0x51, 0xc2, 0x86, 0x35, 0xb5, 0x5c, 0xa8, 0xfe, 0xa1, 0x98, 0x44, 0x4e, 0x16 },
+  { 0xea, 0xda, 0x0d, 0xd6, 0x1c, 0xe1, 0x3f, 0x83, 0x17, 0xde, 0x77, 0x4d, 0xc1, 0xe6, 0x86, 0x04 },
+  { 0xea, 0xe0, 0xc0, 0x6e, 0xe6, 0x1c, 0x63, 0xb8, 0x1c, 0xd0, 0x16, 0x09, 0x6f, 0xc9, 0x01, 0xb0 },
+  { 0xea, 0xe6, 0xa5, 0x51, 0x00, 0x55, 0x34, 0x1d, 0x3a, 0xbe, 0xb4, 0x56, 0x67, 0xbb, 0x3e, 0x9b },
+  { 0xea, 0xf7, 0x44, 0x18, 0x5d, 0x5e, 0x8d, 0xef, 0x89, 0x99, 0x50, 0xba, 0x7c, 0x6e, 0x7b, 0xb5 },
+  { 0xea, 0xfe, 0x8b, 0x40, 0x31, 0x3a, 0x65, 0x79, 0x2e, 0x88, 0xff, 0x9f, 0x2f, 0xe2, 0x65, 0x5c },
+  { 0xeb, 0x3d, 0x68, 0x06, 0x99, 0xf8, 0x76, 0x2f, 0x71, 0xf3, 0x8e, 0x28, 0xe3, 0x21, 0x23, 0x4d },
+  { 0xeb, 0x42, 0x52, 0xfa, 0xff, 0x7a, 0x4f, 0x2b, 0xa5, 0x28, 0x4a, 0x98, 0xb8, 0xf7, 0x8d, 0x1a },
+  { 0xeb, 0x46, 0xe9, 0x9e, 0xc1, 0x58, 0x58, 0xf8, 0xcd, 0x8c, 0x91, 0xce, 0xf3, 0x84, 0xce, 0x09 },
+  { 0xeb, 0x50, 0x3c, 0xc6, 0x4c, 0x35, 0x60, 0xcd, 0x78, 0xb7, 0x05, 0x11, 0x88, 0xb7, 0xba, 0x56 },
+  { 0xeb, 0x63, 0x46, 0x50, 0xc3, 0x91, 0x21, 0x32, 0x09, 0x2b, 0x7a, 0xee, 0x54, 0x0b, 0xbc, 0xe3 },
+  { 0xeb, 0x6d, 0x6e, 0x22, 0xa1, 0x6f, 0x30, 0x68, 0x7a, 0xde, 0x52, 0x6d, 0x7a, 0x6f, 0x05, 0xc5 },
+  { 0xeb, 0x71, 0x74, 0x3c, 0x6c, 0x7c, 0xcc, 0xe5, 0xb1, 0x08, 0xfa, 0xd7, 0x0a, 0x32, 0x6a, 0xd9 },
+  { 0xeb, 0x79, 0x34, 0x36, 0x06, 0x58, 0xa2, 0x9c, 0x50, 0xae, 0xaf, 0xf2, 0x0b, 0xfd, 0xa2, 0x3b },
+  { 0xeb, 0x92, 0x19, 0x3f, 0x06, 0xb6, 0x45, 0xdf, 0x0b, 0x2a, 0x15, 0xd0, 0x77, 0xce, 0x43, 0x5f },
+  { 0xeb, 0x97, 0x12, 0xe4, 0x23, 0xb5, 0x7f, 0x0b, 0x07, 0xcc, 0xd3, 0x15, 0xbb, 0x9a, 0xbf, 0x61 },
+  { 0xeb, 0x9f, 0x8b, 0x84, 0xc1, 0x93, 0xd9, 0xd9, 0x3a, 0x58, 0xfc, 0xa1, 0x12, 0xaa, 0x39, 0xed },
+  { 0xeb, 0xcb, 0x08, 0x4a, 0x91, 0xd4, 0x18, 0x65, 0xb2, 0xc1, 0x91, 0x57, 0x79, 0x00, 0x1c, 0xa7 },
+  { 0xeb, 0xcb, 0xc8, 0xa1, 0x81, 0xa7, 0x38, 0xe1, 0x3d, 0xf6, 0x21, 0x6e, 0x5c, 0x32, 0x92, 0x30 },
+  { 0xeb, 0xd2, 0x48, 0x8d, 0xca, 0xce, 0x40, 0x47, 0x4c, 0x1a, 0x78, 0xfa, 0x53, 0xeb, 0xfa, 0xdf },
+  { 0xeb, 0xf2, 0xdf, 0xf7, 0x8a, 0x08, 0x73, 0x32, 0x51, 0xbf, 0x38, 0x38, 0xf0, 0x2f, 0x79, 0x38 },
+  { 0xeb, 0xf9, 0x03, 0x8e, 0x92, 0x7e, 0x6a, 0x0d, 0xb3, 0xe0, 0xd1, 0x70, 0xc5, 0x99, 0x11, 0xe6 },
+  { 0xec, 0x26, 0xfd, 0xc8, 0x7b, 0x1d, 0x35, 0xf1, 0xd6, 0x0e, 0xa8, 0x9c, 0xda, 0x4f, 0x4d, 0xd4 },
+  { 0xec, 0x3b, 0xeb, 0x6d, 0x8b, 0x56, 0x89, 0xe8, 0x67, 0xba, 0xfb, 0x5d, 0x5f, 0x50, 0x74, 0x91 },
+  { 0xec, 0x40, 0x7a, 0x20, 0x6b, 0x71, 0x8a, 0x0a, 0x9f, 0x69, 0xb0, 0x3e, 0x92, 0x0a, 0x01, 0x85 },
+  { 0xec, 0x5c, 0x86, 0x1b, 0x48, 0x7a, 0x50, 0x75, 0x87, 0x6a, 0xb0, 0x11, 0x55, 0xe7, 0x4c, 0x6c },
+  { 0xec, 0xe4, 0x63, 0xab, 0xde, 0x92, 0xe8, 0xb8, 0x9b, 0xcd, 0x86, 0x7e, 0xc7, 0x17, 0x51, 0xb8 },
+  { 0xec, 0xe9, 0x08, 0xd7, 0x7a, 0xb9, 0x44, 0xf7, 0xba, 0xc8, 0x43, 0x22, 0xb9, 0x97, 0x35, 0x49 },
+  { 0xec, 0xf5, 0x13, 0x85, 0x38, 0x4b, 0x46, 0x88, 0x34, 0x61, 0x1d, 0x44, 0xa8, 0x42, 0x9c, 0x03 },
+  { 0xec, 0xfa, 0x04, 0x52, 0x3d, 0xde, 0x82, 0xfe, 0x42, 0xcd, 0xc7, 0x31, 0x5a, 0x8f, 0x61, 0xb6 },
+  { 0xed, 0x01, 0x4b, 0xee, 0xeb, 0x77, 0xdb, 0xb2, 0xbb, 0xcf, 0x9b, 0x5f, 0x68, 0x50, 0xb2, 0xf4 },
+  { 0xed, 0x04, 0x51, 0x01, 0x0d, 0x02, 0x2b, 0x96, 0xa4, 0x64, 0xfe, 0xbc, 0xba, 0x70, 0xb9, 0xc4 },
+  { 0xed, 0x0a, 0xb9, 0x09, 0xcf, 0x7b, 0x30, 0xaf, 0xf6, 0xfc, 0x28, 0xc3, 0xa4, 0x66, 0x0b, 0x8e },
+  { 0xed, 0x13, 0x06, 0x43, 0x6c, 0xe2, 0x37, 0xaf, 0xc5, 0xa7, 0xed, 0x3f, 0x77, 0x13, 0x42, 0x02 },
+  { 0xed, 0x14, 0x92, 0xd4, 0xca, 0xfd, 0x7e, 0xbf, 0x06, 0x4f, 0x0c, 0x93, 0x32, 0x49, 0xf5, 0xb0 },
+  { 0xed, 0x1a, 0x78, 0x48, 0x75, 0x53, 0x8c, 0x78, 0x71, 0xd0, 0x35, 0xb7, 0xa9, 0x8c, 0x24, 0x33 },
+  { 0xed, 0x22, 0x18, 0xb3, 0x07, 0x5d, 0x15, 0xea, 0xa3, 0x4e, 0x33, 0x56, 0x02, 0x5c, 0xcc, 0xa3 },
+  { 0xed, 0x5c, 0xcf, 0xc9, 0x3a, 0xd4, 0x56, 0x10, 0x75, 0x43, 0x6e, 0xe4, 0x2a, 0x15, 0x43, 0x8a },
+  { 0xed, 0x8f, 0x31, 0x9e, 0x82, 0xd3, 0x55, 0x83, 0x21, 0x95, 0xeb, 0x77, 0x15, 0x64, 0x47, 0x95 },
+  { 0xed, 0x99, 0x99, 0x91, 0x1b, 0x40, 0x6d, 0xc5, 0xf7, 0x5c, 0x85, 0x0d, 0xcc, 0x17, 0xbd, 0xf4 },
+  { 0xed, 0xde, 0xf1, 0x0f, 0xdc, 0x00, 0x29, 0x30, 0x10, 0x64, 0x11, 0x5a, 0xe0, 0xcd, 0x41, 0xd4 },
+  { 0xed, 0xe4, 0xab, 0x11, 0xca, 0x34, 0x6b, 0xd0, 0x23, 0xb2, 0xc2, 0x1d, 0x94, 0x1e, 0x0c, 0x50 },
+  { 0xed, 0xe7, 0xe8, 0xbf, 0x86, 0x5b, 0x0a, 0xfb, 0x47, 0x44, 0xf8, 0x6d, 0x13, 0x62, 0x4f, 0x9a },
+  { 0xed, 0xf6, 0x9b, 0x12, 0x3e, 0x06, 0xea, 0xf8, 0x66, 0x3c, 0xc7, 0x8d, 0x8a, 0xeb, 0xa0, 0x6e },
+  { 0xee, 0x28, 0x42, 0x4a, 0xf3, 0x89, 0xa7, 0xf3, 0x67, 0x21, 0x82, 0x00, 0x94, 0x72, 0x50, 0x0c },
+  { 0xee, 0x45, 0x65, 0x42, 0xb9, 0x3f, 0xa8, 0xd7, 0xe6, 0xa8, 0xc6, 0x89, 0xb5, 0xa0, 0x41, 0x3c },
+  { 0xee, 0x4c, 0x18, 0x61, 0x23, 0xd3, 0x1a, 0x27, 0x9e, 0xd7, 0xa8, 0x4d, 0x35, 0x78, 0xdf, 0x23 },
+  { 0xee, 0x65, 0x9a, 0xe5, 0x0e, 0x9d, 0xf8, 0x86, 0xac, 0x4f, 0x8d, 0x7a, 0xd1, 0x0d, 0x04, 0x6a },
+  { 0xee, 0x66, 0x65, 0x68, 0x3e, 0xbd, 0xb5, 0x39, 0xe8, 0x9b, 0xa6, 0x20, 0x98, 0x1c, 0xb0, 0xf6 },
+  { 0xee, 0x67, 0xdc, 0x0b, 0x01, 0x74, 0x63, 0x72, 0xd2, 0xb9, 0x83, 0xd8, 0x8f, 0x48, 0xe2, 0x4f },
+  { 0xee, 0x68, 0x1f, 0x56, 0x6a, 0xad, 0x6c, 0x07, 0xc6, 0x1b, 0xbb, 0xfc, 0x66, 0xd7, 0x4a, 0x27 },
+  { 0xee, 0x6c, 0xbe, 0xdf, 0x6c, 0x0a, 0xac, 0x90, 0xfa, 0xa0, 0xa8, 0xdb, 0xc0, 0x93, 0xff, 0xbe },
+  { 0xee, 0x80, 0x27, 0xd5, 0x54, 0xd1, 0x4c, 0x8d, 0x0b, 0x86, 0xf9, 0x47, 0x37, 0xd2, 0xfd, 0xcc },
+  { 0xee, 0x84, 0xbd, 0xc5, 0xda, 0xe2, 0x68, 0xe2, 0x27, 0xe4, 0x07, 0xc7, 0xb5, 0xe6, 0xb6, 0xb7 },
+  { 0xee, 0x9c, 0xae, 0xe4, 0xeb, 0x95, 0x82, 0x84, 0xfb, 0x10, 0xc2, 0x77, 0xb1, 0x45, 0x37, 0xf1 },
+  { 0xee, 0xa0, 0xda, 0x9b, 0x98, 0x7d, 0x66, 0x12, 0x64, 0xcc, 0xe6, 0x9a, 0x7c, 0x13, 0xc3, 0xbd },
+  { 0xee, 0xb9, 0x2f, 0x3f, 0x46, 0xdf, 0x84, 0x14, 0x87, 0xd1, 0x50, 0x4f, 0x28, 0x96, 0xd6, 0x1a },
+  { 0xee, 0xc6, 0x1c, 0xc4, 0x25, 0x0d, 0xf7, 0x09, 0x39, 0xd4, 0x8f, 0xe0, 0x2d, 0x71, 0x22, 0xac },
+  { 0xee, 0xd9, 0xea, 0xf1, 0xa0, 0xb6, 0xa2, 0xb9, 0xbc, 0x4c, 0x80, 0x32, 0xcb, 0x43, 0xe3, 0xfb },
+  { 0xee, 0xe7, 0x69, 0x5a, 0xe3, 0xee, 0xa7, 0x81, 0x83, 0x21, 0xdf, 0x0b, 0x79, 0x0b, 0x31, 0xf3 },
+  { 0xef, 0x26, 0x3d, 0x40, 0xa2, 0x34, 0x83, 0xab, 0x33, 0x9c, 0xac, 0x44, 0xd9, 0x51, 0x5a, 0x56 },
+  { 0xef, 0x3a, 0x4f, 0x64, 0xb6, 0x49, 0x4b, 0xa7, 0x70, 0x86, 0x27, 0x68, 0xca, 0xf0, 0x4b, 0x86 },
+  { 0xef, 0x60, 0xb0, 0x6f, 0xdd, 0xb6, 0x75, 0xb0, 0xd7, 0x83, 0xaf, 0xbf, 0xa5, 0xfc, 0x52, 0x32 },
+  { 0xef, 0x66, 0xaf, 0x19, 0x08, 0x40, 0x87, 0x14, 0x09, 0xfe, 0x17, 0x02, 0xd2, 0x48, 0x35, 0x54 },
+  { 0xef, 0x71, 0xe9, 0xfb, 0x0d, 0x8d, 0x47, 0x72, 0x26, 0xd8, 0xd4, 0x22, 0x61, 0xfb, 0xf0, 0xa7 },
+  { 0xef, 0x76, 0xea, 0x05, 0x65, 0x5a, 0x0b, 0x62, 0xcb, 0x10, 0x18, 0xc9, 0x2b, 0x9b, 0x4b, 0x7d },
+  { 0xef, 0xa1, 0x09, 0x8c, 0x7d, 0x09, 0x1b, 0x94, 0x0c, 0x25, 0x43, 0xab, 0xe3, 0x72, 0xf0, 0x36 },
+  { 0xef, 0xb4, 0x7d, 0x70, 0xb2, 0x96, 0x5c, 0xe6, 0x89, 0xe2, 0xc5, 0x75, 0x76, 0x16, 0xb2, 0x86 },
+  { 0xef, 0xd3, 0x87, 0x43, 0x0a, 0x35, 0xa6, 0x59, 0xff, 0x56, 0x9a, 0x9a, 0x0e, 0xc2, 0x22, 0x09 },
+  { 0xef, 0xef, 0xc0, 0x2b, 0xbc, 0x52, 0x58, 0x81, 0x54, 0x57, 0xf7, 0xa5, 0xb8, 0xd8, 0x75, 0x0a },
+  { 0xef, 0xff, 0xaf, 0xc1, 0x7b, 0x7c, 0xb0, 0x1b, 0x9c, 0xa3, 0x53, 0x24, 0xaa, 0x76, 0x73, 0x64 },
+  { 0xf0, 0x2b, 0xa8, 0xb5, 0x29, 0x2b, 0xf3, 0x01, 0x7d, 0x10, 0x55, 0x3c, 0x9b, 0x7b, 0x28, 0x61 },
+  { 0xf0, 0x32, 0xb2, 0xf2, 0xd8, 0x32, 0x34, 0x04, 0xa6, 0xb4, 0x54, 0x1f, 0x92, 0xdd, 0x18, 0x25 },
+  { 0xf0, 0x47, 0xdf, 0x70, 0xd3, 0xd0, 0x8e, 0x33, 0x11, 0x22, 0xcd, 0x2d, 0xe6, 0x1d, 0x6a, 0xf8 },
+  { 0xf0, 0x4e, 0xe8, 0x00, 0x11, 0xd9, 0x57, 0x98, 0x00, 0x63, 0x78, 0x64, 0x36, 0x50, 0xaa, 0xa7 },
+  { 0xf0, 0x53, 0x63, 0x03, 0xf4, 0x90, 0x06, 0x80, 0x6b, 0xac, 0x3a, 0xec, 0x15, 0x73, 0x83, 0x36 },
+  { 0xf0, 0x54, 0x1d, 0x2f, 0x7c, 0xda, 0x5e, 0xc7, 0xba, 0xb6, 0xd6, 0x2b, 0x61, 0x28, 0xb8, 0x23 },
+  { 0xf0, 0x60, 0x82, 0x66, 0x26, 0xaa, 0xc9, 0xe0, 0xd8, 0xcd, 0xa0, 0x28, 0x2f, 0x4b, 0x7f, 0xc3 },
+  { 0xf0, 0x63, 0x1c, 0x66, 0x75, 0x03, 0x34, 0x28, 0x23, 0x84, 0x08, 0x88, 0x5d, 0x7e, 0x4f, 0xde },
+  { 0xf0, 0x66, 0xbe, 0xa7, 0xab, 0x0a, 0x37, 0xb8, 0x3c, 0x83, 0xc9, 0x24, 0xa8, 0x7c, 0x5b, 0x67 },
+  { 0xf0, 0xa6, 0xe9, 0x9f, 0x58, 0x75, 0x89, 0x12, 0x46, 0xc3, 0xdb, 0xec, 0xbf, 0x2d, 0x2c, 0xea },
+  { 0xf0, 0xb7, 0xdb, 0x93, 0x0c, 0xa0, 0xe5, 0x48, 0xc4, 0x1a, 0x97, 0x16, 0x0b, 0x9f, 0x62, 0x75 },
+  { 0xf0, 0xca, 0xca, 0xe1, 0xd1, 0xb7, 0x9e, 0xe9, 0x2f, 0x0d, 0xc0, 0x35, 0xf4, 0x2e, 0x05, 0x60 },
+  { 0xf0, 0xd3, 0x93, 0xdb, 0xf4, 0x16, 0x4a, 0x68, 0x8b, 0x23, 0x46, 0x77, 0x0c, 0x9b, 0xbd, 0x12 },
+  { 0xf0, 0xda, 0xaa, 0x96, 0x61, 0x99, 0xef, 0x2b, 0x49, 0x40, 0x3e, 0x9a, 0x29, 0xd1, 0x2c, 0x50 },
+  { 0xf0, 0xe0, 0xad, 0xdc, 0x07, 0x97, 0x15, 0x61, 0xab, 0x80, 0xd9, 0xab, 0xe1, 0xb8, 0xd3, 0x33 },
+  { 0xf1, 0x0e, 0x3f, 0x45, 0xfb, 0x01, 0x41, 0x6c, 0x87, 0xe5, 0x83, 0x5a, 0xb2, 0x70, 0xb5, 0x3a },
+  { 0xf1, 0x12, 0x7a, 0xde, 0x54, 0x03, 0x72, 0x36, 0xe7, 0x5a, 0x13, 0x3b, 0x1d, 0xfc, 0x38, 0x9d },
+  { 0xf1, 0x1c, 0xfa, 0xb0, 0x87, 0xfc, 0xbd, 0x93, 0x0a, 0xb8, 0xb0, 0xbe, 0xcc, 0x5b, 0x2e, 0x5a },
+  { 0xf1, 0x2a, 0xfb, 0xff, 0xa0, 0x80, 0xdd, 0x3b, 0x28, 0x01, 0xdd, 0x14, 0xd4, 0x83, 0x7c, 0xf6 },
+  { 0xf1, 0x37, 0x21, 0x15, 0x37, 0x43, 0x8b, 0x1f, 0xce, 0x3d, 0x81, 0x1b, 0xae, 0xf2, 0x54, 0x57 },
+  { 0xf1, 0x48, 0x9e, 0x27, 0xa4, 0x53, 0x9a, 0x0c, 0x6c, 0x85, 0x29, 0x26, 0x2f, 0x9f, 0x7e, 0x18 },
+  { 0xf1, 0x4d, 0x5e, 0x96, 0xec, 0x33, 0x80, 0xae, 0xf5, 0x7a, 0x4b, 0x70, 0x13, 0x2c, 0x66, 0x77 },
+  { 0xf1, 0x55, 0x45, 0x69, 0x32, 0x1d, 0xc9, 0x33, 0xc8, 0x79, 0x81, 0xcf, 0x5c, 0x23, 0x9c, 0x43 },
+  { 0xf1, 0x6c, 0x70, 0x9d, 0xf0, 0xa6, 0xc5, 0x2f, 0x47, 0xff, 0x52, 0xb9, 0xd9, 0x5b, 0x7d, 0x8d },
+  { 0xf1, 0x92, 0x9b, 0xb9, 0xb5, 0xdb, 0x22, 0xd9, 0x8d, 0xd9, 0x92, 0xaa, 0x3f, 0xe7, 0x29, 0x20 },
+  { 0xf1, 0x9a, 0xba, 0x18, 0xf8, 0x6e, 0x41, 0x58, 0x12, 0x48, 0x0a, 0xd2, 0xbe, 0x22, 0x14, 0x25 },
+  { 0xf1, 0xa0, 0xa2, 0x3e, 0x64, 0x64, 0xd9, 0x54, 0xe3, 0xa9, 0x57, 0x9c, 0x4c, 0xcd, 0x01, 0xc8 },
+  { 0xf1, 0xae, 0x63, 0x05, 0xfa, 0x33, 0xa9, 0x48, 0xe3, 0x6d, 0xeb, 0x0e, 0xf1, 0x2a, 0xf8, 0x52 },
+  { 0xf1, 0xb2, 0xea, 0x56, 0x8b, 0x3e, 0x15, 0x6e, 0x3f, 0x28, 0x49, 0xda, 0xc8, 0x35, 0x91, 0xf6 },
+  { 0xf1, 0xb7, 0xed, 0xff, 0x81, 0xce, 0xef, 0x5a, 0xf7, 0xae, 0x1f, 0xa7, 0x6c, 0x85, 0x90, 0xfc },
+  { 0xf1, 0xbe, 0xca, 0x5a, 0x19, 0x8c, 0xf0, 0x81, 0x90, 0x48, 0x7e, 0x5c, 0x27, 0xb8, 0xe5, 0x40 },
+  { 0xf1, 0xe3, 0x75, 0xd9, 0x21, 0x85, 0x84, 0x67, 0x16, 0x6e, 0x53, 0xbc, 0xec, 0x05, 0x80, 0x3f },
+  { 0xf1, 0xee, 0xec, 0xcc, 0x4b, 0xba, 0x69, 0x99, 0x34, 0x5a, 0x25, 0x75, 0xae, 0x96, 0x50, 0x8e },
+  { 0xf1, 0xfe, 0x06, 0xeb, 0xe2, 0x90, 0x0e, 0xac, 0x4c, 0xdd, 0x17, 0x79, 0x93, 0x89, 0xa1, 0x02 },
+  { 0xf2, 0x06, 0x75, 0xc8, 0xb9, 0x85, 0x18, 0x36, 0x7b, 0x9f, 0x5b, 0x8e, 0xe6, 0xf7, 0xc8, 0xea },
+  { 0xf2, 0x0b, 0xd7, 0x56, 0xf3, 0x99, 0x0e, 0x06, 0xc4, 0x92, 0xf5, 0x3c, 0xd0, 0x16, 0x8e, 0x68 },
+  { 0xf2, 0x18, 0x13, 0xaa, 0x05, 0x04, 0x37, 0xf0, 0xdb, 0xc8, 0x47, 0x98, 0x64, 0xac, 0xec, 0x6d },
+  { 0xf2, 0x40, 0xba, 0x9f, 0x80, 0x92, 0xd2, 0xe8, 0xa4, 0xc7, 0xd8, 0x2c, 0x55, 0x4b, 0xf5, 0x09 },
+  { 0xf2, 0x80, 0x97, 0x6d, 0x69, 0xd6, 0xe2, 0x7a, 0x48, 0x50, 0x6b, 0xd6, 0xba, 0xd1, 0x1d, 0xcd },
+  { 0xf2, 0x83, 0xcc, 0x29, 0x4e, 0xce, 0x52, 0x0c, 0x2b, 0xad, 0xf9, 0xda, 0x20, 0xcf, 0xc0, 0x25 },
+  { 0xf2, 0x8c, 0x07, 0x76, 0x7b, 0x3e, 0x90, 0xa2, 0x68, 0x9a, 0xde, 0x5b, 0x5e, 0x30, 0x58, 0x74 },
+  { 0xf2, 0xd4, 0x0c, 0x70, 0xcf, 0x3e, 0x1d, 0x03, 0xbc, 0x11, 0x27, 0x96, 0x31, 0x58, 0x88, 0xd9 },
+  { 0xf2, 0xd4, 0xd6, 0x18, 0x79, 0x03, 0xca, 0xc2, 0xd5, 0xea, 0x8e, 0xd9, 0x0d, 0xad, 0x12, 0x0d },
+  { 0xf2, 0xe4, 0xfb, 0x2d, 0x36, 0x00, 0xc0, 0xf7, 0x6d, 0x05, 0x86, 0x4e, 0x65, 0x8c, 0xc5, 0x7b },
+  { 0xf2, 0xf2, 0xcb, 0x35, 0xfd, 0xef, 0x06, 0x3c, 0x96, 0x6c, 0x1f, 0x54, 0x81, 0x05, 0x0e, 0xa2 },
+  { 0xf2, 0xf5, 0x96, 0x29, 0xd7, 0x34, 0x1c, 0x97, 0x64, 0x44, 0x05, 0xda, 0xea, 0xc0, 0x88, 0x45 },
+  { 0xf3, 0x03, 0x63, 0x0a, 0x2d, 0x73, 0x16, 0x78, 0x7a, 0xec, 0xd6, 0x7f, 0xff, 0x6b, 0x2e, 0x33 },
+  { 0xf3, 0x21, 0x3a, 0x8a, 0x70, 0x2b, 0x06, 0x46, 0xd2, 0xea, 0xf9, 0xee, 0x07, 0x22, 0xb5, 0x1c },
+  { 0xf3, 0x3f, 0x1d, 0x0f, 0x78, 0x19, 0xc7, 0x41, 0x48, 0xda, 0xcb, 0x48, 0xcb, 0xf1, 0xc5, 0x97 },
+  { 0xf3, 0x44, 0xac, 0x12, 0x79, 0x15, 0x21, 0x57, 0xd6, 0x3e, 0x64, 0xaa, 0x39, 0x47, 0x95, 0x99 },
+  { 0xf3, 0x4d, 0xd3, 0xb8, 0x15, 0x6a, 0xaf, 0x11, 0x3c, 0xb6, 0x21, 0xb2, 0xe5, 0x1d, 0x90, 0xb8 },
+  { 0xf3, 0x4f, 0x08, 0xe5, 0xeb, 0x96, 0xe5, 0x00, 0xe8, 0x51, 0xa8, 0x0b, 0xe3, 0x27, 0x7a, 0x56 },
+  { 0xf3, 0x67, 0xe5, 0x86, 0x67, 0xa3, 0x0e, 0x74, 0x82, 0x17, 0x58, 0x09, 0xe3, 0xce, 0xc4, 0xd4 },
+  { 0xf3, 0x83, 0x58, 0xcd, 0x8f, 0x5e, 0xcf, 0xed, 0xff, 0xd5, 0xac, 0xa1, 0xaa, 0x93, 0x9f, 0x18 },
+  { 0xf3, 0x9e, 0x4b, 0xc9, 0x98, 0x45, 0xed, 0xd8, 0x62, 0x1b, 0x0f, 0x3c, 0x7b, 0x8c, 0x4f, 0xd9 },
+  { 0xf3, 0xc4, 0x31, 0x93, 0x0e, 0x03, 0x5a, 0x45, 0x7f, 0xe3, 0x70, 0xed, 0x4d, 0x23, 0x06, 0x59 },
+  { 0xf3, 0xcd, 0x0f, 0x88, 0x62, 0x01, 0xd1, 0x37, 0x6f, 0x3a, 0xba, 0xb2, 0xdf, 0x53, 0xb1, 0xb9 },
+  { 0xf3, 0xdf, 0xae, 0x77, 0x4f, 0x3b, 0xd0, 0x05, 0xa0, 0x26, 0xe2, 0x98, 0x94, 0xdb, 0x40, 0xd3 },
+  { 0xf3, 0xf5, 0xf7, 0x2b, 0xfd, 0xd6, 0x7f, 0x3d, 0x0e, 0x45, 0xd0, 0x97, 0xe1, 0x1b, 0x80, 0x91 },
+  { 0xf3, 0xf9, 0x2a, 0xad, 0x3a, 0x33, 0x5f, 0x0a, 0x1e, 0xad, 0x24, 0xa0, 0x21, 0x4f, 0xf4, 0x46 },
+  { 0xf4, 0x20, 0x4f, 0xc9, 0x2d, 0x17, 0xed, 0x4c, 0xb5, 0x67, 0xc4, 0x03, 0x61, 0xad, 0x58, 0xf1 },
+  { 0xf4, 0x46, 0x91, 0x78, 0xcd, 0x89, 0x98, 0xcb, 0x43, 0x7f, 0xa1, 0x10, 0xa2, 0x28, 0xea, 0xca },
+  { 0xf4, 0x56, 0x44, 0xff, 0x82, 0xb5, 0x33, 0xa7, 0x81, 0xa1, 0xee, 0x50, 0xf2, 0xe9, 0x5f, 0x3c },
+  { 0xf4, 0x57, 0x67, 0x4c, 0xef, 0x44, 0x9c, 0xfd, 0x85, 0xf2, 0x1d, 0xb2, 0xb4, 0xf6, 0x31, 0xa7 },
+  { 0xf4, 0x73, 0xf9, 0x9e, 0x47, 0xd4, 0x02, 0x6a, 0x7a, 0x57, 0x11, 0x84, 0x92, 0x2e, 0xbf, 0x04 },
+  { 0xf4, 0x80, 0x22, 0x23, 0x0b, 0xb7, 0x74, 0xa7, 0xf2, 0x21, 0x84, 0xb4, 0x8a, 0x33, 0x85, 0xaf },
+  { 0xf4, 0x87, 0x35, 0x11, 0x5e, 0xc3, 0x02, 0xba, 0x8b, 0xb2, 0xd2, 0xf3, 0xa4, 0x42, 0xe8, 0x14 },
+  { 0xf4, 0x9a, 0x34, 0xf1, 0xfd, 0xd7, 0xdc, 0x14, 0x7c, 0xbf, 0x96, 0xce, 0x2c, 0xe7, 0x1b, 0x76 },
+  { 0xf4, 0xab, 0x6b, 0xd5, 0xf8, 0x0d, 0x89, 0x88, 0x14, 0x1e, 0xdd, 0xe4, 0xc8, 0x4b, 0x23, 0xb5 },
+  { 0xf4, 0xb8, 0xa4, 0x7a, 0x95, 0xb6, 0x18, 0x95, 0xe6, 0x71, 0xc3, 0xec, 0x86, 0xff, 0xd4, 0x61 },
+  { 0xf4, 0xc2, 0xe5, 0x0b, 0x01, 0xdf, 0xf9, 0x9b, 0xdd, 0xbe, 0x03, 0x7b, 0x34, 0x89, 0x51, 0x1c },
+  { 0xf4, 0xc6, 0x62, 0x1f, 0x1a, 0x0b, 0x4d, 0x27, 0x08, 0x11, 0x23, 0xc0, 0x8d, 0x7d, 0x14, 0x97 },
+  { 0xf4, 0xcf, 0x68, 0x81, 0xb6, 0x5c, 0x42, 0x40, 0x95, 0xdc, 0x25, 0xdc, 0x98, 0x7f, 0x15, 0x1f },
+  { 0xf4, 0xda, 0xbd, 0x5b, 0xcc, 0x60, 0x3e, 0x84, 0x64, 0xa4, 0x78, 0x20, 0x80, 0x37, 0xd4, 0x23 },
+  { 0xf5, 0x26, 0xd0, 0xc5, 0x19, 0xf5, 0x00, 0x1a, 0xdb, 0x1f, 0xc7, 0x94, 0x8b, 0xfb, 0xb3, 0xce },
+  { 0xf5, 0x2f, 0x40, 0x29, 0x9f, 0xd2, 0x38, 0xc6, 0xff, 0xd9, 0xe6, 0x10, 0x70, 0x50, 0xdc, 0x76 },
+  { 0xf5, 0x39, 0xe3, 0x2b, 0xf6, 0xce, 0x39, 0xc8, 0xca, 0x47, 0xcb, 0x0c, 0xdd, 0x2c, 0x5c, 0xb8 },
+  { 0xf5, 0x42, 0xb5, 0xd0, 0x19, 0x3a, 0x39, 0x59, 0xb5, 0x4f, 0x3c, 0x4c, 0x80, 0x3b, 0xa2, 0x42 },
+  { 0xf5, 0x44, 0x5b, 0x52, 0x99, 0x9e, 0x22, 0x9e, 0x37, 0x89, 0xc3, 0x9e, 0x7e, 0xe9, 0x99, 0x47 },
+  { 0xf5, 0xa2, 0xf6, 0xef, 0xa3, 0x3a, 0x3e, 0x55, 0x41, 0xbc, 0x68, 0x0e, 0x9d, 0xc3, 0x1d, 0x5b },
+  { 0xf5, 0xa3, 0xe0, 0x51, 0x73, 0x0d, 0x45, 0xfe, 0xa5, 0x18, 0xf2, 0xe8, 0xb9, 0x26, 0x56, 0x5b },
+  { 0xf5, 0xaa, 0x6b, 0xd1, 0x0f, 0x66, 0x21, 0x99, 0xc4, 0x2e, 0x43, 0x86, 0x3a, 0x30, 0x10, 0x6c },
+  { 0xf5, 0xd1, 0x03, 0xa9, 0xae, 0x36, 0xd1, 0xd4, 0xee, 0x7e, 0xef, 0x65, 0x7b, 0x75, 0xd2, 0xb3 },
+  { 0xf6, 0x13, 0xaa, 0xd8, 0x4d, 0x21, 0x63, 0xd6, 0xb1, 0x97, 0xb2, 0x20, 0xbf, 0xec, 0x1b, 0x7e },
+  { 0xf6, 0x61, 0xf1, 0x29, 0x64, 0x4f, 0x33, 0x8b, 0x13, 0xd9, 0xf4, 0x51, 0x0d, 0x81, 0x6c, 0x03 },
+  { 0xf6, 0x67, 0x6e, 0x3f, 0xe9, 0x01, 0xeb, 0x85, 0x15, 0xfc, 0x7a, 0xe3, 0x10, 0x30, 0x2c, 0x3c },
+  { 0xf6, 0x71, 0x81, 0xb3, 0xa0, 0x1b, 0x9c, 0x91, 0x59, 0x84, 0x0b, 0x15, 0x44, 0x9b, 0x87, 0xb0 },
+  { 0xf6, 0x87, 0xec, 0x4b, 0x69, 0x61, 0x1a, 0x7f, 0x78, 0xbd, 0x69, 0xb8, 0xa5, 0x67, 0x93, 0x7a },
+  { 0xf6, 0x9a, 0x39, 0xb2, 0x15, 0x85, 0x2a, 0x0c, 0x27, 0x64, 0xd2, 0xa9, 0x23, 0xc1, 0xe4, 0x63 },
+  { 0xf6, 0x9b, 0xb5, 0x8b, 0x81, 0x5a, 0x6b, 0xdc, 0xa5, 0x48, 0xfa, 0x4d, 0x5e, 0x0d, 0x5a, 0x75 },
+  { 0xf6, 0x9d, 0x4f, 0xcf, 0x76, 0x94, 0x2f, 0xcd, 0x9b, 0xdf, 0x3f, 0xd8, 0xfd, 0xe7, 0x90, 0xfb },
+  { 0xf6, 0xa2, 0x82, 0x37, 0x44, 0x41, 0x01, 0x2b, 0x01, 0x71, 0x4e, 0x19, 0x69, 0x9f, 0xc6, 0x2a },
+  { 0xf6, 0xa9, 0xea, 0x81, 0x4d, 0x15, 0xb8, 0x5b, 0xff, 0xe9, 0x80, 0xc9, 0x27, 0xdf, 0x60, 0x6b },
+  { 0xf6, 0xb5, 0xeb, 0xb6, 0x5c, 0xbb, 0x29, 0x81, 0xaf, 0x4d, 0x54, 0x6c, 0x47, 0x06, 0x29, 0xd7 },
+  { 0xf6, 0xc1, 0x3e, 0x81, 0x6e, 0x58, 0xc8, 0xc6, 0x2f, 0x82, 0xb2, 0xc8, 0xb9, 0x1a, 0x2d, 0x67 },
+  { 0xf6, 0xd5, 0x12, 0xbe, 0xf1, 0xbf, 0x25, 0x3d, 0xc9, 0x35, 0xd0, 0xe1, 0x3c, 0x3d, 0x14, 0x62 },
+  { 0xf6, 0xda, 0xeb, 0xc0, 0x42, 0x4f, 0xa0, 0xf8, 0xd9, 0xaa, 0xf2, 0x6c, 0x86, 0xdf, 0x50, 0xf4 },
+  { 0xf6, 0xef, 0xa0, 0x0a, 0xe9, 0x9a, 0xaf, 0x33, 0xe4, 0x27, 0xb6, 0x74, 0xbc, 0xfd, 0x83, 0x4d },
+  { 0xf6, 0xf1, 0xb2, 0x7e, 0xfc, 0x24, 0x7a, 0x0e, 0x8d, 0x47, 0x3d, 0xdb, 0x42, 0x69, 0xff, 0x9e },
+  { 0xf7, 0x0e, 0x3f, 0x3b, 0xb2, 0xd1, 0x9e, 0xc2, 0xaa, 0xec, 0x8f, 0x78, 0xdc, 0x43, 0x74, 0x4f },
+  { 0xf7, 0x14, 0xa2, 0x23, 0x95, 0x4c, 0x28, 0xec, 0xcf, 0x45, 0x92, 0x95, 0x51, 0x7d, 0xca, 0xe6 },
+  { 0xf7, 0x24, 0xd3, 0xdd, 0x24, 0x71, 0xed, 0x4c, 0xf5, 0xf1, 0x91, 0xdb, 0xb7, 0x24, 0xb6, 0x9f },
+  { 0xf7, 0x36, 0x86, 0x44, 0x42, 0x16, 0x4b, 0x29, 0x23, 0x5e, 0x88, 0x72, 0x01, 0x31, 0x80, 0xcd },
+  { 0xf7, 0x3d, 0x2d, 0x0e, 0xff, 0x54, 0x8e, 0x8f, 0xc6, 0x69, 0x96, 0xf2, 0x7a, 0xcf, 0x2b, 0x4b },
+  { 0xf7, 0x42, 0x49, 0x85, 0xba, 0xc4, 0x10, 0x67, 0x50, 0x2b, 0x4a, 0x05, 0xb6, 0x4c, 0xb7, 0x5a },
+  { 0xf7, 0x4a, 0xd6, 0x42, 0x55, 0x23, 0x85, 0xc3, 0xda, 0xa2, 0x03, 0xa2, 0xa6, 0xfc, 0x22, 0x91 },
+  { 0xf7, 0x50, 0xb5, 0xd6, 0x13, 0x79, 0x69, 0x63, 0xac, 0xec, 0xab, 0x16, 0x90, 0xf5, 0x54, 0xae },
+  { 0xf7, 0x58, 0x72, 0x94, 0x6e, 0x82, 0xad, 0x74, 0xd4, 0x8e, 0xae, 0x5b, 0xc2, 0x8f, 0x5f, 0x0e },
+  { 0xf7, 0x77, 0x44, 0x4f, 0xc2, 0x1a, 0x59, 0x25, 0xe0, 0x66, 0xb6, 0x8b, 0x1d, 0x35, 0x05, 0x75 },
+  { 0xf7, 0x7f, 0x5f, 0xc3, 0x89, 0x3d, 0xa5, 0xd0, 0x01, 0x98, 0xe4, 0xcd, 0x96, 0x54, 0x4a, 0xad },
+  { 0xf7, 0x85, 0x6e, 0x32, 0x4b, 0xc5, 0x6f, 0x45, 0xb9, 0xc8, 0xe6, 0xff, 0x06, 0x2e, 0xc0, 0x33 },
+  { 0xf7, 0x8c, 0x12, 0x5b, 0x5d, 0xa4, 0x83, 0xc4, 0x1e, 0x51, 0x52, 0x29, 0x47, 0xd6, 0xc4, 0xce },
+  { 0xf7, 0xa1, 0x38, 0xee, 0xd6, 0x96, 0x65, 0xb5, 0xcd, 0x1b, 0xfa, 0x79, 0x6a, 0x55, 0x0b, 0x01 },
+  { 0xf7, 0xa6, 0x51, 0x97, 0x2d, 0x78, 0xf9, 0xba, 0x48, 0x5b, 0x14, 0x69, 0x04, 0x52, 0xd4, 0xbe },
+  { 0xf7, 0xaf, 0x41, 0xa8, 0x75, 0x33, 0x52, 0x4d, 0x9a, 0x47, 0x85, 0x75, 0xb0, 0xd8, 0x73, 0xd0 },
+  { 0xf7, 0xd6, 0x59, 0x2d, 0xcb, 0x77, 0x3c, 0x81, 0xc2, 0x78, 0x14, 0x0e, 0xd4, 0xd0, 0x16, 0x69 },
+  { 0xf7, 0xe0, 0x70, 0x80, 0xed, 0x83, 0x96, 0xb6, 0x8f, 0x2e, 0x57, 0x88, 0xa5, 0xc2, 0x45, 0xe2 },
+  { 0xf7, 0xf5, 0x0d, 0x9c, 0x9d, 0x28, 0xbc, 0xc9, 0xf7, 0xd3, 0x07, 0x56, 0x68, 0xb7, 0xac, 0x89 },
+  { 0xf7, 0xfa, 0xc1, 0x5c, 0xf5, 0x4b, 0x55, 0xc5, 0x59, 0x77, 0x18, 0xb6, 0x74, 0x2d, 0xbe, 0xc2 },
+  { 0xf8, 0x02, 0xfa, 0x61, 0x01, 0x1d, 0xd9, 0xeb, 0x6f, 0x80, 0xb2, 0x71, 0xba, 0xc4, 0x79, 0xd0 },
+  { 0xf8, 0x0c, 0xf7, 0x71, 0x64, 0x07, 0x9d, 0x77, 0x4b, 0x9b, 0x0f, 0xae, 0x33, 0xdf, 0xfc, 0xa9 },
+  { 0xf8, 0x24, 0x0e, 0x62, 0xd8, 0xc0, 0xa6, 0x4a, 0x61, 0xe1, 0x93, 0x88, 0x41, 0x4e, 0x31, 0x04 },
+  { 0xf8, 0x25, 0xc5, 0x38, 0x48, 0x1f, 0x9a, 0x7a, 0x46, 0xd1, 0xe9, 0xbc, 0x06, 0x20, 0x0a, 0xaf },
+  { 0xf8, 0x44, 0xf4, 0xc6, 0xf3, 0xba, 0xaa, 0xf5, 0x32, 0x26, 0x57, 0x44, 0x2d, 0x6f, 0x29, 0xeb },
+  { 0xf8, 0x47, 0xfb, 0x8d, 0xba, 0x6c, 0x6d, 0x66, 0xd1, 0x37, 0x24, 0xdb, 0xe5, 0xd9, 0x5c, 0x4d },
+  { 0xf8, 0x58, 0x2b, 0xc6, 0xca, 0x70, 0x46, 0xad, 0xb8, 0xe1, 0x81, 0x64, 0xe8, 0xce, 0xcd, 0xbc },
+  { 0xf8, 0x64, 0x8d, 0x0c, 0x6a, 0xd1, 0x26, 0x64, 0x34, 0xf6, 0xc4, 0x85, 0xff, 0x69, 0xec, 0x40 },
+  { 0xf8, 0x81, 0x1d, 0x45, 0xa9, 0x93, 0x5c, 0xca, 0x90, 0xc6, 0x2f, 0x92, 0x47, 0x12, 0xf8, 0xe6 },
+  { 0xf8, 0xb2, 0xa6, 0xa4, 0xd7, 0x3e, 0xbf, 0xf1, 0x0d, 0x80, 0x5a, 0x9b, 0x59, 0x04, 0x19, 0x86 },
+  { 0xf8, 0xbf, 0xd9, 0x91, 0x63, 0xd2, 0xc4, 0xec, 0x68, 0x83, 0x57, 0x78, 0x6e, 0x6f, 0xba, 0x28 },
+  { 0xf8, 0xc1, 0xc4, 0xa4, 0x13, 0x03, 0xbd, 0x40, 0xb0, 0xd6, 0xc8, 0x1b, 0xfa, 0xf8, 0x57, 0x3b },
+  { 0xf8, 0xff, 0x34, 0xb5, 0x3d, 0x86, 0xf5, 0x5b, 0xd5, 0x2d, 0x7a, 0x52, 0x0a, 0xf6, 0xd1, 0xdc },
+  { 0xf9, 0x0b, 0x5d, 0xa1, 0x89, 0xf2, 0x4d, 0x7e, 0x1a, 0x21, 0x17, 0xd8, 0xc8, 0xab, 0xc9, 0x52 },
+  { 0xf9, 0x1f, 0xb8, 0xda, 0x32, 0x23, 0xb7, 0x9f, 0x1c, 0x9a, 0x07, 0xb7, 0x7e, 0xbf, 0xa0, 0xb2 },
+  { 0xf9, 0x3d, 0x7f, 0xee, 0x92, 0x71, 0x7e, 0x16, 0x1e, 0x67, 0x63, 0xa8, 0x8a, 0x29, 0x3f, 0xfa },
+  { 0xf9, 0x42, 0x01, 0x73, 0xef, 0xcb, 0x4b, 0x9f, 0x2b, 0x01, 0xc2, 0xa7, 0xb5, 0x95, 0xcc, 0xa7 },
+  { 0xf9, 0x54, 0x38, 0x1f, 0x9e, 0x0f, 0x20, 0x09, 0xd1, 0xac, 0x40, 0xde, 0xdd, 0x77, 0x7b, 0x1a },
+  { 0xf9, 0x65, 0x5e, 0xd5, 0x14, 0x62, 0xec, 0xfc, 0x69, 0x0c, 0x7b, 0x97, 0xce, 0xc6, 0x49, 0xf9 },
+  { 0xf9, 0x65, 0xcc, 0x98, 0x1c, 0xbb, 0x08, 0x22, 0xf9, 0x55, 0x64, 0x1f, 0x8d, 0x84, 0xe7, 0x74 },
+  { 0xf9, 0x66, 0x0e, 0xbe, 0xd6, 0x6f, 0xee, 0x8b, 0xdf, 0xdf, 0x07, 0xb4, 0xfa, 0xa2, 0x29, 0x41 },
+  { 0xf9, 0x67, 0x7b, 0x2e, 0xc8, 0x72, 0x8a, 0x70, 0x3e, 0xb7, 0x10, 0x27, 0x44, 0x74, 0x61, 0x3d },
+  { 0xf9, 0x7d, 0xee, 0x1a, 0xa2, 0x62, 0x99, 0x11, 0xf3, 0x0f, 0x22, 0x5c, 0xa3, 0x17, 0x89, 0xd4 },
+  { 0xf9, 0x8d, 0x22, 0x76, 0xd4, 0xa2, 0x5b, 0x28, 0x61, 0x35, 0x56, 0x62, 0x55, 0xae, 0xa9, 0xd0 },
+  { 0xf9, 0x8d, 0x86, 0x9f, 0x28, 0x7d, 0x2c, 0xe4, 0xf8, 0xfb, 0x36, 0xe0, 0x68, 0x69, 0x29, 0xd9 },
+  { 0xf9, 0x92, 0xa3, 0x9b, 0x46, 0xaa, 0x48, 0x18, 0x8f, 0xab, 0x12, 0xad, 0x38, 0x09, 0xae, 0x4a },
+  { 0xf9, 0x96, 0x73, 0x69, 0x94, 0x32, 0x09, 0xb4, 0x78, 0x8d, 0x4e, 0x92, 0xce, 0xfc, 0x07, 0x95 },
+  { 0xf9, 0xce, 0xf6, 0x37, 0xea, 0x8e, 0x90, 0x5a, 0x10, 0xe3, 0x24, 0xe5, 0x82, 0xdd, 0x39, 0xc2 },
+  { 0xf9, 0xd5, 0x1a, 0x4e, 0x5f, 0x8b, 0x48, 0xf6, 0x87, 0x70, 0xc8, 0x9f, 0xfd, 0x49, 0x5e, 0xd1 },
+  { 0xf9, 0xda, 0x42, 0xf9, 0x1a, 0x1c, 0x5c, 0xfa, 0x34, 0x4d, 0x2f, 0xf4, 0x40, 0xc6, 0xf8, 0xd4 },
+  { 0xf9, 0xde, 0x91, 0xd8, 0x68, 0xd6, 0xeb, 0xfb, 0x00, 0x76, 0xaf, 0x90, 0x63, 0xd7, 0x19, 0x5e },
+  { 0xf9, 0xe9, 0x95, 0x96, 0x34, 0x5a, 0x84, 0x35, 0x8b, 0xc5, 0xd1, 0xfb, 0xe8, 0x77, 0x13, 0x4b },
+  { 0xfa, 0x05, 0x70, 0x56, 0x1a, 0xa8, 0x08, 0x96, 0xf0, 0xea, 0xd0, 0x5c, 0x46, 0x35, 0x13, 0x89 },
+  { 0xfa, 0x1b, 0x06, 0x0f, 0xd8, 0xe0, 0xbc, 0xa0, 0xc2, 0xa0, 0x97, 0xdc, 0xff, 0xce, 0x93, 0xd3 },
+  { 0xfa, 0x2b, 0xe8, 0x12, 0x5c, 0x3c, 0x60, 0xab, 0x83, 0xe1, 0xc0, 0xfe, 0x56, 0x92, 0x2f, 0xcb },
+  { 0xfa, 0x3d, 0xe7, 0x18, 0x41, 0xc0, 0x84, 0x1d, 0xb6, 0xa7, 0x41, 0x88, 0x4a, 0x6b, 0x6b, 0x2f },
+  { 0xfa, 0x44, 0x04, 0xfa, 0xbc, 0x09, 0x4e, 0x3a, 0x31, 0xfc, 0xd7, 0xb5, 0x59, 0xcd, 0xd0, 0x29 },
+  { 0xfa, 0x52, 0x9e, 0xc8, 0x8e, 0xca, 0x67, 0x9f, 0x6d, 0x5f, 0xd0, 0xcc, 0xb2, 0x12, 0x0e, 0x46 },
+  { 0xfa, 0x6f, 0xe9, 0x7a, 0x10, 0xef, 0xb9, 0xe7, 0x4c, 0x0b, 0x5a, 0x81, 0x6e, 0x6e, 0x19, 0x58 },
+  { 0xfa, 0x73, 0xf3, 0xc7, 0x7b, 0xa7, 0x67, 0x63, 0xe0, 0x0e, 0x12, 0xd5, 0x45, 0x8b, 0x6c, 0x5d },
+  { 0xfa, 0x7c, 0xe6, 0x2e, 0x7f, 0xd7, 0x7e, 0x02, 0xb3, 0xe2, 0x19, 0x8d, 0x70, 0x74, 0x2f, 0x80 },
+  { 0xfa, 0x7e, 0x11, 0xa3, 0xdb, 0xea, 0x43, 0x65, 0x97, 0x5c, 0xd2, 0xf0, 0x94, 0xe6, 0x1d, 0x25 },
+  { 0xfa, 0x98, 0xd4, 0x8c, 0xd6, 0x09, 0xc9, 0xba, 0xbc, 0x81, 0x9e, 0x0a, 0x1b, 0xd8, 0xd5, 0x98 },
+  { 0xfa, 0xbc, 0xa5, 0x26, 0xd5, 0x7d, 0xe4, 0x67, 0x68, 0xb3, 0x92, 0xf7, 0x58, 0xf1, 0xa0, 0x08 },
+  { 0xfa, 0xc2, 0x89, 0x63, 0x30, 0x7b, 0x6e, 0x85, 0x08, 0x2c, 0xcd, 0x77, 0xc8, 0x83, 0x25, 0xe7 },
+  { 0xfa, 0xdb, 0x89, 0xf9, 0xb2, 0x3b, 0xeb, 0x4d, 0x43, 0xa7, 0x89, 0x5c, 0x53, 0x27, 0x57, 0xe2 },
+  { 0xfa, 0xe0, 0xb8, 0x69, 0x34, 0xa7, 0xc5, 0xa3, 0x62, 0x28, 0x1d, 0xff, 0xeb, 0xdb, 0x43, 0xa0 },
+  { 0xfa, 0xeb, 0xcb, 0x2e, 0xf1, 0xf3, 0x83, 0x1b, 0x2f, 0xc1, 0xdb, 0xd3, 0x9d, 0x36, 0x51, 0x7c },
+  { 0xfa, 0xed, 0x2e, 0xf6, 0xb4, 0x48, 0x94, 0xf8, 0xc8, 0x3f, 0x2b, 0x50, 0x89, 0x1c, 0x35, 0xc6 },
+  { 0xfa, 0xff, 0xd8, 0x4f, 0x3a, 0x8e, 0xce, 0xee, 0x2f, 0xa5, 0xea, 0x5b, 0x0a, 0x3e, 0x66, 0x78 },
+  { 0xfb, 0x09, 0xee, 0x4c, 0xcd, 0x47, 0xae, 0x74, 0xa3, 0xc3, 0x14, 0xf0, 0xd8, 0xa4, 0x03, 0x44 },
+  { 0xfb, 0x0c, 0x32, 0xef, 0x7a, 0xf5, 0xb4, 0x54, 0x86, 0xdb, 0x66, 0x35, 0x10, 0x09, 0x4b, 0xe8 },
+  { 0xfb, 0x0e, 0x84, 0xce, 0xe4, 0xc1, 0x08, 0xd2, 0x42, 0x53, 0xbc, 0xb7, 0xe3, 0x82, 0xcf, 0xfd },
+  { 0xfb, 0x27, 0xaf, 0xe8, 0x96, 0xe7, 0xc9, 0x28, 0x08, 0x93, 0x07, 0xb3, 0x2e, 0x56, 0x42, 0xee },
+  { 0xfb, 0x4c, 0xa8, 0x65, 0xab, 0xc0, 0x2d, 0x66, 0xe3, 0x96, 0x51, 0xbd, 0x9a, 0xde, 0x14, 0x0a },
+  { 0xfb, 0x53, 0x1f, 0xeb, 0xf8, 0xe1, 0x55, 0x32, 0x8e, 0xc0, 0xcd, 0x39, 0xef, 0x77, 0xa1, 0x22 },
+  { 0xfb, 0x5c, 0x8a, 0xf9, 0x7b, 0xd8, 0xff, 0xe8, 0x83, 0x23, 0x65, 0x6f, 0x46, 0x26, 0x45, 0xa7 },
+  { 0xfb, 0x83, 0x3e, 0xd5, 0x0c, 0x86, 0x5a, 0x9a, 0x50, 0x5a, 0x12, 0x5f, 0xc9, 0xd7, 0x9a, 0x7e },
+  { 0xfb, 0x88, 0x4f, 0xfd, 0x89, 0x01, 0x33, 0x31, 0xa6, 0xf0, 0x1a, 0xe3, 0xf6, 0xab, 0xd2, 0x14 },
+  { 0xfb, 0x88, 0xc4, 0x00, 0xd6, 0x02, 0xfe, 0x75, 0x9a, 0xe7, 0x4e, 0xf1, 0x71, 0x6e, 0xe8, 0x4e },
+  { 0xfb, 0x91, 0xda, 0x78, 0x45, 0x5d, 0x9b, 0x16, 0x06, 0x91, 0x3f, 0xbf, 0x8c, 0x85, 0x97, 0x72 },
+  { 0xfb, 0x91, 0xdf, 0xc3, 0x6c, 0xdd, 0xaa, 0x54, 0xb0, 0x99, 0x24, 0xae, 0x8f, 0xd9, 0x61, 0x99 },
+  { 0xfb, 0xac, 0x64, 0x76, 0xe7, 0xb2, 0xb2, 0x0d, 0x24, 0x62, 0x02, 0xaf, 0x81, 0x66, 0x2c, 0x88 },
+  { 0xfb, 0xb0, 0x15, 0x1e, 0xa2, 0x10, 0x8e, 0x33, 0xb2, 0xdb, 0xaa, 0xe1, 0x4a, 0x18, 0x31, 0xdd },
+  { 0xfb, 0xb4, 0xf3, 0xde, 0xbf, 0x48, 0xdc, 0x96, 0x1b, 0x55, 0x93, 0x84, 0x46, 0x7f, 0x20, 0x57 },
+  { 0xfb, 0xd6, 0x10, 0x2e, 0x17, 0xa5, 0xc0, 0x2c, 0x6e, 0x19, 0x11, 0x38, 0x1b, 0x72, 0x03, 0xf9 },
+  { 0xfb, 0xe5, 0x54, 0xaa, 0x8f, 0x75, 0x92, 0x26, 0xd2, 0x51, 0xba, 0x6b, 0x64, 0xa9, 0xcc, 0xe4 },
+  { 0xfb, 0xfe, 0xbe, 0xe9, 0xc1, 0x46, 0x94, 0x71, 0x9e, 0x3e, 0xda, 0x48, 0x54, 0xdc, 0x42, 0xee },
+  { 0xfc, 0x21, 0x04, 0xdd, 0x2d, 0xad, 0xf9, 0xa6, 0x17, 0x6c, 0x1c, 0x1c, 0x8f, 0x87, 0xce, 0xd9 },
+  { 0xfc, 0x22, 0x33, 0xfc, 0x11, 0x6f, 0xae, 0xf0, 0xd3, 0xc3, 0x15, 0x41, 0x71, 0x7c, 0xa2, 0xdb },
+  { 0xfc, 0x24, 0xa9, 0x4d, 0x43, 0x71, 0xc6, 0x9b, 0xc5, 0x8f, 0x52, 0x45, 0xad, 0xa4, 0x3c, 0x44 },
+  { 0xfc, 0x60, 0x52, 0x43, 0x8f, 0x33, 0x9a, 0xea, 0x37, 0x3b, 0xbc, 0x99, 0x94, 0x33, 0x38, 0x8a },
+  { 0xfc, 0x66, 0x8a, 0x22, 0x51, 0xdd, 0x79, 0xcb, 0xd9, 0x03, 0xd4, 0xfa, 0x0e, 0x55, 0x8f, 0x96 },
+  { 0xfc, 0x92, 0xd7, 0x4f, 0x07, 0x3a, 0x44, 0xbc, 0x6e, 0x46, 0xa3, 0xb3, 0xfa, 0x82, 0x56, 0xa2 },
+  { 0xfc, 0x9c, 0x16, 0x52, 0xfe, 0x3a, 0x2c, 0xad, 0xe6, 0x18, 0x8f, 0x4d, 0x36, 0x92, 0x48, 0x1f },
+  { 0xfc, 0xa4, 0xa5, 0xbe, 0x12, 0x51, 0x92, 0x70, 0x27, 0xf2, 0xc2, 0x47, 0x74, 0xa0, 0x21, 0x60 },
+  { 0xfc, 0xbb, 0xd0, 0xa4, 0x07, 0xd3, 0xff, 0x7b, 0xf8, 0x57, 0xb8, 0xa3, 0x99, 0x28, 0x0e, 0xa1 },
+  { 0xfc, 0xbd, 0xf4, 0x05, 0xf0, 0xfc, 0x20, 0x27, 0xb0, 0xea, 0x45, 0xbb, 0x5a, 0xf9, 0x4c, 0x1a },
+  { 0xfc, 0xea, 0x12, 0x62, 0x5c, 0x07, 0x1d, 0xdc, 0x49, 0xf4, 0xe4, 0x09, 0xf4, 0x03, 0x8c, 0x60 },
+  { 0xfc, 0xf8, 0xe3, 0x06, 0xf6, 0x61, 0x5f, 0x74, 0xfe, 0xba, 0x5c, 0xb2, 0x55, 0x50, 0x03, 0x8c },
+  { 0xfd, 0x0e, 0x51, 0x48, 0x16, 0x2e, 0x8e, 0xc6, 0x71, 0x94, 0x45, 0xd5, 0x59, 0xf0, 0x18, 0xa9 },
+  { 0xfd, 0x10, 0x91, 0x56, 0x33, 0xae, 0xa4, 0xf9, 0xcd, 0x8b, 0x51, 0x8a, 0x25, 0xd6, 0x2b, 0x55 },
+  { 0xfd, 0x16, 0x94, 0x99, 0x13, 0xaa, 0xab, 0x5b, 0xea, 0xef, 0xed, 0x73, 0xbf, 0x2c, 0xa6, 0x7c },
+  { 0xfd, 0x4f, 0x55, 0x36, 0xfd, 0x80, 0xf3, 0x5c, 0x64, 0xd3, 0x65, 0xdf, 0x85, 0x87, 0x34, 0x18 },
+  { 0xfd, 0x6e, 0x50, 0x7b, 0x5d, 0xf6, 0x8b, 0xee, 0xed, 0xde, 0xaf, 0x69, 0x6b, 0x68, 0x28, 0xfa },
+  { 0xfd, 0x74, 0x64, 0xed, 0xaa, 0x8c, 0xc2, 0x64, 0xb9, 0x7b, 0xa0, 0xd1, 0x3e, 0x7f, 0x06, 0x78 },
+  { 0xfd, 0x78, 0xf1, 0x86, 0xbd, 0xff, 0x83, 0xfb, 0xad, 0x7f, 0x97, 0xcb, 0x58, 0x38, 0x12, 0xfe },
+  { 0xfd, 0x8b, 0x4e, 0xe0, 0xd5, 0x76, 0x05, 0xb3, 0x5e, 0x23, 0x6e, 0x81, 0x4f, 0x70, 0x6f, 0xf1 },
+  { 0xfd, 0x9b, 0x32, 0x1c, 0xee, 0x5f, 0xbb, 0x32, 0xc3, 0x9b, 0xa3, 0xca, 0x5d, 0x9e, 0xc7, 0xcf },
+  { 0xfd, 0xd4, 0x99, 0x5a, 0x50, 0x39, 0x5d, 0xb1, 0x4f, 0x51, 0x8f, 0x63, 0xc2, 0xd6, 0x34, 0x38 },
+  { 0xfd, 0xe4, 0x2e, 0x39, 0x71, 0x0e, 0x75, 0xe9, 0xe4, 0xd4, 0xd7, 0x54, 0x40, 0xf8, 0xe4, 0xe5 },
+  { 0xfd, 0xf0, 0xde, 0x38, 0x51, 0x7e, 0x0c, 0xf7, 0xf0, 0x88, 0x5f, 0x98, 0xcc, 0xc9, 0x58, 0x36 },
+  { 0xfd, 0xf6, 0x68, 0x0b, 0x2b, 0x1e, 0x80, 0x54, 0x29, 0x3a, 0x39, 0x70, 0x0a, 0x76, 0x56, 0x92 },
+  { 0xfe, 0x0b, 0x7f, 0x27, 0xe3, 0xad, 0x50, 0xbb, 0xf9, 0xff, 0x46, 0x8e, 0xe5, 0x6d, 0x55, 0x3d },
+  { 0xfe, 0x0b, 0xc4, 0xbb, 0x92, 0xc1, 0xc4, 0xde, 0x7d, 0x57, 0x06, 0xaa, 0xa8, 0xd8, 0xc1, 0x0d },
+  { 0xfe, 0x3b, 0x46, 0x1d, 0x4c, 0x8b, 0x17, 0x9f, 0xe6, 0x8b, 0xc7, 0x77, 0x60, 0x29, 0x4c, 0x25 },
+  { 0xfe, 0x67, 0x08, 0x7f, 0x9c, 0x22, 0x65, 0x5c, 0xe5, 0x19, 0x61, 0x6f, 0xc6, 0xc6, 0xef, 0x4d },
+  { 0xfe, 0x6a, 0xbc, 0x0f, 0x63, 0xe3, 0x1e, 0x26, 0x46, 0xc9, 0xc6, 0x00, 0x92, 0x6b, 0x5b, 0x7f },
+  { 0xfe, 0x87, 0x00, 0x18, 0x33, 0x2a, 0x02, 0x21, 0xeb, 0x59, 0xfb, 0x18, 0xb0, 0xc6, 0xbc, 0xcc },
+  { 0xfe, 0x9a, 0xe6, 0x25, 0xd9, 0x24, 0xb5, 0x4c, 0x9f, 0x8a, 0x14, 0xac, 0x9a, 0x0f, 0x6c, 0x6d },
+  { 0xfe, 0xba, 0x86, 0x86, 0xfd, 0x03, 0x76, 0x01, 0x52, 0x58, 0xd1, 0x15, 0x29, 0x23, 0x95, 0x8a },
+  { 0xfe, 0xc0, 0xc2, 0xe2, 0xab, 0x05, 0x88, 0xed, 0x20, 0xc7, 0x50, 0xb5, 0x8c, 0xf3, 0xba, 0xa3 },
+  { 0xfe, 0xce, 0x45, 0x8a, 0x80, 0x23, 0xa8, 0x09, 0xa5, 0x00, 0x68, 0x67, 0xfe, 0xca, 0x40, 0xe8 },
+  { 0xfe, 0xec, 0x54, 0xaa, 0xc9, 0x11, 0x88, 0x79, 0x40, 0xb4, 0x7f, 0xe8, 0xc9, 0xf8, 0x0b, 0x11 },
+  { 0xfe, 0xed, 0xcc, 0x20, 0xbc, 0x3c, 0xa3, 0x48, 0x51, 0xcd, 0x5d, 0x9e, 0x38, 0xaa, 0x2c, 0xa6 },
+  { 0xff, 0x3b, 0xd0, 0xc6, 0x84, 0xf7, 0x14, 0x4a, 0xea, 0xa1, 0x87, 0x58, 0xd8, 0x28, 0x1a, 0x78 },
+  { 0xff, 0x5a, 0x9e, 0x34, 0x0d, 0x96, 0xdf, 0x6f, 0x5a, 0x5b, 0x6e, 0xb0, 0x38, 0xe9, 0x23, 0xbd },
+  { 0xff, 0x76, 0x27, 0x20, 0x7e, 0x8a, 0xa0, 0x37, 0x30, 0xc3, 0x5c, 0x73, 0x5a, 0x82, 0xc2, 0x6c },
+  { 0xff, 0x86, 0xfc, 0x8f, 0xfa, 0x71, 0x7b, 0xb0, 0x95, 0xe8, 0x47, 0x16, 0x38, 0xc1, 0xc3, 0x1c },
+  { 0xff, 0x87, 0xd5, 0x81, 0x25, 0xae, 0x51, 0x7e, 0xb7, 0xb0, 0x9a, 0x04, 0x75, 0xa1, 0xcc, 0xdc },
+  { 0xff, 0xb1, 0xcd, 0x54, 0x85, 0x63, 0x15, 0x8c, 0xe3, 0x3f, 0x9d, 0x10, 0x26, 0x81, 0x87, 0xe7 },
+  { 0xff, 0xc0, 0xff, 0x43, 0x05, 0xdd, 0x46, 0xb4, 0xb4, 0x59, 0x88, 0x5b, 0xd1, 0x81, 0x8e, 0x2e },
+  { 0xff, 0xdc, 0x0e, 0xb3, 0x54, 0x34, 0x04, 0xeb, 0x4c, 0x35, 0x3f, 0xbd, 0xdd, 0xfa, 0x33, 0xb6 },
+  { 0xff, 0xe5, 0x19, 0x89, 0xba, 0x6d, 0xa2, 0xc6, 0xae, 0x5a, 0x12, 0xd2, 0x77, 0x86, 0x2e, 0x16 },
+  { 0xff, 0xeb, 0xb0, 0x07, 0x06, 0x89, 0xb9, 0xd3, 0x22, 0x68, 0x7e, 0xdd, 0x9c, 0x0a, 0x2b, 0xae }
+};
+
+static const uInt16 DefPropsIndex[(1 << DEF_PROPS_INDEX_BITS) + 1] = {
+  0, 1, 1, 1, 1, 1, 1, 2, 3, 4, 4, 4, 5, 7, 8, 11,
+  12, 12, 12, 16, 16, 16, 16, 17, 18, 18, 18, 19, 20, 21, 21, 23,
+  24, 25, 25, 25, 25, 26, 27, 28, 30, 32, 32, 34, 34, 36, 37, 38,
+  38, 38, 38, 38, 39, 40, 40, 40, 41, 43, 44, 44, 45, 46, 46, 46,
+  47, 48, 49, 49, 50, 51, 52, 52, 53, 54, 55, 55, 56, 56, 57, 58,
+  59, 59, 60, 60, 60, 61, 61, 63, 63, 64, 64, 66, 67, 69, 70, 72,
+  73, 74, 75, 75, 75, 75, 76, 76, 77, 78, 80, 80, 82, 83, 84, 85,
+  85, 85, 86, 87, 89, 90, 92, 92, 92, 92, 94, 95, 95, 96, 96, 96,
+  99, 100, 102, 103, 105, 105, 107, 108, 108, 108, 111, 111, 113, 113, 115, 116,
+  118, 120, 120, 121, 122, 123, 124, 126, 128, 128, 128, 129, 129, 129, 130, 131,
+  132, 132, 133, 133, 133, 133, 133, 133, 133, 133, 134, 135, 136, 139, 141, 142,
+  144, 145, 147, 148, 149, 150, 152, 152, 152, 153, 153, 153, 153, 153, 153, 153,
+  156, 157, 157, 157, 158, 159, 160, 160, 162, 163, 163, 163, 164, 165, 166, 167,
+  168, 170, 171, 172, 173, 173, 174, 175, 177, 177, 178, 178, 179, 179, 180, 181,
+  182, 184, 184, 185, 185, 186, 186, 186, 188, 189, 189, 189, 189, 190, 190, 192,
+  193, 193, 194, 196, 198, 198, 198, 200, 201, 202, 203, 203, 205, 207, 208, 208,
+  208, 208, 209, 210, 213, 214, 214, 216, 217, 218, 219, 221, 221, 222, 222, 223,
+  225, 226, 227, 227, 229, 230, 230, 230, 230, 230, 230, 230, 231, 232, 232, 233,
+  234, 235, 236, 237, 237, 237, 237, 239, 240, 241, 242, 242, 243, 243, 244, 244,
+  244, 245, 245, 246, 249, 252, 255, 257, 257, 258, 258, 262, 262, 263, 265, 265,
+  265, 266, 267, 269, 270, 271, 271, 271, 271, 272, 273, 274, 275, 276, 278, 278,
+  278, 278, 280, 281, 282, 283, 284, 284, 286, 286, 287, 287, 290, 291, 292, 292,
+  293, 293, 295, 295, 296, 296, 296, 296, 296, 296, 297, 297, 297, 299, 299, 301,
+  303, 304, 305, 305, 307, 307, 309, 310, 311, 312, 312, 312, 315, 316, 317, 319,
+  319, 320, 320, 320, 321, 321, 321, 322, 323, 323, 323, 324, 326, 326, 328, 329,
+  330, 331, 334, 335, 336, 336, 336, 336, 336, 336, 338, 340, 340, 340, 342, 344,
+  344, 344, 344, 345, 345, 345, 345, 347, 347, 348, 348, 349, 349, 349, 349, 349,
+  349, 350, 351, 352, 352, 353, 353, 353, 353, 355, 355, 355, 356, 357, 357, 358,
+  359, 359, 359, 359, 360, 360, 361, 362, 362, 364, 364, 366, 366, 367, 367, 367,
+  368, 368, 369, 371, 371, 372, 373, 374, 374, 374, 374, 375, 376, 376, 376, 376,
+  376, 378, 380, 381, 381, 381, 382, 382, 383, 385, 385, 387, 387, 389, 390, 392,
+  393, 393, 393, 395, 396, 397, 399, 400, 401, 401, 401, 405, 405, 405, 405, 405,
+  405, 408, 409, 409, 412, 412, 413, 413, 413, 413, 414, 415, 415, 415, 417, 418,
+  418, 418, 421, 424, 425, 425, 425, 426, 427, 429, 429, 430, 431, 431, 433, 433,
+  433, 433, 433, 434, 435, 436, 437, 438, 439, 439, 439, 440, 441, 441, 441, 441,
+  442, 442, 443, 444, 444, 444, 447, 448, 448, 448, 448, 448, 448, 448, 449, 450,
+  451, 452, 452, 452, 454, 456, 459, 459, 461, 461, 462, 464, 466, 466, 469, 469,
+  470, 470, 472, 473, 473, 474, 474, 474, 476, 476, 476, 477, 480, 480, 481, 482,
+  485, 486, 486, 487, 487, 487, 489, 489, 489, 491, 491, 491, 492, 492, 492, 492,
+  493, 494, 495, 495, 496, 497, 497, 497, 500, 504, 504, 504, 504, 506, 506, 506,
+  507, 508, 510, 513, 514, 515, 516, 516, 516, 517, 517, 519, 519, 519, 520, 520,
+  520, 521, 524, 526, 527, 529, 530, 531, 533, 536, 537, 537, 537, 537, 538, 538,
+  538, 539, 541, 542, 544, 544, 544, 544, 544, 544, 545, 546, 548, 549, 549, 551,
+  551, 551, 552, 553, 553, 555, 555, 555, 556, 556, 556, 557, 559, 561, 561, 562,
+  563, 564, 564, 566, 568, 569, 569, 569, 569, 571, 572, 573, 574, 575, 575, 576,
+  578, 578, 581, 582, 582, 583, 583, 586, 587, 587, 589, 589, 591, 592, 592, 593,
+  594, 595, 595, 597, 598, 598, 599, 600, 601, 603, 603, 604, 604, 605, 606, 606,
+  607, 609, 611, 612, 612, 612, 612, 613, 616, 616, 616, 617, 617, 617, 617, 617,
+  617, 617, 617, 618, 619, 620, 623, 624, 624, 624, 626, 626, 626, 627, 627, 629,
+  630, 632, 632, 632, 633, 633, 634, 634, 636, 638, 639, 639, 640, 641, 643, 644,
+  646, 646, 648, 651, 651, 652, 652, 652, 656, 657, 657, 658, 658, 658, 660, 662,
+  663, 663, 665, 666, 666, 667, 669, 670, 670, 670, 671, 671, 671, 672, 673, 674,
+  674, 675, 675, 675, 676, 676, 679, 680, 680, 681, 681, 681, 682, 684, 684, 685,
+  687, 688, 690, 690, 690, 690, 691, 691, 693, 693, 693, 694, 697, 697, 697, 697,
+  698, 700, 701, 702, 703, 703, 704, 704, 705, 707, 707, 708, 709, 712, 712, 714,
+  715, 715, 715, 717, 718, 718, 720, 721, 721, 724, 724, 725, 726, 726, 726, 727,
+  729, 729, 729, 729, 729, 731, 732, 733, 733, 735, 736, 736, 737, 739, 740, 740,
+  740, 740, 741, 743, 745, 746, 746, 747, 748, 748, 748, 749, 750, 751, 753, 753,
+  754, 754, 754, 755, 756, 756, 759, 759, 760, 760, 760, 761, 762, 763, 765, 765,
+  765, 767, 768, 769, 769, 769, 770, 773, 774, 777, 780, 780, 781, 781, 781, 781,
+  781, 781, 781, 782, 783, 785, 786, 786, 789, 792, 792, 794, 795, 795, 796, 796,
+  796, 796, 797, 799, 799, 800, 800, 801, 803, 804, 806, 807, 807, 807, 807, 807,
+  808, 809, 810, 811, 812, 814, 815, 816, 817, 819, 820, 821, 823, 825, 825, 825,
+  826, 828, 828, 829, 830, 830, 833, 835, 836, 836, 839, 839, 839, 839, 841, 842,
+  843, 843, 843, 845, 845, 845, 846, 848, 849, 849, 850, 851, 853, 853, 856, 858,
+  858, 858, 858, 858, 859, 859, 861, 861, 861, 865, 866, 866, 866, 867, 867, 867,
+  868, 869, 869, 870, 871, 871, 873, 873, 874, 875, 875, 876, 879, 880, 881, 882,
+  882, 882, 883, 884, 884, 884, 885, 885, 885, 886, 886, 887, 887, 888, 888, 889,
+  891, 891, 891, 893, 894, 894, 895, 895, 897, 898, 898, 898, 898, 898, 898, 899,
+  900, 902, 902, 902, 902, 903, 903, 905, 908, 909, 909, 911, 912, 914, 914, 914,
+  914, 915, 916, 917, 919, 919, 919, 919, 920, 922, 924, 924, 924, 926, 926, 927,
+  927, 929, 929, 929, 929, 930, 930, 931, 932, 932, 934, 937, 939, 940, 940, 940,
+  940, 940, 942, 943, 943, 945, 945, 946, 946, 947, 948, 948, 949, 949, 949, 950,
+  951, 955, 955, 955, 958, 960, 961, 961, 962, 963, 965, 965, 965, 965, 965, 965,
+  965, 965, 966, 967, 967, 968, 969, 970, 971, 972, 973, 973, 976, 977, 977, 978,
+  981, 981, 982, 984, 984, 984, 984, 984, 986, 986, 988, 989, 989, 990, 991, 991,
+  991, 993, 993, 994, 995, 997, 997, 999, 999, 1001, 1002, 1006, 1006, 1006, 1007, 1007,
+  1007, 1008, 1008, 1009, 1010, 1010, 1012, 1012, 1014, 1015, 1015, 1015, 1016, 1017, 1018, 1018,
+  1020, 1022, 1023, 1024, 1025, 1026, 1026, 1027, 1027, 1028, 1029, 1029, 1030, 1030, 1031, 1031,
+  1031, 1032, 1032, 1033, 1034, 1034, 1034, 1038, 1040, 1042, 1042, 1044, 1045, 1046, 1046, 1046,
+  1046, 1046, 1046, 1049, 1049, 1050, 1051, 1052, 1053, 1053, 1053, 1054, 1054, 1055, 1055, 1056,
+  1056, 1056, 1056, 1057, 1058, 1059, 1060, 1061, 1063, 1064, 1065, 1065, 1065, 1065, 1066, 1067,
+  1069, 1069, 1070, 1071, 1073, 1074, 1077, 1078, 1078, 1079, 1079, 1080, 1082, 1082, 1082, 1084,
+  1084, 1085, 1085, 1086, 1087, 1088, 1089, 1090, 1091, 1092, 1094, 1094, 1095, 1095, 1096, 1096,
+  1097, 1099, 1099, 1101, 1103, 1103, 1104, 1104, 1105, 1105, 1106, 1107, 1108, 1108, 1109, 1109,
+  1110, 1110, 1112, 1113, 1113, 1113, 1113, 1113, 1114, 1114, 1116, 1117, 1117, 1117, 1117, 1119,
+  1119, 1119, 1119, 1121, 1122, 1124, 1124, 1124, 1125, 1126, 1126, 1126, 1126, 1126, 1126, 1126,
+  1126, 1126, 1127, 1128, 1128, 1128, 1129, 1129, 1129, 1129, 1131, 1132, 1132, 1133, 1133, 1133,
+  1133, 1133, 1133, 1133, 1134, 1135, 1138, 1139, 1140, 1140, 1142, 1143, 1143, 1144, 1145, 1146,
+  1146, 1147, 1148, 1148, 1148, 1149, 1149, 1150, 1151, 1152, 1153, 1153, 1154, 1154, 1155, 1157,
+  1158, 1159, 1160, 1162, 1162, 1162, 1163, 1164, 1165, 1168, 1171, 1171, 1171, 1172, 1172, 1174,
+  1175, 1175, 1176, 1176, 1176, 1176, 1178, 1179, 1180, 1181, 1184, 1185, 1187, 1189, 1190, 1191,
+  1191, 1193, 1195, 1195, 1196, 1196, 1196, 1197, 1198, 1199, 1199, 1199, 1200, 1200, 1200, 1201,
+  1201, 1202, 1203, 1205, 1205, 1205, 1205, 1205, 1206, 1208, 1209, 1211, 1212, 1213, 1213, 1214,
+  1216, 1217, 1220, 1223, 1223, 1223, 1223, 1223, 1223, 1223, 1224, 1224, 1224, 1225, 1225, 1226,
+  1227, 1227, 1228, 1229, 1231, 1232, 1233, 1235, 1240, 1240, 1242, 1243, 1244, 1244, 1244, 1244,
+  1244, 1245, 1246, 1246, 1248, 1250, 1253, 1254, 1255, 1255, 1255, 1256, 1257, 1258, 1259, 1260,
+  1260, 1260, 1260, 1260, 1261, 1263, 1264, 1266, 1268, 1268, 1269, 1269, 1269, 1269, 1270, 1272,
+  1272, 1273, 1273, 1273, 1273, 1274, 1274, 1275, 1276, 1277, 1279, 1279, 1279, 1279, 1280, 1280,
+  1282, 1282, 1283, 1283, 1286, 1287, 1289, 1290, 1291, 1293, 1293, 1295, 1295, 1297, 1298, 1301,
+  1301, 1302, 1303, 1303, 1304, 1304, 1305, 1306, 1307, 1307, 1307, 1307, 1308, 1309, 1310, 1310,
+  1311, 1312, 1313, 1314, 1315, 1316, 1318, 1319, 1319, 1319, 1322, 1322, 1325, 1326, 1326, 1326,
+  1326, 1327, 1327, 1328, 1330, 1330, 1332, 1332, 1334, 1335, 1337, 1337, 1340, 1342, 1342, 1342,
+  1343, 1344, 1344, 1345, 1345, 1345, 1346, 1348, 1348, 1349, 1352, 1352, 1353, 1357, 1357, 1357,
+  1357, 1359, 1360, 1360, 1362, 1365, 1367, 1367, 1369, 1370, 1370, 1370, 1370, 1372, 1372, 1372,
+  1373, 1374, 1376, 1377, 1378, 1378, 1378, 1378, 1379, 1381, 1382, 1382, 1382, 1382, 1383, 1385,
+  1386, 1389, 1389, 1390, 1391, 1391, 1391, 1391, 1392, 1395, 1397, 1398, 1398, 1399, 1399, 1400,
+  1400, 1401, 1402, 1402, 1402, 1403, 1403, 1405, 1410, 1411, 1411, 1411, 1413, 1413, 1414, 1414,
+  1414, 1414, 1417, 1418, 1418, 1419, 1419, 1420, 1421, 1422, 1424, 1424, 1425, 1426, 1428, 1431,
+  1432, 1432, 1432, 1433, 1433, 1434, 1434, 1434, 1435, 1437, 1438, 1438, 1438, 1438, 1439, 1440,
+  1441, 1441, 1443, 1443, 1444, 1445, 1447, 1447, 1448, 1448, 1448, 1448, 1448, 1448, 1450, 1450,
+  1451, 1452, 1452, 1453, 1454, 1454, 1454, 1454, 1456, 1456, 1456, 1458, 1459, 1462, 1463, 1464,
+  1466, 1467, 1467, 1467, 1469, 1469, 1470, 1471, 1472, 1472, 1474, 1475, 1475, 1476, 1477, 1477,
+  1477, 1478, 1478, 1478, 1479, 1481, 1483, 1483, 1483, 1486, 1487, 1487, 1488, 1488, 1489, 1489,
+  1491, 1492, 1493, 1493, 1494, 1495, 1495, 1495, 1495, 1497, 1497, 1499, 1500, 1500, 1502, 1502,
+  1504, 1504, 1505, 1505, 1505, 1505, 1506, 1507, 1507, 1507, 1507, 1509, 1510, 1513, 1513, 1515,
+  1515, 1519, 1519, 1520, 1520, 1520, 1522, 1523, 1523, 1524, 1525, 1525, 1525, 1526, 1527, 1528,
+  1529, 1530, 1532, 1532, 1533, 1533, 1536, 1537, 1540, 1540, 1540, 1541, 1543, 1543, 1543, 1548,
+  1548, 1549, 1549, 1551, 1551, 1552, 1552, 1552, 1552, 1553, 1554, 1555, 1555, 1557, 1557, 1558,
+  1560, 1561, 1561, 1561, 1562, 1562, 1562, 1562, 1564, 1565, 1565, 1565, 1566, 1567, 1568, 1568,
+  1568, 1568, 1568, 1569, 1570, 1571, 1571, 1573, 1574, 1575, 1576, 1576, 1577, 1578, 1578, 1578,
+  1578, 1579, 1580, 1582, 1582, 1582, 1582, 1582, 1583, 1585, 1587, 1588, 1589, 1590, 1592, 1593,
+  1594, 1595, 1595, 1596, 1596, 1596, 1597, 1600, 1601, 1601, 1602, 1602, 1605, 1606, 1609, 1609,
+  1610, 1610, 1610, 1611, 1613, 1614, 1615, 1616, 1618, 1619, 1620, 1621, 1622, 1623, 1623, 1623,
+  1623, 1624, 1624, 1624, 1624, 1625, 1625, 1625, 1627, 1627, 1628, 1629, 1629, 1631, 1633, 1635,
+  1635, 1636, 1637, 1637, 1638, 1639, 1640, 1640, 1641, 1641, 1645, 1646, 1647, 1649, 1650, 1650,
+  1651, 1651, 1651, 1652, 1652, 1654, 1656, 1656, 1657, 1658, 1659, 1663, 1664, 1664, 1667, 1667,
+  1669, 1671, 1671, 1671, 1671, 1672, 1674, 1675, 1677, 1678, 1679, 1679, 1679, 1681, 1681, 1681,
+  1683, 1683, 1684, 1684, 1685, 1686, 1688, 1689, 1691, 1692, 1692, 1692, 1692, 1694, 1694, 1697,
+  1697, 1702, 1702, 1703, 1705, 1707, 1708, 1708, 1708, 1708, 1710, 1711, 1712, 1712, 1712, 1712,
+  1713, 1713, 1713, 1714, 1715, 1715, 1715, 1716, 1717, 1717, 1718, 1718, 1719, 1720, 1721, 1723,
+  1723, 1723, 1723, 1723, 1723, 1724, 1725, 1725, 1726, 1727, 1727, 1727, 1729, 1729, 1730, 1730,
+  1733, 1734, 1736, 1737, 1738, 1738, 1740, 1740, 1740, 1740, 1741, 1741, 1741, 1741, 1742, 1742,
+  1742, 1743, 1744, 1745, 1748, 1751, 1755, 1755, 1755, 1755, 1755, 1756, 1758, 1758, 1758, 1760,
+  1760, 1760, 1761, 1762, 1762, 1763, 1764, 1765, 1765, 1765, 1766, 1766, 1767, 1767, 1767, 1767,
+  1768, 1768, 1769, 1770, 1771, 1774, 1774, 1777, 1778, 1781, 1781, 1781, 1784, 1784, 1784, 1785,
+  1786, 1786, 1786, 1786, 1787, 1787, 1787, 1787, 1788, 1790, 1790, 1791, 1791, 1791, 1795, 1796,
+  1797, 1799, 1800, 1800, 1801, 1801, 1802, 1803, 1803, 1806, 1806, 1809, 1809, 1809, 1809, 1810,
+  1810, 1810, 1812, 1812, 1812, 1814, 1814, 1815, 1815, 1816, 1818, 1819, 1819, 1820, 1820, 1820,
+  1821, 1822, 1822, 1822, 1822, 1823, 1826, 1826, 1827, 1829, 1829, 1829, 1830, 1831, 1832, 1833,
+  1833, 1833, 1835, 1836, 1837, 1837, 1837, 1837, 1838, 1840, 1841, 1841, 1841, 1842, 1843, 1844,
+  1845, 1846, 1847, 1847, 1847, 1847, 1847, 1847, 1847, 1848, 1849, 1850, 1851, 1851, 1851, 1851,
+  1852, 1853, 1853, 1853, 1853, 1857, 1858, 1858, 1860, 1863, 1863, 1863, 1863, 1863, 1865, 1866,
+  1866, 1866, 1866, 1866, 1867, 1867, 1869, 1871, 1871, 1872, 1874, 1875, 1876, 1876, 1876, 1878,
+  1879, 1879, 1879, 1879, 1879, 1880, 1882, 1882, 1883, 1883, 1883, 1883, 1885, 1886, 1887, 1887,
+  1888, 1889, 1890, 1890, 1891, 1892, 1892, 1892, 1892, 1892, 1894, 1895, 1896, 1897, 1898, 1898,
+  1900, 1900, 1900, 1901, 1901, 1902, 1902, 1902, 1903, 1904, 1906, 1907, 1907, 1908, 1909, 1911,
+  1911, 1911, 1912, 1912, 1913, 1914, 1914, 1917, 1918, 1918, 1919, 1920, 1921, 1924, 1925, 1926,
+  1926, 1926, 1927, 1927, 1928, 1928, 1928, 1929, 1930, 1930, 1930, 1930, 1931, 1931, 1932, 1935,
+  1936, 1936, 1937, 1938, 1939, 1939, 1940, 1942, 1942, 1942, 1943, 1945, 1945, 1945, 1945, 1947,
+  1948, 1948, 1949, 1950, 1950, 1950, 1950, 1952, 1953, 1954, 1955, 1955, 1956, 1956, 1956, 1958,
+  1959, 1959, 1961, 1962, 1963, 1963, 1963, 1963, 1964, 1965, 1966, 1967, 1967, 1968, 1970, 1970,
+  1970, 1970, 1971, 1971, 1972, 1973, 1975, 1975, 1975, 1975, 1975, 1975, 1976, 1977, 1977, 1983,
+  1985, 1986, 1988, 1988, 1988, 1990, 1990, 1991, 1991, 1992, 1992, 1993, 1993, 1993, 1993, 1993,
+  1994, 1995, 1996, 1998, 1998, 1999, 1999, 1999, 1999, 1999, 1999, 1999, 2000, 2000, 2002, 2003,
+  2005, 2005, 2006, 2008, 2008, 2008, 2008, 2008, 2008, 2008, 2008, 2008, 2009, 2009, 2010, 2011,
+  2011, 2011, 2011, 2012, 2012, 2013, 2013, 2016, 2018, 2018, 2018, 2019, 2020, 2020, 2020, 2020,
+  2020, 2021, 2022, 2024, 2026, 2027, 2028, 2028, 2029, 2029, 2029, 2029, 2029, 2029, 2029, 2031,
+  2031, 2032, 2033, 2034, 2034, 2035, 2036, 2037, 2038, 2038, 2039, 2040, 2040, 2042, 2043, 2044,
+  2046, 2046, 2046, 2047, 2047, 2048, 2050, 2050, 2050, 2051, 2054, 2055, 2055, 2056, 2056, 2056,
+  2056, 2059, 2060, 2062, 2062, 2062, 2063, 2064, 2065, 2065, 2065, 2065, 2065, 2065, 2066, 2067,
+  2067, 2068, 2069, 2069, 2069, 2071, 2072, 2072, 2074, 2076, 2076, 2076, 2077, 2078, 2078, 2079,
+  2080, 2083, 2084, 2084, 2085, 2086, 2087, 2087, 2087, 2088, 2090, 2091, 2091, 2091, 2092, 2093,
+  2094, 2096, 2097, 2097, 2098, 2100, 2101, 2101, 2101, 2102, 2102, 2102, 2103, 2104, 2105, 2105,
+  2108, 2109, 2111, 2112, 2112, 2113, 2113, 2113, 2116, 2116, 2117, 2119, 2121, 2122, 2123, 2125,
+  2127, 2127, 2128, 2129, 2131, 2131, 2131, 2132, 2132, 2134, 2135, 2135, 2136, 2137, 2137, 2138,
+  2138, 2139, 2140, 2141, 2141, 2141, 2141, 2141, 2142, 2142, 2143, 2143, 2143, 2143, 2143, 2143,
+  2143, 2143, 2143, 2143, 2143, 2144, 2145, 2146, 2147, 2147, 2147, 2148, 2150, 2151, 2151, 2153,
+  2153, 2153, 2156, 2156, 2157, 2158, 2158, 2160, 2161, 2161, 2163, 2164, 2165, 2166, 2168, 2169,
+  2169, 2169, 2170, 2170, 2172, 2174, 2176, 2176, 2178, 2179, 2180, 2180, 2180, 2181, 2182, 2183,
+  2183, 2183, 2184, 2185, 2185, 2185, 2186, 2186, 2187, 2188, 2188, 2189, 2190, 2190, 2192, 2193,
+  2194, 2194, 2195, 2197, 2198, 2200, 2202, 2203, 2203, 2204, 2204, 2204, 2206, 2207, 2207, 2208,
+  2208, 2210, 2210, 2211, 2212, 2212, 2214, 2214, 2215, 2215, 2216, 2218, 2221, 2221, 2221, 2222,
+  2222, 2222, 2222, 2223, 2223, 2224, 2224, 2224, 2225, 2226, 2226, 2226, 2228, 2228, 2228, 2228,
+  2230, 2232, 2234, 2235, 2235, 2237, 2237, 2239, 2239, 2240, 2241, 2241, 2242, 2243, 2245, 2245,
+  2245, 2245, 2245, 2245, 2245, 2245, 2245, 2247, 2247, 2247, 2247, 2247, 2248, 2249, 2250, 2253,
+  2254, 2257, 2257, 2257, 2257, 2258, 2258, 2260, 2260, 2260, 2262, 2262, 2263, 2265, 2265, 2266,
+  2266, 2266, 2266, 2267, 2268, 2269, 2270, 2271, 2272, 2272, 2272, 2273, 2274, 2275, 2276, 2277,
+  2278, 2278, 2278, 2279, 2280, 2281, 2281, 2282, 2284, 2284, 2286, 2287, 2287, 2287, 2290, 2290,
+  2291, 2292, 2295, 2296, 2296, 2296, 2296, 2297, 2298, 2298, 2299, 2299, 2299, 2299, 2299, 2299,
+  2299, 2301, 2302, 2303, 2304, 2304, 2305, 2305, 2305, 2305, 2306, 2307, 2307, 2307, 2308, 2309,
+  2312, 2313, 2314, 2314, 2314, 2314, 2314, 2316, 2316, 2316, 2318, 2319, 2319, 2321, 2321, 2322,
+  2322, 2322, 2323, 2323, 2323, 2324, 2325, 2325, 2326, 2328, 2329, 2329, 2329, 2329, 2330, 2331,
+  2331, 2332, 2333, 2333, 2335, 2335, 2335, 2336, 2337, 2337, 2339, 2340, 2341, 2341, 2341, 2342,
+  2343, 2344, 2345, 2346, 2348, 2348, 2348, 2350, 2351, 2352, 2353, 2353, 2353, 2353, 2353, 2354,
+  2354, 2354, 2354, 2355, 2356, 2356, 2358, 2358, 2358, 2359, 2359, 2359, 2360, 2360, 2361, 2361,
+  2363, 2363, 2363, 2364, 2367, 2367, 2367, 2368, 2368, 2368, 2368, 2368, 2368, 2369, 2369, 2371,
+  2372, 2373, 2374, 2374, 2374, 2374, 2376, 2377, 2379, 2379, 2380, 2380, 2380, 2380, 2380, 2380,
+  2381, 2381, 2381, 2381, 2383, 2384, 2386, 2387, 2388, 2388, 2389, 2389, 2390, 2391, 2391, 2394,
+  2394, 2394, 2395, 2395, 2396, 2397, 2397, 2397, 2397, 2397, 2397, 2398, 2400, 2401, 2401, 2402,
+  2403, 2404, 2405, 2406, 2408, 2409, 2410, 2410, 2410, 2410, 2411, 2411, 2411, 2412, 2413, 2413,
+  2414, 2414, 2414, 2414, 2414, 2414, 2416, 2416, 2416, 2417, 2419, 2420, 2421, 2422, 2422, 2422,
+  2424, 2426, 2426, 2427, 2429, 2429, 2431, 2431, 2431, 2432, 2432, 2433, 2433, 2433, 2434, 2434,
+  2434, 2434, 2435, 2436, 2436, 2436, 2437, 2439, 2440, 2440, 2440, 2441, 2444, 2445, 2445, 2446,
+  2448, 2449, 2451, 2454, 2454, 2456, 2456, 2456, 2457, 2458, 2460, 2461, 2463, 2464, 2464, 2464,
+  2465, 2465, 2466, 2467, 2467, 2468, 2468, 2468, 2469, 2469, 2469, 2471, 2472, 2472, 2472, 2474,
+  2475, 2476, 2477, 2477, 2478, 2479, 2480, 2481, 2485, 2486, 2487, 2487, 2490, 2490, 2491, 2491,
+  2491, 2492, 2494, 2496, 2498, 2500, 2500, 2501, 2501, 2502, 2504, 2505, 2506, 2507, 2509, 2509,
+  2510, 2510, 2510, 2510, 2511, 2511, 2512, 2513, 2514, 2516, 2516, 2517, 2517, 2519, 2522, 2522,
+  2522, 2522, 2522, 2522, 2524, 2526, 2526, 2527, 2529, 2529, 2530, 2530, 2530, 2530, 2531, 2533,
+  2534, 2534, 2534, 2535, 2536, 2536, 2536, 2537, 2537, 2538, 2538, 2538, 2538, 2539, 2539, 2539,
+  2540, 2540, 2541, 2542, 2542, 2542, 2542, 2542, 2542, 2542, 2542, 2542, 2543, 2544, 2545, 2546,
+  2547, 2548, 2548, 2548, 2548, 2549, 2552, 2552, 2555, 2555, 2555, 2555, 2555, 2556, 2558, 2559,
+  2559, 2559, 2560, 2561, 2561, 2562, 2562, 2562, 2562, 2563, 2566, 2568, 2569, 2571, 2572, 2574,
+  2574, 2575, 2577, 2578, 2579, 2579, 2579, 2579, 2582, 2582, 2582, 2583, 2587, 2588, 2589, 2589,
+  2589, 2590, 2591, 2591, 2595, 2597, 2599, 2599, 2599, 2601, 2603, 2604, 2605, 2606, 2607, 2607,
+  2607, 2607, 2608, 2609, 2609, 2610, 2611, 2613, 2613, 2616, 2617, 2618, 2618, 2618, 2619, 2619,
+  2621, 2622, 2622, 2622, 2624, 2624, 2625, 2626, 2626, 2626, 2627, 2628, 2630, 2632, 2634, 2638,
+  2642, 2643, 2644, 2645, 2645, 2646, 2646, 2646, 2649, 2650, 2654, 2656, 2659, 2661, 2661, 2663,
+  2663, 2664, 2664, 2664, 2664, 2664, 2664, 2664, 2668, 2668, 2668, 2670, 2671, 2672, 2673, 2673,
+  2673, 2674, 2674, 2675, 2675, 2676, 2677, 2677, 2677, 2678, 2679, 2679, 2679, 2683, 2685, 2685,
+  2686, 2686, 2687, 2688, 2689, 2693, 2693, 2694, 2694, 2694, 2695, 2695, 2696, 2696, 2696, 2696,
+  2696, 2696, 2696, 2696, 2696, 2697, 2699, 2699, 2700, 2702, 2704, 2705, 2705, 2706, 2706, 2706,
+  2706, 2706, 2706, 2706, 2706, 2708, 2708, 2710, 2713, 2713, 2714, 2715, 2715, 2716, 2717, 2720,
+  2721, 2722, 2723, 2725, 2726, 2726, 2728, 2728, 2728, 2728, 2729, 2731, 2732, 2732, 2735, 2735,
+  2735, 2735, 2735, 2736, 2737, 2738, 2738, 2739, 2740, 2743, 2744, 2744, 2745, 2745, 2746, 2746,
+  2747, 2747, 2749, 2752, 2752, 2752, 2753, 2754, 2754, 2755, 2756, 2757, 2758, 2758, 2759, 2760,
+  2760, 2761, 2762, 2762, 2762, 2762, 2763, 2763, 2765, 2765, 2765, 2766, 2768, 2769, 2770, 2770,
+  2771, 2772, 2772, 2772, 2772, 2773, 2774, 2777, 2780, 2780, 2780, 2780, 2781, 2784, 2785, 2787,
+  2788, 2788, 2789, 2789, 2790, 2791, 2792, 2792, 2793, 2794, 2795, 2798, 2799, 2801, 2803, 2803,
+  2803, 2803, 2804, 2804, 2805, 2805, 2805, 2806, 2806, 2807, 2808, 2810, 2811, 2812, 2812, 2813,
+  2813, 2816, 2819, 2819, 2819, 2820, 2820, 2820, 2822, 2823, 2824, 2825, 2825, 2825, 2826, 2826,
+  2826, 2828, 2830, 2832, 2833, 2834, 2835, 2837, 2840, 2841, 2841, 2842, 2843, 2843, 2844, 2844,
+  2844, 2844, 2845, 2846, 2847, 2848, 2849, 2852, 2853, 2853, 2854, 2856, 2856, 2859, 2859, 2861,
+  2862, 2862, 2863, 2866, 2867, 2869, 2869, 2869, 2869, 2869, 2869, 2869, 2870, 2871, 2872, 2873,
+  2873, 2876, 2877, 2878, 2880, 2883, 2885, 2885, 2887, 2888, 2888, 2889, 2890, 2890, 2892, 2894,
+  2895, 2895, 2896, 2896, 2898, 2899, 2900, 2900, 2901, 2903, 2904, 2904, 2905, 2908, 2908, 2909,
+  2909, 2909, 2910, 2910, 2910, 2911, 2912, 2914, 2916, 2917, 2919, 2919, 2919, 2921, 2921, 2922,
+  2922, 2923, 2923, 2924, 2925, 2925, 2925, 2925, 2925, 2925, 2926, 2928, 2930, 2933, 2934, 2935,
+  2935, 2936, 2938, 2938, 2939, 2940, 2942, 2943, 2943, 2943, 2943, 2944, 2945, 2945, 2947, 2948,
+  2952, 2954, 2955, 2956, 2958, 2960, 2961, 2962, 2962, 2963, 2963, 2963, 2963, 2963, 2965, 2966,
+  2967, 2967, 2967, 2970, 2971, 2972, 2972, 2972, 2974, 2976, 2976, 2977, 2977, 2977, 2978, 2978,
+  2979, 2981, 2981, 2982, 2982, 2982, 2982, 2982, 2983, 2984, 2984, 2986, 2986, 2986, 2986, 2987,
+  2988, 2990, 2991, 2993, 2994, 2995, 2997, 2997, 2998, 2998, 2998, 2998, 2999, 3002, 3002, 3004,
+  3005, 3005, 3005, 3005, 3006, 3006, 3006, 3007, 3008, 3010, 3010, 3011, 3011, 3011, 3013, 3015,
+  3017, 3017, 3017, 3017, 3018, 3020, 3021, 3023, 3025, 3025, 3028, 3028, 3028, 3030, 3031, 3031,
+  3033, 3033, 3033, 3034, 3035, 3036, 3037, 3037, 3037, 3037, 3037, 3037, 3037, 3037, 3037, 3039,
+  3041, 3044, 3047, 3048, 3048, 3048, 3049, 3049, 3049, 3050, 3051, 3051, 3051, 3051, 3052, 3054,
+  3055, 3055, 3055, 3056, 3056, 3058, 3058, 3063, 3063, 3065, 3066, 3067, 3068, 3069, 3070, 3071,
+  3071, 3071, 3071, 3072, 3073, 3073, 3073, 3075, 3077, 3077, 3077, 3078, 3079, 3079, 3080, 3081,
+  3082, 3082, 3082, 3083, 3084, 3086, 3088, 3091, 3091, 3091, 3091, 3092, 3093, 3094, 3096, 3097,
+  3097, 3098, 3100, 3101, 3102, 3104, 3105, 3106, 3106, 3106, 3108, 3110, 3113, 3113, 3113, 3115,
+  3116, 3118, 3119, 3119, 3119, 3120, 3120, 3120, 3120, 3123, 3123, 3123, 3123, 3123, 3125, 3126,
+  3128, 3129, 3129, 3130, 3131, 3134, 3134, 3135, 3135, 3136, 3137, 3137, 3137, 3139, 3140, 3140,
+  3142, 3142, 3142, 3143, 3143, 3144, 3146, 3146, 3147, 3149, 3150, 3151, 3152, 3155, 3156, 3156,
+  3156, 3156, 3156, 3158, 3159, 3161, 3161, 3161, 3161, 3161, 3161, 3164, 3164, 3164, 3165, 3165,
+  3165, 3165, 3166, 3166, 3166, 3166, 3166, 3168, 3169, 3170, 3173, 3175, 3176, 3177, 3179, 3180,
+  3181, 3182, 3183, 3184, 3186, 3188, 3190, 3190, 3192, 3194, 3194, 3197, 3197, 3197, 3198, 3199,
+  3201, 3203, 3203, 3205, 3205, 3207, 3208, 3209, 3209, 3210, 3210, 3210, 3212, 3213, 3213, 3213,
+  3214, 3215, 3216, 3216, 3217, 3218, 3219, 3223, 3224, 3226, 3228, 3228, 3228, 3229, 3232, 3233,
+  3233, 3234, 3235, 3236, 3237, 3238, 3239, 3240, 3243, 3243, 3244, 3244, 3245, 3246, 3247, 3250,
+  3251, 3254, 3254, 3255, 3255, 3256, 3258, 3258, 3258, 3261, 3263, 3264, 3266, 3266, 3267, 3268,
+  3269, 3269, 3269, 3272, 3272, 3272, 3272, 3274, 3274, 3274, 3276, 3277, 3279, 3279, 3279, 3280,
+  3281, 3282, 3284, 3284, 3284, 3285, 3285, 3286, 3288, 3289, 3290, 3290, 3290, 3290, 3291, 3292,
+  3294, 3296, 3296, 3296, 3297, 3297, 3297, 3299, 3299, 3300, 3301, 3301, 3302, 3304, 3304, 3306,
+  3306, 3306, 3306, 3306, 3307, 3307, 3308, 3308, 3309, 3311, 3311, 3311, 3312, 3313, 3314, 3316,
+  3316
+};
+
 #endif
@@ -24,6 +24,11 @@
 #include "FSNodeFactory.hxx"
 #include "FSNode.hxx"
 
+namespace {
+  // Files are never read beyond this size (the largest ROMs are 512K)
+  constexpr uInt32 MAX_READ = 512 * 1024;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 FilesystemNode::FilesystemNode()
 {
@@ -73,6 +78,15 @@ bool FilesystemNode::getChildren(FSList& fslist, ListMode mode, bool hidden) con
   return true;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool FilesystemNode::getEntries(EntryList& list, ListMode mode, bool hidden) const
+{
+  if (!_realNode || !_realNode->isDirectory())
+    return false;
+
+  return _realNode->getEntries(list, mode, hidden);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 const string& FilesystemNode::getName() const
 {
@@ -172,6 +186,12 @@ bool FilesystemNode::rename(const string& newfile)
   return (_realNode && _realNode->exists()) ? _realNode->rename(newfile) : false;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool FilesystemNode::getStats(uInt64& size, uInt64& modified) const
+{
+  return _realNode ? _realNode->getStats(size, modified) : false;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt32 FilesystemNode::read(BytePtr& image) const
 {
@@ -189,8 +209,8 @@ uInt32 FilesystemNode::read(BytePtr& image) const
   gzFile f = gzopen(getPath().c_str(), "rb");
   if(f)
   {
-    image = make_unique<uInt8[]>(512 * 1024);
-    size = gzread(f, image.get(), 512 * 1024);
+    image = make_unique<uInt8[]>(MAX_READ);
+    size = gzread(f, image.get(), MAX_READ);
     gzclose(f);
 
     if(size == 0)
@@ -201,3 +221,78 @@ uInt32 FilesystemNode::read(BytePtr& image) const
   else
     throw runtime_error("ZLIB open/read error");
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 FilesystemNode::read(ImagePtr& image) const
+{
+  uInt32 size = 0;
+
+  // Files in archives may be used in place
+  if((size = _realNode->read(image)) > 0)
+    return size;
+
+  BytePtr buffer;
+  size = read(buffer);
+  image = ImagePtr(buffer.release(), std::default_delete<uInt8[]>());
+
+  return size;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 FilesystemNode::read(
+    const std::function<void(const uInt8*, uInt32)>& handler) const
+{
+  BytePtr image;
+  uInt32 size = 0;
+
+  // Files in archives are extracted in one go
+  if((size = _realNode->read(image)) > 0)
+  {
+    handler(image.get(), size);
+    return size;
+  }
+
+  // File must actually exist
+  if(!(exists() && isReadable()))
+    throw runtime_error("File not found/readable");
+
+  // Otherwise, the file is either gzip'ed or not compressed at all; in
+  // both cases zlib reads it piece by piece
+  gzFile f = gzopen(getPath().c_str(), "rb");
+  if(!f)
+    throw runtime_error("ZLIB open/read error");
+
+  constexpr uInt32 CHUNK = 64 * 1024;
+  image = make_unique<uInt8[]>(CHUNK);
+  int length;
+  while(size < MAX_READ &&
+        (length = gzread(f, image.get(), std::min(CHUNK, MAX_READ - size))) > 0)
+  {
+    handler(image.get(), uInt32(length));
+    size += uInt32(length);
+  }
+  gzclose(f);
+
+  if(size == 0)
+    throw runtime_error("Zero-byte file");
+
+  return size;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool AbstractFSNode::getEntries(FilesystemNode::EntryList& list, ListMode mode,
+                                bool hidden) const
+{
+  AbstractFSList children;
+  if (!getChildren(children, mode, hidden))
+    return false;
+
+  for (const auto& child: children)
+  {
+    list.push_back(FilesystemNode::Entry{child->getName(), child->getPath(),
+                   child->isDirectory(), child->isFile()});
+    delete child;
+  }
+
+  return true;
+}
@@ -22,6 +22,7 @@
 #define FS_NODE_HXX
 
 #include <algorithm>
+#include <functional>
 
 /*
  * The API described in this header is meant to allow for file system browsing in a
@@ -73,6 +74,17 @@ class FilesystemNode
       kListAll = 3
     };
 
+    /**
+     * A child of a directory, as returned by getEntries().
+     */
+    struct Entry {
+      string name;
+      string path;
+      bool isDirectory;
+      bool isFile;
+    };
+    using EntryList = vector<Entry>;
+
     /**
      * Create a new pathless FilesystemNode. Since there's no path associated
      * with this node, path-related operations (i.e. exists(), isDirectory(),
@@ -147,6 +159,18 @@ class FilesystemNode
     virtual bool getChildren(FSList &fslist, ListMode mode = kListDirectoriesOnly,
                              bool hidden = false) const;
 
+    /**
+     * Return the name, path and type of the children of this directory node.
+     * This is much faster than getChildren() for large directories, since
+     * no node is created for each child, and (where supported) the type of
+     * each child is taken from the directory itself, without a stat().
+     *
+     * @return true if successful, false otherwise (e.g. when the directory
+     *         does not exist).
+     */
+    bool getEntries(EntryList& list, ListMode mode = kListDirectoriesOnly,
+                    bool hidden = false) const;
+
     /**
      * Return a string representation of the name of the file. This is can be
      * used e.g. by detection code that relies on matching the name of a given
@@ -250,6 +274,43 @@ class FilesystemNode
      */
     virtual uInt32 read(BytePtr& buffer) const;
 
+    /**
+     * Read data (binary format) into a read-only buffer, which can be shared.
+     * A file stored uncompressed in a (memory-mapped) ZIP archive isn't
+     * copied at all; the buffer then points into the archive.
+     *
+     * @param image  The buffer to contain the data
+     *
+     * @return  The number of bytes read (0 in the case of failure)
+     *          This method can throw exceptions, and should be used inside
+     *          a try-catch block.
+     */
+    uInt32 read(ImagePtr& image) const;
+
+    /**
+     * Read data (binary format) a chunk at a time, passing each chunk to the
+     * given function, so that the entire file never needs to be held in
+     * memory.  Files inside ZIP archives are still passed as one chunk.
+     *
+     * @param handler  Called with the location and length of each chunk.
+     *
+     * @return  The number of bytes read (0 in the case of failure)
+     *          This method can throw exceptions, and should be used inside
+     *          a try-catch block.
+     */
+    uInt32 read(const std::function<void(const uInt8*, uInt32)>& handler) const;
+
+    /**
+     * Get the size and the time of the last modification of the file.
+     * For a file inside a ZIP archive, these are taken from the archive.
+     *
+     * @param size      The size of the file, in bytes
+     * @param modified  The time of the last modification, in nanoseconds
+     *
+     * @return  False if the information isn't available
+     */
+    virtual bool getStats(uInt64& size, uInt64& modified) const;
+
     /**
      * The following methods are almost exactly the same as the various
      * getXXXX() methods above.  Internally, they call the respective methods
@@ -313,6 +374,20 @@ class AbstractFSNode
      */
     virtual bool getChildren(AbstractFSList& list, ListMode mode, bool hidden) const = 0;
 
+    /**
+     * Return the name, path and type of the children of this directory node.
+     * By default, these are taken from getChildren().
+     *
+     * @param list List to put the entries of the directory in.
+     * @param mode Mode to use while listing the directory.
+     * @param hidden Whether to include hidden files or not in the results.
+     *
+     * @return true if successful, false otherwise (e.g. when the directory
+     *         does not exist).
+     */
+    virtual bool getEntries(FilesystemNode::EntryList& list, ListMode mode,
+                            bool hidden) const;
+
     /**
      * Returns the last component of the path pointed by this FilesystemNode.
      *
@@ -399,6 +474,19 @@ class AbstractFSNode
      */
     virtual uInt32 read(BytePtr& buffer) const { return 0; }
 
+    /**
+     * As above, but into a read-only buffer, which the node may share with
+     * others (for example, a memory-mapped archive).
+     */
+    virtual uInt32 read(ImagePtr& image) const { return 0; }
+
+    /**
+     * Get the size and the time of the last modification of the file.
+     *
+     * @return  False if the information isn't available
+     */
+    virtual bool getStats(uInt64& size, uInt64& modified) const { return false; }
+
     /**
      * The parent node of this directory.
      * The parent of the root is the root itself.
@@ -31,6 +31,7 @@
 #include "TimeMachine.hxx"
 #include "OSystem.hxx"
 #include "Settings.hxx"
+#include "Sound.hxx"
 #include "TIA.hxx"
 
 #include "FBSurface.hxx"
@@ -47,6 +48,7 @@ FrameBuffer::FrameBuffer(OSystem& osystem)
     myInitializedCount(0),
     myPausedCount(0),
     myStatsEnabled(false),
+    myLastUnderruns(0),
     myLastFrameRate(60),
     myCurrentModeList(nullptr),
     myTotalTime(0),
@@ -231,7 +233,7 @@ FBInitStatus FrameBuffer::createDisplay(const string& title,
   // Create surfaces for TIA statistics and general messages
   myStatsMsg.color = kColorInfo;
   myStatsMsg.w = font().getMaxCharWidth() * 30 + 3;
-  myStatsMsg.h = (font().getFontHeight() + 2) * 2;
+  myStatsMsg.h = (font().getFontHeight() + 2) * 3;
 
   if(!myStatsMsg.surface)
   {
@@ -425,6 +427,18 @@ void FrameBuffer::drawFrameStats()
   myStatsMsg.surface->drawString(font(), bsinfo, XPOS, YPOS + font().getFontHeight(),
                                  myStatsMsg.w, myStatsMsg.color, TextAlign::Left, 0, true, kBGColor);
 
+  // draw audio buffering (queued/target latency, and underruns so far)
+  const Sound::Stats audio = myOSystem.sound().stats();
+  if(audio.callbacks > 0)
+  {
+    color = audio.underruns != myLastUnderruns ? uInt32(kDbgColorRed) : myStatsMsg.color;
+    myLastUnderruns = audio.underruns;
+    std::snprintf(msg, 30, "Audio %4.1f/%4.1fms U:%u%s", audio.queueDepth,
+                  audio.targetDepth, audio.underruns, audio.adaptive ? " A" : "");
+    myStatsMsg.surface->drawString(font(), msg, XPOS, YPOS + font().getFontHeight() * 2,
+                                   myStatsMsg.w, color, TextAlign::Left, 0, true, kBGColor);
+  }
+
   myStatsMsg.surface->setDirty();
   myStatsMsg.surface->setDstPos(myImageRect.x() + 10, myImageRect.y() + 8);
   myStatsMsg.surface->render();
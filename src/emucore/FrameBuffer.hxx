@@ -520,6 +520,7 @@ class FrameBuffer
     Message myStatsMsg;
     bool myStatsEnabled;
     uInt32 myLastScanlines;
+    uInt32 myLastUnderruns;
     float myLastFrameRate;
 
     bool myGrabMouse;
@@ -80,7 +80,9 @@ static void MD5Update(MD5_CTX*, const uInt8*, uInt32);
 static void MD5Final(uInt8[16], MD5_CTX*);
 static void MD5Transform(uInt32 [4], const uInt8 [64]);
 static void Encode(uInt8*, uInt32*, uInt32);
+#ifdef __BIG_ENDIAN__
 static void Decode(uInt32*, const uInt8*, uInt32);
+#endif
 
 static uInt8 PADDING[64] = {
   0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
@@ -89,7 +91,9 @@ static uInt8 PADDING[64] = {
 };
 
 // F, G, H and I are basic MD5 functions.
-#define F(x, y, z) (((x) & (y)) | ((~x) & (z)))
+// F is written as a bit selection with one operation less than the
+// textbook form ((x & y) | (~x & z)); G is inlined into GG below.
+#define F(x, y, z) ((((y) ^ (z)) & (x)) ^ (z))
 #define G(x, y, z) (((x) & (z)) | ((y) & (~z)))
 #define H(x, y, z) ((x) ^ (y) ^ (z))
 #define I(x, y, z) ((y) ^ ((x) | (~z)))
@@ -99,23 +103,32 @@ static uInt8 PADDING[64] = {
 
 // FF, GG, HH, and II transformations for rounds 1, 2, 3, and 4.
 // Rotation is separate from addition to prevent recomputation.
+// The message word and constant are added first, since they don't depend
+// on the previous step; this shortens the chain of dependent operations.
+// Likewise, the two halves of G are added separately, since the first
+// only needs d, which is known a step earlier than b.
 #define FF(a, b, c, d, x, s, ac) { \
- (a) += F ((b), (c), (d)) + (x) + uInt32(ac); \
+ (a) += (x) + uInt32(ac); \
+ (a) += F ((b), (c), (d)); \
  (a) = ROTATE_LEFT ((a), (s)); \
  (a) += (b); \
   }
 #define GG(a, b, c, d, x, s, ac) { \
- (a) += G ((b), (c), (d)) + (x) + uInt32(ac); \
+ (a) += (x) + uInt32(ac); \
+ (a) += (c) & ~(d); \
+ (a) += (b) & (d); \
  (a) = ROTATE_LEFT ((a), (s)); \
  (a) += (b); \
   }
 #define HH(a, b, c, d, x, s, ac) { \
- (a) += H ((b), (c), (d)) + (x) + uInt32(ac); \
+ (a) += (x) + uInt32(ac); \
+ (a) += H ((b), (c), (d)); \
  (a) = ROTATE_LEFT ((a), (s)); \
  (a) += (b); \
   }
 #define II(a, b, c, d, x, s, ac) { \
- (a) += I ((b), (c), (d)) + (x) + uInt32(ac); \
+ (a) += (x) + uInt32(ac); \
+ (a) += I ((b), (c), (d)); \
  (a) = ROTATE_LEFT ((a), (s)); \
  (a) += (b); \
   }
@@ -198,7 +211,13 @@ static void MD5Transform(uInt32 state[4], const uInt8 block[64])
 {
   uInt32 a = state[0], b = state[1], c = state[2], d = state[3], x[16];
 
+  // On little-endian hosts the block already is in the right order, and
+  // the copy becomes plain loads
+#ifdef __BIG_ENDIAN__
   Decode (x, block, 64);
+#else
+  memcpy (x, block, 64);
+#endif
 
   /* Round 1 */
   FF (a, b, c, d, x[ 0], S11, 0xd76aa478); /* 1 */
@@ -276,9 +295,6 @@ static void MD5Transform(uInt32 state[4], const uInt8 block[64])
   state[1] += b;
   state[2] += c;
   state[3] += d;
-
-  /* Zeroize sensitive information. */
-  memset (reinterpret_cast<POINTER>(x), 0, sizeof(x));
 }
 
 // Encodes input (uInt32) into output (uInt8). Assumes len is
@@ -295,6 +311,7 @@ static void Encode(uInt8* output, uInt32* input, uInt32 len)
   }
 }
 
+#ifdef __BIG_ENDIAN__
 // Decodes input (uInt8) into output (uInt32). Assumes len is
 // a multiple of 4.
 static void Decode(uInt32* output, const uInt8* input, uInt32 len)
@@ -305,6 +322,7 @@ static void Decode(uInt32* output, const uInt8* input, uInt32 len)
     output[i] = (uInt32(input[j])) | ((uInt32(input[j+1])) << 8) |
     ((uInt32(input[j+2])) << 16) | ((uInt32(input[j+3])) << 24);
 }
+#endif
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 string hash(const BytePtr& buffer, uInt32 length)
@@ -313,14 +331,11 @@ string hash(const BytePtr& buffer, uInt32 length)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-string hash(const uInt8* buffer, uInt32 length)
+static string toString(MD5_CTX& context)
 {
   char hex[] = "0123456789abcdef";
-  MD5_CTX context;
   uInt8 md5[16];
 
-  MD5Init(&context);
-  MD5Update(&context, buffer, length);
   MD5Final(md5, &context);
 
   string result;
@@ -333,22 +348,36 @@ string hash(const uInt8* buffer, uInt32 length)
   return result;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string hash(const uInt8* buffer, uInt32 length)
+{
+  MD5_CTX context;
+
+  MD5Init(&context);
+  MD5Update(&context, buffer, length);
+
+  return toString(context);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 string hash(const FilesystemNode& node)
 {
-  BytePtr image;
-  uInt32 size = 0;
+  MD5_CTX context;
+
+  // The file is hashed as it is read, rather than being loaded first
+  MD5Init(&context);
   try
   {
-    size = node.read(image);
+    node.read([&context](const uInt8* buffer, uInt32 length) {
+      MD5Update(&context, buffer, length);
+    });
   }
   catch(...)
   {
     return EmptyString;
   }
 
-  const string& md5 = hash(image, size);
-  return md5;
+  return toString(context);
 }
 
 }  // Namespace MD5
@@ -0,0 +1,72 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2018 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef MUSIC_CLOCK_HXX
+#define MUSIC_CLOCK_HXX
+
+#include "bspf.hxx"
+
+/**
+  The music OSC used by the DPC, DPC+, CDF, BUS and CTY schemes runs at
+  20 kHz, ie, 20000 clocks per 1193191.666... CPU cycles, or exactly 60000
+  clocks per 3579575 cycles.  Working in those integer units, the clocks
+  elapsed since the last update are found with one multiply and (only when
+  at least one clock has passed) one divide, and the fractional clock left
+  over is carried exactly as the remainder.
+*/
+namespace MusicClock {
+
+  constexpr uInt32 CLOCKS = 60000, CYCLES = 3579575;
+
+  /**
+    Advance the clock by the given number of CPU cycles.
+
+    @param cycles    The number of CPU cycles since the last update
+    @param fraction  The fractional clock carried from the last update,
+                     in units of 1/CYCLES; updated on return
+
+    @return  The number of whole clocks that have elapsed
+  */
+  inline uInt32 advance(uInt32 cycles, uInt32& fraction)
+  {
+    const uInt64 total = uInt64(cycles) * CLOCKS + fraction;
+    if(total < CYCLES)
+    {
+      fraction = uInt32(total);
+      return 0;
+    }
+
+    const uInt64 clocks = total / CYCLES;
+    fraction = uInt32(total - clocks * CYCLES);
+    return uInt32(clocks);
+  }
+
+  /**
+    Convert the fractional clock to and from the floating-point value
+    stored in state files.
+  */
+  inline double toDouble(uInt32 fraction)
+  {
+    return double(fraction) / CYCLES;
+  }
+  inline uInt32 fromDouble(double value)
+  {
+    return value > 0.0 ? std::min(uInt32(value * CYCLES), CYCLES - 1) : 0;
+  }
+}
+
+#endif
@@ -43,6 +43,7 @@
 #include "TIASurface.hxx"
 #include "Settings.hxx"
 #include "PropsSet.hxx"
+#include "RomInfoCache.hxx"
 #include "EventHandler.hxx"
 #include "Menu.hxx"
 #include "CommandMenu.hxx"
@@ -61,7 +62,10 @@
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 OSystem::OSystem()
   : myLauncherUsed(false),
-    myQuitLoop(false)
+    myQuitLoop(false),
+    myImageSize(0),
+    myImageFileSize(0),
+    myImageModified(0)
 {
   // Calculate startup time
   myMillisAtStart = uInt32(time(nullptr) * 1000);
@@ -131,6 +135,7 @@ bool OSystem::create()
 
   // Create a properties set for us to use and set it up
   myPropSet = make_unique<PropertiesSet>(propertiesFile());
+  myRomInfoCache = make_unique<RomInfoCache>(myBaseDir + "stella.ric");
 
 #ifdef CHEATCODE_SUPPORT
   myCheatManager = make_unique<CheatManager>(*this);
@@ -181,6 +186,9 @@ void OSystem::saveConfig()
 
   if(myPropSet)
     myPropSet->save(myPropertiesFile);
+
+  if(myRomInfoCache)
+    myRomInfoCache->save();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -358,6 +366,10 @@ string OSystem::createConsole(const FilesystemNode& rom, const string& md5sum,
         << getROMInfo(*myConsole) << endl;
     logMessage(buf.str(), 1);
 
+    // Remember anything detected for this ROM right away, rather than
+    // only on a clean exit
+    myRomInfoCache->save();
+
     // Update the timing info for a new console run
     resetLoopTiming();
 
@@ -453,7 +465,7 @@ OSystem::openConsole(const FilesystemNode& romfile, string& md5)
   unique_ptr<Console> console;
 
   // Open the cartridge image and read it in
-  BytePtr image;
+  ImagePtr image;
   uInt32 size  = 0;
   if((image = openROM(romfile, md5, size)) != nullptr)
   {
@@ -471,11 +483,14 @@ OSystem::openConsole(const FilesystemNode& romfile, string& md5)
     CMDLINE_PROPS_UPDATE("bs", Cartridge_Type);
     CMDLINE_PROPS_UPDATE("type", Cartridge_Type);
 
-    // Now create the cartridge
+    // Now create the cartridge, using the type autodetected the last time
+    // this ROM was opened (if any)
     string cartmd5 = md5;
     const string& type = props.get(Cartridge_Type);
+    BSType autodetected = myRomInfoCache->type(md5);
     unique_ptr<Cartridge> cart =
-      CartDetector::create(image, size, cartmd5, type, *this);
+      CartDetector::create(image, size, cartmd5, type, autodetected, *this);
+    myRomInfoCache->setType(md5, autodetected);
 
     // It's possible that the cart created was from a piece of the image,
     // and that the md5 (and hence the cart) has changed
@@ -529,22 +544,50 @@ void OSystem::closeConsole()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-BytePtr OSystem::openROM(const FilesystemNode& rom, string& md5, uInt32& size)
+ImagePtr OSystem::openROM(const FilesystemNode& rom, string& md5, uInt32& size)
 {
   // This method has a documented side-effect:
   // It not only loads a ROM and creates an array with its contents,
   // but also adds a properties entry if the one for the ROM doesn't
   // contain a valid name
 
-  BytePtr image;
-  if((size = rom.read(image)) == 0)
-    return nullptr;
+  // The file is only read again if it has changed (for example, when
+  // a homebrew ROM is rebuilt and reloaded)
+  ImagePtr image;
+  uInt64 fileSize = 0, modified = 0;
+  const bool hasStats = rom.getStats(fileSize, modified);
+  if(hasStats && myImage && rom == myImageFile &&
+     fileSize == myImageFileSize && modified == myImageModified)
+  {
+    image = myImage;
+    size = myImageSize;
+  }
+  else
+  {
+    myImage.reset();
+    if((size = rom.read(image)) == 0)
+      return nullptr;
+
+    // Without the stats of the file, changes to it can't be detected
+    if(hasStats)
+    {
+      myImageFile = rom;
+      myImage = image;
+      myImageSize = size;
+      myImageFileSize = fileSize;
+      myImageModified = modified;
+    }
+  }
 
   // If we get to this point, we know we have a valid file to open
   // Now we make sure that the file has a valid properties entry
-  // To save time, only generate an MD5 if we really need one
-  if(md5 == "")
-    md5 = MD5::hash(image, size);
+  // To save time, only generate an MD5 if we really need one, and the
+  // file hasn't been seen before
+  if(md5 == "" && !myRomInfoCache->getMD5(rom, md5))
+  {
+    md5 = MD5::hash(image.get(), size);
+    myRomInfoCache->setMD5(rom, md5);
+  }
 
   // Some games may not have a name, since there may not
   // be an entry in stella.pro.  In that case, we use the rom name
@@ -32,6 +32,7 @@ class EventHandler;
 class PNGLibrary;
 class Properties;
 class PropertiesSet;
+class RomInfoCache;
 class Random;
 class SerialPort;
 class Settings;
@@ -117,6 +118,13 @@ class OSystem
     */
     PropertiesSet& propSet() const { return *myPropSet; }
 
+    /**
+      Get the cache of what was autodetected for previously opened ROMs.
+
+      @return The ROM info cache object
+    */
+    RomInfoCache& romInfoCache() const { return *myRomInfoCache; }
+
     /**
       Get the console of the system.  The console won't always exist,
       so we should test if it's available.
@@ -454,6 +462,9 @@ class OSystem
     // Pointer to the PropertiesSet object
     unique_ptr<PropertiesSet> myPropSet;
 
+    // Pointer to the RomInfoCache object
+    unique_ptr<RomInfoCache> myRomInfoCache;
+
     // Pointer to the (currently defined) Console object
     unique_ptr<Console> myConsole;
 
@@ -520,6 +531,14 @@ class OSystem
     FilesystemNode myRomFile;
     string myRomMD5;
 
+    // The contents of the ROM file opened last, which the cartridge shares;
+    // they're kept so that reloading the ROM (also done when switching games
+    // on a multicart) doesn't read the file again, unless it has changed
+    FilesystemNode myImageFile;
+    ImagePtr myImage;
+    uInt32 myImageSize;
+    uInt64 myImageFileSize, myImageModified;
+
     string myFeatures;
     string myBuildInfo;
 
@@ -558,16 +577,17 @@ class OSystem
     /**
       Open the given ROM and return an array containing its contents.
       Also, the properties database is updated with a valid ROM name
-      for this ROM (if necessary).
+      for this ROM (if necessary).  If the ROM was the last one opened,
+      and hasn't changed since, its contents are used again.
 
       @param rom    The file node of the ROM to open (contains path)
       @param md5    The md5 calculated from the ROM file
                     (will be recalculated if necessary)
       @param size   The amount of data read into the image array
 
-      @return  Unique pointer to the array
+      @return  Shared pointer to the (read-only) array
     */
-    BytePtr openROM(const FilesystemNode& rom, string& md5, uInt32& size);
+    ImagePtr openROM(const FilesystemNode& rom, string& md5, uInt32& size);
 
     /**
       Gets all possible info about the given console.
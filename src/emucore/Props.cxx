@@ -24,12 +24,16 @@
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Properties::Properties()
+  : myBuiltIn(nullptr),
+    myLoaded(0)
 {
   setDefaults();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Properties::Properties(const Properties& properties)
+  : myBuiltIn(nullptr),
+    myLoaded(0)
 {
   copy(properties);
 }
@@ -40,40 +44,69 @@ void Properties::set(PropertyType key, const string& value)
   if(key != LastPropType)
   {
     myProperties[key] = value;
-    if(BSPF::equalsIgnoreCase(myProperties[key], "AUTO-DETECT"))
-      myProperties[key] = "AUTO";
+    myLoaded |= 1 << key;
+    normalize(key, myProperties[key]);
+  }
+}
 
-    switch(key)
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Properties::setBuiltIn(const char* const* entry)
+{
+  myBuiltIn = entry;
+  myLoaded = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Properties::load(PropertyType key) const
+{
+  // Empty values in the built-in list stand for the default
+  const char* const value = myBuiltIn[key];
+  if(value[0] != 0)
+  {
+    myProperties[key] = value;
+    normalize(key, myProperties[key]);
+  }
+  else
+    myProperties[key] = ourDefaultProperties[key];
+
+  myLoaded |= 1 << key;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Properties::normalize(PropertyType key, string& value)
+{
+  if(BSPF::equalsIgnoreCase(value, "AUTO-DETECT"))
+    value = "AUTO";
+
+  switch(key)
+  {
+    case Cartridge_Type:
+    case Display_Format:
+    case Cartridge_Sound:
+    case Console_LeftDifficulty:
+    case Console_RightDifficulty:
+    case Console_TelevisionType:
+    case Console_SwapPorts:
+    case Controller_Left:
+    case Controller_Right:
+    case Controller_SwapPaddles:
+    case Controller_MouseAxis:
+    case Display_Phosphor:
+    {
+      transform(value.begin(), value.end(), value.begin(), ::toupper);
+      break;
+    }
+
+    case Display_PPBlend:
     {
-      case Cartridge_Type:
-      case Display_Format:
-      case Cartridge_Sound:
-      case Console_LeftDifficulty:
-      case Console_RightDifficulty:
-      case Console_TelevisionType:
-      case Console_SwapPorts:
-      case Controller_Left:
-      case Controller_Right:
-      case Controller_SwapPaddles:
-      case Controller_MouseAxis:
-      case Display_Phosphor:
-      {
-        transform(myProperties[key].begin(), myProperties[key].end(),
-                  myProperties[key].begin(), ::toupper);
-        break;
-      }
-
-      case Display_PPBlend:
-      {
-        int blend = atoi(myProperties[key].c_str());
-        if(blend < 1 || blend > 100)
-          myProperties[key] = ourDefaultProperties[key];
-        break;
-      }
-
-      default:
-        break;
+      int blend = atoi(value.c_str());
+      if(blend < 1 || blend > 100)
+        value = ourDefaultProperties[key];
+      break;
     }
+
+    default:
+      break;
   }
 }
 
@@ -120,11 +153,12 @@ ostream& operator<<(ostream& os, const Properties& p)
   for(int i = 0; i < LastPropType; ++i)
   {
     // Try to save some space by only saving the items that differ from default
-    if(p.myProperties[i] != Properties::ourDefaultProperties[i])
+    const string& value = p.get(PropertyType(i));
+    if(value != Properties::ourDefaultProperties[i])
     {
       p.writeQuotedString(os, Properties::ourPropertyNames[i]);
       os.put(' ');
-      p.writeQuotedString(os, p.myProperties[i]);
+      p.writeQuotedString(os, value);
       os.put('\n');
       changed = true;
     }
@@ -195,7 +229,7 @@ void Properties::writeQuotedString(ostream& out, const string& s)
 bool Properties::operator==(const Properties& properties) const
 {
   for(int i = 0; i < LastPropType; ++i)
-    if(myProperties[i] != properties.myProperties[i])
+    if(get(PropertyType(i)) != properties.get(PropertyType(i)))
       return false;
 
   return true;
@@ -229,9 +263,13 @@ void Properties::setDefault(PropertyType key, const string& value)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Properties::copy(const Properties& properties)
 {
-  // Now, copy each property from properties
+  // Now, copy each property from properties; those which haven't been
+  // taken from the built-in entry yet are left for later
+  myBuiltIn = properties.myBuiltIn;
+  myLoaded = properties.myLoaded;
   for(int i = 0; i < LastPropType; ++i)
-    myProperties[i] = properties.myProperties[i];
+    if(!myBuiltIn || (myLoaded & (1 << i)))
+      myProperties[i] = properties.myProperties[i];
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -264,6 +302,7 @@ void Properties::print() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Properties::setDefaults()
 {
+  myBuiltIn = nullptr;
   for(int i = 0; i < LastPropType; ++i)
     myProperties[i] = ourDefaultProperties[i];
 }
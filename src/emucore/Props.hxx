@@ -82,7 +82,11 @@ class Properties
       @return     The value of the property
     */
     const string& get(PropertyType key) const {
-      return key != LastPropType ? myProperties[key] : EmptyString;
+      if(key == LastPropType)
+        return EmptyString;
+      if(myBuiltIn && !(myLoaded & (1 << key)))
+        load(key);
+      return myProperties[key];
     }
 
     /**
@@ -145,6 +149,30 @@ class Properties
     static void setDefault(PropertyType key, const string& value);
 
   private:
+    /**
+      Take all properties from the given entry of the built-in list.  The
+      values are only copied from the list as they're accessed, since most
+      users look at a few of them only.
+
+      @param entry  The built-in properties to use
+    */
+    void setBuiltIn(const char* const* entry);
+
+    /**
+      Copy the value for the given key from the built-in entry.
+
+      @param key  The key of the property to copy
+    */
+    void load(PropertyType key) const;
+
+    /**
+      Bring the value for the given key into its canonical form.
+
+      @param key    The key of the property
+      @param value  The value to modify
+    */
+    static void normalize(PropertyType key, string& value);
+
     /**
       Helper function to perform a deep copy of the specified
       properties.  Assumes that old properties have already been
@@ -188,7 +216,12 @@ class Properties
 
   private:
     // The array of properties
-    string myProperties[LastPropType];
+    mutable string myProperties[LastPropType];
+
+    // The built-in entry these properties are taken from (if any), and a
+    // bitmask of the values already copied from it into the array
+    const char* const* myBuiltIn;
+    mutable uInt32 myLoaded;
 
     // List of default properties to use when none have been provided
     static string ourDefaultProperties[LastPropType];
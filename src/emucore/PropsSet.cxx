@@ -89,34 +89,49 @@ bool PropertiesSet::getMD5(const string& md5, Properties& properties,
     }
   }
 
-  // Otherwise, search the internal database using binary search
+  // Otherwise, search the internal database
   if(!found)
   {
-    int low = 0, high = DEF_PROPS_SIZE - 1;
-    while(low <= high)
+    int i = findBuiltIn(md5);
+    if(i >= 0)
     {
-      int i = (low + high) / 2;
-      int cmp = BSPF::compareIgnoreCase(md5, DefProps[i][Cartridge_MD5]);
-
-      if(cmp == 0)  // found it
-      {
-        for(int p = 0; p < LastPropType; ++p)
-          if(DefProps[i][p][0] != 0)
-            properties.set(PropertyType(p), DefProps[i][p]);
-
-        found = true;
-        break;
-      }
-      else if(cmp < 0)
-        high = i - 1; // look at lower range
-      else
-        low = i + 1;  // look at upper range
+      properties.setBuiltIn(DefProps[i]);
+      found = true;
     }
   }
 
   return found;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int PropertiesSet::findBuiltIn(const string& md5)
+{
+  // The built-in list is searched by the binary form of the md5, starting
+  // with the entries which have the same leading bits
+  if(md5.length() != 32)
+    return -1;
+
+  uInt8 key[16];
+  for(int i = 0; i < 32; ++i)
+  {
+    const char c = md5[i];
+    uInt8 digit;
+    if(c >= '0' && c <= '9')       digit = c - '0';
+    else if(c >= 'a' && c <= 'f')  digit = c - 'a' + 10;
+    else if(c >= 'A' && c <= 'F')  digit = c - 'A' + 10;
+    else                           return -1;
+
+    key[i >> 1] = (i & 1) ? (key[i >> 1] | digit) : (digit << 4);
+  }
+
+  const uInt32 leading = ((key[0] << 8) | key[1]) >> (16 - DEF_PROPS_INDEX_BITS);
+  for(int i = DefPropsIndex[leading]; i < DefPropsIndex[leading + 1]; ++i)
+    if(memcmp(key, DefPropsMD5[i], 16) == 0)
+      return i;
+
+  return -1;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void PropertiesSet::getMD5WithInsert(const FilesystemNode& rom,
                                      const string& md5, Properties& properties)
@@ -197,11 +212,7 @@ void PropertiesSet::print() const
   Properties properties;
   for(int i = 0; i < DEF_PROPS_SIZE; ++i)
   {
-    properties.setDefaults();
-    for(int p = 0; p < LastPropType; ++p)
-      if(DefProps[i][p][0] != 0)
-        properties.set(PropertyType(p), DefProps[i][p]);
-
+    properties.setBuiltIn(DefProps[i]);
     list.emplace(DefProps[i][Cartridge_MD5], properties);
   }
 
@@ -112,6 +112,16 @@ class PropertiesSet
     */
     void print() const;
 
+  private:
+    /**
+      Find the entry with the given MD5 in the built-in properties.
+
+      @param md5  The md5 of the properties to find
+
+      @return  The index of the entry, or -1 if not found
+    */
+    static int findBuiltIn(const string& md5);
+
   private:
     using PropsList = std::map<string, Properties>;
 
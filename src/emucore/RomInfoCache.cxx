@@ -0,0 +1,231 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2018 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "FSNode.hxx"
+#include "Version.hxx"
+#include "RomInfoCache.hxx"
+
+namespace {
+  // Written as the first line, so that caches from other versions are ignored
+  const string HEADER = string("Stella ") + STELLA_VERSION + " ROM info";
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RomInfoCache::RomInfoCache(const string& filename)
+  : myFilename(filename),
+    myChanged(false)
+{
+  load();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomInfoCache::load()
+{
+  ifstream in(myFilename);
+  string line;
+  if(!getline(in, line) || line != HEADER)
+    return;
+
+  // Each line is a tab-separated record; files are listed as
+  //   F  size  modified  md5  path
+  // and images as
+  //   I  md5  type  layout  ystart(NTSC)  ystart(PAL)
+  while(getline(in, line))
+  {
+    istringstream buf(line);
+    string kind;
+    getline(buf, kind, '\t');
+
+    if(kind == "F")
+    {
+      FileEntry entry;
+      string path;
+      buf >> entry.size >> entry.modified >> entry.md5;
+      buf.get();
+      if(buf && getline(buf, path) && path != "")
+        myFiles[path] = entry;
+    }
+    else if(kind == "I")
+    {
+      ImageEntry entry;
+      string md5, type;
+      buf >> md5 >> type >> entry.layout >> entry.ystart[0] >> entry.ystart[1];
+      if(!buf.fail())
+      {
+        entry.type = Bankswitch::nameToType(type);
+        if(entry.layout == "-") entry.layout = "";
+        myImages[md5] = entry;
+      }
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RomInfoCache::save()
+{
+  if(!myChanged)
+    return true;
+
+  ofstream out(myFilename);
+  if(!out)
+    return false;
+
+  out << HEADER << endl;
+  for(const auto& f: myFiles)
+    out << "F\t" << f.second.size << "\t" << f.second.modified << "\t"
+        << f.second.md5 << "\t" << f.first << endl;
+  for(const auto& i: myImages)
+    out << "I\t" << i.first << "\t" << Bankswitch::typeToName(i.second.type)
+        << "\t" << (i.second.layout != "" ? i.second.layout : "-") << "\t"
+        << i.second.ystart[0] << "\t" << i.second.ystart[1] << endl;
+
+  myChanged = false;
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RomInfoCache::getMD5(const FilesystemNode& rom, string& md5) const
+{
+  uInt64 size, modified, cachedSize, cachedModified;
+  string cachedMD5;
+  if(!getMD5(rom.getPath(), cachedSize, cachedModified, cachedMD5) ||
+     !rom.getStats(size, modified) ||
+     size != cachedSize || modified != cachedModified)
+    return false;
+
+  md5 = cachedMD5;
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RomInfoCache::getMD5(const string& path, uInt64& size, uInt64& modified,
+                          string& md5) const
+{
+  const auto it = myFiles.find(path);
+  if(it == myFiles.end())
+    return false;
+
+  size = it->second.size;
+  modified = it->second.modified;
+  md5 = it->second.md5;
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomInfoCache::setMD5(const FilesystemNode& rom, const string& md5)
+{
+  uInt64 size, modified;
+  if(rom.getStats(size, modified))
+    setMD5(rom.getPath(), size, modified, md5);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomInfoCache::setMD5(const string& path, uInt64 size, uInt64 modified,
+                          const string& md5)
+{
+  FileEntry& current = myFiles[path];
+  if(current.md5 != md5 || current.size != size || current.modified != modified)
+  {
+    current.size = size;
+    current.modified = modified;
+    current.md5 = md5;
+    myChanged = true;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RomInfoCache::ImageEntry& RomInfoCache::image(const string& md5)
+{
+  auto it = myImages.find(md5);
+  if(it == myImages.end())
+    it = myImages.emplace(md5, ImageEntry{ BSType::_AUTO, "", { -1, -1 } }).first;
+
+  return it->second;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+BSType RomInfoCache::type(const string& md5) const
+{
+  const auto it = myImages.find(md5);
+  return it != myImages.end() ? it->second.type : BSType::_AUTO;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomInfoCache::setType(const string& md5, BSType type)
+{
+  if(type == BSType::_AUTO || md5 == "")
+    return;
+
+  ImageEntry& entry = image(md5);
+  if(entry.type != type)
+  {
+    entry.type = type;
+    myChanged = true;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string RomInfoCache::frameLayout(const string& md5) const
+{
+  const auto it = myImages.find(md5);
+  return it != myImages.end() ? it->second.layout : EmptyString;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomInfoCache::setFrameLayout(const string& md5, const string& layout)
+{
+  if(layout == "" || md5 == "")
+    return;
+
+  ImageEntry& entry = image(md5);
+  if(entry.layout != layout)
+  {
+    entry.layout = layout;
+    myChanged = true;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RomInfoCache::getYStart(const string& md5, const string& layout,
+                             uInt32& ystart) const
+{
+  const auto it = myImages.find(md5);
+  if(it == myImages.end())
+    return false;
+
+  const Int32 value = it->second.ystart[layout == "PAL" ? 1 : 0];
+  if(value < 0)
+    return false;
+
+  ystart = uInt32(value);
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomInfoCache::setYStart(const string& md5, const string& layout,
+                             uInt32 ystart)
+{
+  if(md5 == "")
+    return;
+
+  Int32& value = image(md5).ystart[layout == "PAL" ? 1 : 0];
+  if(value != Int32(ystart))
+  {
+    value = Int32(ystart);
+    myChanged = true;
+  }
+}
@@ -0,0 +1,134 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2018 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef ROM_INFO_CACHE_HXX
+#define ROM_INFO_CACHE_HXX
+
+#include <map>
+
+class FilesystemNode;
+
+#include "bspf.hxx"
+#include "BSType.hxx"
+
+/**
+  This class remembers what was found out about a ROM the last time it was
+  opened, so that relaunching it doesn't need to do so again: the MD5 of
+  the file (valid as long as its path, size and modification time are the
+  same), and for the image with that MD5, the autodetected bankswitch
+  type, frame layout and ystart.
+
+  The cache is kept in a file, which is only rewritten when something was
+  added.  Since the results of autodetection may differ between releases,
+  a cache written by another version of Stella is ignored.
+*/
+class RomInfoCache
+{
+  public:
+    /**
+      Create a cache from the specified file (if it exists).
+    */
+    RomInfoCache(const string& filename);
+
+  public:
+    /**
+      Save the cache to its file, if it has changed since it was loaded.
+
+      @return  False if the file couldn't be written
+    */
+    bool save();
+
+    /**
+      Get/set the MD5 of the given file.  The second form of setMD5 is for
+      when the size and modification time of the file are already known.
+
+      @return  False if the MD5 isn't known, or the file has changed
+    */
+    bool getMD5(const FilesystemNode& rom, string& md5) const;
+    void setMD5(const FilesystemNode& rom, const string& md5);
+    void setMD5(const string& path, uInt64 size, uInt64 modified,
+                const string& md5);
+
+    /**
+      Get the MD5 of the given file as it was last recorded, along with the
+      size and modification time the file had at that point.  Unlike the
+      methods above, this doesn't access the file itself; the caller must
+      check that it hasn't changed since.
+
+      @return  False if the file isn't known
+    */
+    bool getMD5(const string& path, uInt64& size, uInt64& modified,
+                string& md5) const;
+
+    /**
+      Get/set the autodetected bankswitch type of the image with the given
+      MD5; BSType::_AUTO if not known.
+    */
+    BSType type(const string& md5) const;
+    void setType(const string& md5, BSType type);
+
+    /**
+      Get/set the autodetected frame layout ("NTSC" or "PAL") of the image
+      with the given MD5; an empty string if not known.
+    */
+    string frameLayout(const string& md5) const;
+    void setFrameLayout(const string& md5, const string& layout);
+
+    /**
+      Get/set the autodetected ystart of the image with the given MD5,
+      when using the given frame layout ("PAL", otherwise NTSC).
+
+      @return  False if not known
+    */
+    bool getYStart(const string& md5, const string& layout, uInt32& ystart) const;
+    void setYStart(const string& md5, const string& layout, uInt32 ystart);
+
+  private:
+    // Where a file was found, and what it contained at the time
+    struct FileEntry {
+      uInt64 size;
+      uInt64 modified;
+      string md5;
+    };
+
+    // What was detected for an image
+    struct ImageEntry {
+      BSType type;
+      string layout;
+      Int32 ystart[2];   // NTSC and PAL, -1 if not known
+    };
+
+    void load();
+    ImageEntry& image(const string& md5);
+
+  private:
+    string myFilename;
+    bool myChanged;
+
+    std::map<string, FileEntry> myFiles;    // Indexed by full path
+    std::map<string, ImageEntry> myImages;  // Indexed by MD5
+
+  private:
+    // Following constructors and assignment operators not supported
+    RomInfoCache() = delete;
+    RomInfoCache(const RomInfoCache&) = delete;
+    RomInfoCache(RomInfoCache&&) = delete;
+    RomInfoCache& operator=(const RomInfoCache&) = delete;
+    RomInfoCache& operator=(RomInfoCache&&) = delete;
+};
+
+#endif
@@ -73,6 +73,8 @@ Settings::Settings(OSystem& osystem)
   setInternal("fragsize", "512");
   setInternal("freq", "31400");
   setInternal("volume", "100");
+  setInternal("audiobuffer", "fixed");
+  setExternal("wavfile", "");
 
   // Input event options
   setInternal("keymap", "");
@@ -140,6 +142,7 @@ Settings::Settings(OSystem& osystem)
   setInternal("dbg.fontstyle", "0");
   setInternal("dbg.uhex", "false");
   setInternal("dbg.ghostreadstrap", "true");
+  setInternal("dbg.armoverruntrap", "false");
   setInternal("dis.resolve", "true");
   setInternal("dis.gfxformat", "2");
   setInternal("dis.showaddr", "true");
@@ -164,6 +167,7 @@ Settings::Settings(OSystem& osystem)
   setInternal("plr.tm.horizon", "10m"); // = ~10 minutes
   // Thumb ARM emulation options
   setInternal("plr.thumb.trapfatal", "false");
+  setInternal("plr.thumb.cyclecount", "false");
   setInternal("plr.eepromaccess", "false");
 
   // developer settings
@@ -185,6 +189,7 @@ Settings::Settings(OSystem& osystem)
   setInternal("dev.tm.horizon", "10s"); // = ~10 seconds
   // Thumb ARM emulation options
   setInternal("dev.thumb.trapfatal", "true");
+  setInternal("dev.thumb.cyclecount", "true");
   setInternal("dev.eepromaccess", "true");
 }
 
@@ -364,6 +369,8 @@ void Settings::validate()
   i = getInt("freq");
   if(!(i == 11025 || i == 22050 || i == 31400 || i == 44100 || i == 48000))
     setInternal("freq", "31400");
+  s = getString("audiobuffer");
+  if(s != "fixed" && s != "adaptive")  setInternal("audiobuffer", "fixed");
 #endif
 
   i = getInt("joydeadzone");
@@ -447,8 +454,13 @@ void Settings::usage() const
     << "  -fragsize     <number>       The size of sound fragments (must be a power of two)\n"
     << "  -freq         <number>       Set sound sample output frequency (11025|22050|31400|44100|48000)\n"
     << "  -volume       <number>       Set the volume (0 - 100)\n"
+    << "  -audiobuffer  <fixed|adaptive> Keep a fixed amount of audio queued, or adapt\n"
+    << "                               it to the measured timing\n"
     << endl
   #endif
+    << "  -wavfile      <path>         Write all emulated sound to the given WAV file,\n"
+    << "                               instead of playing it\n"
+    << endl
     << "  -tia.zoom      <zoom>         Use the specified zoom level (windowed mode) for TIA image\n"
     << "  -tia.inter     <1|0>          Enable interpolated (smooth) scaling for TIA image\n"
     << "  -tia.aspectn   <number>       Scale TIA width by the given percentage in NTSC mode\n"
@@ -538,6 +550,7 @@ void Settings::usage() const
     << "                  large>\n"
     << "   -dbg.fontstyle <0-3>          Font style to use in debugger window (bold vs. normal)\n"
     << "   -dbg.ghostreadstrap <1|0>     Debugger traps on 'ghost' reads\n"
+    << "   -dbg.armoverruntrap <1|0>     Debugger traps on ARM code running past the end of the frame\n"
     << "   -dbg.uhex      <0|1>          lower-/uppercase HEX display\n"
     << "   -break         <address>      Set a breakpoint at 'address'\n"
     << "   -debug                        Start in debugger mode\n"
@@ -576,6 +589,7 @@ void Settings::usage() const
     << "  -plr.tv.jitter_recovery <1-20>   Set recovery time for TV jitter effect\n"
     << "  -plr.tiadriven    <1|0>          Drive unused TIA pins randomly on a read/peek\n"
     << "  -plr.thumb.trapfatal <1|0>       Determines whether errors in ARM emulation throw an exception\n"
+    << "  -plr.thumb.cyclecount <1|0>      Make the 6507 wait for the time ARM code takes to run\n"
     << "  -plr.eepromaccess <1|0>          Enable messages for AtariVox/SaveKey access messages\n"
     << endl
     << " The same parameters but for developer settings mode\n"
@@ -590,6 +604,7 @@ void Settings::usage() const
     << "  -dev.tv.jitter_recovery <1-20>   Set recovery time for TV jitter effect\n"
     << "  -dev.tiadriven    <1|0>          Drive unused TIA pins randomly on a read/peek\n"
     << "  -dev.thumb.trapfatal <1|0>       Determines whether errors in ARM emulation throw an exception\n"
+    << "  -dev.thumb.cyclecount <1|0>      Make the 6507 wait for the time ARM code takes to run\n"
     << "  -dev.eepromaccess <1|0>          Enable messages for AtariVox/SaveKey access messages\n"
     << endl << std::flush;
 }
@@ -39,6 +39,24 @@ class Sound : public Serializable
     Sound(OSystem& osystem) : myOSystem(osystem) { }
     virtual ~Sound() = default;
 
+    /**
+      Measurements of the audio buffering, for the frame stats overlay
+      and for scripts.  All times are in milliseconds.
+    */
+    struct Stats
+    {
+      uInt32 callbacks;        // Number of fragments requested by the device
+      uInt32 underruns;        // Number of those that ran out of samples
+      float queueDepth;        // Audio queued when the last fragment started
+      float targetDepth;       // Audio the queue is currently kept close to
+      float callbackInterval;  // Average time between fragment requests
+      float jitter;            // Average deviation from that time
+      bool adaptive;           // Whether the target is adjusted automatically
+
+      Stats() : callbacks(0), underruns(0), queueDepth(0), targetDepth(0),
+                callbackInterval(0), jitter(0), adaptive(false) { }
+    };
+
   public:
     /**
       Enables/disables the sound subsystem.
@@ -95,6 +113,15 @@ class Sound : public Serializable
     */
     virtual void set(uInt16 addr, uInt8 value, uInt64 cycle) = 0;
 
+    /**
+      Informs the sound device that a frame has been completed, so that
+      sound can be generated up to the given cycle even if no sound
+      registers were written.
+
+      @param cycle The system cycle at which the frame was completed
+    */
+    virtual void frameComplete(uInt64 cycle) = 0;
+
     /**
       Sets the volume of the sound device to the specified level.  The
       volume is given as a percentage from 0 to 100.  Values outside
@@ -112,6 +139,11 @@ class Sound : public Serializable
     */
     virtual void adjustVolume(Int8 direction) = 0;
 
+    /**
+      Answers the current audio buffering measurements.
+    */
+    virtual Stats stats() const = 0;
+
   protected:
     // The OSystem for this sound object
     OSystem& myOSystem;
@@ -36,7 +36,8 @@ System::System(const OSystem& osystem, M6502& m6502, M6532& m6532,
     myCycles(0),
     myDataBusState(0),
     myDataBusLocked(false),
-    mySystemInAutodetect(false)
+    mySystemInAutodetect(false),
+    mySystemHeadless(false)
 {
   // Re-initialize random generator
   randGenerator().initSeed();
@@ -48,6 +49,8 @@ System::System(const OSystem& osystem, M6502& m6502, M6532& m6532,
     myPageAccessTable[page] = access;
     myPageIsDirtyTable[page] = false;
   }
+  for(int window = 0; window < NUM_WINDOWS; ++window)
+    myWindowTable[window] = &myPageAccessTable[window * WINDOW_PAGES];
 
   // Bus starts out unlocked (in other words, peek() changes myDataBusState)
   myDataBusLocked = false;
@@ -88,6 +91,14 @@ void System::consoleChanged(ConsoleTiming timing)
   myCart.consoleChanged(timing);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void System::unmapWindow(uInt16 window)
+{
+  PageAccess* pages = &myPageAccessTable[window * WINDOW_PAGES];
+  std::copy_n(myWindowTable[window], WINDOW_PAGES, pages);
+  myWindowTable[window] = pages;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool System::isPageDirty(uInt16 start_addr, uInt16 end_addr) const
 {
@@ -140,7 +151,7 @@ uInt8 System::peek(uInt16 addr, uInt8 flags)
 void System::poke(uInt16 addr, uInt8 value, uInt8 flags)
 {
   uInt16 page = (addr & ADDRESS_MASK) >> PAGE_SHIFT;
-  const PageAccess& access = myPageAccessTable[page];
+  const PageAccess& access = pageAccess(page);
 
 #ifdef DEBUGGER_SUPPORT
   // Set access type
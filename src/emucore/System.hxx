@@ -68,6 +68,19 @@ class System : public Serializable
     // Number of pages in the system
     static constexpr uInt16 NUM_PAGES = 1 << (13 - PAGE_SHIFT);
 
+    // Amount to shift an address by to determine what window it's in; a
+    // window is the unit in which precomputed pages are mapped (see mapPages)
+    static constexpr uInt16 WINDOW_SHIFT = 10;
+
+    // Size of a window
+    static constexpr uInt16 WINDOW_SIZE = (1 << WINDOW_SHIFT);
+
+    // Number of pages in a window
+    static constexpr uInt16 WINDOW_PAGES = WINDOW_SIZE / PAGE_SIZE;
+
+    // Number of windows in the system
+    static constexpr uInt16 NUM_WINDOWS = 1 << (13 - WINDOW_SHIFT);
+
   public:
     /**
       Initialize system and all attached devices to known state.
@@ -160,6 +173,13 @@ class System : public Serializable
     */
     bool autodetectMode() const { return mySystemInAutodetect; }
 
+    /**
+      Answers whether the system belongs to a headless console, which has
+      no debugger attached to it.
+    */
+    bool headless() const { return mySystemHeadless; }
+    void setHeadless(bool headless) { mySystemHeadless = headless; }
+
   public:
     /**
       Get the current state of the data bus in the system.  The current
@@ -260,7 +280,7 @@ class System : public Serializable
         to this page, while other values are the base address of an array
         to directly access for reads to this page.
       */
-      uInt8* directPeekBase;
+      const uInt8* directPeekBase;
 
       /**
         Pointer to a block of memory or the null pointer.  The null pointer
@@ -314,7 +334,28 @@ class System : public Serializable
       @param access The accessing methods to be used by the page
     */
     void setPageAccess(uInt16 addr, const PageAccess& access) {
-      myPageAccessTable[(addr & ADDRESS_MASK) >> PAGE_SHIFT] = access;
+      const uInt16 page = (addr & ADDRESS_MASK) >> PAGE_SHIFT;
+      const uInt16 window = page / WINDOW_PAGES;
+      if(myWindowTable[window] != &myPageAccessTable[window * WINDOW_PAGES])
+        unmapWindow(window);
+      myPageAccessTable[page] = access;
+    }
+
+    /**
+      Map precomputed accessing methods for a range of pages, replacing
+      whatever was set there.  Only the pointers are stored, so this is much
+      faster than setting each page; devices which switch banks often should
+      prepare the pages for each bank in advance, and map them here.
+
+      @param addr   The first address, which must be at the start of a window
+      @param pages  The accessing methods for all pages in the range; these
+                    must remain valid as long as they're mapped
+      @param size   The size of the range, a multiple of the window size
+    */
+    void mapPages(uInt16 addr, const PageAccess* pages, uInt16 size) {
+      uInt16 window = (addr & ADDRESS_MASK) >> WINDOW_SHIFT;
+      for(uInt16 i = 0; i < size; i += WINDOW_SIZE, pages += WINDOW_PAGES)
+        myWindowTable[window++] = pages;
     }
 
     /**
@@ -324,7 +365,7 @@ class System : public Serializable
       @return The accessing methods used by the page
     */
     const PageAccess& getPageAccess(uInt16 addr) const {
-      return myPageAccessTable[(addr & ADDRESS_MASK) >> PAGE_SHIFT];
+      return pageAccess((addr & ADDRESS_MASK) >> PAGE_SHIFT);
     }
 
     /**
@@ -334,7 +375,7 @@ class System : public Serializable
       @return  The type of page that contains the given address
     */
     System::PageAccessType getPageAccessType(uInt16 addr) const {
-      return myPageAccessTable[(addr & ADDRESS_MASK) >> PAGE_SHIFT].type;
+      return getPageAccess(addr).type;
     }
 
     /**
@@ -383,6 +424,16 @@ class System : public Serializable
     */
     string name() const override { return "System"; }
 
+  private:
+    // The accessing methods of the given page
+    const PageAccess& pageAccess(uInt16 page) const {
+      return myWindowTable[page / WINDOW_PAGES][page % WINDOW_PAGES];
+    }
+
+    // Copy the pages mapped into the given window to the page access table,
+    // so that they can be set individually again
+    void unmapWindow(uInt16 window);
+
   private:
     const OSystem& myOSystem;
 
@@ -404,9 +455,13 @@ class System : public Serializable
     // Null device to use for page which are not installed
     NullDevice myNullDevice;
 
-    // The list of PageAccess structures
+    // The list of PageAccess structures set with setPageAccess()
     PageAccess myPageAccessTable[NUM_PAGES];
 
+    // The pages in use for each window; either the corresponding part of
+    // myPageAccessTable, or pages mapped with mapPages()
+    const PageAccess* myWindowTable[NUM_WINDOWS];
+
     // The list of dirty pages
     bool myPageIsDirtyTable[NUM_PAGES];
 
@@ -423,6 +478,10 @@ class System : public Serializable
     // Some parts of the codebase need to act differently in such a case
     bool mySystemInAutodetect;
 
+    // Whether the system belongs to a headless console (eg, a launcher
+    // preview); devices must never report to the debugger in that case
+    bool mySystemHeadless;
+
   private:
     // Following constructors and assignment operators not supported
     System() = delete;
@@ -36,11 +36,12 @@ void TIASound::reset()
   polyInit(Bit4, 4, 4, 3);
   polyInit(Bit5, 5, 5, 3);
   polyInit(Bit9, 9, 9, 5);
+  clockInit();
 
   // Initialize instance variables
   for(int chan = 0; chan <= 1; ++chan)
   {
-    myVolume[chan] = 0;
+    myOutput[chan] = 0;
     myDivNCnt[chan] = 0;
     myDivNMax[chan] = 0;
     myDiv3Cnt[chan] = 3;
@@ -111,7 +112,7 @@ void TIASound::set(uInt16 address, uInt8 value)
     // Indicate the clock is zero so no processing will occur,
     // and set the output to the selected volume
     newVal = 0;
-    myVolume[chan] = (myAUDV[chan] * myVolumePercentage) / 100;
+    myOutput[chan] = 1;
   }
   else
   {
@@ -161,209 +162,183 @@ void TIASound::volume(uInt32 percent)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIASound::process(Int16* buffer, uInt32 samples)
 {
-  // Make temporary local copy
-  uInt8 audc0 = myAUDC[0], audc1 = myAUDC[1];
-  uInt8 p5_0 = myP5[0], p5_1 = myP5[1];
-  uInt8 div_n_cnt0 = myDivNCnt[0], div_n_cnt1 = myDivNCnt[1];
-  Int16 v0 = myVolume[0], v1 = myVolume[1];
-
-  // Take external volume into account
-  Int16 audv0 = (myAUDV[0] * myVolumePercentage) / 100,
-        audv1 = (myAUDV[1] * myVolumePercentage) / 100;
-
-  // Loop until the sample buffer is full
   while(samples > 0)
   {
-    // Process channel 0
-    if (div_n_cnt0 > 1)
+    // Work out how many TIA ticks are needed for the remaining samples;
+    // at the native frequency this is exactly one per sample
+    uInt32 ticks = samples;
+    if(myOutputFrequency != 31400)
+      ticks = uInt32(std::max<Int64>(1, (Int64(samples) * 31400 - myOutputCounter +
+                                         myOutputFrequency - 1) / myOutputFrequency));
+    ticks = std::min<uInt32>(ticks, BLOCK_SIZE);
+
+    generate(0, ticks);
+    generate(1, ticks);
+
+    if(myOutputFrequency == 31400)
     {
-      div_n_cnt0--;
+      mix(buffer, ticks);
+      buffer += myChannelMode == Hardware1 ? ticks : ticks * 2;
+      samples -= ticks;
     }
-    else if (div_n_cnt0 == 1)
+    else
     {
-      int prev_bit5 = Bit5[p5_0];
-      div_n_cnt0 = myDivNMax[0];
-
-      // The P5 counter has multiple uses, so we increment it here
-      p5_0++;
-      if (p5_0 == POLY5_SIZE)
-        p5_0 = 0;
-
-      // Check clock modifier for clock tick
-      if ((audc0 & 0x02) == 0 ||
-         ((audc0 & 0x01) == 0 && Div31[p5_0]) ||
-         ((audc0 & 0x01) == 1 && Bit5[p5_0]) ||
-         ((audc0 & 0x0f) == POLY5_DIV3 && Bit5[p5_0] != prev_bit5))
+      // Take external volume into account
+      const Int16 audv0 = (myAUDV[0] * myVolumePercentage) / 100,
+                  audv1 = (myAUDV[1] * myVolumePercentage) / 100;
+
+      for(uInt32 i = 0; i < ticks; ++i)
       {
-        if (audc0 & 0x04)       // Pure modified clock selected
-        {
-          if ((audc0 & 0x0f) == POLY5_DIV3) // POLY5 -> DIV3 mode
-          {
-            if ( Bit5[p5_0] != prev_bit5 )
-            {
-              myDiv3Cnt[0]--;
-              if ( !myDiv3Cnt[0] )
-              {
-                myDiv3Cnt[0] = 3;
-                v0 = v0 ? 0 : audv0;
-              }
-            }
-          }
-          else
-          {
-            // If the output was set turn it off, else turn it on
-            v0 = v0 ? 0 : audv0;
-          }
-        }
-        else if (audc0 & 0x08)  // Check for p5/p9
-        {
-          if (audc0 == POLY9)   // Check for poly9
-          {
-            // Increase the poly9 counter
-            myP9[0]++;
-            if (myP9[0] == POLY9_SIZE)
-              myP9[0] = 0;
+        const Int16 v0 = myBits[0][i] ? audv0 : 0,
+                    v1 = myBits[1][i] ? audv1 : 0;
 
-            v0 = Bit9[myP9[0]] ? audv0 : 0;
-          }
-          else if ( audc0 & 0x02 )
-          {
-            v0 = (v0 || audc0 & 0x01) ? 0 : audv0;
-          }
-          else  // Must be poly5
+        myOutputCounter += myOutputFrequency;
+        while((samples > 0) && (myOutputCounter >= 31400))
+        {
+          switch(myChannelMode)
           {
-            v0 = Bit5[p5_0] ? audv0 : 0;
+            case Hardware2Mono:  // mono sampling with 2 hardware channels
+              *(buffer++) = v0 + v1;
+              *(buffer++) = v0 + v1;
+              break;
+
+            case Hardware2Stereo:  // stereo sampling with 2 hardware channels
+              *(buffer++) = v0;
+              *(buffer++) = v1;
+              break;
+
+            case Hardware1:  // mono/stereo sampling with only 1 hardware channel
+              *(buffer++) = v0 + v1;
+              break;
           }
-        }
-        else  // Poly4 is the only remaining option
-        {
-          // Increase the poly4 counter
-          myP4[0]++;
-          if (myP4[0] == POLY4_SIZE)
-            myP4[0] = 0;
-
-          v0 = Bit4[myP4[0]] ? audv0 : 0;
+          myOutputCounter -= 31400;
+          samples--;
         }
       }
     }
+  }
+}
 
-    // Process channel 1
-    if (div_n_cnt1 > 1)
-    {
-      div_n_cnt1--;
-    }
-    else if (div_n_cnt1 == 1)
-    {
-      int prev_bit5 = Bit5[p5_1];
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIASound::generate(int chan, uInt32 ticks)
+{
+  uInt8* bits = myBits[chan];
+  uInt8& divNCnt = myDivNCnt[chan];
 
-      div_n_cnt1 = myDivNMax[1];
+  // A counter of zero means the channel is volume only
+  if(divNCnt == 0)
+  {
+    memset(bits, myOutput[chan], ticks);
+    return;
+  }
 
-      // The P5 counter has multiple uses, so we increment it here
-      p5_1++;
-      if (p5_1 == POLY5_SIZE)
-        p5_1 = 0;
+  uInt32 pos = 0;
+  for(;;)
+  {
+    // The output can't change until the divide-by-N counter expires
+    const uInt32 run = std::min<uInt32>(divNCnt - 1, ticks - pos);
+    memset(bits + pos, myOutput[chan], run);
+    pos += run;
+    divNCnt -= run;
+    if(pos == ticks)
+      break;
 
-      // Check clock modifier for clock tick
-      if ((audc1 & 0x02) == 0 ||
-         ((audc1 & 0x01) == 0 && Div31[p5_1]) ||
-         ((audc1 & 0x01) == 1 && Bit5[p5_1]) ||
-         ((audc1 & 0x0f) == POLY5_DIV3 && Bit5[p5_1] != prev_bit5))
-      {
-        if (audc1 & 0x04)       // Pure modified clock selected
-        {
-          if ((audc1 & 0x0f) == POLY5_DIV3)   // POLY5 -> DIV3 mode
-          {
-            if ( Bit5[p5_1] != prev_bit5 )
-            {
-              myDiv3Cnt[1]--;
-              if ( ! myDiv3Cnt[1] )
-              {
-                myDiv3Cnt[1] = 3;
-                v1 = v1 ? 0 : audv1;
-              }
-            }
-          }
-          else
-          {
-            // If the output was set turn it off, else turn it on
-            v1 = v1 ? 0 : audv1;
-          }
-        }
-        else if (audc1 & 0x08)  // Check for p5/p9
-        {
-          if (audc1 == POLY9)   // Check for poly9
-          {
-            // Increase the poly9 counter
-            myP9[1]++;
-            if (myP9[1] == POLY9_SIZE)
-              myP9[1] = 0;
+    // The counter expires on this tick
+    clock(chan);
+    divNCnt = myDivNMax[chan];
+    bits[pos++] = myOutput[chan];
+    if(pos == ticks)
+      break;
+  }
+}
 
-            v1 = Bit9[myP9[1]] ? audv1 : 0;
-          }
-          else if ( audc1 & 0x02 )
-          {
-            v1 = (v1 || audc1 & 0x01) ? 0 : audv1;
-          }
-          else  // Must be poly5
-          {
-            v1 = Bit5[p5_1] ? audv1 : 0;
-          }
-        }
-        else  // Poly4 is the only remaining option
-        {
-          // Increase the poly4 counter
-          myP4[1]++;
-          if (myP4[1] == POLY4_SIZE)
-            myP4[1] = 0;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIASound::clock(int chan)
+{
+  const uInt8 audc = myAUDC[chan];
+  const uInt8 prev_bit5 = Bit5[myP5[chan]];
 
-          v1 = Bit4[myP4[1]] ? audv1 : 0;
-        }
-      }
-    }
+  // The P5 counter has multiple uses, so we increment it here
+  if(++myP5[chan] == POLY5_SIZE)
+    myP5[chan] = 0;
+  const uInt8 p5 = myP5[chan];
 
-    myOutputCounter += myOutputFrequency;
+  // Check clock modifier for clock tick
+  if(!myClocks[audc][p5])
+    return;
 
-    switch(myChannelMode)
+  uInt8& out = myOutput[chan];
+  if(audc & 0x04)       // Pure modified clock selected
+  {
+    if(audc == POLY5_DIV3)  // POLY5 -> DIV3 mode
     {
-      case Hardware2Mono:  // mono sampling with 2 hardware channels
-        while((samples > 0) && (myOutputCounter >= 31400))
-        {
-          Int16 byte = v0 + v1;
-          *(buffer++) = byte;
-          *(buffer++) = byte;
-          myOutputCounter -= 31400;
-          samples--;
-        }
-        break;
-
-      case Hardware2Stereo:  // stereo sampling with 2 hardware channels
-        while((samples > 0) && (myOutputCounter >= 31400))
-        {
-          *(buffer++) = v0;
-          *(buffer++) = v1;
-          myOutputCounter -= 31400;
-          samples--;
-        }
-        break;
+      if(Bit5[p5] != prev_bit5 && --myDiv3Cnt[chan] == 0)
+      {
+        myDiv3Cnt[chan] = 3;
+        out ^= 1;
+      }
+    }
+    else
+    {
+      // If the output was set turn it off, else turn it on
+      out ^= 1;
+    }
+  }
+  else if(audc & 0x08)  // Check for p5/p9
+  {
+    if(audc == POLY9)   // Check for poly9
+    {
+      // Increase the poly9 counter
+      if(++myP9[chan] == POLY9_SIZE)
+        myP9[chan] = 0;
 
-      case Hardware1:  // mono/stereo sampling with only 1 hardware channel
-        while((samples > 0) && (myOutputCounter >= 31400))
-        {
-          *(buffer++) = v0 + v1;
-          myOutputCounter -= 31400;
-          samples--;
-        }
-        break;
+      out = Bit9[myP9[chan]];
     }
+    else if(audc & 0x02)
+      out = (out || (audc & 0x01)) ? 0 : 1;
+    else  // Must be poly5
+      out = Bit5[p5];
   }
+  else  // Poly4 is the only remaining option
+  {
+    // Increase the poly4 counter
+    if(++myP4[chan] == POLY4_SIZE)
+      myP4[chan] = 0;
 
-  // Save for next round
-  myP5[0] = p5_0;
-  myP5[1] = p5_1;
-  myVolume[0] = v0;
-  myVolume[1] = v1;
-  myDivNCnt[0] = div_n_cnt0;
-  myDivNCnt[1] = div_n_cnt1;
+    out = Bit4[myP4[chan]];
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIASound::mix(Int16* buffer, uInt32 ticks) const
+{
+  // Take external volume into account
+  const Int16 audv0 = (myAUDV[0] * myVolumePercentage) / 100,
+              audv1 = (myAUDV[1] * myVolumePercentage) / 100;
+  const uInt8* bits0 = myBits[0];
+  const uInt8* bits1 = myBits[1];
+
+  // These loops are branch-free, so the compiler can vectorize them
+  switch(myChannelMode)
+  {
+    case Hardware2Mono:  // mono sampling with 2 hardware channels
+      for(uInt32 i = 0; i < ticks; ++i)
+        buffer[i*2] = buffer[i*2+1] = bits0[i] * audv0 + bits1[i] * audv1;
+      break;
+
+    case Hardware2Stereo:  // stereo sampling with 2 hardware channels
+      for(uInt32 i = 0; i < ticks; ++i)
+      {
+        buffer[i*2]   = bits0[i] * audv0;
+        buffer[i*2+1] = bits1[i] * audv1;
+      }
+      break;
+
+    case Hardware1:  // mono/stereo sampling with only 1 hardware channel
+      for(uInt32 i = 0; i < ticks; ++i)
+        buffer[i] = bits0[i] * audv0 + bits1[i] * audv1;
+      break;
+  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -381,6 +356,24 @@ void TIASound::polyInit(uInt8* poly, int size, int f0, int f1)
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIASound::clockInit()
+{
+  for(int audc = 0; audc < 16; ++audc)
+  {
+    for(int p5 = 0; p5 < POLY5_SIZE; ++p5)
+    {
+      const uInt8 prev_bit5 = Bit5[(p5 + POLY5_SIZE - 1) % POLY5_SIZE];
+
+      myClocks[audc][p5] =
+          (audc & 0x02) == 0 ||
+          ((audc & 0x01) == 0 && Div31[p5]) ||
+          ((audc & 0x01) == 1 && Bit5[p5]) ||
+          (audc == POLY5_DIV3 && Bit5[p5] != prev_bit5);
+    }
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 const uInt8 TIASound::Div31[POLY5_SIZE] = {
   0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
@@ -27,6 +27,13 @@
   Currently, the sound generation routines work at 31400Hz only.
   Resampling can be done by passing in a different output frequency.
 
+  Each channel's output only changes when its divide-by-N counter
+  expires, so samples are generated as runs of a constant output bit
+  (one memset per run) into a per-channel buffer, and the clocking of
+  the polynomial counters is looked up from precomputed tables.  The
+  final pass scales each channel's bits by its volume and mixes them
+  into the output buffer.
+
   @author  Bradford W. Mott, Stephen Anthony, z26 and MESS teams
 */
 class TIASound
@@ -37,6 +44,14 @@ class TIASound
     */
     TIASound(Int32 outputFrequency = 31400);
 
+  public:
+    // The TIA clocks its audio circuits twice per scanline (every 38 CPU
+    // cycles), which gives the native sample rate of ~31.4 kHz
+    enum {
+      CYCLES_PER_SAMPLE = 38,
+      NATIVE_FREQUENCY  = 31400
+    };
+
   public:
     /**
       Reset the sound emulation to its power-on state
@@ -94,6 +109,29 @@ class TIASound
   private:
     void polyInit(uInt8* poly, int size, int f0, int f1);
 
+    /**
+      Build the table of which P5 counter positions clock each AUDC mode.
+    */
+    void clockInit();
+
+    /**
+      Generate the output bits for the given channel, for the given number
+      of TIA ticks, into the channel's bit buffer.
+    */
+    void generate(int chan, uInt32 ticks);
+
+    /**
+      Clock the given channel once (its divide-by-N counter has expired),
+      updating its polynomial counters and output bit.
+    */
+    void clock(int chan);
+
+    /**
+      Mix the channel bit buffers into the output buffer, one sample
+      per tick (the output frequency is the native frequency).
+    */
+    void mix(Int16* buffer, uInt32 ticks) const;
+
   private:
     // Definitions for AUDCx (15, 16)
     enum AUDCxRegister
@@ -121,8 +159,9 @@ class TIASound
       POLY5_SIZE = 0x001f,
       POLY9_SIZE = 0x01ff,
       DIV3_MASK  = 0x0c,
-      AUDV_SHIFT = 10     // shift 2 positions for AUDV,
+      AUDV_SHIFT = 10,    // shift 2 positions for AUDV,
                           // then another 8 for 16-bit sound
+      BLOCK_SIZE = 512    // Number of ticks generated per pass
     };
 
     enum ChannelMode {
@@ -137,7 +176,7 @@ class TIASound
     uInt8 myAUDF[2];    // AUDFx (17, 18)
     Int16 myAUDV[2];    // AUDVx (19, 1A)
 
-    Int16 myVolume[2];  // Last output volume for each channel
+    uInt8 myOutput[2];  // Current output bit for each channel
 
     uInt8 myP4[2];      // Position pointer for the 4-bit POLY array
     uInt8 myP5[2];      // Position pointer for the 5-bit POLY array
@@ -164,6 +203,15 @@ class TIASound
     uInt8 Bit5[POLY5_SIZE];
     uInt8 Bit9[POLY9_SIZE];
 
+    /*
+      Whether each AUDC mode clocks its output, indexed by the position of
+      the P5 counter after it has been advanced.
+    */
+    bool myClocks[16][POLY5_SIZE];
+
+    // Output bits of each channel for the block currently being generated
+    uInt8 myBits[2][BLOCK_SIZE];
+
     /*
       The 'Div by 31' counter is treated as another polynomial because of
       the way it operates.  It does not have a 50% duty cycle, but instead
@@ -59,29 +59,167 @@ Thumbulator::Thumbulator(const uInt16* rom_ptr, uInt16* ram_ptr, bool traponfata
     ram(ram_ptr),
     T1TCR(0),
     T1TC(0),
+    profiling(false),
     configuration(configurefor),
     myCartridge(cartridge)
 {
+  // The ROM only changes when patched (see romChanged()), so all of it is
+  // decoded up front
+  for(uInt32 addr = 0; addr < ROMSIZE / 2; ++addr)
+  {
+    uInt16 inst = CONV_RAMROM(rom[addr]);
+    decodedRom[addr] = decodeInstructionWord(inst);
+  }
+  std::fill_n(decodedRamInst, RAMSIZE / 2, 0);
+  std::fill_n(decodedRam, RAMSIZE / 2, decodeInstructionWord(0));
+
   setConsoleTiming(ConsoleTiming::ntsc);
   trapFatalErrors(traponfatal);
   reset();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-string Thumbulator::run()
+void Thumbulator::run()
 {
   reset();
-  for(;;)
+
+  // Messages are only kept until the next call; checking first means the
+  // (usual) empty stream is left alone
+  if(statusMsg.tellp() != 0)
+    statusMsg.str("");
+
+  switch(configuration)
   {
-    if(execute()) break;
-    if(instructions > 500000) // way more than would otherwise be possible
-      throw runtime_error("instructions > 500000");
+    case ConfigureFor::BUS:
+      profiling ? runInstructions<ConfigureFor::BUS, true>()
+                : runInstructions<ConfigureFor::BUS, false>();
+      break;
+    case ConfigureFor::CDF:
+      profiling ? runInstructions<ConfigureFor::CDF, true>()
+                : runInstructions<ConfigureFor::CDF, false>();
+      break;
+    case ConfigureFor::CDF1:
+      profiling ? runInstructions<ConfigureFor::CDF1, true>()
+                : runInstructions<ConfigureFor::CDF1, false>();
+      break;
+    case ConfigureFor::DPCplus:
+      profiling ? runInstructions<ConfigureFor::DPCplus, true>()
+                : runInstructions<ConfigureFor::DPCplus, false>();
+      break;
+  }
+  if(profiling)
+  {
+    Profile& p = *profile_data;
+    if(p.calls.size() == PROFILE_CALLS)
+      p.calls.erase(p.calls.begin(), p.calls.begin() + PROFILE_CALLS / 2);
+    p.calls.push_back({ uInt32(instructions), uInt32(arm_cycles) });
+    p.callCount++;
+    p.instructions += instructions;
+    p.cycles += arm_cycles;
   }
 #if defined(THUMB_DISS) || defined(THUMB_DBUG)
   dump_counters();
   cout << statusMsg.str() << endl;
 #endif
-  return statusMsg.str();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<Thumbulator::ConfigureFor C, bool PROFILE>
+void Thumbulator::runInstructions()
+{
+  for(;;)
+  {
+    uInt32 pc = read_register(15);
+    uInt64 start = arm_cycles;
+    bool done = execute<C>();
+
+    // A taken branch refills the pipeline, and (unless the MAM is fully
+    // enabled) the buffered flash line can't be used for the next fetch
+    if(read_register(15) != pc + 2)
+    {
+      arm_cycles += 2;
+      if(mamcr != 2) fetch_line = ~0u;
+      prefetch_line = ~0u;
+    }
+
+    if(PROFILE)
+    {
+      // The instruction executed was fetched from pc - 2
+      ProfileCounter* counter = nullptr;
+      switch((pc - 2) & 0xF0000000)
+      {
+        case 0x00000000: //ROM
+          counter = &profile_data->rom[((pc - 2) & ROMADDMASK) >> 1];
+          break;
+        case 0x40000000: //RAM
+          counter = &profile_data->ram[((pc - 2) & RAMADDMASK) >> 1];
+          break;
+      }
+      if(counter)
+      {
+        counter->count++;
+        counter->cycles += arm_cycles - start;
+      }
+    }
+
+    if(done) break;
+    if(instructions > 500000) // way more than would otherwise be possible
+      throw runtime_error("instructions > 500000");
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Thumbulator::enableProfiling(bool enable)
+{
+  if(enable && !profile_data)
+  {
+    profile_data = make_unique<Profile>();
+    resetProfile();
+  }
+  profiling = enable;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Thumbulator::resetProfile()
+{
+  if(!profile_data)
+    return;
+
+  Profile& p = *profile_data;
+  p.rom.assign(ROMSIZE / 2, ProfileCounter{ 0, 0 });
+  p.ram.assign(RAMSIZE / 2, ProfileCounter{ 0, 0 });
+  p.calls.clear();
+  p.calls.reserve(PROFILE_CALLS);
+  p.callCount = p.instructions = p.cycles = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+vector<Thumbulator::HotSpot> Thumbulator::hotSpots(uInt32 max) const
+{
+  vector<HotSpot> spots;
+  if(!profile_data)
+    return spots;
+
+  for(uInt32 i = 0; i < ROMSIZE / 2; ++i)
+    if(profile_data->rom[i].count)
+      spots.push_back({ i << 1, profile_data->rom[i] });
+  for(uInt32 i = 0; i < RAMSIZE / 2; ++i)
+    if(profile_data->ram[i].count)
+      spots.push_back({ 0x40000000 | (i << 1), profile_data->ram[i] });
+
+  auto hotter = [](const HotSpot& a, const HotSpot& b) {
+    return a.counter.cycles > b.counter.cycles ||
+          (a.counter.cycles == b.counter.cycles && a.address < b.address);
+  };
+  if(spots.size() > max)
+  {
+    std::partial_sort(spots.begin(), spots.begin() + max, spots.end(), hotter);
+    spots.resize(max);
+  }
+  else
+    std::sort(spots.begin(), spots.end(), hotter);
+
+  return spots;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -100,6 +238,16 @@ void Thumbulator::setConsoleTiming(ConsoleTiming timing)
     case ConsoleTiming::pal:    timing_factor = PAL;    break;
   }
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Thumbulator::romChanged(uInt32 offset)
+{
+  if(offset >= ROMSIZE)
+    return;
+
+  uInt16 inst = CONV_RAMROM(rom[offset >> 1]);
+  decodedRom[offset >> 1] = decodeInstructionWord(inst);
+}
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Thumbulator::updateTimer(uInt32 cycles)
 {
@@ -108,10 +256,10 @@ void Thumbulator::updateTimer(uInt32 cycles)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-string Thumbulator::run(uInt32 cycles)
+void Thumbulator::run(uInt32 cycles)
 {
   updateTimer(cycles);
-  return run();
+  run();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -177,12 +325,23 @@ uInt32 Thumbulator::fetch16(uInt32 addr)
       if(addr < 0x50)
         fatalError("fetch16", addr, "abort");
 
+      // Sequential code is served from the MAM buffers (and with the MAM
+      // fully enabled, the next line is prefetched), otherwise the flash
+      // line has to be read
+      if(mamcr != 0 && ((addr >> 4) == fetch_line || (addr >> 4) == prefetch_line))
+        arm_cycles += 1;
+      else
+        arm_cycles += FLASH_CYCLES;
+      fetch_line = addr >> 4;
+      prefetch_line = mamcr == 2 ? fetch_line + 1 : ~0u;
+
       addr >>= 1;
       data = CONV_RAMROM(rom[addr]);
       DO_DBUG(statusMsg << "fetch16(" << Base::HEX8 << addr << ")=" << Base::HEX4 << data << endl);
       return data;
 
     case 0x40000000: //RAM
+      arm_cycles += 1;
       addr &= RAMADDMASK;
       addr >>= 1;
       data=CONV_RAMROM(ram[addr]);
@@ -219,17 +378,19 @@ uInt32 Thumbulator::fetch32(uInt32 addr)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void Thumbulator::write16(uInt32 addr, uInt32 data)
+template<Thumbulator::ConfigureFor C>
+void Thumbulator::write16(uInt32 addr, uInt32 data, bool charge)
 {
   if((addr > 0x40001fff) && (addr < 0x50000000))
     fatalError("write16", addr, "abort - out of range");
 
-  if (isProtected(addr)) fatalError("write16", addr, "to driver area");
+  if (isProtected<C>(addr)) fatalError("write16", addr, "to driver area");
 
   if(addr & 1)
     fatalError("write16", addr, "abort - misaligned");
 
   writes++;
+  if(charge) arm_cycles += 1;
 
   DO_DBUG(statusMsg << "write16(" << Base::HEX8 << addr << "," << Base::HEX8 << data << ")" << endl);
 
@@ -253,12 +414,14 @@ void Thumbulator::write16(uInt32 addr, uInt32 data)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<Thumbulator::ConfigureFor C>
 void Thumbulator::write32(uInt32 addr, uInt32 data)
 {
   if(addr & 3)
     fatalError("write32", addr, "abort - misaligned");
 
-  if (isProtected(addr)) fatalError("write32", addr, "to driver area");
+  if (isProtected<C>(addr)) fatalError("write32", addr, "to driver area");
+  arm_cycles += 1;
   DO_DBUG(statusMsg << "write32(" << Base::HEX8 << addr << "," << Base::HEX8 << data << ")" << endl);
 
   switch(addr & 0xF0000000)
@@ -327,20 +490,21 @@ void Thumbulator::write32(uInt32 addr, uInt32 data)
       return;
 
     case 0x40000000: //RAM
-      write16(addr+0, (data >>  0) & 0xFFFF);
-      write16(addr+2, (data >> 16) & 0xFFFF);
+      write16<C>(addr+0, (data >>  0) & 0xFFFF, false);
+      write16<C>(addr+2, (data >> 16) & 0xFFFF, false);
       return;
   }
   fatalError("write32", addr, data, "abort");
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<Thumbulator::ConfigureFor C>
 bool Thumbulator::isProtected(uInt32 addr)
 {
   if (addr < 0x40000000) return false;
   addr -= 0x40000000;
 
-  switch (configuration) {
+  switch (C) {
     case ConfigureFor::DPCplus:
       return (addr < 0x0c00) && (addr > 0x0028);
 
@@ -358,7 +522,7 @@ bool Thumbulator::isProtected(uInt32 addr)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt32 Thumbulator::read16(uInt32 addr)
+uInt32 Thumbulator::read16(uInt32 addr, bool charge)
 {
   uInt32 data;
 
@@ -370,6 +534,19 @@ uInt32 Thumbulator::read16(uInt32 addr)
     fatalError("read16", addr, "abort - misaligned");
 
   reads++;
+  if(charge)
+  {
+    // Flash data is latched by the MAM (when enabled), one line at a time
+    if((addr & 0xF0000000) != 0x00000000)
+      arm_cycles += 1;
+    else if(mamcr != 0 && ((addr & ROMADDMASK) >> 4) == data_line)
+      arm_cycles += 1;
+    else
+    {
+      arm_cycles += FLASH_CYCLES;
+      data_line = mamcr != 0 ? (addr & ROMADDMASK) >> 4 : ~0u;
+    }
+  }
 
   switch(addr & 0xF0000000)
   {
@@ -409,12 +586,13 @@ uInt32 Thumbulator::read32(uInt32 addr)
     case 0x00000000: //ROM
     case 0x40000000: //RAM
       data = read16(addr+0);
-      data |= (uInt32(read16(addr+2))) << 16;
+      data |= (uInt32(read16(addr+2, false))) << 16;
       DO_DBUG(statusMsg << "read32(" << Base::HEX8 << addr << ")=" << Base::HEX8 << data << endl);
       return data;
 
     case 0xE0000000:
     {
+      arm_cycles += 1;
       switch(addr)
       {
         case 0xE0008004:  // T1TCR - Timer 1 Control Register
@@ -527,1791 +705,2129 @@ void Thumbulator::do_vflag_bit(uInt32 x)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-int Thumbulator::execute()
+Thumbulator::Op Thumbulator::decodeInstructionWord(uInt16 inst)
 {
-  uInt32 pc, sp, inst, ra, rb, rc, rm, rd, rn, rs, op;
-
-  pc = read_register(15);
-
-#if 0
-  if(handler_mode)
-  {
-    if((pc & 0xF0000000) == 0xF0000000)
-    {
-      uInt32 sp = read_register(13);
-      handler_mode = false;
-      write_register(0,  read32(sp)); sp += 4;
-      write_register(1,  read32(sp)); sp += 4;
-      write_register(2,  read32(sp)); sp += 4;
-      write_register(3,  read32(sp)); sp += 4;
-      write_register(12, read32(sp)); sp += 4;
-      write_register(14, read32(sp)); sp += 4;
-      pc = read32(sp); sp += 4;
-      cpsr = read32(sp); sp += 4;
-      write_register(13, sp);
-    }
-  }
-  if(systick_ctrl & 1)
-  {
-    if(systick_count)
-    {
-      systick_count--;
-    }
-    else
-    {
-      systick_count = systick_reload;
-      systick_ctrl |= 0x00010000;
-    }
-  }
-
-  if((systick_ctrl & 3) == 3)
-  {
-    if(systick_ctrl & 0x00010000)
-    {
-      if(!handler_mode)
-      {
-        systick_ints++;
-        uInt32 sp = read_register(13);
-        sp -= 4; write32(sp, cpsr);
-        sp -= 4; write32(sp, pc);
-        sp -= 4; write32(sp, read_register(14));
-        sp -= 4; write32(sp, read_register(12));
-        sp -= 4; write32(sp, read_register(3));
-        sp -= 4; write32(sp, read_register(2));
-        sp -= 4; write32(sp, read_register(1));
-        sp -= 4; write32(sp, read_register(0));
-        write_register(13, sp);
-        pc = fetch32(0x0000003C); //systick vector
-        pc += 2;
-        //write_register(14, 0xFFFFFF00);
-        write_register(14, 0xFFFFFFF9);
-
-        handler_mode = true;
-      }
-    }
-  }
-#endif
-
-  inst = fetch16(pc-2);
-  pc += 2;
-  write_register(15, pc);
-  DO_DISS(statusMsg << Base::HEX8 << (pc-5) << ": " << Base::HEX4 << inst << " ");
-
-  instructions++;
+  // The order of these tests matters, since some patterns overlap
 
   //ADC
   if((inst & 0xFFC0) == 0x4140)
-  {
-    rd = (inst >> 0) & 0x07;
-    rm = (inst >> 3) & 0x07;
-    DO_DISS(statusMsg << "adc r" << dec << rd << ",r" << dec << rm << endl);
-    ra = read_register(rd);
-    rb = read_register(rm);
-    rc = ra + rb;
-    if(cpsr & CPSR_C)
-      rc++;
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    if(cpsr & CPSR_C) { do_cflag(ra, rb, 1); do_vflag(ra, rb, 1); }
-    else              { do_cflag(ra, rb, 0); do_vflag(ra, rb, 0); }
-    return 0;
-  }
+    return Op::adc;
 
   //ADD(1) small immediate two registers
-  if((inst & 0xFE00) == 0x1C00)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    rb = (inst >> 6) & 0x7;
-    if(rb)
-    {
-      DO_DISS(statusMsg << "adds r" << dec << rd << ",r" << dec << rn << ","
-                        << "#0x" << Base::HEX2 << rb << endl);
-      ra = read_register(rn);
-      rc = ra + rb;
-      //fprintf(stderr,"0x%08X = 0x%08X + 0x%08X\n",rc,ra,rb);
-      write_register(rd, rc);
-      do_nflag(rc);
-      do_zflag(rc);
-      do_cflag(ra, rb, 0);
-      do_vflag(ra, rb, 0);
-      return 0;
-    }
-    else
-    {
-      //this is a mov
-    }
-  }
+  if((inst & 0xFE00) == 0x1C00 && ((inst >> 6) & 0x7) != 0)
+    return Op::add1;
 
   //ADD(2) big immediate one register
   if((inst & 0xF800) == 0x3000)
-  {
-    rb = (inst >> 0) & 0xFF;
-    rd = (inst >> 8) & 0x7;
-    DO_DISS(statusMsg << "adds r" << dec << rd << ",#0x" << Base::HEX2 << rb << endl);
-    ra = read_register(rd);
-    rc = ra + rb;
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    do_cflag(ra, rb, 0);
-    do_vflag(ra, rb, 0);
-    return 0;
-  }
+    return Op::add2;
 
   //ADD(3) three registers
   if((inst & 0xFE00) == 0x1800)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    rm = (inst >> 6) & 0x7;
-    DO_DISS(statusMsg << "adds r" << dec << rd << ",r" << dec << rn << ",r" << rm << endl);
-    ra = read_register(rn);
-    rb = read_register(rm);
-    rc = ra + rb;
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    do_cflag(ra, rb, 0);
-    do_vflag(ra, rb, 0);
-    return 0;
-  }
+    return Op::add3;
 
   //ADD(4) two registers one or both high no flags
   if((inst & 0xFF00) == 0x4400)
-  {
-    if((inst >> 6) & 3)
-    {
-      //UNPREDICTABLE
-    }
-    rd  = (inst >> 0) & 0x7;
-    rd |= (inst >> 4) & 0x8;
-    rm  = (inst >> 3) & 0xF;
-    DO_DISS(statusMsg << "add r" << dec << rd << ",r" << dec << rm << endl);
-    ra = read_register(rd);
-    rb = read_register(rm);
-    rc = ra + rb;
-    if(rd == 15)
-    {
-      if((rc & 1) == 0)
-        fatalError("add pc", pc, rc, " produced an arm address");
-
-      rc &= ~1; //write_register may do this as well
-      rc += 2;  //The program counter is special
-    }
-    //fprintf(stderr,"0x%08X = 0x%08X + 0x%08X\n",rc,ra,rb);
-    write_register(rd, rc);
-    return 0;
-  }
+    return Op::add4;
 
   //ADD(5) rd = pc plus immediate
   if((inst & 0xF800) == 0xA000)
-  {
-    rb = (inst >> 0) & 0xFF;
-    rd = (inst >> 8) & 0x7;
-    rb <<= 2;
-    DO_DISS(statusMsg << "add r" << dec << rd << ",PC,#0x" << Base::HEX2 << rb << endl);
-    ra = read_register(15);
-    rc = (ra & (~3u)) + rb;
-    write_register(rd, rc);
-    return 0;
-  }
+    return Op::add5;
 
   //ADD(6) rd = sp plus immediate
   if((inst & 0xF800) == 0xA800)
-  {
-    rb = (inst >> 0) & 0xFF;
-    rd = (inst >> 8) & 0x7;
-    rb <<= 2;
-    DO_DISS(statusMsg << "add r" << dec << rd << ",SP,#0x" << Base::HEX2 << rb << endl);
-    ra = read_register(13);
-    rc = ra + rb;
-    write_register(rd, rc);
-    return 0;
-  }
+    return Op::add6;
 
   //ADD(7) sp plus immediate
   if((inst & 0xFF80) == 0xB000)
-  {
-    rb = (inst >> 0) & 0x7F;
-    rb <<= 2;
-    DO_DISS(statusMsg << "add SP,#0x" << Base::HEX2 << rb << endl);
-    ra = read_register(13);
-    rc = ra + rb;
-    write_register(13, rc);
-    return 0;
-  }
+    return Op::add7;
 
   //AND
   if((inst & 0xFFC0) == 0x4000)
-  {
-    rd = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "ands r" << dec << rd << ",r" << dec << rm << endl);
-    ra = read_register(rd);
-    rb = read_register(rm);
-    rc = ra & rb;
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    return 0;
-  }
+    return Op::and_;
 
   //ASR(1) two register immediate
   if((inst & 0xF800) == 0x1000)
-  {
-    rd = (inst >> 0) & 0x07;
-    rm = (inst >> 3) & 0x07;
-    rb = (inst >> 6) & 0x1F;
-    DO_DISS(statusMsg << "asrs r" << dec << rd << ",r" << dec << rm << ",#0x" << Base::HEX2 << rb << endl);
-    rc = read_register(rm);
-    if(rb == 0)
-    {
-      if(rc & 0x80000000)
-      {
-        do_cflag_bit(1);
-        rc = ~0;
-      }
-      else
-      {
-        do_cflag_bit(0);
-        rc = 0;
-      }
-    }
-    else
-    {
-      do_cflag_bit(rc & (1 << (rb-1)));
-      ra = rc & 0x80000000;
-      rc >>= rb;
-      if(ra) //asr, sign is shifted in
-        rc |= (~0u) << (32-rb);
-    }
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    return 0;
-  }
+    return Op::asr1;
 
   //ASR(2) two register
   if((inst & 0xFFC0) == 0x4100)
-  {
-    rd = (inst >> 0) & 0x07;
-    rs = (inst >> 3) & 0x07;
-    DO_DISS(statusMsg << "asrs r" << dec << rd << ",r" << dec << rs << endl);
-    rc = read_register(rd);
-    rb = read_register(rs);
-    rb &= 0xFF;
-    if(rb == 0)
-    {
-    }
-    else if(rb < 32)
-    {
-      do_cflag_bit(rc & (1 << (rb-1)));
-      ra = rc & 0x80000000;
-      rc >>= rb;
-      if(ra) //asr, sign is shifted in
-      {
-        rc |= (~0u) << (32-rb);
-      }
-    }
-    else
-    {
-      if(rc & 0x80000000)
-      {
-        do_cflag_bit(1);
-        rc = (~0u);
-      }
-      else
-      {
-        do_cflag_bit(0);
-        rc = 0;
-      }
-    }
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    return 0;
-  }
+    return Op::asr2;
 
   //B(1) conditional branch
-  if((inst & 0xF000) == 0xD000)
-  {
-    rb = (inst >> 0) & 0xFF;
-    if(rb & 0x80)
-      rb |= (~0u) << 8;
-    op=(inst >> 8) & 0xF;
-    rb <<= 1;
-    rb += pc;
-    rb += 2;
-    switch(op)
-    {
-      case 0x0: //b eq  z set
-        DO_DISS(statusMsg << "beq 0x" << Base::HEX8 << (rb-3) << endl);
-        if(cpsr & CPSR_Z)
-          write_register(15, rb);
-        return 0;
+  if((inst & 0xF000) == 0xD000 && ((inst >> 8) & 0xF) < 0xE)
+    return Op::b1;
 
-      case 0x1: //b ne  z clear
-        DO_DISS(statusMsg << "bne 0x" << Base::HEX8 << (rb-3) << endl);
-        if(!(cpsr & CPSR_Z))
-          write_register(15, rb);
-        return 0;
+  //B(2) unconditional branch
+  if((inst & 0xF800) == 0xE000)
+    return Op::b2;
 
-      case 0x2: //b cs c set
-        DO_DISS(statusMsg << "bcs 0x" << Base::HEX8 << (rb-3) << endl);
-        if(cpsr & CPSR_C)
-          write_register(15, rb);
-        return 0;
+  //BIC
+  if((inst & 0xFFC0) == 0x4380)
+    return Op::bic;
 
-      case 0x3: //b cc c clear
-        DO_DISS(statusMsg << "bcc 0x" << Base::HEX8 << (rb-3) << endl);
-        if(!(cpsr & CPSR_C))
-          write_register(15, rb);
-        return 0;
+  //BKPT
+  if((inst & 0xFF00) == 0xBE00)
+    return Op::bkpt;
 
-      case 0x4: //b mi n set
-        DO_DISS(statusMsg << "bmi 0x" << Base::HEX8 << (rb-3) << endl);
-        if(cpsr & CPSR_N)
-          write_register(15, rb);
-        return 0;
+  //BL/BLX(1)
+  if((inst & 0xE000) == 0xE000)
+    return Op::blx1;
 
-      case 0x5: //b pl n clear
-        DO_DISS(statusMsg << "bpl 0x" << Base::HEX8 << (rb-3) << endl);
-        if(!(cpsr & CPSR_N))
-          write_register(15, rb);
-        return 0;
+  //BLX(2)
+  if((inst & 0xFF87) == 0x4780)
+    return Op::blx2;
 
-      case 0x6: //b vs v set
-        DO_DISS(statusMsg << "bvs 0x" << Base::HEX8 << (rb-3) << endl);
-        if(cpsr & CPSR_V)
-          write_register(15,rb);
-        return 0;
+  //BX
+  if((inst & 0xFF87) == 0x4700)
+    return Op::bx;
 
-      case 0x7: //b vc v clear
-        DO_DISS(statusMsg << "bvc 0x" << Base::HEX8 << (rb-3) << endl);
-        if(!(cpsr & CPSR_V))
-          write_register(15, rb);
-        return 0;
+  //CMN
+  if((inst & 0xFFC0) == 0x42C0)
+    return Op::cmn;
 
-      case 0x8: //b hi c set z clear
-        DO_DISS(statusMsg << "bhi 0x" << Base::HEX8 << (rb-3) << endl);
-        if((cpsr & CPSR_C) && (!(cpsr & CPSR_Z)))
-          write_register(15, rb);
-        return 0;
+  //CMP(1) compare immediate
+  if((inst & 0xF800) == 0x2800)
+    return Op::cmp1;
 
-      case 0x9: //b ls c clear or z set
-        DO_DISS(statusMsg << "bls 0x" << Base::HEX8 << (rb-3) << endl);
-        if((cpsr & CPSR_Z) || (!(cpsr & CPSR_C)))
-          write_register(15, rb);
-        return 0;
+  //CMP(2) compare register
+  if((inst & 0xFFC0) == 0x4280)
+    return Op::cmp2;
 
-      case 0xA: //b ge N == V
-        DO_DISS(statusMsg << "bge 0x" << Base::HEX8 << (rb-3) << endl);
-        ra = 0;
-        if(  (cpsr & CPSR_N)  &&   (cpsr & CPSR_V) ) ra++;
-        if((!(cpsr & CPSR_N)) && (!(cpsr & CPSR_V))) ra++;
-        if(ra)
-          write_register(15, rb);
-        return 0;
+  //CMP(3) compare high register
+  if((inst & 0xFF00) == 0x4500)
+    return Op::cmp3;
 
-      case 0xB: //b lt N != V
-        DO_DISS(statusMsg << "blt 0x" << Base::HEX8 << (rb-3) << endl);
-        ra = 0;
-        if((!(cpsr & CPSR_N)) && (cpsr & CPSR_V)) ra++;
-        if((!(cpsr & CPSR_V)) && (cpsr & CPSR_N)) ra++;
-        if(ra)
-          write_register(15, rb);
-        return 0;
+  //CPS
+  if((inst & 0xFFE8) == 0xB660)
+    return Op::cps;
 
-      case 0xC: //b gt Z==0 and N == V
-        DO_DISS(statusMsg << "bgt 0x" << Base::HEX8 << (rb-3) << endl);
-        ra = 0;
-        if(  (cpsr & CPSR_N)  &&   (cpsr & CPSR_V) ) ra++;
-        if((!(cpsr & CPSR_N)) && (!(cpsr & CPSR_V))) ra++;
-        if(cpsr & CPSR_Z) ra = 0;
-        if(ra)
-          write_register(15, rb);
-        return 0;
+  //CPY copy high register
+  if((inst & 0xFFC0) == 0x4600)
+    return Op::cpy;
 
-      case 0xD: //b le Z==1 or N != V
-        DO_DISS(statusMsg << "ble 0x" << Base::HEX8 << (rb-3) << endl);
-        ra = 0;
-        if((!(cpsr & CPSR_N)) && (cpsr & CPSR_V)) ra++;
-        if((!(cpsr & CPSR_V)) && (cpsr & CPSR_N)) ra++;
-        if(cpsr & CPSR_Z) ra++;
-        if(ra)
-          write_register(15, rb);
-        return 0;
+  //EOR
+  if((inst & 0xFFC0) == 0x4040)
+    return Op::eor;
 
-      case 0xE:
-        //undefined instruction
-        break;
+  //LDMIA
+  if((inst & 0xF800) == 0xC800)
+    return Op::ldmia;
 
-      case 0xF:
-        //swi
-        break;
-    }
-  }
+  //LDR(1) two register immediate
+  if((inst & 0xF800) == 0x6800)
+    return Op::ldr1;
 
-  //B(2) unconditional branch
-  if((inst & 0xF800) == 0xE000)
-  {
-    rb = (inst >> 0) & 0x7FF;
-    if(rb & (1 << 10))
-      rb |= (~0u) << 11;
-    rb <<= 1;
-    rb += pc;
-    rb += 2;
-    DO_DISS(statusMsg << "B 0x" << Base::HEX8 << (rb-3) << endl);
-    write_register(15, rb);
-    return 0;
-  }
-
-  //BIC
-  if((inst & 0xFFC0) == 0x4380)
-  {
-    rd = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "bics r" << dec << rd << ",r" << dec << rm << endl);
-    ra = read_register(rd);
-    rb = read_register(rm);
-    rc = ra & (~rb);
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    return 0;
-  }
-
-  //BKPT
-  if((inst & 0xFF00) == 0xBE00)
-  {
-    rb = (inst >> 0) & 0xFF;
-    statusMsg << "bkpt 0x" << Base::HEX2 << rb << endl;
-    return 1;
-  }
-
-  //BL/BLX(1)
-  if((inst & 0xE000) == 0xE000) //BL,BLX
-  {
-    if((inst & 0x1800) == 0x1000) //H=b10
-    {
-      DO_DISS(statusMsg << endl);
-      rb = inst & ((1 << 11) - 1);
-      if(rb & 1<<10) rb |= (~((1 << 11) - 1)); //sign extend
-      rb <<= 12;
-      rb += pc;
-      write_register(14, rb);
-      return 0;
-    }
-    else if((inst & 0x1800) == 0x1800) //H=b11
-    {
-      //branch to thumb
-      rb = read_register(14);
-      rb += (inst & ((1 << 11) - 1)) << 1;;
-      rb += 2;
-      DO_DISS(statusMsg << "bl 0x" << Base::HEX8 << (rb-3) << endl);
-      write_register(14, (pc-2) | 1);
-      write_register(15, rb);
-      return 0;
-    }
-    else if((inst & 0x1800) == 0x0800) //H=b01
-    {
-      //fprintf(stderr,"cannot branch to arm 0x%08X 0x%04X\n",pc,inst);
-      // fxq: this should exit the code without having to detect it
-      rb = read_register(14);
-      rb += (inst & ((1 << 11) - 1)) << 1;;
-      rb &= 0xFFFFFFFC;
-      rb += 2;
-      DO_DISS(statusMsg << "bl 0x" << Base::HEX8 << (rb-3) << endl);
-      write_register(14, (pc-2) | 1);
-      write_register(15, rb);
-      return 0;
-    }
-  }
-
-  //BLX(2)
-  if((inst & 0xFF87) == 0x4780)
-  {
-    rm = (inst >> 3) & 0xF;
-    DO_DISS(statusMsg << "blx r" << dec << rm << endl);
-    rc = read_register(rm);
-    //fprintf(stderr,"blx r%u 0x%X 0x%X\n",rm,rc,pc);
-    rc += 2;
-    if(rc & 1)
-    {
-      write_register(14, (pc-2) | 1);
-      rc &= ~1;
-      write_register(15, rc);
-      return 0;
-    }
-    else
-    {
-      //fprintf(stderr,"cannot branch to arm 0x%08X 0x%04X\n",pc,inst);
-      // fxq: this could serve as exit code
-      return 1;
-    }
-  }
-
-  //BX
-  if((inst & 0xFF87) == 0x4700)
-  {
-    rm = (inst >> 3) & 0xF;
-    DO_DISS(statusMsg << "bx r" << dec << rm << endl);
-    rc = read_register(rm);
-    rc += 2;
-    //fprintf(stderr,"bx r%u 0x%X 0x%X\n",rm,rc,pc);
-    if(rc & 1)
-    {
-      // branch to odd address denotes 16 bit ARM code
-      rc &= ~1;
-      write_register(15, rc);
-      return 0;
-    }
-    else
-    {
-      // branch to even address denotes 32 bit ARM code, which the Thumbulator
-      // class does not support. So capture relavent information and hand it
-      // off to the Cartridge class for it to handle.
-
-      bool handled = false;
-
-      switch(configuration)
-      {
-        case ConfigureFor::BUS:
-          // this subroutine interface is used in the BUS driver,
-          // it starts at address 0x000006d8
-          // _SetNote:
-          //   ldr     r4, =NoteStore
-          //   bx      r4   // bx instruction at 0x000006da
-          // _ResetWave:
-          //   ldr     r4, =ResetWaveStore
-          //   bx      r4   // bx instruction at 0x000006de
-          // _GetWavePtr:
-          //   ldr     r4, =WavePtrFetch
-          //   bx      r4   // bx instruction at 0x000006e2
-          // _SetWaveSize:
-          //   ldr     r4, =WaveSizeStore
-          //   bx      r4   // bx instruction at 0x000006e6
-
-          // address to test for is + 4 due to pipelining
-
-#define BUS_SetNote     (0x000006da + 4)
-#define BUS_ResetWave   (0x000006de + 4)
-#define BUS_GetWavePtr  (0x000006e2 + 4)
-#define BUS_SetWaveSize (0x000006e6 + 4)
-
-          if      (pc == BUS_SetNote)
-          {
-            myCartridge->thumbCallback(0, read_register(2), read_register(3));
-            handled = true;
-          }
-          else if (pc == BUS_ResetWave)
-          {
-            myCartridge->thumbCallback(1, read_register(2), 0);
-            handled = true;
-          }
-          else if (pc == BUS_GetWavePtr)
-          {
-            write_register(2, myCartridge->thumbCallback(2, read_register(2), 0));
-            handled = true;
-          }
-          else if (pc == BUS_SetWaveSize)
-          {
-            myCartridge->thumbCallback(3, read_register(2), read_register(3));
-            handled = true;
-          }
-          else if (pc == 0x0000083a)
-          {
-            // exiting Custom ARM code, returning to BUS Driver control
-          }
-          else
-          {
-#if 0  // uncomment this for testing
-            uInt32 r0 = read_register(0);
-            uInt32 r1 = read_register(1);
-            uInt32 r2 = read_register(2);
-            uInt32 r3 = read_register(3);
-            uInt32 r4 = read_register(4);
-#endif
-            myCartridge->thumbCallback(255, 0, 0);
-          }
-
-          break;
-
-        case ConfigureFor::CDF:
-          // this subroutine interface is used in the CDF driver,
-          // it starts at address 0x000006e0
-          // _SetNote:
-          //   ldr     r4, =NoteStore
-          //   bx      r4   // bx instruction at 0x000006e2
-          // _ResetWave:
-          //   ldr     r4, =ResetWaveStore
-          //   bx      r4   // bx instruction at 0x000006e6
-          // _GetWavePtr:
-          //   ldr     r4, =WavePtrFetch
-          //   bx      r4   // bx instruction at 0x000006ea
-          // _SetWaveSize:
-          //   ldr     r4, =WaveSizeStore
-          //   bx      r4   // bx instruction at 0x000006ee
-
-          // address to test for is + 4 due to pipelining
-
-        #define CDF_SetNote     (0x000006e2 + 4)
-        #define CDF_ResetWave   (0x000006e6 + 4)
-        #define CDF_GetWavePtr  (0x000006ea + 4)
-        #define CDF_SetWaveSize (0x000006ee + 4)
-
-          if      (pc == CDF_SetNote)
-          {
-            myCartridge->thumbCallback(0, read_register(2), read_register(3));
-            handled = true;
-          }
-          else if (pc == CDF_ResetWave)
-          {
-            myCartridge->thumbCallback(1, read_register(2), 0);
-            handled = true;
-          }
-          else if (pc == CDF_GetWavePtr)
-          {
-            write_register(2, myCartridge->thumbCallback(2, read_register(2), 0));
-            handled = true;
-          }
-          else if (pc == CDF_SetWaveSize)
-          {
-            myCartridge->thumbCallback(3, read_register(2), read_register(3));
-            handled = true;
-          }
-          else if (pc == 0x0000083a)
-          {
-            // exiting Custom ARM code, returning to BUS Driver control
-          }
-          else
-          {
-          #if 0  // uncomment this for testing
-            uInt32 r0 = read_register(0);
-            uInt32 r1 = read_register(1);
-            uInt32 r2 = read_register(2);
-            uInt32 r3 = read_register(3);
-            uInt32 r4 = read_register(4);
-          #endif
-            myCartridge->thumbCallback(255, 0, 0);
-          }
-
-          break;
-
-        case ConfigureFor::CDF1:
-          // this subroutine interface is used in the CDF driver,
-          // it starts at address 0x00000750
-          // _SetNote:
-          //   ldr     r4, =NoteStore
-          //   bx      r4   // bx instruction at 0x000006e2
-          // _ResetWave:
-          //   ldr     r4, =ResetWaveStore
-          //   bx      r4   // bx instruction at 0x000006e6
-          // _GetWavePtr:
-          //   ldr     r4, =WavePtrFetch
-          //   bx      r4   // bx instruction at 0x000006ea
-          // _SetWaveSize:
-          //   ldr     r4, =WaveSizeStore
-          //   bx      r4   // bx instruction at 0x000006ee
-
-          // address to test for is + 4 due to pipelining
-
-#define CDF1_SetNote     (0x00000752 + 4)
-#define CDF1_ResetWave   (0x00000756 + 4)
-#define CDF1_GetWavePtr  (0x0000075a + 4)
-#define CDF1_SetWaveSize (0x0000075e + 4)
-
-          if      (pc == CDF1_SetNote)
-          {
-            myCartridge->thumbCallback(0, read_register(2), read_register(3));
-            handled = true;
-          }
-          else if (pc == CDF1_ResetWave)
-          {
-            myCartridge->thumbCallback(1, read_register(2), 0);
-            handled = true;
-          }
-          else if (pc == CDF1_GetWavePtr)
-          {
-            write_register(2, myCartridge->thumbCallback(2, read_register(2), 0));
-            handled = true;
-          }
-          else if (pc == CDF1_SetWaveSize)
-          {
-            myCartridge->thumbCallback(3, read_register(2), read_register(3));
-            handled = true;
-          }
-          else if (pc == 0x0000083a)
-          {
-            // exiting Custom ARM code, returning to BUS Driver control
-          }
-          else
-          {
-#if 0  // uncomment this for testing
-            uInt32 r0 = read_register(0);
-            uInt32 r1 = read_register(1);
-            uInt32 r2 = read_register(2);
-            uInt32 r3 = read_register(3);
-            uInt32 r4 = read_register(4);
-#endif
-            myCartridge->thumbCallback(255, 0, 0);
-          }
-
-          break;
-
-        case ConfigureFor::DPCplus:
-          // no 32-bit subroutines in DPC+
-          break;
-      }
-
-      if (handled)
-      {
-        rc = read_register(14); // lr
-        rc += 2;
-        rc &= ~1;
-        write_register(15, rc);
-        return 0;
-      }
-
-      return 1;
-    }
-  }
-
-  //CMN
-  if((inst & 0xFFC0) == 0x42C0)
-  {
-    rn = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "cmns r" << dec << rn << ",r" << dec << rm << endl);
-    ra = read_register(rn);
-    rb = read_register(rm);
-    rc = ra + rb;
-    do_nflag(rc);
-    do_zflag(rc);
-    do_cflag(ra, rb, 0);
-    do_vflag(ra, rb, 0);
-    return 0;
-  }
-
-  //CMP(1) compare immediate
-  if((inst & 0xF800) == 0x2800)
-  {
-    rb = (inst >> 0) & 0xFF;
-    rn = (inst >> 8) & 0x07;
-    DO_DISS(statusMsg << "cmp r" << dec << rn << ",#0x" << Base::HEX2 << rb << endl);
-    ra = read_register(rn);
-    rc = ra - rb;
-    //fprintf(stderr,"0x%08X 0x%08X\n",ra,rb);
-    do_nflag(rc);
-    do_zflag(rc);
-    do_cflag(ra, ~rb, 1);
-    do_vflag(ra, ~rb, 1);
-    return 0;
-  }
-
-  //CMP(2) compare register
-  if((inst & 0xFFC0) == 0x4280)
-  {
-    rn = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "cmps r" << dec << rn << ",r" << dec << rm << endl);
-    ra = read_register(rn);
-    rb = read_register(rm);
-    rc = ra - rb;
-    //fprintf(stderr,"0x%08X 0x%08X\n",ra,rb);
-    do_nflag(rc);
-    do_zflag(rc);
-    do_cflag(ra, ~rb, 1);
-    do_vflag(ra, ~rb, 1);
-    return 0;
-  }
-
-  //CMP(3) compare high register
-  if((inst & 0xFF00) == 0x4500)
-  {
-    if(((inst >> 6) & 3) == 0x0)
-    {
-      //UNPREDICTABLE
-    }
-    rn = (inst >> 0) & 0x7;
-    rn |= (inst >> 4) & 0x8;
-    if(rn == 0xF)
-    {
-      //UNPREDICTABLE
-    }
-    rm = (inst >> 3) & 0xF;
-    DO_DISS(statusMsg << "cmps r" << dec << rn << ",r" << dec << rm << endl);
-    ra = read_register(rn);
-    rb = read_register(rm);
-    rc = ra - rb;
-    do_nflag(rc);
-    do_zflag(rc);
-    do_cflag(ra, ~rb, 1);
-    do_vflag(ra, ~rb, 1);
-    return 0;
-  }
-
-  //CPS
-  if((inst & 0xFFE8) == 0xB660)
-  {
-    DO_DISS(statusMsg << "cps TODO" << endl);
-    return 1;
-  }
-
-  //CPY copy high register
-  if((inst & 0xFFC0) == 0x4600)
-  {
-    //same as mov except you can use both low registers
-    //going to let mov handle high registers
-    rd = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "cpy r" << dec << rd << ",r" << dec << rm << endl);
-    rc = read_register(rm);
-    write_register(rd, rc);
-    return 0;
-  }
-
-  //EOR
-  if((inst & 0xFFC0) == 0x4040)
-  {
-    rd = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "eors r" << dec << rd << ",r" << dec << rm << endl);
-    ra = read_register(rd);
-    rb = read_register(rm);
-    rc = ra ^ rb;
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    return 0;
-  }
-
-  //LDMIA
-  if((inst & 0xF800) == 0xC800)
-  {
-    rn = (inst >> 8) & 0x7;
-  #if defined(THUMB_DISS)
-    statusMsg << "ldmia r" << dec << rn << "!,{";
-    for(ra=0,rb=0x01,rc=0;rb;rb=(rb<<1)&0xFF,ra++)
-    {
-      if(inst&rb)
-      {
-        if(rc) statusMsg << ",";
-        statusMsg << "r" << dec << ra;
-        rc++;
-      }
-    }
-    statusMsg << "}" << endl;
-  #endif
-    sp = read_register(rn);
-    for(ra = 0, rb = 0x01; rb; rb = (rb << 1) & 0xFF, ra++)
-    {
-      if(inst & rb)
-      {
-        write_register(ra, read32(sp));
-        sp += 4;
-      }
-    }
-    //there is a write back exception.
-    if((inst & (1 << rn)) == 0)
-      write_register(rn, sp);
-
-    return 0;
-  }
-
-  //LDR(1) two register immediate
-  if((inst & 0xF800) == 0x6800)
-  {
-    rd = (inst >> 0) & 0x07;
-    rn = (inst >> 3) & 0x07;
-    rb = (inst >> 6) & 0x1F;
-    rb <<= 2;
-    DO_DISS(statusMsg << "ldr r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX2 << rb << "]" << endl);
-    rb = read_register(rn) + rb;
-    rc = read32(rb);
-    write_register(rd, rc);
-    return 0;
-  }
-
-  //LDR(2) three register
-  if((inst & 0xFE00) == 0x5800)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    rm = (inst >> 6) & 0x7;
-    DO_DISS(statusMsg << "ldr r" << dec << rd << ",[r" << dec << rn << ",r" << dec << "]" << endl);
-    rb = read_register(rn) + read_register(rm);
-    rc = read32(rb);
-    write_register(rd, rc);
-    return 0;
-  }
+  //LDR(2) three register
+  if((inst & 0xFE00) == 0x5800)
+    return Op::ldr2;
 
   //LDR(3)
   if((inst & 0xF800) == 0x4800)
-  {
-    rb = (inst >> 0) & 0xFF;
-    rd = (inst >> 8) & 0x07;
-    rb <<= 2;
-    DO_DISS(statusMsg << "ldr r" << dec << rd << ",[PC+#0x" << Base::HEX2 << rb << "] ");
-    ra = read_register(15);
-    ra &= ~3;
-    rb += ra;
-    DO_DISS(statusMsg << ";@ 0x" << Base::HEX2 << rb << endl);
-    rc = read32(rb);
-    write_register(rd, rc);
-    return 0;
-  }
+    return Op::ldr3;
 
   //LDR(4)
   if((inst & 0xF800) == 0x9800)
-  {
-    rb = (inst >> 0) & 0xFF;
-    rd = (inst >> 8) & 0x07;
-    rb <<= 2;
-    DO_DISS(statusMsg << "ldr r" << dec << rd << ",[SP+#0x" << Base::HEX2 << rb << "]" << endl);
-    ra = read_register(13);
-    //ra&=~3;
-    rb += ra;
-    rc = read32(rb);
-    write_register(rd, rc);
-    return 0;
-  }
+    return Op::ldr4;
 
   //LDRB(1)
   if((inst & 0xF800) == 0x7800)
-  {
-    rd = (inst >> 0) & 0x07;
-    rn = (inst >> 3) & 0x07;
-    rb = (inst >> 6) & 0x1F;
-    DO_DISS(statusMsg << "ldrb r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX2 << rb << "]" << endl);
-    rb = read_register(rn) + rb;
-    rc = read16(rb & (~1u));
-    if(rb & 1)
-    {
-      rc >>= 8;
-    }
-    else
-    {
-    }
-    write_register(rd, rc & 0xFF);
-    return 0;
-  }
+    return Op::ldrb1;
 
   //LDRB(2)
   if((inst & 0xFE00) == 0x5C00)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    rm = (inst >> 6) & 0x7;
-    DO_DISS(statusMsg << "ldrb r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
-    rb = read_register(rn) + read_register(rm);
-    rc = read16(rb & (~1u));
-    if(rb & 1)
-    {
-      rc >>= 8;
-    }
-    else
-    {
-    }
-    write_register(rd, rc & 0xFF);
-    return 0;
-  }
+    return Op::ldrb2;
 
   //LDRH(1)
   if((inst & 0xF800) == 0x8800)
-  {
-    rd = (inst >> 0) & 0x07;
-    rn = (inst >> 3) & 0x07;
-    rb = (inst >> 6) & 0x1F;
-    rb <<= 1;
-    DO_DISS(statusMsg << "ldrh r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX2 << rb << "]" << endl);
-    rb=read_register(rn) + rb;
-    rc = read16(rb);
-    write_register(rd, rc & 0xFFFF);
-    return 0;
-  }
+    return Op::ldrh1;
 
   //LDRH(2)
   if((inst & 0xFE00) == 0x5A00)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    rm = (inst >> 6) & 0x7;
-    DO_DISS(statusMsg << "ldrh r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
-    rb = read_register(rn) + read_register(rm);
-    rc = read16(rb);
-    write_register(rd, rc & 0xFFFF);
-    return 0;
-  }
+    return Op::ldrh2;
 
   //LDRSB
   if((inst & 0xFE00) == 0x5600)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    rm = (inst >> 6) & 0x7;
-    DO_DISS(statusMsg << "ldrsb r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
-    rb = read_register(rn) + read_register(rm);
-    rc = read16(rb & (~1u));
-    if(rb & 1)
-    {
-      rc >>= 8;
-    }
-    else
-    {
-    }
-    rc &= 0xFF;
-    if(rc & 0x80)
-      rc |= ((~0u) << 8);
-    write_register(rd, rc);
-    return 0;
-  }
+    return Op::ldrsb;
 
   //LDRSH
   if((inst & 0xFE00) == 0x5E00)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    rm = (inst >> 6) & 0x7;
-    DO_DISS(statusMsg << "ldrsh r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
-    rb = read_register(rn) + read_register(rm);
-    rc = read16(rb);
-    rc &= 0xFFFF;
-    if(rc & 0x8000)
-      rc |= ((~0u) << 16);
-    write_register(rd, rc);
-    return 0;
-  }
+    return Op::ldrsh;
 
   //LSL(1)
   if((inst & 0xF800) == 0x0000)
-  {
-    rd = (inst >> 0) & 0x07;
-    rm = (inst >> 3) & 0x07;
-    rb = (inst >> 6) & 0x1F;
-    DO_DISS(statusMsg << "lsls r" << dec << rd << ",r" << dec << rm << ",#0x" << Base::HEX2 << rb << endl);
-    rc = read_register(rm);
-    if(rb == 0)
-    {
-      //if immed_5 == 0
-      //C unaffected
-      //result not shifted
-    }
-    else
-    {
-      //else immed_5 > 0
-      do_cflag_bit(rc & (1 << (32-rb)));
-      rc <<= rb;
-    }
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    return 0;
-  }
+    return Op::lsl1;
 
   //LSL(2) two register
   if((inst & 0xFFC0) == 0x4080)
-  {
-    rd = (inst >> 0) & 0x07;
-    rs = (inst >> 3) & 0x07;
-    DO_DISS(statusMsg << "lsls r" << dec << rd << ",r" << dec << rs << endl);
-    rc = read_register(rd);
-    rb = read_register(rs);
-    rb &= 0xFF;
-    if(rb == 0)
-    {
-    }
-    else if(rb < 32)
-    {
-      do_cflag_bit(rc & (1 << (32-rb)));
-      rc <<= rb;
-    }
-    else if(rb == 32)
-    {
-      do_cflag_bit(rc & 1);
-      rc = 0;
-    }
-    else
-    {
-      do_cflag_bit(0);
-      rc = 0;
-    }
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    return 0;
-  }
+    return Op::lsl2;
 
   //LSR(1) two register immediate
   if((inst & 0xF800) == 0x0800)
-  {
-    rd = (inst >> 0) & 0x07;
-    rm = (inst >> 3) & 0x07;
-    rb = (inst >> 6) & 0x1F;
-    DO_DISS(statusMsg << "lsrs r" << dec << rd << ",r" << dec << rm << ",#0x" << Base::HEX2 << rb << endl);
-    rc = read_register(rm);
-    if(rb == 0)
-    {
-      do_cflag_bit(rc & 0x80000000);
-      rc = 0;
-    }
-    else
-    {
-      do_cflag_bit(rc & (1 << (rb-1)));
-      rc >>= rb;
-    }
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    return 0;
-  }
+    return Op::lsr1;
 
   //LSR(2) two register
   if((inst & 0xFFC0) == 0x40C0)
-  {
-    rd = (inst >> 0) & 0x07;
-    rs = (inst >> 3) & 0x07;
-    DO_DISS(statusMsg << "lsrs r" << dec << rd << ",r" << dec << rs << endl);
-    rc = read_register(rd);
-    rb = read_register(rs);
-    rb &= 0xFF;
-    if(rb == 0)
-    {
-    }
-    else if(rb < 32)
-    {
-      do_cflag_bit(rc & (1 << (rb-1)));
-      rc >>= rb;
-    }
-    else if(rb == 32)
-    {
-      do_cflag_bit(rc & 0x80000000);
-      rc = 0;
-    }
-    else
-    {
-      do_cflag_bit(0);
-      rc = 0;
-    }
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    return 0;
-  }
+    return Op::lsr2;
 
   //MOV(1) immediate
   if((inst & 0xF800) == 0x2000)
-  {
-    rb = (inst >> 0) & 0xFF;
-    rd = (inst >> 8) & 0x07;
-    DO_DISS(statusMsg << "movs r" << dec << rd << ",#0x" << Base::HEX2 << rb << endl);
-    write_register(rd, rb);
-    do_nflag(rb);
-    do_zflag(rb);
-    return 0;
-  }
+    return Op::mov1;
 
   //MOV(2) two low registers
   if((inst & 0xFFC0) == 0x1C00)
-  {
-    rd = (inst >> 0) & 7;
-    rn = (inst >> 3) & 7;
-    DO_DISS(statusMsg << "movs r" << dec << rd << ",r" << dec << rn << endl);
-    rc = read_register(rn);
-    //fprintf(stderr,"0x%08X\n",rc);
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    do_cflag_bit(0);
-    do_vflag_bit(0);
-    return 0;
-  }
+    return Op::mov2;
 
   //MOV(3)
   if((inst & 0xFF00) == 0x4600)
-  {
-    rd  = (inst >> 0) & 0x7;
-    rd |= (inst >> 4) & 0x8;
-    rm  = (inst >> 3) & 0xF;
-    DO_DISS(statusMsg << "mov r" << dec << rd << ",r" << dec << rm << endl);
-    rc = read_register(rm);
-    if((rd == 14) && (rm == 15))
-    {
-      //printf("mov lr,pc warning 0x%08X\n",pc-2);
-      //rc|=1;
-    }
-    if(rd == 15)
-    {
-      rc &= ~1; //write_register may do this as well
-      rc += 2;  //The program counter is special
-    }
-    write_register(rd, rc);
-    return 0;
-  }
+    return Op::mov3;
 
   //MUL
   if((inst & 0xFFC0) == 0x4340)
-  {
-    rd = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "muls r" << dec << rd << ",r" << dec << rm << endl);
-    ra = read_register(rd);
-    rb = read_register(rm);
-    rc = ra * rb;
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    return 0;
-  }
+    return Op::mul;
 
   //MVN
   if((inst & 0xFFC0) == 0x43C0)
-  {
-    rd = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "mvns r" << dec << rd << ",r" << dec << rm << endl);
-    ra = read_register(rm);
-    rc = (~ra);
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    return 0;
-  }
+    return Op::mvn;
 
   //NEG
   if((inst & 0xFFC0) == 0x4240)
-  {
-    rd = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "negs r" << dec << rd << ",r" << dec << rm << endl);
-    ra = read_register(rm);
-    rc = 0 - ra;
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    do_cflag(0, ~ra, 1);
-    do_vflag(0, ~ra, 1);
-    return 0;
-  }
+    return Op::neg;
 
   //ORR
   if((inst & 0xFFC0) == 0x4300)
-  {
-    rd = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "orrs r" << dec << rd << ",r" << dec << rm << endl);
-    ra = read_register(rd);
-    rb = read_register(rm);
-    rc = ra | rb;
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    return 0;
-  }
+    return Op::orr;
 
   //POP
   if((inst & 0xFE00) == 0xBC00)
+    return Op::pop;
+
+  //PUSH
+  if((inst & 0xFE00) == 0xB400)
+    return Op::push;
+
+  //REV
+  if((inst & 0xFFC0) == 0xBA00)
+    return Op::rev;
+
+  //REV16
+  if((inst & 0xFFC0) == 0xBA40)
+    return Op::rev16;
+
+  //REVSH
+  if((inst & 0xFFC0) == 0xBAC0)
+    return Op::revsh;
+
+  //ROR
+  if((inst & 0xFFC0) == 0x41C0)
+    return Op::ror;
+
+  //SBC
+  if((inst & 0xFFC0) == 0x4180)
+    return Op::sbc;
+
+  //SETEND
+  if((inst & 0xFFF7) == 0xB650)
+    return Op::setend;
+
+  //STMIA
+  if((inst & 0xF800) == 0xC000)
+    return Op::stmia;
+
+  //STR(1)
+  if((inst & 0xF800) == 0x6000)
+    return Op::str1;
+
+  //STR(2)
+  if((inst & 0xFE00) == 0x5000)
+    return Op::str2;
+
+  //STR(3)
+  if((inst & 0xF800) == 0x9000)
+    return Op::str3;
+
+  //STRB(1)
+  if((inst & 0xF800) == 0x7000)
+    return Op::strb1;
+
+  //STRB(2)
+  if((inst & 0xFE00) == 0x5400)
+    return Op::strb2;
+
+  //STRH(1)
+  if((inst & 0xF800) == 0x8000)
+    return Op::strh1;
+
+  //STRH(2)
+  if((inst & 0xFE00) == 0x5200)
+    return Op::strh2;
+
+  //SUB(1)
+  if((inst & 0xFE00) == 0x1E00)
+    return Op::sub1;
+
+  //SUB(2)
+  if((inst & 0xF800) == 0x3800)
+    return Op::sub2;
+
+  //SUB(3)
+  if((inst & 0xFE00) == 0x1A00)
+    return Op::sub3;
+
+  //SUB(4)
+  if((inst & 0xFF80) == 0xB080)
+    return Op::sub4;
+
+  //SWI
+  if((inst & 0xFF00) == 0xDF00)
+    return Op::swi;
+
+  //SXTB
+  if((inst & 0xFFC0) == 0xB240)
+    return Op::sxtb;
+
+  //SXTH
+  if((inst & 0xFFC0) == 0xB200)
+    return Op::sxth;
+
+  //TST
+  if((inst & 0xFFC0) == 0x4200)
+    return Op::tst;
+
+  //UXTB
+  if((inst & 0xFFC0) == 0xB2C0)
+    return Op::uxtb;
+
+  //UXTH
+  if((inst & 0xFFC0) == 0xB280)
+    return Op::uxth;
+
+  return Op::invalid;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+inline Thumbulator::Op Thumbulator::decodeInstruction(uInt32 addr, uInt16 inst)
+{
+  switch(addr & 0xF0000000)
+  {
+    case 0x00000000: //ROM
+      return decodedRom[(addr & ROMADDMASK) >> 1];
+
+    case 0x40000000: //RAM
+    {
+      // Code in RAM can be changed by the ARM code as well as by the 6507
+      // (through the cartridge), so each entry remembers which instruction
+      // it was decoded from, and is decoded again when that has changed
+      addr = (addr & RAMADDMASK) >> 1;
+      if(decodedRamInst[addr] != inst)
+      {
+        decodedRamInst[addr] = inst;
+        decodedRam[addr] = decodeInstructionWord(inst);
+      }
+      return decodedRam[addr];
+    }
+  }
+  return decodeInstructionWord(inst);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<Thumbulator::ConfigureFor C>
+int Thumbulator::execute()
+{
+  uInt32 pc, sp, inst, ra, rb, rc, rm, rd, rn, rs, op;
+
+  pc = read_register(15);
+
+#if 0
+  if(handler_mode)
+  {
+    if((pc & 0xF0000000) == 0xF0000000)
+    {
+      uInt32 sp = read_register(13);
+      handler_mode = false;
+      write_register(0,  read32(sp)); sp += 4;
+      write_register(1,  read32(sp)); sp += 4;
+      write_register(2,  read32(sp)); sp += 4;
+      write_register(3,  read32(sp)); sp += 4;
+      write_register(12, read32(sp)); sp += 4;
+      write_register(14, read32(sp)); sp += 4;
+      pc = read32(sp); sp += 4;
+      cpsr = read32(sp); sp += 4;
+      write_register(13, sp);
+    }
+  }
+  if(systick_ctrl & 1)
+  {
+    if(systick_count)
+    {
+      systick_count--;
+    }
+    else
+    {
+      systick_count = systick_reload;
+      systick_ctrl |= 0x00010000;
+    }
+  }
+
+  if((systick_ctrl & 3) == 3)
+  {
+    if(systick_ctrl & 0x00010000)
+    {
+      if(!handler_mode)
+      {
+        systick_ints++;
+        uInt32 sp = read_register(13);
+        sp -= 4; write32<C>(sp, cpsr);
+        sp -= 4; write32<C>(sp, pc);
+        sp -= 4; write32<C>(sp, read_register(14));
+        sp -= 4; write32<C>(sp, read_register(12));
+        sp -= 4; write32<C>(sp, read_register(3));
+        sp -= 4; write32<C>(sp, read_register(2));
+        sp -= 4; write32<C>(sp, read_register(1));
+        sp -= 4; write32<C>(sp, read_register(0));
+        write_register(13, sp);
+        pc = fetch32(0x0000003C); //systick vector
+        pc += 2;
+        //write_register(14, 0xFFFFFF00);
+        write_register(14, 0xFFFFFFF9);
+
+        handler_mode = true;
+      }
+    }
+  }
+#endif
+
+  inst = fetch16(pc-2);
+  pc += 2;
+  write_register(15, pc);
+  DO_DISS(statusMsg << Base::HEX8 << (pc-5) << ": " << Base::HEX4 << inst << " ");
+
+  instructions++;
+
+  const Op opcode = decodeInstruction(pc - 4, inst);
+
+  // Loads take an extra internal cycle to write the register
+  // (the load instructions are consecutive in Op)
+  if((opcode >= Op::ldmia && opcode <= Op::ldrsh) || opcode == Op::pop)
+    arm_cycles += 1;
+
+  switch(opcode)
   {
-  #if defined(THUMB_DISS)
-    statusMsg << "pop {";
-    for(ra=0,rb=0x01,rc=0;rb;rb=(rb<<1)&0xFF,ra++)
+    //ADC
+    case Op::adc:
+    {
+      rd = (inst >> 0) & 0x07;
+      rm = (inst >> 3) & 0x07;
+      DO_DISS(statusMsg << "adc r" << dec << rd << ",r" << dec << rm << endl);
+      ra = read_register(rd);
+      rb = read_register(rm);
+      rc = ra + rb;
+      if(cpsr & CPSR_C)
+        rc++;
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      if(cpsr & CPSR_C) { do_cflag(ra, rb, 1); do_vflag(ra, rb, 1); }
+      else              { do_cflag(ra, rb, 0); do_vflag(ra, rb, 0); }
+      return 0;
+    }
+
+    //ADD(1) small immediate two registers
+    case Op::add1:
+    {
+      // (an immediate of zero is decoded as MOV(2) instead)
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      rb = (inst >> 6) & 0x7;
+      DO_DISS(statusMsg << "adds r" << dec << rd << ",r" << dec << rn << ","
+                        << "#0x" << Base::HEX2 << rb << endl);
+      ra = read_register(rn);
+      rc = ra + rb;
+      //fprintf(stderr,"0x%08X = 0x%08X + 0x%08X\n",rc,ra,rb);
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      do_cflag(ra, rb, 0);
+      do_vflag(ra, rb, 0);
+      return 0;
+    }
+
+    //ADD(2) big immediate one register
+    case Op::add2:
+    {
+      rb = (inst >> 0) & 0xFF;
+      rd = (inst >> 8) & 0x7;
+      DO_DISS(statusMsg << "adds r" << dec << rd << ",#0x" << Base::HEX2 << rb << endl);
+      ra = read_register(rd);
+      rc = ra + rb;
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      do_cflag(ra, rb, 0);
+      do_vflag(ra, rb, 0);
+      return 0;
+    }
+
+    //ADD(3) three registers
+    case Op::add3:
+    {
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      rm = (inst >> 6) & 0x7;
+      DO_DISS(statusMsg << "adds r" << dec << rd << ",r" << dec << rn << ",r" << rm << endl);
+      ra = read_register(rn);
+      rb = read_register(rm);
+      rc = ra + rb;
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      do_cflag(ra, rb, 0);
+      do_vflag(ra, rb, 0);
+      return 0;
+    }
+
+    //ADD(4) two registers one or both high no flags
+    case Op::add4:
+    {
+      if((inst >> 6) & 3)
+      {
+        //UNPREDICTABLE
+      }
+      rd  = (inst >> 0) & 0x7;
+      rd |= (inst >> 4) & 0x8;
+      rm  = (inst >> 3) & 0xF;
+      DO_DISS(statusMsg << "add r" << dec << rd << ",r" << dec << rm << endl);
+      ra = read_register(rd);
+      rb = read_register(rm);
+      rc = ra + rb;
+      if(rd == 15)
+      {
+        if((rc & 1) == 0)
+          fatalError("add pc", pc, rc, " produced an arm address");
+
+        rc &= ~1; //write_register may do this as well
+        rc += 2;  //The program counter is special
+      }
+      //fprintf(stderr,"0x%08X = 0x%08X + 0x%08X\n",rc,ra,rb);
+      write_register(rd, rc);
+      return 0;
+    }
+
+    //ADD(5) rd = pc plus immediate
+    case Op::add5:
+    {
+      rb = (inst >> 0) & 0xFF;
+      rd = (inst >> 8) & 0x7;
+      rb <<= 2;
+      DO_DISS(statusMsg << "add r" << dec << rd << ",PC,#0x" << Base::HEX2 << rb << endl);
+      ra = read_register(15);
+      rc = (ra & (~3u)) + rb;
+      write_register(rd, rc);
+      return 0;
+    }
+
+    //ADD(6) rd = sp plus immediate
+    case Op::add6:
+    {
+      rb = (inst >> 0) & 0xFF;
+      rd = (inst >> 8) & 0x7;
+      rb <<= 2;
+      DO_DISS(statusMsg << "add r" << dec << rd << ",SP,#0x" << Base::HEX2 << rb << endl);
+      ra = read_register(13);
+      rc = ra + rb;
+      write_register(rd, rc);
+      return 0;
+    }
+
+    //ADD(7) sp plus immediate
+    case Op::add7:
+    {
+      rb = (inst >> 0) & 0x7F;
+      rb <<= 2;
+      DO_DISS(statusMsg << "add SP,#0x" << Base::HEX2 << rb << endl);
+      ra = read_register(13);
+      rc = ra + rb;
+      write_register(13, rc);
+      return 0;
+    }
+
+    //AND
+    case Op::and_:
+    {
+      rd = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "ands r" << dec << rd << ",r" << dec << rm << endl);
+      ra = read_register(rd);
+      rb = read_register(rm);
+      rc = ra & rb;
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      return 0;
+    }
+
+    //ASR(1) two register immediate
+    case Op::asr1:
+    {
+      rd = (inst >> 0) & 0x07;
+      rm = (inst >> 3) & 0x07;
+      rb = (inst >> 6) & 0x1F;
+      DO_DISS(statusMsg << "asrs r" << dec << rd << ",r" << dec << rm << ",#0x" << Base::HEX2 << rb << endl);
+      rc = read_register(rm);
+      if(rb == 0)
+      {
+        if(rc & 0x80000000)
+        {
+          do_cflag_bit(1);
+          rc = ~0;
+        }
+        else
+        {
+          do_cflag_bit(0);
+          rc = 0;
+        }
+      }
+      else
+      {
+        do_cflag_bit(rc & (1 << (rb-1)));
+        ra = rc & 0x80000000;
+        rc >>= rb;
+        if(ra) //asr, sign is shifted in
+          rc |= (~0u) << (32-rb);
+      }
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      return 0;
+    }
+
+    //ASR(2) two register
+    case Op::asr2:
+    {
+      rd = (inst >> 0) & 0x07;
+      rs = (inst >> 3) & 0x07;
+      DO_DISS(statusMsg << "asrs r" << dec << rd << ",r" << dec << rs << endl);
+      rc = read_register(rd);
+      rb = read_register(rs);
+      rb &= 0xFF;
+      if(rb == 0)
+      {
+      }
+      else if(rb < 32)
+      {
+        do_cflag_bit(rc & (1 << (rb-1)));
+        ra = rc & 0x80000000;
+        rc >>= rb;
+        if(ra) //asr, sign is shifted in
+        {
+          rc |= (~0u) << (32-rb);
+        }
+      }
+      else
+      {
+        if(rc & 0x80000000)
+        {
+          do_cflag_bit(1);
+          rc = (~0u);
+        }
+        else
+        {
+          do_cflag_bit(0);
+          rc = 0;
+        }
+      }
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      return 0;
+    }
+
+    //B(1) conditional branch
+    case Op::b1:
+    {
+      rb = (inst >> 0) & 0xFF;
+      if(rb & 0x80)
+        rb |= (~0u) << 8;
+      op=(inst >> 8) & 0xF;
+      rb <<= 1;
+      rb += pc;
+      rb += 2;
+      switch(op)
+      {
+        case 0x0: //b eq  z set
+          DO_DISS(statusMsg << "beq 0x" << Base::HEX8 << (rb-3) << endl);
+          if(cpsr & CPSR_Z)
+            write_register(15, rb);
+          return 0;
+
+        case 0x1: //b ne  z clear
+          DO_DISS(statusMsg << "bne 0x" << Base::HEX8 << (rb-3) << endl);
+          if(!(cpsr & CPSR_Z))
+            write_register(15, rb);
+          return 0;
+
+        case 0x2: //b cs c set
+          DO_DISS(statusMsg << "bcs 0x" << Base::HEX8 << (rb-3) << endl);
+          if(cpsr & CPSR_C)
+            write_register(15, rb);
+          return 0;
+
+        case 0x3: //b cc c clear
+          DO_DISS(statusMsg << "bcc 0x" << Base::HEX8 << (rb-3) << endl);
+          if(!(cpsr & CPSR_C))
+            write_register(15, rb);
+          return 0;
+
+        case 0x4: //b mi n set
+          DO_DISS(statusMsg << "bmi 0x" << Base::HEX8 << (rb-3) << endl);
+          if(cpsr & CPSR_N)
+            write_register(15, rb);
+          return 0;
+
+        case 0x5: //b pl n clear
+          DO_DISS(statusMsg << "bpl 0x" << Base::HEX8 << (rb-3) << endl);
+          if(!(cpsr & CPSR_N))
+            write_register(15, rb);
+          return 0;
+
+        case 0x6: //b vs v set
+          DO_DISS(statusMsg << "bvs 0x" << Base::HEX8 << (rb-3) << endl);
+          if(cpsr & CPSR_V)
+            write_register(15,rb);
+          return 0;
+
+        case 0x7: //b vc v clear
+          DO_DISS(statusMsg << "bvc 0x" << Base::HEX8 << (rb-3) << endl);
+          if(!(cpsr & CPSR_V))
+            write_register(15, rb);
+          return 0;
+
+        case 0x8: //b hi c set z clear
+          DO_DISS(statusMsg << "bhi 0x" << Base::HEX8 << (rb-3) << endl);
+          if((cpsr & CPSR_C) && (!(cpsr & CPSR_Z)))
+            write_register(15, rb);
+          return 0;
+
+        case 0x9: //b ls c clear or z set
+          DO_DISS(statusMsg << "bls 0x" << Base::HEX8 << (rb-3) << endl);
+          if((cpsr & CPSR_Z) || (!(cpsr & CPSR_C)))
+            write_register(15, rb);
+          return 0;
+
+        case 0xA: //b ge N == V
+          DO_DISS(statusMsg << "bge 0x" << Base::HEX8 << (rb-3) << endl);
+          ra = 0;
+          if(  (cpsr & CPSR_N)  &&   (cpsr & CPSR_V) ) ra++;
+          if((!(cpsr & CPSR_N)) && (!(cpsr & CPSR_V))) ra++;
+          if(ra)
+            write_register(15, rb);
+          return 0;
+
+        case 0xB: //b lt N != V
+          DO_DISS(statusMsg << "blt 0x" << Base::HEX8 << (rb-3) << endl);
+          ra = 0;
+          if((!(cpsr & CPSR_N)) && (cpsr & CPSR_V)) ra++;
+          if((!(cpsr & CPSR_V)) && (cpsr & CPSR_N)) ra++;
+          if(ra)
+            write_register(15, rb);
+          return 0;
+
+        case 0xC: //b gt Z==0 and N == V
+          DO_DISS(statusMsg << "bgt 0x" << Base::HEX8 << (rb-3) << endl);
+          ra = 0;
+          if(  (cpsr & CPSR_N)  &&   (cpsr & CPSR_V) ) ra++;
+          if((!(cpsr & CPSR_N)) && (!(cpsr & CPSR_V))) ra++;
+          if(cpsr & CPSR_Z) ra = 0;
+          if(ra)
+            write_register(15, rb);
+          return 0;
+
+        case 0xD: //b le Z==1 or N != V
+          DO_DISS(statusMsg << "ble 0x" << Base::HEX8 << (rb-3) << endl);
+          ra = 0;
+          if((!(cpsr & CPSR_N)) && (cpsr & CPSR_V)) ra++;
+          if((!(cpsr & CPSR_V)) && (cpsr & CPSR_N)) ra++;
+          if(cpsr & CPSR_Z) ra++;
+          if(ra)
+            write_register(15, rb);
+          return 0;
+
+        // 0xE (undefined instruction) and 0xF (swi) aren't decoded as B(1)
+      }
+      break;
+    }
+
+    //B(2) unconditional branch
+    case Op::b2:
+    {
+      rb = (inst >> 0) & 0x7FF;
+      if(rb & (1 << 10))
+        rb |= (~0u) << 11;
+      rb <<= 1;
+      rb += pc;
+      rb += 2;
+      DO_DISS(statusMsg << "B 0x" << Base::HEX8 << (rb-3) << endl);
+      write_register(15, rb);
+      return 0;
+    }
+
+    //BIC
+    case Op::bic:
+    {
+      rd = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "bics r" << dec << rd << ",r" << dec << rm << endl);
+      ra = read_register(rd);
+      rb = read_register(rm);
+      rc = ra & (~rb);
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      return 0;
+    }
+
+    //BKPT
+    case Op::bkpt:
+    {
+      rb = (inst >> 0) & 0xFF;
+      statusMsg << "bkpt 0x" << Base::HEX2 << rb << endl;
+      return 1;
+    }
+
+    //BL/BLX(1)
+    case Op::blx1:
+    {
+      if((inst & 0x1800) == 0x1000) //H=b10
+      {
+        DO_DISS(statusMsg << endl);
+        rb = inst & ((1 << 11) - 1);
+        if(rb & 1<<10) rb |= (~((1 << 11) - 1)); //sign extend
+        rb <<= 12;
+        rb += pc;
+        write_register(14, rb);
+        return 0;
+      }
+      else if((inst & 0x1800) == 0x1800) //H=b11
+      {
+        //branch to thumb
+        rb = read_register(14);
+        rb += (inst & ((1 << 11) - 1)) << 1;;
+        rb += 2;
+        DO_DISS(statusMsg << "bl 0x" << Base::HEX8 << (rb-3) << endl);
+        write_register(14, (pc-2) | 1);
+        write_register(15, rb);
+        return 0;
+      }
+      else if((inst & 0x1800) == 0x0800) //H=b01
+      {
+        //fprintf(stderr,"cannot branch to arm 0x%08X 0x%04X\n",pc,inst);
+        // fxq: this should exit the code without having to detect it
+        rb = read_register(14);
+        rb += (inst & ((1 << 11) - 1)) << 1;;
+        rb &= 0xFFFFFFFC;
+        rb += 2;
+        DO_DISS(statusMsg << "bl 0x" << Base::HEX8 << (rb-3) << endl);
+        write_register(14, (pc-2) | 1);
+        write_register(15, rb);
+        return 0;
+      }
+      break;
+    }
+
+    //BLX(2)
+    case Op::blx2:
+    {
+      rm = (inst >> 3) & 0xF;
+      DO_DISS(statusMsg << "blx r" << dec << rm << endl);
+      rc = read_register(rm);
+      //fprintf(stderr,"blx r%u 0x%X 0x%X\n",rm,rc,pc);
+      rc += 2;
+      if(rc & 1)
+      {
+        write_register(14, (pc-2) | 1);
+        rc &= ~1;
+        write_register(15, rc);
+        return 0;
+      }
+      else
+      {
+        //fprintf(stderr,"cannot branch to arm 0x%08X 0x%04X\n",pc,inst);
+        // fxq: this could serve as exit code
+        return 1;
+      }
+      break;
+    }
+
+    //BX
+    case Op::bx:
+    {
+      rm = (inst >> 3) & 0xF;
+      DO_DISS(statusMsg << "bx r" << dec << rm << endl);
+      rc = read_register(rm);
+      rc += 2;
+      //fprintf(stderr,"bx r%u 0x%X 0x%X\n",rm,rc,pc);
+      if(rc & 1)
+      {
+        // branch to odd address denotes 16 bit ARM code
+        rc &= ~1;
+        write_register(15, rc);
+        return 0;
+      }
+      else
+      {
+        // branch to even address denotes 32 bit ARM code, which the Thumbulator
+        // class does not support. So capture relavent information and hand it
+        // off to the Cartridge class for it to handle.
+
+        bool handled = false;
+
+        switch(C)
+        {
+          case ConfigureFor::BUS:
+            // this subroutine interface is used in the BUS driver,
+            // it starts at address 0x000006d8
+            // _SetNote:
+            //   ldr     r4, =NoteStore
+            //   bx      r4   // bx instruction at 0x000006da
+            // _ResetWave:
+            //   ldr     r4, =ResetWaveStore
+            //   bx      r4   // bx instruction at 0x000006de
+            // _GetWavePtr:
+            //   ldr     r4, =WavePtrFetch
+            //   bx      r4   // bx instruction at 0x000006e2
+            // _SetWaveSize:
+            //   ldr     r4, =WaveSizeStore
+            //   bx      r4   // bx instruction at 0x000006e6
+
+            // address to test for is + 4 due to pipelining
+
+  #define BUS_SetNote     (0x000006da + 4)
+  #define BUS_ResetWave   (0x000006de + 4)
+  #define BUS_GetWavePtr  (0x000006e2 + 4)
+  #define BUS_SetWaveSize (0x000006e6 + 4)
+
+            if      (pc == BUS_SetNote)
+            {
+              myCartridge->thumbCallback(0, read_register(2), read_register(3));
+              handled = true;
+            }
+            else if (pc == BUS_ResetWave)
+            {
+              myCartridge->thumbCallback(1, read_register(2), 0);
+              handled = true;
+            }
+            else if (pc == BUS_GetWavePtr)
+            {
+              write_register(2, myCartridge->thumbCallback(2, read_register(2), 0));
+              handled = true;
+            }
+            else if (pc == BUS_SetWaveSize)
+            {
+              myCartridge->thumbCallback(3, read_register(2), read_register(3));
+              handled = true;
+            }
+            else if (pc == 0x0000083a)
+            {
+              // exiting Custom ARM code, returning to BUS Driver control
+            }
+            else
+            {
+  #if 0  // uncomment this for testing
+              uInt32 r0 = read_register(0);
+              uInt32 r1 = read_register(1);
+              uInt32 r2 = read_register(2);
+              uInt32 r3 = read_register(3);
+              uInt32 r4 = read_register(4);
+  #endif
+              myCartridge->thumbCallback(255, 0, 0);
+            }
+
+            break;
+
+          case ConfigureFor::CDF:
+            // this subroutine interface is used in the CDF driver,
+            // it starts at address 0x000006e0
+            // _SetNote:
+            //   ldr     r4, =NoteStore
+            //   bx      r4   // bx instruction at 0x000006e2
+            // _ResetWave:
+            //   ldr     r4, =ResetWaveStore
+            //   bx      r4   // bx instruction at 0x000006e6
+            // _GetWavePtr:
+            //   ldr     r4, =WavePtrFetch
+            //   bx      r4   // bx instruction at 0x000006ea
+            // _SetWaveSize:
+            //   ldr     r4, =WaveSizeStore
+            //   bx      r4   // bx instruction at 0x000006ee
+
+            // address to test for is + 4 due to pipelining
+
+          #define CDF_SetNote     (0x000006e2 + 4)
+          #define CDF_ResetWave   (0x000006e6 + 4)
+          #define CDF_GetWavePtr  (0x000006ea + 4)
+          #define CDF_SetWaveSize (0x000006ee + 4)
+
+            if      (pc == CDF_SetNote)
+            {
+              myCartridge->thumbCallback(0, read_register(2), read_register(3));
+              handled = true;
+            }
+            else if (pc == CDF_ResetWave)
+            {
+              myCartridge->thumbCallback(1, read_register(2), 0);
+              handled = true;
+            }
+            else if (pc == CDF_GetWavePtr)
+            {
+              write_register(2, myCartridge->thumbCallback(2, read_register(2), 0));
+              handled = true;
+            }
+            else if (pc == CDF_SetWaveSize)
+            {
+              myCartridge->thumbCallback(3, read_register(2), read_register(3));
+              handled = true;
+            }
+            else if (pc == 0x0000083a)
+            {
+              // exiting Custom ARM code, returning to BUS Driver control
+            }
+            else
+            {
+            #if 0  // uncomment this for testing
+              uInt32 r0 = read_register(0);
+              uInt32 r1 = read_register(1);
+              uInt32 r2 = read_register(2);
+              uInt32 r3 = read_register(3);
+              uInt32 r4 = read_register(4);
+            #endif
+              myCartridge->thumbCallback(255, 0, 0);
+            }
+
+            break;
+
+          case ConfigureFor::CDF1:
+            // this subroutine interface is used in the CDF driver,
+            // it starts at address 0x00000750
+            // _SetNote:
+            //   ldr     r4, =NoteStore
+            //   bx      r4   // bx instruction at 0x000006e2
+            // _ResetWave:
+            //   ldr     r4, =ResetWaveStore
+            //   bx      r4   // bx instruction at 0x000006e6
+            // _GetWavePtr:
+            //   ldr     r4, =WavePtrFetch
+            //   bx      r4   // bx instruction at 0x000006ea
+            // _SetWaveSize:
+            //   ldr     r4, =WaveSizeStore
+            //   bx      r4   // bx instruction at 0x000006ee
+
+            // address to test for is + 4 due to pipelining
+
+  #define CDF1_SetNote     (0x00000752 + 4)
+  #define CDF1_ResetWave   (0x00000756 + 4)
+  #define CDF1_GetWavePtr  (0x0000075a + 4)
+  #define CDF1_SetWaveSize (0x0000075e + 4)
+
+            if      (pc == CDF1_SetNote)
+            {
+              myCartridge->thumbCallback(0, read_register(2), read_register(3));
+              handled = true;
+            }
+            else if (pc == CDF1_ResetWave)
+            {
+              myCartridge->thumbCallback(1, read_register(2), 0);
+              handled = true;
+            }
+            else if (pc == CDF1_GetWavePtr)
+            {
+              write_register(2, myCartridge->thumbCallback(2, read_register(2), 0));
+              handled = true;
+            }
+            else if (pc == CDF1_SetWaveSize)
+            {
+              myCartridge->thumbCallback(3, read_register(2), read_register(3));
+              handled = true;
+            }
+            else if (pc == 0x0000083a)
+            {
+              // exiting Custom ARM code, returning to BUS Driver control
+            }
+            else
+            {
+  #if 0  // uncomment this for testing
+              uInt32 r0 = read_register(0);
+              uInt32 r1 = read_register(1);
+              uInt32 r2 = read_register(2);
+              uInt32 r3 = read_register(3);
+              uInt32 r4 = read_register(4);
+  #endif
+              myCartridge->thumbCallback(255, 0, 0);
+            }
+
+            break;
+
+          case ConfigureFor::DPCplus:
+            // no 32-bit subroutines in DPC+
+            break;
+        }
+
+        if (handled)
+        {
+          rc = read_register(14); // lr
+          rc += 2;
+          rc &= ~1;
+          write_register(15, rc);
+          return 0;
+        }
+
+        return 1;
+      }
+      break;
+    }
+
+    //CMN
+    case Op::cmn:
+    {
+      rn = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "cmns r" << dec << rn << ",r" << dec << rm << endl);
+      ra = read_register(rn);
+      rb = read_register(rm);
+      rc = ra + rb;
+      do_nflag(rc);
+      do_zflag(rc);
+      do_cflag(ra, rb, 0);
+      do_vflag(ra, rb, 0);
+      return 0;
+    }
+
+    //CMP(1) compare immediate
+    case Op::cmp1:
+    {
+      rb = (inst >> 0) & 0xFF;
+      rn = (inst >> 8) & 0x07;
+      DO_DISS(statusMsg << "cmp r" << dec << rn << ",#0x" << Base::HEX2 << rb << endl);
+      ra = read_register(rn);
+      rc = ra - rb;
+      //fprintf(stderr,"0x%08X 0x%08X\n",ra,rb);
+      do_nflag(rc);
+      do_zflag(rc);
+      do_cflag(ra, ~rb, 1);
+      do_vflag(ra, ~rb, 1);
+      return 0;
+    }
+
+    //CMP(2) compare register
+    case Op::cmp2:
+    {
+      rn = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "cmps r" << dec << rn << ",r" << dec << rm << endl);
+      ra = read_register(rn);
+      rb = read_register(rm);
+      rc = ra - rb;
+      //fprintf(stderr,"0x%08X 0x%08X\n",ra,rb);
+      do_nflag(rc);
+      do_zflag(rc);
+      do_cflag(ra, ~rb, 1);
+      do_vflag(ra, ~rb, 1);
+      return 0;
+    }
+
+    //CMP(3) compare high register
+    case Op::cmp3:
+    {
+      if(((inst >> 6) & 3) == 0x0)
+      {
+        //UNPREDICTABLE
+      }
+      rn = (inst >> 0) & 0x7;
+      rn |= (inst >> 4) & 0x8;
+      if(rn == 0xF)
+      {
+        //UNPREDICTABLE
+      }
+      rm = (inst >> 3) & 0xF;
+      DO_DISS(statusMsg << "cmps r" << dec << rn << ",r" << dec << rm << endl);
+      ra = read_register(rn);
+      rb = read_register(rm);
+      rc = ra - rb;
+      do_nflag(rc);
+      do_zflag(rc);
+      do_cflag(ra, ~rb, 1);
+      do_vflag(ra, ~rb, 1);
+      return 0;
+    }
+
+    //CPS
+    case Op::cps:
+    {
+      DO_DISS(statusMsg << "cps TODO" << endl);
+      return 1;
+    }
+
+    //CPY copy high register
+    case Op::cpy:
+    {
+      //same as mov except you can use both low registers
+      //going to let mov handle high registers
+      rd = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "cpy r" << dec << rd << ",r" << dec << rm << endl);
+      rc = read_register(rm);
+      write_register(rd, rc);
+      return 0;
+    }
+
+    //EOR
+    case Op::eor:
+    {
+      rd = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "eors r" << dec << rd << ",r" << dec << rm << endl);
+      ra = read_register(rd);
+      rb = read_register(rm);
+      rc = ra ^ rb;
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      return 0;
+    }
+
+    //LDMIA
+    case Op::ldmia:
+    {
+      rn = (inst >> 8) & 0x7;
+    #if defined(THUMB_DISS)
+      statusMsg << "ldmia r" << dec << rn << "!,{";
+      for(ra=0,rb=0x01,rc=0;rb;rb=(rb<<1)&0xFF,ra++)
+      {
+        if(inst&rb)
+        {
+          if(rc) statusMsg << ",";
+          statusMsg << "r" << dec << ra;
+          rc++;
+        }
+      }
+      statusMsg << "}" << endl;
+    #endif
+      sp = read_register(rn);
+      for(ra = 0, rb = 0x01; rb; rb = (rb << 1) & 0xFF, ra++)
+      {
+        if(inst & rb)
+        {
+          write_register(ra, read32(sp));
+          sp += 4;
+        }
+      }
+      //there is a write back exception.
+      if((inst & (1 << rn)) == 0)
+        write_register(rn, sp);
+
+      return 0;
+    }
+
+    //LDR(1) two register immediate
+    case Op::ldr1:
+    {
+      rd = (inst >> 0) & 0x07;
+      rn = (inst >> 3) & 0x07;
+      rb = (inst >> 6) & 0x1F;
+      rb <<= 2;
+      DO_DISS(statusMsg << "ldr r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX2 << rb << "]" << endl);
+      rb = read_register(rn) + rb;
+      rc = read32(rb);
+      write_register(rd, rc);
+      return 0;
+    }
+
+    //LDR(2) three register
+    case Op::ldr2:
+    {
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      rm = (inst >> 6) & 0x7;
+      DO_DISS(statusMsg << "ldr r" << dec << rd << ",[r" << dec << rn << ",r" << dec << "]" << endl);
+      rb = read_register(rn) + read_register(rm);
+      rc = read32(rb);
+      write_register(rd, rc);
+      return 0;
+    }
+
+    //LDR(3)
+    case Op::ldr3:
+    {
+      rb = (inst >> 0) & 0xFF;
+      rd = (inst >> 8) & 0x07;
+      rb <<= 2;
+      DO_DISS(statusMsg << "ldr r" << dec << rd << ",[PC+#0x" << Base::HEX2 << rb << "] ");
+      ra = read_register(15);
+      ra &= ~3;
+      rb += ra;
+      DO_DISS(statusMsg << ";@ 0x" << Base::HEX2 << rb << endl);
+      rc = read32(rb);
+      write_register(rd, rc);
+      return 0;
+    }
+
+    //LDR(4)
+    case Op::ldr4:
+    {
+      rb = (inst >> 0) & 0xFF;
+      rd = (inst >> 8) & 0x07;
+      rb <<= 2;
+      DO_DISS(statusMsg << "ldr r" << dec << rd << ",[SP+#0x" << Base::HEX2 << rb << "]" << endl);
+      ra = read_register(13);
+      //ra&=~3;
+      rb += ra;
+      rc = read32(rb);
+      write_register(rd, rc);
+      return 0;
+    }
+
+    //LDRB(1)
+    case Op::ldrb1:
+    {
+      rd = (inst >> 0) & 0x07;
+      rn = (inst >> 3) & 0x07;
+      rb = (inst >> 6) & 0x1F;
+      DO_DISS(statusMsg << "ldrb r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX2 << rb << "]" << endl);
+      rb = read_register(rn) + rb;
+      rc = read16(rb & (~1u));
+      if(rb & 1)
+      {
+        rc >>= 8;
+      }
+      else
+      {
+      }
+      write_register(rd, rc & 0xFF);
+      return 0;
+    }
+
+    //LDRB(2)
+    case Op::ldrb2:
+    {
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      rm = (inst >> 6) & 0x7;
+      DO_DISS(statusMsg << "ldrb r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
+      rb = read_register(rn) + read_register(rm);
+      rc = read16(rb & (~1u));
+      if(rb & 1)
+      {
+        rc >>= 8;
+      }
+      else
+      {
+      }
+      write_register(rd, rc & 0xFF);
+      return 0;
+    }
+
+    //LDRH(1)
+    case Op::ldrh1:
+    {
+      rd = (inst >> 0) & 0x07;
+      rn = (inst >> 3) & 0x07;
+      rb = (inst >> 6) & 0x1F;
+      rb <<= 1;
+      DO_DISS(statusMsg << "ldrh r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX2 << rb << "]" << endl);
+      rb=read_register(rn) + rb;
+      rc = read16(rb);
+      write_register(rd, rc & 0xFFFF);
+      return 0;
+    }
+
+    //LDRH(2)
+    case Op::ldrh2:
+    {
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      rm = (inst >> 6) & 0x7;
+      DO_DISS(statusMsg << "ldrh r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
+      rb = read_register(rn) + read_register(rm);
+      rc = read16(rb);
+      write_register(rd, rc & 0xFFFF);
+      return 0;
+    }
+
+    //LDRSB
+    case Op::ldrsb:
+    {
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      rm = (inst >> 6) & 0x7;
+      DO_DISS(statusMsg << "ldrsb r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
+      rb = read_register(rn) + read_register(rm);
+      rc = read16(rb & (~1u));
+      if(rb & 1)
+      {
+        rc >>= 8;
+      }
+      else
+      {
+      }
+      rc &= 0xFF;
+      if(rc & 0x80)
+        rc |= ((~0u) << 8);
+      write_register(rd, rc);
+      return 0;
+    }
+
+    //LDRSH
+    case Op::ldrsh:
+    {
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      rm = (inst >> 6) & 0x7;
+      DO_DISS(statusMsg << "ldrsh r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
+      rb = read_register(rn) + read_register(rm);
+      rc = read16(rb);
+      rc &= 0xFFFF;
+      if(rc & 0x8000)
+        rc |= ((~0u) << 16);
+      write_register(rd, rc);
+      return 0;
+    }
+
+    //LSL(1)
+    case Op::lsl1:
+    {
+      rd = (inst >> 0) & 0x07;
+      rm = (inst >> 3) & 0x07;
+      rb = (inst >> 6) & 0x1F;
+      DO_DISS(statusMsg << "lsls r" << dec << rd << ",r" << dec << rm << ",#0x" << Base::HEX2 << rb << endl);
+      rc = read_register(rm);
+      if(rb == 0)
+      {
+        //if immed_5 == 0
+        //C unaffected
+        //result not shifted
+      }
+      else
+      {
+        //else immed_5 > 0
+        do_cflag_bit(rc & (1 << (32-rb)));
+        rc <<= rb;
+      }
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      return 0;
+    }
+
+    //LSL(2) two register
+    case Op::lsl2:
+    {
+      rd = (inst >> 0) & 0x07;
+      rs = (inst >> 3) & 0x07;
+      DO_DISS(statusMsg << "lsls r" << dec << rd << ",r" << dec << rs << endl);
+      rc = read_register(rd);
+      rb = read_register(rs);
+      rb &= 0xFF;
+      if(rb == 0)
+      {
+      }
+      else if(rb < 32)
+      {
+        do_cflag_bit(rc & (1 << (32-rb)));
+        rc <<= rb;
+      }
+      else if(rb == 32)
+      {
+        do_cflag_bit(rc & 1);
+        rc = 0;
+      }
+      else
+      {
+        do_cflag_bit(0);
+        rc = 0;
+      }
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      return 0;
+    }
+
+    //LSR(1) two register immediate
+    case Op::lsr1:
+    {
+      rd = (inst >> 0) & 0x07;
+      rm = (inst >> 3) & 0x07;
+      rb = (inst >> 6) & 0x1F;
+      DO_DISS(statusMsg << "lsrs r" << dec << rd << ",r" << dec << rm << ",#0x" << Base::HEX2 << rb << endl);
+      rc = read_register(rm);
+      if(rb == 0)
+      {
+        do_cflag_bit(rc & 0x80000000);
+        rc = 0;
+      }
+      else
+      {
+        do_cflag_bit(rc & (1 << (rb-1)));
+        rc >>= rb;
+      }
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      return 0;
+    }
+
+    //LSR(2) two register
+    case Op::lsr2:
+    {
+      rd = (inst >> 0) & 0x07;
+      rs = (inst >> 3) & 0x07;
+      DO_DISS(statusMsg << "lsrs r" << dec << rd << ",r" << dec << rs << endl);
+      rc = read_register(rd);
+      rb = read_register(rs);
+      rb &= 0xFF;
+      if(rb == 0)
+      {
+      }
+      else if(rb < 32)
+      {
+        do_cflag_bit(rc & (1 << (rb-1)));
+        rc >>= rb;
+      }
+      else if(rb == 32)
+      {
+        do_cflag_bit(rc & 0x80000000);
+        rc = 0;
+      }
+      else
+      {
+        do_cflag_bit(0);
+        rc = 0;
+      }
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      return 0;
+    }
+
+    //MOV(1) immediate
+    case Op::mov1:
+    {
+      rb = (inst >> 0) & 0xFF;
+      rd = (inst >> 8) & 0x07;
+      DO_DISS(statusMsg << "movs r" << dec << rd << ",#0x" << Base::HEX2 << rb << endl);
+      write_register(rd, rb);
+      do_nflag(rb);
+      do_zflag(rb);
+      return 0;
+    }
+
+    //MOV(2) two low registers
+    case Op::mov2:
+    {
+      rd = (inst >> 0) & 7;
+      rn = (inst >> 3) & 7;
+      DO_DISS(statusMsg << "movs r" << dec << rd << ",r" << dec << rn << endl);
+      rc = read_register(rn);
+      //fprintf(stderr,"0x%08X\n",rc);
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      do_cflag_bit(0);
+      do_vflag_bit(0);
+      return 0;
+    }
+
+    //MOV(3)
+    case Op::mov3:
+    {
+      rd  = (inst >> 0) & 0x7;
+      rd |= (inst >> 4) & 0x8;
+      rm  = (inst >> 3) & 0xF;
+      DO_DISS(statusMsg << "mov r" << dec << rd << ",r" << dec << rm << endl);
+      rc = read_register(rm);
+      if((rd == 14) && (rm == 15))
+      {
+        //printf("mov lr,pc warning 0x%08X\n",pc-2);
+        //rc|=1;
+      }
+      if(rd == 15)
+      {
+        rc &= ~1; //write_register may do this as well
+        rc += 2;  //The program counter is special
+      }
+      write_register(rd, rc);
+      return 0;
+    }
+
+    //MUL
+    case Op::mul:
+    {
+      rd = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "muls r" << dec << rd << ",r" << dec << rm << endl);
+      ra = read_register(rd);
+      rb = read_register(rm);
+      rc = ra * rb;
+      {
+        // The multiplier terminates early when the upper bytes of the
+        // multiplier (rd) are all zero or all one
+        uInt32 m = (ra & 0x80000000) ? ~ra : ra;
+        arm_cycles += m < 0x100 ? 1 : m < 0x10000 ? 2 : m < 0x1000000 ? 3 : 4;
+      }
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      return 0;
+    }
+
+    //MVN
+    case Op::mvn:
+    {
+      rd = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "mvns r" << dec << rd << ",r" << dec << rm << endl);
+      ra = read_register(rm);
+      rc = (~ra);
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      return 0;
+    }
+
+    //NEG
+    case Op::neg:
+    {
+      rd = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "negs r" << dec << rd << ",r" << dec << rm << endl);
+      ra = read_register(rm);
+      rc = 0 - ra;
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      do_cflag(0, ~ra, 1);
+      do_vflag(0, ~ra, 1);
+      return 0;
+    }
+
+    //ORR
+    case Op::orr:
+    {
+      rd = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "orrs r" << dec << rd << ",r" << dec << rm << endl);
+      ra = read_register(rd);
+      rb = read_register(rm);
+      rc = ra | rb;
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      return 0;
+    }
+
+    //POP
+    case Op::pop:
+    {
+    #if defined(THUMB_DISS)
+      statusMsg << "pop {";
+      for(ra=0,rb=0x01,rc=0;rb;rb=(rb<<1)&0xFF,ra++)
+      {
+        if(inst&rb)
+        {
+          if(rc) statusMsg << ",";
+          statusMsg << "r" << dec << ra;
+          rc++;
+        }
+      }
+      if(inst&0x100)
+      {
+        if(rc) statusMsg << ",";
+        statusMsg << "pc";
+      }
+      statusMsg << "}" << endl;
+    #endif
+
+      sp = read_register(13);
+      for(ra = 0, rb = 0x01; rb; rb = (rb << 1) & 0xFF, ra++)
+      {
+        if(inst & rb)
+        {
+          write_register(ra, read32(sp));
+          sp += 4;
+        }
+      }
+      if(inst & 0x100)
+      {
+        rc = read32(sp);
+        rc += 2;
+        write_register(15, rc);
+        sp += 4;
+      }
+      write_register(13, sp);
+      return 0;
+    }
+
+    //PUSH
+    case Op::push:
+    {
+    #if defined(THUMB_DISS)
+      statusMsg << "push {";
+      for(ra=0,rb=0x01,rc=0;rb;rb=(rb<<1)&0xFF,ra++)
+      {
+        if(inst&rb)
+        {
+          if(rc) statusMsg << ",";
+          statusMsg << "r" << dec << ra;
+          rc++;
+        }
+      }
+      if(inst&0x100)
+      {
+        if(rc) statusMsg << ",";
+        statusMsg << "lr";
+      }
+      statusMsg << "}" << endl;
+    #endif
+
+      sp = read_register(13);
+      //fprintf(stderr,"sp 0x%08X\n",sp);
+      for(ra = 0, rb = 0x01, rc = 0; rb; rb = (rb << 1) & 0xFF, ra++)
+      {
+        if(inst & rb)
+        {
+          rc++;
+        }
+      }
+      if(inst & 0x100) rc++;
+      rc <<= 2;
+      sp -= rc;
+      rd = sp;
+      for(ra = 0, rb = 0x01; rb; rb = (rb << 1) & 0xFF, ra++)
+      {
+        if(inst & rb)
+        {
+          write32<C>(rd, read_register(ra));
+          rd += 4;
+        }
+      }
+      if(inst & 0x100)
+      {
+        rc = read_register(14);
+        write32<C>(rd, rc);
+        if((rc & 1) == 0)
+        {
+          // FIXME fprintf(stderr,"push {lr} with an ARM address pc 0x%08X popped 0x%08X\n",pc,rc);
+        }
+      }
+      write_register(13, sp);
+      return 0;
+    }
+
+    //REV
+    case Op::rev:
+    {
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "rev r" << dec << rd << ",r" << dec << rn << endl);
+      ra = read_register(rn);
+      rc  = ((ra >>  0) & 0xFF) << 24;
+      rc |= ((ra >>  8) & 0xFF) << 16;
+      rc |= ((ra >> 16) & 0xFF) <<  8;
+      rc |= ((ra >> 24) & 0xFF) <<  0;
+      write_register(rd, rc);
+      return 0;
+    }
+
+    //REV16
+    case Op::rev16:
+    {
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "rev16 r" << dec << rd << ",r" << dec << rn << endl);
+      ra = read_register(rn);
+      rc  = ((ra >>  0) & 0xFF) <<  8;
+      rc |= ((ra >>  8) & 0xFF) <<  0;
+      rc |= ((ra >> 16) & 0xFF) << 24;
+      rc |= ((ra >> 24) & 0xFF) << 16;
+      write_register(rd, rc);
+      return 0;
+    }
+
+    //REVSH
+    case Op::revsh:
+    {
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "revsh r" << dec << rd << ",r" << dec << rn << endl);
+      ra = read_register(rn);
+      rc  = ((ra >> 0) & 0xFF) << 8;
+      rc |= ((ra >> 8) & 0xFF) << 0;
+      if(rc & 0x8000) rc |= 0xFFFF0000;
+      else            rc &= 0x0000FFFF;
+      write_register(rd, rc);
+      return 0;
+    }
+
+    //ROR
+    case Op::ror:
+    {
+      rd = (inst >> 0) & 0x7;
+      rs = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "rors r" << dec << rd << ",r" << dec << rs << endl);
+      rc = read_register(rd);
+      ra = read_register(rs);
+      ra &= 0xFF;
+      if(ra == 0)
+      {
+      }
+      else
+      {
+        ra &= 0x1F;
+        if(ra == 0)
+        {
+          do_cflag_bit(rc & 0x80000000);
+        }
+        else
+        {
+          do_cflag_bit(rc & (1 << (ra-1)));
+          rb = rc << (32-ra);
+          rc >>= ra;
+          rc |= rb;
+        }
+      }
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      return 0;
+    }
+
+    //SBC
+    case Op::sbc:
     {
-      if(inst&rb)
+      rd = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "sbc r" << dec << rd << ",r" << dec << rm << endl);
+      ra = read_register(rd);
+      rb = read_register(rm);
+      rc = ra - rb;
+      if(!(cpsr & CPSR_C)) rc--;
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      if(cpsr & CPSR_C)
       {
-        if(rc) statusMsg << ",";
-        statusMsg << "r" << dec << ra;
-        rc++;
+        do_cflag(ra, ~rb, 1);
+        do_vflag(ra, ~rb, 1);
+      }
+      else
+      {
+        do_cflag(ra, ~rb, 0);
+        do_vflag(ra, ~rb, 0);
       }
+      return 0;
     }
-    if(inst&0x100)
+
+    //SETEND
+    case Op::setend:
     {
-      if(rc) statusMsg << ",";
-      statusMsg << "pc";
+      statusMsg << "setend not implemented" << endl;
+      return 1;
     }
-    statusMsg << "}" << endl;
-  #endif
 
-    sp = read_register(13);
-    for(ra = 0, rb = 0x01; rb; rb = (rb << 1) & 0xFF, ra++)
+    //STMIA
+    case Op::stmia:
     {
-      if(inst & rb)
+      rn = (inst >> 8) & 0x7;
+    #if defined(THUMB_DISS)
+      statusMsg << "stmia r" << dec << rn << "!,{";
+      for(ra=0,rb=0x01,rc=0;rb;rb=(rb<<1)&0xFF,ra++)
       {
-        write_register(ra, read32(sp));
-        sp += 4;
+        if(inst & rb)
+        {
+          if(rc) statusMsg << ",";
+          statusMsg << "r" << dec << ra;
+          rc++;
+        }
+      }
+      statusMsg << "}" << endl;
+    #endif
+
+      sp = read_register(rn);
+      for(ra = 0, rb = 0x01; rb; rb = (rb << 1) & 0xFF, ra++)
+      {
+        if(inst & rb)
+        {
+          write32<C>(sp, read_register(ra));
+          sp += 4;
+        }
       }
+      write_register(rn, sp);
+      return 0;
     }
-    if(inst & 0x100)
+
+    //STR(1)
+    case Op::str1:
     {
-      rc = read32(sp);
-      rc += 2;
-      write_register(15, rc);
-      sp += 4;
+      rd = (inst >> 0) & 0x07;
+      rn = (inst >> 3) & 0x07;
+      rb = (inst >> 6) & 0x1F;
+      rb <<= 2;
+      DO_DISS(statusMsg << "str r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX2 << rb << "]" << endl);
+      rb = read_register(rn) + rb;
+      rc = read_register(rd);
+      write32<C>(rb, rc);
+      return 0;
     }
-    write_register(13, sp);
-    return 0;
-  }
 
-  //PUSH
-  if((inst & 0xFE00) == 0xB400)
-  {
-  #if defined(THUMB_DISS)
-    statusMsg << "push {";
-    for(ra=0,rb=0x01,rc=0;rb;rb=(rb<<1)&0xFF,ra++)
+    //STR(2)
+    case Op::str2:
     {
-      if(inst&rb)
-      {
-        if(rc) statusMsg << ",";
-        statusMsg << "r" << dec << ra;
-        rc++;
-      }
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      rm = (inst >> 6) & 0x7;
+      DO_DISS(statusMsg << "str r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
+      rb = read_register(rn) + read_register(rm);
+      rc = read_register(rd);
+      write32<C>(rb, rc);
+      return 0;
     }
-    if(inst&0x100)
+
+    //STR(3)
+    case Op::str3:
     {
-      if(rc) statusMsg << ",";
-      statusMsg << "lr";
+      rb = (inst >> 0) & 0xFF;
+      rd = (inst >> 8) & 0x07;
+      rb <<= 2;
+      DO_DISS(statusMsg << "str r" << dec << rd << ",[SP,#0x" << Base::HEX2 << rb << "]" << endl);
+      rb = read_register(13) + rb;
+      //fprintf(stderr,"0x%08X\n",rb);
+      rc = read_register(rd);
+      write32<C>(rb, rc);
+      return 0;
     }
-    statusMsg << "}" << endl;
-  #endif
 
-    sp = read_register(13);
-    //fprintf(stderr,"sp 0x%08X\n",sp);
-    for(ra = 0, rb = 0x01, rc = 0; rb; rb = (rb << 1) & 0xFF, ra++)
+    //STRB(1)
+    case Op::strb1:
     {
-      if(inst & rb)
+      rd = (inst >> 0) & 0x07;
+      rn = (inst >> 3) & 0x07;
+      rb = (inst >> 6) & 0x1F;
+      DO_DISS(statusMsg << "strb r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX8 << rb << "]" << endl);
+      rb = read_register(rn) + rb;
+      rc = read_register(rd);
+      ra = read16(rb & (~1u));
+      if(rb & 1)
       {
-        rc++;
+        ra &= 0x00FF;
+        ra |= rc << 8;
       }
-    }
-    if(inst & 0x100) rc++;
-    rc <<= 2;
-    sp -= rc;
-    rd = sp;
-    for(ra = 0, rb = 0x01; rb; rb = (rb << 1) & 0xFF, ra++)
-    {
-      if(inst & rb)
+      else
       {
-        write32(rd, read_register(ra));
-        rd += 4;
+        ra &= 0xFF00;
+        ra |= rc & 0x00FF;
       }
+      write16<C>(rb & (~1u), ra & 0xFFFF);
+      return 0;
     }
-    if(inst & 0x100)
+
+    //STRB(2)
+    case Op::strb2:
     {
-      rc = read_register(14);
-      write32(rd, rc);
-      if((rc & 1) == 0)
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      rm = (inst >> 6) & 0x7;
+      DO_DISS(statusMsg << "strb r" << dec << rd << ",[r" << dec << rn << ",r" << rm << "]" << endl);
+      rb = read_register(rn) + read_register(rm);
+      rc = read_register(rd);
+      ra = read16(rb & (~1u));
+      if(rb & 1)
+      {
+        ra &= 0x00FF;
+        ra |= rc << 8;
+      }
+      else
       {
-        // FIXME fprintf(stderr,"push {lr} with an ARM address pc 0x%08X popped 0x%08X\n",pc,rc);
+        ra &= 0xFF00;
+        ra |= rc & 0x00FF;
       }
+      write16<C>(rb & (~1u), ra & 0xFFFF);
+      return 0;
     }
-    write_register(13, sp);
-    return 0;
-  }
 
-  //REV
-  if((inst & 0xFFC0) == 0xBA00)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "rev r" << dec << rd << ",r" << dec << rn << endl);
-    ra = read_register(rn);
-    rc  = ((ra >>  0) & 0xFF) << 24;
-    rc |= ((ra >>  8) & 0xFF) << 16;
-    rc |= ((ra >> 16) & 0xFF) <<  8;
-    rc |= ((ra >> 24) & 0xFF) <<  0;
-    write_register(rd, rc);
-    return 0;
-  }
-
-  //REV16
-  if((inst & 0xFFC0) == 0xBA40)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "rev16 r" << dec << rd << ",r" << dec << rn << endl);
-    ra = read_register(rn);
-    rc  = ((ra >>  0) & 0xFF) <<  8;
-    rc |= ((ra >>  8) & 0xFF) <<  0;
-    rc |= ((ra >> 16) & 0xFF) << 24;
-    rc |= ((ra >> 24) & 0xFF) << 16;
-    write_register(rd, rc);
-    return 0;
-  }
-
-  //REVSH
-  if((inst & 0xFFC0) == 0xBAC0)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "revsh r" << dec << rd << ",r" << dec << rn << endl);
-    ra = read_register(rn);
-    rc  = ((ra >> 0) & 0xFF) << 8;
-    rc |= ((ra >> 8) & 0xFF) << 0;
-    if(rc & 0x8000) rc |= 0xFFFF0000;
-    else            rc &= 0x0000FFFF;
-    write_register(rd, rc);
-    return 0;
-  }
-
-  //ROR
-  if((inst & 0xFFC0) == 0x41C0)
-  {
-    rd = (inst >> 0) & 0x7;
-    rs = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "rors r" << dec << rd << ",r" << dec << rs << endl);
-    rc = read_register(rd);
-    ra = read_register(rs);
-    ra &= 0xFF;
-    if(ra == 0)
+    //STRH(1)
+    case Op::strh1:
     {
+      rd = (inst >> 0) & 0x07;
+      rn = (inst >> 3) & 0x07;
+      rb = (inst >> 6) & 0x1F;
+      rb <<= 1;
+      DO_DISS(statusMsg << "strh r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX2 << rb << "]" << endl);
+      rb = read_register(rn) + rb;
+      rc=  read_register(rd);
+      write16<C>(rb, rc & 0xFFFF);
+      return 0;
     }
-    else
+
+    //STRH(2)
+    case Op::strh2:
     {
-      ra &= 0x1F;
-      if(ra == 0)
-      {
-        do_cflag_bit(rc & 0x80000000);
-      }
-      else
-      {
-        do_cflag_bit(rc & (1 << (ra-1)));
-        rb = rc << (32-ra);
-        rc >>= ra;
-        rc |= rb;
-      }
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      rm = (inst >> 6) & 0x7;
+      DO_DISS(statusMsg << "strh r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
+      rb = read_register(rn) + read_register(rm);
+      rc = read_register(rd);
+      write16<C>(rb, rc & 0xFFFF);
+      return 0;
     }
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    return 0;
-  }
 
-  //SBC
-  if((inst & 0xFFC0) == 0x4180)
-  {
-    rd = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "sbc r" << dec << rd << ",r" << dec << rm << endl);
-    ra = read_register(rd);
-    rb = read_register(rm);
-    rc = ra - rb;
-    if(!(cpsr & CPSR_C)) rc--;
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    if(cpsr & CPSR_C)
+    //SUB(1)
+    case Op::sub1:
     {
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      rb = (inst >> 6) & 0x7;
+      DO_DISS(statusMsg << "subs r" << dec << rd << ",r" << dec << rn << ",#0x" << Base::HEX2 << rb << endl);
+      ra = read_register(rn);
+      rc = ra - rb;
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
       do_cflag(ra, ~rb, 1);
       do_vflag(ra, ~rb, 1);
+      return 0;
     }
-    else
+
+    //SUB(2)
+    case Op::sub2:
     {
-      do_cflag(ra, ~rb, 0);
-      do_vflag(ra, ~rb, 0);
+      rb = (inst >> 0) & 0xFF;
+      rd = (inst >> 8) & 0x07;
+      DO_DISS(statusMsg << "subs r" << dec << rd << ",#0x" << Base::HEX2 << rb << endl);
+      ra = read_register(rd);
+      rc = ra - rb;
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      do_cflag(ra, ~rb, 1);
+      do_vflag(ra, ~rb, 1);
+      return 0;
     }
-    return 0;
-  }
 
-  //SETEND
-  if((inst & 0xFFF7) == 0xB650)
-  {
-    statusMsg << "setend not implemented" << endl;
-    return 1;
-  }
+    //SUB(3)
+    case Op::sub3:
+    {
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      rm = (inst >> 6) & 0x7;
+      DO_DISS(statusMsg << "subs r" << dec << rd << ",r" << dec << rn << ",r" << dec << rm << endl);
+      ra = read_register(rn);
+      rb = read_register(rm);
+      rc = ra - rb;
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      do_cflag(ra, ~rb, 1);
+      do_vflag(ra, ~rb, 1);
+      return 0;
+    }
 
-  //STMIA
-  if((inst & 0xF800) == 0xC000)
-  {
-    rn = (inst >> 8) & 0x7;
-  #if defined(THUMB_DISS)
-    statusMsg << "stmia r" << dec << rn << "!,{";
-    for(ra=0,rb=0x01,rc=0;rb;rb=(rb<<1)&0xFF,ra++)
+    //SUB(4)
+    case Op::sub4:
     {
-      if(inst & rb)
-      {
-        if(rc) statusMsg << ",";
-        statusMsg << "r" << dec << ra;
-        rc++;
-      }
+      rb = inst & 0x7F;
+      rb <<= 2;
+      DO_DISS(statusMsg << "sub SP,#0x" << Base::HEX2 << rb << endl);
+      ra = read_register(13);
+      ra -= rb;
+      write_register(13, ra);
+      return 0;
     }
-    statusMsg << "}" << endl;
-  #endif
 
-    sp = read_register(rn);
-    for(ra = 0, rb = 0x01; rb; rb = (rb << 1) & 0xFF, ra++)
+    //SWI
+    case Op::swi:
     {
-      if(inst & rb)
+      rb = inst & 0xFF;
+      DO_DISS(statusMsg << "swi 0x" << Base::HEX2 << rb << endl);
+
+      if((inst & 0xFF) == 0xCC)
       {
-        write32(sp, read_register(ra));
-        sp += 4;
+        write_register(0, cpsr);
+        return 0;
       }
+      else
+      {
+        statusMsg << endl << endl << "swi 0x" << Base::HEX2 << rb << endl;
+        return 1;
+      }
+      break;
     }
-    write_register(rn, sp);
-    return 0;
-  }
-
-  //STR(1)
-  if((inst & 0xF800) == 0x6000)
-  {
-    rd = (inst >> 0) & 0x07;
-    rn = (inst >> 3) & 0x07;
-    rb = (inst >> 6) & 0x1F;
-    rb <<= 2;
-    DO_DISS(statusMsg << "str r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX2 << rb << "]" << endl);
-    rb = read_register(rn) + rb;
-    rc = read_register(rd);
-    write32(rb, rc);
-    return 0;
-  }
-
-  //STR(2)
-  if((inst & 0xFE00) == 0x5000)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    rm = (inst >> 6) & 0x7;
-    DO_DISS(statusMsg << "str r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
-    rb = read_register(rn) + read_register(rm);
-    rc = read_register(rd);
-    write32(rb, rc);
-    return 0;
-  }
-
-  //STR(3)
-  if((inst & 0xF800) == 0x9000)
-  {
-    rb = (inst >> 0) & 0xFF;
-    rd = (inst >> 8) & 0x07;
-    rb <<= 2;
-    DO_DISS(statusMsg << "str r" << dec << rd << ",[SP,#0x" << Base::HEX2 << rb << "]" << endl);
-    rb = read_register(13) + rb;
-    //fprintf(stderr,"0x%08X\n",rb);
-    rc = read_register(rd);
-    write32(rb, rc);
-    return 0;
-  }
 
-  //STRB(1)
-  if((inst & 0xF800) == 0x7000)
-  {
-    rd = (inst >> 0) & 0x07;
-    rn = (inst >> 3) & 0x07;
-    rb = (inst >> 6) & 0x1F;
-    DO_DISS(statusMsg << "strb r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX8 << rb << "]" << endl);
-    rb = read_register(rn) + rb;
-    rc = read_register(rd);
-    ra = read16(rb & (~1u));
-    if(rb & 1)
-    {
-      ra &= 0x00FF;
-      ra |= rc << 8;
-    }
-    else
+    //SXTB
+    case Op::sxtb:
     {
-      ra &= 0xFF00;
-      ra |= rc & 0x00FF;
+      rd = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "sxtb r" << dec << rd << ",r" << dec << rm << endl);
+      ra = read_register(rm);
+      rc = ra & 0xFF;
+      if(rc & 0x80)
+        rc |= (~0u) << 8;
+      write_register(rd, rc);
+      return 0;
     }
-    write16(rb & (~1u), ra & 0xFFFF);
-    return 0;
-  }
 
-  //STRB(2)
-  if((inst & 0xFE00) == 0x5400)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    rm = (inst >> 6) & 0x7;
-    DO_DISS(statusMsg << "strb r" << dec << rd << ",[r" << dec << rn << ",r" << rm << "]" << endl);
-    rb = read_register(rn) + read_register(rm);
-    rc = read_register(rd);
-    ra = read16(rb & (~1u));
-    if(rb & 1)
-    {
-      ra &= 0x00FF;
-      ra |= rc << 8;
-    }
-    else
+    //SXTH
+    case Op::sxth:
     {
-      ra &= 0xFF00;
-      ra |= rc & 0x00FF;
+      rd = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "sxth r" << dec << rd << ",r" << dec << rm << endl);
+      ra = read_register(rm);
+      rc = ra & 0xFFFF;
+      if(rc & 0x8000)
+        rc |= (~0u) << 16;
+      write_register(rd, rc);
+      return 0;
     }
-    write16(rb & (~1u), ra & 0xFFFF);
-    return 0;
-  }
-
-  //STRH(1)
-  if((inst & 0xF800) == 0x8000)
-  {
-    rd = (inst >> 0) & 0x07;
-    rn = (inst >> 3) & 0x07;
-    rb = (inst >> 6) & 0x1F;
-    rb <<= 1;
-    DO_DISS(statusMsg << "strh r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX2 << rb << "]" << endl);
-    rb = read_register(rn) + rb;
-    rc=  read_register(rd);
-    write16(rb, rc & 0xFFFF);
-    return 0;
-  }
-
-  //STRH(2)
-  if((inst & 0xFE00) == 0x5200)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    rm = (inst >> 6) & 0x7;
-    DO_DISS(statusMsg << "strh r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
-    rb = read_register(rn) + read_register(rm);
-    rc = read_register(rd);
-    write16(rb, rc & 0xFFFF);
-    return 0;
-  }
-
-  //SUB(1)
-  if((inst & 0xFE00) == 0x1E00)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    rb = (inst >> 6) & 0x7;
-    DO_DISS(statusMsg << "subs r" << dec << rd << ",r" << dec << rn << ",#0x" << Base::HEX2 << rb << endl);
-    ra = read_register(rn);
-    rc = ra - rb;
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    do_cflag(ra, ~rb, 1);
-    do_vflag(ra, ~rb, 1);
-    return 0;
-  }
-
-  //SUB(2)
-  if((inst & 0xF800) == 0x3800)
-  {
-    rb = (inst >> 0) & 0xFF;
-    rd = (inst >> 8) & 0x07;
-    DO_DISS(statusMsg << "subs r" << dec << rd << ",#0x" << Base::HEX2 << rb << endl);
-    ra = read_register(rd);
-    rc = ra - rb;
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    do_cflag(ra, ~rb, 1);
-    do_vflag(ra, ~rb, 1);
-    return 0;
-  }
 
-  //SUB(3)
-  if((inst & 0xFE00) == 0x1A00)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    rm = (inst >> 6) & 0x7;
-    DO_DISS(statusMsg << "subs r" << dec << rd << ",r" << dec << rn << ",r" << dec << rm << endl);
-    ra = read_register(rn);
-    rb = read_register(rm);
-    rc = ra - rb;
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    do_cflag(ra, ~rb, 1);
-    do_vflag(ra, ~rb, 1);
-    return 0;
-  }
-
-  //SUB(4)
-  if((inst & 0xFF80) == 0xB080)
-  {
-    rb = inst & 0x7F;
-    rb <<= 2;
-    DO_DISS(statusMsg << "sub SP,#0x" << Base::HEX2 << rb << endl);
-    ra = read_register(13);
-    ra -= rb;
-    write_register(13, ra);
-    return 0;
-  }
-
-  //SWI
-  if((inst & 0xFF00) == 0xDF00)
-  {
-    rb = inst & 0xFF;
-    DO_DISS(statusMsg << "swi 0x" << Base::HEX2 << rb << endl);
-
-    if((inst & 0xFF) == 0xCC)
+    //TST
+    case Op::tst:
     {
-      write_register(0, cpsr);
+      rn = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "tst r" << dec << rn << ",r" << dec << rm << endl);
+      ra = read_register(rn);
+      rb = read_register(rm);
+      rc = ra & rb;
+      do_nflag(rc);
+      do_zflag(rc);
       return 0;
     }
-    else
+
+    //UXTB
+    case Op::uxtb:
     {
-      statusMsg << endl << endl << "swi 0x" << Base::HEX2 << rb << endl;
-      return 1;
+      rd = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "uxtb r" << dec << rd << ",r" << dec << rm << endl);
+      ra = read_register(rm);
+      rc = ra & 0xFF;
+      write_register(rd, rc);
+      return 0;
     }
-  }
-
-  //SXTB
-  if((inst & 0xFFC0) == 0xB240)
-  {
-    rd = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "sxtb r" << dec << rd << ",r" << dec << rm << endl);
-    ra = read_register(rm);
-    rc = ra & 0xFF;
-    if(rc & 0x80)
-      rc |= (~0u) << 8;
-    write_register(rd, rc);
-    return 0;
-  }
-
-  //SXTH
-  if((inst & 0xFFC0) == 0xB200)
-  {
-    rd = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "sxth r" << dec << rd << ",r" << dec << rm << endl);
-    ra = read_register(rm);
-    rc = ra & 0xFFFF;
-    if(rc & 0x8000)
-      rc |= (~0u) << 16;
-    write_register(rd, rc);
-    return 0;
-  }
-
-  //TST
-  if((inst & 0xFFC0) == 0x4200)
-  {
-    rn = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "tst r" << dec << rn << ",r" << dec << rm << endl);
-    ra = read_register(rn);
-    rb = read_register(rm);
-    rc = ra & rb;
-    do_nflag(rc);
-    do_zflag(rc);
-    return 0;
-  }
 
-  //UXTB
-  if((inst & 0xFFC0) == 0xB2C0)
-  {
-    rd = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "uxtb r" << dec << rd << ",r" << dec << rm << endl);
-    ra = read_register(rm);
-    rc = ra & 0xFF;
-    write_register(rd, rc);
-    return 0;
-  }
+    //UXTH
+    case Op::uxth:
+    {
+      rd = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "uxth r" << dec << rd << ",r" << dec << rm << endl);
+      ra = read_register(rm);
+      rc = ra & 0xFFFF;
+      write_register(rd, rc);
+      return 0;
+    }
 
-  //UXTH
-  if((inst & 0xFFC0) == 0xB280)
-  {
-    rd = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "uxth r" << dec << rd << ",r" << dec << rm << endl);
-    ra = read_register(rm);
-    rc = ra & 0xFFFF;
-    write_register(rd, rc);
-    return 0;
+    case Op::invalid:
+      break;
   }
 
   statusMsg << "invalid instruction " << Base::HEX8 << pc << " " << Base::HEX4 << inst << endl;
@@ -2351,11 +2867,177 @@ int Thumbulator::reset()
 
   // fxq: don't care about below so much (maybe to guess timing???)
   instructions = fetches = reads = writes = systick_ints = 0;
-
-  statusMsg.str("");
+  arm_cycles = 0;
+  fetch_line = prefetch_line = data_line = ~0u;
 
   return 0;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string Thumbulator::disassemble(uInt32 addr) const
+{
+  uInt16 inst;
+  switch(addr & 0xF0000000)
+  {
+    case 0x00000000: //ROM
+      inst = CONV_RAMROM(rom[(addr & ROMADDMASK) >> 1]);
+      break;
+    case 0x40000000: //RAM
+      inst = CONV_RAMROM(ram[(addr & RAMADDMASK) >> 1]);
+      break;
+    default:
+      return "";
+  }
+  return disassemble(addr, inst);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string Thumbulator::disassemble(uInt32 addr, uInt16 inst)
+{
+  static const char* const regs[16] = {
+    "r0", "r1", "r2", "r3", "r4", "r5", "r6", "r7",
+    "r8", "r9", "r10", "r11", "r12", "sp", "lr", "pc"
+  };
+  static const char* const conds[14] = {
+    "eq", "ne", "cs", "cc", "mi", "pl", "vs", "vc",
+    "hi", "ls", "ge", "lt", "gt", "le"
+  };
+
+  // The register and immediate fields, by position in the instruction
+  const char* const r0 = regs[inst & 0x7];
+  const char* const r3 = regs[(inst >> 3) & 0x7];
+  const char* const r6 = regs[(inst >> 6) & 0x7];
+  const char* const r8 = regs[(inst >> 8) & 0x7];
+  const char* const hd = regs[(inst & 0x7) | ((inst >> 4) & 0x8)];
+  const char* const hm = regs[(inst >> 3) & 0xF];
+  const uInt32 imm3 = (inst >> 6) & 0x7, imm5 = (inst >> 6) & 0x1F,
+               imm8 = inst & 0xFF;
+
+  ostringstream buf;
+  buf << std::hex;
+
+  // Register lists of LDMIA/STMIA/PUSH/POP
+  auto reglist = [&](const char* extra) {
+    buf << "{";
+    bool first = true;
+    for(int r = 0; r < 8; ++r)
+      if(inst & (1 << r))
+      {
+        buf << (first ? "" : ",") << regs[r];
+        first = false;
+      }
+    if(extra && (inst & 0x100))
+      buf << (first ? "" : ",") << extra;
+    buf << "}";
+  };
+
+  switch(decodeInstructionWord(inst))
+  {
+    case Op::adc:   buf << "adcs "  << r0 << "," << r3; break;
+    case Op::add1:  buf << "adds "  << r0 << "," << r3 << ",#0x" << imm3; break;
+    case Op::add2:  buf << "adds "  << r8 << ",#0x" << imm8; break;
+    case Op::add3:  buf << "adds "  << r0 << "," << r3 << "," << r6; break;
+    case Op::add4:  buf << "add "   << hd << "," << hm; break;
+    case Op::add5:  buf << "add "   << r8 << ",pc,#0x" << (imm8 << 2); break;
+    case Op::add6:  buf << "add "   << r8 << ",sp,#0x" << (imm8 << 2); break;
+    case Op::add7:  buf << "add sp,#0x" << ((inst & 0x7F) << 2); break;
+    case Op::and_:  buf << "ands "  << r0 << "," << r3; break;
+    case Op::asr1:  buf << "asrs "  << r0 << "," << r3 << ",#0x" << imm5; break;
+    case Op::asr2:  buf << "asrs "  << r0 << "," << r3; break;
+    case Op::b1:
+    {
+      uInt32 offset = imm8;
+      if(offset & 0x80) offset |= (~0u) << 8;
+      buf << "b" << conds[(inst >> 8) & 0xF] << " 0x" << (addr + 4 + (offset << 1));
+      break;
+    }
+    case Op::b2:
+    {
+      uInt32 offset = inst & 0x7FF;
+      if(offset & 0x400) offset |= (~0u) << 11;
+      buf << "b 0x" << (addr + 4 + (offset << 1));
+      break;
+    }
+    case Op::bic:   buf << "bics "  << r0 << "," << r3; break;
+    case Op::bkpt:  buf << "bkpt 0x" << imm8; break;
+    case Op::blx1:
+      // The first half of BL sets up LR, the second half adds to it
+      if((inst & 0x1800) == 0x1000)
+      {
+        uInt32 offset = inst & 0x7FF;
+        if(offset & 0x400) offset |= (~0u) << 11;
+        buf << "bl (lr = 0x" << (addr + 4 + (offset << 12)) << ")";
+      }
+      else
+        buf << ((inst & 0x1800) == 0x1800 ? "bl" : "blx")
+            << " lr+0x" << ((inst & 0x7FF) << 1);
+      break;
+    case Op::blx2:  buf << "blx "   << hm; break;
+    case Op::bx:    buf << "bx "    << hm; break;
+    case Op::cmn:   buf << "cmn "   << r0 << "," << r3; break;
+    case Op::cmp1:  buf << "cmp "   << r8 << ",#0x" << imm8; break;
+    case Op::cmp2:  buf << "cmp "   << r0 << "," << r3; break;
+    case Op::cmp3:  buf << "cmp "   << hd << "," << hm; break;
+    case Op::cps:   buf << "cps"; break;
+    case Op::cpy:   buf << "cpy "   << r0 << "," << r3; break;
+    case Op::eor:   buf << "eors "  << r0 << "," << r3; break;
+    case Op::ldmia: buf << "ldmia " << r8 << "!,"; reglist(nullptr); break;
+    case Op::ldr1:  buf << "ldr "   << r0 << ",[" << r3 << ",#0x" << (imm5 << 2) << "]"; break;
+    case Op::ldr2:  buf << "ldr "   << r0 << ",[" << r3 << "," << r6 << "]"; break;
+    case Op::ldr3:
+      buf << "ldr " << r8 << ",[pc,#0x" << (imm8 << 2) << "] ; @ 0x"
+          << (((addr + 4) & ~3u) + (imm8 << 2));
+      break;
+    case Op::ldr4:  buf << "ldr "   << r8 << ",[sp,#0x" << (imm8 << 2) << "]"; break;
+    case Op::ldrb1: buf << "ldrb "  << r0 << ",[" << r3 << ",#0x" << imm5 << "]"; break;
+    case Op::ldrb2: buf << "ldrb "  << r0 << ",[" << r3 << "," << r6 << "]"; break;
+    case Op::ldrh1: buf << "ldrh "  << r0 << ",[" << r3 << ",#0x" << (imm5 << 1) << "]"; break;
+    case Op::ldrh2: buf << "ldrh "  << r0 << ",[" << r3 << "," << r6 << "]"; break;
+    case Op::ldrsb: buf << "ldrsb " << r0 << ",[" << r3 << "," << r6 << "]"; break;
+    case Op::ldrsh: buf << "ldrsh " << r0 << ",[" << r3 << "," << r6 << "]"; break;
+    case Op::lsl1:  buf << "lsls "  << r0 << "," << r3 << ",#0x" << imm5; break;
+    case Op::lsl2:  buf << "lsls "  << r0 << "," << r3; break;
+    case Op::lsr1:  buf << "lsrs "  << r0 << "," << r3 << ",#0x" << imm5; break;
+    case Op::lsr2:  buf << "lsrs "  << r0 << "," << r3; break;
+    case Op::mov1:  buf << "movs "  << r8 << ",#0x" << imm8; break;
+    case Op::mov2:  buf << "movs "  << r0 << "," << r3; break;
+    case Op::mov3:  buf << "mov "   << hd << "," << hm; break;
+    case Op::mul:   buf << "muls "  << r0 << "," << r3; break;
+    case Op::mvn:   buf << "mvns "  << r0 << "," << r3; break;
+    case Op::neg:   buf << "negs "  << r0 << "," << r3; break;
+    case Op::orr:   buf << "orrs "  << r0 << "," << r3; break;
+    case Op::pop:   buf << "pop ";  reglist("pc"); break;
+    case Op::push:  buf << "push "; reglist("lr"); break;
+    case Op::rev:   buf << "rev "   << r0 << "," << r3; break;
+    case Op::rev16: buf << "rev16 " << r0 << "," << r3; break;
+    case Op::revsh: buf << "revsh " << r0 << "," << r3; break;
+    case Op::ror:   buf << "rors "  << r0 << "," << r3; break;
+    case Op::sbc:   buf << "sbcs "  << r0 << "," << r3; break;
+    case Op::setend: buf << "setend"; break;
+    case Op::stmia: buf << "stmia " << r8 << "!,"; reglist(nullptr); break;
+    case Op::str1:  buf << "str "   << r0 << ",[" << r3 << ",#0x" << (imm5 << 2) << "]"; break;
+    case Op::str2:  buf << "str "   << r0 << ",[" << r3 << "," << r6 << "]"; break;
+    case Op::str3:  buf << "str "   << r8 << ",[sp,#0x" << (imm8 << 2) << "]"; break;
+    case Op::strb1: buf << "strb "  << r0 << ",[" << r3 << ",#0x" << imm5 << "]"; break;
+    case Op::strb2: buf << "strb "  << r0 << ",[" << r3 << "," << r6 << "]"; break;
+    case Op::strh1: buf << "strh "  << r0 << ",[" << r3 << ",#0x" << (imm5 << 1) << "]"; break;
+    case Op::strh2: buf << "strh "  << r0 << ",[" << r3 << "," << r6 << "]"; break;
+    case Op::sub1:  buf << "subs "  << r0 << "," << r3 << ",#0x" << imm3; break;
+    case Op::sub2:  buf << "subs "  << r8 << ",#0x" << imm8; break;
+    case Op::sub3:  buf << "subs "  << r0 << "," << r3 << "," << r6; break;
+    case Op::sub4:  buf << "sub sp,#0x" << ((inst & 0x7F) << 2); break;
+    case Op::swi:   buf << "swi 0x" << imm8; break;
+    case Op::sxtb:  buf << "sxtb "  << r0 << "," << r3; break;
+    case Op::sxth:  buf << "sxth "  << r0 << "," << r3; break;
+    case Op::tst:   buf << "tst "   << r0 << "," << r3; break;
+    case Op::uxtb:  buf << "uxtb "  << r0 << "," << r3; break;
+    case Op::uxth:  buf << "uxth "  << r0 << "," << r3; break;
+    case Op::invalid:
+      buf << ".hword 0x" << inst;
+      break;
+  }
+  return buf.str();
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool Thumbulator::trapOnFatal = true;
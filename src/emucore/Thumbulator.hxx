@@ -68,11 +68,19 @@ class Thumbulator
       thrown in case of any fatal errors/aborts (if enabled), containing the
       actual error, and the contents of the registers at that point in time.
 
-      @return  The results of any debugging output (if enabled),
-               otherwise an empty string
+      Since this is called several times per frame, a successful call does
+      no more than set up the registers and run the code; in particular,
+      no strings are built unless something is reported.
     */
-    string run();
-    string run(uInt32 cycles);
+    void run();
+    void run(uInt32 cycles);
+
+    /**
+      Answers anything reported during the last call to run(): fatal errors
+      when these aren't trapped, breakpoints and unimplemented instructions,
+      and any debugging output (if enabled).  Normally an empty string.
+    */
+    string statusMessage() const { return statusMsg.str(); }
 
     /**
       Normally when a fatal error is encountered, the ARM emulation
@@ -95,16 +103,104 @@ class Thumbulator
     */
     void setConsoleTiming(ConsoleTiming timing);
 
+    /**
+      Inform the Thumbulator class that a byte of the ROM has been changed
+      (ie, patched from the debugger), so the instruction containing it is
+      decoded again.
+
+      @param offset  The offset of the changed byte into the ROM
+    */
+    void romChanged(uInt32 offset);
+
+    /**
+      Answers the time taken by the last call to run(), in cycles of the
+      ARM clock and in (whole) cycles of the 6507 clock.
+
+      The count is an approximation of the LPC2103 running at 70 MHz:
+      each instruction is charged for its memory accesses, with flash
+      accesses taking FLASH_CYCLES unless served from the buffers of the
+      memory accelerator module (depending on the mode set in MAMCR),
+      plus the internal cycles of loads and multiplies, and the pipeline
+      refill after a taken branch.
+    */
+    uInt64 armCycles() const { return arm_cycles; }
+    uInt32 cycles6507() const { return uInt32(arm_cycles / timing_factor); }
+
+    // Instructions executed and ARM cycles used at one address, or by
+    // one call to run()
+    struct ProfileCounter {
+      uInt64 count;
+      uInt64 cycles;
+    };
+    struct ProfileCall {
+      uInt32 instructions;
+      uInt32 cycles;
+    };
+    struct Profile {
+      vector<ProfileCounter> rom;  // Indexed by ROM address / 2
+      vector<ProfileCounter> ram;  // Indexed by RAM address / 2
+      vector<ProfileCall> calls;   // The most recent calls, oldest first
+      uInt64 callCount, instructions, cycles;
+    };
+    struct HotSpot {
+      uInt32 address;
+      ProfileCounter counter;
+    };
+
+    /**
+      Enable or disable collecting an execution profile of the ARM code.
+      When disabled (the default), the instruction loop is compiled
+      without any profiling code, so it costs nothing.  The data collected
+      so far is kept when disabling, until resetProfile() is called.
+    */
+    void enableProfiling(bool enable);
+    bool profilingEnabled() const { return profiling; }
+    void resetProfile();
+
+    /**
+      Answers the profile collected so far, or nullptr if profiling was
+      never enabled.
+    */
+    const Profile* profile() const { return profile_data.get(); }
+
+    /**
+      Answers (at most) the given number of addresses where most ARM
+      cycles were spent, in descending order.
+    */
+    vector<HotSpot> hotSpots(uInt32 max) const;
+
+    /**
+      Disassemble the instruction at the given address in ROM or RAM,
+      or the given instruction word, located at the given address.
+    */
+    string disassemble(uInt32 addr) const;
+    static string disassemble(uInt32 addr, uInt16 inst);
+
+  private:
+    // The Thumb instructions, in the order they're tested for when decoding
+    enum class Op : uInt8 {
+      adc, add1, add2, add3, add4, add5, add6, add7, and_, asr1, asr2,
+      b1, b2, bic, bkpt, blx1, blx2, bx, cmn, cmp1, cmp2, cmp3, cps,
+      cpy, eor, ldmia, ldr1, ldr2, ldr3, ldr4, ldrb1, ldrb2, ldrh1,
+      ldrh2, ldrsb, ldrsh, lsl1, lsl2, lsr1, lsr2, mov1, mov2, mov3,
+      mul, mvn, neg, orr, pop, push, rev, rev16, revsh, ror, sbc,
+      setend, stmia, str1, str2, str3, strb1, strb2, strh1, strh2, sub1,
+      sub2, sub3, sub4, swi, sxtb, sxth, tst, uxtb, uxth, invalid
+    };
+
   private:
     uInt32 read_register(uInt32 reg);
     void write_register(uInt32 reg, uInt32 data);
     uInt32 fetch16(uInt32 addr);
     uInt32 fetch32(uInt32 addr);
-    uInt32 read16(uInt32 addr);
+    // The second halfword of a word access isn't charged separately
+    uInt32 read16(uInt32 addr, bool charge = true);
     uInt32 read32(uInt32 addr);
-    bool isProtected(uInt32 addr);
-    void write16(uInt32 addr, uInt32 data);
-    void write32(uInt32 addr, uInt32 data);
+    // Writes are checked against the driver area of the configuration,
+    // which is fixed at compile time for each instantiation
+    template<ConfigureFor C> static bool isProtected(uInt32 addr);
+    template<ConfigureFor C> void write16(uInt32 addr, uInt32 data, bool charge = true);
+    template<ConfigureFor C> void write32(uInt32 addr, uInt32 data);
     void updateTimer(uInt32 cycles);
 
     void do_zflag(uInt32 x);
@@ -122,13 +218,31 @@ class Thumbulator
 
     void dump_counters();
     void dump_regs();
-    int execute();
+
+    // Find the instruction type of the given instruction word
+    static Op decodeInstructionWord(uInt16 inst);
+
+    // Find the instruction type of the instruction at the given address,
+    // using the decoded ROM and RAM
+    Op decodeInstruction(uInt32 addr, uInt16 inst);
+
+    // Run/execute the instructions of the current call; these are
+    // instantiated for each configuration (and with/without profiling),
+    // selected once per call in run()
+    template<ConfigureFor C, bool PROFILE> void runInstructions();
+    template<ConfigureFor C> int execute();
     int reset();
 
   private:
     const uInt16* rom;
     uInt16* ram;
 
+    // Instruction types for every halfword of ROM and RAM; the RAM entries
+    // are tagged with the instruction word they were decoded from
+    Op decodedRom[ROMSIZE / 2];
+    Op decodedRam[RAMSIZE / 2];
+    uInt16 decodedRamInst[RAMSIZE / 2];
+
     uInt32 reg_norm[16]; // normal execution mode, do not have a thread mode
     uInt32 cpsr, mamcr;
     bool handler_mode;
@@ -142,6 +256,21 @@ class Thumbulator
     uInt32 T1TC;   // Timer 1 Timer Counter
     double timing_factor;
 
+    // Cycles taken by a flash access at 70 MHz (the MAMTIM setting)
+    static constexpr uInt32 FLASH_CYCLES = 4;
+
+    // ARM cycles used by the current call, and the flash lines currently
+    // held by the MAM's instruction, prefetch and data buffers
+    uInt64 arm_cycles;
+    uInt32 fetch_line, prefetch_line, data_line;
+
+    // The execution profile (allocated when first enabled)
+    unique_ptr<Profile> profile_data;
+    bool profiling;
+
+    // The number of recent calls kept in the profile
+    static constexpr uInt32 PROFILE_CALLS = 4096;
+
     ostringstream statusMsg;
 
     static bool trapOnFatal;
@@ -71,6 +71,7 @@ MODULE_OBJS := \
 	src/emucore/PointingDevice.o \
 	src/emucore/Props.o \
 	src/emucore/PropsSet.o \
+	src/emucore/RomInfoCache.o \
 	src/emucore/SaveKey.o \
 	src/emucore/Serializer.o \
 	src/emucore/Settings.o \
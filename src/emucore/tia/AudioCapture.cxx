@@ -0,0 +1,159 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2018 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "TIAConstants.hxx"
+#include "AudioCapture.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+AudioCapture::AudioCapture()
+  : myCurrent(0),
+    mySamplesRequested(false),
+    mySamplesEnabled(false),
+    myLastSampleCycle(0)
+{
+  // Enough for any sane frame, so nothing is allocated while running
+  for(Frame& frame: myFrames)
+    frame.events.reserve(256);
+
+  myTIASound.outputFrequency(TIASound::NATIVE_FREQUENCY);
+  myTIASound.channels(2, true);
+
+  std::fill_n(myRegisters, 6, 0);
+  reset(0, myRegisters);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AudioCapture::reset(uInt64 cycle, const uInt8* registers)
+{
+  if(registers != myRegisters)
+    std::copy_n(registers, 6, myRegisters);
+
+  for(Frame& frame: myFrames)
+  {
+    frame.startCycle = cycle;
+    frame.cycles = 0;
+    std::copy_n(myRegisters, 6, frame.registers);
+    frame.events.clear();
+    frame.samples.clear();
+  }
+
+  // Synthesis carries on from the given register values
+  myTIASound.reset();
+  for(uInt16 i = 0; i < 6; ++i)
+    myTIASound.set(TIARegister::AUDC0 + i, myRegisters[i]);
+  myLastSampleCycle = cycle;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AudioCapture::set(uInt16 address, uInt8 value, uInt64 cycle)
+{
+  Frame& frame = myFrames[myCurrent];
+
+  // Normally the TIA restarts the capture when a state is loaded; if the
+  // cycle count jumps nevertheless, the current values are kept
+  if(discontinuous(cycle))
+    reset(cycle, myRegisters);
+
+  if(mySamplesEnabled)
+  {
+    update(cycle);
+    myTIASound.set(address, value);
+  }
+
+  frame.events.push_back(
+      { uInt32(cycle - frame.startCycle), uInt8(address), value });
+  myRegisters[address - TIARegister::AUDC0] = value;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AudioCapture::frameComplete(uInt64 cycle)
+{
+  if(discontinuous(cycle))
+  {
+    reset(cycle, myRegisters);
+    return;
+  }
+
+  if(mySamplesEnabled)
+    update(cycle);
+
+  Frame& last = myFrames[myCurrent];
+  last.cycles = uInt32(cycle - last.startCycle);
+
+  // Start the next frame in the other set of buffers
+  myCurrent ^= 1;
+  Frame& next = myFrames[myCurrent];
+  next.startCycle = cycle;
+  next.cycles = 0;
+  std::copy_n(myRegisters, 6, next.registers);
+  next.events.clear();
+  next.samples.clear();
+
+  if(mySamplesRequested && !mySamplesEnabled)
+  {
+    // Start synthesis from the current register values
+    myTIASound.reset();
+    for(uInt16 i = 0; i < 6; ++i)
+      myTIASound.set(TIARegister::AUDC0 + i, myRegisters[i]);
+    myLastSampleCycle = cycle;
+
+    // Room for two channels of a frame with twice the usual PAL scanlines
+    for(Frame& frame: myFrames)
+      frame.samples.reserve(2 * 2 * 312 * 76 / TIASound::CYCLES_PER_SAMPLE);
+
+    mySamplesEnabled = true;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AudioCapture::enableSamples(bool enable)
+{
+  // Synthesis can only start at a frame boundary, where the register
+  // values are known
+  mySamplesRequested = enable;
+  if(!enable)
+    mySamplesEnabled = false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool AudioCapture::discontinuous(uInt64 cycle) const
+{
+  const uInt64 start = myFrames[myCurrent].startCycle;
+  return cycle < start || cycle - start > MAX_FRAME_CYCLES;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AudioCapture::update(uInt64 cycle)
+{
+  if(cycle < myLastSampleCycle)
+  {
+    myLastSampleCycle = cycle;
+    return;
+  }
+
+  uInt64 samples = (cycle - myLastSampleCycle) / TIASound::CYCLES_PER_SAMPLE;
+  myLastSampleCycle += samples * TIASound::CYCLES_PER_SAMPLE;
+
+  vector<Int16>& out = myFrames[myCurrent].samples;
+  while(samples > 0)
+  {
+    uInt32 count = uInt32(std::min(samples, uInt64(GENERATE_SIZE)));
+    myTIASound.process(myGenerateBuffer, count);
+    out.insert(out.end(), myGenerateBuffer, myGenerateBuffer + count * 2);
+    samples -= count;
+  }
+}
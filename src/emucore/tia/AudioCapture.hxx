@@ -0,0 +1,123 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2018 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef TIA_AUDIO_CAPTURE
+#define TIA_AUDIO_CAPTURE
+
+#include "bspf.hxx"
+#include "TIASnd.hxx"
+
+/**
+  Records what the TIA audio circuits did during the last complete frame,
+  for scripts and tools that need to observe the sound without listening
+  to it: the register values at the start of the frame, every write to
+  AUDCx/AUDFx/AUDVx (with its cycle), and optionally the synthesized
+  samples at the native TIA rate.
+
+  The frame being built and the last complete one are kept in two sets of
+  buffers which are swapped at the end of each frame, so after the first
+  few frames no memory is allocated, and the last frame can be read in
+  place until the next one completes.
+*/
+class AudioCapture
+{
+  public:
+    struct Event {
+      uInt32 cycle;    // CPU cycles since the start of the frame
+      uInt8 address;   // One of AUDC0 .. AUDV1
+      uInt8 value;
+    };
+
+    struct Frame {
+      uInt64 startCycle;
+      uInt32 cycles;
+      uInt8 registers[6];   // AUDC0 .. AUDV1 at the start of the frame
+      vector<Event> events;
+      vector<Int16> samples;  // Interleaved, channel 0 left and 1 right
+    };
+
+  public:
+    AudioCapture();
+
+  public:
+    /**
+      Clear everything, and start the next frame at the given cycle with
+      the given register values (AUDC0 .. AUDV1), which are those of the
+      TIA after a reset or after a state has been loaded.
+    */
+    void reset(uInt64 cycle, const uInt8* registers);
+
+    /**
+      Record a write to an audio register.
+    */
+    void set(uInt16 address, uInt8 value, uInt64 cycle);
+
+    /**
+      End the current frame, which then becomes the last complete one.
+    */
+    void frameComplete(uInt64 cycle);
+
+    /**
+      Enable or disable synthesis of samples (events are always recorded).
+      Samples are generated starting with the next frame.
+    */
+    void enableSamples(bool enable);
+    bool samplesEnabled() const { return mySamplesRequested; }
+
+    /**
+      Answers the last complete frame.
+    */
+    const Frame& lastFrame() const { return myFrames[myCurrent ^ 1]; }
+
+  private:
+    /**
+      Generate samples from the last update up to the given cycle.
+    */
+    void update(uInt64 cycle);
+
+    /**
+      Answers whether the given cycle can't belong to the current frame,
+      since the emulation has jumped backwards or far ahead.
+    */
+    bool discontinuous(uInt64 cycle) const;
+
+  private:
+    // Far longer than any frame (four times the usual PAL scanlines)
+    enum { GENERATE_SIZE = 512, MAX_FRAME_CYCLES = 4 * 312 * 76 };
+
+    // The frame being built, and the last complete one
+    Frame myFrames[2];
+    uInt32 myCurrent;
+
+    // Current register values (AUDC0 .. AUDV1)
+    uInt8 myRegisters[6];
+
+    // Sample synthesis (only used when enabled)
+    TIASound myTIASound;
+    bool mySamplesRequested, mySamplesEnabled;
+    uInt64 myLastSampleCycle;
+    Int16 myGenerateBuffer[GENERATE_SIZE * 2];
+
+  private:
+    // Following constructors and assignment operators not supported
+    AudioCapture(const AudioCapture&) = delete;
+    AudioCapture(AudioCapture&&) = delete;
+    AudioCapture& operator=(const AudioCapture&) = delete;
+    AudioCapture& operator=(AudioCapture&&) = delete;
+};
+
+#endif // TIA_AUDIO_CAPTURE
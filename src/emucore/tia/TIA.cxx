@@ -164,6 +164,7 @@ void TIA::reset()
     paddleReader.reset(myTimestamp);
 
   mySound.reset();
+  myAudioCapture.reset(0, &myShadowRegisters[AUDC0]);
   myDelayQueue.reset();
 
   if (myFrameManager) myFrameManager->reset();
@@ -349,6 +350,10 @@ bool TIA::load(Serializer& in)
     in.getByteArray(myShadowRegisters, 64);
 
     myCyclesAtFrameStart = in.getLong();
+
+    // The audio capture restarts from the registers of the loaded state,
+    // whether it lies before or after the current one
+    myAudioCapture.reset(mySystem->cycles(), &myShadowRegisters[AUDC0]);
   }
   catch(...)
   {
@@ -523,26 +528,32 @@ bool TIA::poke(uInt16 address, uInt8 value)
     // FIXME - rework this when we add the new sound core
     case AUDV0:
       mySound.set(address, value, mySystem->cycles());
+      myAudioCapture.set(address, value, mySystem->cycles());
       myShadowRegisters[address] = value;
       break;
     case AUDV1:
       mySound.set(address, value, mySystem->cycles());
+      myAudioCapture.set(address, value, mySystem->cycles());
       myShadowRegisters[address] = value;
       break;
     case AUDF0:
       mySound.set(address, value, mySystem->cycles());
+      myAudioCapture.set(address, value, mySystem->cycles());
       myShadowRegisters[address] = value;
       break;
     case AUDF1:
       mySound.set(address, value, mySystem->cycles());
+      myAudioCapture.set(address, value, mySystem->cycles());
       myShadowRegisters[address] = value;
       break;
     case AUDC0:
       mySound.set(address, value, mySystem->cycles());
+      myAudioCapture.set(address, value, mySystem->cycles());
       myShadowRegisters[address] = value;
       break;
     case AUDC1:
       mySound.set(address, value, mySystem->cycles());
+      myAudioCapture.set(address, value, mySystem->cycles());
       myShadowRegisters[address] = value;
       break;
     ////////////////////////////////////////////////////////////
@@ -1140,6 +1151,10 @@ void TIA::onFrameComplete()
   mySystem->m6502().stop();
   myCyclesAtFrameStart = mySystem->cycles();
 
+  // Let the sound device catch up, in case no sound registers were written
+  mySound.frameComplete(myCyclesAtFrameStart);
+  myAudioCapture.frameComplete(myCyclesAtFrameStart);
+
   if (myXAtRenderingStart > 0)
     memset(myFramebuffer, 0, myXAtRenderingStart);
 
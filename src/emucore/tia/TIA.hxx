@@ -36,6 +36,7 @@
 #include "Ball.hxx"
 #include "LatchedInput.hxx"
 #include "PaddleReader.hxx"
+#include "AudioCapture.hxx"
 #include "DelayQueueIterator.hxx"
 #include "Control.hxx"
 #include "System.hxx"
@@ -199,6 +200,12 @@ class TIA : public Device
     */
     uInt8* frameBuffer() { return static_cast<uInt8*>(myFramebuffer); }
 
+    /**
+      Answers the record of audio register writes (and optionally samples)
+      for the last complete frame.
+    */
+    AudioCapture& audioCapture() { return myAudioCapture; }
+
     /**
       Answers dimensional info about the framebuffer.
     */
@@ -646,6 +653,11 @@ class TIA : public Device
      */
     PaddleReader myPaddleReaders[4];
 
+    /**
+     * Record of the audio register writes, for scripts and tools.
+     */
+    AudioCapture myAudioCapture;
+
     /**
      * Circuits for the "latched inputs".
      */
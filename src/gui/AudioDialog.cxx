@@ -50,7 +50,7 @@ AudioDialog::AudioDialog(OSystem& osystem, DialogContainer& parent,
 
   // Set real dimensions
   _w = 35 * fontWidth + 10;
-  _h = 7 * (lineHeight + 4) + 10;
+  _h = 8 * (lineHeight + 4) + 10;
 
   // Volume
   xpos = 3 * fontWidth;  ypos = 10;
@@ -93,6 +93,12 @@ AudioDialog::AudioDialog(OSystem& osystem, DialogContainer& parent,
   wid.push_back(myFreqPopup);
   ypos += lineHeight + 4;
 
+  // Adaptive buffering
+  myAdaptiveCheckbox = new CheckboxWidget(this, font, xpos + lwidth, ypos + 1,
+                                          "Adaptive buffer");
+  wid.push_back(myAdaptiveCheckbox);
+  ypos += lineHeight + 4;
+
   // Enable sound
   xpos = (_w - (font.getStringWidth("Enable sound") + 10)) / 2;
   ypos += 4;
@@ -130,6 +136,9 @@ void AudioDialog::loadConfig()
   // Output frequency
   myFreqPopup->setSelected(instance().settings().getString("freq"), "31400");
 
+  // Adaptive buffering
+  myAdaptiveCheckbox->setState(instance().settings().getString("audiobuffer") == "adaptive");
+
   // Enable sound
   bool b = instance().settings().getBool("sound");
   mySoundEnableCheckbox->setState(b);
@@ -153,6 +162,9 @@ void AudioDialog::saveConfig()
   // Output frequency
   settings.setValue("freq", myFreqPopup->getSelectedTag().toString());
 
+  // Adaptive buffering
+  settings.setValue("audiobuffer", myAdaptiveCheckbox->getState() ? "adaptive" : "fixed");
+
   // Enable/disable sound (requires a restart to take effect)
   instance().sound().setEnabled(mySoundEnableCheckbox->getState());
 
@@ -170,6 +182,7 @@ void AudioDialog::setDefaults()
 
   myFragsizePopup->setSelected("512", "");
   myFreqPopup->setSelected("31400", "");
+  myAdaptiveCheckbox->setState(false);
 
   mySoundEnableCheckbox->setState(true);
 
@@ -186,6 +199,7 @@ void AudioDialog::handleSoundEnableChange(bool active)
   myVolumeLabel->setEnabled(active);
   myFragsizePopup->setEnabled(active);
   myFreqPopup->setEnabled(active);
+  myAdaptiveCheckbox->setEnabled(active);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -53,6 +53,7 @@ class AudioDialog : public Dialog
     StaticTextWidget* myVolumeLabel;
     PopUpWidget*      myFragsizePopup;
     PopUpWidget*      myFreqPopup;
+    CheckboxWidget*   myAdaptiveCheckbox;
     CheckboxWidget*   mySoundEnableCheckbox;
 
   private:
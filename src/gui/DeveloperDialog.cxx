@@ -32,6 +32,7 @@
 #include "Widget.hxx"
 #include "Font.hxx"
 #ifdef DEBUGGER_SUPPORT
+#include "Debugger.hxx"
 #include "DebuggerDialog.hxx"
 #endif
 #include "Console.hxx"
@@ -55,7 +56,7 @@ DeveloperDialog::DeveloperDialog(OSystem& osystem, DialogContainer& parent,
 
   // Set real dimensions
   _w = std::min(53 * fontWidth + 10, max_w);
-  _h = std::min(15 * (lineHeight + VGAP) + 14, max_h);
+  _h = std::min(16 * (lineHeight + VGAP) + 14, max_h);
 
   // The tab widget
   xpos = 2; ypos = 4;
@@ -156,6 +157,12 @@ void DeveloperDialog::addEmulationTab(const GUI::Font& font)
   wid.push_back(myThumbExceptionWidget);
   ypos += lineHeight + VGAP;
 
+  // Thumb ARM emulation timing
+  myThumbCycleCountWidget = new CheckboxWidget(myTab, font, HBORDER + INDENT * 1, ypos + 1,
+                                               "6507 waits for ARM code to finish");
+  wid.push_back(myThumbCycleCountWidget);
+  ypos += lineHeight + VGAP;
+
   // AtariVox/SaveKey EEPROM access
   myEEPROMAccessWidget = new CheckboxWidget(myTab, font, HBORDER + INDENT * 1, ypos + 1,
                                             "Display AtariVox/SaveKey EEPROM R/W access");
@@ -454,6 +461,9 @@ void DeveloperDialog::addDebuggerTab(const GUI::Font& font)
   ypos += lineHeight + VGAP * 4;
   myGhostReadsTrapWidget = new CheckboxWidget(myTab, font, HBORDER, ypos + 1,
                                              "Trap on 'ghost' reads", kGhostReads);
+  ypos += lineHeight + VGAP;
+  myARMOverrunTrapWidget = new CheckboxWidget(myTab, font, HBORDER, ypos + 1,
+                                              "Trap on ARM code overrunning the frame");
 
   // Add message concerning usage
   const GUI::Font& infofont = instance().frameBuffer().infoFont();
@@ -516,6 +526,7 @@ void DeveloperDialog::loadSettings(SettingsSet set)
   myUndrivenPins[set] = instance().settings().getBool(prefix + "tiadriven");
   // Thumb ARM emulation exception
   myThumbException[set] = instance().settings().getBool(prefix + "thumb.trapfatal");
+  myThumbCycleCount[set] = instance().settings().getBool(prefix + "thumb.cyclecount");
   // AtariVox/SaveKey EEPROM access
   myEEPROMAccess[set] = instance().settings().getBool(prefix + "eepromaccess");
 
@@ -550,6 +561,7 @@ void DeveloperDialog::saveSettings(SettingsSet set)
   instance().settings().setValue(prefix + "tiadriven", myUndrivenPins[set]);
   // Thumb ARM emulation exception
   instance().settings().setValue(prefix + "thumb.trapfatal", myThumbException[set]);
+  instance().settings().setValue(prefix + "thumb.cyclecount", myThumbCycleCount[set]);
   // AtariVox/SaveKey EEPROM access
   instance().settings().setValue(prefix + "eepromaccess", myEEPROMAccess[set]);
 
@@ -587,6 +599,7 @@ void DeveloperDialog::getWidgetStates(SettingsSet set)
   myUndrivenPins[set] = myUndrivenPinsWidget->getState();
   // Thumb ARM emulation exception
   myThumbException[set] = myThumbExceptionWidget->getState();
+  myThumbCycleCount[set] = myThumbCycleCountWidget->getState();
   // AtariVox/SaveKey EEPROM access
   myEEPROMAccess[set] = myEEPROMAccessWidget->getState();
 
@@ -624,6 +637,7 @@ void DeveloperDialog::setWidgetStates(SettingsSet set)
   myUndrivenPinsWidget->setState(myUndrivenPins[set]);
   // Thumb ARM emulation exception
   myThumbExceptionWidget->setState(myThumbException[set]);
+  myThumbCycleCountWidget->setState(myThumbCycleCount[set]);
   // AtariVox/SaveKey EEPROM access
   myEEPROMAccessWidget->setState(myEEPROMAccess[set]);
 
@@ -694,6 +708,8 @@ void DeveloperDialog::loadConfig()
 
   // Ghost reads trap
   myGhostReadsTrapWidget->setState(instance().settings().getBool("dbg.ghostreadstrap"));
+  // ARM overrun trap
+  myARMOverrunTrapWidget->setState(instance().settings().getBool("dbg.armoverruntrap"));
 
   handleFontSize();
 #endif
@@ -752,6 +768,10 @@ void DeveloperDialog::saveConfig()
   instance().settings().setValue("dbg.ghostreadstrap", myGhostReadsTrapWidget->getState());
   if(instance().hasConsole())
     instance().console().system().m6502().setGhostReadsTrap(myGhostReadsTrapWidget->getState());
+  // ARM overrun trap
+  instance().settings().setValue("dbg.armoverruntrap", myARMOverrunTrapWidget->getState());
+  if(instance().hasConsole())
+    instance().debugger().setARMOverrunTrap(myARMOverrunTrapWidget->getState());
 #endif
 }
 
@@ -774,6 +794,7 @@ void DeveloperDialog::setDefaults()
       myUndrivenPins[set] = devSettings ? true : false;
       // Thumb ARM emulation exception
       myThumbException[set] = devSettings ? true : false;
+      myThumbCycleCount[set] = devSettings ? true : false;
       // AtariVox/SaveKey EEPROM access
       myEEPROMAccess[set] = devSettings ? true : false;
 
@@ -816,6 +837,7 @@ void DeveloperDialog::setDefaults()
       myDebuggerFontStyle->setSelected("0");
 
       myGhostReadsTrapWidget->setState(true);
+      myARMOverrunTrapWidget->setState(false);
 
       handleFontSize();
 #endif
@@ -105,6 +105,7 @@ class DeveloperDialog : public Dialog
     CheckboxWidget*     myRandomizeCPUWidget[5];
     CheckboxWidget*     myUndrivenPinsWidget;
     CheckboxWidget*     myThumbExceptionWidget;
+    CheckboxWidget*     myThumbCycleCountWidget;
     CheckboxWidget*     myEEPROMAccessWidget;
 
     // Video widgets
@@ -136,6 +137,7 @@ class DeveloperDialog : public Dialog
     PopUpWidget*        myDebuggerFontSize;
     PopUpWidget*        myDebuggerFontStyle;
     CheckboxWidget*     myGhostReadsTrapWidget;
+    CheckboxWidget*     myARMOverrunTrapWidget;
 #endif
 
     bool    mySettings;
@@ -151,6 +153,7 @@ class DeveloperDialog : public Dialog
     bool    myDebugColors[2];
     bool    myUndrivenPins[2];
     bool    myThumbException[2];
+    bool    myThumbCycleCount[2];
     bool    myEEPROMAccess[2];
     // States sets
     bool    myTimeMachine[2];
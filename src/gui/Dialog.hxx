@@ -106,6 +106,7 @@ class Dialog : public GuiObject
     virtual void handleJoyUp(int stick, int button);
     virtual void handleJoyAxis(int stick, int axis, int value);
     virtual bool handleJoyHat(int stick, int hat, JoyHat value);
+    virtual void handleTick() { }  // called regularly while on top of the stack
     virtual void handleCommand(CommandSender* sender, int cmd, int data, int id) override;
 
     Widget* findWidget(int x, int y) const; // Find the widget at pos x,y if any
@@ -56,6 +56,7 @@ void DialogContainer::updateTime(uInt64 time)
 
   // Check for pending continuous events and send them to the active dialog box
   Dialog* activeDialog = myDialogStack.top();
+  activeDialog->handleTick();
 
   // Key still pressed
   if(myCurrentKeyDown.keycode != 0 && myKeyRepeatTime < myTime)
@@ -23,6 +23,24 @@
 
 #include "GameList.hxx"
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+GameList::Entry::Entry(const string& name, const string& path,
+                       const string& md5, bool isdir)
+  : _name(name),
+    _path(path),
+    _md5(md5),
+    _isdir(isdir)
+{
+  // The key is the name in uppercase, so that neither sorting nor filtering
+  // needs to convert the names over and over again
+  // Account for ending ']' character in directory entries
+  const size_t length =
+    isdir && name.size() > 0 && name.back() == ']' ? name.size() - 1 : name.size();
+  _key.resize(length);
+  for(size_t i = 0; i < length; ++i)
+    _key[i] = char(toupper(name[i]));
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void GameList::sortByName()
 {
@@ -35,23 +53,8 @@ void GameList::sortByName()
     if(a._isdir != b._isdir)
       return a._isdir;
 
-    auto it1 = a._name.cbegin(), it2 = b._name.cbegin();
-
-    // Account for ending ']' character in directory entries
-    auto end1 = a._isdir ? a._name.cend() - 1 : a._name.cend();
-    auto end2 = b._isdir ? b._name.cend() - 1 : b._name.cend();
-
-    // Stop when either string's end has been reached
-    while((it1 != end1) && (it2 != end2))
-    {
-      if(toupper(*it1) != toupper(*it2)) // letters differ?
-        return toupper(*it1) < toupper(*it2);
-
-      // proceed to the next character in each string
-      ++it1;
-      ++it2;
-    }
-    return a._name.size() < b._name.size();
+    return std::lexicographical_compare(a._key.cbegin(), a._key.cend(),
+                                        b._key.cbegin(), b._key.cend());
   };
 
   sort(myArray.begin(), myArray.end(), cmp);
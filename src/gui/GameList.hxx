@@ -43,9 +43,15 @@ class GameList
     void setMd5(uInt32 i, const string& md5)
       { myArray[i]._md5 = md5; }
 
+    // Answer whether the name of the given entry contains 'text', ignoring
+    // case; 'text' must already be in uppercase
+    bool nameContains(uInt32 i, const string& text) const
+      { return myArray[i]._key.find(text) != string::npos; }
+
     uInt32 size() const { return uInt32(myArray.size()); }
     void clear() { myArray.clear(); }
 
+    void reserve(uInt32 size) { myArray.reserve(size); }
     void appendGame(const string& name, const string& path, const string& md5,
                     bool isDir = false) {
       myArray.emplace_back(name, path, md5, isDir);
@@ -57,10 +63,11 @@ class GameList
       string _name;
       string _path;
       string _md5;
+      string _key;    // The name in uppercase, for sorting and filtering
       bool   _isdir;
 
-      Entry(string name, string path, string md5, bool isdir)
-        : _name(name), _path(path), _md5(md5), _isdir(isdir) { }
+      Entry(const string& name, const string& path, const string& md5,
+            bool isdir);
     };
     vector<Entry> myArray;
 
@@ -34,13 +34,23 @@
 #include "StellaKeys.hxx"
 #include "Props.hxx"
 #include "PropsSet.hxx"
+#include "RomIndexer.hxx"
 #include "RomInfoWidget.hxx"
+#include "RomThumbnails.hxx"
 #include "Settings.hxx"
 #include "StringListWidget.hxx"
 #include "Widget.hxx"
 #include "Font.hxx"
 #include "LauncherDialog.hxx"
 
+namespace {
+  // Time spent rendering previews on each tick, in microseconds
+  constexpr uInt32 THUMBNAIL_TIME = 4000;
+
+  // How many ROMs above and below the selected one get a preview in advance
+  constexpr int THUMBNAIL_AHEAD = 4;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 LauncherDialog::LauncherDialog(OSystem& osystem, DialogContainer& parent,
                                int x, int y, int w, int h)
@@ -52,7 +62,8 @@ LauncherDialog::LauncherDialog(OSystem& osystem, DialogContainer& parent,
     myList(nullptr),
     myPattern(nullptr),
     myRomInfoWidget(nullptr),
-    mySelectedItem(0)
+    mySelectedItem(0),
+    myRomInfoPending(false)
 {
   const GUI::Font& font = instance().frameBuffer().launcherFont();
 
@@ -168,6 +179,18 @@ LauncherDialog::LauncherDialog(OSystem& osystem, DialogContainer& parent,
   // the launcher needs
   myGameList = make_unique<GameList>();
 
+  // Create an indexer, which calculates the MD5 of all ROMs in the listing
+  // in the background
+  myIndexer = make_unique<RomIndexer>(osystem.romInfoCache());
+
+  // Previews for ROMs without a snapshot are rendered while the launcher
+  // is idle, if the ROM info is shown at all
+  if(myRomInfoWidget)
+  {
+    myThumbnails = make_unique<RomThumbnails>(osystem, osystem.baseDir() + "stella.rth");
+    myRomInfoWidget->setThumbnails(myThumbnails.get());
+  }
+
   addToFocusList(wid);
 
   // Create context menu for ROM list options
@@ -191,7 +214,7 @@ LauncherDialog::LauncherDialog(OSystem& osystem, DialogContainer& parent,
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 const string& LauncherDialog::selectedRomMD5()
 {
-  int item = myList->getSelected();
+  int item = selectedItem();
   if(item < 0)
     return EmptyString;
 
@@ -236,7 +259,7 @@ void LauncherDialog::loadConfig()
 
   // Assume that if the list is empty, this is the first time that loadConfig()
   // has been called (and we should reload the list)
-  if(myList->getList().empty())
+  if(myGameList->size() == 0)
   {
     myPrevDirButton->setEnabled(false);
     myCurrentNode = FilesystemNode(romdir == "" ? "~" : romdir);
@@ -266,17 +289,9 @@ void LauncherDialog::updateListing(const string& nameToSelect)
   // Show current directory
   myDir->setText(myCurrentNode.getShortPath());
 
-  // Now fill the list widget with the contents of the GameList
-  StringList l;
-  for(uInt32 i = 0; i < myGameList->size(); ++i)
-    l.push_back(myGameList->name(i));
-
-  myList->setList(l);
-
-  // Indicate how many files were found
-  ostringstream buf;
-  buf << (myGameList->size() - 1) << " items found";
-  myRomCount->setLabel(buf.str());
+  // Now show the contents of the GameList which match the pattern
+  myShownPattern = "";
+  filterListing();
 
   // Restore last selection
   const string& find =
@@ -290,20 +305,24 @@ void LauncherDialog::loadDirListing()
   if(!myCurrentNode.isDirectory())
     return;
 
-  FSList files;
+  // Only the name and type of each file is needed, which is much quicker
+  // to get for large directories than a full FilesystemNode
+  FilesystemNode::EntryList files;
   files.reserve(2048);
-  myCurrentNode.getChildren(files, FilesystemNode::kListAll);
+  myCurrentNode.getEntries(files, FilesystemNode::kListAll);
+  myGameList->reserve(uInt32(files.size()) + 1);
 
   // Add '[..]' to indicate previous folder
   if(myCurrentNode.hasParent())
     myGameList->appendGame(" [..]", "", "", true);
 
   // Now add the directory entries
-  bool domatch = myPattern && myPattern->getText() != "";
+  StringList roms;
+  string extension;
   for(const auto& f: files)
   {
-    bool isDir = f.isDirectory();
-    const string& name = isDir ? (" [" + f.getName() + "]") : f.getName();
+    bool isDir = f.isDirectory;
+    const string& name = isDir ? (" [" + f.name + "]") : f.name;
 
     // Honour the filtering settings
     // Showing only certain ROM extensions is determined by the extension
@@ -316,22 +335,80 @@ void LauncherDialog::loadDirListing()
         continue;
     }
 
-    // Skip over files that don't match the pattern in the 'pattern' textbox
-    if(domatch && !isDir && !matchPattern(name, myPattern->getText()))
-      continue;
-
-    myGameList->appendGame(name, f.getPath(), "", isDir);
+    myGameList->appendGame(name, f.path, "", isDir);
+    if(!isDir && LauncherFilterDialog::isValidRomName(f.path, extension) &&
+       RomIndexer::canIndex(f.path))
+      roms.push_back(f.path);
   }
 
   // Sort the list by rom name (since that's what we see in the listview)
   myGameList->sortByName();
+
+  // Calculate the MD5 of the ROMs in the background, so that neither
+  // moving through the list nor showing the ROM info waits for file I/O
+  // The results are added to the list as they arrive (see handleTick())
+  myIndexedItems.clear();
+  for(const auto& rom: roms)
+    myIndexedItems.emplace(rom, 0);
+  for(uInt32 i = 0; i < myGameList->size(); ++i)
+  {
+    const auto it = myIndexedItems.find(myGameList->path(i));
+    if(it != myIndexedItems.end())
+      it->second = i;
+  }
+  myIndexer->index(roms);
+  myRomInfoPending = false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void LauncherDialog::filterListing()
+{
+  string pattern = myPattern ? myPattern->getText() : "";
+  for(auto& c: pattern)
+    c = char(toupper(c));
+
+  // Files only match a pattern if they match every part of it, so when
+  // the pattern is extended only the files shown so far need to be checked
+  const bool narrow = myShownPattern != "" &&
+                      pattern.find(myShownPattern) != string::npos;
+  vector<uInt32> items;
+  const uInt32 size = narrow ? uInt32(myShownItems.size()) : myGameList->size();
+  items.reserve(size);
+  for(uInt32 i = 0; i < size; ++i)
+  {
+    // Directories are always shown
+    const uInt32 item = narrow ? myShownItems[i] : i;
+    if(pattern == "" || myGameList->isDir(item) ||
+       myGameList->nameContains(item, pattern))
+      items.push_back(item);
+  }
+  myShownItems.swap(items);
+  myShownPattern = pattern;
+
+  // The list widget only asks for the names it actually shows
+  myList->setList(int(myShownItems.size()), [this](int i) -> const string& {
+    return myGameList->name(myShownItems[i]);
+  });
+
+  // Indicate how many files were found
+  ostringstream buf;
+  buf << (int(myShownItems.size()) - 1) << " items found";
+  myRomCount->setLabel(buf.str());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int LauncherDialog::selectedItem() const
+{
+  int item = myList->getSelected();
+  return item >= 0 && item < int(myShownItems.size()) ? int(myShownItems[item]) : -1;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void LauncherDialog::loadRomInfo()
 {
   if(!myRomInfoWidget) return;
-  int item = myList->getSelected();
+  myRomInfoPending = false;
+  int item = selectedItem();
   if(item < 0) return;
 
   string extension;
@@ -339,19 +416,83 @@ void LauncherDialog::loadRomInfo()
   if(!node.isDirectory() && LauncherFilterDialog::isValidRomName(node, extension))
   {
     // Make sure we have a valid md5 for this ROM
+    // If it is still being indexed, have it done next, and show the info
+    // once it's available
     if(myGameList->md5(item) == "")
+    {
+      if(myIndexedItems.count(myGameList->path(item)))
+      {
+        myIndexer->prioritize(myGameList->path(item));
+        myRomInfoWidget->clearProperties();
+        myRomInfoPending = true;
+        return;
+      }
       myGameList->setMd5(item, MD5::hash(node));
+    }
 
     // Get the properties for this entry
     Properties props;
     instance().propSet().getMD5WithInsert(node, myGameList->md5(item), props);
 
     myRomInfoWidget->setProperties(props);
+    queueThumbnails();
   }
   else
     myRomInfoWidget->clearProperties();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void LauncherDialog::queueThumbnails()
+{
+  // The selected ROM comes first, then those around it, which are likely
+  // to be selected next; ROMs which aren't indexed yet are left out
+  vector<RomThumbnails::Rom> roms;
+  auto addRow = [&](int row)
+  {
+    if(row < 0 || row >= int(myShownItems.size()))
+      return;
+
+    const uInt32 item = myShownItems[row];
+    if(!myGameList->isDir(item) && myGameList->md5(item) != "")
+      roms.emplace_back(myGameList->path(item), myGameList->md5(item));
+  };
+
+  const int selected = myList->getSelected();
+  addRow(selected);
+  for(int i = 1; i <= THUMBNAIL_AHEAD; ++i)
+  {
+    addRow(selected + i);
+    addRow(selected - i);
+  }
+
+  myThumbnails->queue(roms);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void LauncherDialog::handleTick()
+{
+  string md5;
+  if(myThumbnails && myThumbnails->render(THUMBNAIL_TIME, md5))
+    myRomInfoWidget->thumbnailReady(md5);
+
+  vector<RomIndexer::Result> results;
+  if(!myIndexer->results(results))
+    return;
+
+  for(const auto& r: results)
+  {
+    const auto it = myIndexedItems.find(r.first);
+    if(it != myIndexedItems.end())
+    {
+      myGameList->setMd5(it->second, r.second);
+      myIndexedItems.erase(it);
+    }
+  }
+
+  if(myRomInfoPending)
+    loadRomInfo();
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void LauncherDialog::handleContextMenu()
 {
@@ -379,47 +520,6 @@ void LauncherDialog::setListFilters()
   LauncherFilterDialog::parseExts(myRomExts, exts);
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool LauncherDialog::matchPattern(const string& s, const string& pattern) const
-{
-  // This method is modelled after strcasestr, which we don't use
-  // because it isn't guaranteed to be available everywhere
-  // The strcasestr uses the KMP algorithm when the comparisons
-  // reach a certain point, but since we'll be dealing with relatively
-  // short strings, I think the overhead of building a KMP table
-  // each time would be slower than the brute force method used here
-  const char* haystack = s.c_str();
-  const char* needle = pattern.c_str();
-
-  uInt8 b = tolower(*needle);
-
-  needle++;
-  for(;; haystack++)
-  {
-    if(*haystack == '\0')  /* No match */
-      return false;
-
-    /* The first character matches */
-    if(tolower(*haystack) == b)
-    {
-      const char* rhaystack = haystack + 1;
-      const char* rneedle = needle;
-
-      for(;; rhaystack++, rneedle++)
-      {
-        if(*rneedle == '\0')   /* Found a match */
-          return true;
-        if(*rhaystack == '\0') /* No match */
-          return false;
-
-        /* Nothing in this round */
-        if(tolower(*rhaystack) != tolower(*rneedle))
-          break;
-      }
-    }
-  }
-}
-
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void LauncherDialog::handleKeyDown(StellaKey key, StellaMod mod)
 {
@@ -454,7 +554,7 @@ void LauncherDialog::handleCommand(CommandSender* sender, int cmd,
     case ListWidget::kActivatedCmd:
     case ListWidget::kDoubleClickedCmd:
     {
-      int item = myList->getSelected();
+      int item = selectedItem();
       if(item >= 0)
       {
         const FilesystemNode romnode(myGameList->path(item));
@@ -478,6 +578,11 @@ void LauncherDialog::handleCommand(CommandSender* sender, int cmd,
         }
         else
         {
+          // Keep the previews rendered so far, in case the game never
+          // returns to the launcher
+          if(myThumbnails)
+            myThumbnails->save();
+
           const string& result =
             instance().createConsole(romnode, myGameList->md5(item));
           if(result == EmptyString)
@@ -545,9 +650,13 @@ void LauncherDialog::handleCommand(CommandSender* sender, int cmd,
 
     case EditableWidget::kAcceptCmd:
     case EditableWidget::kChangedCmd:
-      // The updateListing() method knows what to do when the text changes
-      updateListing();
+    {
+      // Only the files shown change, the directory isn't read again
+      const string selected = myList->getSelectedString();
+      filterListing();
+      myList->setSelected(selected);
       break;
+    }
 
     default:
       Dialog::handleCommand(sender, cmd, data, 0);
@@ -30,13 +30,17 @@ class LauncherFilterDialog;
 class OSystem;
 class Properties;
 class EditTextWidget;
+class RomIndexer;
 class RomInfoWidget;
+class RomThumbnails;
 class StaticTextWidget;
 class StringListWidget;
 namespace GUI {
   class MessageBox;
 }
 
+#include <unordered_map>
+
 #include "bspf.hxx"
 #include "Dialog.hxx"
 #include "FSNode.hxx"
@@ -81,19 +85,26 @@ class LauncherDialog : public Dialog
     void handleKeyDown(StellaKey key, StellaMod mod) override;
     void handleMouseDown(int x, int y, MouseButton b, int clickCount) override;
     void handleCommand(CommandSender* sender, int cmd, int data, int id) override;
+    void handleTick() override;
 
     void loadConfig() override;
     void updateListing(const string& nameToSelect = "");
 
     void loadDirListing();
+    void filterListing();
     void loadRomInfo();
+    void queueThumbnails();
     void handleContextMenu();
     void setListFilters();
-    bool matchPattern(const string& s, const string& pattern) const;
+
+    // The position in the game list of the selected item (or -1)
+    int selectedItem() const;
 
   private:
     unique_ptr<OptionsDialog> myOptions;
     unique_ptr<GameList> myGameList;
+    unique_ptr<RomIndexer> myIndexer;
+    unique_ptr<RomThumbnails> myThumbnails;
     unique_ptr<ContextMenu> myMenu;
     unique_ptr<GlobalPropsDialog> myGlobalProps;
     unique_ptr<LauncherFilterDialog> myFilters;
@@ -119,6 +130,16 @@ class LauncherDialog : public Dialog
 
     StringList myRomExts;
 
+    // The game list items currently shown, and the pattern (in uppercase)
+    // they were filtered by
+    vector<uInt32> myShownItems;
+    string myShownPattern;
+
+    // Position of each file being indexed in the game list, and whether the
+    // ROM info is waiting for the MD5 of the selected file
+    std::unordered_map<string, uInt32> myIndexedItems;
+    bool myRomInfoPending;
+
     enum {
       kPrevDirCmd = 'PRVD',
       kOptionsCmd = 'OPTI',
@@ -130,7 +130,12 @@ bool LauncherFilterDialog::isValidRomName(const string& name,
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool LauncherFilterDialog::isValidRomName(const FilesystemNode& node, string& ext)
 {
-  const string& name = node.getPath();
+  return isValidRomName(node.getPath(), ext);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool LauncherFilterDialog::isValidRomName(const string& name, string& ext)
+{
   string::size_type idx = name.find_last_of('.');
   if(idx != string::npos)
   {
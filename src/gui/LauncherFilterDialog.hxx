@@ -55,6 +55,14 @@ class LauncherFilterDialog : public Dialog, public CommandSender
      */
     static bool isValidRomName(const FilesystemNode& name, string& ext);
 
+    /**
+      Is this a valid ROM filename (does it have a valid extension?).
+
+      @param name  Filename (or path) of potential ROM file
+      @param ext   The extension extracted from the given file
+     */
+    static bool isValidRomName(const string& name, string& ext);
+
   private:
     void loadConfig() override;
     void saveConfig() override;
@@ -62,7 +62,7 @@ ListWidget::ListWidget(GuiObject* boss, const GUI::Font& font,
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void ListWidget::setSelected(int item)
 {
-  if(item < 0 || item >= int(_list.size()))
+  if(item < 0 || item >= listSize())
   {
     setDirty();  // Simply redraw and exit
     return;
@@ -85,23 +85,22 @@ void ListWidget::setSelected(int item)
 void ListWidget::setSelected(const string& item)
 {
   int selected = -1;
-  if(!_list.empty())
+  const int size = listSize();
+  if(size > 0)
   {
     if(item == "")
       selected = 0;
     else
     {
-      uInt32 itemToSelect = 0;
-      for(const auto& iter: _list)
+      for(int i = 0; i < size; ++i)
       {
-        if(item == iter)
+        if(item == listItem(i))
         {
-          selected = itemToSelect;
+          selected = i;
           break;
         }
-        ++itemToSelect;
       }
-      if(itemToSelect > _list.size() || selected == -1)
+      if(selected == -1)
         selected = 0;
     }
   }
@@ -111,7 +110,7 @@ void ListWidget::setSelected(const string& item)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void ListWidget::setHighlighted(int item)
 {
-  if(item < -1 || item >= int(_list.size()))
+  if(item < -1 || item >= listSize())
     return;
 
   if(isEnabled())
@@ -134,14 +133,14 @@ void ListWidget::setHighlighted(int item)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 const string& ListWidget::getSelectedString() const
 {
-  return (_selectedItem >= 0 && _selectedItem < int(_list.size()))
-            ? _list[_selectedItem] : EmptyString;
+  return (_selectedItem >= 0 && _selectedItem < listSize())
+            ? listItem(_selectedItem) : EmptyString;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void ListWidget::scrollTo(int item)
 {
-  int size = int(_list.size());
+  int size = listSize();
   if (item >= size)
     item = size - 1;
   if (item < 0)
@@ -163,7 +162,7 @@ int ListWidget::getWidth() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void ListWidget::recalc()
 {
-  int size = int(_list.size());
+  int size = listSize();
 
   if (_currentPos >= size)
     _currentPos = size - 1;
@@ -175,7 +174,7 @@ void ListWidget::recalc()
 
   _editMode = false;
 
-  _scrollBar->_numEntries     = int(_list.size());
+  _scrollBar->_numEntries     = size;
   _scrollBar->_entriesPerPage = _rows;
 
   // Reset to normal data entry
@@ -199,7 +198,7 @@ void ListWidget::handleMouseDown(int x, int y, MouseButton b, int clickCount)
   // First check whether the selection changed
   int newSelectedItem;
   newSelectedItem = findItem(x, y);
-  if (newSelectedItem >= int(_list.size()))
+  if (newSelectedItem >= listSize())
     return;
 
   if (_selectedItem != newSelectedItem)
@@ -266,15 +265,14 @@ bool ListWidget::handleText(char text)
     // key is pressed); it could be much faster. Only of importance if we have
     // quite big lists to deal with -- so for now we can live with this lazy
     // implementation :-)
-    int newSelectedItem = 0;
-    for(const auto& i: _list)
+    const int size = listSize();
+    for(int i = 0; i < size; ++i)
     {
-      if(BSPF::startsWithIgnoreCase(i, _quickSelectStr))
+      if(BSPF::startsWithIgnoreCase(listItem(i), _quickSelectStr))
       {
-        _selectedItem = newSelectedItem;
+        _selectedItem = i;
         break;
       }
-      newSelectedItem++;
     }
   }
   else if (_editMode)
@@ -340,7 +338,7 @@ bool ListWidget::handleEvent(Event::Type e)
 
   bool handled = true;
   int oldSelectedItem = _selectedItem;
-  int size = int(_list.size());
+  int size = listSize();
 
   switch(e)
   {
@@ -445,10 +443,10 @@ void ListWidget::scrollToCurrent(int item)
     _currentPos = item - _rows + 1;
   }
 
-  if (_currentPos < 0 || _rows > int(_list.size()))
+  if (_currentPos < 0 || _rows > listSize())
     _currentPos = 0;
-  else if (_currentPos + _rows > int(_list.size()))
-    _currentPos = int(_list.size()) - _rows;
+  else if (_currentPos + _rows > listSize())
+    _currentPos = listSize() - _rows;
 
   int oldScrollPos = _scrollBar->_currentPos;
   _scrollBar->_currentPos = _currentPos;
@@ -466,7 +464,7 @@ void ListWidget::startEditMode()
   if (isEditable() && !_editMode && _selectedItem >= 0)
   {
     _editMode = true;
-    setText(_list[_selectedItem]);
+    setText(listItem(_selectedItem));
 
     // Widget gets raw data while editing
     EditableWidget::startEditMode();
@@ -57,6 +57,11 @@ class ListWidget : public EditableWidget
     const StringList& getList()	const { return _list; }
     const string& getSelectedString() const;
 
+    // The number of items in the list, and the text of the given item
+    // These come from _list, unless a subclass provides them otherwise
+    virtual int listSize() const { return int(_list.size()); }
+    virtual const string& listItem(int item) const { return _list[item]; }
+
     void scrollTo(int item);
 
     // Account for the extra width of embedded scrollbar
@@ -15,6 +15,8 @@
 // this file, and for a DISCLAIMER OF ALL WARRANTIES.
 //============================================================================
 
+#include <map>
+
 #include "bspf.hxx"
 #include "Launcher.hxx"
 #include "LauncherFilterDialog.hxx"
@@ -30,6 +32,8 @@
 #include "Props.hxx"
 #include "PropsSet.hxx"
 #include "Settings.hxx"
+#include "RomIndexer.hxx"
+#include "RomInfoCache.hxx"
 #include "RomAuditDialog.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -123,47 +127,85 @@ void RomAuditDialog::auditRoms()
   files.reserve(2048);
   node.getChildren(files, FilesystemNode::kListFilesOnly);
 
+  // Only files with a valid ROM extension are considered
+  FSList roms;
+  StringList paths, extensions;
+  for(const auto& f: files)
+  {
+    string extension;
+    if(f.isFile() && LauncherFilterDialog::isValidRomName(f, extension))
+    {
+      roms.push_back(f);
+      paths.push_back(f.getPath());
+      extensions.push_back(extension);
+    }
+  }
+
   // Create a progress dialog box to show the progress of processing
   // the ROMs, since this is usually a time-consuming operation
+  // The first half of the range is for hashing, the second for renaming
   ProgressDialog progress(this, instance().frameBuffer().font(),
                           "Auditing ROM files ...");
-  progress.setRange(0, int(files.size()) - 1, 5);
+  progress.setRange(0, 2 * int(roms.size()) - 1, 5);
 
-  // Create a entry for the GameList for each file
+  // Calculate the MD5 of all files first, so we can get the rest of the
+  // info from the PropertiesSet (stella.pro)
+  // This is done by several threads at once, and files which haven't
+  // changed since the last audit don't need to be read at all
+  std::map<string, string> md5s;
+  {
+    RomIndexer indexer(instance().romInfoCache());
+    vector<RomIndexer::Result> results;
+
+    indexer.index(paths);
+    while(indexer.pending() > 0)
+    {
+      if(indexer.results(results, 100))
+      {
+        for(auto& r: results)
+          md5s[r.first] = std::move(r.second);
+        progress.setProgress(int(md5s.size()));
+      }
+    }
+  }
+
+  // Now rename each file according to its entry in the PropertiesSet
   Properties props;
   int renamed = 0, notfound = 0;
-  for(uInt32 idx = 0; idx < files.size(); idx++)
+  for(uInt32 idx = 0; idx < roms.size(); idx++)
   {
     bool renameSucceeded = false;
-    string extension;
-    if(files[idx].isFile() &&
-       LauncherFilterDialog::isValidRomName(files[idx], extension))
+
+    // Files which weren't indexed (see RomIndexer::canIndex()) are
+    // hashed here instead
+    const auto it = md5s.find(roms[idx].getPath());
+    const string& md5 = it != md5s.end() ? it->second : MD5::hash(roms[idx]);
+    if(instance().propSet().getMD5(md5, props))
     {
-      // Calculate the MD5 so we can get the rest of the info
-      // from the PropertiesSet (stella.pro)
-      const string& md5 = MD5::hash(files[idx]);
-      if(instance().propSet().getMD5(md5, props))
-      {
-        const string& name = props.get(Cartridge_Name);
+      const string& name = props.get(Cartridge_Name);
 
-        // Only rename the file if we found a valid properties entry
-        if(name != "" && name != files[idx].getName())
+      // Only rename the file if we found a valid properties entry
+      if(name != "" && name != roms[idx].getName())
+      {
+        const string& newfile = node.getPath() + name + "." + extensions[idx];
+        if(roms[idx].getPath() != newfile && roms[idx].rename(newfile))
         {
-          const string& newfile = node.getPath() + name + "." + extension;
-          if(files[idx].getPath() != newfile && files[idx].rename(newfile))
-            renameSucceeded = true;
+          // Remember the MD5 under the new name too
+          instance().romInfoCache().setMD5(FilesystemNode(newfile), md5);
+          renameSucceeded = true;
         }
       }
-      if(renameSucceeded)
-        ++renamed;
-      else
-        ++notfound;
     }
+    if(renameSucceeded)
+      ++renamed;
+    else
+      ++notfound;
 
     // Update the progress bar, indicating one more ROM has been processed
-    progress.setProgress(idx);
+    progress.setProgress(int(roms.size() + idx));
   }
   progress.close();
+  instance().romInfoCache().save();
 
   myResults1->setText(Variant(renamed).toString());
   myResults2->setText(Variant(notfound).toString());
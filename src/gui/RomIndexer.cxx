@@ -0,0 +1,213 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2018 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "FSNode.hxx"
+#include "FSNodeFactory.hxx"
+#include "MD5.hxx"
+#include "RomInfoCache.hxx"
+#include "RomIndexer.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RomIndexer::RomIndexer(RomInfoCache& cache)
+  : myCache(cache),
+    myBusy(0),
+    myGeneration(0),
+    myQuit(false)
+{
+  // Hashing is mostly bound by file I/O, so use at least two workers even
+  // on a single core, so that one can hash while the other is waiting
+  const uInt32 systemThreads = std::thread::hardware_concurrency();
+  const uInt32 numThreads = std::min(4u, std::max(2u, systemThreads));
+
+  for(uInt32 i = 0; i < numThreads; ++i)
+    myThreads.emplace_back([this] { work(); });
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RomIndexer::~RomIndexer()
+{
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+    myQueue.clear();
+    myQuit = true;
+  }
+  myQueued.notify_all();
+
+  for(auto& t: myThreads)
+    t.join();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomIndexer::index(const StringList& paths)
+{
+  std::lock_guard<std::mutex> lock(myMutex);
+
+  // Files which a worker is already hashing aren't queued again
+  std::deque<Entry> queue;
+  StringList zipped;
+  for(const auto& path: paths)
+  {
+    if(!canIndex(path) || myHashing.count(path) > 0)
+      continue;
+
+    Entry entry{path, "", 0, 0, false};
+    myCache.getMD5(path, entry.size, entry.modified, entry.md5);
+    queue.push_back(std::move(entry));
+
+    if(BSPF::containsIgnoreCase(path, ".zip"))
+      zipped.push_back(path);
+  }
+  // Files in archives are decompressed in the same order they're hashed
+  myLoader.queue(zipped);
+
+  myQueue = std::move(queue);
+  myQueued.notify_all();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomIndexer::prioritize(const string& path)
+{
+  std::lock_guard<std::mutex> lock(myMutex);
+
+  auto it = std::find_if(myQueue.begin(), myQueue.end(),
+                         [&path](const Entry& e) { return e.path == path; });
+  if(it != myQueue.end() && it != myQueue.begin())
+  {
+    Entry entry = std::move(*it);
+    myQueue.erase(it);
+    myQueue.push_front(std::move(entry));
+    myLoader.prioritize(path);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomIndexer::cancel()
+{
+  std::lock_guard<std::mutex> lock(myMutex);
+
+  myQueue.clear();
+  myResults.clear();
+  ++myGeneration;
+  myLoader.cancel();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RomIndexer::results(vector<Result>& list, uInt32 timeout)
+{
+  vector<Entry> entries;
+  {
+    std::unique_lock<std::mutex> lock(myMutex);
+    if(timeout > 0)
+      myFinished.wait_for(lock, std::chrono::milliseconds(timeout), [this] {
+        return !myResults.empty() || (myQueue.empty() && myBusy == 0);
+      });
+    entries.swap(myResults);
+  }
+
+  list.clear();
+  list.reserve(entries.size());
+  for(auto& e: entries)
+  {
+    if(e.store && e.md5 != "")
+      myCache.setMD5(e.path, e.size, e.modified, e.md5);
+
+    list.emplace_back(std::move(e.path), std::move(e.md5));
+  }
+
+  return !list.empty();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 RomIndexer::pending() const
+{
+  std::lock_guard<std::mutex> lock(myMutex);
+  return uInt32(myQueue.size() + myResults.size()) + myBusy;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomIndexer::work()
+{
+  std::unique_lock<std::mutex> lock(myMutex);
+  for(;;)
+  {
+    myQueued.wait(lock, [this] { return myQuit || !myQueue.empty(); });
+    if(myQuit)
+      return;
+
+    Entry entry = std::move(myQueue.front());
+    myQueue.pop_front();
+    const uInt32 generation = myGeneration;
+    myHashing.insert(entry.path);
+    ++myBusy;
+
+    // The file is read without holding the lock, so that the other
+    // workers (and the GUI) can carry on meanwhile
+    lock.unlock();
+    // Files which haven't changed since they were last hashed don't need
+    // to be read again
+    const bool zipped = BSPF::containsIgnoreCase(entry.path, ".zip");
+    uInt64 size = 0, modified = 0;
+    const bool stats = getStats(entry.path, size, modified);
+    if(stats && entry.md5 != "" &&
+       size == entry.size && modified == entry.modified)
+    {
+      if(zipped)
+        myLoader.skip(entry.path);
+    }
+    else
+    {
+      if(zipped)
+      {
+        ZipLoader::Image image;
+        const uInt32 length = myLoader.load(entry.path, image);
+        entry.md5 = length > 0 ? MD5::hash(image.get(), length) : EmptyString;
+      }
+      else
+        entry.md5 = MD5::hash(FilesystemNode(entry.path));
+      entry.size = size;
+      entry.modified = modified;
+      entry.store = stats;
+    }
+    lock.lock();
+
+    --myBusy;
+    myHashing.erase(entry.path);
+    if(generation == myGeneration)
+      myResults.push_back(std::move(entry));
+    myFinished.notify_all();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RomIndexer::canIndex(const string& path)
+{
+  string archive, file;
+  return !BSPF::containsIgnoreCase(path, ".zip") ||
+         ZipLoader::splitPath(path, archive, file);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RomIndexer::getStats(const string& path, uInt64& size, uInt64& modified)
+{
+  string archive, file;
+  if(!ZipLoader::splitPath(path, archive, file))
+    return FilesystemNode(path).getStats(size, modified);
+
+  unique_ptr<AbstractFSNode> node(
+    FilesystemNodeFactory::create(archive, FilesystemNodeFactory::SYSTEM));
+  return node && node->getStats(size, modified);
+}
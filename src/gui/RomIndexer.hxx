@@ -0,0 +1,144 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2018 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef ROM_INDEXER_HXX
+#define ROM_INDEXER_HXX
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+
+class RomInfoCache;
+
+#include "bspf.hxx"
+#include "ZipLoader.hxx"
+
+/**
+  Calculates the MD5 of ROM files in the background, using a small pool of
+  worker threads, so that the GUI doesn't have to wait on file I/O.
+
+  Files are only read if the RomInfoCache doesn't know their MD5, or they
+  have changed since it was recorded; even checking for the latter is done
+  by the workers.  All methods must be called from the GUI thread, since
+  new results are stored in the cache (which isn't thread-safe) when they
+  are collected.
+
+  Files inside ZIP archives are loaded by a ZipLoader, which decompresses
+  them in advance, in the order they were queued; whether they have changed
+  is decided by the archive itself.  The only files which are skipped (see
+  canIndex()) are archives given by their own name, which the caller should
+  hash itself when needed.
+*/
+class RomIndexer
+{
+  public:
+    // The path of a file, and its MD5 (empty if it couldn't be read)
+    using Result = std::pair<string, string>;
+
+    RomIndexer(RomInfoCache& cache);
+    ~RomIndexer();
+
+  public:
+    /**
+      Index the given files, replacing any which were still waiting from
+      a previous call.  Returns immediately.
+
+      @param paths  The full paths of the files to index
+    */
+    void index(const StringList& paths);
+
+    /**
+      Move the given file to the front of the queue, if it is still
+      waiting to be hashed.
+    */
+    void prioritize(const string& path);
+
+    /**
+      Drop all files which haven't been hashed yet, and all results which
+      haven't been collected.
+    */
+    void cancel();
+
+    /**
+      Collect the results which have become available since the last call,
+      and store them in the cache.  If 'timeout' is non-zero, wait up to that
+      many milliseconds for at least one result to arrive.
+
+      @return  False if no new results were available
+    */
+    bool results(vector<Result>& list, uInt32 timeout = 0);
+
+    /**
+      The number of files which are queued or being hashed, and whose
+      results haven't been collected yet.
+    */
+    uInt32 pending() const;
+
+    /**
+      Whether the given file is one that will be indexed at all.
+    */
+    static bool canIndex(const string& path);
+
+  private:
+    // A file to be hashed; before hashing, the size, modification time
+    // and MD5 are those from the cache (if any), afterwards the current ones
+    struct Entry {
+      string path;
+      string md5;
+      uInt64 size;
+      uInt64 modified;
+      bool store;     // Whether the MD5 should be added to the cache
+    };
+
+    // The worker thread loop
+    void work();
+
+    // Get the size and modification time of the given file, or of its
+    // archive; the worker threads can't use FilesystemNodeZIP
+    static bool getStats(const string& path, uInt64& size, uInt64& modified);
+
+  private:
+    RomInfoCache& myCache;
+    ZipLoader myLoader;
+
+    vector<std::thread> myThreads;
+
+    // All following state is shared with the workers, and protected by myMutex
+    mutable std::mutex myMutex;
+    std::condition_variable myQueued;    // Signalled when files are queued
+    std::condition_variable myFinished;  // Signalled when results arrive
+
+    std::deque<Entry> myQueue;
+    vector<Entry> myResults;
+    uInt32 myBusy;        // Files currently being hashed by a worker
+    std::unordered_set<string> myHashing;  // The paths of these files
+    uInt32 myGeneration;  // Increased on cancel, to discard stale results
+    bool myQuit;
+
+  private:
+    // Following constructors and assignment operators not supported
+    RomIndexer() = delete;
+    RomIndexer(const RomIndexer&) = delete;
+    RomIndexer(RomIndexer&&) = delete;
+    RomIndexer& operator=(const RomIndexer&) = delete;
+    RomIndexer& operator=(RomIndexer&&) = delete;
+};
+
+#endif
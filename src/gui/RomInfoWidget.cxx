@@ -15,6 +15,7 @@
 // this file, and for a DISCLAIMER OF ALL WARRANTIES.
 //============================================================================
 
+#include "Console.hxx"
 #include "EventHandler.hxx"
 #include "FrameBuffer.hxx"
 #include "Dialog.hxx"
@@ -25,6 +26,7 @@
 #include "Props.hxx"
 #include "PNGLibrary.hxx"
 #include "Rect.hxx"
+#include "RomThumbnails.hxx"
 #include "Widget.hxx"
 #include "TIAConstants.hxx"
 #include "RomInfoWidget.hxx"
@@ -36,7 +38,8 @@ RomInfoWidget::RomInfoWidget(GuiObject* boss, const GUI::Font& font,
     mySurfaceIsValid(false),
     myHaveProperties(false),
     myAvail(w > 400 ? GUI::Size(640, TIAConstants::maxViewableHeight*2) :
-                      GUI::Size(320, TIAConstants::maxViewableHeight))
+                      GUI::Size(320, TIAConstants::maxViewableHeight)),
+    myThumbnails(nullptr)
 {
   _flags = WIDGET_ENABLED;
   _bgcolor = _bgcolorhi = kWidColor;
@@ -75,6 +78,15 @@ void RomInfoWidget::clearProperties()
     setDirty();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomInfoWidget::thumbnailReady(const string& md5)
+{
+  if(myHaveProperties && !mySurfaceIsValid &&
+     md5 == myProperties.get(Cartridge_MD5) &&
+     instance().eventHandler().state() == EventHandlerState::LAUNCHER)
+    parseProperties();
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void RomInfoWidget::parseProperties()
 {
@@ -99,21 +111,24 @@ void RomInfoWidget::parseProperties()
   const string& filename = instance().snapshotLoadDir() +
       myProperties.get(Cartridge_Name) + ".png";
 
-  // Read the PNG file
+  // Read the PNG file, or show the preview rendered instead
   try
   {
     instance().png().loadImage(filename, *mySurface);
-
+  }
+  catch(const runtime_error& e)
+  {
+    mySurfaceIsValid = loadThumbnail();
+    if(!mySurfaceIsValid)
+      mySurfaceErrorMsg = e.what();
+  }
+  if(mySurfaceIsValid)
+  {
     // Scale surface to available image area
     const GUI::Rect& src = mySurface->srcRect();
     float scale = std::min(float(myAvail.w) / src.width(), float(myAvail.h) / src.height());
     mySurface->setDstSize(uInt32(src.width() * scale), uInt32(src.height() * scale));
   }
-  catch(const runtime_error& e)
-  {
-    mySurfaceIsValid = false;
-    mySurfaceErrorMsg = e.what();
-  }
   if(mySurface)
     mySurface->setVisible(mySurfaceIsValid);
 
@@ -135,6 +150,40 @@ void RomInfoWidget::parseProperties()
   setDirty();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RomInfoWidget::loadThumbnail()
+{
+  RomThumbnails::Thumbnail thumbnail;
+  if(!myThumbnails || !myThumbnails->get(myProperties.get(Cartridge_MD5), thumbnail))
+    return false;
+
+  // Each row stands for two scanlines, so the preview has the same aspect
+  // ratio as a snapshot twice its size; the user-defined palette isn't
+  // available without a console, so the standard one is used instead
+  const string& name = instance().settings().getString("palette");
+  const uInt32* palette =
+      Console::palette(name != "user" ? name : "standard", thumbnail.timing);
+
+  mySurface->setSrcPos(0, 0);
+  mySurface->setSrcSize(thumbnail.width, thumbnail.height);
+
+  FrameBuffer& fb = instance().frameBuffer();
+  uInt32 *s_buf, s_pitch;
+  mySurface->basePtr(s_buf, s_pitch);
+  const uInt8* t_buf = thumbnail.pixels;
+  for(uInt32 row = 0; row < thumbnail.height; ++row, t_buf += thumbnail.width, s_buf += s_pitch)
+  {
+    uInt32* s_ptr = s_buf;
+    for(uInt32 col = 0; col < thumbnail.width; ++col)
+    {
+      const uInt32 rgb = palette[t_buf[col]];
+      *s_ptr++ = fb.mapRGB((rgb >> 16) & 0xff, (rgb >> 8) & 0xff, rgb & 0xff);
+    }
+  }
+
+  return true;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void RomInfoWidget::drawWidget(bool hilite)
 {
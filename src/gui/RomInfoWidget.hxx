@@ -20,6 +20,7 @@
 
 class FBSurface;
 class Properties;
+class RomThumbnails;
 namespace GUI {
   struct Size;
 }
@@ -38,11 +39,23 @@ class RomInfoWidget : public Widget
     void clearProperties();
     void loadConfig() override;
 
+    /**
+      Show previews from the given cache for ROMs without a snapshot.
+    */
+    void setThumbnails(const RomThumbnails* thumbnails) { myThumbnails = thumbnails; }
+
+    /**
+      Inform the widget that the preview for the given MD5 has been
+      rendered, so it can be shown if that ROM is selected.
+    */
+    void thumbnailReady(const string& md5);
+
   protected:
     void drawWidget(bool hilite) override;
 
   private:
     void parseProperties();
+    bool loadThumbnail();
 
   private:
     // Surface pointer holding the PNG image
@@ -66,6 +79,9 @@ class RomInfoWidget : public Widget
     // How much space available for the PNG image
     GUI::Size myAvail;
 
+    // Previews for ROMs without a snapshot (if any)
+    const RomThumbnails* myThumbnails;
+
   private:
     // Following constructors and assignment operators not supported
     RomInfoWidget() = delete;
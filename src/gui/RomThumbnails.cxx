@@ -0,0 +1,323 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2018 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include <algorithm>
+
+#if defined(BSPF_UNIX) || defined(BSPF_MAC_OSX)
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+#include "Cart.hxx"
+#include "CartDetector.hxx"
+#include "Console.hxx"
+#include "FSNode.hxx"
+#include "OSystem.hxx"
+#include "Props.hxx"
+#include "PropsSet.hxx"
+#include "RomInfoCache.hxx"
+#include "Settings.hxx"
+#include "SoundNull.hxx"
+#include "TIA.hxx"
+#include "RomThumbnails.hxx"
+
+namespace {
+  // Written at the start of the file; the number must be increased whenever
+  // the layout of the records changes
+  const string HEADER = "Stella thumbnails 1\n";
+
+  // Each record holds the MD5 of the ROM image, the console timing, the
+  // number of rows, and then the rows of palette indices
+  constexpr uInt32 MD5_SIZE = 32;
+  constexpr uInt32 RECORD_HEADER_SIZE = MD5_SIZE + 2;
+  constexpr uInt32 WIDTH = 160;
+
+  // How long a ROM runs before its frame is captured (about 2.5 seconds)
+  constexpr uInt32 FRAMES = 150;
+
+  size_t recordSize(const uInt8* record)
+  {
+    return RECORD_HEADER_SIZE + WIDTH * record[MD5_SIZE + 1];
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RomThumbnails::RomThumbnails(OSystem& osystem, const string& filename)
+  : myOSystem(osystem),
+    myFilename(filename),
+    myFileSize(0),
+    mySaved(0),
+    myFrames(0)
+{
+  load();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RomThumbnails::~RomThumbnails()
+{
+  save();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomThumbnails::load()
+{
+#if defined(BSPF_UNIX) || defined(BSPF_MAC_OSX)
+  int fd = ::open(myFilename.c_str(), O_RDONLY);
+  if(fd >= 0)
+  {
+    struct stat st;
+    void* data = MAP_FAILED;
+    if(fstat(fd, &st) == 0 && st.st_size > 0)
+      data = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping remains valid after the descriptor is closed
+    ::close(fd);
+
+    if(data != MAP_FAILED)
+    {
+      const size_t size = size_t(st.st_size);
+      myFileData = shared_ptr<const uInt8>(static_cast<const uInt8*>(data),
+          [size](const uInt8* p) { munmap(const_cast<uInt8*>(p), size); });
+      myFileSize = size;
+    }
+  }
+#endif
+
+  if(!myFileData)
+  {
+    ifstream in(myFilename, std::ios::binary | std::ios::ate);
+    const std::streamoff size = in ? std::streamoff(in.tellg()) : 0;
+    if(size > 0)
+    {
+      uInt8* data = new uInt8[size_t(size)];
+      myFileData = shared_ptr<const uInt8>(data, std::default_delete<uInt8[]>());
+      in.seekg(0);
+      if(in.read(reinterpret_cast<char*>(data), size))
+        myFileSize = size_t(size);
+    }
+  }
+
+  // A file written by another version, or cut short while it was being
+  // written, is replaced the next time it's saved
+  const uInt8* data = myFileData.get();
+  if(myFileSize < HEADER.size() ||
+     memcmp(data, HEADER.data(), HEADER.size()) != 0 ||
+     !addRecords(data + HEADER.size(), myFileSize - HEADER.size()))
+  {
+    myRecords.clear();
+    myFileData.reset();
+    myFileSize = 0;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RomThumbnails::save()
+{
+  if(mySaved == myAdded.size())
+    return true;
+
+  const bool append = myFileSize > 0;
+  ofstream out(myFilename, std::ios::binary |
+                           (append ? std::ios::app : std::ios::trunc));
+  if(!out)
+    return false;
+
+  if(!append)
+  {
+    out.write(HEADER.data(), HEADER.size());
+    myFileSize = HEADER.size();
+  }
+  for(; mySaved < myAdded.size(); ++mySaved)
+  {
+    const uInt8* record = myAdded[mySaved].get();
+    const size_t size = recordSize(record);
+    out.write(reinterpret_cast<const char*>(record), size);
+    myFileSize += size;
+  }
+
+  return bool(out);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RomThumbnails::addRecords(const uInt8* data, size_t size)
+{
+  size_t pos = 0;
+  while(pos + RECORD_HEADER_SIZE <= size)
+  {
+    const uInt8* record = data + pos;
+    const size_t length = recordSize(record);
+    if(pos + length > size)
+      break;
+
+    myRecords[string(reinterpret_cast<const char*>(record), MD5_SIZE)] = record;
+    pos += length;
+  }
+
+  return pos == size;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RomThumbnails::get(const string& md5, Thumbnail& thumbnail) const
+{
+  const auto it = myRecords.find(md5);
+  if(it == myRecords.end())
+    return false;
+
+  const uInt8* record = it->second;
+  thumbnail.pixels = record + RECORD_HEADER_SIZE;
+  thumbnail.width  = WIDTH;
+  thumbnail.height = record[MD5_SIZE + 1];
+  switch(record[MD5_SIZE])
+  {
+    case 1:  thumbnail.timing = ConsoleTiming::pal;    break;
+    case 2:  thumbnail.timing = ConsoleTiming::secam;  break;
+    default: thumbnail.timing = ConsoleTiming::ntsc;   break;
+  }
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomThumbnails::queue(const vector<Rom>& roms)
+{
+  myQueue.clear();
+  for(const auto& rom: roms)
+    if(rom.second.length() == MD5_SIZE && myRecords.count(rom.second) == 0)
+      myQueue.push_back(rom);
+
+  // The preview being rendered is finished first if it's still wanted,
+  // and dropped otherwise
+  if(myConsole)
+  {
+    auto it = std::find_if(myQueue.begin(), myQueue.end(),
+        [this](const Rom& rom) { return rom.second == myMD5; });
+    if(it != myQueue.end())
+      myQueue.erase(it);
+    else
+      myConsole.reset();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RomThumbnails::render(uInt32 time, string& md5)
+{
+  const uInt64 end = myOSystem.getTicks() + time;
+  do
+  {
+    if(!myConsole)
+    {
+      if(myQueue.empty())
+        return false;
+
+      const Rom rom = myQueue.front();
+      myQueue.pop_front();
+      start(rom);
+      continue;
+    }
+
+    myConsole->tia().update();
+    if(++myFrames == FRAMES)
+    {
+      capture();
+      myConsole.reset();
+      md5 = myMD5;
+      return true;
+    }
+  }
+  while(myOSystem.getTicks() < end);
+
+  return false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RomThumbnails::start(const Rom& rom)
+{
+  const string& md5 = rom.second;
+  if(myRecords.count(md5) > 0)
+    return false;
+
+  // Previews are only needed for ROMs without a snapshot
+  const FilesystemNode node(rom.first);
+  Properties props;
+  myOSystem.propSet().getMD5WithInsert(node, md5, props);
+  if(FilesystemNode(myOSystem.snapshotLoadDir() +
+                    props.get(Cartridge_Name) + ".png").exists())
+    return false;
+
+  try
+  {
+    ImagePtr image;
+    const uInt32 size = node.read(image);
+    if(size == 0)
+      return false;
+
+    // The cartridge is created as in OSystem::openConsole, but ignoring any
+    // properties from the commandline; creating a multicart selects the
+    // next game in it, which mustn't happen because of a preview
+    Settings& settings = myOSystem.settings();
+    const int romloadcount = settings.getInt("romloadcount");
+    string cartmd5 = md5;
+    BSType autodetected = myOSystem.romInfoCache().type(md5);
+    unique_ptr<Cartridge> cart = CartDetector::create(image, size, cartmd5,
+        props.get(Cartridge_Type), autodetected, myOSystem);
+    settings.setValue("romloadcount", romloadcount);
+    myOSystem.romInfoCache().setType(md5, autodetected);
+    if(!cart)
+      return false;
+
+    if(cartmd5 != md5 && !myOSystem.propSet().getMD5(cartmd5, props))
+      props.set(Cartridge_MD5, cartmd5);
+
+    if(!mySound)
+      mySound = make_unique<SoundNull>(myOSystem);
+    myConsole = make_unique<Console>(myOSystem, cart, props, mySound.get());
+  }
+  catch(...)
+  {
+    myConsole.reset();
+    return false;
+  }
+
+  myMD5 = md5;
+  myFrames = 0;
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomThumbnails::capture()
+{
+  TIA& tia = myConsole->tia();
+  const uInt8* frame = tia.frameBuffer();
+  const uInt32 rows = std::min(tia.height() / 2, 255u);
+
+  BytePtr record = make_unique<uInt8[]>(RECORD_HEADER_SIZE + WIDTH * rows);
+  memcpy(record.get(), myMD5.data(), MD5_SIZE);
+  record[MD5_SIZE] = myConsole->timing() == ConsoleTiming::pal   ? 1 :
+                     myConsole->timing() == ConsoleTiming::secam ? 2 : 0;
+  record[MD5_SIZE + 1] = uInt8(rows);
+
+  // Every other row is kept; where it's black, the pixel from the row below
+  // is used instead, so that objects only drawn on odd lines don't vanish
+  uInt8* pixels = record.get() + RECORD_HEADER_SIZE;
+  for(uInt32 y = 0; y < rows; ++y, frame += 2 * WIDTH)
+    for(uInt32 x = 0; x < WIDTH; ++x)
+      *pixels++ = frame[x] != 0 ? frame[x] : frame[x + WIDTH];
+
+  myRecords[myMD5] = record.get();
+  myAdded.push_back(std::move(record));
+}
@@ -0,0 +1,144 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2018 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef ROM_THUMBNAILS_HXX
+#define ROM_THUMBNAILS_HXX
+
+#include <deque>
+#include <unordered_map>
+
+class Console;
+class OSystem;
+class Sound;
+enum class ConsoleTiming;
+
+#include "bspf.hxx"
+
+/**
+  Renders preview images for ROMs which don't have a snapshot, by running
+  each one on a headless console for a few seconds and keeping the last
+  frame, at half the vertical resolution.
+
+  The previews are stored as palette indices in a single file, which is
+  appended to as new ones are rendered, and memory-mapped (where possible)
+  when it's opened, so looking one up never touches the disk.
+
+  The emulation core isn't thread-safe, so rendering is done on the GUI
+  thread, a little at a time (see render()); all methods must be called
+  from there.
+*/
+class RomThumbnails
+{
+  public:
+    // The path of a ROM, and its MD5
+    using Rom = std::pair<string, string>;
+
+    // A preview, which remains valid as long as this object exists
+    struct Thumbnail {
+      const uInt8* pixels;   // Palette indices, one row after the other
+      uInt32 width;
+      uInt32 height;
+      ConsoleTiming timing;  // Selects the NTSC/PAL/SECAM colours
+    };
+
+    /**
+      Create a cache from the specified file (if it exists).
+    */
+    RomThumbnails(OSystem& osystem, const string& filename);
+    ~RomThumbnails();
+
+  public:
+    /**
+      Get the preview of the ROM image with the given MD5.
+
+      @return  False if none has been rendered
+    */
+    bool get(const string& md5, Thumbnail& thumbnail) const;
+
+    /**
+      Render previews for the given ROMs, in that order, replacing any
+      which were still waiting from a previous call.  ROMs which already
+      have a preview or a snapshot are skipped.
+    */
+    void queue(const vector<Rom>& roms);
+
+    /**
+      Continue rendering for about the given time, and stop as soon as
+      a preview has been completed.
+
+      @param time  The time available, in microseconds
+      @param md5   The MD5 of the ROM whose preview was completed
+
+      @return  True if a preview was completed
+    */
+    bool render(uInt32 time, string& md5);
+
+    /**
+      Append the previews rendered since the last call to the file.
+
+      @return  False if the file couldn't be written
+    */
+    bool save();
+
+  private:
+    void load();
+
+    // Create a headless console for the given ROM, if it needs a preview
+    bool start(const Rom& rom);
+
+    // Store the current frame of the console as a preview
+    void capture();
+
+    // Index the records stored one after the other in the given data
+    // Returns false if the data doesn't end with a complete record
+    bool addRecords(const uInt8* data, size_t size);
+
+  private:
+    OSystem& myOSystem;
+    string myFilename;
+
+    // The contents of the file, mapped or (failing that) read into memory,
+    // and the size of the file as written so far (0 if it must be replaced)
+    shared_ptr<const uInt8> myFileData;
+    size_t myFileSize;
+
+    // Records rendered since the file was loaded, and how many of them have
+    // been saved to it
+    vector<BytePtr> myAdded;
+    size_t mySaved;
+
+    // The start of every record, indexed by MD5
+    std::unordered_map<string, const uInt8*> myRecords;
+
+    std::deque<Rom> myQueue;
+
+    // The preview being rendered
+    unique_ptr<Sound> mySound;
+    unique_ptr<Console> myConsole;
+    string myMD5;
+    uInt32 myFrames;
+
+  private:
+    // Following constructors and assignment operators not supported
+    RomThumbnails() = delete;
+    RomThumbnails(const RomThumbnails&) = delete;
+    RomThumbnails(RomThumbnails&&) = delete;
+    RomThumbnails& operator=(const RomThumbnails&) = delete;
+    RomThumbnails& operator=(RomThumbnails&&) = delete;
+};
+
+#endif
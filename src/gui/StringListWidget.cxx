@@ -27,7 +27,8 @@ StringListWidget::StringListWidget(GuiObject* boss, const GUI::Font& font,
                                    int x, int y, int w, int h, bool hilite)
   : ListWidget(boss, font, x, y, w, h,
                boss->instance().settings().getInt("listdelay") >= 300),
-    _hilite(hilite)
+    _hilite(hilite),
+    _itemCount(0)
 {
 }
 
@@ -35,15 +36,38 @@ StringListWidget::StringListWidget(GuiObject* boss, const GUI::Font& font,
 void StringListWidget::setList(const StringList& list)
 {
   _list = list;
+  _itemFunc = nullptr;
 
   ListWidget::recalc();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void StringListWidget::setList(int size, const ItemFunc& item)
+{
+  _list.clear();
+  _itemFunc = item;
+  _itemCount = size;
+
+  ListWidget::recalc();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int StringListWidget::listSize() const
+{
+  return _itemFunc ? _itemCount : int(_list.size());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const string& StringListWidget::listItem(int item) const
+{
+  return _itemFunc ? _itemFunc(item) : _list[item];
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void StringListWidget::drawWidget(bool hilite)
 {
   FBSurface& s = _boss->dialog().surface();
-  int i, pos, len = int(_list.size());
+  int i, pos, len = listSize();
 
   // Draw a thin frame around the list.
   s.hLine(_x, _y, _x + _w - 1, kColor);
@@ -77,7 +101,7 @@ void StringListWidget::drawWidget(bool hilite)
                    TextAlign::Left, -_editScrollOffset, false);
     }
     else
-      s.drawString(_font, _list[pos], _x + r.left, y, r.width(), textColor);
+      s.drawString(_font, listItem(pos), _x + r.left, y, r.width(), textColor);
   }
 
   // Only draw the caret while editing, and if it's in the current viewport
@@ -18,6 +18,8 @@
 #ifndef STRING_LIST_WIDGET_HXX
 #define STRING_LIST_WIDGET_HXX
 
+#include <functional>
+
 #include "ListWidget.hxx"
 
 /** StringListWidget */
@@ -31,6 +33,17 @@ class StringListWidget : public ListWidget
     void setList(const StringList& list);
     bool wantsFocus() const override { return true; }
 
+    /**
+      Show a list of 'size' items, without copying them into the widget.
+      The text of an item is asked for only when it's needed (mostly when
+      it's visible), so it must remain valid until the list is changed.
+    */
+    using ItemFunc = std::function<const string&(int)>;
+    void setList(int size, const ItemFunc& item);
+
+    int listSize() const override;
+    const string& listItem(int item) const override;
+
   protected:
     void drawWidget(bool hilite) override;
     GUI::Rect getEditRect() const override;
@@ -38,6 +51,10 @@ class StringListWidget : public ListWidget
   protected:
     bool _hilite;
 
+    // The source of the items, when they aren't kept in _list
+    ItemFunc _itemFunc;
+    int _itemCount;
+
   private:
     // Following constructors and assignment operators not supported
     StringListWidget() = delete;
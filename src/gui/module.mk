@@ -38,7 +38,9 @@ MODULE_OBJS := \
 	src/gui/ProgressDialog.o \
 	src/gui/RadioButtonWidget.o \
 	src/gui/RomAuditDialog.o \
+	src/gui/RomIndexer.o \
 	src/gui/RomInfoWidget.o \
+	src/gui/RomThumbnails.o \
 	src/gui/ScrollBarWidget.o \
 	src/gui/SnapshotDialog.o \
 	src/gui/StringListWidget.o \
@@ -63,8 +63,10 @@ print OUTFILE "\n\n";
 print OUTFILE "static const char* const DefProps[DEF_PROPS_SIZE][" . $typesize . "] = {\n";
 
 # Walk the hash map and print each item in order of md5sum
+# The order must be case-insensitive, to match the binary form below
+my @keys = sort { lc($a) cmp lc($b) } keys %propset;
 my $idx = 0;
-for my $key ( sort keys %propset )
+for my $key ( @keys )
 {
   print OUTFILE PropSet::build_prop_string(@{ $propset{$key} });
 
@@ -75,6 +77,52 @@ for my $key ( sort keys %propset )
   $idx++;
 }
 
+print OUTFILE "};\n";
+print OUTFILE "\n";
+
+# Now print the same md5sums in binary form, along with an index of where
+# the entries starting with each possible value of the leading bits begin
+my $indexbits = 12;
+my @index = (0) x ((1 << $indexbits) + 1);
+
+print OUTFILE "/**\n";
+print OUTFILE "  The md5sum of each entry above in binary form, and for each value\n";
+print OUTFILE "  of the leading DEF_PROPS_INDEX_BITS bits, the first entry whose\n";
+print OUTFILE "  md5sum starts with that value (so those entries are found at\n";
+print OUTFILE "  DefPropsIndex[value] ... DefPropsIndex[value+1]-1).\n";
+print OUTFILE "*/\n";
+print OUTFILE "#define DEF_PROPS_INDEX_BITS " . $indexbits . "\n";
+print OUTFILE "\n";
+print OUTFILE "static const uInt8 DefPropsMD5[DEF_PROPS_SIZE][16] = {\n";
+$idx = 0;
+for my $key ( @keys )
+{
+  my @bytes = unpack("C16", pack("H32", lc($key)));
+  print OUTFILE "  { " . join(", ", map { sprintf("0x%02x", $_) } @bytes) . " }";
+  if ($idx+1 < $setsize) {
+    print OUTFILE ",";
+  }
+  print OUTFILE "\n";
+
+  my $leading = (($bytes[0] << 8) | $bytes[1]) >> (16 - $indexbits);
+  for (my $i = $leading + 1; $i <= (1 << $indexbits); $i++) {
+    $index[$i]++;
+  }
+  $idx++;
+}
+print OUTFILE "};\n";
+print OUTFILE "\n";
+
+print OUTFILE "static const uInt16 DefPropsIndex[(1 << DEF_PROPS_INDEX_BITS) + 1] = {\n";
+for (my $i = 0; $i <= (1 << $indexbits); $i += 16)
+{
+  my $last = $i + 15 < (1 << $indexbits) ? $i + 15 : (1 << $indexbits);
+  print OUTFILE "  " . join(", ", @index[$i .. $last]);
+  if ($last < (1 << $indexbits)) {
+    print OUTFILE ",";
+  }
+  print OUTFILE "\n";
+}
 print OUTFILE "};\n";
 print OUTFILE "\n";
 print OUTFILE "#endif\n";
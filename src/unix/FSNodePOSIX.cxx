@@ -93,6 +93,32 @@ string FilesystemNodePOSIX::getShortPath() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool FilesystemNodePOSIX::getChildren(AbstractFSList& myList, ListMode mode,
                                       bool hidden) const
+{
+  FilesystemNode::EntryList entries;
+  if (!getEntries(entries, mode, hidden))
+    return false;
+
+  myList.reserve(myList.size() + entries.size());
+  for (const auto& e: entries)
+  {
+    FilesystemNodePOSIX* entry = new FilesystemNodePOSIX(e.path, false);
+    entry->_isDirectory = e.isDirectory;
+    entry->_isFile = e.isFile;
+
+    // Add a trailing slash, if necessary (it was removed by realpath())
+    if (entry->_isDirectory && entry->_path.length() > 0 &&
+        entry->_path[entry->_path.length()-1] != '/')
+      entry->_path += '/';
+
+    myList.emplace_back(entry);
+  }
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool FilesystemNodePOSIX::getEntries(FilesystemNode::EntryList& myList,
+                                     ListMode mode, bool hidden) const
 {
   assert(_isDirectory);
 
@@ -102,7 +128,12 @@ bool FilesystemNodePOSIX::getChildren(AbstractFSList& myList, ListMode mode,
   if (dirp == nullptr)
     return false;
 
-  // loop over dir entries using readdir
+  string dirPath(_path);
+  if (dirPath.length() > 0 && dirPath[dirPath.length()-1] != '/')
+    dirPath += '/';
+
+  // loop over dir entries using readdir (which in turn reads many entries
+  // at once from the system)
   while ((dp = readdir(dirp)) != nullptr)
   {
     // Skip 'invisible' files if necessary
@@ -113,12 +144,8 @@ bool FilesystemNodePOSIX::getChildren(AbstractFSList& myList, ListMode mode,
     if ((dp->d_name[0] == '.' && dp->d_name[1] == 0) || (dp->d_name[0] == '.' && dp->d_name[1] == '.'))
       continue;
 
-    string newPath(_path);
-    if (newPath.length() > 0 && newPath[newPath.length()-1] != '/')
-      newPath += '/';
-    newPath += dp->d_name;
-
-    FilesystemNodePOSIX entry(newPath, false);
+    FilesystemNode::Entry entry{dp->d_name, dirPath + dp->d_name, false, false};
+    bool isValid = true, isLink = false;
 
 #if defined(SYSTEM_NOT_SUPPORTING_D_TYPE)
     /* TODO: d_type is not part of POSIX, so it might not be supported
@@ -128,49 +155,46 @@ bool FilesystemNodePOSIX::getChildren(AbstractFSList& myList, ListMode mode,
      * The d_type method is used to avoid costly recurrent stat() calls in big
      * directories.
      */
-    entry.setFlags();
+    const bool useStat = true;
 #else
-    if (dp->d_type == DT_UNKNOWN)
+    // Only links (and files on filesystems which don't report a type)
+    // need a stat() to find out what they are
+    isLink = dp->d_type == DT_LNK;
+    const bool useStat = dp->d_type == DT_UNKNOWN || isLink;
+    if (!useStat)
     {
-      // Fall back to stat()
-      entry.setFlags();
+      isValid = (dp->d_type == DT_DIR) || (dp->d_type == DT_REG);
+      entry.isDirectory = (dp->d_type == DT_DIR);
+      entry.isFile = (dp->d_type == DT_REG);
     }
-    else
+#endif
+    if (useStat)
     {
-      entry._isValid = (dp->d_type == DT_DIR) || (dp->d_type == DT_REG) || (dp->d_type == DT_LNK);
-      if (dp->d_type == DT_LNK)
+      // Broken links are still listed, as neither file nor directory
+      struct stat st;
+      if (stat(entry.path.c_str(), &st) == 0)
       {
-        struct stat st;
-        if (stat(entry._path.c_str(), &st) == 0)
-        {
-          entry._isDirectory = S_ISDIR(st.st_mode);
-          entry._isFile = S_ISREG(st.st_mode);
-        }
-        else
-          entry._isDirectory = entry._isFile = false;
+        entry.isDirectory = S_ISDIR(st.st_mode);
+        entry.isFile = S_ISREG(st.st_mode);
       }
       else
-      {
-        entry._isDirectory = (dp->d_type == DT_DIR);
-        entry._isFile = (dp->d_type == DT_REG);
-      }
-
-      if (entry._isDirectory)
-        entry._path += "/";
+        isValid = isLink;
     }
-#endif
 
     // Skip files that are invalid for some reason (e.g. because we couldn't
     // properly stat them).
-    if (!entry._isValid)
+    if (!isValid)
       continue;
 
     // Honor the chosen mode
-    if ((mode == FilesystemNode::kListFilesOnly && !entry._isFile) ||
-        (mode == FilesystemNode::kListDirectoriesOnly && !entry._isDirectory))
+    if ((mode == FilesystemNode::kListFilesOnly && !entry.isFile) ||
+        (mode == FilesystemNode::kListDirectoriesOnly && !entry.isDirectory))
       continue;
 
-    myList.emplace_back(new FilesystemNodePOSIX(entry));
+    if (entry.isDirectory)
+      entry.path += '/';
+
+    myList.push_back(std::move(entry));
   }
   closedir(dirp);
 
@@ -225,6 +249,26 @@ bool FilesystemNodePOSIX::rename(const string& newfile)
     return false;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool FilesystemNodePOSIX::getStats(uInt64& size, uInt64& modified) const
+{
+  struct stat st;
+  if(stat(_path.c_str(), &st) != 0)
+    return false;
+
+  size = uInt64(st.st_size);
+
+  // A rebuilt file often keeps its size, so seconds aren't precise enough
+#if defined(BSPF_MAC_OSX)
+  modified = uInt64(st.st_mtimespec.tv_sec) * 1000000000 +
+             uInt64(st.st_mtimespec.tv_nsec);
+#else
+  modified = uInt64(st.st_mtim.tv_sec) * 1000000000 +
+             uInt64(st.st_mtim.tv_nsec);
+#endif
+  return true;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 AbstractFSNode* FilesystemNodePOSIX::getParent() const
 {
@@ -295,6 +295,22 @@ bool FilesystemNodeWINDOWS::rename(const string& newfile)
     return false;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool FilesystemNodeWINDOWS::getStats(uInt64& size, uInt64& modified) const
+{
+  WIN32_FILE_ATTRIBUTE_DATA data;
+  if(_isPseudoRoot ||
+     !GetFileAttributesEx(toUnicode(_path.c_str()), GetFileExInfoStandard, &data))
+    return false;
+
+  size = (uInt64(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+
+  // FILETIME counts 100ns intervals
+  modified = ((uInt64(data.ftLastWriteTime.dwHighDateTime) << 32) |
+              data.ftLastWriteTime.dwLowDateTime) * 100;
+  return true;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 AbstractFSNode* FilesystemNodeWINDOWS::getParent() const
 {